@@ -0,0 +1,1191 @@
+#ifndef BTREE_H
+#define BTREE_H
+
+#include <new>
+#include "allocator.h"
+#include "comparator.h"
+#include "couple.h"
+#include "error.h"
+
+/**
+ * @file BTree.h
+ * @brief B+ Tree implementation header
+ * @details Provides a template-based B+ Tree implementation with:
+ * - Wide nodes with a compile-time fanout
+ * - Keys of a node stored contiguously and searched branchlessly
+ * - All key-value pairs kept in doubly linked leaves for sequential scans
+ * - Memory management via allocators
+ * - Custom comparison support
+ */
+
+
+namespace original {
+
+    /**
+     * @class BTree
+     * @tparam K_TYPE Key type (must be comparable)
+     * @tparam V_TYPE Value type
+     * @tparam ALLOC Allocator type (default: allocator<K_TYPE>)
+     * @tparam Compare Comparison function type (default: increaseComparator<K_TYPE>)
+     * @tparam FANOUT Maximum number of children of an inner node and of pairs in a leaf (default: 32)
+     * @brief B+ Tree container implementation
+     * @details This class provides a balanced multiway search tree implementation
+     * with the following properties:
+     * - O(log n) search/insert/delete operations with a height of about log_(FANOUT/2)(n)
+     * - Inner nodes hold only separator keys and child pointers, in two contiguous arrays
+     * - Leaves hold the key-value pairs contiguously and are linked to their neighbours
+     * - Every node except the root is at least half full
+     *
+     * Compared with RBTree, which allocates one node per pair, a lookup touches one
+     * node per level, and FANOUT pairs share one allocation.
+     *
+     * @note FANOUT must be even and at least 4.
+     */
+    template<typename K_TYPE,
+             typename V_TYPE,
+             typename ALLOC = allocator<K_TYPE>,
+             typename Compare = increaseComparator<K_TYPE>,
+             u_integer FANOUT = 32>
+    class BTree {
+    protected:
+
+        /**
+         * @brief Maximum number of pairs in a leaf
+         */
+        static constexpr u_integer MAX_ENTRIES = FANOUT;
+
+        /**
+         * @brief Minimum number of pairs in a non-root leaf
+         */
+        static constexpr u_integer MIN_ENTRIES = FANOUT / 2;
+
+        /**
+         * @brief Maximum number of separator keys in an inner node
+         */
+        static constexpr u_integer MAX_KEYS = FANOUT - 1;
+
+        /**
+         * @brief Minimum number of separator keys in a non-root inner node
+         */
+        static constexpr u_integer MIN_KEYS = (FANOUT - 1) / 2;
+
+        /**
+         * @class slots
+         * @tparam TYPE Element type
+         * @tparam SIZE Number of slots
+         * @brief Fixed-size uninitialized storage for node contents
+         * @details Elements are constructed and destroyed explicitly, so node types do
+         * not require TYPE to be default constructible or assignable.
+         */
+        template<typename TYPE, u_integer SIZE>
+        class slots {
+            alignas(TYPE) byte storage_[sizeof(TYPE) * SIZE]; ///< Raw element storage
+
+        public:
+            /**
+             * @brief Accesses a constructed slot
+             * @param index Slot index
+             * @return Reference to the element
+             */
+            TYPE& operator[](u_integer index);
+
+            /**
+             * @brief Accesses a constructed slot (const)
+             * @param index Slot index
+             * @return Const reference to the element
+             */
+            const TYPE& operator[](u_integer index) const;
+
+            /**
+             * @brief Constructs an element in an empty slot
+             * @tparam Args Constructor argument types
+             * @param index Slot index
+             * @param args Constructor arguments
+             */
+            template<typename... Args>
+            void construct(u_integer index, Args&&... args);
+
+            /**
+             * @brief Destroys the element in a slot
+             * @param index Slot index
+             */
+            void destroy(u_integer index);
+
+            /**
+             * @brief Moves elements [index, cnt) one slot to the right
+             * @param index First element to move, left empty afterwards
+             * @param cnt Number of constructed elements
+             */
+            void shiftRight(u_integer index, u_integer cnt);
+
+            /**
+             * @brief Moves elements (index, cnt) one slot to the left
+             * @param index Empty slot to fill
+             * @param cnt Number of elements before the slot at index was emptied
+             */
+            void shiftLeft(u_integer index, u_integer cnt);
+        };
+
+        /**
+         * @class BNode
+         * @brief Common header of leaf and inner nodes
+         */
+        class BNode {
+        public:
+            const bool leaf_;   ///< Whether this node is a leaf
+            u_integer cnt_;     ///< Pairs in a leaf, separator keys in an inner node
+
+            /**
+             * @brief Constructs an empty node header
+             * @param leaf Whether the node is a leaf
+             */
+            explicit BNode(bool leaf);
+        };
+
+        /**
+         * @class leafNode
+         * @brief Leaf node holding key-value pairs in key order
+         */
+        class leafNode final : public BNode {
+        public:
+            slots<couple<const K_TYPE, V_TYPE>, MAX_ENTRIES> data_;    ///< Pairs
+            leafNode* prev_;                                            ///< Previous leaf in key order
+            leafNode* next_;                                            ///< Next leaf in key order
+
+            /**
+             * @brief Constructs an empty, unlinked leaf
+             */
+            leafNode();
+        };
+
+        /**
+         * @class innerNode
+         * @brief Inner node holding separator keys and children
+         * @details Child i holds the keys in [keys_[i - 1], keys_[i]).
+         */
+        class innerNode final : public BNode {
+        public:
+            slots<K_TYPE, MAX_KEYS> keys_;  ///< Separator keys
+            BNode* children_[FANOUT];       ///< Child pointers
+
+            /**
+             * @brief Constructs an empty inner node
+             */
+            innerNode();
+        };
+
+        using rebind_alloc_leaf = typename ALLOC::template rebind_alloc<leafNode>;      ///< Leaf allocator type
+        using rebind_alloc_inner = typename ALLOC::template rebind_alloc<innerNode>;    ///< Inner node allocator type
+
+        BNode* root_;                                       ///< Root node pointer
+        leafNode* first_;                                   ///< Leaf with the smallest keys
+        leafNode* last_;                                    ///< Leaf with the largest keys
+        u_integer size_;                                    ///< Number of elements
+        Compare compare_;                                   ///< Comparison function
+        mutable rebind_alloc_leaf rebind_alloc_leaf_{};     ///< Leaf allocator
+        mutable rebind_alloc_inner rebind_alloc_inner_{};   ///< Inner node allocator
+
+        /**
+         * @class Iterator
+         * @brief Bidirectional iterator for BTree
+         * @details Walks the linked leaves, so advancing never climbs the tree.
+         */
+        class Iterator
+        {
+        protected:
+            mutable BTree* tree_;       ///< Owning tree
+            mutable leafNode* leaf_;    ///< Current leaf
+            mutable u_integer index_;   ///< Position in the current leaf
+
+            /**
+             * @brief Constructs iterator
+             * @param tree Owning tree
+             * @param leaf Current leaf
+             * @param index Position in the current leaf
+             */
+            explicit Iterator(BTree* tree = nullptr, leafNode* leaf = nullptr, u_integer index = 0);
+
+            /// Copy constructor
+            Iterator(const Iterator& other);
+
+            /// Copy assignment operator
+            Iterator& operator=(const Iterator& other);
+
+        public:
+            /**
+             * @brief Checks if more elements exist forward
+             * @return true if more elements available
+             */
+            [[nodiscard]] bool hasNext() const;
+
+            /**
+             * @brief Checks if more elements exist backward
+             * @return true if more elements available
+             */
+            [[nodiscard]] bool hasPrev() const;
+
+            /**
+             * @brief Moves to next element
+             */
+            void next() const;
+
+            /**
+             * @brief Moves to previous element
+             */
+            void prev() const;
+
+            /**
+             * @brief Advances iterator by steps
+             * @param steps Number of positions to advance
+             * @details Skips whole leaves, O(steps / FANOUT) for long jumps
+             */
+            void operator+=(integer steps) const;
+
+            /**
+             * @brief Moves iterator backward by steps
+             * @param steps Number of positions to move back
+             * @details Skips whole leaves, O(steps / FANOUT) for long jumps
+             */
+            void operator-=(integer steps) const;
+
+            /**
+             * @brief Gets current element (non-const)
+             * @return Reference to current key-value pair
+             */
+            couple<const K_TYPE, V_TYPE>& get();
+
+            /**
+             * @brief Gets current element (const)
+             * @return Copy of current key-value pair
+             */
+            couple<const K_TYPE, V_TYPE> get() const;
+
+            /**
+             * @brief Checks if iterator is valid
+             * @return true if iterator points to valid element
+             */
+            [[nodiscard]] bool isValid() const;
+        };
+
+        friend Iterator;
+
+        /**
+         * @brief Compares two keys with the tree's comparison function
+         * @param key First key
+         * @param other Second key
+         * @return true if key is ordered before other
+         */
+        bool highPriority(const K_TYPE& key, const K_TYPE& other) const;
+
+        /**
+         * @brief Finds the first pair of a leaf whose key is not ordered before key
+         * @param leaf Leaf to search
+         * @param key Key to search for
+         * @return Index in [0, leaf->cnt_]
+         * @details Branchless binary search over the contiguous pairs
+         */
+        u_integer lowerBound(const leafNode* leaf, const K_TYPE& key) const;
+
+        /**
+         * @brief Finds the child of an inner node whose range contains key
+         * @param inner Inner node to search
+         * @param key Key to search for
+         * @return Number of separators not ordered after key
+         * @details Branchless binary search over the contiguous separator keys
+         */
+        u_integer upperBound(const innerNode* inner, const K_TYPE& key) const;
+
+        /**
+         * @brief Finds the leaf whose range contains key
+         * @param key Key to search for
+         * @return Leaf pointer, or nullptr if the tree is empty
+         */
+        leafNode* findLeaf(const K_TYPE& key) const;
+
+        /**
+         * @brief Finds the first pair whose key is not ordered before key
+         * @param key Key to search for
+         * @param index Set to the position of the pair in the returned leaf
+         * @return Leaf holding the pair, or nullptr if every key is ordered before key
+         */
+        leafNode* lowerBoundEntry(const K_TYPE& key, u_integer& index) const;
+
+        /**
+         * @brief Creates an empty leaf
+         * @return Pointer to the new leaf
+         */
+        leafNode* createLeaf() const;
+
+        /**
+         * @brief Creates an empty inner node
+         * @return Pointer to the new inner node
+         */
+        innerNode* createInner() const;
+
+        /**
+         * @brief Destroys a node, its constructed elements and deallocates memory
+         * @param node Node to destroy (children are not destroyed)
+         */
+        void destroyNode(BNode* node) noexcept;
+
+        /**
+         * @brief Destroys a subtree
+         * @param node Root of the subtree
+         */
+        void destroySubtree(BNode* node) noexcept;
+
+        /**
+         * @brief Copies a subtree, relinking the copied leaves in key order
+         * @param node Root of the subtree to copy
+         * @param prev Last copied leaf, updated while copying
+         * @return Root of the copied subtree
+         */
+        BNode* copySubtree(const BNode* node, leafNode*& prev);
+
+        /**
+         * @brief Inserts a pair into a leaf with free space
+         * @param leaf Target leaf
+         * @param index Position of the new pair
+         * @param key Key to insert
+         * @param value Value to insert
+         */
+        void insertEntry(leafNode* leaf, u_integer index, const K_TYPE& key, const V_TYPE& value);
+
+        /**
+         * @brief Inserts a separator and the child to its right into an inner node with free space
+         * @param inner Target inner node
+         * @param index Position of the new separator
+         * @param key Separator key
+         * @param child Child holding the keys not ordered before key
+         */
+        void insertSeparator(innerNode* inner, u_integer index, const K_TYPE& key, BNode* child);
+
+        /**
+         * @brief Removes a separator and the child to its right from an inner node
+         * @param inner Target inner node
+         * @param index Position of the separator
+         */
+        void removeSeparator(innerNode* inner, u_integer index);
+
+        /**
+         * @brief Replaces a separator key
+         * @param inner Target inner node
+         * @param index Position of the separator
+         * @param key New separator key
+         */
+        void replaceSeparator(innerNode* inner, u_integer index, const K_TYPE& key);
+
+        /**
+         * @brief Recursively inserts a pair into a subtree
+         * @param node Root of the subtree
+         * @param key Key to insert
+         * @param value Value to insert
+         * @param inserted Set to false if key already existed
+         * @param up Receives the separator for the parent if the node was split
+         * @return New right sibling if the node was split, nullptr otherwise
+         */
+        BNode* insertInto(BNode* node, const K_TYPE& key, const V_TYPE& value,
+                          bool& inserted, slots<K_TYPE, 1>& up);
+
+        /**
+         * @brief Recursively erases a key from a subtree
+         * @param node Root of the subtree
+         * @param key Key to erase
+         * @return true if key was found and erased
+         * @details Children left less than half full are fixed by rebalance()
+         */
+        bool eraseFrom(BNode* node, const K_TYPE& key);
+
+        /**
+         * @brief Restores the minimum fill of a child by borrowing from or merging with a sibling
+         * @param parent Parent of the underfull child
+         * @param index Position of the child in parent
+         */
+        void rebalance(innerNode* parent, u_integer index);
+
+        /**
+         * @brief Destroys entire tree and deallocates all nodes
+         */
+        void destroyTree() noexcept;
+
+        /**
+         * @brief Replaces the contents of this tree with a structural copy of other
+         * @param other Tree to copy
+         * @details O(n), copies nodes one to one instead of re-inserting pairs
+         */
+        void copyTree(const BTree& other);
+
+        /**
+         * @brief Swaps tree structures with another tree
+         * @param other Tree to swap with
+         * @details Swaps root, leaf list ends, size and comparison function
+         */
+        void swapTree(BTree& other) noexcept;
+
+        /**
+         * @brief Takes over the tree structure of another tree
+         * @param other Tree to move from, left empty
+         */
+        void moveTree(BTree& other) noexcept;
+
+        /**
+         * @brief Constructs BTree with given comparison function
+         * @param compare Comparison function to use
+         */
+        explicit BTree(Compare compare = Compare{});
+
+        /**
+         * @brief Finds pair with given key
+         * @param key Key to search for
+         * @return Pointer to found pair, or nullptr if not found
+         */
+        couple<const K_TYPE, V_TYPE>* find(const K_TYPE& key) const;
+
+        /**
+         * @brief Modifies value for existing key
+         * @param key Key to modify
+         * @param value New value to set
+         * @return true if key was found and modified
+         */
+        bool modify(const K_TYPE& key, const V_TYPE& value);
+
+        /**
+         * @brief Inserts new key-value pair
+         * @param key Key to insert
+         * @param value Value to insert
+         * @return true if inserted, false if key already existed
+         * @details Splits full nodes on the way back up; the tree grows at the root
+         */
+        bool insert(const K_TYPE& key, const V_TYPE& value);
+
+        /**
+         * @brief Erases pair with given key
+         * @param key Key to erase
+         * @return true if key was found and erased
+         * @details Borrows from or merges with siblings on the way back up; the tree shrinks at the root
+         */
+        bool erase(const K_TYPE& key);
+
+        /**
+         * @brief Visits the pairs with keys in [low, high) in key order
+         * @tparam Callback Callable invocable with const couple<const K_TYPE, V_TYPE>&
+         * @param low Inclusive lower bound
+         * @param high Exclusive upper bound
+         * @param operation Visitor
+         * @details One descent to low, then a sequential walk along the linked leaves
+         */
+        template<typename Callback>
+        void scan(const K_TYPE& low, const K_TYPE& high, Callback&& operation) const;
+
+        /**
+         * @brief Destructor
+         * @details Cleans up all tree nodes and allocated memory
+         */
+        ~BTree();
+    };
+
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+template<typename TYPE, original::u_integer SIZE>
+TYPE& original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::slots<TYPE, SIZE>::operator[](const u_integer index) {
+    return *std::launder(reinterpret_cast<TYPE*>(this->storage_) + index);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+template<typename TYPE, original::u_integer SIZE>
+const TYPE& original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::slots<TYPE, SIZE>::operator[](const u_integer index) const {
+    return *std::launder(reinterpret_cast<const TYPE*>(this->storage_) + index);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+template<typename TYPE, original::u_integer SIZE>
+template<typename... Args>
+void original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::slots<TYPE, SIZE>::construct(const u_integer index, Args&&... args) {
+    ::new (reinterpret_cast<TYPE*>(this->storage_) + index) TYPE(std::forward<Args>(args)...);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+template<typename TYPE, original::u_integer SIZE>
+void original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::slots<TYPE, SIZE>::destroy(const u_integer index) {
+    (*this)[index].~TYPE();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+template<typename TYPE, original::u_integer SIZE>
+void original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::slots<TYPE, SIZE>::shiftRight(const u_integer index, const u_integer cnt) {
+    for (u_integer i = cnt; i > index; --i) {
+        this->construct(i, std::move((*this)[i - 1]));
+        this->destroy(i - 1);
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+template<typename TYPE, original::u_integer SIZE>
+void original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::slots<TYPE, SIZE>::shiftLeft(const u_integer index, const u_integer cnt) {
+    for (u_integer i = index; i + 1 < cnt; ++i) {
+        this->construct(i, std::move((*this)[i + 1]));
+        this->destroy(i + 1);
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::BNode::BNode(const bool leaf)
+    : leaf_(leaf), cnt_(0) {}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::leafNode::leafNode()
+    : BNode(true), prev_(nullptr), next_(nullptr) {}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::innerNode::innerNode()
+    : BNode(false), children_{} {}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::Iterator::Iterator(BTree* tree, leafNode* leaf, const u_integer index)
+    : tree_(tree), leaf_(leaf), index_(index) {}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::Iterator::Iterator(const Iterator& other) : Iterator() {
+    this->operator=(other);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+typename original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::Iterator&
+original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::Iterator::operator=(const Iterator& other)
+{
+    if (this == &other)
+        return *this;
+
+    this->tree_ = other.tree_;
+    this->leaf_ = other.leaf_;
+    this->index_ = other.index_;
+    return *this;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+bool original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::Iterator::hasNext() const
+{
+    return this->leaf_ && (this->index_ + 1 < this->leaf_->cnt_ || this->leaf_->next_);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+bool original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::Iterator::hasPrev() const
+{
+    return this->leaf_ && (this->index_ > 0 || this->leaf_->prev_);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+void original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::Iterator::next() const
+{
+    if (!this->leaf_)
+        return;
+
+    if (this->index_ + 1 < this->leaf_->cnt_) {
+        this->index_ += 1;
+    } else {
+        this->leaf_ = this->leaf_->next_;
+        this->index_ = 0;
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+void original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::Iterator::prev() const
+{
+    if (!this->leaf_)
+        return;
+
+    if (this->index_ > 0) {
+        this->index_ -= 1;
+    } else {
+        this->leaf_ = this->leaf_->prev_;
+        this->index_ = this->leaf_ ? this->leaf_->cnt_ - 1 : 0;
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+void original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::Iterator::operator+=(const integer steps) const
+{
+    if (steps < 0){
+        this->operator-=(-steps);
+        return;
+    }
+
+    integer remaining = steps;
+    while (this->leaf_ && remaining > 0) {
+        const integer in_leaf = this->leaf_->cnt_ - 1 - this->index_;
+        if (remaining <= in_leaf) {
+            this->index_ += static_cast<u_integer>(remaining);
+            return;
+        }
+        remaining -= in_leaf + 1;
+        this->leaf_ = this->leaf_->next_;
+        this->index_ = 0;
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+void original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::Iterator::operator-=(const integer steps) const
+{
+    if (steps < 0){
+        this->operator+=(-steps);
+        return;
+    }
+
+    integer remaining = steps;
+    while (this->leaf_ && remaining > 0) {
+        if (remaining <= this->index_) {
+            this->index_ -= static_cast<u_integer>(remaining);
+            return;
+        }
+        remaining -= this->index_ + 1;
+        this->leaf_ = this->leaf_->prev_;
+        this->index_ = this->leaf_ ? this->leaf_->cnt_ - 1 : 0;
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+original::couple<const K_TYPE, V_TYPE>& original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::Iterator::get()
+{
+    if (!this->isValid()) {
+        throw outOfBoundError();
+    }
+
+    return this->leaf_->data_[this->index_];
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+original::couple<const K_TYPE, V_TYPE> original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::Iterator::get() const
+{
+    if (!this->isValid()) {
+        throw outOfBoundError();
+    }
+
+    return this->leaf_->data_[this->index_];
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+bool original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::Iterator::isValid() const
+{
+    return this->leaf_;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+bool original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::highPriority(const K_TYPE& key, const K_TYPE& other) const {
+    return this->compare_(key, other);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+original::u_integer
+original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::lowerBound(const leafNode* leaf, const K_TYPE& key) const {
+    u_integer len = leaf->cnt_;
+    if (len == 0)
+        return 0;
+
+    u_integer base = 0;
+    while (len > 1) {
+        const u_integer half = len / 2;
+        base = this->highPriority(leaf->data_[base + half].first(), key) ? base + half : base;
+        len -= half;
+    }
+    return base + this->highPriority(leaf->data_[base].first(), key);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+original::u_integer
+original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::upperBound(const innerNode* inner, const K_TYPE& key) const {
+    u_integer len = inner->cnt_;
+    if (len == 0)
+        return 0;
+
+    u_integer base = 0;
+    while (len > 1) {
+        const u_integer half = len / 2;
+        base = this->highPriority(key, inner->keys_[base + half]) ? base : base + half;
+        len -= half;
+    }
+    return base + !this->highPriority(key, inner->keys_[base]);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+typename original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::leafNode*
+original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::findLeaf(const K_TYPE& key) const {
+    BNode* cur = this->root_;
+    if (!cur)
+        return nullptr;
+
+    while (!cur->leaf_) {
+        auto inner = static_cast<innerNode*>(cur);
+        cur = inner->children_[this->upperBound(inner, key)];
+    }
+    return static_cast<leafNode*>(cur);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+typename original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::leafNode*
+original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::lowerBoundEntry(const K_TYPE& key, u_integer& index) const {
+    leafNode* leaf = this->findLeaf(key);
+    if (!leaf)
+        return nullptr;
+
+    index = this->lowerBound(leaf, key);
+    if (index == leaf->cnt_) {
+        leaf = leaf->next_;
+        index = 0;
+    }
+    return leaf;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+typename original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::leafNode*
+original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::createLeaf() const {
+    auto node = this->rebind_alloc_leaf_.allocate(1);
+    this->rebind_alloc_leaf_.construct(node);
+    return node;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+typename original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::innerNode*
+original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::createInner() const {
+    auto node = this->rebind_alloc_inner_.allocate(1);
+    this->rebind_alloc_inner_.construct(node);
+    return node;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+void original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::destroyNode(BNode* node) noexcept {
+    if (node->leaf_) {
+        auto leaf = static_cast<leafNode*>(node);
+        for (u_integer i = 0; i < leaf->cnt_; ++i) {
+            leaf->data_.destroy(i);
+        }
+        this->rebind_alloc_leaf_.destroy(leaf);
+        this->rebind_alloc_leaf_.deallocate(leaf, 1);
+    } else {
+        auto inner = static_cast<innerNode*>(node);
+        for (u_integer i = 0; i < inner->cnt_; ++i) {
+            inner->keys_.destroy(i);
+        }
+        this->rebind_alloc_inner_.destroy(inner);
+        this->rebind_alloc_inner_.deallocate(inner, 1);
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+void original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::destroySubtree(BNode* node) noexcept {
+    if (!node->leaf_) {
+        auto inner = static_cast<innerNode*>(node);
+        for (u_integer i = 0; i <= inner->cnt_; ++i) {
+            this->destroySubtree(inner->children_[i]);
+        }
+    }
+    this->destroyNode(node);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+typename original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::BNode*
+original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::copySubtree(const BNode* node, leafNode*& prev) {
+    if (node->leaf_) {
+        auto src = static_cast<const leafNode*>(node);
+        leafNode* leaf = this->createLeaf();
+        for (u_integer i = 0; i < src->cnt_; ++i) {
+            leaf->data_.construct(i, src->data_[i]);
+        }
+        leaf->cnt_ = src->cnt_;
+        leaf->prev_ = prev;
+        if (prev) {
+            prev->next_ = leaf;
+        } else {
+            this->first_ = leaf;
+        }
+        prev = leaf;
+        return leaf;
+    }
+
+    auto src = static_cast<const innerNode*>(node);
+    innerNode* inner = this->createInner();
+    for (u_integer i = 0; i < src->cnt_; ++i) {
+        inner->keys_.construct(i, src->keys_[i]);
+    }
+    inner->cnt_ = src->cnt_;
+    for (u_integer i = 0; i <= src->cnt_; ++i) {
+        inner->children_[i] = this->copySubtree(src->children_[i], prev);
+    }
+    return inner;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+void original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::insertEntry(
+    leafNode* leaf, const u_integer index, const K_TYPE& key, const V_TYPE& value) {
+    leaf->data_.shiftRight(index, leaf->cnt_);
+    leaf->data_.construct(index, key, value);
+    leaf->cnt_ += 1;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+void original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::insertSeparator(
+    innerNode* inner, const u_integer index, const K_TYPE& key, BNode* child) {
+    inner->keys_.shiftRight(index, inner->cnt_);
+    inner->keys_.construct(index, key);
+    for (u_integer i = inner->cnt_ + 1; i > index + 1; --i) {
+        inner->children_[i] = inner->children_[i - 1];
+    }
+    inner->children_[index + 1] = child;
+    inner->cnt_ += 1;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+void original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::removeSeparator(innerNode* inner, const u_integer index) {
+    inner->keys_.destroy(index);
+    inner->keys_.shiftLeft(index, inner->cnt_);
+    for (u_integer i = index + 1; i < inner->cnt_; ++i) {
+        inner->children_[i] = inner->children_[i + 1];
+    }
+    inner->cnt_ -= 1;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+void original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::replaceSeparator(
+    innerNode* inner, const u_integer index, const K_TYPE& key) {
+    inner->keys_.destroy(index);
+    inner->keys_.construct(index, key);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+typename original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::BNode*
+original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::insertInto(
+    BNode* node, const K_TYPE& key, const V_TYPE& value, bool& inserted, slots<K_TYPE, 1>& up) {
+    if (node->leaf_) {
+        auto leaf = static_cast<leafNode*>(node);
+        const u_integer index = this->lowerBound(leaf, key);
+        if (index < leaf->cnt_ && leaf->data_[index].first() == key) {
+            inserted = false;
+            return nullptr;
+        }
+
+        inserted = true;
+        if (leaf->cnt_ < MAX_ENTRIES) {
+            this->insertEntry(leaf, index, key, value);
+            return nullptr;
+        }
+
+        constexpr u_integer mid = MAX_ENTRIES / 2;
+        leafNode* right = this->createLeaf();
+        for (u_integer i = mid; i < leaf->cnt_; ++i) {
+            right->data_.construct(i - mid, std::move(leaf->data_[i]));
+            leaf->data_.destroy(i);
+        }
+        right->cnt_ = leaf->cnt_ - mid;
+        leaf->cnt_ = mid;
+
+        right->prev_ = leaf;
+        right->next_ = leaf->next_;
+        if (leaf->next_) {
+            leaf->next_->prev_ = right;
+        } else {
+            this->last_ = right;
+        }
+        leaf->next_ = right;
+
+        if (index <= mid) {
+            this->insertEntry(leaf, index, key, value);
+        } else {
+            this->insertEntry(right, index - mid, key, value);
+        }
+        up.construct(0, right->data_[0].first());
+        return right;
+    }
+
+    auto inner = static_cast<innerNode*>(node);
+    const u_integer index = this->upperBound(inner, key);
+    slots<K_TYPE, 1> child_up;
+    BNode* child_right = this->insertInto(inner->children_[index], key, value, inserted, child_up);
+    if (!child_right)
+        return nullptr;
+
+    innerNode* right = nullptr;
+    if (inner->cnt_ < MAX_KEYS) {
+        this->insertSeparator(inner, index, child_up[0], child_right);
+    } else {
+        constexpr u_integer mid = MAX_KEYS / 2;
+        right = this->createInner();
+        up.construct(0, std::move(inner->keys_[mid]));
+        inner->keys_.destroy(mid);
+        for (u_integer i = mid + 1; i < inner->cnt_; ++i) {
+            right->keys_.construct(i - mid - 1, std::move(inner->keys_[i]));
+            inner->keys_.destroy(i);
+        }
+        for (u_integer i = mid + 1; i <= inner->cnt_; ++i) {
+            right->children_[i - mid - 1] = inner->children_[i];
+        }
+        right->cnt_ = inner->cnt_ - mid - 1;
+        inner->cnt_ = mid;
+
+        if (index <= mid) {
+            this->insertSeparator(inner, index, child_up[0], child_right);
+        } else {
+            this->insertSeparator(right, index - mid - 1, child_up[0], child_right);
+        }
+    }
+    child_up.destroy(0);
+    return right;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+bool original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::eraseFrom(BNode* node, const K_TYPE& key) {
+    if (node->leaf_) {
+        auto leaf = static_cast<leafNode*>(node);
+        const u_integer index = this->lowerBound(leaf, key);
+        if (index == leaf->cnt_ || !(leaf->data_[index].first() == key))
+            return false;
+
+        leaf->data_.destroy(index);
+        leaf->data_.shiftLeft(index, leaf->cnt_);
+        leaf->cnt_ -= 1;
+        return true;
+    }
+
+    auto inner = static_cast<innerNode*>(node);
+    const u_integer index = this->upperBound(inner, key);
+    BNode* child = inner->children_[index];
+    if (!this->eraseFrom(child, key))
+        return false;
+
+    if (child->cnt_ < (child->leaf_ ? MIN_ENTRIES : MIN_KEYS)) {
+        this->rebalance(inner, index);
+    }
+    return true;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+void original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::rebalance(innerNode* parent, const u_integer index) {
+    BNode* child = parent->children_[index];
+    BNode* left = index > 0 ? parent->children_[index - 1] : nullptr;
+    BNode* right = index < parent->cnt_ ? parent->children_[index + 1] : nullptr;
+
+    if (child->leaf_) {
+        auto cur = static_cast<leafNode*>(child);
+        if (left && left->cnt_ > MIN_ENTRIES) {
+            auto l = static_cast<leafNode*>(left);
+            cur->data_.shiftRight(0, cur->cnt_);
+            cur->data_.construct(0, std::move(l->data_[l->cnt_ - 1]));
+            l->data_.destroy(l->cnt_ - 1);
+            l->cnt_ -= 1;
+            cur->cnt_ += 1;
+            this->replaceSeparator(parent, index - 1, cur->data_[0].first());
+        } else if (right && right->cnt_ > MIN_ENTRIES) {
+            auto r = static_cast<leafNode*>(right);
+            cur->data_.construct(cur->cnt_, std::move(r->data_[0]));
+            r->data_.destroy(0);
+            r->data_.shiftLeft(0, r->cnt_);
+            r->cnt_ -= 1;
+            cur->cnt_ += 1;
+            this->replaceSeparator(parent, index, r->data_[0].first());
+        } else {
+            const u_integer sep = left ? index - 1 : index;
+            auto l = static_cast<leafNode*>(parent->children_[sep]);
+            auto r = static_cast<leafNode*>(parent->children_[sep + 1]);
+            for (u_integer i = 0; i < r->cnt_; ++i) {
+                l->data_.construct(l->cnt_ + i, std::move(r->data_[i]));
+                r->data_.destroy(i);
+            }
+            l->cnt_ += r->cnt_;
+            r->cnt_ = 0;
+            l->next_ = r->next_;
+            if (r->next_) {
+                r->next_->prev_ = l;
+            } else {
+                this->last_ = l;
+            }
+            this->destroyNode(r);
+            this->removeSeparator(parent, sep);
+        }
+        return;
+    }
+
+    auto cur = static_cast<innerNode*>(child);
+    if (left && left->cnt_ > MIN_KEYS) {
+        auto l = static_cast<innerNode*>(left);
+        cur->keys_.shiftRight(0, cur->cnt_);
+        cur->keys_.construct(0, parent->keys_[index - 1]);
+        for (u_integer i = cur->cnt_ + 1; i > 0; --i) {
+            cur->children_[i] = cur->children_[i - 1];
+        }
+        cur->children_[0] = l->children_[l->cnt_];
+        cur->cnt_ += 1;
+        this->replaceSeparator(parent, index - 1, l->keys_[l->cnt_ - 1]);
+        l->keys_.destroy(l->cnt_ - 1);
+        l->cnt_ -= 1;
+    } else if (right && right->cnt_ > MIN_KEYS) {
+        auto r = static_cast<innerNode*>(right);
+        cur->keys_.construct(cur->cnt_, parent->keys_[index]);
+        cur->children_[cur->cnt_ + 1] = r->children_[0];
+        cur->cnt_ += 1;
+        this->replaceSeparator(parent, index, r->keys_[0]);
+        r->keys_.destroy(0);
+        r->keys_.shiftLeft(0, r->cnt_);
+        for (u_integer i = 0; i < r->cnt_; ++i) {
+            r->children_[i] = r->children_[i + 1];
+        }
+        r->cnt_ -= 1;
+    } else {
+        const u_integer sep = left ? index - 1 : index;
+        auto l = static_cast<innerNode*>(parent->children_[sep]);
+        auto r = static_cast<innerNode*>(parent->children_[sep + 1]);
+        l->keys_.construct(l->cnt_, parent->keys_[sep]);
+        for (u_integer i = 0; i < r->cnt_; ++i) {
+            l->keys_.construct(l->cnt_ + 1 + i, std::move(r->keys_[i]));
+            r->keys_.destroy(i);
+        }
+        for (u_integer i = 0; i <= r->cnt_; ++i) {
+            l->children_[l->cnt_ + 1 + i] = r->children_[i];
+        }
+        l->cnt_ += r->cnt_ + 1;
+        r->cnt_ = 0;
+        this->destroyNode(r);
+        this->removeSeparator(parent, sep);
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+void original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::destroyTree() noexcept {
+    if (this->root_) {
+        this->destroySubtree(this->root_);
+    }
+    this->root_ = nullptr;
+    this->first_ = nullptr;
+    this->last_ = nullptr;
+    this->size_ = 0;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+void original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::copyTree(const BTree& other) {
+    this->destroyTree();
+    if (!other.root_)
+        return;
+
+    leafNode* prev = nullptr;
+    this->root_ = this->copySubtree(other.root_, prev);
+    this->last_ = prev;
+    this->size_ = other.size_;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+void original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::swapTree(BTree& other) noexcept {
+    std::swap(this->root_, other.root_);
+    std::swap(this->first_, other.first_);
+    std::swap(this->last_, other.last_);
+    std::swap(this->size_, other.size_);
+    std::swap(this->compare_, other.compare_);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+void original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::moveTree(BTree& other) noexcept {
+    this->destroyTree();
+    this->root_ = other.root_;
+    this->first_ = other.first_;
+    this->last_ = other.last_;
+    this->size_ = other.size_;
+    this->compare_ = std::move(other.compare_);
+    other.root_ = nullptr;
+    other.first_ = nullptr;
+    other.last_ = nullptr;
+    other.size_ = 0;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::BTree(Compare compare)
+    : root_(nullptr), first_(nullptr), last_(nullptr), size_(0), compare_(std::move(compare)) {
+    staticError<valueError, (FANOUT < 4 || FANOUT % 2 != 0)>::asserts();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+original::couple<const K_TYPE, V_TYPE>*
+original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::find(const K_TYPE& key) const {
+    leafNode* leaf = this->findLeaf(key);
+    if (!leaf)
+        return nullptr;
+
+    const u_integer index = this->lowerBound(leaf, key);
+    if (index < leaf->cnt_ && leaf->data_[index].first() == key)
+        return &leaf->data_[index];
+    return nullptr;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+bool original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::modify(const K_TYPE& key, const V_TYPE& value) {
+    if (auto cur = this->find(key)){
+        cur->template set<1>(value);
+        return true;
+    }
+    return false;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+bool original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::insert(const K_TYPE& key, const V_TYPE& value) {
+    if (!this->root_) {
+        leafNode* leaf = this->createLeaf();
+        this->root_ = leaf;
+        this->first_ = leaf;
+        this->last_ = leaf;
+    }
+
+    bool inserted = false;
+    slots<K_TYPE, 1> up;
+    BNode* right = this->insertInto(this->root_, key, value, inserted, up);
+    if (right) {
+        innerNode* new_root = this->createInner();
+        new_root->keys_.construct(0, std::move(up[0]));
+        up.destroy(0);
+        new_root->children_[0] = this->root_;
+        new_root->children_[1] = right;
+        new_root->cnt_ = 1;
+        this->root_ = new_root;
+    }
+    if (inserted) {
+        this->size_ += 1;
+    }
+    return inserted;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+bool original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::erase(const K_TYPE& key) {
+    if (!this->root_ || !this->eraseFrom(this->root_, key))
+        return false;
+
+    this->size_ -= 1;
+    if (this->root_->cnt_ == 0) {
+        BNode* old_root = this->root_;
+        if (old_root->leaf_) {
+            this->root_ = nullptr;
+            this->first_ = nullptr;
+            this->last_ = nullptr;
+        } else {
+            this->root_ = static_cast<innerNode*>(old_root)->children_[0];
+        }
+        this->destroyNode(old_root);
+    }
+    return true;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+template<typename Callback>
+void original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::scan(
+    const K_TYPE& low, const K_TYPE& high, Callback&& operation) const {
+    u_integer index = 0;
+    for (leafNode* leaf = this->lowerBoundEntry(low, index); leaf; leaf = leaf->next_, index = 0) {
+        for (; index < leaf->cnt_; ++index) {
+            const couple<const K_TYPE, V_TYPE>& e = leaf->data_[index];
+            if (!this->highPriority(e.first(), high))
+                return;
+            operation(e);
+        }
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare, original::u_integer FANOUT>
+original::BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>::~BTree() {
+    this->destroyTree();
+}
+
+#endif // BTREE_H
@@ -5,6 +5,8 @@
 #include "comparator.h"
 #include "couple.h"
 #include "queue.h"
+#include "vector.h"
+#include <limits>
 
 /**
  * @file RBTree.h
@@ -14,11 +16,15 @@
  * - Iterator support
  * - Memory management via allocators
  * - Custom comparison support
+ * - Order statistics (rank/select) through subtree sizes kept in every node
+ * - Join/split based union, intersection and difference (parallel versions in parallelTrees.h)
  */
 
 
 namespace original {
 
+    class parallelTrees;
+
     /**
      * @class RBTree
      * @tparam K_TYPE Key type (must be comparable)
@@ -32,6 +38,8 @@ namespace original {
      * - Self-balancing through color properties
      * - Custom comparator support
      * - STL-style allocator support
+     * - Every node knows the size of its subtree, so rank, select and iterator
+     *   jumps run in O(log n)
      */
     template<typename K_TYPE,
              typename V_TYPE,
@@ -46,6 +54,7 @@ namespace original {
          * @details Represents a single node in the tree with:
          * - Key-value pair storage
          * - Color property (RED/BLACK)
+         * - Subtree size
          * - Parent/child pointers
          */
         class RBNode {
@@ -57,6 +66,7 @@ namespace original {
         private:
             couple<const K_TYPE, V_TYPE> data_;  ///< Key-value pair storage
             color color_;                        ///< Node color
+            u_integer count_;                    ///< Number of nodes in the subtree rooted here
             RBNode* parent_;                     ///< Parent node pointer
             RBNode* left_;                       ///< Left child pointer
             RBNode* right_;                      ///< Right child pointer
@@ -137,6 +147,30 @@ namespace original {
              */
             color getColor() const;
 
+            /**
+             * @brief Gets the size of the subtree rooted at this node
+             * @return Number of nodes in the subtree, including this one
+             */
+            u_integer getCount() const;
+
+            /**
+             * @brief Sets the size of the subtree rooted at this node
+             * @param count New subtree size
+             */
+            void setCount(u_integer count);
+
+            /**
+             * @brief Recomputes the subtree size from the children
+             */
+            void updateCount();
+
+            /**
+             * @brief Gets the size of a possibly empty subtree
+             * @param node Subtree root, may be nullptr
+             * @return Subtree size, 0 for nullptr
+             */
+            static u_integer countOf(const RBNode* node);
+
             /**
              * @brief Gets parent node
              * @return Pointer to parent node
@@ -204,6 +238,24 @@ namespace original {
         static constexpr color BLACK = color::BLACK;                                ///< Black color constant
         static constexpr color RED = color::RED;                                    ///< Red color constant
         using rebind_alloc_node = typename ALLOC::template rebind_alloc<RBNode>;    ///< Rebound allocator type
+        using rebind_alloc_pointer = typename ALLOC::template rebind_alloc<RBNode*>; ///< Rebound allocator type for node pointers
+        using nodes_type = vector<RBNode*, rebind_alloc_pointer>;                  ///< Sequence of detached nodes
+
+        /// Set algebra performed by combineWith()
+        enum class setOperation {
+            UNION,          ///< Keep keys of either tree
+            INTERSECTION,   ///< Keep keys of both trees
+            DIFFERENCE,     ///< Keep keys of this tree only
+        };
+
+        /**
+         * @struct subtree
+         * @brief Detached subtree together with its black height
+         */
+        struct subtree {
+            RBNode* root;       ///< Root node, nullptr for the empty subtree
+            u_integer height;   ///< Black nodes on any path from root to a nil leaf
+        };
 
         RBNode* root_;                              ///< Root node pointer
         u_integer size_;                            ///< Number of elements
@@ -269,6 +321,14 @@ namespace original {
              */
             void operator-=(integer steps) const;
 
+            /**
+             * @brief Gets the number of positions from other to this iterator
+             * @param other Iterator over the same tree
+             * @return Position of this minus position of other; an invalid iterator is at
+             * position size(). Iterators over different trees give the max or min integer.
+             */
+            integer operator-(const Iterator& other) const;
+
             /**
              * @brief Gets current element (non-const)
              * @return Reference to current key-value pair
@@ -289,6 +349,7 @@ namespace original {
         };
 
         friend Iterator;
+        friend parallelTrees;   ///< Runs combine() over a taskDelegator (vibrant/parallelTrees.h)
 
         /**
           * @brief Creates a deep copy of the tree
@@ -296,6 +357,13 @@ namespace original {
           */
         RBNode* treeCopy() const;
 
+        /**
+         * @brief Creates a deep copy of a subtree with this tree's allocator
+         * @param root Root of the subtree, may belong to another tree
+         * @return Pointer to root of copied subtree, detached from any parent
+         */
+        RBNode* treeCopy(const RBNode* root) const;
+
         /**
          * @brief Gets precursor node (in-order predecessor)
          * @param cur Current node
@@ -381,13 +449,44 @@ namespace original {
          */
         bool highPriority(const K_TYPE& key, RBNode* other) const;
 
+        /**
+         * @brief Adds delta to the subtree size of a node and of all its ancestors
+         * @param from First node to update, may be nullptr
+         * @param delta Change of the subtree sizes
+         */
+        static void shiftCounts(RBNode* from, integer delta);
+
+        /**
+         * @brief Counts the keys ordered before a key
+         * @param key Key to rank
+         * @return Number of keys in the tree ordered before key
+         * @details O(log n); key does not have to be present.
+         */
+        u_integer rankOf(const K_TYPE& key) const;
+
+        /**
+         * @brief Finds the node at an in-order position
+         * @param index Zero-based position
+         * @return Node at index, or nullptr if index >= size
+         * @details O(log n)
+         */
+        RBNode* selectNode(u_integer index) const;
+
+        /**
+         * @brief Gets the in-order position of a node
+         * @param node Node of this tree, or nullptr
+         * @return Zero-based position of node, size for nullptr
+         * @details O(log n), by walking up to the root.
+         */
+        u_integer indexOf(RBNode* node) const;
+
         /**
          * @brief Performs left rotation around a node
          * @param cur Node to rotate around
          * @return New root node after rotation
          * @details Maintains tree properties during rotation
          */
-        RBNode* rotateLeft(RBNode* cur);
+        static RBNode* rotateLeft(RBNode* cur);
 
         /**
          * @brief Performs right rotation around a node
@@ -395,7 +494,7 @@ namespace original {
          * @return New root node after rotation
          * @details Maintains tree properties during rotation
          */
-        RBNode* rotateRight(RBNode* cur);
+        static RBNode* rotateRight(RBNode* cur);
 
         /**
          * @brief Adjusts tree after insertion to maintain RB properties
@@ -417,6 +516,159 @@ namespace original {
          */
         void destroyTree() noexcept;
 
+        /**
+         * @brief Destroys a detached subtree
+         * @param root Root of the subtree, may be nullptr
+         */
+        void destroyTree(RBNode* root) noexcept;
+
+        /**
+         * @brief Counts the black nodes on any path from a subtree root to a nil leaf
+         * @param tree Root of a valid red-black subtree, may be nullptr
+         * @return Black height, 0 for the empty tree
+         */
+        static u_integer blackHeight(const RBNode* tree);
+
+        /**
+         * @brief Detaches the children of a subtree root
+         * @param tree Subtree whose root to expose
+         * @param left Receives the detached left subtree
+         * @param right Receives the detached right subtree
+         * @details Afterward tree.root is a single node with no parent and no children.
+         */
+        static void expose(subtree tree, subtree& left, subtree& right);
+
+        /**
+         * @brief Makes a node the root of two subtrees
+         * @param left New left subtree
+         * @param mid Detached node to become the root
+         * @param right New right subtree
+         * @param c Color of mid
+         * @return mid
+         */
+        static RBNode* link(RBNode* left, RBNode* mid, RBNode* right, color c);
+
+        /**
+         * @brief Joins a lower right subtree into the right spine of left
+         * @param left Subtree with the smaller keys
+         * @param left_height Black height of left, at least right_height
+         * @param mid Detached node with a key between both subtrees
+         * @param right Subtree with the larger keys and a black root
+         * @param right_height Black height of right
+         * @return Root of the joined subtree, which may be red with a red right child
+         */
+        static RBNode* joinRight(RBNode* left, u_integer left_height, RBNode* mid,
+                                 RBNode* right, u_integer right_height);
+
+        /**
+         * @brief Joins a lower left subtree into the left spine of right
+         * @details Mirror image of joinRight().
+         */
+        static RBNode* joinLeft(RBNode* left, u_integer left_height, RBNode* mid,
+                                RBNode* right, u_integer right_height);
+
+        /**
+         * @brief Joins two subtrees around a middle node
+         * @param left Detached subtree whose keys are all ordered before mid
+         * @param mid Detached node
+         * @param right Detached subtree whose keys are all ordered after mid
+         * @return Valid red-black subtree holding all nodes, its root may be red
+         * @details O(|h(left) - h(right)| + 1): mid is linked where the black heights meet
+         * and only the path above it is rebalanced (Blelloch, Ferizovic and Sun, "Just Join
+         * for Parallel Ordered Sets"). Heights travel with the subtrees, so no join walks
+         * a spine to measure them.
+         */
+        static subtree join(subtree left, RBNode* mid, subtree right);
+
+        /**
+         * @brief Joins two subtrees without a middle node
+         * @param left Detached subtree whose keys are all ordered before right
+         * @param right Detached subtree
+         * @return Joined subtree
+         * @details The maximum of left is split off and used as the middle node. O(log n)
+         */
+        static subtree join(subtree left, subtree right);
+
+        /**
+         * @brief Removes the maximum node of a subtree
+         * @param tree Detached non-empty subtree
+         * @param last Receives the detached maximum node
+         * @return The remaining subtree
+         */
+        static subtree splitLast(subtree tree, RBNode*& last);
+
+        /**
+         * @brief Splits a subtree around a key
+         * @param tree Detached subtree, consumed by the split
+         * @param key Key to split at
+         * @param less Receives the subtree of keys ordered before key
+         * @param match Receives the detached node equal to key, or nullptr
+         * @param greater Receives the subtree of keys ordered after key
+         * @details O(log n): the joins along the search path cost O(log n) together,
+         * as each one only climbs the height difference of its operands.
+         */
+        void split(subtree tree, const K_TYPE& key, subtree& less, RBNode*& match, subtree& greater) const;
+
+        /**
+         * @brief Combines a subtree of this tree with a subtree of another tree
+         * @param mine Detached subtree of this tree, consumed by the operation
+         * @param other Subtree of another tree, only read
+         * @param op Operation to perform
+         * @return The resulting detached subtree
+         * @details mine is split at the root key of other and both halves are combined
+         * recursively with the children of other, then joined again. Nodes of mine are
+         * reused, dropped ones are destroyed and keys only in other are copied. Work is
+         * O(m log(n / m + 1)) for subtree sizes m <= n.
+         */
+        subtree combine(subtree mine, const RBNode* other, setOperation op);
+
+        /**
+         * @brief Makes the tree the union, intersection or difference with another tree
+         * @param other Tree ordered by the same comparison
+         * @param op Operation to perform
+         */
+        void combineWith(const RBTree& other, setOperation op);
+
+        /**
+         * @brief Links a balanced subtree over a sorted node range
+         * @param nodes Nodes in ascending key order
+         * @param low First node of the range
+         * @param high One past the last node of the range
+         * @param depth Depth of the subtree root
+         * @param red_depth Depth whose nodes are colored red
+         * @return Root of the subtree, or nullptr if the range is empty
+         * @details The middle node becomes the root, so sibling subtrees differ in size by at
+         * most one and all leaves lie on the two deepest levels. Coloring exactly the nodes
+         * on the deepest possible level red gives every root-to-nil path the same number
+         * of black nodes without any rotation.
+         */
+        static RBNode* linkBalanced(nodes_type& nodes, u_integer low, u_integer high,
+                                    u_integer depth, u_integer red_depth);
+
+        /**
+         * @brief Replaces the tree with a balanced tree over sorted nodes
+         * @param nodes Nodes in strictly ascending key order
+         * @details Runs in O(n). Parent, child and color fields of every node are overwritten.
+         */
+        void rebuildFrom(nodes_type& nodes);
+
+        /**
+         * @brief Inserts detached nodes given in ascending key order
+         * @param nodes New nodes sorted by key, duplicates allowed
+         * @return Number of nodes linked into the tree
+         * @throw valueError if nodes are not sorted; all new nodes are destroyed and the tree is unchanged
+         * @details Keys already in the tree and repeated keys keep their first value; the
+         * nodes carrying the later duplicates are destroyed.
+         *
+         * - Empty tree: the nodes are linked into a balanced tree directly in O(m)
+         * - Few nodes (m * log n < n + m): each node is inserted with a regular descent and rebalancing
+         * - Otherwise: the existing nodes are collected in order, merged with the new ones
+         *   and the whole tree is relinked in O(n + m)
+         *
+         * Existing nodes are reused, so iterators stay valid in all cases.
+         */
+        u_integer linkSorted(nodes_type& nodes);
+
         /**
          * @brief Constructs RBTree with given comparison function
          * @param compare Comparison function to use
@@ -468,7 +720,7 @@ namespace original {
 template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
 original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode::RBNode(const K_TYPE &key, const V_TYPE &value,
                                                                  const color color, RBNode *parent, RBNode *left, RBNode *right)
-                                                                 : data_({key, value}), color_(color), parent_(parent), left_(left), right_(right) {}
+                                                                 : data_({key, value}), color_(color), count_(1), parent_(parent), left_(left), right_(right) {}
 
 template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
 original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode::RBNode(const RBNode &other) : RBNode() {
@@ -483,6 +735,7 @@ original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode::operator=(const RBNode
 
     this->data_ = other.data_;
     this->color_ = other.color_;
+    this->count_ = other.count_;
     this->parent_ = other.parent_;
     this->left_ = other.left_;
     this->right_ = other.right_;
@@ -491,7 +744,7 @@ original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode::operator=(const RBNode
 
 template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
 original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode::RBNode(RBNode&& other) noexcept
-    : data_(std::move(other.data_)), color_(other.color_), parent_(nullptr), left_(nullptr), right_(nullptr) {}
+    : data_(std::move(other.data_)), color_(other.color_), count_(1), parent_(nullptr), left_(nullptr), right_(nullptr) {}
 
 
 template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
@@ -544,6 +797,26 @@ original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode::getColor() const {
     return this->color_;
 }
 
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+original::u_integer original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode::getCount() const {
+    return this->count_;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode::setCount(const u_integer count) {
+    this->count_ = count;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode::updateCount() {
+    this->count_ = 1 + countOf(this->left_) + countOf(this->right_);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+original::u_integer original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode::countOf(const RBNode* node) {
+    return node ? node->count_ : 0;
+}
+
 template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
 typename original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode*
 original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode::getPParent() const {
@@ -657,10 +930,11 @@ void original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::Iterator::operator+=(cons
 {
     if (steps < 0){
         this->operator-=(-steps);
-    } else {
-        for (integer i = 0; i < steps; ++i) {
-            this->next();
-        }
+    } else if (steps == 1) {
+        this->next();
+    } else if (steps > 1 && this->cur_) {
+        const ul_integer target = this->tree_->indexOf(this->cur_) + static_cast<ul_integer>(steps);
+        this->cur_ = target < this->tree_->size_ ? this->tree_->selectNode(static_cast<u_integer>(target)) : nullptr;
     }
 }
 
@@ -669,13 +943,27 @@ void original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::Iterator::operator-=(inte
 {
     if (steps < 0){
         this->operator+=(-steps);
-    } else {
-        for (integer i = 0; i < steps; ++i) {
-            this->prev();
-        }
+    } else if (steps == 1) {
+        this->prev();
+    } else if (steps > 1 && this->cur_) {
+        const u_integer index = this->tree_->indexOf(this->cur_);
+        this->cur_ = static_cast<ul_integer>(steps) <= index ?
+                     this->tree_->selectNode(index - static_cast<u_integer>(steps)) : nullptr;
     }
 }
 
+template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+original::integer original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::Iterator::operator-(const Iterator& other) const
+{
+    if (this->tree_ != other.tree_) {
+        return this->tree_ > other.tree_ ?
+               std::numeric_limits<integer>::max() :
+               std::numeric_limits<integer>::min();
+    }
+    return static_cast<integer>(this->tree_->indexOf(this->cur_)) -
+           static_cast<integer>(this->tree_->indexOf(other.cur_));
+}
+
 template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
 original::couple<const K_TYPE, V_TYPE>& original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::Iterator::get()
 {
@@ -706,22 +994,30 @@ bool original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::Iterator::isValid() const
 template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
 typename original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode*
 original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::treeCopy() const {
-    if (!this->root_) {
+    return this->treeCopy(this->root_);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode*
+original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::treeCopy(const RBNode* root) const {
+    if (!root) {
         return nullptr;
     }
 
     RBNode* copied_root =
-    this->createNode(this->root_->getKey(), this->root_->getValue(), this->root_->getColor());
-    queue<RBNode*> src = {this->root_};
+    this->createNode(root->getKey(), root->getValue(), root->getColor());
+    copied_root->setCount(root->getCount());
+    queue<const RBNode*> src = {root};
     queue<RBNode*> tar = {copied_root};
     while (!src.empty()){
-        RBNode* src_cur = src.head();
+        const RBNode* src_cur = src.head();
         RBNode* tar_cur = tar.head();
-        RBNode* src_child;
+        const RBNode* src_child;
         RBNode* tar_child;
         if (src_cur->getPLeft()){
             src_child = src_cur->getPLeft();
             tar_child = this->createNode(src_child->getKey(), src_child->getValue(), src_child->getColor());
+            tar_child->setCount(src_child->getCount());
             RBNode::connect(tar_cur, tar_child, true);
             src.push(src_child);
             tar.push(tar_child);
@@ -729,6 +1025,7 @@ original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::treeCopy() const {
         if (src_cur->getPRight()){
             src_child = src_cur->getPRight();
             tar_child = this->createNode(src_child->getKey(), src_child->getValue(), src_child->getColor());
+            tar_child->setCount(src_child->getCount());
             RBNode::connect(tar_cur, tar_child, false);
             src.push(src_child);
             tar.push(tar_child);
@@ -817,6 +1114,7 @@ original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::replaceNode(RBNode* src, RBNod
 {
     auto moved_src = this->createNode(std::move(*src));
     moved_src->setColor(tar->getColor());
+    moved_src->setCount(tar->getCount());
     if (RBNode* tar_parent = tar->getPParent()) {
         RBNode::connect(tar_parent, moved_src, tar_parent->getPLeft() == tar);
     } else {
@@ -834,7 +1132,12 @@ original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::createNode(const K_TYPE &key,
                                                              color color, RBNode* parent,
                                                              RBNode* left, RBNode* right) const {
     auto node = this->rebind_alloc.allocate(1);
-    this->rebind_alloc.construct(node, key, value, color, parent, left, right);
+    try {
+        this->rebind_alloc.construct(node, key, value, color, parent, left, right);
+    } catch (...) {
+        this->rebind_alloc.deallocate(node, 1);
+        throw;
+    }
     return node;
 }
 
@@ -843,7 +1146,12 @@ typename original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode*
 original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::createNode(RBNode&& other_node) const
 {
     auto node = this->rebind_alloc.allocate(1);
-    this->rebind_alloc.construct(node, std::move(other_node));
+    try {
+        this->rebind_alloc.construct(node, std::move(other_node));
+    } catch (...) {
+        this->rebind_alloc.deallocate(node, 1);
+        throw;
+    }
     return node;
 }
 
@@ -869,6 +1177,64 @@ bool original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::highPriority(const K_TYPE
     return this->compare_(key, other->getKey());
 }
 
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::shiftCounts(RBNode* from, const integer delta) {
+    for (RBNode* cur = from; cur; cur = cur->getPParent()) {
+        cur->setCount(static_cast<u_integer>(cur->getCount() + delta));
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+original::u_integer original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::rankOf(const K_TYPE& key) const {
+    u_integer rank = 0;
+    auto cur = this->root_;
+    while (cur) {
+        if (cur->getKey() == key) {
+            return rank + RBNode::countOf(cur->getPLeft());
+        }
+        if (this->highPriority(key, cur)) {
+            cur = cur->getPLeft();
+        } else {
+            rank += RBNode::countOf(cur->getPLeft()) + 1;
+            cur = cur->getPRight();
+        }
+    }
+    return rank;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode*
+original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::selectNode(u_integer index) const {
+    auto cur = this->root_;
+    while (cur) {
+        const u_integer left_count = RBNode::countOf(cur->getPLeft());
+        if (index < left_count) {
+            cur = cur->getPLeft();
+        } else if (index == left_count) {
+            return cur;
+        } else {
+            index -= left_count + 1;
+            cur = cur->getPRight();
+        }
+    }
+    return nullptr;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+original::u_integer original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::indexOf(RBNode* node) const {
+    if (!node) {
+        return this->size_;
+    }
+
+    u_integer index = RBNode::countOf(node->getPLeft());
+    for (RBNode* parent = node->getPParent(); parent; node = parent, parent = parent->getPParent()) {
+        if (parent->getPRight() == node) {
+            index += RBNode::countOf(parent->getPLeft()) + 1;
+        }
+    }
+    return index;
+}
+
 template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
 typename original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode*
 original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::rotateLeft(RBNode *cur) {
@@ -880,6 +1246,8 @@ original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::rotateLeft(RBNode *cur) {
     RBNode::connect(child_root, child_left, true);
     RBNode::connect(child_left, child_left_child, false);
     RBNode::connect(child_root, child_right, false);
+    child_left->updateCount();
+    child_root->updateCount();
     return child_root;
 }
 
@@ -894,6 +1262,8 @@ original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::rotateRight(RBNode *cur) {
     RBNode::connect(child_root, child_left, true);
     RBNode::connect(child_right, child_right_child, true);
     RBNode::connect(child_root, child_right, false);
+    child_right->updateCount();
+    child_root->updateCount();
     return child_root;
 }
 
@@ -998,7 +1368,7 @@ void original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::adjustErase(RBNode *cur)
                     nephew = brother->getPLeft();
                     nephew->setColor(parent->getColor());
                     parent->setColor(BLACK);
-                    RBNode::connect(parent, this->rotateRight(brother), true);
+                    RBNode::connect(parent, this->rotateRight(brother), false);
                     grand_parent = parent->getPParent();
                     if (grand_parent) {
                         bool is_left = grand_parent->getPLeft() == parent;
@@ -1094,11 +1464,17 @@ void original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::adjustErase(RBNode *cur)
 
 template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
 void original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::destroyTree() noexcept {
-    if (!this->root_) {
+    this->destroyTree(this->root_);
+    this->root_ = nullptr;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::destroyTree(RBNode* root) noexcept {
+    if (!root) {
         return;
     }
 
-    queue<RBNode*> queue = {this->root_};
+    queue<RBNode*> queue = {root};
     while (!queue.empty()) {
         RBNode* node = queue.head();
         if (node->getPLeft()) {
@@ -1109,7 +1485,345 @@ void original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::destroyTree() noexcept {
         }
         this->destroyNode(queue.pop());
     }
-    this->root_ = nullptr;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+original::u_integer original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::blackHeight(const RBNode* tree) {
+    u_integer height = 0;
+    for (; tree; tree = tree->getPLeft()) {
+        if (tree->getColor() == BLACK) {
+            height += 1;
+        }
+    }
+    return height;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::expose(const subtree tree, subtree& left, subtree& right) {
+    RBNode* root = tree.root;
+    const u_integer child_height = root->getColor() == BLACK ? tree.height - 1 : tree.height;
+    left = {root->getPLeft(), child_height};
+    right = {root->getPRight(), child_height};
+    RBNode::connect(nullptr, left.root, true);
+    RBNode::connect(nullptr, right.root, false);
+    root->setPParent(nullptr);
+    root->setPLeft(nullptr);
+    root->setPRight(nullptr);
+    root->setCount(1);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode*
+original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::link(RBNode* left, RBNode* mid, RBNode* right, const color c) {
+    mid->setPParent(nullptr);
+    RBNode::connect(mid, left, true);
+    RBNode::connect(mid, right, false);
+    mid->setColor(c);
+    mid->updateCount();
+    return mid;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode*
+original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::joinRight(RBNode* left, const u_integer left_height, RBNode* mid,
+                                                            RBNode* right, const u_integer right_height) {
+    const bool black = !left || left->getColor() == BLACK;
+    if (black && left_height == right_height) {
+        return link(left, mid, right, RED);
+    }
+
+    RBNode* joined = joinRight(left->getPRight(), black ? left_height - 1 : left_height,
+                               mid, right, right_height);
+    RBNode::connect(left, joined, false);
+    left->updateCount();
+    if (black && joined->getColor() == RED &&
+        joined->getPRight() && joined->getPRight()->getColor() == RED) {
+        joined->getPRight()->setColor(BLACK);
+        return rotateLeft(left);
+    }
+    return left;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode*
+original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::joinLeft(RBNode* left, const u_integer left_height, RBNode* mid,
+                                                           RBNode* right, const u_integer right_height) {
+    const bool black = !right || right->getColor() == BLACK;
+    if (black && left_height == right_height) {
+        return link(left, mid, right, RED);
+    }
+
+    RBNode* joined = joinLeft(left, left_height, mid,
+                              right->getPLeft(), black ? right_height - 1 : right_height);
+    RBNode::connect(right, joined, true);
+    right->updateCount();
+    if (black && joined->getColor() == RED &&
+        joined->getPLeft() && joined->getPLeft()->getColor() == RED) {
+        joined->getPLeft()->setColor(BLACK);
+        return rotateRight(right);
+    }
+    return right;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::subtree
+original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::join(subtree left, RBNode* mid, subtree right) {
+    // A red root may always turn black, so both sides enter with black roots
+    if (left.root && left.root->getColor() == RED) {
+        left.root->setColor(BLACK);
+        left.height += 1;
+    }
+    if (right.root && right.root->getColor() == RED) {
+        right.root->setColor(BLACK);
+        right.height += 1;
+    }
+
+    if (left.height > right.height) {
+        subtree joined{joinRight(left.root, left.height, mid, right.root, right.height), left.height};
+        if (joined.root->getColor() == RED && joined.root->getPRight() &&
+            joined.root->getPRight()->getColor() == RED) {
+            joined.root->setColor(BLACK);
+            joined.height += 1;
+        }
+        return joined;
+    }
+    if (right.height > left.height) {
+        subtree joined{joinLeft(left.root, left.height, mid, right.root, right.height), right.height};
+        if (joined.root->getColor() == RED && joined.root->getPLeft() &&
+            joined.root->getPLeft()->getColor() == RED) {
+            joined.root->setColor(BLACK);
+            joined.height += 1;
+        }
+        return joined;
+    }
+    return {link(left.root, mid, right.root, RED), left.height};
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::subtree
+original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::join(const subtree left, const subtree right) {
+    if (!left.root) {
+        return right;
+    }
+    if (!right.root) {
+        return left;
+    }
+
+    RBNode* last;
+    const subtree rest = splitLast(left, last);
+    return join(rest, last, right);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::subtree
+original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::splitLast(const subtree tree, RBNode*& last) {
+    subtree left, right;
+    expose(tree, left, right);
+    if (!right.root) {
+        last = tree.root;
+        return left;
+    }
+    return join(left, tree.root, splitLast(right, last));
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::split(const subtree tree, const K_TYPE& key,
+                                                             subtree& less, RBNode*& match, subtree& greater) const {
+    if (!tree.root) {
+        less = greater = {nullptr, 0};
+        match = nullptr;
+        return;
+    }
+
+    subtree left, right;
+    expose(tree, left, right);
+    if (tree.root->getKey() == key) {
+        less = left;
+        match = tree.root;
+        greater = right;
+    } else if (this->highPriority(key, tree.root)) {
+        subtree between;
+        this->split(left, key, less, match, between);
+        greater = join(between, tree.root, right);
+    } else {
+        subtree between;
+        this->split(right, key, between, match, greater);
+        less = join(left, tree.root, between);
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::subtree
+original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::combine(const subtree mine, const RBNode* other,
+                                                          const setOperation op) {
+    if (!other) {
+        if (op == setOperation::INTERSECTION) {
+            this->destroyTree(mine.root);
+            return {nullptr, 0};
+        }
+        return mine;
+    }
+    if (!mine.root) {
+        if (op != setOperation::UNION) {
+            return {nullptr, 0};
+        }
+        RBNode* copied = this->treeCopy(other);
+        return {copied, blackHeight(copied)};
+    }
+
+    subtree less, greater;
+    RBNode* match;
+    this->split(mine, other->getKey(), less, match, greater);
+    const subtree left = this->combine(less, other->getPLeft(), op);
+    const subtree right = this->combine(greater, other->getPRight(), op);
+    switch (op) {
+        case setOperation::UNION:
+            if (!match) {
+                match = this->createNode(other->getKey(), other->getValue());
+            }
+            return join(left, match, right);
+        case setOperation::INTERSECTION:
+            return match ? join(left, match, right) : join(left, right);
+        default:
+            if (match) {
+                this->destroyNode(match);
+            }
+            return join(left, right);
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::combineWith(const RBTree& other, const setOperation op) {
+    if (&other == this) {
+        if (op == setOperation::DIFFERENCE) {
+            this->destroyTree();
+            this->size_ = 0;
+        }
+        return;
+    }
+
+    this->root_ = this->combine({this->root_, blackHeight(this->root_)}, other.root_, op).root;
+    if (this->root_) {
+        this->root_->setColor(BLACK);
+    }
+    this->size_ = RBNode::countOf(this->root_);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode*
+original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::linkBalanced(nodes_type& nodes, const u_integer low, const u_integer high,
+                                                               const u_integer depth, const u_integer red_depth) {
+    if (low >= high) {
+        return nullptr;
+    }
+
+    const u_integer mid = low + (high - low) / 2;
+    RBNode* cur = nodes[mid];
+    cur->setColor(depth == red_depth ? RED : BLACK);
+    cur->setPLeft(nullptr);
+    cur->setPRight(nullptr);
+    RBNode::connect(cur, linkBalanced(nodes, low, mid, depth + 1, red_depth), true);
+    RBNode::connect(cur, linkBalanced(nodes, mid + 1, high, depth + 1, red_depth), false);
+    cur->setCount(high - low);
+    return cur;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::rebuildFrom(nodes_type& nodes) {
+    u_integer red_depth = 0;
+    while ((static_cast<ul_integer>(2) << red_depth) <= nodes.size()) {
+        red_depth += 1;
+    }
+
+    this->root_ = linkBalanced(nodes, 0, nodes.size(), 0, red_depth);
+    this->size_ = nodes.size();
+    if (this->root_) {
+        this->root_->setPParent(nullptr);
+        this->root_->setColor(BLACK);
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+original::u_integer original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::linkSorted(nodes_type& nodes) {
+    u_integer cnt = 0;
+    for (u_integer i = 0; i < nodes.size(); ++i) {
+        RBNode* node = nodes[i];
+        if (cnt > 0 && nodes[cnt - 1]->getKey() == node->getKey()) {
+            this->destroyNode(node);
+            continue;
+        }
+        if (cnt > 0 && !this->highPriority(nodes[cnt - 1], node)) {
+            for (u_integer j = 0; j < cnt; ++j) {
+                this->destroyNode(nodes[j]);
+            }
+            for (u_integer j = i; j < nodes.size(); ++j) {
+                this->destroyNode(nodes[j]);
+            }
+            nodes.clear();
+            throw valueError("Nodes passed to linkSorted are not sorted by key");
+        }
+        nodes[cnt++] = node;
+    }
+    while (nodes.size() > cnt) {
+        nodes.popEnd();
+    }
+
+    if (!this->root_) {
+        this->rebuildFrom(nodes);
+        return this->size_;
+    }
+
+    u_integer height = 0;
+    for (u_integer n = this->size_; n > 0; n >>= 1) {
+        height += 1;
+    }
+    const u_integer old_size = this->size_;
+    if (static_cast<ul_integer>(nodes.size()) * height < static_cast<ul_integer>(this->size_) + nodes.size()) {
+        for (RBNode* node : nodes) {
+            auto** cur = &this->root_;
+            RBNode* parent = nullptr;
+            bool is_left = false;
+            bool exists = false;
+            while (*cur) {
+                if ((*cur)->getKey() == node->getKey()) {
+                    exists = true;
+                    break;
+                }
+                parent = *cur;
+                is_left = this->highPriority(node, *cur);
+                cur = is_left ? &(*cur)->getPLeftRef() : &(*cur)->getPRightRef();
+            }
+            if (exists) {
+                this->destroyNode(node);
+                continue;
+            }
+            node->setColor(RED);
+            node->setCount(1);
+            RBNode::connect(parent, node, is_left);
+            shiftCounts(parent, 1);
+            this->size_ += 1;
+            this->adjustInsert(node);
+        }
+        return this->size_ - old_size;
+    }
+
+    nodes_type merged;
+    RBNode* cur = this->getMinNode();
+    u_integer i = 0;
+    while (cur || i < nodes.size()) {
+        if (!cur) {
+            merged.pushEnd(nodes[i++]);
+        } else if (i == nodes.size() || this->highPriority(cur, nodes[i])) {
+            merged.pushEnd(cur);
+            cur = this->getSuccessorNode(cur);
+        } else if (cur->getKey() == nodes[i]->getKey()) {
+            this->destroyNode(nodes[i++]);
+        } else {
+            merged.pushEnd(nodes[i++]);
+        }
+    }
+    this->rebuildFrom(merged);
+    return this->size_ - old_size;
 }
 
 template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
@@ -1158,6 +1872,7 @@ bool original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::insert(const K_TYPE &key,
         this->root_ = child;
     } else {
         RBNode::connect(parent, child, is_left);
+        shiftCounts(parent, 1);
     }
 
     this->size_ += 1;
@@ -1183,6 +1898,8 @@ bool original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::erase(const K_TYPE &key)
     }
 
     RBNode* parent = cur->getPParent();
+    shiftCounts(parent, -1);
+    cur->setCount(0);
     if (cur->getPLeft() && !cur->getPRight()) {
         if (!parent) {
             this->root_ = cur->getPLeft();
@@ -1210,8 +1927,6 @@ bool original::RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::erase(const K_TYPE &key)
             this->root_ = nullptr;
         } else if (cur->getColor() == BLACK) {
             this->adjustErase(cur);
-        } else {
-            RBNode::connect(nullptr, cur, true);
         }
     }
 
@@ -291,6 +291,14 @@ namespace original {
      */
     using l_floating = long double;
     /** @} */ // end of TypeDefinitions group
+
+    /**
+     * @brief Assumed size of a CPU cache line in bytes
+     * @details Used to pad or separate data that is written by different threads,
+     * so that independent hot fields do not share a cache line (false sharing).
+     * @note 64 bytes matches mainstream x86-64 and ARMv8 cores
+     */
+    constexpr u_integer CACHE_LINE_SIZE = 64;
 }
 
 #endif //CONFIG_H
\ No newline at end of file
@@ -12,8 +12,9 @@
  * @subsection Containers
  * - Fixed-size containers: array, bitSet
  * - Variable-size containers: vector, forwardChain, chain, blocksList
- * - Associative containers: hashMap, treeMap, hashSet, treeSet, JSet, JMap
+ * - Associative containers: hashMap, treeMap, hashSet, treeSet, JSet, JMap, persistentTreeMap
  * - Container adapters: stack, queue, deque, prique
+ * - Heaps: indexedHeap (d-ary, handle based priority updates), pairingHeap (O(1) merge)
  *
  * @subsection Memory_Management
  * - Smart pointers: ownerPtr, strongPtr, weakPtr
@@ -62,6 +63,7 @@
 #include "baseList.h"
 #include "bitSet.h"
 #include "blocksList.h"
+#include "BTree.h"
 #include "chain.h"
 #include "cloneable.h"
 #include "comparable.h"
@@ -78,6 +80,7 @@
 #include "filterStream.h"
 #include "forwardChain.h"
 #include "hash.h"
+#include "indexedHeap.h"
 #include "iterable.h"
 #include "iterationStream.h"
 #include "iterator.h"
@@ -86,6 +89,8 @@
 #include "maths.h"
 #include "optional.h"
 #include "ownerPtr.h"
+#include "pairingHeap.h"
+#include "persistentTree.h"
 #include "printable.h"
 #include "prique.h"
 #include "queue.h"
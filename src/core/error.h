@@ -24,7 +24,8 @@
  *     ├── callbackSignatureError
  *     ├── callbackReturnTypeError
  *     ├── allocateError
- *     └── sysError
+ *     ├── sysError
+ *     └── cancelledError
  * @endcode
  */
 
@@ -426,6 +427,33 @@ public:
     }
 };
 
+/**
+ * @class cancelledError
+ * @brief Exception for work that was cancelled before it completed.
+ * @details Thrown by cooperative cancellation points once the owning
+ *          cancellationSource was cancelled or its deadline has passed.
+ *
+ * @section Typical_Scenarios Typical Scenarios
+ * - A submitted task whose token was cancelled before a worker picked it up
+ * - A long computation polling its token after the caller gave up
+ */
+class cancelledError final : public error
+{
+public:
+    #define ORIGINAL_CANCELLED_ERROR_MSG "Operation cancelled"
+
+    explicit cancelledError(std::string msg = "")
+    : error(std::move(msg)) {}
+
+    std::string className() const override{
+        return "cancelledError";
+    }
+
+    std::string defaultMsg() const override {
+        return ORIGINAL_CANCELLED_ERROR_MSG;
+    }
+};
+
 } // namespace original
 
 // ----------------- Definitions of error.h -----------------
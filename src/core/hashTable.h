@@ -5,6 +5,7 @@
 #include "couple.h"
 #include "hash.h"
 #include "singleDirectionIterator.h"
+#include "thread.h"
 #include "vector.h"
 #include "wrapper.h"
 
@@ -23,6 +24,7 @@
  * - Printable interface support
  * - Dynamic resizing based on load factor
  * - Predefined bucket sizes for optimal performance
+ * - One-shot bucket sizing and optionally parallel bulk linking
  * - Exception-safe implementation
  */
 
@@ -450,6 +452,46 @@ namespace original {
          */
         void adjust();
 
+        /**
+         * @brief Gets the smallest predefined bucket size for an expected element count
+         * @param expected Number of elements the table should hold
+         * @return First size in BUCKETS_SIZES whose load factor stays below LOAD_FACTOR_MAX
+         * @throw outOfBoundError if expected exceeds the largest bucket size
+         */
+        static u_integer bucketsFor(u_integer expected);
+
+        /**
+         * @brief Grows the bucket array in one step so expected elements fit without rehashing
+         * @param expected Number of elements the table should hold
+         * @details Never shrinks the table. Insertions do not shrink it either, so the
+         * reserved size holds until elements are erased.
+         * @note Invalidates all iterators if the table is rehashed
+         */
+        void rehashFor(u_integer expected);
+
+        /**
+         * @brief Links detached nodes into the table, skipping duplicate keys
+         * @param nodes Nodes created by createNode(), in source order
+         * @param thread_cnt Number of threads that link nodes
+         * @return Number of nodes linked
+         * @details Sizes the bucket array once for size() + nodes.size(), then links every node.
+         * Keys already in the table and repeated keys keep their first value; the nodes
+         * carrying the later duplicates are destroyed.
+         *
+         * With thread_cnt > 1 the work is hash partitioned:
+         * 1. Bucket indices of all nodes are computed by thread_cnt threads over equal slices
+         * 2. The nodes are partitioned once by the contiguous bucket range they fall into
+         * 3. Each thread links the nodes of its own partition
+         *
+         * Bucket ranges are disjoint, so no synchronization is needed besides joining the threads,
+         * and the result is identical to the sequential one.
+         * @note The parallel path calls HASH and the key comparison concurrently, and destroys
+         *       duplicates only after joining
+         * @note If an exception is thrown, nodes linked so far stay in the table and every other
+         *       node is destroyed
+         */
+        u_integer linkNodes(buckets_type& nodes, u_integer thread_cnt);
+
         /**
          * @brief Constructs empty hashTable
          * @param hash Hash function to use
@@ -476,7 +518,7 @@ namespace original {
          * @param key Key to insert
          * @param value Value to associate
          * @return true if inserted, false if key already existed
-         * @note Automatically adjusts table size if needed
+         * @note Automatically expands table size if needed, but never shrinks it
          */
         bool insert(const K_TYPE& key, const V_TYPE& value);
 
@@ -488,6 +530,18 @@ namespace original {
          */
         bool erase(const K_TYPE& key);
 
+        /**
+         * @brief Erases every node whose key satisfies a predicate
+         * @tparam Callback Callable invocable with const K_TYPE&, returning bool
+         * @param drop Predicate selecting the keys to erase
+         * @return Number of erased nodes
+         * @details One pass over all buckets, O(n + buckets), then at most one rehash
+         * down to the smallest bucket count that fits the remaining nodes.
+         * @note Invalidates iterators to erased nodes, and all iterators if the table is rehashed
+         */
+        template<typename Callback>
+        u_integer eraseIf(Callback&& drop);
+
         /**
          * @brief Destroys hashTable
          * @details Cleans up all nodes and buckets
@@ -805,6 +859,127 @@ void original::hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::adjust() {
     }
 }
 
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename HASH>
+original::u_integer original::hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::bucketsFor(const u_integer expected) {
+    for (u_integer i : BUCKETS_SIZES){
+        if (static_cast<floating>(expected) / i < LOAD_FACTOR_MAX){
+            return i;
+        }
+    }
+    throw outOfBoundError();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename HASH>
+void original::hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::rehashFor(const u_integer expected) {
+    const u_integer new_bucket_count = bucketsFor(expected);
+    if (new_bucket_count > this->getBucketCount())
+        this->rehash(new_bucket_count);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename HASH>
+original::u_integer
+original::hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::linkNodes(buckets_type& nodes, u_integer thread_cnt) {
+    const u_integer node_cnt = nodes.size();
+    if (node_cnt == 0)
+        return 0;
+
+    // Linked nodes are cleared from the vector; whatever is left is a duplicate or, after an
+    // exception, was never reached. Either way it is destroyed here.
+    auto finish = [this, &nodes, node_cnt]() -> u_integer {
+        u_integer linked = 0;
+        for (u_integer i = 0; i < node_cnt; ++i) {
+            if (nodes[i]) {
+                this->destroyNode(nodes[i]);
+            } else {
+                linked += 1;
+            }
+        }
+        this->size_ += linked;
+        return linked;
+    };
+
+    auto linkNode = [this, &nodes](const u_integer i, const u_integer code) {
+        hashNode*& head = this->buckets[code];
+        for (auto cur = head; cur; cur = cur->getPNext()) {
+            if (cur->getKey() == nodes[i]->getKey())
+                return;
+        }
+        nodes[i]->setPNext(head);
+        head = nodes[i];
+        nodes[i] = nullptr;
+    };
+
+    try {
+        this->rehashFor(this->size_ + node_cnt);
+        const u_integer bucket_cnt = this->getBucketCount();
+
+        thread_cnt = thread_cnt == 0 ? 1 : thread_cnt;
+        thread_cnt = thread_cnt > node_cnt ? node_cnt : thread_cnt;
+        array<u_integer> codes(node_cnt);
+        if (thread_cnt == 1) {
+            for (u_integer i = 0; i < node_cnt; ++i) {
+                linkNode(i, this->getHashCode(nodes[i]->getKey()));
+            }
+            return finish();
+        }
+
+        {
+            array<thread> workers(thread_cnt);
+            for (u_integer t = 0; t < thread_cnt; ++t) {
+                workers[t] = thread{[this, &nodes, &codes, t, thread_cnt, node_cnt] {
+                    const u_integer first = static_cast<u_integer>(static_cast<ul_integer>(node_cnt) * t / thread_cnt);
+                    const u_integer last = static_cast<u_integer>(static_cast<ul_integer>(node_cnt) * (t + 1) / thread_cnt);
+                    for (u_integer i = first; i < last; ++i) {
+                        codes[i] = this->getHashCode(nodes[i]->getKey());
+                    }
+                }};
+            }
+        }
+
+        // Thread t owns buckets [bucket_cnt * t / thread_cnt, bucket_cnt * (t + 1) / thread_cnt).
+        // A stable counting sort groups node indices by owner, keeping source order within each group.
+        auto ownerOf = [thread_cnt, bucket_cnt](const u_integer code) -> u_integer {
+            const ul_integer scaled = (static_cast<ul_integer>(code) + 1) * thread_cnt;
+            return static_cast<u_integer>((scaled + bucket_cnt - 1) / bucket_cnt - 1);
+        };
+        array<u_integer> starts(thread_cnt + 1);
+        for (u_integer t = 0; t <= thread_cnt; ++t) {
+            starts[t] = 0;
+        }
+        for (u_integer i = 0; i < node_cnt; ++i) {
+            starts[ownerOf(codes[i]) + 1] += 1;
+        }
+        for (u_integer t = 0; t < thread_cnt; ++t) {
+            starts[t + 1] += starts[t];
+        }
+        array<u_integer> order(node_cnt);
+        {
+            array<u_integer> next(thread_cnt);
+            for (u_integer t = 0; t < thread_cnt; ++t) {
+                next[t] = starts[t];
+            }
+            for (u_integer i = 0; i < node_cnt; ++i) {
+                order[next[ownerOf(codes[i])]++] = i;
+            }
+        }
+
+        {
+            array<thread> workers(thread_cnt);
+            for (u_integer t = 0; t < thread_cnt; ++t) {
+                workers[t] = thread{[&linkNode, &codes, &order, &starts, t] {
+                    for (u_integer k = starts[t]; k < starts[t + 1]; ++k) {
+                        linkNode(order[k], codes[order[k]]);
+                    }
+                }};
+            }
+        }
+    } catch (...) {
+        finish();
+        throw;
+    }
+    return finish();
+}
+
 template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename HASH>
 original::hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::hashTable(HASH hash)
     : size_(0), hash_(std::move(hash)) {
@@ -835,7 +1010,9 @@ bool original::hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::modify(const K_TYPE &key,
 
 template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename HASH>
 bool original::hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::insert(const K_TYPE &key, const V_TYPE &value) {
-    this->adjust();
+    if (this->loadFactor() >= LOAD_FACTOR_MAX){
+        this->rehash(this->getNextSize());
+    }
 
     auto cur = this->getBucket(key);
     if (!cur){
@@ -845,7 +1022,7 @@ bool original::hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::insert(const K_TYPE &key,
             return false;
 
         for (; cur->getPNext(); cur = cur->getPNext()){
-            if (cur->getKey() == key)
+            if (cur->getPNext()->getKey() == key)
                 return false;
         }
         hashNode::connect(cur, this->createNode(key, value));
@@ -884,6 +1061,39 @@ bool original::hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::erase(const K_TYPE &key)
     return false;
 }
 
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename HASH>
+template<typename Callback>
+original::u_integer original::hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::eraseIf(Callback&& drop) {
+    u_integer erased = 0;
+    for (hashNode*& bucket : this->buckets) {
+        hashNode* prev = nullptr;
+        hashNode* cur = bucket;
+        while (cur) {
+            hashNode* next = cur->getPNext();
+            if (drop(cur->getKey())) {
+                if (prev) {
+                    hashNode::connect(prev, next);
+                } else {
+                    bucket = next;
+                }
+                this->destroyNode(cur);
+                erased += 1;
+            } else {
+                prev = cur;
+            }
+            cur = next;
+        }
+    }
+    this->size_ -= erased;
+
+    if (this->loadFactor() <= LOAD_FACTOR_MIN) {
+        const u_integer new_bucket_count = bucketsFor(this->size_);
+        if (new_bucket_count < this->getBucketCount())
+            this->rehash(new_bucket_count);
+    }
+    return erased;
+}
+
 template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename HASH>
 original::hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::~hashTable() {
     for (hashNode*& bucket: this->buckets) {
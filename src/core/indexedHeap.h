@@ -0,0 +1,719 @@
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include "allocator.h"
+#include "comparator.h"
+#include "container.h"
+#include "error.h"
+#include "printable.h"
+
+/**
+ * @file indexedHeap.h
+ * @brief Indexed d-ary heap with handle based priority updates
+ * @details Provides a priority queue that, unlike prique, can change or remove any
+ * element after insertion:
+ * - push() returns a handle that stays attached to its element while the element moves
+ * - decreaseKey()/increaseKey()/update() re-prioritize an element in O(log n)
+ * - erase() removes an element from anywhere in the heap in O(log n)
+ *
+ * Elements are stored in one contiguous array and sifted by moving, without polymorphic
+ * iterators. The arity is a template parameter: wider nodes make the heap shallower,
+ * so push() and decreaseKey() touch fewer levels, while pop() compares more children per level.
+ */
+
+namespace original {
+
+    /**
+     * @class indexedHeap
+     * @tparam TYPE Type of elements stored in the heap
+     * @tparam Callback Comparison functor type (default: increaseComparator)
+     * @tparam ARITY Number of children per node (default: 4, at least 2)
+     * @tparam ALLOC Allocator template for memory management (default: allocator)
+     * @brief Contiguous d-ary heap addressable through handles
+     * @extends container
+     * @extends printable
+     * @details The element for which the comparator holds against all others is on top,
+     * the same ordering as prique with the same comparator: increaseComparator keeps
+     * the smallest element on top.
+     *
+     * Every element carries its handle, and a handle-indexed position table is updated
+     * whenever an element moves, so handles are resolved in O(1). Handles of popped or
+     * erased elements are recycled by later pushes.
+     *
+     * Performance Characteristics:
+     * - push/decreaseKey: O(log_ARITY n)
+     * - pop/increaseKey/erase: O(ARITY log_ARITY n)
+     * - top/get: O(1)
+     *
+     * @note A handle is only valid while its element is in the heap; afterward it may
+     *       refer to a newer element. Check containsHandle() when in doubt.
+     */
+    template<typename TYPE,
+             template <typename> typename Callback = increaseComparator,
+             u_integer ARITY = 4,
+             template <typename> typename ALLOC = allocator>
+    requires Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+    class indexedHeap final : public container<TYPE, ALLOC<TYPE>>,
+                              public printable {
+    public:
+        /**
+         * @typedef handle
+         * @brief Identifies an element for its lifetime in the heap
+         */
+        using handle = u_integer;
+
+    private:
+        /**
+         * @struct heapEntry
+         * @brief Element stored together with its handle
+         */
+        struct heapEntry {
+            TYPE value_;        ///< Element
+            handle handle_;     ///< Handle of the element
+        };
+
+        using rebind_alloc_entry = typename ALLOC<TYPE>::template rebind_alloc<heapEntry>;   ///< Entry allocator type
+        using rebind_alloc_index = typename ALLOC<TYPE>::template rebind_alloc<u_integer>;   ///< Position allocator type
+
+        static constexpr u_integer NO_HANDLE = static_cast<u_integer>(-1);  ///< End of the free handle list
+
+        heapEntry* entries_;                ///< Heap ordered entries, size_ constructed
+        u_integer* positions_;              ///< Entry index per live handle, next free handle per free one
+        u_integer size_;                    ///< Number of elements
+        u_integer capacity_;                ///< Capacity of both arrays
+        u_integer handles_;                 ///< Number of handles ever issued, at most capacity_
+        handle free_;                       ///< Most recently freed handle
+        Callback<TYPE> compare_;            ///< Comparison functor instance for priority ordering
+        rebind_alloc_entry rebind_alloc_entry_{};   ///< Allocator for entries_
+        rebind_alloc_index rebind_alloc_index_{};   ///< Allocator for positions_
+
+        /**
+         * @brief Reallocates both arrays
+         * @param capacity New capacity, at least handles_
+         */
+        void reallocate(u_integer capacity);
+
+        /**
+         * @brief Places an entry at an index and records the index for its handle
+         * @param index Destination index, holding a constructed entry
+         * @param entry Entry to move there
+         */
+        void place(u_integer index, heapEntry&& entry);
+
+        /**
+         * @brief Moves the entry at an index toward the top while it outranks its parent
+         * @param index Index of the entry
+         */
+        void siftUp(u_integer index);
+
+        /**
+         * @brief Moves the entry at an index toward the leaves while a child outranks it
+         * @param index Index of the entry
+         */
+        void siftDown(u_integer index);
+
+        /**
+         * @brief Restores the heap order around an entry that changed in either direction
+         * @param index Index of the entry
+         */
+        void sift(u_integer index);
+
+        /**
+         * @brief Removes the entry at an index and releases its handle
+         * @param index Index of the entry
+         * @return The removed element
+         */
+        TYPE removeAt(u_integer index);
+
+        /**
+         * @brief Gets the entry index of a handle
+         * @param h Handle to resolve
+         * @return Entry index
+         * @throw noElementError if h does not refer to an element in the heap
+         */
+        u_integer indexOf(handle h) const;
+
+        /**
+         * @brief Releases all storage
+         */
+        void destroyHeap() noexcept;
+
+    public:
+        /**
+         * @brief Constructs an empty heap
+         * @param compare Comparison functor instance (default: default-constructed)
+         */
+        explicit indexedHeap(const Callback<TYPE>& compare = Callback<TYPE>{});
+
+        /**
+         * @brief Copy constructor
+         * @param other Heap to copy from
+         * @details Handles of other refer to the same elements in the copy.
+         */
+        indexedHeap(const indexedHeap& other);
+
+        /**
+         * @brief Copy assignment operator
+         * @param other Heap to copy from
+         * @return Reference to this heap
+         * @details Handles of other refer to the same elements in this heap.
+         */
+        indexedHeap& operator=(const indexedHeap& other);
+
+        /**
+         * @brief Move constructor
+         * @param other Heap to move from, left empty
+         */
+        indexedHeap(indexedHeap&& other) noexcept;
+
+        /**
+         * @brief Move assignment operator
+         * @param other Heap to move from, left empty
+         * @return Reference to this heap
+         */
+        indexedHeap& operator=(indexedHeap&& other) noexcept;
+
+        /**
+         * @brief Swaps contents with another heap in O(1)
+         * @param other Heap to swap with
+         */
+        void swap(indexedHeap& other) noexcept;
+
+        /**
+         * @brief Reserves storage so that pushes up to a size do not reallocate
+         * @param capacity Number of elements to reserve space for
+         */
+        void reserve(u_integer capacity);
+
+        /**
+         * @brief Gets number of elements
+         * @return Current size
+         */
+        [[nodiscard]] u_integer size() const override;
+
+        /**
+         * @brief Checks if an equal element is in the heap
+         * @param e Element to look for
+         * @return true if found
+         * @details Linear scan; use containsHandle() to check a handle in O(1).
+         */
+        bool contains(const TYPE& e) const override;
+
+        /**
+         * @brief Checks if a handle refers to an element in the heap
+         * @param h Handle to check
+         * @return true if h is valid
+         */
+        [[nodiscard]] bool containsHandle(handle h) const;
+
+        /**
+         * @brief Inserts an element
+         * @param e Element to insert
+         * @return Handle of the element
+         */
+        handle push(const TYPE& e);
+
+        /**
+         * @brief Extracts the highest priority element
+         * @return The extracted element
+         * @throw noElementError if the heap is empty
+         */
+        TYPE pop();
+
+        /**
+         * @brief Accesses the highest priority element
+         * @return Const reference to the top element
+         * @throw noElementError if the heap is empty
+         */
+        const TYPE& top() const;
+
+        /**
+         * @brief Gets the handle of the highest priority element
+         * @return Handle of the top element
+         * @throw noElementError if the heap is empty
+         */
+        [[nodiscard]] handle topHandle() const;
+
+        /**
+         * @brief Accesses an element by handle
+         * @param h Handle of the element
+         * @return Const reference to the element
+         * @throw noElementError if h is not valid
+         */
+        const TYPE& get(handle h) const;
+
+        /**
+         * @brief Raises the priority of an element
+         * @param h Handle of the element
+         * @param e New value, must not rank below the current one
+         * @throw noElementError if h is not valid
+         * @throw valueError if the comparator ranks the current value before e
+         * @details Only sifts toward the top, O(log_ARITY n).
+         */
+        void decreaseKey(handle h, const TYPE& e);
+
+        /**
+         * @brief Lowers the priority of an element
+         * @param h Handle of the element
+         * @param e New value, must not rank above the current one
+         * @throw noElementError if h is not valid
+         * @throw valueError if the comparator ranks e before the current value
+         * @details Only sifts toward the leaves, O(ARITY log_ARITY n).
+         */
+        void increaseKey(handle h, const TYPE& e);
+
+        /**
+         * @brief Replaces an element, moving it in whichever direction its priority changed
+         * @param h Handle of the element
+         * @param e New value
+         * @throw noElementError if h is not valid
+         */
+        void update(handle h, const TYPE& e);
+
+        /**
+         * @brief Removes an element by handle
+         * @param h Handle of the element, invalid afterward
+         * @return The removed element
+         * @throw noElementError if h is not valid
+         */
+        TYPE erase(handle h);
+
+        /**
+         * @brief Removes all elements and invalidates all handles, keeping the storage
+         */
+        void clear();
+
+        /**
+         * @brief Gets class name identifier
+         * @return "indexedHeap"
+         */
+        [[nodiscard]] std::string className() const override;
+
+        /**
+         * @brief Converts to string representation, elements in storage order
+         * @param enter Add newline if true
+         * @return String representation
+         */
+        [[nodiscard]] std::string toString(bool enter) const override;
+
+        /**
+         * @brief Destructor
+         */
+        ~indexedHeap() override;
+    };
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+void original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::reallocate(const u_integer capacity) {
+    heapEntry* entries = this->rebind_alloc_entry_.allocate(capacity);
+    u_integer* positions;
+    try {
+        positions = this->rebind_alloc_index_.allocate(capacity);
+    } catch (...) {
+        this->rebind_alloc_entry_.deallocate(entries, capacity);
+        throw;
+    }
+
+    for (u_integer i = 0; i < this->size_; ++i) {
+        this->rebind_alloc_entry_.construct(&entries[i], std::move(this->entries_[i]));
+        this->rebind_alloc_entry_.destroy(&this->entries_[i]);
+    }
+    for (u_integer i = 0; i < this->handles_; ++i) {
+        positions[i] = this->positions_[i];
+    }
+    if (this->entries_) {
+        this->rebind_alloc_entry_.deallocate(this->entries_, this->capacity_);
+        this->rebind_alloc_index_.deallocate(this->positions_, this->capacity_);
+    }
+    this->entries_ = entries;
+    this->positions_ = positions;
+    this->capacity_ = capacity;
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+void original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::place(const u_integer index, heapEntry&& entry) {
+    this->positions_[entry.handle_] = index;
+    this->entries_[index] = std::move(entry);
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+void original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::siftUp(u_integer index) {
+    if (index == 0 || !this->compare_(this->entries_[index].value_, this->entries_[(index - 1) / ARITY].value_)) {
+        return;
+    }
+
+    // Parents move down into the hole, the entry is written once at its final index
+    heapEntry moving = std::move(this->entries_[index]);
+    do {
+        const u_integer parent = (index - 1) / ARITY;
+        this->place(index, std::move(this->entries_[parent]));
+        index = parent;
+    } while (index > 0 && this->compare_(moving.value_, this->entries_[(index - 1) / ARITY].value_));
+    this->place(index, std::move(moving));
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+void original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::siftDown(u_integer index) {
+    heapEntry moving = std::move(this->entries_[index]);
+    while (true) {
+        const u_integer first = index * ARITY + 1;
+        if (first >= this->size_) {
+            break;
+        }
+
+        const u_integer last = this->size_ - first < ARITY ? this->size_ : first + ARITY;
+        u_integer best = first;
+        for (u_integer child = first + 1; child < last; ++child) {
+            if (this->compare_(this->entries_[child].value_, this->entries_[best].value_)) {
+                best = child;
+            }
+        }
+        if (!this->compare_(this->entries_[best].value_, moving.value_)) {
+            break;
+        }
+        this->place(index, std::move(this->entries_[best]));
+        index = best;
+    }
+    this->place(index, std::move(moving));
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+void original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::sift(const u_integer index) {
+    if (index > 0 && this->compare_(this->entries_[index].value_, this->entries_[(index - 1) / ARITY].value_)) {
+        this->siftUp(index);
+    } else {
+        this->siftDown(index);
+    }
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+TYPE original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::removeAt(const u_integer index) {
+    TYPE result = std::move(this->entries_[index].value_);
+    const handle h = this->entries_[index].handle_;
+    this->positions_[h] = this->free_;
+    this->free_ = h;
+
+    const u_integer last = this->size_ - 1;
+    if (index != last) {
+        this->place(index, std::move(this->entries_[last]));
+    }
+    this->rebind_alloc_entry_.destroy(&this->entries_[last]);
+    this->size_ -= 1;
+    if (index != last) {
+        this->sift(index);
+    }
+    return result;
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+original::u_integer original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::indexOf(const handle h) const {
+    if (!this->containsHandle(h)) {
+        throw noElementError();
+    }
+    return this->positions_[h];
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+void original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::destroyHeap() noexcept {
+    if (!this->entries_) {
+        return;
+    }
+
+    for (u_integer i = 0; i < this->size_; ++i) {
+        this->rebind_alloc_entry_.destroy(&this->entries_[i]);
+    }
+    this->rebind_alloc_entry_.deallocate(this->entries_, this->capacity_);
+    this->rebind_alloc_index_.deallocate(this->positions_, this->capacity_);
+    this->entries_ = nullptr;
+    this->positions_ = nullptr;
+    this->size_ = 0;
+    this->capacity_ = 0;
+    this->handles_ = 0;
+    this->free_ = NO_HANDLE;
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::indexedHeap(const Callback<TYPE>& compare)
+    : entries_(nullptr), positions_(nullptr), size_(0), capacity_(0),
+      handles_(0), free_(NO_HANDLE), compare_(compare) {}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::indexedHeap(const indexedHeap& other) : indexedHeap() {
+    this->operator=(other);
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+auto original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::operator=(const indexedHeap& other) -> indexedHeap& {
+    if (this == &other) {
+        return *this;
+    }
+
+    this->destroyHeap();
+    this->compare_ = other.compare_;
+    if constexpr (ALLOC<TYPE>::propagate_on_container_copy_assignment::value) {
+        this->allocator = other.allocator;
+        this->rebind_alloc_entry_ = other.rebind_alloc_entry_;
+        this->rebind_alloc_index_ = other.rebind_alloc_index_;
+    }
+    if (other.handles_ == 0) {
+        return *this;
+    }
+
+    this->reallocate(other.handles_);
+    for (; this->size_ < other.size_; ++this->size_) {
+        this->rebind_alloc_entry_.construct(&this->entries_[this->size_], other.entries_[this->size_]);
+    }
+    for (u_integer i = 0; i < other.handles_; ++i) {
+        this->positions_[i] = other.positions_[i];
+    }
+    this->handles_ = other.handles_;
+    this->free_ = other.free_;
+    return *this;
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::indexedHeap(indexedHeap&& other) noexcept : indexedHeap() {
+    this->operator=(std::move(other));
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+auto original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::operator=(indexedHeap&& other) noexcept -> indexedHeap& {
+    if (this == &other) {
+        return *this;
+    }
+
+    this->destroyHeap();
+    this->swap(other);
+    return *this;
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+void original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::swap(indexedHeap& other) noexcept {
+    if (this == &other) {
+        return;
+    }
+
+    std::swap(this->entries_, other.entries_);
+    std::swap(this->positions_, other.positions_);
+    std::swap(this->size_, other.size_);
+    std::swap(this->capacity_, other.capacity_);
+    std::swap(this->handles_, other.handles_);
+    std::swap(this->free_, other.free_);
+    std::swap(this->compare_, other.compare_);
+    std::swap(this->allocator, other.allocator);
+    std::swap(this->rebind_alloc_entry_, other.rebind_alloc_entry_);
+    std::swap(this->rebind_alloc_index_, other.rebind_alloc_index_);
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+void original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::reserve(const u_integer capacity) {
+    if (capacity > this->capacity_) {
+        this->reallocate(capacity);
+    }
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+original::u_integer original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::size() const {
+    return this->size_;
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+bool original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::contains(const TYPE& e) const {
+    for (u_integer i = 0; i < this->size_; ++i) {
+        if (this->entries_[i].value_ == e) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+bool original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::containsHandle(const handle h) const {
+    // A free handle's slot holds a free list link, and no entry carries a free handle
+    return h < this->handles_ && this->positions_[h] < this->size_
+           && this->entries_[this->positions_[h]].handle_ == h;
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+auto original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::push(const TYPE& e) -> handle {
+    if (this->size_ == this->capacity_) {
+        this->reallocate(this->capacity_ < 8 ? 16 : this->capacity_ * 2);
+    }
+
+    // Handles are only left over from removed elements while size_ < handles_ <= capacity_
+    handle h;
+    if (this->free_ != NO_HANDLE) {
+        h = this->free_;
+        this->free_ = this->positions_[h];
+    } else {
+        h = this->handles_;
+        this->handles_ += 1;
+    }
+    this->rebind_alloc_entry_.construct(&this->entries_[this->size_], heapEntry{e, h});
+    this->positions_[h] = this->size_;
+    this->size_ += 1;
+    this->siftUp(this->size_ - 1);
+    return h;
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+TYPE original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::pop() {
+    if (this->size_ == 0) {
+        throw noElementError();
+    }
+    return this->removeAt(0);
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+const TYPE& original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::top() const {
+    if (this->size_ == 0) {
+        throw noElementError();
+    }
+    return this->entries_[0].value_;
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+auto original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::topHandle() const -> handle {
+    if (this->size_ == 0) {
+        throw noElementError();
+    }
+    return this->entries_[0].handle_;
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+const TYPE& original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::get(const handle h) const {
+    return this->entries_[this->indexOf(h)].value_;
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+void original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::decreaseKey(const handle h, const TYPE& e) {
+    const u_integer index = this->indexOf(h);
+    if (this->compare_(this->entries_[index].value_, e)) {
+        throw valueError("decreaseKey: new value ranks below the current one");
+    }
+    this->entries_[index].value_ = e;
+    this->siftUp(index);
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+void original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::increaseKey(const handle h, const TYPE& e) {
+    const u_integer index = this->indexOf(h);
+    if (this->compare_(e, this->entries_[index].value_)) {
+        throw valueError("increaseKey: new value ranks above the current one");
+    }
+    this->entries_[index].value_ = e;
+    this->siftDown(index);
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+void original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::update(const handle h, const TYPE& e) {
+    const u_integer index = this->indexOf(h);
+    this->entries_[index].value_ = e;
+    this->sift(index);
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+TYPE original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::erase(const handle h) {
+    return this->removeAt(this->indexOf(h));
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+void original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::clear() {
+    for (u_integer i = 0; i < this->size_; ++i) {
+        this->rebind_alloc_entry_.destroy(&this->entries_[i]);
+    }
+    this->size_ = 0;
+    this->handles_ = 0;
+    this->free_ = NO_HANDLE;
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+std::string original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::className() const {
+    return "indexedHeap";
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+std::string original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::toString(const bool enter) const {
+    std::stringstream ss;
+    ss << this->className();
+    ss << "(";
+    for (u_integer i = 0; i < this->size_; ++i) {
+        if (i != 0) {
+            ss << ", ";
+        }
+        ss << printable::formatString(this->entries_[i].value_);
+    }
+    ss << ")";
+    if (enter)
+        ss << "\n";
+    return ss.str();
+}
+
+template<typename TYPE, template <typename> typename Callback, original::u_integer ARITY,
+         template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE> && (ARITY >= 2)
+original::indexedHeap<TYPE, Callback, ARITY, ALLOC>::~indexedHeap() {
+    this->destroyHeap();
+}
+
+#endif //INDEXED_HEAP_H
@@ -9,21 +9,25 @@
 #include "ownerPtr.h"
 #include "comparator.h"
 #include "RBTree.h"
+#include "BTree.h"
+#include "persistentTree.h"
 #include "skipList.h"
 
 
 /**
  * @file maps.h
  * @brief Implementation of map containers with different underlying data structures
- * @details Provides three map implementations with different performance characteristics
+ * @details Provides five map implementations with different performance characteristics
  * and iteration capabilities:
  * 1. hashMap - Hash table based implementation (unordered, fastest average case)
  * 2. treeMap - Red-Black Tree based implementation (ordered, consistent performance)
  * 3. JMap - Skip List based implementation (ordered, probabilistic balance)
+ * 4. btreeMap - B+ Tree based implementation (ordered, wide cache-friendly nodes)
+ * 5. persistentTreeMap - Path-copying AVL Tree based implementation (ordered, O(1) snapshots)
  *
  * Common Features:
  * - Key-value pair storage with unique keys
- * - Full iterator support with different capabilities
+ * - Full iterator support with different capabilities (visitor traversal for persistentTreeMap)
  * - Customizable comparison/hash functions
  * - Customizable allocators with propagation support
  * - Exception safety guarantees (basic guarantee for most operations)
@@ -40,6 +44,8 @@
  * | hashMap   | O(1) avg     | O(1)     | O(1)     | No      | Medium-High  | Forward-only  |
  * | treeMap   | O(log n)     | O(log n) | O(log n) | Yes     | Low          | Bidirectional |
  * | JMap      | O(log n) avg | O(log n) | O(log n) | Yes     | Medium       | Forward-only  |
+ * | btreeMap  | O(log n)     | O(log n) | O(log n) | Yes     | Low          | Bidirectional |
+ * | persistentTreeMap | O(log n) | O(log n) | O(log n) | Yes | Low, shared with snapshots | None (forEach) |
  *
  * Memory Characteristics:
  * | Container | Node Structure | Overhead | Rehashing | Balance Operations |
@@ -47,20 +53,26 @@
  * | hashMap   | Key-Value + Next | 1 pointer | Yes       | No                |
  * | treeMap   | Key-Value + Parent/Child/Color | 3 pointers + color | No | Yes (Red-Black) |
  * | JMap      | Key-Value + Multi-level links | ~2 pointers avg | No | Probabilistic |
+ * | btreeMap  | FANOUT Key-Values per leaf | ~1/FANOUT nodes per pair | No | Yes (split/merge) |
+ * | persistentTreeMap | Key-Value + Child links/Height/Refcount | 2 pointers + 2 counters | No | Yes (AVL, path copying) |
  *
  * Usage Guidelines:
  * - Use hashMap for maximum performance when key order doesn't matter and keys are hashable
  * - Use treeMap for ordered traversal, range queries, and consistent worst-case performance
  * - Use JMap for concurrent scenarios (external synchronization) or when probabilistic balance is preferred
+ * - Use btreeMap for large ordered maps where lookups are bound by cache misses, and for range scans
+ * - Use persistentTreeMap when readers need consistent views of a changing map without copying or locking
  *
  * Iterator Invalidation:
  * - hashMap: Iterators invalidate on rehash (insertion that causes capacity change)
  * - treeMap: Iterators invalidate on element removal that affects the current position
  * - JMap: Iterators invalidate on any structural modification
+ * - btreeMap: Iterators invalidate on any insertion or removal (pairs move between leaves)
+ * - persistentTreeMap: No iterators; snapshots are never invalidated by writes to their source
  *
  * Key Requirements:
  * - hashMap: Keys must be hashable (provide std::hash specialization or custom HASH)
- * - treeMap/JMap: Keys must be comparable (provide operator< or custom Compare)
+ * - treeMap/JMap/btreeMap/persistentTreeMap: Keys must be comparable (provide operator< or custom Compare)
  * - All keys must be copyable and movable
  * - Values must be default constructible for operator[] usage
  *
@@ -73,6 +85,8 @@
  * @see hashTable.h For hashMap implementation details
  * @see RBTree.h For treeMap implementation details
  * @see skipList.h For JMap implementation details
+ * @see BTree.h For btreeMap implementation details
+ * @see persistentTree.h For persistentTreeMap implementation details
  * @see printable.h For string formatting support
  * @see couple.h For key-value pair implementation
  */
@@ -283,6 +297,15 @@ namespace original {
              */
             explicit hashMap(HASH hash = HASH{}, ALLOC alloc = ALLOC{});
 
+            /**
+             * @brief Constructs empty hashMap sized for an expected number of pairs
+             * @param capacity Number of pairs to hold without rehashing
+             * @param hash Hash function to use
+             * @param alloc Allocator to use
+             * @see reserve
+             */
+            explicit hashMap(u_integer capacity, HASH hash = HASH{}, ALLOC alloc = ALLOC{});
+
             /**
              * @brief Copy constructor
              * @param other hashMap to copy
@@ -372,6 +395,34 @@ namespace original {
              */
             bool remove(const K_TYPE &k) override;
 
+            /**
+             * @brief Sizes the bucket array for an expected number of pairs
+             * @param expected Number of pairs to hold without rehashing
+             * @details Rehashes at most once; never shrinks the map. The reserved size
+             * is kept by later insertions and may only shrink again through remove().
+             * @note Invalidates all iterators if the map is rehashed
+             */
+            void reserve(u_integer expected);
+
+            /**
+             * @brief Adds all key-value pairs produced by a source
+             * @tparam SOURCE Range of couple<K_TYPE, V_TYPE>, e.g. any iterable or coroutine::generator
+             * @param source Pairs to add
+             * @param thread_cnt Number of threads that link the pairs into the buckets
+             * @return Number of pairs added
+             * @details Collects the pairs into nodes first, sizes the bucket array once for
+             * the final element count and then links all nodes, instead of running add() and
+             * its stepwise rehashing for each pair. Keys already in the map, and keys repeated
+             * in source, keep their first value, as with add().
+             *
+             * With thread_cnt > 1 the nodes are hash partitioned across threads that each own
+             * a contiguous bucket range; the result is the same as the sequential build.
+             * @note The parallel build requires HASH and key comparison to be safe to call
+             *       concurrently
+             */
+            template<typename SOURCE>
+            u_integer bulkInsert(SOURCE&& source, u_integer thread_cnt = 1);
+
             /**
              * @brief Checks if key exists
              * @param k Key to check
@@ -457,6 +508,8 @@ namespace original {
      * - Lookup: O(log n)
      * - Deletion: O(log n)
      * - Traversal: O(n)
+     * - Rank, select, iterator jumps and distance: O(log n)
+     * - Union, intersection, difference: O(m log(n / m + 1)) via join/split (parallel versions in parallelTrees.h)
      *
      * The implementation guarantees:
      * - Elements sorted by key according to comparator
@@ -548,17 +601,22 @@ namespace original {
         /**
          * @brief Advances iterator by steps
          * @param steps Number of positions to advance
+         * @details O(log n) for any step count, through the subtree sizes.
          */
         void operator+=(integer steps) const override;
 
         /**
          * @brief Rewinds iterator by steps
          * @param steps Number of positions to rewind
+         * @details O(log n) for any step count, through the subtree sizes.
          */
         void operator-=(integer steps) const override;
 
         /**
-         * @brief Not supported (throws unSupportedMethodError)
+         * @brief Gets the number of positions from other to this iterator
+         * @param other Iterator to measure from
+         * @return Distance in O(log n); an invalid iterator counts as one past the
+         * maximum key. Iterators of other containers give the max or min integer.
          */
         integer operator-(const iterator<couple<const K_TYPE, V_TYPE>> &other) const override;
 
@@ -640,6 +698,20 @@ namespace original {
          */
         explicit treeMap(Compare comp = Compare{}, ALLOC alloc = ALLOC{});
 
+        /**
+         * @brief Builds a treeMap from pairs sorted by key in O(n)
+         * @tparam SOURCE Range of couple<K_TYPE, V_TYPE> in ascending key order
+         * @param sorted Pairs to insert
+         * @param comp Comparison function to use; sorted must be ordered by it
+         * @param alloc Allocator to use
+         * @return New treeMap holding the pairs
+         * @throw valueError if sorted is not in ascending key order
+         * @details Links the nodes into a balanced, correctly colored tree directly,
+         * without per-pair descents or rotations. Repeated keys keep their first value.
+         */
+        template<typename SOURCE>
+        static treeMap fromSorted(SOURCE&& sorted, Compare comp = Compare{}, ALLOC alloc = ALLOC{});
+
         /**
          * @brief Copy constructor
          * @param other treeMap to copy
@@ -769,6 +841,61 @@ namespace original {
          */
         V_TYPE & operator[](const K_TYPE &k) override;
 
+        /**
+         * @brief Adds a batch of pairs sorted by key
+         * @tparam SOURCE Range of couple<K_TYPE, V_TYPE> in ascending key order
+         * @param sorted Pairs to add
+         * @return Number of pairs added
+         * @throw valueError if sorted is not in ascending key order; the map is unchanged
+         * @details Keys already in the map, and keys repeated in sorted, keep their first
+         * value, as with add(). An empty map is built in O(m); a batch that is large
+         * relative to the map is merged with the existing pairs and relinked in O(n + m);
+         * a small batch is inserted pair by pair in O(m log n).
+         * @note Iterators stay valid, as existing nodes are reused
+         */
+        template<typename SOURCE>
+        u_integer bulkLoad(SOURCE&& sorted);
+
+        /**
+         * @brief Gets the position a key has, or would have, in key order
+         * @param k Key to rank
+         * @return Number of keys ordered before k
+         * @details O(log n); k does not have to be present.
+         */
+        [[nodiscard]] u_integer rank(const K_TYPE& k) const;
+
+        /**
+         * @brief Gets the pair at a position in key order
+         * @param index Zero-based position
+         * @return Const reference to the pair with index smaller keys before it
+         * @throw outOfBoundError if index >= size()
+         * @details O(log n)
+         */
+        const couple<const K_TYPE, V_TYPE>& select(u_integer index) const;
+
+        /**
+         * @brief Adds every pair of another treeMap
+         * @param other treeMap ordered by the same comparison
+         * @details Join/split based: this tree is split at the keys of other and joined again,
+         * so keys present in both keep this treeMap's nodes, and values. O(m log(n / m + 1))
+         * for sizes m <= n. Iterators to the kept nodes stay valid.
+         */
+        void unionWith(const treeMap& other);
+
+        /**
+         * @brief Keeps only the pairs whose keys are also in another treeMap
+         * @param other treeMap ordered by the same comparison
+         * @details Join/split based like unionWith(). O(m log(n / m + 1))
+         */
+        void intersectWith(const treeMap& other);
+
+        /**
+         * @brief Removes the pairs whose keys are in another treeMap
+         * @param other treeMap ordered by the same comparison
+         * @details Join/split based like unionWith(). O(m log(n / m + 1))
+         */
+        void differenceWith(const treeMap& other);
+
         /**
          * @brief Gets begin iterator
          * @return New iterator at first element (minimum key)
@@ -1157,252 +1284,1554 @@ namespace original {
          */
         ~JMap() override;
     };
-}
 
-namespace std {
     /**
-     * @brief std::swap specialization for hashMap
-     * @tparam K_TYPE Key type (must be hashable and copyable)
-     * @tparam V_TYPE Value type (must be copyable and movable)
-     * @tparam HASH Hash function type (default: hash<K_TYPE>)
-     * @tparam ALLOC Allocator type for memory management
-     * @param lhs First hashMap to swap
-     * @param rhs Second hashMap to swap
-     * @note No-throw guarantee if hashMap::swap is noexcept
-     * @details Provides standard library integration for hashMap by specializing
-     * std::swap. This enables:
-     * - ADL-friendly swapping in generic code
-     * - Use with standard algorithms (std::sort, std::rotate, etc.)
-     * - Consistent behavior with standard containers
+     * @class btreeMap
+     * @tparam K_TYPE Key type (must be comparable)
+     * @tparam V_TYPE Value type
+     * @tparam Compare Comparison function type (default: increaseComparator<K_TYPE>)
+     * @tparam ALLOC Allocator type (default: allocator<couple<const K_TYPE, V_TYPE>>)
+     * @tparam FANOUT Node width of the underlying B+ Tree (default: 32, even and >= 4)
+     * @brief B+ Tree based implementation of the map interface
+     * @details This class provides a concrete implementation of the map interface
+     * using a B+ Tree. It combines the functionality of:
+     * - map (interface)
+     * - BTree (storage)
+     * - iterable (iteration support)
      *
-     * The implementation delegates to hashMap::swap() to ensure proper handling of:
-     * - Bucket array exchange
-     * - Size counter swapping
-     * - Hash function transfer
-     * - Allocator propagation according to ALLOC traits
+     * Performance Characteristics:
+     * - Insertion: O(log n)
+     * - Lookup: O(log n), one node per tree level instead of one per comparison
+     * - Deletion: O(log n)
+     * - Traversal: O(n) along linked leaves
+     * - Range scan: O(log n + k) via forEachInRange()
      *
-     * Iterator Invalidation: All iterators from both maps are invalidated
-     * Exception Safety: No-throw if hashMap::swap is noexcept
+     * The implementation guarantees:
+     * - Elements sorted by key according to comparator
+     * - Unique keys (no duplicates)
+     * - Type safety
+     * - Exception safety (basic guarantee)
+     * - Iterator validity unless modified
      *
-     * @see hashMap::swap For the underlying swap implementation
-     * @see std::swap For the general swap algorithm
-     * @see <algorithm> For standard algorithms that use swap
+     * @note Unlike treeMap, insertions and removals move pairs within and between leaves,
+     *       so any modification invalidates iterators and references to values.
      */
-    template <typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-    void swap(original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>& lhs, // NOLINT
-              original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>& rhs) noexcept;
+    template <typename K_TYPE,
+              typename V_TYPE,
+              typename Compare = increaseComparator<K_TYPE>,
+              typename ALLOC = allocator<couple<const K_TYPE, V_TYPE>>,
+              u_integer FANOUT = 32>
+    class btreeMap final : public BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>,
+                           public map<K_TYPE, V_TYPE, ALLOC>,
+                           public iterable<couple<const K_TYPE, V_TYPE>>,
+                           public printable {
 
-    /**
-     * @brief std::swap specialization for treeMap
-     * @tparam K_TYPE Key type (must be comparable and copyable)
-     * @tparam V_TYPE Value type (must be copyable and movable)
-     * @tparam COMPARE Comparison function type (default: increaseComparator<K_TYPE>)
-     * @tparam ALLOC Allocator type for memory management
-     * @param lhs First treeMap to swap
-     * @param rhs Second treeMap to swap
-     * @note No-throw guarantee if treeMap::swap is noexcept
-     * @details Provides standard library integration for treeMap by specializing
-     * std::swap. This enables consistent behavior with standard ordered containers
-     * like std::map and std::set.
-     *
-     * The implementation delegates to treeMap::swap() to ensure proper handling of:
-     * - Red-Black tree root node exchange
-     * - Size counter swapping
-     * - Comparison function transfer
-     * - Allocator propagation according to ALLOC traits
-     *
-     * Iterator Invalidation: All iterators from both maps are invalidated
-     * Exception Safety: No-throw if treeMap::swap is noexcept
-     * Order Preservation: Both maps maintain their key ordering after swap
-     *
-     * @see treeMap::swap For the underlying swap implementation
-     * @see std::map For the standard ordered map comparison
-     * @see std::swap For the general swap algorithm
-     */
-    template <typename K_TYPE, typename V_TYPE, typename COMPARE, typename ALLOC>
-    void swap(original::treeMap<K_TYPE, V_TYPE, COMPARE, ALLOC>& lhs, // NOLINT
-              original::treeMap<K_TYPE, V_TYPE, COMPARE, ALLOC>& rhs) noexcept;
+        /**
+         * @typedef BTreeType
+         * @brief Alias for the underlying B+ tree implementation.
+         */
+        using BTreeType = BTree<K_TYPE, V_TYPE, ALLOC, Compare, FANOUT>;
 
-    /**
-     * @brief std::swap specialization for JMap
-     * @tparam K_TYPE Key type (must be comparable and copyable)
-     * @tparam V_TYPE Value type (must be copyable and movable)
-     * @tparam COMPARE Comparison function type (default: increaseComparator<K_TYPE>)
-     * @tparam ALLOC Allocator type for memory management
-     * @param lhs First JMap to swap
-     * @param rhs Second JMap to swap
-     * @note No-throw guarantee if JMap::swap is noexcept
-     * @details Provides standard library integration for JMap by specializing
-     * std::swap. This enables probabilistic skip list containers to work seamlessly
-     * with standard C++ algorithms and generic programming patterns.
-     *
-     * The implementation delegates to JMap::swap() to ensure proper handling of:
-     * - Skip list head node exchange (entire multi-level structure)
-     * - Size counter swapping
-     * - Comparison function transfer
-     * - Allocator propagation according to ALLOC traits
-     *
-     * Iterator Invalidation: All iterators from both maps are invalidated
-     * Exception Safety: No-throw if JMap::swap is noexcept
-     * Probabilistic Structure: Both skip lists maintain their level distributions
-     *
-     * @see JMap::swap For the underlying swap implementation
-     * @see skipList For the underlying probabilistic data structure
-     * @see std::swap For the general swap algorithm
-     */
-    template <typename K_TYPE, typename V_TYPE, typename COMPARE, typename ALLOC>
-    void swap(original::JMap<K_TYPE, V_TYPE, COMPARE, ALLOC>& lhs, // NOLINT
-              original::JMap<K_TYPE, V_TYPE, COMPARE, ALLOC>& rhs) noexcept;
-}
+        /**
+         * @typedef leafNode
+         * @brief Leaf node type of the B+ Tree storage
+         */
+        using leafNode = BTreeType::leafNode;
+    public:
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::Iterator(
-    vector<hashNode *, rebind_alloc_pointer> *buckets, u_integer bucket, hashNode *node)
-    : hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::Iterator(
-        const_cast<vector<hashNode*, rebind_alloc_pointer>*>(buckets), bucket, node) {}
+        /**
+         * @class Iterator
+         * @brief Bidirectional iterator for btreeMap
+         * @details Provides iteration over btreeMap elements while maintaining:
+         * - Sorted traversal order (according to comparator)
+         * - Safe invalidation detection
+         * - Const-correct access
+         *
+         * Iterator Characteristics:
+         * - Both forward and backward iteration along the linked leaves
+         * - Invalidates on map modification
+         * - Lightweight copy semantics
+         */
+        class Iterator final : public BTreeType::Iterator,
+                               public baseIterator<couple<const K_TYPE, V_TYPE>> {
+            /**
+             * @brief Constructs iterator pointing to a pair in a leaf
+             * @param tree Pointer to owning tree
+             * @param leaf Current leaf
+             * @param index Position in the leaf
+             * @note Internal constructor, not meant for direct use
+             */
+            explicit Iterator(BTreeType* tree, leafNode* leaf, u_integer index);
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-bool original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::equalPtr(
-        const iterator<couple<const K_TYPE, V_TYPE>>* other) const {
-    auto other_it = dynamic_cast<const Iterator*>(other);
-    return other_it &&
-           this->p_buckets == other_it->p_buckets &&
-           this->cur_bucket == other_it->cur_bucket &&
-           this->p_node == other_it->p_node;
-}
+            /**
+             * @brief Compares iterator pointers for equality
+             * @param other Iterator to compare with
+             * @return true if iterators point to same element
+             * @internal
+             */
+            bool equalPtr(const iterator<couple<const K_TYPE, V_TYPE>>* other) const override;
+        public:
+            friend class btreeMap;
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::Iterator(const Iterator &other) : Iterator() {
-    this->operator=(other);
-}
+            /**
+             * @brief Copy constructor
+             * @param other Iterator to copy
+             */
+            Iterator(const Iterator& other);
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator&
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::operator=(const Iterator &other) {
-    if (this == &other)
-        return *this;
+            /**
+             * @brief Copy assignment operator
+             * @param other Iterator to copy
+             * @return Reference to this iterator
+             */
+            Iterator& operator=(const Iterator& other);
 
-    hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::Iterator::operator=(other);
-    return *this;
-}
+            /**
+             * @brief Creates a copy of this iterator
+             * @return New iterator instance
+             */
+            Iterator* clone() const override;
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator*
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::clone() const {
-    return new Iterator(*this);
-}
+            /**
+             * @brief Gets iterator class name
+             * @return "btreeMap::Iterator"
+             */
+            [[nodiscard]] std::string className() const override;
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-std::string original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::className() const {
-    return "hashMap::Iterator";
-}
+            /**
+             * @brief Advances iterator by steps
+             * @param steps Number of positions to advance
+             */
+            void operator+=(integer steps) const override;
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-void original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::operator+=(integer steps) const {
-    hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::Iterator::operator+=(steps);
-}
+            /**
+             * @brief Rewinds iterator by steps
+             * @param steps Number of positions to rewind
+             */
+            void operator-=(integer steps) const override;
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-void original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::operator-=(integer) const {
-    throw unSupportedMethodError();
-}
+            /**
+             * @brief Not supported (throws unSupportedMethodError)
+             */
+            integer operator-(const iterator<couple<const K_TYPE, V_TYPE>> &other) const override;
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-original::integer original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::operator-(
-        const iterator<couple<const K_TYPE, V_TYPE>>&) const {
-    throw unSupportedMethodError();
-}
+            /**
+             * @brief Checks if more elements exist in forward direction
+             * @return true if more elements available
+             */
+            [[nodiscard]] bool hasNext() const override;
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-bool original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::hasNext() const {
-    return hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::Iterator::hasNext();
+            /**
+             * @brief Checks if more elements exist in backward direction
+             * @return true if more elements available
+             */
+            [[nodiscard]] bool hasPrev() const override;
+
+            /**
+             * @brief Checks if other is previous to this
+             * @param other Iterator to check
+             * @return true if other is previous
+             */
+            bool atPrev(const iterator<couple<const K_TYPE, V_TYPE>>* other) const override;
+
+            /**
+             * @brief Checks if other is next to this
+             * @param other Iterator to check
+             * @return true if other is next
+             */
+            bool atNext(const iterator<couple<const K_TYPE, V_TYPE>>* other) const override;
+
+            /**
+             * @brief Moves to next element
+             */
+            void next() const override;
+
+            /**
+             * @brief Moves to previous element
+             */
+            void prev() const override;
+
+            /**
+             * @brief Gets previous iterator
+             * @return New iterator at previous position
+             */
+            Iterator* getPrev() const override;
+
+            /**
+             * @brief Gets current element (non-const)
+             * @return Reference to current key-value pair
+             */
+            couple<const K_TYPE, V_TYPE>& get() override;
+
+            /**
+             * @brief Gets current element (const)
+             * @return Copy of current key-value pair
+             */
+            couple<const K_TYPE, V_TYPE> get() const override;
+
+            /**
+             * @brief Not supported
+             * @throw unSupportedMethodError
+             */
+            void set(const couple<const K_TYPE, V_TYPE> &data) override;
+
+            /**
+             * @brief Checks if iterator is valid
+             * @return true if iterator points to valid element
+             */
+            [[nodiscard]] bool isValid() const override;
+
+            ~Iterator() override = default;
+        };
+
+        friend class Iterator;
+
+        /**
+         * @brief Constructs empty btreeMap
+         * @param comp Comparison function to use
+         * @param alloc Allocator to use
+         */
+        explicit btreeMap(Compare comp = Compare{}, ALLOC alloc = ALLOC{});
+
+        /**
+         * @brief Copy constructor
+         * @param other btreeMap to copy
+         * @details Copies the tree node by node, without re-inserting pairs
+         * @note Allocator is copied if propagate_on_container_copy_assignment is true
+         */
+        btreeMap(const btreeMap& other);
+
+        /**
+         * @brief Copy assignment operator
+         * @param other btreeMap to copy
+         * @return Reference to this btreeMap
+         * @details Copies the tree node by node, without re-inserting pairs
+         * @note Allocator is copied if propagate_on_container_copy_assignment is true
+         */
+        btreeMap& operator=(const btreeMap& other);
+
+        /**
+         * @brief Move constructor
+         * @param other btreeMap to move from
+         * @details Transfers ownership of resources from other
+         * @note Leaves other in valid but unspecified state
+         */
+        btreeMap(btreeMap&& other) noexcept;
+
+        /**
+         * @brief Move assignment operator
+         * @param other btreeMap to move from
+         * @return Reference to this btreeMap
+         * @details Transfers ownership of resources from other
+         * @note Leaves other in valid but unspecified state
+         * @note Allocator is moved if propagate_on_container_move_assignment is true
+         */
+        btreeMap& operator=(btreeMap&& other) noexcept;
+
+        /**
+         * @brief Swaps contents with another btreeMap
+         * @param other btreeMap to swap with
+         * @details Exchanges roots, leaf list ends, size counters, comparison functions
+         * and allocators (if ALLOC::propagate_on_container_swap::value is true) in O(1).
+         * All iterators from both maps are invalidated.
+         */
+        void swap(btreeMap& other) noexcept;
+
+        /**
+         * @brief Gets number of elements
+         * @return Current size
+         */
+        [[nodiscard]] u_integer size() const override;
+
+        /**
+         * @brief Checks if key-value pair exists
+         * @param e Pair to check
+         * @return true if both key exists and value matches
+         */
+        bool contains(const couple<const K_TYPE, V_TYPE> &e) const override;
+
+        /**
+         * @brief Adds new key-value pair
+         * @param k Key to add
+         * @param v Value to associate
+         * @return true if added, false if key existed
+         */
+        bool add(const K_TYPE &k, const V_TYPE &v) override;
+
+        /**
+         * @brief Removes key-value pair
+         * @param k Key to remove
+         * @return true if removed, false if key didn't exist
+         */
+        bool remove(const K_TYPE &k) override;
+
+        /**
+         * @brief Checks if key exists
+         * @param k Key to check
+         * @return true if key exists
+         */
+        [[nodiscard]] bool containsKey(const K_TYPE &k) const override;
+
+        /**
+         * @brief Gets value for key
+         * @param k Key to lookup
+         * @return Associated value
+         * @throw noElementError if key doesn't exist
+         */
+        V_TYPE get(const K_TYPE &k) const override;
+
+        /**
+         * @brief Updates value for existing key
+         * @param key Key to update
+         * @param value New value
+         * @return true if updated, false if key didn't exist
+         */
+        bool update(const K_TYPE &key, const V_TYPE &value) override;
+
+        /**
+         * @brief Const element access
+         * @param k Key to access
+         * @return const reference to value
+         * @throw noElementError if key doesn't exist
+         */
+        const V_TYPE & operator[](const K_TYPE &k) const override;
+
+        /**
+         * @brief Non-const element access
+         * @param k Key to access
+         * @return reference to value
+         * @note Inserts default-constructed value if key doesn't exist
+         */
+        V_TYPE & operator[](const K_TYPE &k) override;
+
+        /**
+         * @brief Visits the pairs with keys in [low, high) in key order
+         * @tparam Callback Callable invocable with const couple<const K_TYPE, V_TYPE>&
+         * @param low Inclusive lower bound
+         * @param high Exclusive upper bound
+         * @param operation Visitor
+         * @details Descends once to low, then walks the linked leaves sequentially.
+         */
+        template<typename Callback>
+        void forEachInRange(const K_TYPE& low, const K_TYPE& high, Callback operation) const;
+
+        /**
+         * @brief Gets begin iterator
+         * @return New iterator at first element (minimum key)
+         */
+        Iterator* begins() const override;
+
+        /**
+         * @brief Gets end iterator
+         * @return New iterator at last element (maximum key)
+         */
+        Iterator* ends() const override;
+
+        /**
+         * @brief Gets class name
+         * @return "btreeMap"
+         */
+        [[nodiscard]] std::string className() const override;
+
+        /**
+         * @brief Converts to string representation
+         * @param enter Add newline if true
+         * @return String representation of key-value pairs
+         */
+        [[nodiscard]] std::string toString(bool enter) const override;
+
+        /**
+         * @brief Destructor
+         * @details Cleans up all tree nodes and allocated memory
+         */
+        ~btreeMap() override;
+    };
+
+    /**
+     * @class persistentTreeMap
+     * @tparam K_TYPE Key type (must be comparable)
+     * @tparam V_TYPE Value type
+     * @tparam Compare Comparison function type (default: increaseComparator<K_TYPE>)
+     * @tparam ALLOC Allocator type (default: allocator<couple<const K_TYPE, V_TYPE>>)
+     * @brief Persistent AVL Tree based implementation of the map interface with O(1) snapshots
+     * @details This class provides a concrete implementation of the map interface
+     * using a path-copying AVL Tree. It combines the functionality of:
+     * - map (interface)
+     * - persistentTree (storage)
+     *
+     * snapshot() and copying take another reference to the root in O(1). Both maps then share
+     * every node, and each later write copies only the O(log n) nodes on its path, so every
+     * snapshot keeps the contents it was taken with and stays valid after the source map
+     * changes or is destroyed. Writes to a map without live snapshots copy nothing.
+     *
+     * Performance Characteristics:
+     * - Snapshot/Copy: O(1)
+     * - Insertion: O(log n), plus O(log n) node copies while shared with a snapshot
+     * - Lookup: O(log n), never copies
+     * - Deletion: O(log n), plus O(log n) node copies while shared with a snapshot
+     * - Traversal: O(n) via forEach(), range scan O(log n + k) via forEachInRange()
+     *
+     * Thread Safety:
+     * - Writes and snapshot() on the same map must be externally synchronized
+     * - A snapshot is a separate map: threads can read and destroy their own snapshots while
+     *   the source map is modified, without locking, because shared nodes are never changed
+     *   and are reference counted atomically
+     * - The allocator may then free nodes on any thread and must allow that
+     *
+     * @note Nodes have no parent pointers so that they can be shared, therefore the map is
+     *       traversed with forEach() and forEachInRange() instead of iterators.
+     * @note References returned by the non-const operator[] are invalidated by any later
+     *       write or snapshot() of the map.
+     * @note Snapshots share the node allocator of their source regardless of the allocator
+     *       propagation traits, since either of them may free the shared nodes.
+     */
+    template <typename K_TYPE,
+              typename V_TYPE,
+              typename Compare = increaseComparator<K_TYPE>,
+              typename ALLOC = allocator<couple<const K_TYPE, V_TYPE>>>
+    class persistentTreeMap final : public persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>,
+                                    public map<K_TYPE, V_TYPE, ALLOC>,
+                                    public printable {
+
+        /**
+         * @typedef persistentTreeType
+         * @brief Alias for the underlying persistent tree implementation.
+         */
+        using persistentTreeType = persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>;
+    public:
+
+        /**
+         * @brief Constructs empty persistentTreeMap
+         * @param comp Comparison function to use
+         * @param alloc Allocator to use
+         */
+        explicit persistentTreeMap(Compare comp = Compare{}, ALLOC alloc = ALLOC{});
+
+        /**
+         * @brief Copy constructor
+         * @param other persistentTreeMap to copy
+         * @details Shares all nodes of other in O(1), same as other.snapshot()
+         */
+        persistentTreeMap(const persistentTreeMap& other);
+
+        /**
+         * @brief Copy assignment operator
+         * @param other persistentTreeMap to copy
+         * @return Reference to this persistentTreeMap
+         * @details Releases the current contents and shares all nodes of other in O(1)
+         */
+        persistentTreeMap& operator=(const persistentTreeMap& other);
+
+        /**
+         * @brief Move constructor
+         * @param other persistentTreeMap to move from
+         * @details Transfers ownership of resources from other
+         * @note Leaves other empty
+         */
+        persistentTreeMap(persistentTreeMap&& other) noexcept;
+
+        /**
+         * @brief Move assignment operator
+         * @param other persistentTreeMap to move from
+         * @return Reference to this persistentTreeMap
+         * @details Transfers ownership of resources from other
+         * @note Leaves other empty
+         */
+        persistentTreeMap& operator=(persistentTreeMap&& other) noexcept;
+
+        /**
+         * @brief Swaps contents with another persistentTreeMap in O(1)
+         * @param other persistentTreeMap to swap with
+         */
+        void swap(persistentTreeMap& other) noexcept;
+
+        /**
+         * @brief Takes an immutable view of the current contents in O(1)
+         * @return Map sharing all nodes with this map
+         * @details Later writes to either map copy the nodes they touch and leave the other
+         * map unchanged, so the snapshot can be handed to reader threads as is.
+         */
+        [[nodiscard]] persistentTreeMap snapshot() const;
+
+        /**
+         * @brief Gets number of elements
+         * @return Current size
+         */
+        [[nodiscard]] u_integer size() const override;
+
+        /**
+         * @brief Checks if key-value pair exists
+         * @param e Pair to check
+         * @return true if both key exists and value matches
+         */
+        bool contains(const couple<const K_TYPE, V_TYPE> &e) const override;
+
+        /**
+         * @brief Adds new key-value pair
+         * @param k Key to add
+         * @param v Value to associate
+         * @return true if added, false if key existed
+         */
+        bool add(const K_TYPE &k, const V_TYPE &v) override;
+
+        /**
+         * @brief Removes key-value pair
+         * @param k Key to remove
+         * @return true if removed, false if key didn't exist
+         */
+        bool remove(const K_TYPE &k) override;
+
+        /**
+         * @brief Checks if key exists
+         * @param k Key to check
+         * @return true if key exists
+         */
+        [[nodiscard]] bool containsKey(const K_TYPE &k) const override;
+
+        /**
+         * @brief Gets value for key
+         * @param k Key to lookup
+         * @return Associated value
+         * @throw noElementError if key doesn't exist
+         */
+        V_TYPE get(const K_TYPE &k) const override;
+
+        /**
+         * @brief Updates value for existing key
+         * @param key Key to update
+         * @param value New value
+         * @return true if updated, false if key didn't exist
+         */
+        bool update(const K_TYPE &key, const V_TYPE &value) override;
+
+        /**
+         * @brief Const element access
+         * @param k Key to access
+         * @return const reference to value
+         * @throw noElementError if key doesn't exist
+         */
+        const V_TYPE & operator[](const K_TYPE &k) const override;
+
+        /**
+         * @brief Non-const element access
+         * @param k Key to access
+         * @return reference to value
+         * @details Copies the path to the key if it is shared with a snapshot.
+         * @note Inserts default-constructed value if key doesn't exist
+         */
+        V_TYPE & operator[](const K_TYPE &k) override;
+
+        /**
+         * @brief Visits every pair in key order
+         * @tparam Callback Callable invocable with const couple<const K_TYPE, V_TYPE>&
+         * @param operation Visitor
+         */
+        template<typename Callback>
+        void forEach(Callback operation) const;
+
+        /**
+         * @brief Visits the pairs with keys in [low, high) in key order
+         * @tparam Callback Callable invocable with const couple<const K_TYPE, V_TYPE>&
+         * @param low Inclusive lower bound
+         * @param high Exclusive upper bound
+         * @param operation Visitor
+         * @details Skips the subtrees outside the range, O(log n + k).
+         */
+        template<typename Callback>
+        void forEachInRange(const K_TYPE& low, const K_TYPE& high, Callback operation) const;
+
+        /**
+         * @brief Gets class name
+         * @return "persistentTreeMap"
+         */
+        [[nodiscard]] std::string className() const override;
+
+        /**
+         * @brief Converts to string representation
+         * @param enter Add newline if true
+         * @return String representation of key-value pairs
+         */
+        [[nodiscard]] std::string toString(bool enter) const override;
+
+        /**
+         * @brief Destructor
+         * @details Releases the root; nodes still shared with snapshots are kept alive
+         */
+        ~persistentTreeMap() override;
+    };
+}
+
+namespace std {
+    /**
+     * @brief std::swap specialization for hashMap
+     * @tparam K_TYPE Key type (must be hashable and copyable)
+     * @tparam V_TYPE Value type (must be copyable and movable)
+     * @tparam HASH Hash function type (default: hash<K_TYPE>)
+     * @tparam ALLOC Allocator type for memory management
+     * @param lhs First hashMap to swap
+     * @param rhs Second hashMap to swap
+     * @note No-throw guarantee if hashMap::swap is noexcept
+     * @details Provides standard library integration for hashMap by specializing
+     * std::swap. This enables:
+     * - ADL-friendly swapping in generic code
+     * - Use with standard algorithms (std::sort, std::rotate, etc.)
+     * - Consistent behavior with standard containers
+     *
+     * The implementation delegates to hashMap::swap() to ensure proper handling of:
+     * - Bucket array exchange
+     * - Size counter swapping
+     * - Hash function transfer
+     * - Allocator propagation according to ALLOC traits
+     *
+     * Iterator Invalidation: All iterators from both maps are invalidated
+     * Exception Safety: No-throw if hashMap::swap is noexcept
+     *
+     * @see hashMap::swap For the underlying swap implementation
+     * @see std::swap For the general swap algorithm
+     * @see <algorithm> For standard algorithms that use swap
+     */
+    template <typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+    void swap(original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>& lhs, // NOLINT
+              original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>& rhs) noexcept;
+
+    /**
+     * @brief std::swap specialization for treeMap
+     * @tparam K_TYPE Key type (must be comparable and copyable)
+     * @tparam V_TYPE Value type (must be copyable and movable)
+     * @tparam COMPARE Comparison function type (default: increaseComparator<K_TYPE>)
+     * @tparam ALLOC Allocator type for memory management
+     * @param lhs First treeMap to swap
+     * @param rhs Second treeMap to swap
+     * @note No-throw guarantee if treeMap::swap is noexcept
+     * @details Provides standard library integration for treeMap by specializing
+     * std::swap. This enables consistent behavior with standard ordered containers
+     * like std::map and std::set.
+     *
+     * The implementation delegates to treeMap::swap() to ensure proper handling of:
+     * - Red-Black tree root node exchange
+     * - Size counter swapping
+     * - Comparison function transfer
+     * - Allocator propagation according to ALLOC traits
+     *
+     * Iterator Invalidation: All iterators from both maps are invalidated
+     * Exception Safety: No-throw if treeMap::swap is noexcept
+     * Order Preservation: Both maps maintain their key ordering after swap
+     *
+     * @see treeMap::swap For the underlying swap implementation
+     * @see std::map For the standard ordered map comparison
+     * @see std::swap For the general swap algorithm
+     */
+    template <typename K_TYPE, typename V_TYPE, typename COMPARE, typename ALLOC>
+    void swap(original::treeMap<K_TYPE, V_TYPE, COMPARE, ALLOC>& lhs, // NOLINT
+              original::treeMap<K_TYPE, V_TYPE, COMPARE, ALLOC>& rhs) noexcept;
+
+    /**
+     * @brief std::swap specialization for JMap
+     * @tparam K_TYPE Key type (must be comparable and copyable)
+     * @tparam V_TYPE Value type (must be copyable and movable)
+     * @tparam COMPARE Comparison function type (default: increaseComparator<K_TYPE>)
+     * @tparam ALLOC Allocator type for memory management
+     * @param lhs First JMap to swap
+     * @param rhs Second JMap to swap
+     * @note No-throw guarantee if JMap::swap is noexcept
+     * @details Provides standard library integration for JMap by specializing
+     * std::swap. This enables probabilistic skip list containers to work seamlessly
+     * with standard C++ algorithms and generic programming patterns.
+     *
+     * The implementation delegates to JMap::swap() to ensure proper handling of:
+     * - Skip list head node exchange (entire multi-level structure)
+     * - Size counter swapping
+     * - Comparison function transfer
+     * - Allocator propagation according to ALLOC traits
+     *
+     * Iterator Invalidation: All iterators from both maps are invalidated
+     * Exception Safety: No-throw if JMap::swap is noexcept
+     * Probabilistic Structure: Both skip lists maintain their level distributions
+     *
+     * @see JMap::swap For the underlying swap implementation
+     * @see skipList For the underlying probabilistic data structure
+     * @see std::swap For the general swap algorithm
+     */
+    template <typename K_TYPE, typename V_TYPE, typename COMPARE, typename ALLOC>
+    void swap(original::JMap<K_TYPE, V_TYPE, COMPARE, ALLOC>& lhs, // NOLINT
+              original::JMap<K_TYPE, V_TYPE, COMPARE, ALLOC>& rhs) noexcept;
+
+    /**
+     * @brief std::swap specialization for btreeMap
+     * @tparam K_TYPE Key type (must be comparable and copyable)
+     * @tparam V_TYPE Value type (must be copyable and movable)
+     * @tparam COMPARE Comparison function type (default: increaseComparator<K_TYPE>)
+     * @tparam ALLOC Allocator type for memory management
+     * @tparam FANOUT Node width of the underlying B+ Tree
+     * @param lhs First btreeMap to swap
+     * @param rhs Second btreeMap to swap
+     * @note No-throw guarantee if btreeMap::swap is noexcept
+     * @details Delegates to btreeMap::swap(). All iterators from both maps are invalidated.
+     * @see btreeMap::swap For the underlying swap implementation
+     */
+    template <typename K_TYPE, typename V_TYPE, typename COMPARE, typename ALLOC, original::u_integer FANOUT>
+    void swap(original::btreeMap<K_TYPE, V_TYPE, COMPARE, ALLOC, FANOUT>& lhs, // NOLINT
+              original::btreeMap<K_TYPE, V_TYPE, COMPARE, ALLOC, FANOUT>& rhs) noexcept;
+
+    /**
+     * @brief std::swap specialization for persistentTreeMap
+     * @tparam K_TYPE Key type (must be comparable and copyable)
+     * @tparam V_TYPE Value type (must be copyable and movable)
+     * @tparam COMPARE Comparison function type (default: increaseComparator<K_TYPE>)
+     * @tparam ALLOC Allocator type for memory management
+     * @param lhs First persistentTreeMap to swap
+     * @param rhs Second persistentTreeMap to swap
+     * @details Delegates to persistentTreeMap::swap(). Snapshots of either map are unaffected.
+     * @see persistentTreeMap::swap For the underlying swap implementation
+     */
+    template <typename K_TYPE, typename V_TYPE, typename COMPARE, typename ALLOC>
+    void swap(original::persistentTreeMap<K_TYPE, V_TYPE, COMPARE, ALLOC>& lhs, // NOLINT
+              original::persistentTreeMap<K_TYPE, V_TYPE, COMPARE, ALLOC>& rhs) noexcept;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::Iterator(
+    vector<hashNode *, rebind_alloc_pointer> *buckets, u_integer bucket, hashNode *node)
+    : hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::Iterator(
+        const_cast<vector<hashNode*, rebind_alloc_pointer>*>(buckets), bucket, node) {}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::equalPtr(
+        const iterator<couple<const K_TYPE, V_TYPE>>* other) const {
+    auto other_it = dynamic_cast<const Iterator*>(other);
+    return other_it &&
+           this->p_buckets == other_it->p_buckets &&
+           this->cur_bucket == other_it->cur_bucket &&
+           this->p_node == other_it->p_node;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::Iterator(const Iterator &other) : Iterator() {
+    this->operator=(other);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator&
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::operator=(const Iterator &other) {
+    if (this == &other)
+        return *this;
+
+    hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::Iterator::operator=(other);
+    return *this;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator*
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::clone() const {
+    return new Iterator(*this);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+std::string original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::className() const {
+    return "hashMap::Iterator";
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+void original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::operator+=(integer steps) const {
+    hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::Iterator::operator+=(steps);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+void original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::operator-=(integer) const {
+    throw unSupportedMethodError();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::integer original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::operator-(
+        const iterator<couple<const K_TYPE, V_TYPE>>&) const {
+    throw unSupportedMethodError();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::hasNext() const {
+    return hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::Iterator::hasNext();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::hasPrev() const {
+    throw unSupportedMethodError();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::atPrev(
+        const iterator<couple<const K_TYPE, V_TYPE>> *other) const {
+    auto other_it = dynamic_cast<const Iterator*>(other);
+    if (!other_it) {
+        return false;
+    }
+    auto next = ownerPtr(this->clone());
+    if (!next->isValid()){
+        return false;
+    }
+
+    next->next();
+    return next->equalPtr(other_it);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::atNext(
+        const iterator<couple<const K_TYPE, V_TYPE>> *other) const {
+    return other->atPrev(*this);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+void original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::next() const {
+    hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::Iterator::next();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+void original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::prev() const {
+    throw unSupportedMethodError();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator*
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::getPrev() const {
+    throw unSupportedMethodError();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::couple<const K_TYPE, V_TYPE>&
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::get() {
+    return hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::Iterator::get();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::couple<const K_TYPE, V_TYPE>
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::get() const {
+    return hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::Iterator::get();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+void original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::set(const couple<const K_TYPE, V_TYPE>&) {
+    throw unSupportedMethodError();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::isValid() const {
+    return hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::Iterator::isValid();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::hashMap(HASH hash, ALLOC alloc)
+    : hashTable<K_TYPE, V_TYPE, ALLOC, HASH>(std::move(hash)),
+      map<K_TYPE, V_TYPE, ALLOC>(std::move(alloc)) {}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::hashMap(const u_integer capacity, HASH hash, ALLOC alloc)
+    : hashMap(std::move(hash), std::move(alloc)) {
+    this->rehashFor(capacity);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::hashMap(const hashMap &other) : hashMap() {
+    this->operator=(other);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>&
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::operator=(const hashMap &other) {
+    if (this == &other) {
+        return *this;
+    }
+
+    this->buckets = this->bucketsCopy(other.buckets);
+    this->size_ = other.size_;
+    this->hash_ = other.hash_;
+    if constexpr(ALLOC::propagate_on_container_copy_assignment::value) {
+        this->allocator = other.allocator;
+        this->rebind_alloc = other.rebind_alloc;
+    }
+    return *this;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::hashMap(hashMap &&other) noexcept : hashMap() {
+    this->operator=(std::move(other));
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>&
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::operator=(hashMap &&other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+
+    this->buckets = std::move(other.buckets);
+    this->size_ = other.size_;
+    other.size_ = 0;
+    this->hash_ = std::move(other.hash_);
+    if constexpr(ALLOC::propagate_on_container_move_assignment::value) {
+        this->allocator = std::move(other.allocator);
+        this->rebind_alloc = std::move(other.rebind_alloc);
+    }
+    return *this;
+}
+
+template <typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+void original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::swap(hashMap& other) noexcept
+{
+    if (this == &other)
+        return;
+
+    std::swap(this->size_, other.size_);
+    std::swap(this->buckets, other.buckets);
+    std::swap(this->hash_, other.hash_);
+    if constexpr (ALLOC::propagate_on_container_swap::value) {
+        std::swap(this->allocator, other.allocator);
+        std::swap(this->rebind_alloc, other.rebind_alloc);
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::u_integer
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::size() const {
+    return this->size_;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::contains(const couple<const K_TYPE, V_TYPE> &e) const {
+    return this->containsKey(e.first()) && this->get(e.first()) == e.second();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::add(const K_TYPE &k, const V_TYPE &v) {
+    return this->insert(k, v);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::remove(const K_TYPE &k) {
+    return this->erase(k);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+void original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::reserve(const u_integer expected) {
+    this->rehashFor(expected);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+template<typename SOURCE>
+original::u_integer
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::bulkInsert(SOURCE&& source, const u_integer thread_cnt) {
+    typename hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::buckets_type nodes;
+    try {
+        for (auto&& e : source) {
+            // The slot exists before the node, so a failing allocation leaves nothing unowned
+            nodes.pushEnd(nullptr);
+            nodes[nodes.size() - 1] = this->createNode(e.first(), e.second());
+        }
+    } catch (...) {
+        for (u_integer i = 0; i < nodes.size(); ++i) {
+            if (nodes[i])
+                this->destroyNode(nodes[i]);
+        }
+        throw;
+    }
+    return this->linkNodes(nodes, thread_cnt);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::containsKey(const K_TYPE &k) const {
+    return this->find(k);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+V_TYPE original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::get(const K_TYPE &k) const {
+    auto node = this->find(k);
+    if (!node)
+        throw noElementError();
+    return node->getValue();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::update(const K_TYPE &key, const V_TYPE &value) {
+    return this->modify(key, value);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+const V_TYPE& original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::operator[](const K_TYPE &k) const {
+    auto node = this->find(k);
+    if (!node)
+        throw noElementError();
+    return node->getValue();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+V_TYPE& original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::operator[](const K_TYPE &k) {
+    auto node = this->find(k);
+    if (!node) {
+        this->insert(k, V_TYPE{});
+        node = this->find(k);
+    }
+    return node->getValue();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator*
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::begins() const {
+    auto p_buckets = const_cast<vector<hashNode*, rebind_alloc_pointer>*>(&this->buckets);
+    if (this->buckets[0]) {
+        return new Iterator(p_buckets, 0, this->buckets[0]);
+    }
+    auto bucket = Iterator::findNextValidBucket(p_buckets, 0);
+    return new Iterator(p_buckets, bucket, p_buckets->get(bucket));
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator*
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::ends() const {
+    auto p_buckets = const_cast<vector<hashNode*, rebind_alloc_pointer>*>(&this->buckets);
+    auto bucket = Iterator::findPrevValidBucket(p_buckets, this->buckets.size());
+    auto node = this->buckets[bucket];
+    while (node && node->getPNext()) {
+        node = node->getPNext();
+    }
+    return new Iterator(p_buckets, bucket, node);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+std::string original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::className() const {
+    return "hashMap";
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+std::string original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::toString(const bool enter) const {
+    std::stringstream ss;
+    ss << this->className();
+    ss << "(";
+    bool first = true;
+    for (auto it = this->begin(); it != this->end(); it.next()){
+        if (!first){
+            ss << ", ";
+        }
+        ss << "{" << printable::formatString(it.get().template get<0>()) << ": "
+           << printable::formatString(it.get().template get<1>()) << "}";
+        first = false;
+    }
+    ss << ")";
+    if (enter)
+        ss << "\n";
+    return ss.str();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::~hashMap() = default;
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::Iterator(RBTreeType* tree, RBNode* cur)
+    : RBTreeType::Iterator(tree, cur)  {}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::equalPtr(
+    const iterator<couple<const K_TYPE, V_TYPE>>* other) const
+{
+    auto other_it = dynamic_cast<const Iterator*>(other);
+    return other_it &&
+           this->tree_ == other_it->tree_ &&
+           this->cur_ == other_it->cur_;
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::Iterator(const Iterator& other) : Iterator(nullptr, nullptr)
+{
+    this->operator=(other);
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator&
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::operator=(const Iterator& other)
+{
+    if (this == &other) {
+        return *this;
+    }
+
+    this->tree_ = other.tree_;
+    this->cur_ = other.cur_;
+    return *this;
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator*
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::clone() const
+{
+    return new Iterator(*this);
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+std::string original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::className() const
+{
+    return "treeMap::Iterator";
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+void original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::operator+=(integer steps) const
+{
+    RBTreeType::Iterator::operator+=(steps);
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+void original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::operator-=(integer steps) const
+{
+    RBTreeType::Iterator::operator-=(steps);
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::integer
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::operator-(
+    const iterator<couple<const K_TYPE, V_TYPE>>& other) const
+{
+    auto other_it = dynamic_cast<const Iterator*>(&other);
+    if (other_it == nullptr)
+        return this > &other ?
+               std::numeric_limits<integer>::max() :
+               std::numeric_limits<integer>::min();
+    return RBTreeType::Iterator::operator-(*other_it);
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::hasNext() const
+{
+    return RBTreeType::Iterator::hasNext();
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::hasPrev() const
+{
+    return RBTreeType::Iterator::hasPrev();
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::atPrev(
+    const iterator<couple<const K_TYPE, V_TYPE>>* other) const
+{
+    auto other_it = dynamic_cast<const Iterator*>(other);
+    if (!other_it) {
+        return false;
+    }
+    auto next = ownerPtr(this->clone());
+    if (!next->isValid()){
+        return false;
+    }
+
+    next->next();
+    return next->equalPtr(other_it);
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::atNext(
+    const iterator<couple<const K_TYPE, V_TYPE>>* other) const
+{
+    return other->atNext(*this);
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+void original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::next() const
+{
+    RBTreeType::Iterator::next();
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+void original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::prev() const
+{
+    RBTreeType::Iterator::prev();
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator*
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::getPrev() const
+{
+    auto it = this->clone();
+    it->prev();
+    return it;
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::couple<const K_TYPE, V_TYPE>& original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::get()
+{
+    return RBTreeType::Iterator::get();
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::couple<const K_TYPE, V_TYPE> original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::get() const
+{
+    return RBTreeType::Iterator::get();
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+void original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::set(const couple<const K_TYPE, V_TYPE>&)
+{
+    throw unSupportedMethodError();
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::isValid() const
+{
+    return RBTreeType::Iterator::isValid();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::treeMap(Compare comp, ALLOC alloc)
+    : RBTreeType(std::move(comp)),
+      map<K_TYPE, V_TYPE, ALLOC>(std::move(alloc)) {}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::treeMap(const treeMap& other) : treeMap() {
+    this->operator=(other);
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-bool original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::hasPrev() const {
-    throw unSupportedMethodError();
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>&
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::operator=(const treeMap& other) {
+    if (this == &other){
+        return *this;
+    }
+
+    this->destroyTree();
+    this->root_ = other.treeCopy();
+    this->size_ = other.size_;
+    this->compare_ = other.compare_;
+    if constexpr(ALLOC::propagate_on_container_copy_assignment::value) {
+        this->allocator = other.allocator;
+        this->rebind_alloc = other.rebind_alloc;
+    }
+    return *this;
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-bool original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::atPrev(
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::treeMap(treeMap&& other) noexcept : treeMap() {
+    this->operator=(std::move(other));
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>&
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::operator=(treeMap&& other) noexcept {
+    if (this == &other){
+        return *this;
+    }
+
+    this->destroyTree();
+    this->root_ = other.root_;
+    other.root_ = nullptr;
+    this->size_ = other.size_;
+    other.size_ = 0;
+    this->compare_ = std::move(other.compare_);
+    if constexpr(ALLOC::propagate_on_container_move_assignment::value) {
+        this->allocator = std::move(other.allocator);
+        this->rebind_alloc = std::move(other.rebind_alloc);
+    }
+    return *this;
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+void original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::swap(treeMap& other) noexcept
+{
+    if (this == &other)
+        return;
+
+    std::swap(this->root_, other.root_);
+    std::swap(this->size_, other.size_);
+    std::swap(this->compare_, other.compare_);
+    if constexpr (ALLOC::propagate_on_container_swap::value) {
+        std::swap(this->allocator, other.allocator);
+        std::swap(this->rebind_alloc, other.rebind_alloc);
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::u_integer original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::size() const {
+    return this->size_;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::contains(const couple<const K_TYPE, V_TYPE> &e) const {
+    return this->containsKey(e.first()) && this->get(e.first()) == e.second();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::add(const K_TYPE &k, const V_TYPE &v) {
+    return this->insert(k, v);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::remove(const K_TYPE &k) {
+    return this->erase(k);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::containsKey(const K_TYPE &k) const {
+    return this->find(k);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+V_TYPE original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::get(const K_TYPE &k) const {
+    auto node = this->find(k);
+    if (!node)
+        throw noElementError();
+    return node->getValue();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::update(const K_TYPE &key, const V_TYPE &value) {
+    return this->modify(key, value);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+const V_TYPE &original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::operator[](const K_TYPE &k) const {
+    auto node = this->find(k);
+    if (!node)
+        throw noElementError();
+    return node->getValue();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+V_TYPE &original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::operator[](const K_TYPE &k) {
+    auto node = this->find(k);
+    if (!node) {
+        this->insert(k, V_TYPE{});
+        node = this->find(k);
+    }
+    return node->getValue();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+template<typename SOURCE>
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::fromSorted(SOURCE&& sorted, Compare comp, ALLOC alloc) {
+    treeMap map{std::move(comp), std::move(alloc)};
+    map.bulkLoad(std::forward<SOURCE>(sorted));
+    return map;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+template<typename SOURCE>
+original::u_integer original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::bulkLoad(SOURCE&& sorted) {
+    typename RBTreeType::nodes_type nodes;
+    for (auto&& e : sorted) {
+        nodes.pushEnd(this->createNode(e.first(), e.second()));
+    }
+    return this->linkSorted(nodes);
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::u_integer original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::rank(const K_TYPE& k) const {
+    return this->rankOf(k);
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+const original::couple<const K_TYPE, V_TYPE>&
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::select(const u_integer index) const {
+    auto node = this->selectNode(index);
+    if (!node) {
+        throw outOfBoundError();
+    }
+    return node->getVal();
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+void original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::unionWith(const treeMap& other) {
+    this->combineWith(other, RBTreeType::setOperation::UNION);
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+void original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::intersectWith(const treeMap& other) {
+    this->combineWith(other, RBTreeType::setOperation::INTERSECTION);
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+void original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::differenceWith(const treeMap& other) {
+    this->combineWith(other, RBTreeType::setOperation::DIFFERENCE);
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator*
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::begins() const
+{
+    return new Iterator(const_cast<treeMap*>(this), this->getMinNode());
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator*
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::ends() const
+{
+    return new Iterator(const_cast<treeMap*>(this), this->getMaxNode());
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+std::string original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::className() const {
+    return "treeMap";
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+std::string original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::toString(const bool enter) const {
+    std::stringstream ss;
+    ss << this->className();
+    ss << "(";
+    bool first = true;
+    for (auto it = this->begin(); it != this->end(); it.next()){
+        if (!first){
+            ss << ", ";
+        }
+        ss << "{" << printable::formatString(it.get().template get<0>()) << ": "
+           << printable::formatString(it.get().template get<1>()) << "}";
+        first = false;
+    }
+    ss << ")";
+    if (enter)
+        ss << "\n";
+    return ss.str();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::~treeMap() = default;
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::equalPtr(
         const iterator<couple<const K_TYPE, V_TYPE>> *other) const {
     auto other_it = dynamic_cast<const Iterator*>(other);
-    if (!other_it) {
-        return false;
-    }
-    auto next = ownerPtr(this->clone());
-    if (!next->isValid()){
+    return other_it && this->cur_ == other_it->cur_;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::Iterator(skipListNode* cur)
+    : skipListType::Iterator(cur) {}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::Iterator(const Iterator& other)
+    : skipListType::Iterator(other) {}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator&
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::operator=(const Iterator& other) {
+    skipListType::Iterator::operator=(other);
+    return *this;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator*
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::clone() const {
+    return new Iterator(*this);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+std::string
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::className() const {
+    return "JMap::Iterator";
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+void original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::operator+=(integer steps) const {
+    skipListType::Iterator::operator+=(steps);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+void original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::operator-=(integer) const {
+    throw unSupportedMethodError();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::integer
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::operator-(
+        const iterator<couple<const K_TYPE, V_TYPE>> &other) const {
+    auto other_it = dynamic_cast<const Iterator*>(&other);
+    if (other_it == nullptr)
+        return this > &other ?
+               std::numeric_limits<integer>::max() :
+               std::numeric_limits<integer>::min();
+    return skipListType::Iterator::operator-(*other_it);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::hasNext() const {
+    return skipListType::Iterator::hasNext();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::hasPrev() const {
+    throw unSupportedMethodError();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::atPrev(
+        const iterator<couple<const K_TYPE, V_TYPE>>* other) const {
+    const auto other_it = dynamic_cast<const Iterator*>(other);
+    if (!other_it){
         return false;
     }
-
-    next->next();
-    return next->equalPtr(other_it);
+    auto cloned_it = ownerPtr(other_it->clone());
+    return this->equalPtr(cloned_it.get());
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-bool original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::atNext(
-        const iterator<couple<const K_TYPE, V_TYPE>> *other) const {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::atNext(
+        const iterator<couple<const K_TYPE, V_TYPE>>* other) const {
     return other->atPrev(*this);
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-void original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::next() const {
-    hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::Iterator::next();
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+void original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::next() const {
+    skipListType::Iterator::next();
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-void original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::prev() const {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+void original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::prev() const {
     throw unSupportedMethodError();
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator*
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::getPrev() const {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator*
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::getPrev() const {
     throw unSupportedMethodError();
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-original::couple<const K_TYPE, V_TYPE>&
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::get() {
-    return hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::Iterator::get();
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::couple<const K_TYPE, V_TYPE> &original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::get() {
+    return skipListType::Iterator::get();
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-original::couple<const K_TYPE, V_TYPE>
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::get() const {
-    return hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::Iterator::get();
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::couple<const K_TYPE, V_TYPE> original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::get() const {
+    return skipListType::Iterator::get();
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-void original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::set(const couple<const K_TYPE, V_TYPE>&) {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+void original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::set(const original::couple<const K_TYPE, V_TYPE>&) {
     throw unSupportedMethodError();
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-bool original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator::isValid() const {
-    return hashTable<K_TYPE, V_TYPE, ALLOC, HASH>::Iterator::isValid();
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::isValid() const {
+    return skipListType::Iterator::isValid();
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::hashMap(HASH hash, ALLOC alloc)
-    : hashTable<K_TYPE, V_TYPE, ALLOC, HASH>(std::move(hash)),
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::JMap(Compare comp, ALLOC alloc)
+    : skipListType(std::move(comp)) ,
       map<K_TYPE, V_TYPE, ALLOC>(std::move(alloc)) {}
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::hashMap(const hashMap &other) : hashMap() {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::JMap(const JMap& other) : JMap() {
     this->operator=(other);
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>&
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::operator=(const hashMap &other) {
-    if (this == &other) {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>&
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::operator=(const JMap& other) {
+    if (this == &other){
         return *this;
     }
 
-    this->buckets = this->bucketsCopy(other.buckets);
+    this->listDestroy();
+    this->head_ = other.listCopy();
     this->size_ = other.size_;
-    this->hash_ = other.hash_;
+    this->compare_ = other.compare_;
     if constexpr(ALLOC::propagate_on_container_copy_assignment::value) {
         this->allocator = other.allocator;
         this->rebind_alloc = other.rebind_alloc;
@@ -1410,22 +2839,24 @@ original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::operator=(const hashMap &other)
     return *this;
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::hashMap(hashMap &&other) noexcept : hashMap() {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::JMap(JMap&& other) noexcept : JMap() {
     this->operator=(std::move(other));
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>&
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::operator=(hashMap &&other) noexcept {
-    if (this == &other) {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>&
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::operator=(JMap&& other) noexcept {
+    if (this == &other){
         return *this;
     }
 
-    this->buckets = std::move(other.buckets);
+    this->listDestroy();
+    this->head_ = other.head_;
+    other.head_ = other.createHead();
     this->size_ = other.size_;
     other.size_ = 0;
-    this->hash_ = std::move(other.hash_);
+    this->compare_ = std::move(other.compare_);
     if constexpr(ALLOC::propagate_on_container_move_assignment::value) {
         this->allocator = std::move(other.allocator);
         this->rebind_alloc = std::move(other.rebind_alloc);
@@ -1433,71 +2864,69 @@ original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::operator=(hashMap &&other) noexc
     return *this;
 }
 
-template <typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-void original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::swap(hashMap& other) noexcept
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+void original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::swap(JMap& other) noexcept
 {
     if (this == &other)
         return;
 
     std::swap(this->size_, other.size_);
-    std::swap(this->buckets, other.buckets);
-    std::swap(this->hash_, other.hash_);
-    if constexpr (ALLOC::propagate_on_container_swap::value) {
+    std::swap(this->head_, other.head_);
+    std::swap(this->compare_, other.compare_);
+    if constexpr(ALLOC::propagate_on_container_swap::value) {
         std::swap(this->allocator, other.allocator);
         std::swap(this->rebind_alloc, other.rebind_alloc);
     }
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-original::u_integer
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::size() const {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::u_integer original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::size() const {
     return this->size_;
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-bool
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::contains(const couple<const K_TYPE, V_TYPE> &e) const {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::contains(const couple<const K_TYPE, V_TYPE> &e) const {
     return this->containsKey(e.first()) && this->get(e.first()) == e.second();
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-bool original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::add(const K_TYPE &k, const V_TYPE &v) {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::add(const K_TYPE &k, const V_TYPE &v) {
     return this->insert(k, v);
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-bool original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::remove(const K_TYPE &k) {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::remove(const K_TYPE &k) {
     return this->erase(k);
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-bool original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::containsKey(const K_TYPE &k) const {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::containsKey(const K_TYPE &k) const {
     return this->find(k);
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-V_TYPE original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::get(const K_TYPE &k) const {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+V_TYPE original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::get(const K_TYPE &k) const {
     auto node = this->find(k);
     if (!node)
         throw noElementError();
     return node->getValue();
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-bool original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::update(const K_TYPE &key, const V_TYPE &value) {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::update(const K_TYPE &key, const V_TYPE &value) {
     return this->modify(key, value);
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-const V_TYPE& original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::operator[](const K_TYPE &k) const {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+const V_TYPE& original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::operator[](const K_TYPE &k) const {
     auto node = this->find(k);
     if (!node)
         throw noElementError();
     return node->getValue();
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-V_TYPE& original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::operator[](const K_TYPE &k) {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+V_TYPE &original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::operator[](const K_TYPE &k) {
     auto node = this->find(k);
     if (!node) {
         this->insert(k, V_TYPE{});
@@ -1506,36 +2935,25 @@ V_TYPE& original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::operator[](const K_TYPE
     return node->getValue();
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator*
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::begins() const {
-    auto p_buckets = const_cast<vector<hashNode*, rebind_alloc_pointer>*>(&this->buckets);
-    if (this->buckets[0]) {
-        return new Iterator(p_buckets, 0, this->buckets[0]);
-    }
-    auto bucket = Iterator::findNextValidBucket(p_buckets, 0);
-    return new Iterator(p_buckets, bucket, p_buckets->get(bucket));
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator*
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::begins() const {
+    return new Iterator(this->head_->getPNext(1));
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::Iterator*
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::ends() const {
-    auto p_buckets = const_cast<vector<hashNode*, rebind_alloc_pointer>*>(&this->buckets);
-    auto bucket = Iterator::findPrevValidBucket(p_buckets, this->buckets.size());
-    auto node = this->buckets[bucket];
-    while (node && node->getPNext()) {
-        node = node->getPNext();
-    }
-    return new Iterator(p_buckets, bucket, node);
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator*
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::ends() const {
+    return new Iterator(this->findLastNode());
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-std::string original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::className() const {
-    return "hashMap";
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+std::string original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::className() const {
+    return "JMap";
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-std::string original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::toString(const bool enter) const {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+std::string original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::toString(bool enter) const {
     std::stringstream ss;
     ss << this->className();
     ss << "(";
@@ -1554,90 +2972,91 @@ std::string original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::toString(const bool
     return ss.str();
 }
 
-template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
-original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>::~hashMap() = default;
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::~JMap() = default;
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::Iterator(RBTreeType* tree, RBNode* cur)
-    : RBTreeType::Iterator(tree, cur)  {}
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator::Iterator(BTreeType* tree, leafNode* leaf, const u_integer index)
+    : BTreeType::Iterator(tree, leaf, index) {}
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
 bool
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::equalPtr(
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator::equalPtr(
     const iterator<couple<const K_TYPE, V_TYPE>>* other) const
 {
     auto other_it = dynamic_cast<const Iterator*>(other);
     return other_it &&
            this->tree_ == other_it->tree_ &&
-           this->cur_ == other_it->cur_;
+           this->leaf_ == other_it->leaf_ &&
+           this->index_ == other_it->index_;
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::Iterator(const Iterator& other) : Iterator(nullptr, nullptr)
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator::Iterator(const Iterator& other)
+    : Iterator(nullptr, nullptr, 0)
 {
     this->operator=(other);
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator&
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::operator=(const Iterator& other)
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator&
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator::operator=(const Iterator& other)
 {
     if (this == &other) {
         return *this;
     }
 
-    this->tree_ = other.tree_;
-    this->cur_ = other.cur_;
+    BTreeType::Iterator::operator=(other);
     return *this;
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator*
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::clone() const
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator*
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator::clone() const
 {
     return new Iterator(*this);
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-std::string original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::className() const
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+std::string original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator::className() const
 {
-    return "treeMap::Iterator";
+    return "btreeMap::Iterator";
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-void original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::operator+=(integer steps) const
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+void original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator::operator+=(integer steps) const
 {
-    RBTreeType::Iterator::operator+=(steps);
+    BTreeType::Iterator::operator+=(steps);
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-void original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::operator-=(integer steps) const
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+void original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator::operator-=(integer steps) const
 {
-    RBTreeType::Iterator::operator-=(steps);
+    BTreeType::Iterator::operator-=(steps);
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
 original::integer
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::operator-(
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator::operator-(
     const iterator<couple<const K_TYPE, V_TYPE>>&) const
 {
     throw unSupportedMethodError();
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-bool original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::hasNext() const
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+bool original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator::hasNext() const
 {
-    return RBTreeType::Iterator::hasNext();
+    return BTreeType::Iterator::hasNext();
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-bool original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::hasPrev() const
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+bool original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator::hasPrev() const
 {
-    return RBTreeType::Iterator::hasPrev();
+    return BTreeType::Iterator::hasPrev();
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-bool original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::atPrev(
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+bool original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator::atPrev(
     const iterator<couple<const K_TYPE, V_TYPE>>* other) const
 {
     auto other_it = dynamic_cast<const Iterator*>(other);
@@ -1653,204 +3072,208 @@ bool original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::atPrev(
     return next->equalPtr(other_it);
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-bool original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::atNext(
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+bool original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator::atNext(
     const iterator<couple<const K_TYPE, V_TYPE>>* other) const
 {
     return other->atNext(*this);
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-void original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::next() const
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+void original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator::next() const
 {
-    RBTreeType::Iterator::next();
+    BTreeType::Iterator::next();
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-void original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::prev() const
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+void original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator::prev() const
 {
-    RBTreeType::Iterator::prev();
+    BTreeType::Iterator::prev();
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator*
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::getPrev() const
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator*
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator::getPrev() const
 {
     auto it = this->clone();
     it->prev();
     return it;
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::couple<const K_TYPE, V_TYPE>& original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::get()
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::couple<const K_TYPE, V_TYPE>& original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator::get()
 {
-    return RBTreeType::Iterator::get();
+    return BTreeType::Iterator::get();
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::couple<const K_TYPE, V_TYPE> original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::get() const
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::couple<const K_TYPE, V_TYPE> original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator::get() const
 {
-    return RBTreeType::Iterator::get();
+    return BTreeType::Iterator::get();
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-void original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::set(const couple<const K_TYPE, V_TYPE>&)
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+void original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator::set(const couple<const K_TYPE, V_TYPE>&)
 {
     throw unSupportedMethodError();
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-bool original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::isValid() const
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+bool original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator::isValid() const
 {
-    return RBTreeType::Iterator::isValid();
+    return BTreeType::Iterator::isValid();
 }
 
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::treeMap(Compare comp, ALLOC alloc)
-    : RBTreeType(std::move(comp)),
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::btreeMap(Compare comp, ALLOC alloc)
+    : BTreeType(std::move(comp)),
       map<K_TYPE, V_TYPE, ALLOC>(std::move(alloc)) {}
 
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::treeMap(const treeMap& other) : treeMap() {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::btreeMap(const btreeMap& other) : btreeMap() {
     this->operator=(other);
 }
 
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>&
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::operator=(const treeMap& other) {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>&
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::operator=(const btreeMap& other) {
     if (this == &other){
         return *this;
     }
 
     this->destroyTree();
-    this->root_ = other.treeCopy();
-    this->size_ = other.size_;
     this->compare_ = other.compare_;
     if constexpr(ALLOC::propagate_on_container_copy_assignment::value) {
         this->allocator = other.allocator;
-        this->rebind_alloc = other.rebind_alloc;
+        this->rebind_alloc_leaf_ = other.rebind_alloc_leaf_;
+        this->rebind_alloc_inner_ = other.rebind_alloc_inner_;
     }
+    this->copyTree(other);
     return *this;
 }
 
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::treeMap(treeMap&& other) noexcept : treeMap() {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::btreeMap(btreeMap&& other) noexcept : btreeMap() {
     this->operator=(std::move(other));
 }
 
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>&
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::operator=(treeMap&& other) noexcept {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>&
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::operator=(btreeMap&& other) noexcept {
     if (this == &other){
         return *this;
     }
 
-    this->destroyTree();
-    this->root_ = other.root_;
-    other.root_ = nullptr;
-    this->size_ = other.size_;
-    other.size_ = 0;
-    this->compare_ = std::move(other.compare_);
+    this->moveTree(other);
     if constexpr(ALLOC::propagate_on_container_move_assignment::value) {
         this->allocator = std::move(other.allocator);
-        this->rebind_alloc = std::move(other.rebind_alloc);
+        this->rebind_alloc_leaf_ = std::move(other.rebind_alloc_leaf_);
+        this->rebind_alloc_inner_ = std::move(other.rebind_alloc_inner_);
     }
     return *this;
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-void original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::swap(treeMap& other) noexcept
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+void original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::swap(btreeMap& other) noexcept
 {
     if (this == &other)
         return;
 
-    std::swap(this->root_, other.root_);
-    std::swap(this->size_, other.size_);
-    std::swap(this->compare_, other.compare_);
+    this->swapTree(other);
     if constexpr (ALLOC::propagate_on_container_swap::value) {
         std::swap(this->allocator, other.allocator);
-        std::swap(this->rebind_alloc, other.rebind_alloc);
+        std::swap(this->rebind_alloc_leaf_, other.rebind_alloc_leaf_);
+        std::swap(this->rebind_alloc_inner_, other.rebind_alloc_inner_);
     }
 }
 
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::u_integer original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::size() const {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::u_integer original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::size() const {
     return this->size_;
 }
 
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
 bool
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::contains(const couple<const K_TYPE, V_TYPE> &e) const {
-    return this->containsKey(e.first()) && this->get(e.first()) == e.second();
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::contains(const couple<const K_TYPE, V_TYPE> &e) const {
+    auto pair = this->find(e.first());
+    return pair && pair->second() == e.second();
 }
 
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-bool original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::add(const K_TYPE &k, const V_TYPE &v) {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+bool original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::add(const K_TYPE &k, const V_TYPE &v) {
     return this->insert(k, v);
 }
 
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-bool original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::remove(const K_TYPE &k) {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+bool original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::remove(const K_TYPE &k) {
     return this->erase(k);
 }
 
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-bool original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::containsKey(const K_TYPE &k) const {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+bool original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::containsKey(const K_TYPE &k) const {
     return this->find(k);
 }
 
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-V_TYPE original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::get(const K_TYPE &k) const {
-    auto node = this->find(k);
-    if (!node)
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+V_TYPE original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::get(const K_TYPE &k) const {
+    auto pair = this->find(k);
+    if (!pair)
         throw noElementError();
-    return node->getValue();
+    return pair->second();
 }
 
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-bool original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::update(const K_TYPE &key, const V_TYPE &value) {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+bool original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::update(const K_TYPE &key, const V_TYPE &value) {
     return this->modify(key, value);
 }
 
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-const V_TYPE &original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::operator[](const K_TYPE &k) const {
-    auto node = this->find(k);
-    if (!node)
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+const V_TYPE &original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::operator[](const K_TYPE &k) const {
+    auto pair = this->find(k);
+    if (!pair)
         throw noElementError();
-    return node->getValue();
+    return pair->second();
 }
 
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-V_TYPE &original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::operator[](const K_TYPE &k) {
-    auto node = this->find(k);
-    if (!node) {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+V_TYPE &original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::operator[](const K_TYPE &k) {
+    auto pair = this->find(k);
+    if (!pair) {
         this->insert(k, V_TYPE{});
-        node = this->find(k);
+        pair = this->find(k);
     }
-    return node->getValue();
+    return pair->template get<1>();
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator*
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::begins() const
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+template<typename Callback>
+void original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::forEachInRange(
+    const K_TYPE& low, const K_TYPE& high, Callback operation) const {
+    this->scan(low, high, operation);
+}
+
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator*
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::begins() const
 {
-    return new Iterator(const_cast<treeMap*>(this), this->getMinNode());
+    return new Iterator(const_cast<btreeMap*>(this), this->first_, 0);
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator*
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::ends() const
+template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::Iterator*
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::ends() const
 {
-    return new Iterator(const_cast<treeMap*>(this), this->getMaxNode());
+    return new Iterator(const_cast<btreeMap*>(this), this->last_,
+                        this->last_ ? this->last_->cnt_ - 1 : 0);
 }
 
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-std::string original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::className() const {
-    return "treeMap";
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+std::string original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::className() const {
+    return "btreeMap";
 }
 
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-std::string original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::toString(const bool enter) const {
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+std::string original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::toString(const bool enter) const {
     std::stringstream ss;
     ss << this->className();
     ss << "(";
@@ -1869,283 +3292,154 @@ std::string original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::toString(const bo
     return ss.str();
 }
 
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::treeMap<K_TYPE, V_TYPE, Compare, ALLOC>::~treeMap() = default;
-
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::equalPtr(
-        const iterator<couple<const K_TYPE, V_TYPE>> *other) const {
-    auto other_it = dynamic_cast<const Iterator*>(other);
-    return other_it && this->cur_ == other_it->cur_;
-}
-
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::Iterator(skipListNode* cur)
-    : skipListType::Iterator(cur) {}
-
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::Iterator(const Iterator& other)
-    : skipListType::Iterator(other) {}
-
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator&
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::operator=(const Iterator& other) {
-    skipListType::Iterator::operator=(other);
-    return *this;
-}
-
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator*
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::clone() const {
-    return new Iterator(*this);
-}
-
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-std::string
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::className() const {
-    return "JMap::Iterator";
-}
-
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-void original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::operator+=(integer steps) const {
-    skipListType::Iterator::operator+=(steps);
-}
-
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-void original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::operator-=(integer) const {
-    throw unSupportedMethodError();
-}
-
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::integer
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::operator-(
-        const iterator<couple<const K_TYPE, V_TYPE>> &other) const {
-    auto other_it = dynamic_cast<const Iterator*>(&other);
-    if (other_it == nullptr)
-        return this > &other ?
-               std::numeric_limits<integer>::max() :
-               std::numeric_limits<integer>::min();
-    return skipListType::Iterator::operator-(*other_it);
-}
-
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::hasNext() const {
-    return skipListType::Iterator::hasNext();
-}
-
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::hasPrev() const {
-    throw unSupportedMethodError();
-}
-
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::atPrev(
-        const iterator<couple<const K_TYPE, V_TYPE>>* other) const {
-    const auto other_it = dynamic_cast<const Iterator*>(other);
-    if (!other_it){
-        return false;
-    }
-    auto cloned_it = ownerPtr(other_it->clone());
-    return this->equalPtr(cloned_it.get());
-}
-
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::atNext(
-        const iterator<couple<const K_TYPE, V_TYPE>>* other) const {
-    return other->atPrev(*this);
-}
-
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-void original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::next() const {
-    skipListType::Iterator::next();
-}
-
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-void original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::prev() const {
-    throw unSupportedMethodError();
-}
-
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator*
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::getPrev() const {
-    throw unSupportedMethodError();
-}
-
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::couple<const K_TYPE, V_TYPE> &original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::get() {
-    return skipListType::Iterator::get();
-}
-
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::couple<const K_TYPE, V_TYPE> original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::get() const {
-    return skipListType::Iterator::get();
-}
-
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-void original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::set(const original::couple<const K_TYPE, V_TYPE>&) {
-    throw unSupportedMethodError();
-}
-
-template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator::isValid() const {
-    return skipListType::Iterator::isValid();
-}
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeMap<K_TYPE, V_TYPE, Compare, ALLOC, FANOUT>::~btreeMap() = default;
 
 template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::JMap(Compare comp, ALLOC alloc)
-    : skipListType(std::move(comp)) ,
+original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::persistentTreeMap(Compare comp, ALLOC alloc)
+    : persistentTreeType(std::move(comp)),
       map<K_TYPE, V_TYPE, ALLOC>(std::move(alloc)) {}
 
 template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::JMap(const JMap& other) : JMap() {
+original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::persistentTreeMap(const persistentTreeMap& other)
+    : persistentTreeMap() {
     this->operator=(other);
 }
 
 template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>&
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::operator=(const JMap& other) {
+original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>&
+original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::operator=(const persistentTreeMap& other) {
     if (this == &other){
         return *this;
     }
 
-    this->listDestroy();
-    this->head_ = other.listCopy();
-    this->size_ = other.size_;
-    this->compare_ = other.compare_;
-    if constexpr(ALLOC::propagate_on_container_copy_assignment::value) {
-        this->allocator = other.allocator;
-        this->rebind_alloc = other.rebind_alloc;
-    }
+    this->shareTree(other);
+    this->allocator = other.allocator;
     return *this;
 }
 
 template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::JMap(JMap&& other) noexcept : JMap() {
+original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::persistentTreeMap(persistentTreeMap&& other) noexcept
+    : persistentTreeMap() {
     this->operator=(std::move(other));
 }
 
 template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>&
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::operator=(JMap&& other) noexcept {
+original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>&
+original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::operator=(persistentTreeMap&& other) noexcept {
     if (this == &other){
         return *this;
     }
 
-    this->listDestroy();
-    this->head_ = other.head_;
-    other.head_ = other.createNode();
-    this->size_ = other.size_;
-    other.size_ = 0;
-    this->compare_ = std::move(other.compare_);
-    if constexpr(ALLOC::propagate_on_container_move_assignment::value) {
-        this->allocator = std::move(other.allocator);
-        this->rebind_alloc = std::move(other.rebind_alloc);
-    }
+    this->moveTree(other);
+    this->allocator = std::move(other.allocator);
     return *this;
 }
 
-template <typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-void original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::swap(JMap& other) noexcept
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+void original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::swap(persistentTreeMap& other) noexcept
 {
     if (this == &other)
         return;
 
-    std::swap(this->size_, other.size_);
-    std::swap(this->head_, other.head_);
-    std::swap(this->compare_, other.compare_);
-    if constexpr(ALLOC::propagate_on_container_swap::value) {
-        std::swap(this->allocator, other.allocator);
-        std::swap(this->rebind_alloc, other.rebind_alloc);
-    }
+    this->swapTree(other);
+    std::swap(this->allocator, other.allocator);
 }
 
 template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::u_integer original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::size() const {
+original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>
+original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::snapshot() const {
+    return persistentTreeMap(*this);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::u_integer original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::size() const {
     return this->size_;
 }
 
 template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::contains(const couple<const K_TYPE, V_TYPE> &e) const {
-    return this->containsKey(e.first()) && this->get(e.first()) == e.second();
+bool
+original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::contains(const couple<const K_TYPE, V_TYPE> &e) const {
+    auto node = this->find(e.first());
+    return node && node->data_.second() == e.second();
 }
 
 template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::add(const K_TYPE &k, const V_TYPE &v) {
+bool original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::add(const K_TYPE &k, const V_TYPE &v) {
     return this->insert(k, v);
 }
 
 template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::remove(const K_TYPE &k) {
+bool original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::remove(const K_TYPE &k) {
     return this->erase(k);
 }
 
 template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::containsKey(const K_TYPE &k) const {
+bool original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::containsKey(const K_TYPE &k) const {
     return this->find(k);
 }
 
 template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-V_TYPE original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::get(const K_TYPE &k) const {
+V_TYPE original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::get(const K_TYPE &k) const {
     auto node = this->find(k);
     if (!node)
         throw noElementError();
-    return node->getValue();
+    return node->data_.second();
 }
 
 template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-bool original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::update(const K_TYPE &key, const V_TYPE &value) {
+bool original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::update(const K_TYPE &key, const V_TYPE &value) {
     return this->modify(key, value);
 }
 
 template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-const V_TYPE& original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::operator[](const K_TYPE &k) const {
+const V_TYPE &original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::operator[](const K_TYPE &k) const {
     auto node = this->find(k);
     if (!node)
         throw noElementError();
-    return node->getValue();
+    return node->data_.second();
 }
 
 template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-V_TYPE &original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::operator[](const K_TYPE &k) {
-    auto node = this->find(k);
-    if (!node) {
+V_TYPE &original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::operator[](const K_TYPE &k) {
+    if (!this->find(k)) {
         this->insert(k, V_TYPE{});
-        node = this->find(k);
     }
-    return node->getValue();
+    return this->ownPath(k)->data_.second();
 }
 
 template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator*
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::begins() const {
-    return new Iterator(this->head_->getPNext(1));
+template<typename Callback>
+void original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::forEach(Callback operation) const {
+    this->traverse(this->root_, nullptr, nullptr, operation);
 }
 
 template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::Iterator*
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::ends() const {
-    return new Iterator(this->findLastNode());
+template<typename Callback>
+void original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::forEachInRange(
+    const K_TYPE& low, const K_TYPE& high, Callback operation) const {
+    this->traverse(this->root_, &low, &high, operation);
 }
 
 template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-std::string original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::className() const {
-    return "JMap";
+std::string original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::className() const {
+    return "persistentTreeMap";
 }
 
 template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-std::string original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::toString(bool enter) const {
+std::string original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::toString(const bool enter) const {
     std::stringstream ss;
     ss << this->className();
     ss << "(";
     bool first = true;
-    for (auto it = this->begin(); it != this->end(); it.next()){
+    this->forEach([&](const couple<const K_TYPE, V_TYPE>& pair) {
         if (!first){
             ss << ", ";
         }
-        ss << "{" << printable::formatString(it.get().template get<0>()) << ": "
-           << printable::formatString(it.get().template get<1>()) << "}";
+        ss << "{" << printable::formatString(pair.template get<0>()) << ": "
+           << printable::formatString(pair.template get<1>()) << "}";
         first = false;
-    }
+    });
     ss << ")";
     if (enter)
         ss << "\n";
@@ -2153,7 +3447,7 @@ std::string original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::toString(bool enter)
 }
 
 template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
-original::JMap<K_TYPE, V_TYPE, Compare, ALLOC>::~JMap() = default;
+original::persistentTreeMap<K_TYPE, V_TYPE, Compare, ALLOC>::~persistentTreeMap() = default;
 
 template <typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
 void std::swap(original::hashMap<K_TYPE, V_TYPE, HASH, ALLOC>& lhs, // NOLINT
@@ -2176,4 +3470,18 @@ void std::swap(original::JMap<K_TYPE, V_TYPE, COMPARE, ALLOC>& lhs, // NOLINT
     lhs.swap(rhs);
 }
 
+template <typename K_TYPE, typename V_TYPE, typename COMPARE, typename ALLOC, original::u_integer FANOUT>
+void std::swap(original::btreeMap<K_TYPE, V_TYPE, COMPARE, ALLOC, FANOUT>& lhs, // NOLINT
+    original::btreeMap<K_TYPE, V_TYPE, COMPARE, ALLOC, FANOUT>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+template <typename K_TYPE, typename V_TYPE, typename COMPARE, typename ALLOC>
+void std::swap(original::persistentTreeMap<K_TYPE, V_TYPE, COMPARE, ALLOC>& lhs, // NOLINT
+    original::persistentTreeMap<K_TYPE, V_TYPE, COMPARE, ALLOC>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
 #endif //MAPS_H
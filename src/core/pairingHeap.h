@@ -0,0 +1,653 @@
+#ifndef PAIRING_HEAP_H
+#define PAIRING_HEAP_H
+
+#include "allocator.h"
+#include "comparator.h"
+#include "container.h"
+#include "error.h"
+#include "printable.h"
+
+/**
+ * @file pairingHeap.h
+ * @brief Mergeable priority queue based on a pairing heap
+ * @details Provides a heap-ordered multiway tree in which:
+ * - push(), top() and merge() are O(1)
+ * - pop() and erase() are O(log n) amortized, through two-pass pairing of the root's children
+ * - decreaseKey() is o(log n) amortized, by cutting the subtree and linking it to the root
+ *
+ * Nodes never move, so handles returned by push() stay attached to their elements,
+ * also after the heap holding them is merged into another heap.
+ */
+
+namespace original {
+
+    /**
+     * @class pairingHeap
+     * @tparam TYPE Type of elements stored in the heap
+     * @tparam Callback Comparison functor type (default: increaseComparator)
+     * @tparam ALLOC Allocator template for node storage (default: objPoolAllocator)
+     * @brief Pairing heap with O(1) merge and handle based decrease-key
+     * @extends container
+     * @extends printable
+     * @details Offers prique's push()/pop()/top() with the same ordering for the same
+     * comparator, and adds merge(), which links the other heap's root under this one
+     * instead of re-inserting its elements.
+     *
+     * Each node links to its leftmost child, its right sibling, and its left sibling or,
+     * for a leftmost child, its parent; this is enough to cut any node in O(1).
+     *
+     * Nodes come from a per-heap object pool by default. When the allocator propagates on
+     * merge (objPoolAllocator does), merge() also hands the other heap's pool over, so merged
+     * nodes are returned to the pool they were taken from. Merging the pools takes time
+     * proportional to the other pool's free list, not to the number of elements.
+     *
+     * @note A handle is valid until its element is popped or erased, and follows the
+     *       element into the heap it is merged into.
+     */
+    template<typename TYPE,
+             template <typename> typename Callback = increaseComparator,
+             template <typename> typename ALLOC = objPoolAllocator>
+    requires Compare<Callback<TYPE>, TYPE>
+    class pairingHeap final : public container<TYPE, ALLOC<TYPE>>,
+                              public printable {
+        /**
+         * @class pairingNode
+         * @brief Heap tree node in child-sibling form
+         */
+        class pairingNode {
+        public:
+            TYPE value_;                ///< Element
+            pairingNode* child_;        ///< Leftmost child
+            pairingNode* sibling_;      ///< Right sibling
+            pairingNode* prev_;         ///< Left sibling, or parent for a leftmost child
+
+            /**
+             * @brief Constructs a detached node
+             * @param value Element
+             */
+            explicit pairingNode(const TYPE& value);
+        };
+
+        using rebind_alloc_node = typename ALLOC<TYPE>::template rebind_alloc<pairingNode>;  ///< Node allocator type
+
+        pairingNode* root_;                 ///< Root, holding the top element
+        u_integer size_;                    ///< Number of elements
+        Callback<TYPE> compare_;            ///< Comparison functor instance for priority ordering
+        rebind_alloc_node rebind_alloc{};   ///< Node allocator
+
+        /**
+         * @brief Creates a detached node
+         * @param value Element
+         * @return New node
+         */
+        pairingNode* createNode(const TYPE& value);
+
+        /**
+         * @brief Destroys a node and frees its memory
+         * @param node Node to destroy
+         */
+        void destroyNode(pairingNode* node) noexcept;
+
+        /**
+         * @brief Links two detached trees
+         * @param a Root of the first tree
+         * @param b Root of the second tree
+         * @return Root of the combined tree, whichever of a and b ranks first
+         */
+        pairingNode* link(pairingNode* a, pairingNode* b) const;
+
+        /**
+         * @brief Links a sibling list into one tree by two-pass pairing
+         * @param first Leftmost node of the list, may be nullptr
+         * @return Root of the combined tree, detached
+         * @details Links pairs left to right, then links the results right to left.
+         */
+        pairingNode* combine(pairingNode* first) const;
+
+        /**
+         * @brief Detaches a non-root node and its subtree from the tree
+         * @param node Node to cut
+         */
+        static void cut(pairingNode* node);
+
+        /**
+         * @brief Visits every node in unspecified order without recursion
+         * @param callback Callable invocable with const pairingNode*
+         */
+        template<typename Callback_>
+        void forEachNode(Callback_&& callback) const;
+
+        /**
+         * @brief Destroys all nodes
+         */
+        void destroyHeap() noexcept;
+
+    public:
+        /**
+         * @class handle
+         * @brief Refers to an element for its lifetime in a heap
+         */
+        class handle {
+            pairingNode* node_;     ///< Node of the element
+
+            /**
+             * @brief Constructs a handle to a node
+             * @param node Node of the element
+             */
+            explicit handle(pairingNode* node);
+
+            friend class pairingHeap;
+        public:
+            /**
+             * @brief Constructs a handle that refers to no element
+             */
+            handle();
+
+            /**
+             * @brief Compares two handles
+             * @param other Handle to compare with
+             * @return true if both refer to the same element
+             */
+            bool operator==(const handle& other) const = default;
+        };
+
+        /**
+         * @brief Constructs an empty heap
+         * @param compare Comparison functor instance (default: default-constructed)
+         */
+        explicit pairingHeap(const Callback<TYPE>& compare = Callback<TYPE>{});
+
+        /**
+         * @brief Copy constructor
+         * @param other Heap to copy from
+         * @details Re-inserts the elements of other; handles of other do not apply to the copy.
+         * @note The allocator is copied if propagate_on_container_copy_assignment is true
+         */
+        pairingHeap(const pairingHeap& other);
+
+        /**
+         * @brief Copy assignment operator
+         * @param other Heap to copy from
+         * @return Reference to this heap
+         * @details Re-inserts the elements of other; handles of other do not apply to the copy.
+         * @note The allocator is copied if propagate_on_container_copy_assignment is true
+         */
+        pairingHeap& operator=(const pairingHeap& other);
+
+        /**
+         * @brief Move constructor
+         * @param other Heap to move from, left empty
+         */
+        pairingHeap(pairingHeap&& other) noexcept;
+
+        /**
+         * @brief Move assignment operator
+         * @param other Heap to move from, left empty
+         * @return Reference to this heap
+         * @note The allocator is moved if propagate_on_container_move_assignment is true
+         */
+        pairingHeap& operator=(pairingHeap&& other) noexcept;
+
+        /**
+         * @brief Swaps contents with another heap in O(1)
+         * @param other Heap to swap with
+         * @note Allocators are swapped if propagate_on_container_swap is true
+         */
+        void swap(pairingHeap& other) noexcept;
+
+        /**
+         * @brief Gets number of elements
+         * @return Current size
+         */
+        [[nodiscard]] u_integer size() const override;
+
+        /**
+         * @brief Checks if an equal element is in the heap
+         * @param e Element to look for
+         * @return true if found
+         * @details Linear scan.
+         */
+        bool contains(const TYPE& e) const override;
+
+        /**
+         * @brief Inserts an element in O(1)
+         * @param e Element to insert
+         * @return Handle of the element
+         */
+        handle push(const TYPE& e);
+
+        /**
+         * @brief Extracts the highest priority element
+         * @return The extracted element
+         * @throw noElementError if the heap is empty
+         */
+        TYPE pop();
+
+        /**
+         * @brief Accesses the highest priority element
+         * @return Const reference to the top element
+         * @throw noElementError if the heap is empty
+         */
+        const TYPE& top() const;
+
+        /**
+         * @brief Accesses an element by handle
+         * @param h Handle of the element
+         * @return Const reference to the element
+         * @throw noElementError if h refers to no element
+         */
+        const TYPE& get(const handle& h) const;
+
+        /**
+         * @brief Raises the priority of an element
+         * @param h Handle of the element
+         * @param e New value, must not rank below the current one
+         * @throw noElementError if h refers to no element
+         * @throw valueError if the comparator ranks the current value before e
+         */
+        void decreaseKey(const handle& h, const TYPE& e);
+
+        /**
+         * @brief Removes an element by handle
+         * @param h Handle of the element, invalid afterward
+         * @return The removed element
+         * @throw noElementError if h refers to no element
+         */
+        TYPE erase(const handle& h);
+
+        /**
+         * @brief Moves all elements of another heap into this one in O(1)
+         * @param other Heap to merge, left empty
+         * @return Reference to this heap
+         * @details Handles into other stay valid and now refer to elements of this heap.
+         * The allocators are merged if ALLOC::propagate_on_container_merge is true.
+         */
+        pairingHeap& merge(pairingHeap& other);
+
+        /**
+         * @brief Removes all elements
+         */
+        void clear();
+
+        /**
+         * @brief Gets class name identifier
+         * @return "pairingHeap"
+         */
+        [[nodiscard]] std::string className() const override;
+
+        /**
+         * @brief Converts to string representation, elements in unspecified order
+         * @param enter Add newline if true
+         * @return String representation
+         */
+        [[nodiscard]] std::string toString(bool enter) const override;
+
+        /**
+         * @brief Destructor
+         */
+        ~pairingHeap() override;
+    };
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+original::pairingHeap<TYPE, Callback, ALLOC>::pairingNode::pairingNode(const TYPE& value)
+    : value_(value), child_(nullptr), sibling_(nullptr), prev_(nullptr) {}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+auto original::pairingHeap<TYPE, Callback, ALLOC>::createNode(const TYPE& value) -> pairingNode* {
+    auto node = this->rebind_alloc.allocate(1);
+    try {
+        this->rebind_alloc.construct(node, value);
+    } catch (...) {
+        this->rebind_alloc.deallocate(node, 1);
+        throw;
+    }
+    return node;
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+void original::pairingHeap<TYPE, Callback, ALLOC>::destroyNode(pairingNode* node) noexcept {
+    this->rebind_alloc.destroy(node);
+    this->rebind_alloc.deallocate(node, 1);
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+auto original::pairingHeap<TYPE, Callback, ALLOC>::link(pairingNode* a, pairingNode* b) const -> pairingNode* {
+    if (this->compare_(b->value_, a->value_)) {
+        std::swap(a, b);
+    }
+    b->sibling_ = a->child_;
+    if (a->child_) {
+        a->child_->prev_ = b;
+    }
+    b->prev_ = a;
+    a->child_ = b;
+    return a;
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+auto original::pairingHeap<TYPE, Callback, ALLOC>::combine(pairingNode* first) const -> pairingNode* {
+    // First pass: link neighbours pairwise, chaining the results in reverse through prev_
+    pairingNode* paired = nullptr;
+    while (first) {
+        pairingNode* a = first;
+        pairingNode* b = a->sibling_;
+        first = b ? b->sibling_ : nullptr;
+        a->sibling_ = a->prev_ = nullptr;
+        if (b) {
+            b->sibling_ = b->prev_ = nullptr;
+            a = this->link(a, b);
+        }
+        a->prev_ = paired;
+        paired = a;
+    }
+
+    // Second pass: link the results from the rightmost pair back to the leftmost
+    pairingNode* root = nullptr;
+    while (paired) {
+        pairingNode* next = paired->prev_;
+        paired->prev_ = nullptr;
+        root = root ? this->link(root, paired) : paired;
+        paired = next;
+    }
+    return root;
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+void original::pairingHeap<TYPE, Callback, ALLOC>::cut(pairingNode* node) {
+    if (node->prev_->child_ == node) {
+        node->prev_->child_ = node->sibling_;
+    } else {
+        node->prev_->sibling_ = node->sibling_;
+    }
+    if (node->sibling_) {
+        node->sibling_->prev_ = node->prev_;
+    }
+    node->sibling_ = node->prev_ = nullptr;
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+template<typename Callback_>
+void original::pairingHeap<TYPE, Callback, ALLOC>::forEachNode(Callback_&& callback) const {
+    const pairingNode* cur = this->root_;
+    while (cur) {
+        callback(cur);
+        if (cur->child_) {
+            cur = cur->child_;
+            continue;
+        }
+        // Climb until a node with a right sibling; the parent is reached through the leftmost child
+        while (cur && !cur->sibling_) {
+            while (cur->prev_ && cur->prev_->child_ != cur) {
+                cur = cur->prev_;
+            }
+            cur = cur->prev_;
+        }
+        if (cur) {
+            cur = cur->sibling_;
+        }
+    }
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+void original::pairingHeap<TYPE, Callback, ALLOC>::destroyHeap() noexcept {
+    // Splice each child list in front of the pending list, so no recursion is needed
+    pairingNode* pending = this->root_;
+    while (pending) {
+        pairingNode* node = pending;
+        pending = node->sibling_;
+        if (node->child_) {
+            pairingNode* last = node->child_;
+            while (last->sibling_) {
+                last = last->sibling_;
+            }
+            last->sibling_ = pending;
+            pending = node->child_;
+        }
+        this->destroyNode(node);
+    }
+    this->root_ = nullptr;
+    this->size_ = 0;
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+original::pairingHeap<TYPE, Callback, ALLOC>::handle::handle(pairingNode* node) : node_(node) {}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+original::pairingHeap<TYPE, Callback, ALLOC>::handle::handle() : node_(nullptr) {}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+original::pairingHeap<TYPE, Callback, ALLOC>::pairingHeap(const Callback<TYPE>& compare)
+    : root_(nullptr), size_(0), compare_(compare) {}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+original::pairingHeap<TYPE, Callback, ALLOC>::pairingHeap(const pairingHeap& other) : pairingHeap() {
+    this->operator=(other);
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+auto original::pairingHeap<TYPE, Callback, ALLOC>::operator=(const pairingHeap& other) -> pairingHeap& {
+    if (this == &other) {
+        return *this;
+    }
+
+    this->destroyHeap();
+    this->compare_ = other.compare_;
+    if constexpr (ALLOC<TYPE>::propagate_on_container_copy_assignment::value) {
+        this->allocator = other.allocator;
+        this->rebind_alloc = other.rebind_alloc;
+    }
+    other.forEachNode([this](const pairingNode* node) {
+        this->push(node->value_);
+    });
+    return *this;
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+original::pairingHeap<TYPE, Callback, ALLOC>::pairingHeap(pairingHeap&& other) noexcept : pairingHeap() {
+    this->operator=(std::move(other));
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+auto original::pairingHeap<TYPE, Callback, ALLOC>::operator=(pairingHeap&& other) noexcept -> pairingHeap& {
+    if (this == &other) {
+        return *this;
+    }
+
+    this->destroyHeap();
+    this->root_ = other.root_;
+    this->size_ = other.size_;
+    this->compare_ = std::move(other.compare_);
+    if constexpr (ALLOC<TYPE>::propagate_on_container_move_assignment::value) {
+        this->allocator = std::move(other.allocator);
+        this->rebind_alloc = std::move(other.rebind_alloc);
+    }
+    other.root_ = nullptr;
+    other.size_ = 0;
+    return *this;
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+void original::pairingHeap<TYPE, Callback, ALLOC>::swap(pairingHeap& other) noexcept {
+    if (this == &other) {
+        return;
+    }
+
+    std::swap(this->root_, other.root_);
+    std::swap(this->size_, other.size_);
+    std::swap(this->compare_, other.compare_);
+    if constexpr (ALLOC<TYPE>::propagate_on_container_swap::value) {
+        std::swap(this->allocator, other.allocator);
+        std::swap(this->rebind_alloc, other.rebind_alloc);
+    }
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+original::u_integer original::pairingHeap<TYPE, Callback, ALLOC>::size() const {
+    return this->size_;
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+bool original::pairingHeap<TYPE, Callback, ALLOC>::contains(const TYPE& e) const {
+    bool found = false;
+    this->forEachNode([&](const pairingNode* node) {
+        found = found || node->value_ == e;
+    });
+    return found;
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+auto original::pairingHeap<TYPE, Callback, ALLOC>::push(const TYPE& e) -> handle {
+    pairingNode* node = this->createNode(e);
+    this->root_ = this->root_ ? this->link(this->root_, node) : node;
+    this->size_ += 1;
+    return handle{node};
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+TYPE original::pairingHeap<TYPE, Callback, ALLOC>::pop() {
+    if (!this->root_) {
+        throw noElementError();
+    }
+
+    pairingNode* top = this->root_;
+    TYPE result = std::move(top->value_);
+    this->root_ = this->combine(top->child_);
+    this->destroyNode(top);
+    this->size_ -= 1;
+    return result;
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+const TYPE& original::pairingHeap<TYPE, Callback, ALLOC>::top() const {
+    if (!this->root_) {
+        throw noElementError();
+    }
+    return this->root_->value_;
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+const TYPE& original::pairingHeap<TYPE, Callback, ALLOC>::get(const handle& h) const {
+    if (!h.node_) {
+        throw noElementError();
+    }
+    return h.node_->value_;
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+void original::pairingHeap<TYPE, Callback, ALLOC>::decreaseKey(const handle& h, const TYPE& e) {
+    if (!h.node_) {
+        throw noElementError();
+    }
+    if (this->compare_(h.node_->value_, e)) {
+        throw valueError("decreaseKey: new value ranks below the current one");
+    }
+
+    h.node_->value_ = e;
+    if (h.node_ != this->root_) {
+        cut(h.node_);
+        this->root_ = this->link(this->root_, h.node_);
+    }
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+TYPE original::pairingHeap<TYPE, Callback, ALLOC>::erase(const handle& h) {
+    if (!h.node_) {
+        throw noElementError();
+    }
+    if (h.node_ == this->root_) {
+        return this->pop();
+    }
+
+    pairingNode* node = h.node_;
+    TYPE result = std::move(node->value_);
+    cut(node);
+    if (pairingNode* subtree = this->combine(node->child_)) {
+        this->root_ = this->link(this->root_, subtree);
+    }
+    this->destroyNode(node);
+    this->size_ -= 1;
+    return result;
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+auto original::pairingHeap<TYPE, Callback, ALLOC>::merge(pairingHeap& other) -> pairingHeap& {
+    if (this == &other || !other.root_) {
+        return *this;
+    }
+
+    this->root_ = this->root_ ? this->link(this->root_, other.root_) : other.root_;
+    this->size_ += other.size_;
+    if constexpr (ALLOC<TYPE>::propagate_on_container_merge::value) {
+        this->allocator += other.allocator;
+        this->rebind_alloc += other.rebind_alloc;
+    }
+    other.root_ = nullptr;
+    other.size_ = 0;
+    return *this;
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+void original::pairingHeap<TYPE, Callback, ALLOC>::clear() {
+    this->destroyHeap();
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+std::string original::pairingHeap<TYPE, Callback, ALLOC>::className() const {
+    return "pairingHeap";
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+std::string original::pairingHeap<TYPE, Callback, ALLOC>::toString(const bool enter) const {
+    std::stringstream ss;
+    ss << this->className();
+    ss << "(";
+    bool first = true;
+    this->forEachNode([&](const pairingNode* node) {
+        if (!first) {
+            ss << ", ";
+        }
+        ss << printable::formatString(node->value_);
+        first = false;
+    });
+    ss << ")";
+    if (enter)
+        ss << "\n";
+    return ss.str();
+}
+
+template<typename TYPE, template <typename> typename Callback, template <typename> typename ALLOC>
+requires original::Compare<Callback<TYPE>, TYPE>
+original::pairingHeap<TYPE, Callback, ALLOC>::~pairingHeap() {
+    this->destroyHeap();
+}
+
+#endif //PAIRING_HEAP_H
@@ -0,0 +1,680 @@
+#ifndef PERSISTENT_TREE_H
+#define PERSISTENT_TREE_H
+
+#include "allocator.h"
+#include "atomic.h"
+#include "comparator.h"
+#include "couple.h"
+#include "error.h"
+
+/**
+ * @file persistentTree.h
+ * @brief Persistent (path-copying) balanced search tree header
+ * @details Provides a template-based persistent AVL tree with:
+ * - O(1) snapshots that share every node with the tree they were taken from
+ * - Copy-on-write updates that copy only the nodes on the path they change
+ * - Atomic per-node reference counts, so snapshots can be released on any thread
+ * - Memory management via allocators
+ * - Custom comparison support
+ */
+
+
+namespace original {
+
+    /**
+     * @class persistentTree
+     * @tparam K_TYPE Key type (must be comparable)
+     * @tparam V_TYPE Value type
+     * @tparam ALLOC Allocator type (default: allocator<K_TYPE>)
+     * @tparam Compare Comparison function type (default: increaseComparator<K_TYPE>)
+     * @brief Persistent balanced search tree with shared, reference-counted nodes
+     * @details Nodes have no parent pointers, so a subtree can hang below any number of
+     * parents, each owning one reference to it. Copying a tree only takes another reference
+     * to the root.
+     *
+     * A write descends from the root and takes every node on its path for itself:
+     * a node referenced once is only reachable through this tree and is changed in place,
+     * a shared node is replaced by a copy that references the same children. Below the first
+     * copy every node is shared, so a write to a tree with live snapshots copies exactly
+     * the O(log n) nodes on its path, and a write to an unshared tree copies nothing.
+     *
+     * AVL balancing keeps the paths short (height below 1.45 log2(n + 2)) and needs no
+     * information from outside the path, which path copying requires.
+     */
+    template<typename K_TYPE,
+             typename V_TYPE,
+             typename ALLOC = allocator<K_TYPE>,
+             typename Compare = increaseComparator<K_TYPE>>
+    class persistentTree {
+    protected:
+
+        /**
+         * @class treeNode
+         * @brief Node shared by all trees and snapshots that reach it
+         */
+        class treeNode {
+        public:
+            couple<const K_TYPE, V_TYPE> data_;     ///< Key-value pair
+            treeNode* left_;                        ///< Left child, one owned reference
+            treeNode* right_;                       ///< Right child, one owned reference
+            u_integer height_;                      ///< Height of the subtree, 1 for a leaf
+            atomic<u_integer> refs_;                ///< Number of owners
+
+            /**
+             * @brief Constructs a node owned once
+             * @param key Key
+             * @param value Value
+             * @param left Left child, whose reference passes to the node
+             * @param right Right child, whose reference passes to the node
+             */
+            treeNode(const K_TYPE& key, const V_TYPE& value, treeNode* left, treeNode* right);
+
+            /**
+             * @brief Gets the height of a subtree
+             * @param node Subtree root, may be nullptr
+             * @return Height, 0 for the empty subtree
+             */
+            static u_integer heightOf(const treeNode* node);
+
+            /**
+             * @brief Recomputes the height from the children
+             */
+            void updateHeight();
+        };
+
+        using rebind_alloc_node = typename ALLOC::template rebind_alloc<treeNode>;  ///< Node allocator type
+
+        treeNode* root_;                            ///< Root node, one owned reference
+        u_integer size_;                            ///< Number of elements
+        Compare compare_;                           ///< Comparison function
+        mutable rebind_alloc_node rebind_alloc{};   ///< Node allocator
+
+        /**
+         * @brief Creates a node owned once
+         * @param key Key
+         * @param value Value
+         * @param left Left child, whose reference passes to the node
+         * @param right Right child, whose reference passes to the node
+         * @return New node
+         */
+        treeNode* createNode(const K_TYPE& key, const V_TYPE& value,
+                             treeNode* left = nullptr, treeNode* right = nullptr) const;
+
+        /**
+         * @brief Takes another reference to a node
+         * @param node Node, may be nullptr
+         * @return node
+         */
+        static treeNode* retain(treeNode* node);
+
+        /**
+         * @brief Drops a reference to a node
+         * @param node Node, may be nullptr
+         * @details The last owner destroys the node and drops its references to the children.
+         */
+        void release(treeNode* node) const noexcept;
+
+        /**
+         * @brief Gets a node that is safe to change in place
+         * @param node Node, its reference stays with the caller
+         * @return node if referenced once, otherwise a copy referencing the same children
+         * @details The caller releases node once a change to the copy has succeeded,
+         * or hands both to abandon() if it fails.
+         */
+        treeNode* unshare(treeNode* node) const;
+
+        /**
+         * @brief Backs out of a failed change below a node
+         * @param node Node passed to unshare(), still referenced by the caller
+         * @param owned Node unshare() returned for it
+         * @details A copy is dropped together with everything hung below it, leaving node
+         * as it was. A node changed in place keeps what was done below it and gets its height
+         * recomputed, so the tree stays a valid search tree.
+         */
+        void abandon(treeNode* node, treeNode* owned) const noexcept;
+
+        /**
+         * @brief Rotates a subtree right
+         * @param node Subtree root with a left child, reference passes to the call unless it throws
+         * @return New subtree root
+         */
+        treeNode* rotateRight(treeNode* node) const;
+
+        /**
+         * @brief Rotates a subtree left
+         * @param node Subtree root with a right child, reference passes to the call unless it throws
+         * @return New subtree root
+         */
+        treeNode* rotateLeft(treeNode* node) const;
+
+        /**
+         * @brief Restores the AVL balance of a node whose children differ in height by at most 2
+         * @param node Node referenced once, reference passes to the call
+         * @return New subtree root
+         * @details Copying a shared child for a rotation is the only step that can throw,
+         * and it happens before node changes.
+         */
+        treeNode* rebalance(treeNode* node) const;
+
+        /**
+         * @brief Inserts a key that is not in a subtree
+         * @param node Subtree root, reference passes to the call unless it throws
+         * @param key Key to insert
+         * @param value Value to insert
+         * @return New subtree root
+         */
+        treeNode* insertAt(treeNode* node, const K_TYPE& key, const V_TYPE& value) const;
+
+        /**
+         * @brief Removes the minimum node of a subtree
+         * @param node Non-empty subtree root, reference passes to the call unless it throws
+         * @param min Receives a reference to the minimum node, which keeps its old links
+         * @return New subtree root
+         * @details node must be shared, so every node on the path is copied and a failure
+         * leaves the subtree as it was.
+         */
+        treeNode* eraseMinAt(treeNode* node, treeNode*& min) const;
+
+        /**
+         * @brief Removes a key that is in a subtree
+         * @param node Subtree root, reference passes to the call unless it throws
+         * @param key Key to remove
+         * @return New subtree root
+         */
+        treeNode* eraseAt(treeNode* node, const K_TYPE& key) const;
+
+        /**
+         * @brief Copies the path to a key so its node belongs to this tree only
+         * @param key Key in the tree
+         * @return Node holding key, referenced once
+         */
+        treeNode* ownPath(const K_TYPE& key);
+
+        /**
+         * @brief Visits the pairs of a subtree within [low, high) in key order
+         * @param node Subtree root
+         * @param low Inclusive lower bound, nullptr for none
+         * @param high Exclusive upper bound, nullptr for none
+         * @param callback Callable invocable with const couple<const K_TYPE, V_TYPE>&
+         */
+        template<typename Callback>
+        void traverse(const treeNode* node, const K_TYPE* low, const K_TYPE* high, Callback& callback) const;
+
+        /**
+         * @brief Constructs an empty tree
+         * @param compare Comparison function to use
+         */
+        explicit persistentTree(Compare compare = Compare{});
+
+        /**
+         * @brief Shares the nodes of another tree in O(1)
+         * @param other Tree to share with
+         */
+        void shareTree(const persistentTree& other);
+
+        /**
+         * @brief Takes over the nodes of another tree, leaving it empty
+         * @param other Tree to move from
+         */
+        void moveTree(persistentTree& other) noexcept;
+
+        /**
+         * @brief Exchanges the nodes of two trees in O(1)
+         * @param other Tree to swap with
+         */
+        void swapTree(persistentTree& other) noexcept;
+
+        /**
+         * @brief Drops the reference to the root
+         */
+        void destroyTree() noexcept;
+
+        /**
+         * @brief Finds the node with a key
+         * @param key Key to search for
+         * @return Node, or nullptr if not found
+         */
+        const treeNode* find(const K_TYPE& key) const;
+
+        /**
+         * @brief Inserts a key-value pair
+         * @param key Key to insert
+         * @param value Value to insert
+         * @return true if inserted, false if key already existed (nothing is copied then)
+         * @details If copying a node throws, the tree is left as it was.
+         */
+        bool insert(const K_TYPE& key, const V_TYPE& value);
+
+        /**
+         * @brief Sets the value of an existing key
+         * @param key Key to modify
+         * @param value New value
+         * @return true if key was found
+         */
+        bool modify(const K_TYPE& key, const V_TYPE& value);
+
+        /**
+         * @brief Erases a key
+         * @param key Key to erase
+         * @return true if key was found and erased
+         * @details If copying a node throws, the tree is left with or without key,
+         * and its size matches either way. Snapshots are never affected.
+         */
+        bool erase(const K_TYPE& key);
+
+        /**
+         * @brief Destructor
+         * @details Drops the reference to the root; nodes still shared by snapshots survive.
+         */
+        ~persistentTree();
+    };
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::treeNode::treeNode(
+    const K_TYPE& key, const V_TYPE& value, treeNode* left, treeNode* right)
+    : data_({key, value}), left_(left), right_(right), height_(0), refs_(makeAtomic<u_integer>(1)) {
+    this->updateHeight();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+original::u_integer
+original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::treeNode::heightOf(const treeNode* node) {
+    return node ? node->height_ : 0;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::treeNode::updateHeight() {
+    const u_integer left = heightOf(this->left_);
+    const u_integer right = heightOf(this->right_);
+    this->height_ = 1 + (left > right ? left : right);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::treeNode*
+original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::createNode(const K_TYPE& key, const V_TYPE& value,
+                                                                    treeNode* left, treeNode* right) const {
+    auto node = this->rebind_alloc.allocate(1);
+    try {
+        this->rebind_alloc.construct(node, key, value, left, right);
+    } catch (...) {
+        this->rebind_alloc.deallocate(node, 1);
+        throw;
+    }
+    return node;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::treeNode*
+original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::retain(treeNode* node) {
+    if (node) {
+        node->refs_ += 1;
+    }
+    return node;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::release(treeNode* node) const noexcept {
+    while (node) {
+        u_integer refs = node->refs_.load();
+        while (!node->refs_.exchangeCmp(refs, refs - 1)) {}
+        if (refs != 1) {
+            return;
+        }
+
+        // Recurse into one child and loop on the other, so a long spine needs no deep stack
+        this->release(node->left_);
+        treeNode* next = node->right_;
+        this->rebind_alloc.destroy(node);
+        this->rebind_alloc.deallocate(node, 1);
+        node = next;
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::treeNode*
+original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::unshare(treeNode* node) const {
+    if (node->refs_.load() == 1) {
+        return node;
+    }
+
+    // The children are shared only once the copy exists, so a throwing copy leaks nothing
+    auto copied = this->createNode(node->data_.first(), node->data_.second());
+    copied->left_ = retain(node->left_);
+    copied->right_ = retain(node->right_);
+    copied->updateHeight();
+    return copied;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::abandon(treeNode* node,
+                                                                      treeNode* owned) const noexcept {
+    if (owned != node) {
+        this->release(owned);
+    } else {
+        node->updateHeight();
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::treeNode*
+original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::rotateRight(treeNode* node) const {
+    treeNode* owned = this->unshare(node);
+    treeNode* left;
+    try {
+        left = this->unshare(owned->left_);
+    } catch (...) {
+        this->abandon(node, owned);
+        throw;
+    }
+    if (owned != node) {
+        this->release(node);
+    }
+    if (left != owned->left_) {
+        this->release(owned->left_);
+    }
+    owned->left_ = left->right_;
+    left->right_ = owned;
+    owned->updateHeight();
+    left->updateHeight();
+    return left;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::treeNode*
+original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::rotateLeft(treeNode* node) const {
+    treeNode* owned = this->unshare(node);
+    treeNode* right;
+    try {
+        right = this->unshare(owned->right_);
+    } catch (...) {
+        this->abandon(node, owned);
+        throw;
+    }
+    if (owned != node) {
+        this->release(node);
+    }
+    if (right != owned->right_) {
+        this->release(owned->right_);
+    }
+    owned->right_ = right->left_;
+    right->left_ = owned;
+    owned->updateHeight();
+    right->updateHeight();
+    return right;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::treeNode*
+original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::rebalance(treeNode* node) const {
+    const u_integer left = treeNode::heightOf(node->left_);
+    const u_integer right = treeNode::heightOf(node->right_);
+    if (left > right + 1) {
+        if (treeNode::heightOf(node->left_->left_) < treeNode::heightOf(node->left_->right_)) {
+            node->left_ = this->rotateLeft(node->left_);
+        }
+        return this->rotateRight(node);
+    }
+    if (right > left + 1) {
+        if (treeNode::heightOf(node->right_->right_) < treeNode::heightOf(node->right_->left_)) {
+            node->right_ = this->rotateRight(node->right_);
+        }
+        return this->rotateLeft(node);
+    }
+    node->updateHeight();
+    return node;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::treeNode*
+original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::insertAt(treeNode* node, const K_TYPE& key,
+                                                                  const V_TYPE& value) const {
+    if (!node) {
+        return this->createNode(key, value);
+    }
+
+    treeNode* owned = this->unshare(node);
+    treeNode* root;
+    try {
+        if (this->compare_(key, owned->data_.first())) {
+            owned->left_ = this->insertAt(owned->left_, key, value);
+        } else {
+            owned->right_ = this->insertAt(owned->right_, key, value);
+        }
+        root = this->rebalance(owned);
+    } catch (...) {
+        this->abandon(node, owned);
+        throw;
+    }
+    if (owned != node) {
+        this->release(node);
+    }
+    return root;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::treeNode*
+original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::eraseMinAt(treeNode* node, treeNode*& min) const {
+    if (!node->left_) {
+        min = node;
+        return retain(node->right_);
+    }
+
+    treeNode* owned = this->unshare(node);
+    try {
+        owned->left_ = this->eraseMinAt(owned->left_, min);
+    } catch (...) {
+        this->abandon(node, owned);
+        throw;
+    }
+    treeNode* root;
+    try {
+        root = this->rebalance(owned);
+    } catch (...) {
+        // owned is a copy, so node still links min and the reference handed out is dropped
+        this->release(min);
+        this->abandon(node, owned);
+        throw;
+    }
+    if (owned != node) {
+        this->release(node);
+    }
+    return root;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::treeNode*
+original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::eraseAt(treeNode* node, const K_TYPE& key) const {
+    if (!(node->data_.first() == key)) {
+        treeNode* owned = this->unshare(node);
+        treeNode* root;
+        try {
+            if (this->compare_(key, owned->data_.first())) {
+                owned->left_ = this->eraseAt(owned->left_, key);
+            } else {
+                owned->right_ = this->eraseAt(owned->right_, key);
+            }
+            root = this->rebalance(owned);
+        } catch (...) {
+            this->abandon(node, owned);
+            throw;
+        }
+        if (owned != node) {
+            this->release(node);
+        }
+        return root;
+    }
+
+    treeNode* replacement;
+    if (!node->left_) {
+        replacement = retain(node->right_);
+    } else if (!node->right_) {
+        replacement = retain(node->left_);
+    } else {
+        // The key is const, so the successor's pair moves into a new node
+        treeNode* min;
+        treeNode* right = retain(node->right_);
+        try {
+            right = this->eraseMinAt(right, min);
+        } catch (...) {
+            this->release(right);
+            throw;
+        }
+        try {
+            replacement = this->createNode(min->data_.first(), min->data_.second());
+        } catch (...) {
+            this->release(right);
+            this->release(min);
+            throw;
+        }
+        this->release(min);
+        replacement->left_ = retain(node->left_);
+        replacement->right_ = right;
+        replacement->updateHeight();
+        try {
+            replacement = this->rebalance(replacement);
+        } catch (...) {
+            this->release(replacement);
+            throw;
+        }
+    }
+    this->release(node);
+    return replacement;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::treeNode*
+original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::ownPath(const K_TYPE& key) {
+    treeNode** link = &this->root_;
+    while (true) {
+        treeNode* node = this->unshare(*link);
+        if (node != *link) {
+            this->release(*link);
+            *link = node;
+        }
+        if (node->data_.first() == key) {
+            return node;
+        }
+        link = this->compare_(key, node->data_.first()) ? &node->left_ : &node->right_;
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+template<typename Callback>
+void original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::traverse(const treeNode* node, const K_TYPE* low,
+                                                                       const K_TYPE* high, Callback& callback) const {
+    while (node) {
+        const bool above_low = !low || !this->compare_(node->data_.first(), *low);
+        const bool below_high = !high || this->compare_(node->data_.first(), *high);
+        if (above_low) {
+            this->traverse(node->left_, low, high, callback);
+        }
+        if (above_low && below_high) {
+            callback(node->data_);
+        }
+        if (!below_high) {
+            return;
+        }
+        node = node->right_;
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::persistentTree(Compare compare)
+    : root_(nullptr), size_(0), compare_(std::move(compare)) {}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::shareTree(const persistentTree& other) {
+    treeNode* old_root = this->root_;
+    this->root_ = retain(other.root_);
+    this->size_ = other.size_;
+    this->compare_ = other.compare_;
+    this->rebind_alloc = other.rebind_alloc;
+    this->release(old_root);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::moveTree(persistentTree& other) noexcept {
+    this->destroyTree();
+    this->root_ = other.root_;
+    this->size_ = other.size_;
+    this->compare_ = other.compare_;
+    this->rebind_alloc = std::move(other.rebind_alloc);
+    other.root_ = nullptr;
+    other.size_ = 0;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::swapTree(persistentTree& other) noexcept {
+    std::swap(this->root_, other.root_);
+    std::swap(this->size_, other.size_);
+    std::swap(this->compare_, other.compare_);
+    std::swap(this->rebind_alloc, other.rebind_alloc);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::destroyTree() noexcept {
+    this->release(this->root_);
+    this->root_ = nullptr;
+    this->size_ = 0;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+const typename original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::treeNode*
+original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::find(const K_TYPE& key) const {
+    const treeNode* cur = this->root_;
+    while (cur) {
+        if (cur->data_.first() == key) {
+            return cur;
+        }
+        cur = this->compare_(key, cur->data_.first()) ? cur->left_ : cur->right_;
+    }
+    return nullptr;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+bool original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::insert(const K_TYPE& key, const V_TYPE& value) {
+    if (this->find(key)) {
+        return false;
+    }
+
+    this->root_ = this->insertAt(this->root_, key, value);
+    this->size_ += 1;
+    return true;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+bool original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::modify(const K_TYPE& key, const V_TYPE& value) {
+    if (!this->find(key)) {
+        return false;
+    }
+
+    this->ownPath(key)->data_.second() = value;
+    return true;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+bool original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::erase(const K_TYPE& key) {
+    if (!this->find(key)) {
+        return false;
+    }
+
+    try {
+        this->root_ = this->eraseAt(this->root_, key);
+    } catch (...) {
+        // A rotation below a node changed in place can fail after the key is already gone
+        if (!this->find(key)) {
+            this->size_ -= 1;
+        }
+        throw;
+    }
+    this->size_ -= 1;
+    return true;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+original::persistentTree<K_TYPE, V_TYPE, ALLOC, Compare>::~persistentTree() {
+    this->destroyTree();
+}
+
+#endif //PERSISTENT_TREE_H
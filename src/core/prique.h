@@ -7,6 +7,8 @@
  * @details Provides a heap-based priority queue with configurable comparison logic
  * and underlying storage. Supports efficient insertion and extraction of highest
  * priority elements according to the specified comparator.
+ * @see indexedHeap.h For a contiguous d-ary heap whose elements can be re-prioritized or erased
+ * @see pairingHeap.h For a heap that merges with another in O(1)
  */
 
 #include "algorithms.h"
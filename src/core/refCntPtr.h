@@ -193,6 +193,17 @@ namespace original{
         template<typename U, typename DEL = DELETER::template rebound_deleter<U>>
         strongPtr<U, DEL> constCastTo() const;
 
+        /**
+        * @brief Aliases a subobject of the managed object
+        * @tparam U Type of the subobject
+        * @tparam DEL Rebound deleter type for target type
+        * @param member Pointer into the managed object, e.g. to one of its fields
+        * @return strongPtr<U, DEL> pointing to member with same reference counter
+        * @note The whole managed object stays alive as long as the returned pointer does
+        */
+        template<typename U, typename DEL = DELETER::template rebound_deleter<U>>
+        strongPtr<U, DEL> aliasTo(U* member) const;
+
         /**
         * @brief Resets the smart pointer and releases the managed object
         * @details Performs the following sequence of operations:
@@ -596,6 +607,13 @@ namespace original{
         return strongPtr<U, DEL>{*this->ref_count, alias};
     }
 
+    template <typename TYPE, typename DELETER>
+    template <typename U, typename DEL>
+    strongPtr<U, DEL> strongPtr<TYPE, DELETER>::aliasTo(U* member) const
+    {
+        return strongPtr<U, DEL>{*this->ref_count, member};
+    }
+
     template<typename TYPE, typename DELETER>
     void strongPtr<TYPE, DELETER>::reset() noexcept {
         this->removeStrongRef();
@@ -9,17 +9,19 @@
 #include "ownerPtr.h"
 #include "comparator.h"
 #include "RBTree.h"
+#include "BTree.h"
 #include "skipList.h"
 
 
 /**
  * @file sets.h
  * @brief Implementation of set containers with different underlying data structures
- * @details Provides three set implementations with different performance characteristics
+ * @details Provides four set implementations with different performance characteristics
  * and iteration capabilities:
  * 1. hashSet - Hash table based implementation (unordered, fastest average case)
  * 2. treeSet - Red-Black Tree based implementation (ordered, consistent performance)
  * 3. JSet - Skip List based implementation (ordered, probabilistic balance)
+ * 4. btreeSet - B+ Tree based implementation (ordered, wide cache-friendly nodes)
  *
  * Common Features:
  * - Unique element storage (no duplicates)
@@ -36,16 +38,19 @@
  * | hashSet   | O(1) avg     | O(1)     | O(1)     | No      | Medium-High  |
  * | treeSet   | O(log n)     | O(log n) | O(log n) | Yes     | Low          |
  * | JSet      | O(log n) avg | O(log n) | O(log n) | Yes     | Medium       |
+ * | btreeSet  | O(log n)     | O(log n) | O(log n) | Yes     | Low          |
  *
  * Usage Guidelines:
  * - Use hashSet for maximum performance when order doesn't matter and elements are hashable
  * - Use treeSet for ordered traversal, range queries, and consistent worst-case performance
  * - Use JSet for concurrent scenarios (external synchronization) or when probabilistic balance is preferred
+ * - Use btreeSet for large ordered sets where lookups are bound by cache misses, and for range scans
  *
  * Iterator Invalidation:
  * - hashSet: Iterators invalidate on rehash (insertion that causes capacity change)
  * - treeSet: Iterators invalidate on element removal that affects the current position
  * - JSet: Iterators invalidate on any structural modification
+ * - btreeSet: Iterators invalidate on any insertion or removal (elements move between leaves)
  *
  * Exception Safety:
  * - Basic guarantee: Container remains valid but unspecified state on exception
@@ -56,6 +61,7 @@
  * @see hashTable.h For hashSet implementation details
  * @see RBTree.h For treeSet implementation details
  * @see skipList.h For JSet implementation details
+ * @see BTree.h For btreeSet implementation details
  * @see printable.h For string formatting support
  */
 
@@ -76,6 +82,7 @@ namespace original {
      * - Insertion: Average O(1), Worst O(n)
      * - Lookup: Average O(1), Worst O(n)
      * - Deletion: Average O(1), Worst O(n)
+     * - Union: Average O(n + m); intersection, difference: Average O(n)
      *
      * The implementation guarantees:
      * - Unique elements (no duplicates)
@@ -256,6 +263,15 @@ namespace original {
          */
         explicit hashSet(HASH hash = HASH{}, ALLOC alloc = ALLOC{});
 
+        /**
+         * @brief Constructs empty hashSet sized for an expected number of elements
+         * @param capacity Number of elements to hold without rehashing
+         * @param hash Hash function to use
+         * @param alloc Allocator to use
+         * @see reserve
+         */
+        explicit hashSet(u_integer capacity, HASH hash = HASH{}, ALLOC alloc = ALLOC{});
+
         /**
          * @brief Copy constructor
          * @param other hashSet to copy
@@ -341,6 +357,57 @@ namespace original {
          */
         bool remove(const TYPE &e) override;
 
+        /**
+         * @brief Adds every element of another hashSet
+         * @param other Set to add from
+         * @details Reserves buckets for both sets once, then inserts without rehashing.
+         * O(n + m) expected.
+         */
+        void unionWith(const hashSet& other);
+
+        /**
+         * @brief Keeps only the elements also in another hashSet
+         * @param other Set to intersect with
+         * @details One pass over the buckets with an expected O(1) lookup per element,
+         * O(n) expected.
+         */
+        void intersectWith(const hashSet& other);
+
+        /**
+         * @brief Removes the elements in another hashSet
+         * @param other Set to subtract
+         * @details One pass over the buckets with an expected O(1) lookup per element,
+         * O(n) expected.
+         */
+        void differenceWith(const hashSet& other);
+
+        /**
+         * @brief Sizes the bucket array for an expected number of elements
+         * @param expected Number of elements to hold without rehashing
+         * @details Rehashes at most once; never shrinks the set. The reserved size
+         * is kept by later insertions and may only shrink again through remove().
+         * @note Invalidates all iterators if the set is rehashed
+         */
+        void reserve(u_integer expected);
+
+        /**
+         * @brief Adds all elements produced by a source
+         * @tparam SOURCE Range of TYPE, e.g. any iterable or coroutine::generator
+         * @param source Elements to add
+         * @param thread_cnt Number of threads that link the elements into the buckets
+         * @return Number of elements added
+         * @details Collects the elements into nodes first, sizes the bucket array once for
+         * the final element count and then links all nodes, instead of running add() and
+         * its stepwise rehashing for each element. Duplicates are skipped as with add().
+         *
+         * With thread_cnt > 1 the nodes are hash partitioned across threads that each own
+         * a contiguous bucket range; the result is the same as the sequential build.
+         * @note The parallel build requires HASH and element comparison to be safe to call
+         *       concurrently
+         */
+        template<typename SOURCE>
+        u_integer bulkInsert(SOURCE&& source, u_integer thread_cnt = 1);
+
         /**
          * @brief Gets begin iterator
          * @return New iterator at first element
@@ -386,6 +453,8 @@ namespace original {
      * - Lookup: O(log n)
      * - Deletion: O(log n)
      * - Traversal: O(n)
+     * - Rank, select, iterator jumps and distance: O(log n)
+     * - Union, intersection, difference: O(m log(n / m + 1)) via join/split (parallel versions in parallelTrees.h)
      *
      * The implementation guarantees:
      * - Elements sorted according to comparator
@@ -471,17 +540,22 @@ namespace original {
             /**
              * @brief Advances iterator by steps
              * @param steps Number of positions to advance
+             * @details O(log n) for any step count, through the subtree sizes.
              */
             void operator+=(integer steps) const override;
 
             /**
              * @brief Rewinds iterator by steps
              * @param steps Number of positions to rewind
+             * @details O(log n) for any step count, through the subtree sizes.
              */
             void operator-=(integer steps) const override;
 
             /**
-             * @brief Not supported (throws unSupportedMethodError)
+             * @brief Gets the number of positions from other to this iterator
+             * @param other Iterator to measure from
+             * @return Distance in O(log n); an invalid iterator counts as one past the
+             * maximum element. Iterators of other containers give the max or min integer.
              */
             integer operator-(const iterator<const TYPE> &other) const override;
 
@@ -563,6 +637,20 @@ namespace original {
          */
         explicit treeSet(Compare comp = Compare{}, ALLOC alloc = ALLOC{});
 
+        /**
+         * @brief Builds a treeSet from sorted elements in O(n)
+         * @tparam SOURCE Range of TYPE in ascending order
+         * @param sorted Elements to insert
+         * @param comp Comparison function to use; sorted must be ordered by it
+         * @param alloc Allocator to use
+         * @return New treeSet holding the elements
+         * @throw valueError if sorted is not in ascending order
+         * @details Links the nodes into a balanced, correctly colored tree directly,
+         * without per-element descents or rotations. Repeated elements are skipped.
+         */
+        template<typename SOURCE>
+        static treeSet fromSorted(SOURCE&& sorted, Compare comp = Compare{}, ALLOC alloc = ALLOC{});
+
         /**
          * @brief Copy constructor
          * @param other treeSet to copy
@@ -648,6 +736,61 @@ namespace original {
          */
         bool remove(const TYPE &e) override;
 
+        /**
+         * @brief Adds a batch of sorted elements
+         * @tparam SOURCE Range of TYPE in ascending order
+         * @param sorted Elements to add
+         * @return Number of elements added
+         * @throw valueError if sorted is not in ascending order; the set is unchanged
+         * @details Elements already in the set and repeated elements are skipped, as with
+         * add(). An empty set is built in O(m); a batch that is large relative to the set
+         * is merged with the existing elements and relinked in O(n + m); a small batch is
+         * inserted element by element in O(m log n).
+         * @note Iterators stay valid, as existing nodes are reused
+         */
+        template<typename SOURCE>
+        u_integer bulkLoad(SOURCE&& sorted);
+
+        /**
+         * @brief Gets the position an element has, or would have, in order
+         * @param e Element to rank
+         * @return Number of elements ordered before e
+         * @details O(log n); e does not have to be present.
+         */
+        [[nodiscard]] u_integer rank(const TYPE& e) const;
+
+        /**
+         * @brief Gets the element at a position in order
+         * @param index Zero-based position
+         * @return Const reference to the element with index smaller elements before it
+         * @throw outOfBoundError if index >= size()
+         * @details O(log n)
+         */
+        const TYPE& select(u_integer index) const;
+
+        /**
+         * @brief Adds every element of another treeSet
+         * @param other treeSet ordered by the same comparison
+         * @details Join/split based: this tree is split at the keys of other and joined again,
+         * so keys present in both keep this treeSet's nodes. O(m log(n / m + 1))
+         * for sizes m <= n. Iterators to the kept nodes stay valid.
+         */
+        void unionWith(const treeSet& other);
+
+        /**
+         * @brief Keeps only the elements also in another treeSet
+         * @param other treeSet ordered by the same comparison
+         * @details Join/split based like unionWith(). O(m log(n / m + 1))
+         */
+        void intersectWith(const treeSet& other);
+
+        /**
+         * @brief Removes the elements in another treeSet
+         * @param other treeSet ordered by the same comparison
+         * @details Join/split based like unionWith(). O(m log(n / m + 1))
+         */
+        void differenceWith(const treeSet& other);
+
         /**
          * @brief Gets begin iterator
          * @return New iterator at first element (minimum element)
@@ -697,6 +840,7 @@ namespace original {
      * - Insertion: Average O(log n), Worst O(n)
      * - Lookup: Average O(log n), Worst O(n)
      * - Deletion: Average O(log n), Worst O(n)
+     * - Union, intersection, difference: O(n + m) by linear merge
      *
      * The implementation guarantees:
      * - Elements sorted according to comparator
@@ -930,7 +1074,342 @@ namespace original {
          * // Now set1 contains 2, set2 contains 1
          * @endcode
          */
-        void swap(JSet& other) noexcept;
+        void swap(JSet& other) noexcept;
+
+        /**
+         * @brief Gets number of elements
+         * @return Current size
+         */
+        [[nodiscard]] u_integer size() const override;
+
+        /**
+         * @brief Checks if element exists
+         * @param e Element to check
+         * @return true if element exists
+         */
+        bool contains(const TYPE &e) const override;
+
+        /**
+         * @brief Adds new element
+         * @param e Element to add
+         * @return true if added, false if element existed
+         */
+        bool add(const TYPE &e) override;
+
+        /**
+         * @brief Removes element
+         * @param e Element to remove
+         * @return true if removed, false if element didn't exist
+         * @note Average O(log n), worst case O(n) time complexity
+         */
+        bool remove(const TYPE &e) override;
+
+        /**
+         * @brief Adds every element of another JSet
+         * @param other JSet ordered by the same comparison
+         * @details Linear merge of both sorted lists, O(n + m). Existing nodes stay in place.
+         */
+        void unionWith(const JSet& other);
+
+        /**
+         * @brief Keeps only the elements also in another JSet
+         * @param other JSet ordered by the same comparison
+         * @details Linear merge of both sorted lists, O(n + m).
+         */
+        void intersectWith(const JSet& other);
+
+        /**
+         * @brief Removes the elements in another JSet
+         * @param other JSet ordered by the same comparison
+         * @details Linear merge of both sorted lists, O(n + m).
+         */
+        void differenceWith(const JSet& other);
+
+        /**
+         * @brief Gets begin iterator
+         * @return New iterator at first element (minimum element)
+         * @note O(log n) time complexity to find first element
+         */
+        Iterator* begins() const override;
+
+        /**
+         * @brief Gets end iterator
+         * @return New iterator at last element (maximum element)
+         * @note O(log n) time complexity to find last element
+         */
+        Iterator* ends() const override;
+
+        /**
+         * @brief Gets class name
+         * @return "JSet"
+         */
+        [[nodiscard]] std::string className() const override;
+
+        /**
+         * @brief Converts to string representation
+         * @param enter Add newline if true
+         * @return String representation of elements
+         * @note O(n) time complexity
+         */
+        [[nodiscard]] std::string toString(bool enter) const override;
+
+        /**
+         * @brief Destructor
+         * @details Cleans up all skip list nodes and allocated memory
+         * @note O(n) time complexity
+         */
+        ~JSet() override;
+    };
+
+    /**
+     * @class btreeSet
+     * @tparam TYPE Element type (must be comparable)
+     * @tparam Compare Comparison function type (default: increaseComparator<TYPE>)
+     * @tparam ALLOC Allocator type (default: allocator<couple<const TYPE, const bool>>)
+     * @tparam FANOUT Node width of the underlying B+ Tree (default: 32, even and >= 4)
+     * @brief B+ Tree based implementation of the set interface
+     * @details This class provides a concrete implementation of the set interface
+     * using a B+ Tree. It combines the functionality of:
+     * - set (interface)
+     * - BTree (storage with bool values)
+     * - iterable (iteration support)
+     *
+     * Performance Characteristics:
+     * - Insertion: O(log n)
+     * - Lookup: O(log n), one node per tree level instead of one per comparison
+     * - Deletion: O(log n)
+     * - Traversal: O(n) along linked leaves
+     * - Range scan: O(log n + k) via forEachInRange()
+     *
+     * The implementation guarantees:
+     * - Elements sorted according to comparator
+     * - Unique elements (no duplicates)
+     * - Type safety
+     * - Exception safety (basic guarantee)
+     * - Iterator validity unless modified
+     *
+     * @note Unlike treeSet, insertions and removals move elements within and between leaves,
+     *       so any modification invalidates iterators.
+     */
+    template <typename TYPE,
+              typename Compare = increaseComparator<TYPE>,
+              typename ALLOC = allocator<couple<const TYPE, const bool>>,
+              u_integer FANOUT = 32>
+    class btreeSet final : public BTree<TYPE, const bool, ALLOC, Compare, FANOUT>,
+                           public set<TYPE, ALLOC>,
+                           public iterable<const TYPE>,
+                           public printable {
+
+        /**
+         * @typedef BTreeType
+         * @brief Alias for the underlying B+ tree implementation.
+         */
+        using BTreeType = BTree<TYPE, const bool, ALLOC, Compare, FANOUT>;
+
+        /**
+         * @typedef leafNode
+         * @brief Leaf node type of the B+ Tree storage
+         */
+        using leafNode = BTreeType::leafNode;
+    public:
+
+        /**
+         * @class Iterator
+         * @brief Bidirectional iterator for btreeSet
+         * @details Provides iteration over btreeSet elements while maintaining:
+         * - Sorted traversal order (according to comparator)
+         * - Safe invalidation detection
+         * - Const-correct access
+         *
+         * Iterator Characteristics:
+         * - Both forward and backward iteration along the linked leaves
+         * - Invalidates on map modification
+         * - Lightweight copy semantics
+         */
+        class Iterator final : public BTreeType::Iterator,
+                               public baseIterator<const TYPE> {
+            /**
+             * @brief Constructs iterator pointing to an element in a leaf
+             * @param tree Pointer to owning tree
+             * @param leaf Current leaf
+             * @param index Position in the leaf
+             * @note Internal constructor, not meant for direct use
+             */
+            explicit Iterator(BTreeType* tree, leafNode* leaf, u_integer index);
+
+            /**
+             * @brief Compares iterator pointers for equality
+             * @param other Iterator to compare with
+             * @return true if iterators point to same element
+             * @internal
+             */
+            bool equalPtr(const iterator<const TYPE>* other) const override;
+        public:
+            friend class btreeSet;
+
+            /**
+             * @brief Copy constructor
+             * @param other Iterator to copy
+             */
+            Iterator(const Iterator& other);
+
+            /**
+             * @brief Copy assignment operator
+             * @param other Iterator to copy
+             * @return Reference to this iterator
+             */
+            Iterator& operator=(const Iterator& other);
+
+            /**
+             * @brief Creates a copy of this iterator
+             * @return New iterator instance
+             */
+            Iterator* clone() const override;
+
+            /**
+             * @brief Gets iterator class name
+             * @return "btreeSet::Iterator"
+             */
+            [[nodiscard]] std::string className() const override;
+
+            /**
+             * @brief Advances iterator by steps
+             * @param steps Number of positions to advance
+             */
+            void operator+=(integer steps) const override;
+
+            /**
+             * @brief Rewinds iterator by steps
+             * @param steps Number of positions to rewind
+             */
+            void operator-=(integer steps) const override;
+
+            /**
+             * @brief Not supported (throws unSupportedMethodError)
+             */
+            integer operator-(const iterator<const TYPE> &other) const override;
+
+            /**
+             * @brief Checks if more elements exist in forward direction
+             * @return true if more elements available
+             */
+            [[nodiscard]] bool hasNext() const override;
+
+            /**
+             * @brief Checks if more elements exist in backward direction
+             * @return true if more elements available
+             */
+            [[nodiscard]] bool hasPrev() const override;
+
+            /**
+             * @brief Checks if other is previous to this
+             * @param other Iterator to check
+             * @return true if other is previous
+             */
+            bool atPrev(const iterator<const TYPE>* other) const override;
+
+            /**
+             * @brief Checks if other is next to this
+             * @param other Iterator to check
+             * @return true if other is next
+             */
+            bool atNext(const iterator<const TYPE>* other) const override;
+
+            /**
+             * @brief Moves to next element
+             */
+            void next() const override;
+
+            /**
+             * @brief Moves to previous element
+             */
+            void prev() const override;
+
+            /**
+             * @brief Gets previous iterator
+             * @return New iterator at previous position
+             */
+            Iterator* getPrev() const override;
+
+            /**
+             * @brief Gets current element (non-const)
+             * @return Const reference to current element
+             */
+            const TYPE& get() override;
+
+            /**
+             * @brief Gets current element (const)
+             * @return Copy of current element
+             */
+            const TYPE get() const override;
+
+            /**
+             * @brief Not supported
+             * @throw unSupportedMethodError
+             */
+            void set(const TYPE &data) override;
+
+            /**
+             * @brief Checks if iterator is valid
+             * @return true if iterator points to valid element
+             */
+            [[nodiscard]] bool isValid() const override;
+
+            ~Iterator() override = default;
+        };
+
+        friend class Iterator;
+
+        /**
+         * @brief Constructs empty btreeSet
+         * @param comp Comparison function to use
+         * @param alloc Allocator to use
+         */
+        explicit btreeSet(Compare comp = Compare{}, ALLOC alloc = ALLOC{});
+
+        /**
+         * @brief Copy constructor
+         * @param other btreeSet to copy
+         * @details Copies the tree node by node, without re-inserting elements
+         * @note Allocator is copied if propagate_on_container_copy_assignment is true
+         */
+        btreeSet(const btreeSet& other);
+
+        /**
+         * @brief Copy assignment operator
+         * @param other btreeSet to copy
+         * @return Reference to this btreeSet
+         * @details Copies the tree node by node, without re-inserting elements
+         * @note Allocator is copied if propagate_on_container_copy_assignment is true
+         */
+        btreeSet& operator=(const btreeSet& other);
+
+        /**
+         * @brief Move constructor
+         * @param other btreeSet to move from
+         * @details Transfers ownership of resources from other
+         * @note Leaves other in valid but unspecified state
+         */
+        btreeSet(btreeSet&& other) noexcept;
+
+        /**
+         * @brief Move assignment operator
+         * @param other btreeSet to move from
+         * @return Reference to this btreeSet
+         * @details Transfers ownership of resources from other
+         * @note Leaves other in valid but unspecified state
+         * @note Allocator is moved if propagate_on_container_move_assignment is true
+         */
+        btreeSet& operator=(btreeSet&& other) noexcept;
+
+        /**
+         * @brief Swaps contents with another btreeSet
+         * @param other btreeSet to swap with
+         * @details Exchanges roots, leaf list ends, size counters, comparison functions
+         * and allocators (if ALLOC::propagate_on_container_swap::value is true) in O(1).
+         * All iterators from both sets are invalidated.
+         */
+        void swap(btreeSet& other) noexcept;
 
         /**
          * @brief Gets number of elements
@@ -956,27 +1435,35 @@ namespace original {
          * @brief Removes element
          * @param e Element to remove
          * @return true if removed, false if element didn't exist
-         * @note Average O(log n), worst case O(n) time complexity
          */
         bool remove(const TYPE &e) override;
 
+        /**
+         * @brief Visits the elements in [low, high) in order
+         * @tparam Callback Callable invocable with const TYPE&
+         * @param low Inclusive lower bound
+         * @param high Exclusive upper bound
+         * @param operation Visitor
+         * @details Descends once to low, then walks the linked leaves sequentially.
+         */
+        template<typename Callback>
+        void forEachInRange(const TYPE& low, const TYPE& high, Callback operation) const;
+
         /**
          * @brief Gets begin iterator
          * @return New iterator at first element (minimum element)
-         * @note O(log n) time complexity to find first element
          */
         Iterator* begins() const override;
 
         /**
          * @brief Gets end iterator
          * @return New iterator at last element (maximum element)
-         * @note O(log n) time complexity to find last element
          */
         Iterator* ends() const override;
 
         /**
          * @brief Gets class name
-         * @return "JSet"
+         * @return "btreeSet"
          */
         [[nodiscard]] std::string className() const override;
 
@@ -984,16 +1471,14 @@ namespace original {
          * @brief Converts to string representation
          * @param enter Add newline if true
          * @return String representation of elements
-         * @note O(n) time complexity
          */
         [[nodiscard]] std::string toString(bool enter) const override;
 
         /**
          * @brief Destructor
-         * @details Cleans up all skip list nodes and allocated memory
-         * @note O(n) time complexity
+         * @details Cleans up all tree nodes and allocated memory
          */
-        ~JSet() override;
+        ~btreeSet() override;
     };
 }
 
@@ -1069,6 +1554,22 @@ namespace std {
     template <typename TYPE, typename COMPARE, typename ALLOC>
     void swap(original::JSet<TYPE, COMPARE, ALLOC>& lhs, // NOLINT
               original::JSet<TYPE, COMPARE, ALLOC>& rhs) noexcept;
+
+    /**
+     * @brief std::swap specialization for btreeSet
+     * @tparam TYPE Element type
+     * @tparam COMPARE Comparison function type
+     * @tparam ALLOC Allocator type for memory management
+     * @tparam FANOUT Node width of the underlying B+ Tree
+     * @param lhs First btreeSet to swap
+     * @param rhs Second btreeSet to swap
+     * @note No-throw guarantee if btreeSet::swap is noexcept
+     * @details Delegates to btreeSet::swap(). All iterators from both sets are invalidated.
+     * @see btreeSet::swap For the underlying swap implementation
+     */
+    template <typename TYPE, typename COMPARE, typename ALLOC, original::u_integer FANOUT>
+    void swap(original::btreeSet<TYPE, COMPARE, ALLOC, FANOUT>& lhs, // NOLINT
+              original::btreeSet<TYPE, COMPARE, ALLOC, FANOUT>& rhs) noexcept;
 }
 
 template<typename TYPE, typename HASH, typename ALLOC>
@@ -1199,6 +1700,12 @@ original::hashSet<TYPE, HASH, ALLOC>::hashSet(HASH hash, ALLOC alloc)
     : hashTable<TYPE, const bool, ALLOC, HASH>(std::move(hash)),
       set<TYPE, ALLOC>(std::move(alloc)) {}
 
+template<typename TYPE, typename HASH, typename ALLOC>
+original::hashSet<TYPE, HASH, ALLOC>::hashSet(const u_integer capacity, HASH hash, ALLOC alloc)
+    : hashSet(std::move(hash), std::move(alloc)) {
+    this->rehashFor(capacity);
+}
+
 template<typename TYPE, typename HASH, typename ALLOC>
 original::hashSet<TYPE, HASH, ALLOC>::hashSet(const hashSet &other) : hashSet() {
     this->operator=(other);
@@ -1279,6 +1786,62 @@ bool original::hashSet<TYPE, HASH, ALLOC>::remove(const TYPE &e) {
     return this->erase(e);
 }
 
+template<typename TYPE, typename HASH, typename ALLOC>
+void original::hashSet<TYPE, HASH, ALLOC>::unionWith(const hashSet& other) {
+    if (&other == this)
+        return;
+
+    this->rehashFor(this->size() + other.size());
+    for (hashNode* bucket : other.buckets) {
+        for (auto cur = bucket; cur; cur = cur->getPNext()) {
+            this->insert(cur->getKey(), true);
+        }
+    }
+}
+
+template<typename TYPE, typename HASH, typename ALLOC>
+void original::hashSet<TYPE, HASH, ALLOC>::intersectWith(const hashSet& other) {
+    if (&other == this)
+        return;
+
+    this->eraseIf([&other](const TYPE& e) {
+        return !other.contains(e);
+    });
+}
+
+template<typename TYPE, typename HASH, typename ALLOC>
+void original::hashSet<TYPE, HASH, ALLOC>::differenceWith(const hashSet& other) {
+    this->eraseIf([&other](const TYPE& e) {
+        return other.contains(e);
+    });
+}
+
+template<typename TYPE, typename HASH, typename ALLOC>
+void original::hashSet<TYPE, HASH, ALLOC>::reserve(const u_integer expected) {
+    this->rehashFor(expected);
+}
+
+template<typename TYPE, typename HASH, typename ALLOC>
+template<typename SOURCE>
+original::u_integer
+original::hashSet<TYPE, HASH, ALLOC>::bulkInsert(SOURCE&& source, const u_integer thread_cnt) {
+    typename hashTable<TYPE, const bool, ALLOC, HASH>::buckets_type nodes;
+    try {
+        for (auto&& e : source) {
+            // The slot exists before the node, so a failing allocation leaves nothing unowned
+            nodes.pushEnd(nullptr);
+            nodes[nodes.size() - 1] = this->createNode(e, true);
+        }
+    } catch (...) {
+        for (u_integer i = 0; i < nodes.size(); ++i) {
+            if (nodes[i])
+                this->destroyNode(nodes[i]);
+        }
+        throw;
+    }
+    return this->linkNodes(nodes, thread_cnt);
+}
+
 template<typename TYPE, typename HASH, typename ALLOC>
 original::hashSet<TYPE, HASH, ALLOC>::Iterator*
 original::hashSet<TYPE, HASH, ALLOC>::begins() const {
@@ -1389,9 +1952,14 @@ void original::treeSet<TYPE, Compare, ALLOC>::Iterator::operator-=(integer steps
 
 template <typename TYPE, typename Compare, typename ALLOC>
 original::integer
-original::treeSet<TYPE, Compare, ALLOC>::Iterator::operator-(const iterator<const TYPE>&) const
+original::treeSet<TYPE, Compare, ALLOC>::Iterator::operator-(const iterator<const TYPE>& other) const
 {
-    throw unSupportedMethodError();
+    auto other_it = dynamic_cast<const Iterator*>(&other);
+    if (other_it == nullptr)
+        return this > &other ?
+               std::numeric_limits<integer>::max() :
+               std::numeric_limits<integer>::min();
+    return RBTreeType::Iterator::operator-(*other_it);
 }
 
 template <typename TYPE, typename Compare, typename ALLOC>
@@ -1561,6 +2129,54 @@ bool original::treeSet<TYPE, Compare, ALLOC>::remove(const TYPE &e) {
     return this->erase(e);
 }
 
+template<typename TYPE, typename Compare, typename ALLOC>
+template<typename SOURCE>
+original::treeSet<TYPE, Compare, ALLOC>
+original::treeSet<TYPE, Compare, ALLOC>::fromSorted(SOURCE&& sorted, Compare comp, ALLOC alloc) {
+    treeSet set{std::move(comp), std::move(alloc)};
+    set.bulkLoad(std::forward<SOURCE>(sorted));
+    return set;
+}
+
+template<typename TYPE, typename Compare, typename ALLOC>
+template<typename SOURCE>
+original::u_integer original::treeSet<TYPE, Compare, ALLOC>::bulkLoad(SOURCE&& sorted) {
+    typename RBTreeType::nodes_type nodes;
+    for (auto&& e : sorted) {
+        nodes.pushEnd(this->createNode(e, true));
+    }
+    return this->linkSorted(nodes);
+}
+
+template <typename TYPE, typename Compare, typename ALLOC>
+original::u_integer original::treeSet<TYPE, Compare, ALLOC>::rank(const TYPE& e) const {
+    return this->rankOf(e);
+}
+
+template <typename TYPE, typename Compare, typename ALLOC>
+const TYPE& original::treeSet<TYPE, Compare, ALLOC>::select(const u_integer index) const {
+    auto node = this->selectNode(index);
+    if (!node) {
+        throw outOfBoundError();
+    }
+    return node->getKey();
+}
+
+template <typename TYPE, typename Compare, typename ALLOC>
+void original::treeSet<TYPE, Compare, ALLOC>::unionWith(const treeSet& other) {
+    this->combineWith(other, RBTreeType::setOperation::UNION);
+}
+
+template <typename TYPE, typename Compare, typename ALLOC>
+void original::treeSet<TYPE, Compare, ALLOC>::intersectWith(const treeSet& other) {
+    this->combineWith(other, RBTreeType::setOperation::INTERSECTION);
+}
+
+template <typename TYPE, typename Compare, typename ALLOC>
+void original::treeSet<TYPE, Compare, ALLOC>::differenceWith(const treeSet& other) {
+    this->combineWith(other, RBTreeType::setOperation::DIFFERENCE);
+}
+
 template <typename TYPE, typename Compare, typename ALLOC>
 original::treeSet<TYPE, Compare, ALLOC>::Iterator*
 original::treeSet<TYPE, Compare, ALLOC>::begins() const
@@ -1763,7 +2379,7 @@ original::JSet<TYPE, Compare, ALLOC>::operator=(JSet&& other) noexcept {
 
     this->listDestroy();
     this->head_ = other.head_;
-    other.head_ = other.createNode();
+    other.head_ = other.createHead();
     this->size_ = other.size_;
     other.size_ = 0;
     this->compare_ = std::move(other.compare_);
@@ -1809,6 +2425,21 @@ bool original::JSet<TYPE, Compare, ALLOC>::remove(const TYPE &e) {
     return this->erase(e);
 }
 
+template<typename TYPE, typename Compare, typename ALLOC>
+void original::JSet<TYPE, Compare, ALLOC>::unionWith(const JSet& other) {
+    this->mergeWith(other, skipListType::setOperation::UNION);
+}
+
+template<typename TYPE, typename Compare, typename ALLOC>
+void original::JSet<TYPE, Compare, ALLOC>::intersectWith(const JSet& other) {
+    this->mergeWith(other, skipListType::setOperation::INTERSECTION);
+}
+
+template<typename TYPE, typename Compare, typename ALLOC>
+void original::JSet<TYPE, Compare, ALLOC>::differenceWith(const JSet& other) {
+    this->mergeWith(other, skipListType::setOperation::DIFFERENCE);
+}
+
 template<typename TYPE, typename Compare, typename ALLOC>
 original::JSet<TYPE, Compare, ALLOC>::Iterator*
 original::JSet<TYPE, Compare, ALLOC>::begins() const {
@@ -1848,6 +2479,289 @@ std::string original::JSet<TYPE, Compare, ALLOC>::toString(bool enter) const {
 template<typename TYPE, typename Compare, typename ALLOC>
 original::JSet<TYPE, Compare, ALLOC>::~JSet() = default;
 
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator::Iterator(BTreeType* tree, leafNode* leaf, const u_integer index)
+    : BTreeType::Iterator(tree, leaf, index) {}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+bool
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator::equalPtr(
+    const iterator<const TYPE>* other) const
+{
+    auto other_it = dynamic_cast<const Iterator*>(other);
+    return other_it &&
+           this->tree_ == other_it->tree_ &&
+           this->leaf_ == other_it->leaf_ &&
+           this->index_ == other_it->index_;
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator::Iterator(const Iterator& other)
+    : Iterator(nullptr, nullptr, 0)
+{
+    this->operator=(other);
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator&
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator::operator=(const Iterator& other)
+{
+    if (this == &other) {
+        return *this;
+    }
+
+    BTreeType::Iterator::operator=(other);
+    return *this;
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator*
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator::clone() const
+{
+    return new Iterator(*this);
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+std::string original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator::className() const
+{
+    return "btreeSet::Iterator";
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+void original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator::operator+=(integer steps) const
+{
+    BTreeType::Iterator::operator+=(steps);
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+void original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator::operator-=(integer steps) const
+{
+    BTreeType::Iterator::operator-=(steps);
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::integer
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator::operator-(
+    const iterator<const TYPE>&) const
+{
+    throw unSupportedMethodError();
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+bool original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator::hasNext() const
+{
+    return BTreeType::Iterator::hasNext();
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+bool original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator::hasPrev() const
+{
+    return BTreeType::Iterator::hasPrev();
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+bool original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator::atPrev(
+    const iterator<const TYPE>* other) const
+{
+    auto other_it = dynamic_cast<const Iterator*>(other);
+    if (!other_it) {
+        return false;
+    }
+    auto next = ownerPtr(this->clone());
+    if (!next->isValid()){
+        return false;
+    }
+
+    next->next();
+    return next->equalPtr(other_it);
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+bool original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator::atNext(
+    const iterator<const TYPE>* other) const
+{
+    return other->atNext(*this);
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+void original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator::next() const
+{
+    BTreeType::Iterator::next();
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+void original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator::prev() const
+{
+    BTreeType::Iterator::prev();
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator*
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator::getPrev() const
+{
+    auto it = this->clone();
+    it->prev();
+    return it;
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+const TYPE& original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator::get()
+{
+    return BTreeType::Iterator::get().template get<0>();
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+const TYPE original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator::get() const
+{
+    return BTreeType::Iterator::get().template get<0>();
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+void original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator::set(const TYPE&)
+{
+    throw unSupportedMethodError();
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+bool original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator::isValid() const
+{
+    return BTreeType::Iterator::isValid();
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::btreeSet(Compare comp, ALLOC alloc)
+    : BTreeType(std::move(comp)),
+      set<TYPE, ALLOC>(std::move(alloc)) {}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::btreeSet(const btreeSet& other) : btreeSet() {
+    this->operator=(other);
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>&
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::operator=(const btreeSet& other) {
+    if (this == &other){
+        return *this;
+    }
+
+    this->destroyTree();
+    this->compare_ = other.compare_;
+    if constexpr(ALLOC::propagate_on_container_copy_assignment::value) {
+        this->allocator = other.allocator;
+        this->rebind_alloc_leaf_ = other.rebind_alloc_leaf_;
+        this->rebind_alloc_inner_ = other.rebind_alloc_inner_;
+    }
+    this->copyTree(other);
+    return *this;
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::btreeSet(btreeSet&& other) noexcept : btreeSet() {
+    this->operator=(std::move(other));
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>&
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::operator=(btreeSet&& other) noexcept {
+    if (this == &other){
+        return *this;
+    }
+
+    this->moveTree(other);
+    if constexpr(ALLOC::propagate_on_container_move_assignment::value) {
+        this->allocator = std::move(other.allocator);
+        this->rebind_alloc_leaf_ = std::move(other.rebind_alloc_leaf_);
+        this->rebind_alloc_inner_ = std::move(other.rebind_alloc_inner_);
+    }
+    return *this;
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+void original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::swap(btreeSet& other) noexcept
+{
+    if (this == &other)
+        return;
+
+    this->swapTree(other);
+    if constexpr (ALLOC::propagate_on_container_swap::value) {
+        std::swap(this->allocator, other.allocator);
+        std::swap(this->rebind_alloc_leaf_, other.rebind_alloc_leaf_);
+        std::swap(this->rebind_alloc_inner_, other.rebind_alloc_inner_);
+    }
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::u_integer original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::size() const {
+    return this->size_;
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+bool original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::contains(const TYPE &e) const {
+    return this->find(e);
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+bool original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::add(const TYPE &e) {
+    return this->insert(e, true);
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+bool original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::remove(const TYPE &e) {
+    return this->erase(e);
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+template<typename Callback>
+void original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::forEachInRange(
+    const TYPE& low, const TYPE& high, Callback operation) const {
+    this->scan(low, high, [&operation](const couple<const TYPE, const bool>& pair) {
+        operation(pair.template get<0>());
+    });
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator*
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::begins() const
+{
+    return new Iterator(const_cast<btreeSet*>(this), this->first_, 0);
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::Iterator*
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::ends() const
+{
+    return new Iterator(const_cast<btreeSet*>(this), this->last_,
+                        this->last_ ? this->last_->cnt_ - 1 : 0);
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+std::string original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::className() const {
+    return "btreeSet";
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+std::string original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::toString(const bool enter) const {
+    std::stringstream ss;
+    ss << this->className();
+    ss << "(";
+    bool first = true;
+    for (auto it = this->begin(); it != this->end(); it.next()){
+        if (!first){
+            ss << ", ";
+        }
+        ss << printable::formatString(it.get());
+        first = false;
+    }
+    ss << ")";
+    if (enter)
+        ss << "\n";
+    return ss.str();
+}
+
+template<typename TYPE, typename Compare, typename ALLOC, original::u_integer FANOUT>
+original::btreeSet<TYPE, Compare, ALLOC, FANOUT>::~btreeSet() = default;
+
 template <typename TYPE, typename HASH, typename ALLOC>
 void std::swap(original::hashSet<TYPE, HASH, ALLOC>& lhs, // NOLINT
                original::hashSet<TYPE, HASH, ALLOC>& rhs) noexcept
@@ -1869,4 +2783,11 @@ void std::swap(original::JSet<TYPE, COMPARE, ALLOC>& lhs, // NOLINT
     lhs.swap(rhs);
 }
 
+template <typename TYPE, typename COMPARE, typename ALLOC, original::u_integer FANOUT>
+void std::swap(original::btreeSet<TYPE, COMPARE, ALLOC, FANOUT>& lhs, // NOLINT
+    original::btreeSet<TYPE, COMPARE, ALLOC, FANOUT>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
 #endif //SETS_H
@@ -1,5 +1,8 @@
 #ifndef SKIPLIST_H
 #define SKIPLIST_H
+#include <algorithm>
+#include <bit>
+#include <memory>
 #include <random>
 #include "comparator.h"
 #include "vector.h"
@@ -13,6 +16,7 @@
  * - Multi-level linked list structure
  * - Custom comparator support
  * - STL-style allocator support
+ * - Level towers stored inline after each node, one allocation per element
  *
  * Key Features:
  * - Probabilistic balancing with O(log n) expected performance
@@ -44,30 +48,63 @@ namespace original {
             typename Compare = increaseComparator<K_TYPE>>
     class skipList {
     protected:
+        /**
+         * @brief Maximum number of levels of a node, and tower capacity of the head node
+         */
+        static constexpr u_integer MAX_LEVELS = 32;
+
         /**
          * @class skipListNode
          * @brief Internal node class for Skip List
          * @details Represents a single node in the list with:
          * - Key-value pair storage
-         * - Vector of next pointers for multiple levels
+         * - Level count and tower capacity
+         * - A tower of next pointers stored directly behind the node object
+         *
+         * The tower is a variable-length trailing array: a node and its tower are one
+         * allocation of towerUnits(capacity) nodeUnit blocks, so a level-1 node costs a
+         * single pointer of link storage and no separate heap block.
+         * Nodes must therefore be created through skipList::createNode().
          */
-        class skipListNode {
+        class alignas(void*) skipListNode {
             couple<const K_TYPE, V_TYPE> data_;  ///< Key-value pair storage
-            vector<skipListNode*> next_;         ///< Vector of next pointers for each level
+            u_integer levels_;                   ///< Number of levels in use
+            u_integer capacity_;                 ///< Number of tower slots behind the node
+
+            /**
+             * @brief Gets the first slot of the trailing tower
+             * @return Pointer to the level-1 next pointer
+             */
+            skipListNode** tower();
 
-            using rebind_alloc_pointer = ALLOC::template rebind_alloc<skipListNode*>;
+            /**
+             * @brief Gets the first slot of the trailing tower (const)
+             * @return Pointer to the level-1 next pointer
+             */
+            skipListNode* const* tower() const;
         public:
             friend class skipList;
 
             /**
-             * @brief Constructs a new skipListNode
+             * @brief Constructs a new skipListNode in storage of towerUnits(capacity) units
              * @param key Key to store
              * @param value Value to store
              * @param levels Number of levels for this node
-             * @param next Initializer list of next pointers
+             * @param capacity Number of tower slots allocated behind the node (at least levels)
+             * @details All next pointers of the tower start as nullptr.
+             */
+            explicit skipListNode(const K_TYPE& key, const V_TYPE& value,
+                                  u_integer levels, u_integer capacity);
+
+            skipListNode(const skipListNode&) = delete;              ///< Nodes are tied to their storage
+            skipListNode& operator=(const skipListNode&) = delete;   ///< Nodes are tied to their storage
+
+            /**
+             * @brief Number of nodeUnit blocks holding a node and its tower
+             * @param capacity Number of tower slots
+             * @return Units to allocate through the node allocator
              */
-            explicit skipListNode(const K_TYPE& key = K_TYPE{}, const V_TYPE& value = V_TYPE{},
-                                  u_integer levels = 1, std::initializer_list<skipListNode*> next = {});
+            static constexpr u_integer towerUnits(u_integer capacity);
 
             /**
              * @brief Gets key-value pair (non-const)
@@ -107,13 +144,15 @@ namespace original {
 
             /**
              * @brief Expands node to more levels
-             * @param new_levels New total number of levels
+             * @param new_levels New total number of levels, at most the tower capacity
+             * @throw outOfBoundError if new_levels exceeds the tower capacity
              */
             void expandLevels(u_integer new_levels);
 
             /**
              * @brief Shrinks node to fewer levels
              * @param new_levels New total number of levels
+             * @details Released levels are reset to nullptr.
              */
             void shrinkLevels(u_integer new_levels);
 
@@ -146,15 +185,29 @@ namespace original {
             static void connect(u_integer levels, skipListNode* prev, skipListNode* next);
         };
 
-        using rebind_alloc_node = ALLOC::template rebind_alloc<skipListNode>;       ///< Rebound allocator for nodes
+        /**
+         * @struct nodeUnit
+         * @brief Allocation granule of a node and its tower, one alignment step of skipListNode
+         */
+        struct alignas(skipListNode) nodeUnit {
+            byte storage[alignof(skipListNode)];
+        };
+
+        using rebind_alloc_node = ALLOC::template rebind_alloc<nodeUnit>;           ///< Rebound allocator for node storage
         using rebind_alloc_pointer = ALLOC::template rebind_alloc<skipListNode*>;  ///< Rebound allocator for pointers
 
+        /// Set algebra performed by mergeWith()
+        enum class setOperation {
+            UNION,          ///< Keep keys of either list
+            INTERSECTION,   ///< Keep keys of both lists
+            DIFFERENCE,     ///< Keep keys of this list only
+        };
+
         u_integer size_;                     ///< Number of elements
         skipListNode* head_;                 ///< Head node pointer
         Compare compare_;                     ///< Comparison function
         mutable rebind_alloc_node rebind_alloc{};  ///< Node allocator
-        mutable std::mt19937 gen_{std::random_device{}()};  ///< Random number generator
-        mutable std::uniform_real_distribution<> dis_{0.0, 1.0};  ///< Uniform distribution for level generation
+        mutable ul_integer seed_;             ///< xorshift64* state for level generation (never zero)
 
         /**
          * @class Iterator
@@ -241,17 +294,23 @@ namespace original {
          * @param key Key for new node
          * @param value Value for new node
          * @param levels Number of levels for new node
-         * @param next Initializer list of next pointers
          * @return Pointer to newly created node
-         * @details Uses allocator to construct node in place
+         * @details Allocates the node and a tower of exactly levels slots in one block
+         * and constructs the node in place
          */
         skipListNode* createNode(const K_TYPE& key = K_TYPE{}, const V_TYPE& value = V_TYPE{},
-                                 u_integer levels = 1, std::initializer_list<skipListNode*> next = {}) const;
+                                 u_integer levels = 1) const;
+
+        /**
+         * @brief Creates an empty head node
+         * @return Pointer to a level-1 head whose tower can grow up to MAX_LEVELS
+         */
+        skipListNode* createHead() const;
 
         /**
          * @brief Destroys a node and deallocates memory
          * @param node Node to destroy
-         * @details Uses allocator to destroy and deallocate node
+         * @details Uses allocator to destroy and deallocate node together with its tower
          */
         void destroyNode(skipListNode* node) const;
 
@@ -283,7 +342,10 @@ namespace original {
 
         /**
          * @brief Generates random number of levels for new node
-         * @return Random number of levels (geometric distribution)
+         * @return Random number of levels (geometric distribution with p = 1/2, at most MAX_LEVELS)
+         * @details Draws one xorshift64* word and counts its trailing zero bits: each
+         * bit is an independent coin flip, so the count is geometric without a loop
+         * or floating-point distribution.
          */
         u_integer getRandomLevels() const;
 
@@ -356,6 +418,17 @@ namespace original {
          */
         bool erase(const K_TYPE& key);
 
+        /**
+         * @brief Makes the list the union, intersection or difference with another list
+         * @param other List ordered by the same comparison
+         * @param op Operation to perform
+         * @details One linear merge over the bottom levels of both lists, O(n + m). The last
+         * kept node of every level is remembered while walking, so unlinking a node or
+         * linking a copied one in front of the walk costs O(levels) instead of a search.
+         * Keys present in both lists keep this list's nodes.
+         */
+        void mergeWith(const skipList& other, setOperation op);
+
         /**
          * @brief Destroys entire list and deallocates all nodes
          * @details Uses sequential traversal to destroy all nodes
@@ -370,18 +443,29 @@ namespace original {
     };
 }
 
+template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipListNode**
+original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipListNode::tower() {
+    return reinterpret_cast<skipListNode**>(this + 1);
+}
+
+template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipListNode* const*
+original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipListNode::tower() const {
+    return reinterpret_cast<skipListNode* const*>(this + 1);
+}
+
 template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
 original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipListNode::skipListNode(const K_TYPE& key, const V_TYPE& value,
-    u_integer levels, std::initializer_list<skipListNode*> next)
-    : data_({key, value}), next_(vector<skipListNode*>(levels, rebind_alloc_pointer{}, nullptr)) {
-    if (next.size() != 0 && static_cast<u_integer>(next.size()) != levels) {
-        throw outOfBoundError();
-    }
-    u_integer i = 0;
-    for (auto&& ptr: next) {
-        this->next_[i] = ptr;
-        i += 1;
-    }
+    const u_integer levels, const u_integer capacity)
+    : data_({key, value}), levels_(levels), capacity_(capacity) {
+    std::uninitialized_fill_n(this->tower(), capacity, nullptr);
+}
+
+template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+constexpr original::u_integer
+original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipListNode::towerUnits(const u_integer capacity) {
+    return (sizeof(skipListNode) + capacity * sizeof(skipListNode*) + sizeof(nodeUnit) - 1) / sizeof(nodeUnit);
 }
 
 template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
@@ -416,7 +500,7 @@ original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipListNode::getValue() {
 
 template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
 original::u_integer original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipListNode::getLevels() const {
-    return this->next_.size();
+    return this->levels_;
 }
 
 template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
@@ -424,10 +508,10 @@ void original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipListNode::expandLev
     if (this->getLevels() >= new_levels){
         return;
     }
-    auto increment = new_levels - this->getLevels();
-    for (u_integer i = 0; i < increment; ++i) {
-        this->next_.pushEnd(nullptr);
+    if (new_levels > this->capacity_){
+        throw outOfBoundError();
     }
+    this->levels_ = new_levels;
 }
 
 template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
@@ -435,10 +519,8 @@ void original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipListNode::shrinkLev
     if (new_levels >= this->getLevels() || new_levels == 0){
         return;
     }
-    auto decrement = this->getLevels() - new_levels;
-    for (u_integer i = 0; i < decrement; ++i) {
-        this->next_.popEnd();
-    }
+    std::fill(this->tower() + new_levels, this->tower() + this->levels_, nullptr);
+    this->levels_ = new_levels;
 }
 
 template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
@@ -449,13 +531,13 @@ void original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipListNode::setValue(
 template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
  original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipListNode*
 original::skipList<K_TYPE, V_TYPE, ALLOC,Compare>::skipListNode::getPNext(const u_integer levels) const {
-    return this->next_[levels - 1];
+    return this->tower()[levels - 1];
 }
 
 template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
 void original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipListNode::setPNext(const u_integer levels, skipListNode* next)
 {
-    this->next_[levels - 1] = next;
+    this->tower()[levels - 1] = next;
 }
 
 template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
@@ -571,17 +653,38 @@ original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::Iterator::ptrDistance(const
 
 template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
 original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipListNode*
-original::skipList<K_TYPE, V_TYPE, ALLOC,Compare>::createNode(const K_TYPE& key, const V_TYPE& value, u_integer levels,
-    std::initializer_list<skipListNode*> next) const {
-    auto node = this->rebind_alloc.allocate(1);
-    this->rebind_alloc.construct(node, key, value, levels, next);
+original::skipList<K_TYPE, V_TYPE, ALLOC,Compare>::createNode(const K_TYPE& key, const V_TYPE& value,
+                                                              const u_integer levels) const {
+    auto units = this->rebind_alloc.allocate(skipListNode::towerUnits(levels));
+    auto node = reinterpret_cast<skipListNode*>(units);
+    try {
+        this->rebind_alloc.construct(node, key, value, levels, levels);
+    } catch (...) {
+        this->rebind_alloc.deallocate(units, skipListNode::towerUnits(levels));
+        throw;
+    }
+    return node;
+}
+
+template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipListNode*
+original::skipList<K_TYPE, V_TYPE, ALLOC,Compare>::createHead() const {
+    auto units = this->rebind_alloc.allocate(skipListNode::towerUnits(MAX_LEVELS));
+    auto node = reinterpret_cast<skipListNode*>(units);
+    try {
+        this->rebind_alloc.construct(node, K_TYPE{}, V_TYPE{}, u_integer{1}, MAX_LEVELS);
+    } catch (...) {
+        this->rebind_alloc.deallocate(units, skipListNode::towerUnits(MAX_LEVELS));
+        throw;
+    }
     return node;
 }
 
 template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
 void original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::destroyNode(skipListNode* node) const {
+    const u_integer units = skipListNode::towerUnits(node->capacity_);
     this->rebind_alloc.destroy(node);
-    this->rebind_alloc.deallocate(node, 1);
+    this->rebind_alloc.deallocate(reinterpret_cast<nodeUnit*>(node), units);
 }
 
 template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
@@ -615,12 +718,12 @@ bool original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::equal(const K_TYPE& key
 template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
 original::u_integer original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::getRandomLevels() const
 {
-    constexpr floating p = 0.5;
-    u_integer levels = 1;
-    while (this->dis_(this->gen_) < p) {
-        levels += 1;
-    }
-    return levels;
+    this->seed_ ^= this->seed_ >> 12;
+    this->seed_ ^= this->seed_ << 25;
+    this->seed_ ^= this->seed_ >> 27;
+    const ul_integer word = this->seed_ * 0x2545F4914F6CDD1DULL;
+    const auto levels = 1 + static_cast<u_integer>(std::countr_zero(word));
+    return levels < MAX_LEVELS ? levels : MAX_LEVELS;
 }
 
 template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
@@ -642,10 +745,11 @@ void original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::shrinkCurLevels(u_integ
 template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
 original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipListNode*
 original::skipList<K_TYPE, V_TYPE, ALLOC,Compare>::listCopy() const {
-    auto copied_head =
-    this->createNode(this->head_->getKey(), this->head_->getValue(), this->getCurLevels());
+    auto copied_head = this->createHead();
+    copied_head->expandLevels(this->getCurLevels());
 
-    vector<skipListNode*> copied_curs{this->getCurLevels(), rebind_alloc_pointer{}, copied_head};
+    skipListNode* copied_curs[MAX_LEVELS];
+    std::fill_n(copied_curs, this->getCurLevels(), copied_head);
     auto src_cur = this->head_;
     while (src_cur->getPNext(1)){
         auto src_next = src_cur->getPNext(1);
@@ -672,7 +776,8 @@ original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::findLastNode() const {
 
 template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
 original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipList(Compare compare)
-    : size_(0), head_(this->createNode()), compare_(std::move(compare)) {}
+    : size_(0), head_(this->createHead()), compare_(std::move(compare)),
+      seed_(static_cast<ul_integer>(std::random_device{}()) << 1 | 1) {}
 
 template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
 original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipListNode*
@@ -721,7 +826,7 @@ bool original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::insert(const K_TYPE& ke
         this->expandCurLevels(new_levels);
     }
 
-    vector<skipListNode*> update(new_levels, rebind_alloc_pointer{}, nullptr);
+    skipListNode* update[MAX_LEVELS];
     skipListNode* cur = this->head_;
 
     for (u_integer i = this->getCurLevels(); i > 0; --i) {
@@ -751,27 +856,21 @@ bool original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::insert(const K_TYPE& ke
 template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
 bool original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::erase(const K_TYPE& key)
 {
-    auto cur_p = this->find(key);
-    if (!cur_p){
-        return false;
+    skipListNode* update[MAX_LEVELS];
+    skipListNode* cur = this->head_;
+    for (u_integer i = this->getCurLevels(); i > 0; --i) {
+        while (cur->getPNext(i) && this->compare_(cur->getPNext(i)->getKey(), key)) {
+            cur = cur->getPNext(i);
+        }
+        update[i - 1] = cur;
     }
 
-    auto cur_levels = cur_p->getLevels();
-    vector<skipListNode*> prev_nodes{cur_levels, rebind_alloc_pointer{}, this->head_};
-    vector<skipListNode*> next_nodes{cur_levels, rebind_alloc_pointer{}, nullptr};
-    for (u_integer i = 0; i < cur_levels; ++i) {
-        next_nodes[i] = cur_p->getPNext(i + 1);
-        while (true){
-            skipListNode* cur_node = prev_nodes[i];
-            skipListNode* next_node = cur_node->getPNext(i + 1);
-            if (!next_node || !this->highPriority(next_node, cur_p)){
-                break;
-            }
-            prev_nodes[i] = next_node;
-        }
+    auto cur_p = cur->getPNext(1);
+    if (!equal(key, cur_p)){
+        return false;
     }
-    for (u_integer i = 0; i < cur_levels; ++i) {
-        skipListNode::connect(i + 1, prev_nodes[i], next_nodes[i]);
+    for (u_integer i = 0; i < cur_p->getLevels(); ++i) {
+        skipListNode::connect(i + 1, update[i], cur_p->getPNext(i + 1));
     }
     this->destroyNode(cur_p);
 
@@ -789,6 +888,74 @@ bool original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::erase(const K_TYPE& key
     return true;
 }
 
+template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::mergeWith(const skipList& other, const setOperation op)
+{
+    if (&other == this) {
+        if (op == setOperation::DIFFERENCE) {
+            this->listDestroy();
+            this->head_ = this->createHead();
+            this->size_ = 0;
+        }
+        return;
+    }
+
+    skipListNode* update[MAX_LEVELS];
+    for (auto& last : update) {
+        last = this->head_;
+    }
+    skipListNode* cur = this->head_->getPNext(1);
+    skipListNode* theirs = other.head_->getPNext(1);
+    while (cur || (op == setOperation::UNION && theirs)) {
+        if (theirs && this->highPriority(theirs->getKey(), cur)) {
+            if (op == setOperation::UNION) {
+                const u_integer new_levels = this->getRandomLevels();
+                if (new_levels > this->getCurLevels()) {
+                    this->expandCurLevels(new_levels);
+                }
+                auto new_node = this->createNode(theirs->getKey(), theirs->getValue(), new_levels);
+                for (u_integer i = 0; i < new_levels; ++i) {
+                    skipListNode::connect(i + 1, new_node, update[i]->getPNext(i + 1));
+                    skipListNode::connect(i + 1, update[i], new_node);
+                    update[i] = new_node;
+                }
+                this->size_ += 1;
+            }
+            theirs = theirs->getPNext(1);
+            continue;
+        }
+
+        const bool shared = equal(cur->getKey(), theirs);
+        if (shared) {
+            theirs = theirs->getPNext(1);
+        }
+        auto next = cur->getPNext(1);
+        if (op == setOperation::UNION || shared == (op == setOperation::INTERSECTION)) {
+            for (u_integer i = 0; i < cur->getLevels(); ++i) {
+                update[i] = cur;
+            }
+        } else {
+            for (u_integer i = 0; i < cur->getLevels(); ++i) {
+                skipListNode::connect(i + 1, update[i], cur->getPNext(i + 1));
+            }
+            this->destroyNode(cur);
+            this->size_ -= 1;
+        }
+        cur = next;
+    }
+
+    u_integer decrement = 0;
+    for (u_integer i = this->getCurLevels(); i > 1; --i) {
+        if (this->head_->getPNext(i)){
+            break;
+        }
+        decrement += 1;
+    }
+    if (decrement > 0){
+        this->shrinkCurLevels(this->getCurLevels() - decrement);
+    }
+}
+
 template <typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
 void original::skipList<K_TYPE, V_TYPE, ALLOC, Compare>::listDestroy() noexcept
 {
@@ -2,12 +2,18 @@
 #define ORIGINAL_ASYNC_H
 
 #include "atomic.h"
-#include "condition.h"
+#include "cancellation.h"
+#include "couple.h"
 #include "optional.h"
 #include "refCntPtr.h"
 #include "thread.h"
+#include "tuple.h"
+#include "vector.h"
+#include "zeit.h"
 #include <exception>
 #include <functional>
+#include <iterator>
+#include <tuple>
 #include <utility>
 
 namespace original {
@@ -22,31 +28,84 @@ namespace original {
         // ==================== Async Wrapper (Internal) ====================
 
         /**
-         * @class asyncWrapper
-         * @brief Internal wrapper for asynchronous result storage
-         * @tparam TYPE The result type of the asynchronous computation
-         * @details Manages the state and synchronization of asynchronous results
+         * @class asyncState
+         * @brief Completion state shared by every asyncWrapper
+         * @details One atomic word tracks the state (PENDING, WAITING or READY):
+         * - ready() and waiting on a completed result are a single acquire load
+         * - A consumer that has to block first moves PENDING to WAITING, then sleeps on the
+         *   word through atomic wait (futex on Linux)
+         * - The producer stores the result, swaps in READY and only issues a wake-up if
+         *   the swapped-out state was WAITING
+         *
+         * The stored exception is written before READY is published and never changes after,
+         * so readers that observed READY access it without locking.
+         *
+         * Completion callbacks (used by whenAll/whenAny) sit on a lock-free list that
+         * publish() detaches and runs on the producer thread; a callback added after that
+         * runs at once on the adding thread.
          */
-        template<typename TYPE>
-        class asyncWrapper {
-            atomic<bool> ready_{makeAtomic(false)};  ///< Atomic flag indicating result readiness
-            strongPtr<TYPE> result_;                      ///< Storage of asynchronous computation result
-            mutable pCondition cond_{};                   ///< Condition variable for synchronization
-            mutable pMutex mutex_{};                      ///< Mutex for thread safety
-            std::exception_ptr e_{};                      ///< Exception pointer for error handling
+        class asyncState {
+            /**
+             * @struct callbackNode
+             * @brief Entry of the completion callback list
+             */
+            struct callbackNode {
+                std::function<void()> callback;  ///< Callback to run once the result is ready
+                callbackNode* next;              ///< Next entry, added before this one
+            };
+
+            static constexpr u_integer PENDING = 0;   ///< No result yet and nobody blocked
+            static constexpr u_integer WAITING = 1;   ///< No result yet and a consumer may be blocked
+            static constexpr u_integer READY = 2;     ///< Result or exception published
+
+            /// Marks a callback list that publish() has already taken
+            static inline callbackNode PUBLISHED{{}, nullptr};
+
+            mutable atomic<u_integer> state_{makeAtomic<u_integer>(PENDING)};  ///< Completion state
+            std::exception_ptr e_{};                  ///< Exception pointer for error handling
+            atomic<callbackNode*> callbacks_{makeAtomic<callbackNode*>(nullptr)};  ///< Pending callbacks
+
+            /**
+             * @brief Wakes blocked consumers without publishing anything
+             * @details Used by cancellation callbacks: moving WAITING back to PENDING makes
+             * a consumer that is about to sleep return at once, and every consumer that is
+             * still pending re-announces itself before sleeping again
+             */
+            void interrupt() const;
+
+        protected:
+            asyncState() = default;
+
+            /**
+             * @brief Publishes the result stored by the derived wrapper
+             * @details Wakes blocked consumers only if one announced itself, then runs the
+             * completion callbacks in the order they were added. An exception thrown by a
+             * callback is dropped so the remaining callbacks still run. Only the first call
+             * publishes; later calls return at once.
+             */
+            void publish();
+
+            /**
+             * @brief Destroys callbacks that never ran because no result was published
+             */
+            ~asyncState();
 
         public:
-            asyncWrapper();
+            asyncState(const asyncState&) = delete;
+            asyncState& operator=(const asyncState&) = delete;
 
             /**
-             * @brief Sets the result value and marks as ready
-             * @param v The result value to store
+             * @brief Runs a callback once the result is ready
+             * @param callback Callback to run, must not throw
+             * @details Runs on the thread that publishes the result, or immediately on the
+             * calling thread if the result is already published
              */
-            void setValue(TYPE&& v);
+            void onReady(std::function<void()> callback);
 
             /**
              * @brief Sets an exception and marks as ready
              * @param e Exception pointer to store
+             * @details Does nothing if a result or exception is already published
              */
             void setException(std::exception_ptr e);
 
@@ -66,7 +125,47 @@ namespace original {
              * @param timeout Maximum time to wait
              * @return True if result is ready within timeout, false otherwise
              */
-            bool waitFor(time::duration timeout) const;
+            bool waitFor(const time::duration& timeout) const;
+
+            /**
+             * @brief Waits for the result until a token is cancelled or its deadline passes
+             * @param token Token to observe
+             * @return True if the result is ready, false if the token was cancelled first
+             */
+            bool waitFor(const cancellationToken& token) const;
+
+            /**
+             * @brief Throws stored exception if present
+             * @pre The result is ready
+             */
+            void rethrowIfException() const;
+
+            /**
+             * @brief Gets the stored exception
+             * @return Exception pointer (nullptr if no exception or not ready yet)
+             */
+            [[nodiscard]] std::exception_ptr exception() const noexcept;
+        };
+
+        /**
+         * @class asyncWrapper
+         * @brief Internal wrapper for asynchronous result storage
+         * @tparam TYPE The result type of the asynchronous computation
+         * @details Keeps the result inline, so the shared state of a promise and its futures
+         * is a single object; synchronization is inherited from asyncState.
+         */
+        template<typename TYPE>
+        class asyncWrapper final : public asyncState {
+            alternative<TYPE> result_;                    ///< Storage of asynchronous computation result
+
+        public:
+            asyncWrapper();
+
+            /**
+             * @brief Sets the result value and marks as ready
+             * @param v The result value to store
+             */
+            void setValue(TYPE&& v);
 
             /**
              * @brief Retrieves the result value (blocks until ready)
@@ -83,21 +182,12 @@ namespace original {
             const TYPE& peek() const;
 
             /**
-             * @brief Gets a strong pointer to the result value
-             * @return Strong pointer to the result
-             */
-            strongPtr<TYPE> getPtr() const;
-
-            /**
-             * @brief Throws stored exception if present
-             */
-            void rethrowIfException() const;
-
-            /**
-             * @brief Gets the stored exception
-             * @return Exception pointer (nullptr if no exception)
+             * @brief Gets a pointer to the stored result value
+             * @return Pointer into this wrapper, nullptr if the value was moved out
+             * @throws std::exception if an exception was set
+             * @pre The result is ready
              */
-            [[nodiscard]] std::exception_ptr exception() const;
+            const TYPE* resultPtr() const;
         };
 
     public:
@@ -111,7 +201,7 @@ namespace original {
          * - `valid()`   : check if the consumer is valid
          * - `ready()`   : check if the result is ready
          * - `wait()`    : block until ready
-         * - `waitFor()` : Block with a timeout
+         * - `waitFor()` : Block with a timeout or until a cancellationToken is cancelled
          * - `exception()`: retrieve any stored exception
          */
         class futureBase {
@@ -134,6 +224,13 @@ namespace original {
              */
             [[nodiscard]] virtual bool waitFor(time::duration timeout) const = 0;
 
+            /**
+             * @brief Waits for the result until a token is cancelled
+             * @param token Token whose cancellation or deadline ends the wait
+             * @return True if result is ready, false if the token was cancelled first
+             */
+            [[nodiscard]] virtual bool waitFor(const cancellationToken& token) const = 0;
+
             /**
              * @brief Gets the stored exception if computation failed
              * @return Exception pointer (nullptr if no exception)
@@ -221,6 +318,13 @@ namespace original {
              * @return True if result is ready within timeout, false otherwise
              */
             [[nodiscard]] bool waitFor(time::duration timeout) const override;
+
+            /**
+             * @brief Waits for the result until a token is cancelled
+             * @param token Token whose cancellation or deadline ends the wait
+             * @return True if result is ready, false if the token was cancelled first
+             */
+            [[nodiscard]] bool waitFor(const cancellationToken& token) const override;
         };
 
         /**
@@ -312,6 +416,13 @@ namespace original {
              */
             [[nodiscard]] bool waitFor(time::duration timeout) const override;
 
+            /**
+             * @brief Waits for the result until a token is cancelled
+             * @param token Token whose cancellation or deadline ends the wait
+             * @return True if result is ready, false if the token was cancelled first
+             */
+            [[nodiscard]] bool waitFor(const cancellationToken& token) const override;
+
             /**
              * @brief Generates a hash value for the shared future
              * @return Hash value based on the async wrapper pointer
@@ -347,7 +458,7 @@ namespace original {
          */
         template<typename TYPE, typename Callback>
         class promise {
-            std::function<TYPE()> c_{};                ///< The computation to execute (one-time use)
+            alternative<Callback> c_{};                ///< The computation to execute (one-time use)
             strongPtr<asyncWrapper<TYPE>> awr_{};      ///< Shared pointer to the async wrapper
             bool valid_{false};                         ///< Whether the promise still holds a valid task
 
@@ -443,6 +554,192 @@ namespace original {
          */
         template <typename Callback, typename... Args>
         static auto get(Callback&& c, Args&&... args) -> future<std::invoke_result_t<std::decay_t<Callback>, std::decay_t<Args>...>>;
+
+        /**
+         * @brief Executes a callable asynchronously unless a token is cancelled first
+         * @tparam Callback The type of the callable
+         * @tparam Args The types of the arguments
+         * @param token Token checked on the new thread right before the callable runs
+         * @param c Callable to execute
+         * @param args Arguments to forward to the callable
+         * @return A future that will hold the result of the computation, or a cancelledError
+         *         if the token was cancelled before the callable started
+         * @note The callable itself may keep polling a copy of the token to stop early.
+         */
+        template <typename Callback, typename... Args>
+        static auto get(cancellationToken token, Callback&& c, Args&&... args)
+            -> future<std::invoke_result_t<std::decay_t<Callback>, std::decay_t<Args>...>>;
+
+        // ==================== Combinators ====================
+
+        /**
+         * @brief Combines futures into one that completes when all of them have completed
+         * @tparam TYPE Result type of the first future
+         * @tparam TYPES Result types of the other futures
+         * @param first First future to wait for
+         * @param rest Other futures to wait for
+         * @return A future holding a tuple of all results, in argument order
+         * @throws sysError if any of the futures is invalid
+         * @details No thread blocks: each input completes the combined future from its
+         * completion callback, and the last one to complete builds the tuple. If any input
+         * failed, the combined future holds the exception of the first failed input in
+         * argument order, once every input has completed.
+         * @note The futures are consumed. Results must not be void.
+         */
+        template<typename TYPE, typename... TYPES>
+        static future<tuple<TYPE, TYPES...>> whenAll(future<TYPE> first, future<TYPES>... rest);
+
+        /**
+         * @brief Combines a container of futures into one that completes when all have completed
+         * @tparam Container Iterable container of future<TYPE>, e.g. std::vector<future<TYPE>>
+         * @param futures Futures to wait for, moved out of the container
+         * @return future<vector<TYPE>> holding the results in container order,
+         *         or future<void> if TYPE is void
+         * @throws sysError if any of the futures is invalid
+         * @details Callback driven like the variadic form, with the same exception rule.
+         * An empty container gives an already completed future.
+         */
+        template<typename Container>
+        requires requires(Container& c) { std::begin(c); std::end(c); }
+        static auto whenAll(Container&& futures);
+
+        /**
+         * @brief Combines futures into one that completes with the first of them to complete
+         * @tparam TYPE Result type shared by all futures
+         * @tparam TYPES Result types of the other futures, all equal to TYPE
+         * @param first First future to wait for
+         * @param rest Other futures to wait for
+         * @return future<couple<u_integer, TYPE>> holding the argument index and the result of
+         *         the first future to complete, or future<u_integer> with the index if TYPE is void
+         * @throws sysError if any of the futures is invalid
+         * @details If the first future to complete failed, the combined future holds its
+         * exception. Results of the other futures are dropped when they complete.
+         * @note The futures are consumed.
+         */
+        template<typename TYPE, typename... TYPES>
+        static auto whenAny(future<TYPE> first, future<TYPES>... rest);
+
+        /**
+         * @brief Combines a container of futures into one that completes with the first to complete
+         * @tparam Container Iterable container of future<TYPE>, e.g. std::vector<future<TYPE>>
+         * @param futures Futures to wait for, moved out of the container
+         * @return Same as the variadic whenAny, with the index in container order
+         * @throws sysError if any of the futures is invalid
+         * @throws valueError if the container is empty
+         */
+        template<typename Container>
+        requires requires(Container& c) { std::begin(c); std::end(c); }
+        static auto whenAny(Container&& futures);
+
+    private:
+        /**
+         * @brief Maps future<TYPE> to TYPE
+         */
+        template<typename FUTURE>
+        struct futureValue;
+
+        template<typename TYPE>
+        struct futureValue<future<TYPE>> {
+            using type = TYPE;
+        };
+
+        /**
+         * @brief Takes the shared state out of a future
+         * @param f Future to consume
+         * @return The shared state of f
+         * @throws sysError if f is invalid
+         */
+        template<typename TYPE>
+        static strongPtr<asyncWrapper<TYPE>> stateOf(future<TYPE>& f);
+
+        /**
+         * @brief Moves the outcome of a completed input into a combinator slot
+         * @param from Completed input state
+         * @param to Slot receiving the value
+         * @param e Slot receiving the exception, including one thrown while taking the value
+         */
+        template<typename TYPE>
+        static void collect(asyncWrapper<TYPE>& from, alternative<TYPE>& to, std::exception_ptr& e);
+
+        /**
+         * @brief Publishes a value or an exception to a combined future
+         * @param out Shared state of the combined future
+         * @param make Builds the value, only called if e is null
+         * @param e Exception to publish instead of the value
+         */
+        template<typename TYPE, typename Make>
+        static void complete(asyncWrapper<TYPE>& out, Make&& make, const std::exception_ptr& e);
+
+        /**
+         * @brief Counts down the inputs of a combinator that still have to complete
+         * @param remaining Number of pending inputs
+         * @return True for the call that completed the last input
+         */
+        static bool arrive(atomic<u_integer>& remaining);
+
+        /**
+         * @class combinatorState
+         * @brief State shared by the input callbacks of a combinator
+         * @details Every copy owns one reference on an atomic counter, and the copy that drops
+         * the last one deletes the state. Inputs complete, and so drop their callbacks, on
+         * any thread at once, which strongPtr does not support.
+         */
+        template<typename STATE>
+        class combinatorState {
+            /**
+             * @struct block
+             * @brief The state and its reference count in one allocation
+             */
+            struct block {
+                STATE state;                 ///< Shared state
+                atomic<u_integer> refs;      ///< Number of combinatorState copies
+
+                template<typename... ARGS>
+                explicit block(ARGS&&... args);
+            };
+
+            block* block_;  ///< Shared block, nullptr once moved from
+
+            explicit combinatorState(block* b) noexcept;
+
+        public:
+            /**
+             * @brief Allocates a state with a single reference
+             * @param args Arguments forwarded to the constructor of STATE
+             */
+            template<typename... ARGS>
+            static combinatorState make(ARGS&&... args);
+
+            combinatorState(const combinatorState& other) noexcept;
+
+            combinatorState(combinatorState&& other) noexcept;
+
+            combinatorState& operator=(const combinatorState&) = delete;
+
+            STATE* operator->() const noexcept;
+
+            STATE& operator*() const noexcept;
+
+            ~combinatorState();
+        };
+
+        /**
+         * @brief Variadic whenAll with the argument indexes as a pack
+         */
+        template<typename... TYPES, u_integer... IDX>
+        static future<tuple<TYPES...>> whenAllOf(indexSequence<IDX...>, future<TYPES>... futures);
+
+        /**
+         * @brief whenAll over the shared states of the inputs
+         */
+        template<typename TYPE>
+        static auto whenAllOf(const vector<strongPtr<asyncWrapper<TYPE>>>& states);
+
+        /**
+         * @brief whenAny over the shared states of the inputs
+         */
+        template<typename TYPE>
+        static auto whenAnyOf(const vector<strongPtr<asyncWrapper<TYPE>>>& states);
     };
 
     /**
@@ -553,13 +850,7 @@ namespace original {
      * @brief Specialization of asyncWrapper for void results
      */
     template <>
-    class async::asyncWrapper<void> {
-        atomic<bool> ready_{makeAtomic(false)};  ///< Atomic flag indicating completion
-        alternative<void> result_;                    ///< Mark of asynchronous computation status
-        mutable pCondition cond_{};                   ///< Condition variable for synchronization
-        mutable pMutex mutex_{};                      ///< Mutex for thread safety
-        std::exception_ptr e_{};                      ///< Exception pointer for error handling
-
+    class async::asyncWrapper<void> final : public asyncState {
     public:
         asyncWrapper() = default;
 
@@ -568,53 +859,17 @@ namespace original {
          */
         void setValue();
 
-        /**
-         * @brief Sets an exception and marks as completed
-         * @param e Exception pointer to store
-         */
-        void setException(std::exception_ptr e);
-
-        /**
-         * @brief Checks if the computation is completed
-         * @return True if completed (successfully or with exception)
-         */
-        [[nodiscard]] bool ready() const;
-
-        /**
-         * @brief Waits until the computation completes
-         */
-        void wait() const;
-
-        /**
-         * @brief Waits for the result with a timeout
-         * @param timeout Maximum time to wait
-         * @return True if result is ready within timeout, false otherwise
-         */
-        bool waitFor(const time::duration& timeout) const;
-
         /**
          * @brief Waits for completion and checks for exceptions
          * @throws std::exception if the computation threw an exception
          */
-        void get();
+        void get() const;
 
         /**
          * @brief Checks for completion and exceptions without consuming the result
          * @throws std::exception if the computation threw an exception
          */
         void peek() const;
-
-        /**
-         * @brief Throws stored exception if present
-         * @throws std::exception if the computation threw an exception
-         */
-        void rethrowIfException() const;
-
-        /**
-         * @brief Gets the stored exception
-         * @return Exception pointer (nullptr if no exception)
-         */
-        [[nodiscard]] std::exception_ptr exception() const noexcept;
     };
 
     /**
@@ -679,6 +934,13 @@ namespace original {
          * @return True if result is ready within timeout, false otherwise
          */
         [[nodiscard]] bool waitFor(time::duration timeout) const override;
+
+        /**
+         * @brief Waits for the result until a token is cancelled
+         * @param token Token whose cancellation or deadline ends the wait
+         * @return True if result is ready, false if the token was cancelled first
+         */
+        [[nodiscard]] bool waitFor(const cancellationToken& token) const override;
     };
 
     template <>
@@ -747,6 +1009,13 @@ namespace original {
          */
         [[nodiscard]] bool waitFor(time::duration timeout) const override;
 
+        /**
+         * @brief Waits for the result until a token is cancelled
+         * @param token Token whose cancellation or deadline ends the wait
+         * @return True if result is ready, false if the token was cancelled first
+         */
+        [[nodiscard]] bool waitFor(const cancellationToken& token) const override;
+
         /**
          * @brief Generates a hash value for the shared future
          * @return Hash value based on the async wrapper pointer
@@ -770,7 +1039,7 @@ namespace original {
      */
     template <typename Callback>
     class async::promise<void, Callback> {
-        std::function<void()> c_{};                  ///< The computation to execute (one-time use)
+        alternative<Callback> c_{};                  ///< The computation to execute (one-time use)
         strongPtr<asyncWrapper<void>> awr_{};        ///< Shared pointer to the async wrapper
         bool valid_{false};                           ///< Whether the promise still holds a valid task
 
@@ -823,65 +1092,175 @@ namespace original {
     };
 } // namespace original
 
-template <typename TYPE>
-original::async::asyncWrapper<TYPE>::asyncWrapper() = default;
+inline void original::async::asyncState::publish()
+{
+    const u_integer previous = this->state_.exchange(READY, memOrder::ACQ_REL);
+    if (previous == READY) {
+        return;
+    }
+    if (previous == WAITING) {
+        this->state_.notifyAll();
+    }
+    callbackNode* node = this->callbacks_.exchange(&PUBLISHED, memOrder::ACQ_REL);
+    if (node == &PUBLISHED) {
+        return;
+    }
+    callbackNode* ordered = nullptr;
+    while (node) {
+        callbackNode* next = node->next;
+        node->next = ordered;
+        ordered = node;
+        node = next;
+    }
+    while (ordered) {
+        callbackNode* next = ordered->next;
+        try {
+            ordered->callback();
+        } catch (...) {
+            // The result is out already, so there is nobody left to report to
+        }
+        delete ordered;
+        ordered = next;
+    }
+}
 
-template <typename TYPE>
-void original::async::asyncWrapper<TYPE>::setValue(TYPE&& v)
+inline original::async::asyncState::~asyncState()
 {
-    {
-        uniqueLock lock{this->mutex_};
-        this->result_ = makeStrongPtr<TYPE>(std::move(v));
-        this->ready_.store(true);
+    callbackNode* node = this->callbacks_.load(memOrder::ACQUIRE);
+    if (node == &PUBLISHED) {
+        return;
+    }
+    while (node) {
+        callbackNode* next = node->next;
+        delete node;
+        node = next;
     }
-    this->cond_.notifyAll();
 }
 
-template <typename TYPE>
-void original::async::asyncWrapper<TYPE>::setException(std::exception_ptr e)
+inline void original::async::asyncState::onReady(std::function<void()> callback)
 {
-    {
-        uniqueLock lock{this->mutex_};
-        this->e_ = std::move(e);
-        this->ready_.store(true);
+    auto node = new callbackNode{std::move(callback), this->callbacks_.load(memOrder::ACQUIRE)};
+    while (node->next != &PUBLISHED) {
+        if (this->callbacks_.exchangeCmp(node->next, node)) {
+            return;
+        }
     }
-    this->cond_.notifyAll();
+    const auto published = std::move(node->callback);
+    delete node;
+    published();
 }
 
-template <typename TYPE>
-bool original::async::asyncWrapper<TYPE>::ready() const
+inline void original::async::asyncState::setException(std::exception_ptr e)
 {
-    return *this->ready_;
+    if (this->ready()) {
+        return;
+    }
+    this->e_ = std::move(e);
+    this->publish();
 }
 
-template <typename TYPE>
-void original::async::asyncWrapper<TYPE>::wait() const
+inline bool original::async::asyncState::ready() const
 {
-    uniqueLock lock{this->mutex_};
-    this->cond_.wait(this->mutex_, [this]
-    {
-        return this->ready();
-    });
+    return this->state_.load(memOrder::ACQUIRE) == READY;
+}
+
+inline void original::async::asyncState::wait() const
+{
+    u_integer state = this->state_.load(memOrder::ACQUIRE);
+    while (state != READY) {
+        if (state == PENDING && !this->state_.exchangeCmp(state, WAITING, memOrder::ACQUIRE)) {
+            continue;
+        }
+        this->state_.wait(WAITING, memOrder::ACQUIRE);
+        state = this->state_.load(memOrder::ACQUIRE);
+    }
 }
 
+inline bool original::async::asyncState::waitFor(const time::duration& timeout) const
+{
+    const auto deadline = time::point::now() + timeout;
+    u_integer state = this->state_.load(memOrder::ACQUIRE);
+    while (state != READY) {
+        if (state == PENDING && !this->state_.exchangeCmp(state, WAITING, memOrder::ACQUIRE)) {
+            continue;
+        }
+        const auto remaining = deadline - time::point::now();
+        if (remaining <= time::duration::ZERO) {
+            return false;
+        }
+        this->state_.waitFor(WAITING, remaining, memOrder::ACQUIRE);
+        state = this->state_.load(memOrder::ACQUIRE);
+    }
+    return true;
+}
+
+inline bool original::async::asyncState::waitFor(const cancellationToken& token) const
+{
+    if (this->ready()) {
+        return true;
+    }
+    const auto deadline = token.deadline();
+    const auto wake = token.onCancel([this] { this->interrupt(); });
+    u_integer state = this->state_.load(memOrder::ACQUIRE);
+    while (state != READY) {
+        if (state == PENDING && !this->state_.exchangeCmp(state, WAITING, memOrder::ACQUIRE)) {
+            continue;
+        }
+        // Checked after announcing WAITING: a cancellation from here on finds WAITING and
+        // interrupts the wait below
+        if (token.cancelled()) {
+            return false;
+        }
+        if (deadline) {
+            const auto remaining = *deadline - time::point::now();
+            if (remaining > time::duration::ZERO) {
+                this->state_.waitFor(WAITING, remaining, memOrder::ACQUIRE);
+            }
+        } else {
+            this->state_.wait(WAITING, memOrder::ACQUIRE);
+        }
+        state = this->state_.load(memOrder::ACQUIRE);
+    }
+    return true;
+}
+
+inline void original::async::asyncState::interrupt() const
+{
+    u_integer expected = WAITING;
+    if (this->state_.exchangeCmp(expected, PENDING, memOrder::ACQUIRE)) {
+        this->state_.notifyAll();
+    }
+}
+
+inline void original::async::asyncState::rethrowIfException() const
+{
+    if (this->e_)
+        std::rethrow_exception(this->e_);
+}
+
+inline std::exception_ptr
+original::async::asyncState::exception() const noexcept
+{
+    if (!this->ready()) {
+        return {};
+    }
+    return this->e_;
+}
+
+template <typename TYPE>
+original::async::asyncWrapper<TYPE>::asyncWrapper() = default;
+
 template <typename TYPE>
-bool original::async::asyncWrapper<TYPE>::waitFor(time::duration timeout) const
+void original::async::asyncWrapper<TYPE>::setValue(TYPE&& v)
 {
-    uniqueLock lock{this->mutex_};
-    return this->cond_.waitFor(this->mutex_, timeout, [this]
-    {
-        return this->ready();
-    });
+    this->result_.emplace(std::move(v));
+    this->publish();
 }
 
 template <typename TYPE>
 TYPE original::async::asyncWrapper<TYPE>::get()
 {
-    uniqueLock lock{this->mutex_};
-    this->cond_.wait(this->mutex_, [this]{
-        return this->ready();
-    });
-
+    this->wait();
     this->rethrowIfException();
 
     TYPE result = std::move(*this->result_);
@@ -892,35 +1271,16 @@ TYPE original::async::asyncWrapper<TYPE>::get()
 template <typename TYPE>
 const TYPE& original::async::asyncWrapper<TYPE>::peek() const
 {
-    uniqueLock lock{this->mutex_};
-    this->cond_.wait(this->mutex_, [this]{
-        return this->ready();
-    });
-
+    this->wait();
     this->rethrowIfException();
     return *this->result_;
 }
 
 template <typename TYPE>
-original::strongPtr<TYPE> original::async::asyncWrapper<TYPE>::getPtr() const
+const TYPE* original::async::asyncWrapper<TYPE>::resultPtr() const
 {
     this->rethrowIfException();
-    return this->result_;
-}
-
-template <typename TYPE>
-void original::async::asyncWrapper<TYPE>::rethrowIfException() const
-{
-    if (this->e_)
-        std::rethrow_exception(this->e_);
-}
-
-template <typename TYPE>
-std::exception_ptr
-original::async::asyncWrapper<TYPE>::exception() const
-{
-    uniqueLock lock{this->mutex_};
-    return this->e_;
+    return this->result_.get();
 }
 
 template <typename TYPE>
@@ -985,6 +1345,15 @@ bool original::async::future<TYPE>::waitFor(time::duration timeout) const
     return this->awr_->waitFor(timeout);
 }
 
+template <typename TYPE>
+bool original::async::future<TYPE>::waitFor(const cancellationToken& token) const
+{
+    if (!this->valid()) {
+        throw sysError("Access an invalid future");
+    }
+    return this->awr_->waitFor(token);
+}
+
 template <typename TYPE>
 original::async::sharedFuture<TYPE>::sharedFuture(strongPtr<asyncWrapper<TYPE>> awr)
     : awr_(std::move(awr)) {}
@@ -1013,7 +1382,7 @@ original::strongPtr<const TYPE> original::async::sharedFuture<TYPE>::strongPoint
     if (!this->ready()) {
         throw sysError("Cannot get a strongPtr from a sharedFuture that is not ready");
     }
-    return this->awr_->getPtr().template constCastTo<const TYPE>();
+    return this->awr_.aliasTo(this->awr_->resultPtr());
 }
 
 template <typename TYPE>
@@ -1064,6 +1433,15 @@ bool original::async::sharedFuture<TYPE>::waitFor(time::duration timeout) const
     return this->awr_->waitFor(timeout);
 }
 
+template <typename TYPE>
+bool original::async::sharedFuture<TYPE>::waitFor(const cancellationToken& token) const
+{
+    if (!this->valid()) {
+        throw sysError("Access an invalid sharedFuture");
+    }
+    return this->awr_->waitFor(token);
+}
+
 template <typename TYPE>
 original::u_integer original::async::sharedFuture<TYPE>::toHash() const noexcept
 {
@@ -1083,7 +1461,8 @@ original::async::promise<TYPE, Callback>::promise(promise&& other) noexcept
         return;
     }
     this->valid_ = true;
-    this->c_ = std::move(other.c_);
+    this->c_.emplace(std::move(*other.c_));
+    other.c_.reset();
     this->awr_ = std::move(other.awr_);
     other.valid_ = false;
 }
@@ -1096,7 +1475,8 @@ original::async::promise<TYPE, Callback>::operator=(promise&& other) noexcept
         return *this;
     }
     this->valid_ = true;
-    this->c_ = std::move(other.c_);
+    this->c_.emplace(std::move(*other.c_));
+    other.c_.reset();
     this->awr_ = std::move(other.awr_);
     other.valid_ = false;
     return *this;
@@ -1126,7 +1506,9 @@ std::function<TYPE()> original::async::promise<TYPE, Callback>::function()
         throw sysError("Try to get an invalid task");
     }
     this->valid_ = false;
-    return std::move(this->c_);
+    std::function<TYPE()> f{std::move(*this->c_)};
+    this->c_.reset();
+    return f;
 }
 
 template <typename TYPE, typename Callback>
@@ -1136,10 +1518,11 @@ void original::async::promise<TYPE, Callback>::run()
         throw sysError("Try to run an invalid task");
     }
     try {
-        this->awr_->setValue(this->c_());
+        this->awr_->setValue((*this->c_)());
     } catch (...) {
         this->awr_->setException(std::current_exception());
     }
+    this->c_.reset();
     this->valid_ = false;
 }
 
@@ -1161,10 +1544,9 @@ auto original::async::get(Callback&& c, Args&&... args)
     auto p = makePromise(std::forward<Callback>(c), std::forward<Args>(args)...);
     auto fut = p.getFuture();
 
-    auto p_shared = makeStrongPtr<decltype(p)>(std::move(p));
     thread t{
-        [p_shared]() mutable {
-            p_shared->run();
+        [p = std::move(p)]() mutable {
+            p.run();
         },
         thread::AUTO_DETACH
     };
@@ -1172,6 +1554,273 @@ auto original::async::get(Callback&& c, Args&&... args)
     return fut;
 }
 
+template <typename Callback, typename... Args>
+auto original::async::get(cancellationToken token, Callback&& c, Args&&... args)
+    -> future<std::invoke_result_t<std::decay_t<Callback>, std::decay_t<Args>...>>
+{
+    return get([token = std::move(token), c = std::forward<Callback>(c)](auto&&... params) mutable {
+        token.throwIfCancelled();
+        return std::invoke(c, std::forward<decltype(params)>(params)...);
+    }, std::forward<Args>(args)...);
+}
+
+template <typename TYPE>
+original::strongPtr<original::async::asyncWrapper<TYPE>>
+original::async::stateOf(future<TYPE>& f)
+{
+    if (!f.valid()) {
+        throw sysError("Access an invalid future");
+    }
+    return std::move(f.awr_);
+}
+
+template <typename TYPE>
+void original::async::collect(asyncWrapper<TYPE>& from, alternative<TYPE>& to, std::exception_ptr& e)
+{
+    if (auto failure = from.exception()) {
+        e = std::move(failure);
+        return;
+    }
+    try {
+        to.emplace(from.get());
+    } catch (...) {
+        e = std::current_exception();
+    }
+}
+
+template <typename TYPE, typename Make>
+void original::async::complete(asyncWrapper<TYPE>& out, Make&& make, const std::exception_ptr& e)
+{
+    if (e) {
+        out.setException(e);
+        return;
+    }
+    try {
+        if constexpr (std::is_void_v<TYPE>) {
+            make();
+            out.setValue();
+        } else {
+            out.setValue(make());
+        }
+    } catch (...) {
+        out.setException(std::current_exception());
+    }
+}
+
+inline bool original::async::arrive(atomic<u_integer>& remaining)
+{
+    u_integer left = remaining.load(memOrder::ACQUIRE);
+    while (!remaining.exchangeCmp(left, left - 1)) {}
+    return left == 1;
+}
+
+template <typename STATE>
+template <typename... ARGS>
+original::async::combinatorState<STATE>::block::block(ARGS&&... args)
+    : state(std::forward<ARGS>(args)...), refs(makeAtomic<u_integer>(1)) {}
+
+template <typename STATE>
+original::async::combinatorState<STATE>::combinatorState(block* b) noexcept
+    : block_(b) {}
+
+template <typename STATE>
+template <typename... ARGS>
+auto original::async::combinatorState<STATE>::make(ARGS&&... args) -> combinatorState
+{
+    return combinatorState{new block(std::forward<ARGS>(args)...)};
+}
+
+template <typename STATE>
+original::async::combinatorState<STATE>::combinatorState(const combinatorState& other) noexcept
+    : block_(other.block_)
+{
+    this->block_->refs += 1;
+}
+
+template <typename STATE>
+original::async::combinatorState<STATE>::combinatorState(combinatorState&& other) noexcept
+    : block_(other.block_)
+{
+    other.block_ = nullptr;
+}
+
+template <typename STATE>
+STATE* original::async::combinatorState<STATE>::operator->() const noexcept
+{
+    return &this->block_->state;
+}
+
+template <typename STATE>
+STATE& original::async::combinatorState<STATE>::operator*() const noexcept
+{
+    return this->block_->state;
+}
+
+template <typename STATE>
+original::async::combinatorState<STATE>::~combinatorState()
+{
+    if (this->block_ && arrive(this->block_->refs)) {
+        delete this->block_;
+    }
+}
+
+template <typename TYPE, typename... TYPES>
+auto original::async::whenAll(future<TYPE> first, future<TYPES>... rest) -> future<tuple<TYPE, TYPES...>>
+{
+    return whenAllOf(makeSequence<sizeof...(TYPES) + 1>(), std::move(first), std::move(rest)...);
+}
+
+template <typename... TYPES, original::u_integer... IDX>
+auto original::async::whenAllOf(indexSequence<IDX...>, future<TYPES>... futures) -> future<tuple<TYPES...>>
+{
+    static_assert((!std::is_void_v<TYPES> && ...), "Use the container form of whenAll for void futures");
+    struct allState {
+        std::tuple<alternative<TYPES>...> values;
+        std::exception_ptr errors[sizeof...(TYPES)];
+        atomic<u_integer> remaining{makeAtomic<u_integer>(sizeof...(TYPES))};
+        strongPtr<asyncWrapper<tuple<TYPES...>>> out{makeStrongPtr<asyncWrapper<tuple<TYPES...>>>()};
+    };
+
+    std::tuple<strongPtr<asyncWrapper<TYPES>>...> states{stateOf(futures)...};
+    auto all = combinatorState<allState>::make();
+    future<tuple<TYPES...>> combined{all->out};
+    auto finish = [](allState& done) {
+        std::exception_ptr e;
+        for (u_integer i = 0; i < sizeof...(TYPES) && !e; ++i) {
+            e = done.errors[i];
+        }
+        complete(*done.out, [&done] {
+            return tuple<TYPES...>{std::move(*std::get<IDX>(done.values))...};
+        }, e);
+    };
+    (std::get<IDX>(states)->onReady([all, finish, input = std::get<IDX>(states).get()] mutable {
+        collect(*input, std::get<IDX>(all->values), all->errors[IDX]);
+        if (arrive(all->remaining)) {
+            finish(*all);
+        }
+    }), ...);
+    return combined;
+}
+
+template <typename Container>
+requires requires(Container& c) { std::begin(c); std::end(c); }
+auto original::async::whenAll(Container&& futures)
+{
+    using TYPE = futureValue<std::remove_cvref_t<decltype(*std::begin(futures))>>::type;
+    vector<strongPtr<asyncWrapper<TYPE>>> states;
+    for (auto& f : futures) {
+        states.pushEnd(stateOf(f));
+    }
+    return whenAllOf(states);
+}
+
+template <typename TYPE>
+auto original::async::whenAllOf(const vector<strongPtr<asyncWrapper<TYPE>>>& states)
+{
+    using RESULT = std::conditional_t<std::is_void_v<TYPE>, void, vector<TYPE>>;
+    using SLOT = std::conditional_t<std::is_void_v<TYPE>, none, alternative<TYPE>>;
+    struct allState {
+        array<SLOT> values;
+        array<std::exception_ptr> errors;
+        atomic<u_integer> remaining;
+        strongPtr<asyncWrapper<RESULT>> out{makeStrongPtr<asyncWrapper<RESULT>>()};
+
+        explicit allState(const u_integer count)
+            : values(std::is_void_v<TYPE> ? 0 : count), errors(count),
+              remaining(makeAtomic<u_integer>(count)) {}
+    };
+
+    const u_integer count = states.size();
+    auto all = combinatorState<allState>::make(count);
+    future<RESULT> combined{all->out};
+    auto finish = [](allState& done) {
+        std::exception_ptr e;
+        for (u_integer i = 0; i < done.errors.size() && !e; ++i) {
+            e = done.errors[i];
+        }
+        complete(*done.out, [&done] {
+            if constexpr (!std::is_void_v<TYPE>) {
+                vector<TYPE> results;
+                for (u_integer i = 0; i < done.values.size(); ++i) {
+                    results.pushEnd(std::move(*done.values[i]));
+                }
+                return results;
+            }
+        }, e);
+    };
+    if (count == 0) {
+        finish(*all);
+        return combined;
+    }
+    for (u_integer i = 0; i < count; ++i) {
+        states[i]->onReady([all, finish, i, input = states[i].get()] mutable {
+            if constexpr (std::is_void_v<TYPE>) {
+                all->errors[i] = input->exception();
+            } else {
+                collect(*input, all->values[i], all->errors[i]);
+            }
+            if (arrive(all->remaining)) {
+                finish(*all);
+            }
+        });
+    }
+    return combined;
+}
+
+template <typename TYPE, typename... TYPES>
+auto original::async::whenAny(future<TYPE> first, future<TYPES>... rest)
+{
+    static_assert((std::is_same_v<TYPE, TYPES> && ...), "whenAny needs futures of one result type");
+    vector<strongPtr<asyncWrapper<TYPE>>> states;
+    states.pushEnd(stateOf(first));
+    (states.pushEnd(stateOf(rest)), ...);
+    return whenAnyOf(states);
+}
+
+template <typename Container>
+requires requires(Container& c) { std::begin(c); std::end(c); }
+auto original::async::whenAny(Container&& futures)
+{
+    using TYPE = futureValue<std::remove_cvref_t<decltype(*std::begin(futures))>>::type;
+    vector<strongPtr<asyncWrapper<TYPE>>> states;
+    for (auto& f : futures) {
+        states.pushEnd(stateOf(f));
+    }
+    if (states.empty()) {
+        throw valueError("whenAny needs at least one future");
+    }
+    return whenAnyOf(states);
+}
+
+template <typename TYPE>
+auto original::async::whenAnyOf(const vector<strongPtr<asyncWrapper<TYPE>>>& states)
+{
+    using RESULT = std::conditional_t<std::is_void_v<TYPE>, u_integer, couple<u_integer, TYPE>>;
+    struct anyState {
+        atomic<bool> decided{makeAtomic(false)};
+        strongPtr<asyncWrapper<RESULT>> out{makeStrongPtr<asyncWrapper<RESULT>>()};
+    };
+
+    auto any = combinatorState<anyState>::make();
+    future<RESULT> combined{any->out};
+    for (u_integer i = 0; i < states.size(); ++i) {
+        states[i]->onReady([any, i, input = states[i].get()] mutable {
+            bool expected = false;
+            if (!any->decided.exchangeCmp(expected, true)) {
+                return;
+            }
+            complete(*any->out, [i, input] {
+                if constexpr (std::is_void_v<TYPE>) {
+                    return i;
+                } else {
+                    return couple<u_integer, TYPE>{u_integer{i}, input->get()};
+                }
+            }, input->exception());
+        });
+    }
+    return combined;
+}
+
 template <typename T, typename Callback>
 auto original::operator|(async::future<T> f, Callback&& c)
 {
@@ -1241,81 +1890,20 @@ auto original::operator|(async::promise<void, Callback1> p, Callback2&& c)
 
 inline void original::async::asyncWrapper<void>::setValue()
 {
-    {
-        uniqueLock lock{this->mutex_};
-        this->result_.set();
-        this->ready_.store(true);
-    }
-    this->cond_.notifyAll();
-}
-
-inline void original::async::asyncWrapper<void>::setException(std::exception_ptr e)
-{
-    {
-        uniqueLock lock{this->mutex_};
-        this->e_ = std::move(e);
-        this->ready_.store(true);
-    }
-    this->cond_.notifyAll();
-}
-
-inline bool original::async::asyncWrapper<void>::ready() const
-{
-    return *this->ready_;
+    this->publish();
 }
 
-inline void original::async::asyncWrapper<void>::wait() const
+inline void original::async::asyncWrapper<void>::get() const
 {
-    uniqueLock lock{this->mutex_};
-    this->cond_.wait(this->mutex_, [this]
-    {
-        return this->ready();
-    });
-}
-
-inline bool original::async::asyncWrapper<void>::waitFor(const time::duration& timeout) const
-{
-    uniqueLock lock{this->mutex_};
-    return this->cond_.waitFor(this->mutex_, timeout, [this]
-    {
-       return this->ready();
-    });
-}
-
-inline void original::async::asyncWrapper<void>::get()
-{
-    uniqueLock lock{this->mutex_};
-    this->cond_.wait(this->mutex_, [this] {
-        return this->ready();
-    });
-
-    this->rethrowIfException();
-    this->result_.reset();
+    this->peek();
 }
 
 inline void original::async::asyncWrapper<void>::peek() const
 {
-    uniqueLock lock{this->mutex_};
-    this->cond_.wait(this->mutex_, [this] {
-        return this->ready();
-    });
-
+    this->wait();
     this->rethrowIfException();
 }
 
-inline void original::async::asyncWrapper<void>::rethrowIfException() const
-{
-    if (this->e_)
-        std::rethrow_exception(this->e_);
-}
-
-inline std::exception_ptr
-original::async::asyncWrapper<void>::exception() const noexcept
-{
-    uniqueLock lock{this->mutex_};
-    return this->e_;
-}
-
 inline original::async::future<void>::future(strongPtr<asyncWrapper<void>> awr)
     : awr_(std::move(awr)) {}
 
@@ -1369,6 +1957,14 @@ inline bool original::async::future<void>::waitFor(const time::duration timeout)
     return this->awr_->waitFor(timeout);
 }
 
+inline bool original::async::future<void>::waitFor(const cancellationToken& token) const
+{
+    if (!this->valid()) {
+        throw sysError("Access an invalid future");
+    }
+    return this->awr_->waitFor(token);
+}
+
 inline original::async::sharedFuture<void>::sharedFuture(strongPtr<asyncWrapper<void>> awr)
     : awr_(std::move(awr)) {}
 
@@ -1428,6 +2024,14 @@ inline bool original::async::sharedFuture<void>::waitFor(const time::duration ti
     return this->awr_->waitFor(timeout);
 }
 
+inline bool original::async::sharedFuture<void>::waitFor(const cancellationToken& token) const
+{
+    if (!this->valid()) {
+        throw sysError("Access an invalid sharedFuture");
+    }
+    return this->awr_->waitFor(token);
+}
+
 inline original::u_integer original::async::sharedFuture<void>::toHash() const noexcept
 {
     return this->awr_.toHash();
@@ -1445,7 +2049,8 @@ original::async::promise<void, Callback>::promise(promise&& other) noexcept
         return;
     }
     this->valid_ = true;
-    this->c_ = std::move(other.c_);
+    this->c_.emplace(std::move(*other.c_));
+    other.c_.reset();
     this->awr_ = std::move(other.awr_);
     other.valid_ = false;
 }
@@ -1457,7 +2062,8 @@ original::async::promise<void, Callback>& original::async::promise<void, Callbac
         return *this;
     }
     this->valid_ = true;
-    this->c_ = std::move(other.c_);
+    this->c_.emplace(std::move(*other.c_));
+    other.c_.reset();
     this->awr_ = std::move(other.awr_);
     other.valid_ = false;
     return *this;
@@ -1486,7 +2092,9 @@ std::function<void()> original::async::promise<void, Callback>::function()
         throw sysError("Try to get an invalid task");
     }
     this->valid_ = false;
-    return std::move(this->c_);
+    std::function<void()> f{std::move(*this->c_)};
+    this->c_.reset();
+    return f;
 }
 
 template <typename Callback>
@@ -1496,11 +2104,12 @@ void original::async::promise<void, Callback>::run()
         throw sysError("Try to run an invalid task");
     }
     try {
-        this->c_();
+        (*this->c_)();
         this->awr_->setValue();
     } catch (...) {
         this->awr_->setException(std::current_exception());
     }
+    this->c_.reset();
     this->valid_ = false;
 }
 
@@ -2,10 +2,20 @@
 #define ORIGINAL_ATOMIC_H
 
 #include <type_traits>
+#include <climits>
 #include <cstring>
 #include "optional.h"
 #include "config.h"
 #include "mutex.h"
+#include "zeit.h"
+
+#if ORIGINAL_PLATFORM_LINUX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <sched.h>
+#endif
 
 namespace original {
 #if ORIGINAL_COMPILER_GCC || ORIGINAL_COMPILER_CLANG
@@ -159,6 +169,37 @@ namespace original {
          */
         bool exchangeCmp(TYPE& expected, TYPE desired, memOrder order = SEQ_CST) noexcept;
 
+        /**
+         * @brief Blocks while the stored value equals old
+         * @param old Value to wait on
+         * @param order Memory ordering of the reloads (default: SEQ_CST)
+         * @details Sleeps in the kernel through futex on Linux, so the writer must call
+         *          notifyOne() or notifyAll() after changing the value; other platforms poll
+         *          with sched_yield. May also return spuriously, callers re-check the value.
+         * @note Only available for 4-byte types, the width futex operates on
+         */
+        void wait(TYPE old, memOrder order = SEQ_CST) const noexcept;
+
+        /**
+         * @brief Blocks while the stored value equals old, at most for timeout
+         * @param old Value to wait on
+         * @param timeout Maximum time to wait
+         * @param order Memory ordering of the reloads (default: SEQ_CST)
+         * @return True if the value was seen to differ from old, false on timeout
+         * @note Only available for 4-byte types, see wait()
+         */
+        bool waitFor(TYPE old, const time::duration& timeout, memOrder order = SEQ_CST) const noexcept;
+
+        /**
+         * @brief Wakes one thread blocked in wait() or waitFor()
+         */
+        void notifyOne() noexcept;
+
+        /**
+         * @brief Wakes every thread blocked in wait() or waitFor()
+         */
+        void notifyAll() noexcept;
+
         /// @brief Default destructor
         ~atomicImpl() = default;
 
@@ -386,6 +427,69 @@ bool original::atomicImpl<TYPE, false>::exchangeCmp(TYPE& expected, TYPE desired
                      static_cast<integer>(order), static_cast<integer>(order));
 }
 
+template <typename TYPE>
+void original::atomicImpl<TYPE, false>::wait(TYPE old, memOrder order) const noexcept
+{
+    static_assert(sizeof(TYPE) == sizeof(u_integer), "atomic wait needs a 4-byte type");
+    while (true) {
+        const TYPE current = this->load(order);
+        if (std::memcmp(&current, &old, sizeof(TYPE)) != 0) {
+            return;
+        }
+#if ORIGINAL_PLATFORM_LINUX
+        u_integer expected;
+        std::memcpy(&expected, &old, sizeof(TYPE));
+        syscall(SYS_futex, reinterpret_cast<const u_integer*>(this->data_), FUTEX_WAIT_PRIVATE,
+                expected, nullptr, nullptr, 0);
+#else
+        sched_yield();
+#endif
+    }
+}
+
+template <typename TYPE>
+bool original::atomicImpl<TYPE, false>::waitFor(TYPE old, const time::duration& timeout, memOrder order) const noexcept
+{
+    static_assert(sizeof(TYPE) == sizeof(u_integer), "atomic wait needs a 4-byte type");
+    const auto deadline = time::point::now() + timeout;
+    while (true) {
+        const TYPE current = this->load(order);
+        if (std::memcmp(&current, &old, sizeof(TYPE)) != 0) {
+            return true;
+        }
+        const auto remaining = deadline - time::point::now();
+        if (remaining <= time::duration::ZERO) {
+            return false;
+        }
+#if ORIGINAL_PLATFORM_LINUX
+        u_integer expected;
+        std::memcpy(&expected, &old, sizeof(TYPE));
+        const timespec ts = remaining.toTimespec();
+        syscall(SYS_futex, reinterpret_cast<const u_integer*>(this->data_), FUTEX_WAIT_PRIVATE,
+                expected, &ts, nullptr, 0);
+#else
+        sched_yield();
+#endif
+    }
+}
+
+template <typename TYPE>
+void original::atomicImpl<TYPE, false>::notifyOne() noexcept
+{
+#if ORIGINAL_PLATFORM_LINUX
+    syscall(SYS_futex, reinterpret_cast<u_integer*>(this->data_), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
+}
+
+template <typename TYPE>
+void original::atomicImpl<TYPE, false>::notifyAll() noexcept
+{
+#if ORIGINAL_PLATFORM_LINUX
+    syscall(SYS_futex, reinterpret_cast<u_integer*>(this->data_), FUTEX_WAKE_PRIVATE,
+            INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
 template <typename TYPE>
 original::atomicImpl<TYPE, true>::atomicImpl(TYPE value, memOrder) {
     uniqueLock lock{this->mutex_};
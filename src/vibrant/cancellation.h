@@ -0,0 +1,507 @@
+#ifndef ORIGINAL_CANCELLATION_H
+#define ORIGINAL_CANCELLATION_H
+
+#include "atomic.h"
+#include "condition.h"
+#include "error.h"
+#include "mutex.h"
+#include "optional.h"
+#include "refCntPtr.h"
+#include "zeit.h"
+#include <functional>
+
+
+/**
+ * @file cancellation.h
+ * @brief Cooperative cancellation with optional deadlines
+ * @details A cancellationSource owns the decision to cancel; the cancellationTokens it hands
+ * out let the work observe it:
+ * - Poll cancelled() or call throwIfCancelled() at convenient points of a long computation
+ * - Register a callback with onCancel() to interrupt something that cannot poll
+ * - Give the source a deadline, and the token reports cancellation once it has passed
+ * - Derive a child source from a token: it is cancelled with its parent, and its deadline
+ *   is never later than the parent's
+ *
+ * Tokens are accepted by async::get, taskDelegator::submit, the futures' waitFor and the
+ * generator adaptor cancellable().
+ *
+ * @note Cancellation is cooperative: nothing is stopped forcibly, the work itself decides
+ * where to check its token.
+ */
+
+namespace original {
+    class cancellationState;
+    class cancellationToken;
+    class cancellationSource;
+
+    /**
+     * @class cancellationRegistration
+     * @brief Handle of a callback registered with cancellationToken::onCancel
+     * @details Destroying (or reset()ting) the handle unregisters the callback. Once that
+     * returns, the callback is neither running nor going to run, so it may safely capture
+     * objects that die together with the handle. The callback itself may destroy its own
+     * handle; that returns at once and the callback runs to its end.
+     * @note Move-only. A default constructed handle registers nothing.
+     */
+    class cancellationRegistration {
+        friend class cancellationToken;
+
+        /**
+         * @struct callbackNode
+         * @brief Entry of the callback list of a cancellationState
+         */
+        struct callbackNode {
+            std::function<void()> callback;  ///< Callback to run on cancellation
+            callbackNode* prev;              ///< Previous entry, registered earlier
+            callbackNode* next;              ///< Next entry, registered later
+        };
+
+        strongPtr<cancellationState> state_;  ///< State the callback is registered with
+        callbackNode* node_;                  ///< Registered entry, nullptr if none
+
+        /**
+         * @brief Takes ownership of a registered entry
+         * @param state State the entry is linked into
+         * @param node The linked entry
+         */
+        cancellationRegistration(strongPtr<cancellationState> state, callbackNode* node);
+
+        friend class cancellationState;
+    public:
+        /**
+         * @brief Constructs a handle that registers nothing
+         */
+        cancellationRegistration();
+
+        cancellationRegistration(const cancellationRegistration&) = delete;
+        cancellationRegistration& operator=(const cancellationRegistration&) = delete;
+
+        /**
+         * @brief Move constructor
+         * @param other Handle to take the registration from
+         */
+        cancellationRegistration(cancellationRegistration&& other) noexcept;
+
+        /**
+         * @brief Move assignment, unregistering the callback held so far
+         * @param other Handle to take the registration from
+         * @return Reference to this handle
+         */
+        cancellationRegistration& operator=(cancellationRegistration&& other) noexcept;
+
+        /**
+         * @brief Unregisters the callback, waiting for it if it is running right now
+         */
+        void reset();
+
+        /**
+         * @brief Unregisters the callback
+         */
+        ~cancellationRegistration();
+    };
+
+    /**
+     * @class cancellationState
+     * @brief State shared by a cancellationSource, its copies and its tokens
+     * @details The cancelled flag is an atomic, so polling costs one acquire load (plus a clock
+     * read when a deadline is set). Callbacks are kept in a doubly linked list guarded by a
+     * pMutex. cancel() takes them off the list one at a time and runs each with the mutex
+     * released, recording which one is running. A registration unlinked from another thread
+     * waits for its running callback; one unlinked by the callback itself returns at once.
+     * @note Internal to cancellation.h, only reachable through the classes above and below.
+     */
+    class cancellationState {
+        friend class cancellationRegistration;
+        friend class cancellationToken;
+        friend class cancellationSource;
+
+        using callbackNode = cancellationRegistration::callbackNode;
+
+        atomic<bool> cancelled_{makeAtomic(false)};  ///< Set once by the first cancel()
+        const bool has_deadline_;                    ///< Whether deadline_ applies
+        const time::point deadline_;                 ///< Cancellation time, if has_deadline_
+        pMutex mutex_;                               ///< Guards the fields below
+        pCondition finished_;                        ///< Signalled after each callback
+        bool fired_;                                 ///< Callbacks have been run or are running
+        callbackNode* head_;                         ///< Earliest callback not yet run
+        callbackNode* tail_;                         ///< Latest callback not yet run
+        const callbackNode* running_;                ///< Callback running right now, if any
+        pthread_t runner_;                           ///< Thread running the callbacks
+        cancellationRegistration parent_;            ///< Link to the parent state, if any
+
+        /**
+         * @brief Cancels and runs the registered callbacks, once
+         */
+        void cancel();
+
+        /**
+         * @brief Checks the flag, cancelling first if the deadline has passed
+         * @return True if cancelled
+         */
+        bool cancelled();
+
+        /**
+         * @brief Links a callback, or runs it at once if callbacks already ran
+         * @param self Strong pointer to this state, kept by the registration
+         * @param callback Callback to register
+         * @return Registration handle, empty if the callback already ran
+         */
+        static cancellationRegistration link(const strongPtr<cancellationState>& self,
+                                             std::function<void()> callback);
+
+        /**
+         * @brief Unlinks a callback so it does not run
+         * @param node Entry to unlink
+         * @details If cancel() has already taken the entry and is running it on another
+         * thread, waits for it to return.
+         */
+        void unlink(callbackNode* node);
+
+    public:
+        /**
+         * @brief Constructs a not yet cancelled state
+         * @param has_deadline Whether deadline applies
+         * @param deadline Point in time from which the state counts as cancelled
+         */
+        cancellationState(bool has_deadline, const time::point& deadline);
+
+        cancellationState(const cancellationState&) = delete;
+        cancellationState& operator=(const cancellationState&) = delete;
+    };
+
+    /**
+     * @class cancellationToken
+     * @brief Observer side of a cancellationSource
+     * @details Cheap to copy; every copy observes the same source. A default constructed
+     * token belongs to no source and is never cancelled.
+     */
+    class cancellationToken {
+        friend class cancellationSource;
+
+        strongPtr<cancellationState> state_;  ///< Observed state, null for a detached token
+
+        /**
+         * @brief Constructs a token observing a state
+         * @param state State of the issuing source
+         */
+        explicit cancellationToken(strongPtr<cancellationState> state);
+
+    public:
+        /**
+         * @brief Constructs a token that is never cancelled
+         */
+        cancellationToken() = default;
+
+        /**
+         * @brief Checks whether the source was cancelled or its deadline has passed
+         * @return True if the work should stop
+         */
+        [[nodiscard]] bool cancelled() const;
+
+        /**
+         * @brief Cancellation point for code that reports failure by exception
+         * @throws cancelledError if cancelled() is true
+         */
+        void throwIfCancelled() const;
+
+        /**
+         * @brief Gets the deadline of the source
+         * @return The deadline, or an empty alternative if there is none
+         */
+        [[nodiscard]] alternative<time::point> deadline() const;
+
+        /**
+         * @brief Registers a callback to run on cancellation
+         * @param callback Callback to run, must not throw
+         * @return Handle that unregisters the callback when destroyed
+         * @details The callback runs on the thread that cancels, or at once on the calling
+         * thread if the token is already cancelled. A deadline only triggers callbacks when
+         * some check (cancelled(), throwIfCancelled() or a waitFor) notices it has passed.
+         * @note A callback may register or unregister callbacks of the same source, its own
+         * included.
+         */
+        [[nodiscard]] cancellationRegistration onCancel(std::function<void()> callback) const;
+    };
+
+    /**
+     * @class cancellationSource
+     * @brief Owner side of a cancellation: issues tokens and cancels them
+     * @details Copies share the same state, so any copy can cancel. Destroying the sources
+     * does not cancel the tokens.
+     */
+    class cancellationSource {
+        strongPtr<cancellationState> state_;  ///< Shared state
+
+        /**
+         * @brief Builds a source with an optional deadline, linked to an optional parent
+         * @param parent Parent token, detached for a root source
+         * @param has_deadline Whether deadline applies
+         * @param deadline Deadline of this source
+         */
+        cancellationSource(const cancellationToken& parent, bool has_deadline, const time::point& deadline);
+
+    public:
+        /**
+         * @brief Constructs a source without a deadline
+         */
+        cancellationSource();
+
+        /**
+         * @brief Constructs a source that cancels itself at a point in time
+         * @param deadline Point in time from which tokens report cancellation
+         */
+        explicit cancellationSource(const time::point& deadline);
+
+        /**
+         * @brief Constructs a source that cancels itself after a timeout
+         * @param timeout Time from now after which tokens report cancellation
+         */
+        explicit cancellationSource(const time::duration& timeout);
+
+        /**
+         * @brief Constructs a child source, cancelled together with its parent
+         * @param parent Token of the parent; its deadline is inherited
+         */
+        explicit cancellationSource(const cancellationToken& parent);
+
+        /**
+         * @brief Constructs a child source with its own deadline
+         * @param parent Token of the parent
+         * @param deadline Deadline of the child; the parent's applies if it is earlier
+         */
+        cancellationSource(const cancellationToken& parent, const time::point& deadline);
+
+        /**
+         * @brief Requests cancellation and runs the registered callbacks
+         * @details Only the first call has an effect; it also cancels every child source.
+         */
+        void cancel();
+
+        /**
+         * @brief Checks whether the source was cancelled or its deadline has passed
+         * @return True if cancelled
+         */
+        [[nodiscard]] bool cancelled() const;
+
+        /**
+         * @brief Gets a token observing this source
+         * @return A new token
+         */
+        [[nodiscard]] cancellationToken token() const;
+    };
+}
+
+inline original::cancellationRegistration::cancellationRegistration(strongPtr<cancellationState> state,
+                                                                    callbackNode* node)
+    : state_(std::move(state)), node_(node) {}
+
+inline original::cancellationRegistration::cancellationRegistration() : node_(nullptr) {}
+
+inline original::cancellationRegistration::cancellationRegistration(cancellationRegistration&& other) noexcept
+    : state_(std::move(other.state_)), node_(other.node_)
+{
+    other.node_ = nullptr;
+}
+
+inline original::cancellationRegistration&
+original::cancellationRegistration::operator=(cancellationRegistration&& other) noexcept
+{
+    if (this == &other) {
+        return *this;
+    }
+    this->reset();
+    this->state_ = std::move(other.state_);
+    this->node_ = other.node_;
+    other.node_ = nullptr;
+    return *this;
+}
+
+inline void original::cancellationRegistration::reset()
+{
+    if (!this->node_) {
+        return;
+    }
+    this->state_->unlink(this->node_);
+    delete this->node_;
+    this->node_ = nullptr;
+    this->state_ = strongPtr<cancellationState>{};
+}
+
+inline original::cancellationRegistration::~cancellationRegistration()
+{
+    this->reset();
+}
+
+inline original::cancellationState::cancellationState(const bool has_deadline, const time::point& deadline)
+    : has_deadline_(has_deadline), deadline_(deadline), fired_(false), head_(nullptr), tail_(nullptr),
+      running_(nullptr), runner_() {}
+
+inline void original::cancellationState::cancel()
+{
+    bool expected = false;
+    if (!this->cancelled_.exchangeCmp(expected, true)) {
+        return;
+    }
+    uniqueLock lock{this->mutex_};
+    this->fired_ = true;
+    this->runner_ = pthread_self();
+    while (callbackNode* node = this->head_) {
+        this->head_ = node->next;
+        if (this->head_) {
+            this->head_->prev = nullptr;
+        } else {
+            this->tail_ = nullptr;
+        }
+        node->next = nullptr;
+        // Moved out, so the callback may unregister itself and free its node while running
+        const std::function<void()> callback = std::move(node->callback);
+        this->running_ = node;
+        lock.unlock();
+        callback();
+        lock.lock();
+        this->running_ = nullptr;
+        this->finished_.notifyAll();
+    }
+}
+
+inline bool original::cancellationState::cancelled()
+{
+    if (this->cancelled_.load(memOrder::ACQUIRE)) {
+        return true;
+    }
+    if (this->has_deadline_ && time::point::now() >= this->deadline_) {
+        this->cancel();
+        return true;
+    }
+    return false;
+}
+
+inline original::cancellationRegistration
+original::cancellationState::link(const strongPtr<cancellationState>& self, std::function<void()> callback)
+{
+    cancellationState& state = const_cast<cancellationState&>(*self);
+    if (!state.cancelled()) {
+        auto node = new callbackNode{std::move(callback), nullptr, nullptr};
+        {
+            uniqueLock lock{state.mutex_};
+            if (!state.fired_) {
+                node->prev = state.tail_;
+                if (state.tail_) {
+                    state.tail_->next = node;
+                } else {
+                    state.head_ = node;
+                }
+                state.tail_ = node;
+                return cancellationRegistration{self, node};
+            }
+        }
+        callback = std::move(node->callback);
+        delete node;
+    }
+    callback();
+    return cancellationRegistration{};
+}
+
+inline void original::cancellationState::unlink(callbackNode* node)
+{
+    uniqueLock lock{this->mutex_};
+    if (!node->prev && this->head_ != node) {
+        // Already taken by cancel(); a callback unregistering itself must not wait for itself
+        while (this->running_ == node && !pthread_equal(this->runner_, pthread_self())) {
+            this->finished_.wait(this->mutex_);
+        }
+        return;
+    }
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        this->head_ = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        this->tail_ = node->prev;
+    }
+}
+
+inline original::cancellationToken::cancellationToken(strongPtr<cancellationState> state)
+    : state_(std::move(state)) {}
+
+inline bool original::cancellationToken::cancelled() const
+{
+    if (!this->state_) {
+        return false;
+    }
+    return const_cast<cancellationState&>(*this->state_).cancelled();
+}
+
+inline void original::cancellationToken::throwIfCancelled() const
+{
+    if (this->cancelled()) {
+        throw cancelledError();
+    }
+}
+
+inline original::alternative<original::time::point> original::cancellationToken::deadline() const
+{
+    if (!this->state_ || !this->state_->has_deadline_) {
+        return alternative<time::point>{};
+    }
+    return alternative<time::point>{this->state_->deadline_};
+}
+
+inline original::cancellationRegistration
+original::cancellationToken::onCancel(std::function<void()> callback) const
+{
+    if (!this->state_) {
+        return cancellationRegistration{};
+    }
+    return cancellationState::link(this->state_, std::move(callback));
+}
+
+inline original::cancellationSource::cancellationSource(const cancellationToken& parent,
+                                                        bool has_deadline, const time::point& deadline)
+{
+    time::point effective = deadline;
+    if (const auto inherited = parent.deadline()) {
+        if (!has_deadline || *inherited < effective) {
+            effective = *inherited;
+        }
+        has_deadline = true;
+    }
+    this->state_ = makeStrongPtr<cancellationState>(has_deadline, effective);
+    cancellationState* child = this->state_.get();
+    child->parent_ = parent.onCancel([child] { child->cancel(); });
+}
+
+inline original::cancellationSource::cancellationSource()
+    : cancellationSource(cancellationToken{}, false, time::point{}) {}
+
+inline original::cancellationSource::cancellationSource(const time::point& deadline)
+    : cancellationSource(cancellationToken{}, true, deadline) {}
+
+inline original::cancellationSource::cancellationSource(const time::duration& timeout)
+    : cancellationSource(cancellationToken{}, true, time::point::now() + timeout) {}
+
+inline original::cancellationSource::cancellationSource(const cancellationToken& parent)
+    : cancellationSource(parent, false, time::point{}) {}
+
+inline original::cancellationSource::cancellationSource(const cancellationToken& parent, const time::point& deadline)
+    : cancellationSource(parent, true, deadline) {}
+
+inline void original::cancellationSource::cancel()
+{
+    this->state_->cancel();
+}
+
+inline bool original::cancellationSource::cancelled() const
+{
+    return const_cast<cancellationState&>(*this->state_).cancelled();
+}
+
+inline original::cancellationToken original::cancellationSource::token() const
+{
+    return cancellationToken{this->state_};
+}
+
+#endif //ORIGINAL_CANCELLATION_H
@@ -0,0 +1,341 @@
+#ifndef ORIGINAL_CHANNEL_H
+#define ORIGINAL_CHANNEL_H
+
+#include "chain.h"
+#include "condition.h"
+#include "config.h"
+#include "coroutines.h"
+#include "mutex.h"
+#include "optional.h"
+#include "zeit.h"
+
+
+/**
+ * @file channel.h
+ * @brief Blocking multi-producer/multi-consumer message channel
+ * @details Packages the queue + pMutex + pCondition + closed flag pattern:
+ * - Bounded channels make senders wait while the buffer is full; unbounded channels never do
+ * - Receivers wait while the buffer is empty, with or without a timeout
+ * - receiveBatch drains up to N messages under one lock acquisition, so a consumer that
+ *   keeps up with its producers pays one lock round-trip per batch instead of per message;
+ *   when it takes everything pending, the whole buffer chain changes hands in O(1)
+ * - Closing wakes everyone; pending messages are still delivered, new ones are refused
+ *
+ * @see spscRing.h and mpmcQueue.h for lock-free bounded queues that never block the caller
+ */
+
+namespace original {
+
+    /**
+     * @class channel
+     * @tparam TYPE Message type (must be copyable, like the elements of chain)
+     * @brief FIFO channel with blocking send/receive and close semantics
+     * @details Pending messages are kept in a chain (pushEnd/popBegin are O(1), and a chain
+     * is moved without touching its elements), and all state is guarded by one pMutex.
+     * Waiting senders and receivers are counted, so a send or receive only signals a
+     * condition variable when someone is actually waiting on it.
+     *
+     * Close semantics:
+     * - close() is idempotent and may be called from any thread
+     * - send on a closed channel returns false and drops nothing that was sent before
+     * - receive keeps returning messages until the buffer is drained, then returns an empty
+     *   alternative (receiveBatch an empty chain)
+     *
+     * @note Not copyable or movable; threads share it by reference.
+     */
+    template<typename TYPE>
+    class channel final {
+        chain<TYPE> buffer_;                    ///< Pending messages, oldest first
+        u_integer capacity_;                    ///< Maximum pending messages, UNBOUNDED for none
+        bool closed_;                           ///< Set by close()
+        u_integer senders_waiting_;             ///< Senders blocked on not_full_
+        u_integer receivers_waiting_;           ///< Receivers blocked on not_empty_
+        mutable pMutex mutex_;                  ///< Guards all fields above
+        pCondition not_full_;                   ///< Signalled when space frees up or on close
+        pCondition not_empty_;                  ///< Signalled when a message arrives or on close
+
+        /**
+         * @brief Checks whether a bounded channel has no room left
+         * @return True if a send would have to wait
+         * @pre mutex_ is held
+         */
+        [[nodiscard]] bool full() const;
+
+        /**
+         * @brief Removes up to max messages and wakes senders for the freed slots
+         * @param out Empty chain receiving the messages
+         * @param max Maximum number of messages to move
+         * @note If max covers every pending message, out takes over the buffer itself
+         * @pre mutex_ is held
+         */
+        void take(chain<TYPE>& out, u_integer max);
+
+        /**
+         * @brief Removes the front message and wakes a sender waiting for its slot
+         * @return The front message
+         * @pre mutex_ is held and the buffer is not empty
+         */
+        TYPE take();
+
+    public:
+        /**
+         * @brief Capacity value for a channel whose senders never wait
+         */
+        static constexpr u_integer UNBOUNDED = 0;
+
+        /**
+         * @brief Constructs an open, empty channel
+         * @param capacity Maximum number of pending messages, or UNBOUNDED
+         */
+        explicit channel(u_integer capacity = UNBOUNDED);
+
+        channel(const channel&) = delete;               ///< Disable copy constructor
+        channel& operator=(const channel&) = delete;    ///< Disable copy assignment
+
+        /**
+         * @brief Sends a message, waiting for room in a bounded channel
+         * @param message Message to send
+         * @return True if the message was queued, false if the channel is (or got) closed
+         */
+        bool send(const TYPE& message);
+
+        /**
+         * @brief Sends a message only if that needs no waiting
+         * @param message Message to send
+         * @return True if the message was queued, false if the channel is full or closed
+         */
+        bool trySend(const TYPE& message);
+
+        /**
+         * @brief Receives the oldest message, waiting until there is one
+         * @return The message, or an empty alternative once the channel is closed and drained
+         */
+        alternative<TYPE> receive();
+
+        /**
+         * @brief Receives the oldest message if one is pending
+         * @return The message, or an empty alternative if none is pending
+         */
+        alternative<TYPE> tryReceive();
+
+        /**
+         * @brief Receives the oldest message, waiting at most timeout for one
+         * @param timeout Maximum time to wait
+         * @return The message, or an empty alternative on timeout or once closed and drained
+         */
+        alternative<TYPE> receiveFor(const time::duration& timeout);
+
+        /**
+         * @brief Receives up to max messages with a single lock acquisition
+         * @param max Maximum number of messages to return
+         * @return The oldest pending messages in order; waits until there is at least one,
+         *         and is empty only once the channel is closed and drained (or max is 0)
+         */
+        chain<TYPE> receiveBatch(u_integer max);
+
+        /**
+         * @brief Closes the channel and wakes every waiting sender and receiver
+         */
+        void close();
+
+        /**
+         * @brief Checks whether the channel has been closed
+         * @return True after close()
+         */
+        [[nodiscard]] bool closed() const;
+
+        /**
+         * @brief Number of pending messages
+         * @return Buffer size at the time of the call
+         */
+        [[nodiscard]] u_integer size() const;
+
+        /**
+         * @brief Checks whether no message is pending
+         * @return True if the buffer is empty
+         */
+        [[nodiscard]] bool empty() const;
+
+        /**
+         * @brief Maximum number of pending messages
+         * @return Capacity given at construction, UNBOUNDED for none
+         */
+        [[nodiscard]] u_integer capacity() const;
+
+        /**
+         * @brief Generator that receives messages until the channel is closed and drained
+         * @param batch Maximum messages fetched per lock acquisition (0 is taken as 1)
+         * @return Generator over the received messages
+         * @note Up to batch - 1 fetched messages wait inside the generator for the consumer,
+         *       where other receivers cannot take them. Use batch = 1 to share a channel
+         *       fairly between several generator consumers.
+         */
+        coroutine::generator<TYPE> elements(u_integer batch = 64);
+    };
+}
+
+template<typename TYPE>
+bool original::channel<TYPE>::full() const {
+    return this->capacity_ != UNBOUNDED && this->buffer_.size() >= this->capacity_;
+}
+
+template<typename TYPE>
+void original::channel<TYPE>::take(chain<TYPE>& out, const u_integer max) {
+    u_integer taken = 0;
+    if (max >= this->buffer_.size()) {
+        taken = this->buffer_.size();
+        out = std::move(this->buffer_);
+    } else {
+        while (taken < max) {
+            out.pushEnd(this->buffer_.popBegin());
+            ++taken;
+        }
+    }
+    if (this->senders_waiting_ > 0) {
+        this->not_full_.notifySome(taken);
+    }
+}
+
+template<typename TYPE>
+TYPE original::channel<TYPE>::take() {
+    TYPE message = this->buffer_.popBegin();
+    if (this->senders_waiting_ > 0) {
+        this->not_full_.notify();
+    }
+    return message;
+}
+
+template<typename TYPE>
+original::channel<TYPE>::channel(const u_integer capacity)
+    : capacity_(capacity), closed_(false), senders_waiting_(0), receivers_waiting_(0) {}
+
+template<typename TYPE>
+bool original::channel<TYPE>::send(const TYPE& message) {
+    uniqueLock lock{this->mutex_};
+    if (this->full() && !this->closed_) {
+        ++this->senders_waiting_;
+        this->not_full_.wait(this->mutex_, [this] { return this->closed_ || !this->full(); });
+        --this->senders_waiting_;
+    }
+    if (this->closed_) {
+        return false;
+    }
+    this->buffer_.pushEnd(message);
+    if (this->receivers_waiting_ > 0) {
+        this->not_empty_.notify();
+    }
+    return true;
+}
+
+template<typename TYPE>
+bool original::channel<TYPE>::trySend(const TYPE& message) {
+    uniqueLock lock{this->mutex_};
+    if (this->closed_ || this->full()) {
+        return false;
+    }
+    this->buffer_.pushEnd(message);
+    if (this->receivers_waiting_ > 0) {
+        this->not_empty_.notify();
+    }
+    return true;
+}
+
+template<typename TYPE>
+original::alternative<TYPE> original::channel<TYPE>::receive() {
+    uniqueLock lock{this->mutex_};
+    if (this->buffer_.empty() && !this->closed_) {
+        ++this->receivers_waiting_;
+        this->not_empty_.wait(this->mutex_, [this] { return this->closed_ || !this->buffer_.empty(); });
+        --this->receivers_waiting_;
+    }
+    if (this->buffer_.empty()) {
+        return alternative<TYPE>{};
+    }
+    return alternative<TYPE>{this->take()};
+}
+
+template<typename TYPE>
+original::alternative<TYPE> original::channel<TYPE>::tryReceive() {
+    uniqueLock lock{this->mutex_};
+    if (this->buffer_.empty()) {
+        return alternative<TYPE>{};
+    }
+    return alternative<TYPE>{this->take()};
+}
+
+template<typename TYPE>
+original::alternative<TYPE> original::channel<TYPE>::receiveFor(const time::duration& timeout) {
+    uniqueLock lock{this->mutex_};
+    if (this->buffer_.empty() && !this->closed_) {
+        ++this->receivers_waiting_;
+        this->not_empty_.waitFor(this->mutex_, timeout,
+                                 [this] { return this->closed_ || !this->buffer_.empty(); });
+        --this->receivers_waiting_;
+    }
+    if (this->buffer_.empty()) {
+        return alternative<TYPE>{};
+    }
+    return alternative<TYPE>{this->take()};
+}
+
+template<typename TYPE>
+original::chain<TYPE> original::channel<TYPE>::receiveBatch(const u_integer max) {
+    chain<TYPE> batch;
+    if (max == 0) {
+        return batch;
+    }
+    uniqueLock lock{this->mutex_};
+    if (this->buffer_.empty() && !this->closed_) {
+        ++this->receivers_waiting_;
+        this->not_empty_.wait(this->mutex_, [this] { return this->closed_ || !this->buffer_.empty(); });
+        --this->receivers_waiting_;
+    }
+    this->take(batch, max);
+    return batch;
+}
+
+template<typename TYPE>
+void original::channel<TYPE>::close() {
+    uniqueLock lock{this->mutex_};
+    this->closed_ = true;
+    this->not_full_.notifyAll();
+    this->not_empty_.notifyAll();
+}
+
+template<typename TYPE>
+bool original::channel<TYPE>::closed() const {
+    uniqueLock lock{this->mutex_};
+    return this->closed_;
+}
+
+template<typename TYPE>
+original::u_integer original::channel<TYPE>::size() const {
+    uniqueLock lock{this->mutex_};
+    return this->buffer_.size();
+}
+
+template<typename TYPE>
+bool original::channel<TYPE>::empty() const {
+    return this->size() == 0;
+}
+
+template<typename TYPE>
+original::u_integer original::channel<TYPE>::capacity() const {
+    return this->capacity_;
+}
+
+template<typename TYPE>
+original::coroutine::generator<TYPE> original::channel<TYPE>::elements(const u_integer batch) {
+    const u_integer fetch = batch == 0 ? 1 : batch;
+    while (true) {
+        auto messages = this->receiveBatch(fetch);
+        if (messages.empty()) {
+            co_return;
+        }
+        for (auto& message : messages) {
+            co_yield message;
+        }
+    }
+}
+
+#endif //ORIGINAL_CHANNEL_H
@@ -0,0 +1,1314 @@
+#ifndef ORIGINAL_CONCURRENT_MAPS_H
+#define ORIGINAL_CONCURRENT_MAPS_H
+
+#include "allocator.h"
+#include "atomic.h"
+#include "container.h"
+#include "couple.h"
+#include "epochReclaimer.h"
+#include "hash.h"
+#include "hashTable.h"
+#include "lockFreeSkipList.h"
+#include "mutex.h"
+#include <bit>
+#include <type_traits>
+
+
+/**
+ * @file concurrentMaps.h
+ * @brief Map containers that are safe for concurrent use from many threads
+ * @details Provides thread-safe counterparts of the containers in maps.h:
+ * 1. concurrentHashMap - Lock-striped hash table (unordered, shards with independent read-write locks)
+ * 2. lockFreeHashMap - Split-ordered list hash table (unordered, lock-free, epoch-based reclamation)
+ * 3. concurrentJMap - Lock-free skip list (ordered, lock-free, epoch-based reclamation)
+ *
+ * Unlike the maps in maps.h, these containers never hand out references into their storage:
+ * every accessor returns values by copy. Where in-place modification is supported, compound
+ * read-modify-write steps are offered as single atomic operations (computeIfAbsent, update
+ * with a callback) instead.
+ *
+ * Performance Characteristics:
+ * | Container         | Insertion | Lookup   | Deletion | Ordered | Readers block each other | size()      |
+ * |-------------------|-----------|----------|----------|---------|--------------------------|-------------|
+ * | concurrentHashMap | O(1) avg  | O(1)     | O(1)     | No      | No                       | O(shards)   |
+ * | lockFreeHashMap   | O(1) avg  | O(1)     | O(1)     | No      | No (no locks at all)     | O(1)        |
+ * | concurrentJMap    | O(log n)  | O(log n) | O(log n) | Yes     | No (no locks at all)     | O(1)        |
+ *
+ * Usage Guidelines:
+ * - Use concurrentHashMap when values must be updated in place or computed atomically
+ * - Use lockFreeHashMap for read-dominated, insert-heavy tables where a preempted thread
+ *   must never hold up others (tail latency)
+ * - Use concurrentJMap when keys must also be visited in order, e.g. time-ordered indexes
+ *
+ * @see maps.h For the single-threaded map containers
+ * @see mutex.h For pRWMutex used by the shards
+ * @see epochReclaimer.h For the memory reclamation used by lockFreeHashMap and concurrentJMap
+ * @see lockFreeSkipList.h For the skip list behind concurrentJMap
+ */
+
+namespace original {
+
+    /**
+     * @class concurrentHashMap
+     * @tparam K_TYPE Key type (must be hashable)
+     * @tparam V_TYPE Value type (must be copyable)
+     * @tparam HASH Hash function type (default: hash<K_TYPE>)
+     * @tparam ALLOC Allocator type (default: allocator)
+     * @brief Lock-striped hash map for concurrent access
+     * @details The key space is split into a power-of-two number of shards. Each shard
+     * is an independent hashTable guarded by its own pRWMutex, so:
+     * - Operations on keys in different shards never contend
+     * - Lookups on the same shard only take the lock in shared mode and run in parallel
+     * - Rehashing is local to a shard and only blocks that shard's writers and readers
+     *
+     * The shard of a key is picked from the high bits of a multiplicative mix of its hash,
+     * so it stays independent of the in-shard bucket index (hash modulo a prime).
+     *
+     * Every shard publishes its element count through an atomic counter, which lets
+     * size() sum the shards without taking any lock. The result is a consistent count
+     * for each shard but not a global snapshot while writers are active.
+     *
+     * Performance Characteristics:
+     * - Insertion: Average O(1), one exclusive shard lock
+     * - Lookup: Average O(1), one shared shard lock
+     * - Deletion: Average O(1), one exclusive shard lock
+     * - size(): O(shards), lock-free
+     *
+     * @note Not copyable or movable; share it by reference or through a pointer.
+     */
+    template <typename K_TYPE,
+              typename V_TYPE,
+              typename HASH = hash<K_TYPE>,
+              typename ALLOC = allocator<couple<const K_TYPE, V_TYPE>>>
+    class concurrentHashMap final : public container<couple<const K_TYPE, V_TYPE>, ALLOC>,
+                                    public printable {
+
+        /**
+         * @class shard
+         * @brief One independently locked partition of the map
+         * @details A hashTable plus the lock guarding it and a mirror of its size that can be
+         * read without the lock. Trailing padding keeps the hot fields of neighbouring shards
+         * on different cache lines.
+         */
+        class shard final : public hashTable<K_TYPE, V_TYPE, ALLOC, HASH> {
+            friend class concurrentHashMap;
+
+            mutable pRWMutex mutex_;                              ///< Guards the table
+            atomic<u_integer> cnt_{makeAtomic<u_integer>(0)};     ///< Published element count
+            byte padding_[CACHE_LINE_SIZE]{};                     ///< Separates neighbouring shards
+
+            /**
+             * @brief Publishes the current table size to cnt_
+             * @note Must be called with mutex_ held exclusively
+             */
+            void publishSize();
+
+        public:
+            /**
+             * @brief Constructs an empty shard
+             * @param hash Hash function to use
+             */
+            explicit shard(HASH hash = HASH{});
+        };
+
+        /**
+         * @typedef rebind_alloc_shard
+         * @brief Rebound allocator type for the shard array
+         */
+        using rebind_alloc_shard = typename ALLOC::template rebind_alloc<shard>;
+
+        shard* shards_;                                 ///< Shard array
+        u_integer shard_cnt_;                           ///< Number of shards (power of two)
+        HASH hash_;                                     ///< Hash function used for shard selection
+        mutable rebind_alloc_shard shard_alloc_{};      ///< Allocator for the shard array
+
+        /**
+         * @brief Rounds a requested shard count up to a power of two
+         * @param shard_cnt Requested number of shards
+         * @return Smallest power of two >= shard_cnt (at least 1)
+         */
+        static u_integer roundShardCount(u_integer shard_cnt);
+
+        /**
+         * @brief Selects the shard responsible for a key
+         * @param key Key to locate
+         * @return Reference to the owning shard
+         */
+        shard& shardOf(const K_TYPE& key) const;
+
+    public:
+        /**
+         * @brief Default number of shards
+         */
+        static constexpr u_integer DEFAULT_SHARDS = 16;
+
+        /**
+         * @brief Constructs an empty concurrentHashMap
+         * @param shard_cnt Number of shards, rounded up to a power of two (default: DEFAULT_SHARDS)
+         * @param hash Hash function to use
+         * @param alloc Allocator to use
+         */
+        explicit concurrentHashMap(u_integer shard_cnt = DEFAULT_SHARDS, HASH hash = HASH{}, ALLOC alloc = ALLOC{});
+
+        concurrentHashMap(const concurrentHashMap&) = delete;               ///< Disable copy constructor
+        concurrentHashMap& operator=(const concurrentHashMap&) = delete;    ///< Disable copy assignment
+        concurrentHashMap(concurrentHashMap&&) = delete;                    ///< Disable move constructor
+        concurrentHashMap& operator=(concurrentHashMap&&) = delete;         ///< Disable move assignment
+
+        /**
+         * @brief Gets number of elements
+         * @return Sum of the published shard sizes
+         * @note Lock-free; concurrent writers may make the result slightly stale
+         */
+        [[nodiscard]] u_integer size() const override;
+
+        /**
+         * @brief Gets the number of shards
+         * @return Shard count (a power of two)
+         */
+        [[nodiscard]] u_integer shardCount() const noexcept;
+
+        /**
+         * @brief Checks if key-value pair exists
+         * @param e Pair to check
+         * @return true if the key exists and its value matches
+         */
+        bool contains(const couple<const K_TYPE, V_TYPE>& e) const override;
+
+        /**
+         * @brief Adds new key-value pair
+         * @param k Key to add
+         * @param v Value to associate
+         * @return true if added, false if key existed
+         */
+        bool add(const K_TYPE& k, const V_TYPE& v);
+
+        /**
+         * @brief Removes key-value pair
+         * @param k Key to remove
+         * @return true if removed, false if key didn't exist
+         */
+        bool remove(const K_TYPE& k);
+
+        /**
+         * @brief Checks if key exists
+         * @param k Key to check
+         * @return true if key exists
+         */
+        [[nodiscard]] bool containsKey(const K_TYPE& k) const;
+
+        /**
+         * @brief Gets a copy of the value for key
+         * @param k Key to lookup
+         * @return Associated value
+         * @throw noElementError if key doesn't exist
+         */
+        V_TYPE get(const K_TYPE& k) const;
+
+        /**
+         * @brief Updates value for existing key
+         * @param key Key to update
+         * @param value New value
+         * @return true if updated, false if key didn't exist
+         */
+        bool update(const K_TYPE& key, const V_TYPE& value);
+
+        /**
+         * @brief Atomically modifies the value for an existing key in place
+         * @tparam Callback Callable invocable with V_TYPE&
+         * @param key Key to update
+         * @param c Callback applied to the stored value while the shard is locked
+         * @return true if the key existed and c was applied, false otherwise
+         * @note c must not access this map, or it will deadlock on the shard lock
+         */
+        template<typename Callback>
+        requires std::is_invocable_v<Callback, V_TYPE&>
+        bool update(const K_TYPE& key, Callback&& c);
+
+        /**
+         * @brief Gets the value for key, inserting a computed one if absent
+         * @tparam Callback Callable invocable with const K_TYPE& returning V_TYPE
+         * @param key Key to look up
+         * @param c Callback producing the value for a missing key
+         * @return The existing value, or the newly inserted one
+         * @details The key is first looked up under a shared lock, so the common "already
+         * present" case does not block other readers. Otherwise the shard is locked
+         * exclusively, the key is checked again and c is called at most once.
+         * @note c must not access this map, or it will deadlock on the shard lock
+         */
+        template<typename Callback>
+        V_TYPE computeIfAbsent(const K_TYPE& key, Callback&& c);
+
+        /**
+         * @brief Visits every key-value pair
+         * @tparam Callback Callable invocable with (const K_TYPE&, const V_TYPE&)
+         * @param c Visitor
+         * @details Shards are visited one after another, each under its shared lock.
+         * The traversal is weakly consistent: every pair present for the whole call
+         * is visited once, while concurrent changes to other shards may or may not be seen.
+         */
+        template<typename Callback>
+        void forEach(Callback&& c) const;
+
+        /**
+         * @brief Gets class name
+         * @return "concurrentHashMap"
+         */
+        [[nodiscard]] std::string className() const override;
+
+        /**
+         * @brief Converts to string representation
+         * @param enter Add newline if true
+         * @return String representation
+         */
+        [[nodiscard]] std::string toString(bool enter) const override;
+
+        /**
+         * @brief Destroys all shards and their elements
+         * @note No other thread may access the map during destruction
+         */
+        ~concurrentHashMap() override;
+    };
+
+    /**
+     * @class lockFreeHashMap
+     * @tparam K_TYPE Key type (must be hashable)
+     * @tparam V_TYPE Value type (must be copyable)
+     * @tparam HASH Hash function type (default: hash<K_TYPE>)
+     * @tparam ALLOC Allocator type (default: allocator)
+     * @brief Lock-free hash map based on split-ordered lists
+     * @details Implements the split-ordered list of Shalev and Shavit:
+     * - All pairs live in one lock-free sorted linked list (Harris/Michael marked-pointer
+     *   deletion), ordered by the bit-reversed hash ("split order")
+     * - Buckets are shortcuts into that list: bucket b points to a dummy node whose split-order
+     *   key is reverse(b), so every bucket's elements form one contiguous run of the list
+     * - Doubling the bucket count never moves an element; new buckets are initialized lazily by
+     *   inserting their dummy node after the dummy of their parent bucket
+     * - The bucket directory is a fixed array of lazily allocated segments of
+     *   doubling size, so growth never copies or locks a table
+     *
+     * Unlinked nodes are retired to an epochReclaimer and freed once no running operation
+     * can still observe them.
+     *
+     * Progress Guarantees:
+     * - add, remove, containsKey, get and contains are lock-free: a thread whose CAS fails
+     *   retries only because another thread's CAS succeeded, so the system as a whole always
+     *   makes progress, and no thread ever waits on another one
+     * - size() is wait-free (a single atomic load)
+     * - Memory reclamation is epoch-based: a thread stalled inside an operation delays the
+     *   freeing of nodes retired after it started, but never blocks other operations
+     *
+     * Performance Characteristics:
+     * - Insertion/Lookup/Deletion: Average O(1) with load factor <= LOAD_FACTOR_MAX
+     * - Values are immutable once inserted; replace one with remove() followed by add()
+     *
+     * @note Not copyable or movable; share it by reference or through a pointer.
+     */
+    template <typename K_TYPE,
+              typename V_TYPE,
+              typename HASH = hash<K_TYPE>,
+              typename ALLOC = allocator<couple<const K_TYPE, V_TYPE>>>
+    class lockFreeHashMap final : public container<couple<const K_TYPE, V_TYPE>, ALLOC>,
+                                  public printable {
+
+        /**
+         * @class listNode
+         * @brief Node of the split-ordered list
+         * @details Dummy (bucket) nodes are plain listNodes with an even split-order key,
+         * nodes holding pairs are dataNodes with an odd split-order key.
+         * The lowest bit of next_ marks the node as logically deleted.
+         */
+        class listNode : public epochReclaimer::retirable {
+        public:
+            const u_integer so_key_;        ///< Split-order key
+            atomic<listNode*> next_;        ///< Marked successor pointer
+
+            /**
+             * @brief Constructs a node
+             * @param so_key Split-order key
+             */
+            explicit listNode(u_integer so_key);
+
+            /**
+             * @brief Checks if this node carries a key-value pair
+             * @return true for data nodes, false for bucket dummies
+             */
+            [[nodiscard]] bool isData() const noexcept;
+        };
+
+        /**
+         * @class dataNode
+         * @brief List node carrying a key-value pair
+         */
+        class dataNode final : public listNode {
+        public:
+            const couple<const K_TYPE, V_TYPE> data_;   ///< Stored pair
+
+            /**
+             * @brief Constructs a data node
+             * @param so_key Split-order key (odd)
+             * @param key Key to store
+             * @param value Value to store
+             */
+            dataNode(u_integer so_key, const K_TYPE& key, const V_TYPE& value);
+        };
+
+        /**
+         * @typedef bucket
+         * @brief A bucket slot: pointer to the bucket's dummy node, nullptr while uninitialized
+         */
+        using bucket = atomic<listNode*>;
+
+        using rebind_alloc_list_node = typename ALLOC::template rebind_alloc<listNode>;     ///< Dummy allocator
+        using rebind_alloc_data_node = typename ALLOC::template rebind_alloc<dataNode>;     ///< Data node allocator
+        using rebind_alloc_bucket = typename ALLOC::template rebind_alloc<bucket>;          ///< Segment allocator
+        using rebind_alloc_segment = typename ALLOC::template rebind_alloc<atomic<bucket*>>; ///< Directory allocator
+
+        /**
+         * @brief Number of directory entries; segment i holds buckets [2^i, 2^(i+1)), segment 0 holds [0, 2)
+         */
+        static constexpr u_integer MAX_SEGMENTS = 26;
+
+        /**
+         * @brief Upper bound of the bucket count
+         */
+        static constexpr u_integer MAX_BUCKETS = 1u << MAX_SEGMENTS;
+
+        /**
+         * @brief Initial bucket count
+         */
+        static constexpr u_integer INITIAL_BUCKETS = 2;
+
+        HASH hash_;                                             ///< Hash function
+        atomic<u_integer> bucket_cnt_{makeAtomic<u_integer>(INITIAL_BUCKETS)};  ///< Current bucket count
+        atomic<u_integer> size_{makeAtomic<u_integer>(0)};      ///< Element count
+        atomic<bucket*>* segments_;                             ///< Segment directory
+        mutable rebind_alloc_list_node list_node_alloc_{};      ///< Allocator for dummy nodes
+        mutable rebind_alloc_data_node data_node_alloc_{};      ///< Allocator for data nodes
+        mutable rebind_alloc_bucket bucket_alloc_{};            ///< Allocator for segments
+        mutable rebind_alloc_segment segment_alloc_{};          ///< Allocator for the directory
+        mutable epochReclaimer reclaimer_;                      ///< Reclamation of unlinked nodes
+
+        /**
+         * @brief Reverses the bit order of a 32-bit word
+         * @param v Word to reverse
+         * @return v with bit i moved to bit 31 - i
+         */
+        static u_integer reverseBits(u_integer v) noexcept;
+
+        /**
+         * @brief Split-order key of a data node
+         * @param hash_code Hash of the key
+         * @return Bit-reversed hash with the lowest bit set
+         */
+        static u_integer regularKey(u_integer hash_code) noexcept;
+
+        /**
+         * @brief Split-order key of a bucket dummy
+         * @param b Bucket index
+         * @return Bit-reversed bucket index (lowest bit clear)
+         */
+        static u_integer dummyKey(u_integer b) noexcept;
+
+        /**
+         * @brief Checks the deletion mark of a successor pointer
+         */
+        static bool isMarked(listNode* p) noexcept;
+
+        /**
+         * @brief Sets the deletion mark of a successor pointer
+         */
+        static listNode* marked(listNode* p) noexcept;
+
+        /**
+         * @brief Clears the deletion mark of a successor pointer
+         */
+        static listNode* unmarked(listNode* p) noexcept;
+
+        /**
+         * @brief Frees a node through the matching allocator
+         * @param node Node to free
+         */
+        void destroyNode(listNode* node) const;
+
+        /**
+         * @brief Gets the slot of a bucket, allocating its segment if needed
+         * @param b Bucket index
+         * @return Reference to the bucket slot
+         */
+        bucket& bucketSlot(u_integer b) const;
+
+        /**
+         * @brief Gets the dummy node of a bucket, initializing the bucket if needed
+         * @param b Bucket index
+         * @return Dummy node heading the bucket's run of the list
+         */
+        listNode* getBucket(u_integer b) const;
+
+        /**
+         * @brief Initializes a bucket by inserting its dummy node after its parent's
+         * @param b Bucket index (> 0)
+         */
+        void initBucket(u_integer b) const;
+
+        /**
+         * @brief Searches the list starting at a dummy node
+         * @param head Dummy node to start from
+         * @param so_key Split-order key to find
+         * @param key Key to match for data nodes, nullptr to search a dummy
+         * @param prev Set to the successor field that points to cur
+         * @param cur Set to the found node, or the first node ordered after the target
+         * @return true if a matching node was found
+         * @details Physically unlinks and retires marked nodes it passes.
+         */
+        bool listFind(listNode* head, u_integer so_key, const K_TYPE* key,
+                      atomic<listNode*>*& prev, listNode*& cur) const;
+
+        /**
+         * @brief Inserts a node into the list unless a matching one exists
+         * @param head Dummy node to start from
+         * @param node Node to insert
+         * @param key Key of node, nullptr for a dummy
+         * @return nullptr if inserted, otherwise the existing matching node
+         */
+        listNode* listInsert(listNode* head, listNode* node, const K_TYPE* key) const;
+
+        /**
+         * @brief Finds the data node of a key
+         * @param key Key to look up
+         * @return Matching data node, or nullptr
+         * @note The caller must hold an epochReclaimer::guard
+         */
+        dataNode* findNode(const K_TYPE& key) const;
+
+    public:
+        /**
+         * @brief Maximum average number of elements per bucket before the bucket count doubles
+         */
+        static constexpr u_integer LOAD_FACTOR_MAX = 2;
+
+        /**
+         * @brief Constructs an empty lockFreeHashMap
+         * @param hash Hash function to use
+         * @param alloc Allocator to use
+         */
+        explicit lockFreeHashMap(HASH hash = HASH{}, ALLOC alloc = ALLOC{});
+
+        lockFreeHashMap(const lockFreeHashMap&) = delete;               ///< Disable copy constructor
+        lockFreeHashMap& operator=(const lockFreeHashMap&) = delete;    ///< Disable copy assignment
+        lockFreeHashMap(lockFreeHashMap&&) = delete;                    ///< Disable move constructor
+        lockFreeHashMap& operator=(lockFreeHashMap&&) = delete;         ///< Disable move assignment
+
+        /**
+         * @brief Gets number of elements
+         * @return Current size (wait-free)
+         */
+        [[nodiscard]] u_integer size() const override;
+
+        /**
+         * @brief Gets the current number of buckets
+         * @return Bucket count (a power of two)
+         */
+        [[nodiscard]] u_integer bucketCount() const noexcept;
+
+        /**
+         * @brief Checks if key-value pair exists
+         * @param e Pair to check
+         * @return true if the key exists and its value matches
+         */
+        bool contains(const couple<const K_TYPE, V_TYPE>& e) const override;
+
+        /**
+         * @brief Adds new key-value pair
+         * @param k Key to add
+         * @param v Value to associate
+         * @return true if added, false if key existed
+         */
+        bool add(const K_TYPE& k, const V_TYPE& v);
+
+        /**
+         * @brief Removes key-value pair
+         * @param k Key to remove
+         * @return true if removed, false if key didn't exist
+         */
+        bool remove(const K_TYPE& k);
+
+        /**
+         * @brief Checks if key exists
+         * @param k Key to check
+         * @return true if key exists
+         */
+        [[nodiscard]] bool containsKey(const K_TYPE& k) const;
+
+        /**
+         * @brief Gets a copy of the value for key
+         * @param k Key to lookup
+         * @return Associated value
+         * @throw noElementError if key doesn't exist
+         */
+        V_TYPE get(const K_TYPE& k) const;
+
+        /**
+         * @brief Visits every key-value pair
+         * @tparam Callback Callable invocable with (const K_TYPE&, const V_TYPE&)
+         * @param c Visitor
+         * @details Walks the split-ordered list once. The traversal is weakly consistent:
+         * pairs present for the whole call are visited exactly once, concurrently added or
+         * removed pairs may or may not be visited.
+         */
+        template<typename Callback>
+        void forEach(Callback&& c) const;
+
+        /**
+         * @brief Gets class name
+         * @return "lockFreeHashMap"
+         */
+        [[nodiscard]] std::string className() const override;
+
+        /**
+         * @brief Converts to string representation
+         * @param enter Add newline if true
+         * @return String representation
+         */
+        [[nodiscard]] std::string toString(bool enter) const override;
+
+        /**
+         * @brief Frees all nodes, segments and retired nodes
+         * @note No other thread may access the map during destruction
+         */
+        ~lockFreeHashMap() override;
+    };
+
+    /**
+     * @class concurrentJMap
+     * @tparam K_TYPE Key type (must be comparable)
+     * @tparam V_TYPE Value type (must be copyable)
+     * @tparam Compare Comparison function type (default: increaseComparator<K_TYPE>)
+     * @tparam ALLOC Allocator type (default: allocator<couple<const K_TYPE, V_TYPE>>)
+     * @brief Lock-free ordered map based on a skip list
+     * @details The concurrent counterpart of JMap, built on lockFreeSkipList: towers are
+     * linked with CAS, deletion marks successor pointers, and unlinked nodes are retired
+     * to an epochReclaimer.
+     *
+     * Progress Guarantees:
+     * - add and remove are lock-free
+     * - containsKey, get, contains and the traversals never write the map's nodes; they only
+     *   update the shared epoch counters of its reclaimer
+     * - size() is wait-free (a single atomic load)
+     *
+     * Performance Characteristics:
+     * - Insertion/Lookup/Deletion: Expected O(log n)
+     * - Ordered traversal: O(n), range scan O(log n + k) via forEachInRange()
+     * - Values are immutable once inserted; replace one with remove() followed by add()
+     *
+     * @note Not copyable or movable; share it by reference or through a pointer.
+     */
+    template <typename K_TYPE,
+              typename V_TYPE,
+              typename Compare = increaseComparator<K_TYPE>,
+              typename ALLOC = allocator<couple<const K_TYPE, V_TYPE>>>
+    class concurrentJMap final : public lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>,
+                                 public container<couple<const K_TYPE, V_TYPE>, ALLOC>,
+                                 public printable {
+        using skipListType = lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>;
+
+    public:
+        /**
+         * @brief Constructs an empty concurrentJMap
+         * @param compare Comparison function to use
+         * @param alloc Allocator to use
+         */
+        explicit concurrentJMap(Compare compare = Compare{}, ALLOC alloc = ALLOC{});
+
+        /**
+         * @brief Gets number of elements
+         * @return Current size (wait-free)
+         */
+        [[nodiscard]] u_integer size() const override;
+
+        /**
+         * @brief Checks if key-value pair exists
+         * @param e Pair to check
+         * @return true if the key exists and its value matches
+         */
+        bool contains(const couple<const K_TYPE, V_TYPE>& e) const override;
+
+        /**
+         * @brief Adds new key-value pair
+         * @param k Key to add
+         * @param v Value to associate
+         * @return true if added, false if key existed
+         */
+        bool add(const K_TYPE& k, const V_TYPE& v);
+
+        /**
+         * @brief Removes key-value pair
+         * @param k Key to remove
+         * @return true if removed, false if key didn't exist
+         */
+        bool remove(const K_TYPE& k);
+
+        /**
+         * @brief Checks if key exists
+         * @param k Key to check
+         * @return true if key exists
+         */
+        [[nodiscard]] bool containsKey(const K_TYPE& k) const;
+
+        /**
+         * @brief Gets a copy of the value for key
+         * @param k Key to lookup
+         * @return Associated value
+         * @throw noElementError if key doesn't exist
+         */
+        V_TYPE get(const K_TYPE& k) const;
+
+        /**
+         * @brief Visits every key-value pair in key order
+         * @tparam Callback Callable invocable with (const K_TYPE&, const V_TYPE&)
+         * @param c Visitor
+         * @details The traversal is weakly consistent: pairs present for the whole call are
+         * visited exactly once and in key order, concurrently added or removed pairs may or
+         * may not be visited.
+         */
+        template<typename Callback>
+        void forEach(Callback&& c) const;
+
+        /**
+         * @brief Visits the pairs with keys in [low, high) in key order
+         * @tparam Callback Callable invocable with (const K_TYPE&, const V_TYPE&)
+         * @param low Inclusive lower bound
+         * @param high Exclusive upper bound
+         * @param c Visitor
+         * @details Descends once to low, then walks the bottom level. Weakly consistent like forEach().
+         */
+        template<typename Callback>
+        void forEachInRange(const K_TYPE& low, const K_TYPE& high, Callback&& c) const;
+
+        /**
+         * @brief Gets class name
+         * @return "concurrentJMap"
+         */
+        [[nodiscard]] std::string className() const override;
+
+        /**
+         * @brief Converts to string representation
+         * @param enter Add newline if true
+         * @return String representation
+         */
+        [[nodiscard]] std::string toString(bool enter) const override;
+
+        /**
+         * @brief Frees all nodes
+         * @note No other thread may access the map during destruction
+         */
+        ~concurrentJMap() override;
+    };
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::concurrentHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::shard::shard(HASH hash)
+    : hashTable<K_TYPE, V_TYPE, ALLOC, HASH>(std::move(hash)) {}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+void original::concurrentHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::shard::publishSize() {
+    this->cnt_.store(this->size_, memOrder::RELEASE);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::u_integer
+original::concurrentHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::roundShardCount(const u_integer shard_cnt) {
+    u_integer cnt = 1;
+    while (cnt < shard_cnt) {
+        cnt <<= 1;
+    }
+    return cnt;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+typename original::concurrentHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::shard&
+original::concurrentHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::shardOf(const K_TYPE& key) const {
+    const ul_integer mixed = static_cast<ul_integer>(this->hash_(key)) * 0x9E3779B97F4A7C15ULL;
+    return this->shards_[static_cast<u_integer>(mixed >> 32) & (this->shard_cnt_ - 1)];
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::concurrentHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::concurrentHashMap(
+    const u_integer shard_cnt, HASH hash, ALLOC alloc)
+    : container<couple<const K_TYPE, V_TYPE>, ALLOC>(std::move(alloc)),
+      shards_(nullptr), shard_cnt_(roundShardCount(shard_cnt)), hash_(std::move(hash)) {
+    this->shards_ = this->shard_alloc_.allocate(this->shard_cnt_);
+    for (u_integer i = 0; i < this->shard_cnt_; ++i) {
+        this->shard_alloc_.construct(&this->shards_[i], this->hash_);
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::u_integer
+original::concurrentHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::size() const {
+    u_integer total = 0;
+    for (u_integer i = 0; i < this->shard_cnt_; ++i) {
+        total += this->shards_[i].cnt_.load(memOrder::ACQUIRE);
+    }
+    return total;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::u_integer
+original::concurrentHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::shardCount() const noexcept {
+    return this->shard_cnt_;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::concurrentHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::contains(const couple<const K_TYPE, V_TYPE>& e) const {
+    auto& s = this->shardOf(e.first());
+    sharedLock lock{s.mutex_};
+    auto node = s.find(e.first());
+    return node && node->getValue() == e.second();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::concurrentHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::add(const K_TYPE& k, const V_TYPE& v) {
+    auto& s = this->shardOf(k);
+    uniqueLock lock{s.mutex_};
+    if (!s.insert(k, v))
+        return false;
+    s.publishSize();
+    return true;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::concurrentHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::remove(const K_TYPE& k) {
+    auto& s = this->shardOf(k);
+    uniqueLock lock{s.mutex_};
+    if (!s.erase(k))
+        return false;
+    s.publishSize();
+    return true;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::concurrentHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::containsKey(const K_TYPE& k) const {
+    auto& s = this->shardOf(k);
+    sharedLock lock{s.mutex_};
+    return s.find(k);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+V_TYPE original::concurrentHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::get(const K_TYPE& k) const {
+    auto& s = this->shardOf(k);
+    sharedLock lock{s.mutex_};
+    auto node = s.find(k);
+    if (!node)
+        throw noElementError();
+    return node->getValue();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::concurrentHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::update(const K_TYPE& key, const V_TYPE& value) {
+    auto& s = this->shardOf(key);
+    uniqueLock lock{s.mutex_};
+    return s.modify(key, value);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+template<typename Callback>
+requires std::is_invocable_v<Callback, V_TYPE&>
+bool original::concurrentHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::update(const K_TYPE& key, Callback&& c) {
+    auto& s = this->shardOf(key);
+    uniqueLock lock{s.mutex_};
+    auto node = s.find(key);
+    if (!node)
+        return false;
+    c(node->getValue());
+    return true;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+template<typename Callback>
+V_TYPE original::concurrentHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::computeIfAbsent(const K_TYPE& key, Callback&& c) {
+    auto& s = this->shardOf(key);
+    {
+        sharedLock lock{s.mutex_};
+        if (auto node = s.find(key))
+            return node->getValue();
+    }
+
+    uniqueLock lock{s.mutex_};
+    if (auto node = s.find(key))
+        return node->getValue();
+    V_TYPE value = c(key);
+    s.insert(key, value);
+    s.publishSize();
+    return value;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+template<typename Callback>
+void original::concurrentHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::forEach(Callback&& c) const {
+    for (u_integer i = 0; i < this->shard_cnt_; ++i) {
+        auto& s = this->shards_[i];
+        sharedLock lock{s.mutex_};
+        for (auto bucket : s.buckets) {
+            for (auto cur = bucket; cur; cur = cur->getPNext()) {
+                c(cur->getKey(), cur->getValue());
+            }
+        }
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+std::string original::concurrentHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::className() const {
+    return "concurrentHashMap";
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+std::string original::concurrentHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::toString(const bool enter) const {
+    std::stringstream ss;
+    ss << this->className();
+    ss << "(";
+    bool first = true;
+    this->forEach([&](const K_TYPE& k, const V_TYPE& v) {
+        if (!first){
+            ss << ", ";
+        }
+        ss << "{" << printable::formatString(k) << ": "
+           << printable::formatString(v) << "}";
+        first = false;
+    });
+    ss << ")";
+    if (enter)
+        ss << "\n";
+    return ss.str();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::concurrentHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::~concurrentHashMap() {
+    for (u_integer i = 0; i < this->shard_cnt_; ++i) {
+        this->shard_alloc_.destroy(&this->shards_[i]);
+    }
+    this->shard_alloc_.deallocate(this->shards_, this->shard_cnt_);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::listNode::listNode(const u_integer so_key)
+    : so_key_(so_key), next_(makeAtomic<listNode*>(nullptr)) {}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::listNode::isData() const noexcept {
+    return this->so_key_ & 1;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::dataNode::dataNode(
+    const u_integer so_key, const K_TYPE& key, const V_TYPE& value)
+    : listNode(so_key), data_(key, value) {}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::u_integer
+original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::reverseBits(u_integer v) noexcept {
+    v = (v >> 1 & 0x55555555u) | (v & 0x55555555u) << 1;
+    v = (v >> 2 & 0x33333333u) | (v & 0x33333333u) << 2;
+    v = (v >> 4 & 0x0F0F0F0Fu) | (v & 0x0F0F0F0Fu) << 4;
+    v = (v >> 8 & 0x00FF00FFu) | (v & 0x00FF00FFu) << 8;
+    return v >> 16 | v << 16;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::u_integer
+original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::regularKey(const u_integer hash_code) noexcept {
+    return reverseBits(hash_code | 0x80000000u);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::u_integer
+original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::dummyKey(const u_integer b) noexcept {
+    return reverseBits(b);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::isMarked(listNode* p) noexcept {
+    return reinterpret_cast<ul_integer>(p) & 1;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+typename original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::listNode*
+original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::marked(listNode* p) noexcept {
+    return reinterpret_cast<listNode*>(reinterpret_cast<ul_integer>(p) | 1);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+typename original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::listNode*
+original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::unmarked(listNode* p) noexcept {
+    return reinterpret_cast<listNode*>(reinterpret_cast<ul_integer>(p) & ~static_cast<ul_integer>(1));
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+void original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::destroyNode(listNode* node) const {
+    if (node->isData()) {
+        auto data = static_cast<dataNode*>(node);
+        this->data_node_alloc_.destroy(data);
+        this->data_node_alloc_.deallocate(data, 1);
+    } else {
+        this->list_node_alloc_.destroy(node);
+        this->list_node_alloc_.deallocate(node, 1);
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+typename original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::bucket&
+original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::bucketSlot(const u_integer b) const {
+    const u_integer seg = b < 2 ? 0 : static_cast<u_integer>(std::bit_width(b)) - 1;
+    const u_integer offset = b < 2 ? b : b - (1u << seg);
+    bucket* segment = this->segments_[seg].load(memOrder::ACQUIRE);
+    if (!segment) {
+        const u_integer seg_size = seg == 0 ? 2 : 1u << seg;
+        bucket* fresh = this->bucket_alloc_.allocate(seg_size);
+        for (u_integer i = 0; i < seg_size; ++i) {
+            ::new (&fresh[i]) bucket(makeAtomic<listNode*>(nullptr));
+        }
+        if (this->segments_[seg].exchangeCmp(segment, fresh)) {
+            segment = fresh;
+        } else {
+            this->bucket_alloc_.deallocate(fresh, seg_size);
+        }
+    }
+    return segment[offset];
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+typename original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::listNode*
+original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::getBucket(const u_integer b) const {
+    auto& slot = this->bucketSlot(b);
+    listNode* dummy = slot.load(memOrder::ACQUIRE);
+    if (!dummy) {
+        this->initBucket(b);
+        dummy = slot.load(memOrder::ACQUIRE);
+    }
+    return dummy;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+void original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::initBucket(const u_integer b) const {
+    const u_integer parent = b & ~(1u << (std::bit_width(b) - 1));
+    listNode* parent_dummy = this->getBucket(parent);
+
+    listNode* dummy = this->list_node_alloc_.allocate(1);
+    this->list_node_alloc_.construct(dummy, dummyKey(b));
+    if (listNode* existing = this->listInsert(parent_dummy, dummy, nullptr)) {
+        this->destroyNode(dummy);
+        dummy = existing;
+    }
+
+    listNode* expected = nullptr;
+    this->bucketSlot(b).exchangeCmp(expected, dummy);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::listFind(
+    listNode* head, const u_integer so_key, const K_TYPE* key,
+    atomic<listNode*>*& prev, listNode*& cur) const {
+    retry:
+    prev = &head->next_;
+    cur = prev->load();
+    while (true) {
+        if (!cur)
+            return false;
+
+        listNode* next = cur->next_.load();
+        if (prev->load() != cur)
+            goto retry;
+
+        if (isMarked(next)) {
+            listNode* expected = cur;
+            if (!prev->exchangeCmp(expected, unmarked(next)))
+                goto retry;
+            this->reclaimer_.retire(cur);
+            cur = unmarked(next);
+            continue;
+        }
+
+        if (cur->so_key_ > so_key)
+            return false;
+        if (cur->so_key_ == so_key &&
+            (!key || static_cast<dataNode*>(cur)->data_.first() == *key))
+            return true;
+
+        prev = &cur->next_;
+        cur = next;
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+typename original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::listNode*
+original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::listInsert(
+    listNode* head, listNode* node, const K_TYPE* key) const {
+    atomic<listNode*>* prev;
+    listNode* cur;
+    while (true) {
+        if (this->listFind(head, node->so_key_, key, prev, cur))
+            return cur;
+        node->next_.store(cur);
+        if (listNode* expected = cur; prev->exchangeCmp(expected, node))
+            return nullptr;
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+typename original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::dataNode*
+original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::findNode(const K_TYPE& key) const {
+    const u_integer hash_code = this->hash_(key);
+    listNode* head = this->getBucket(hash_code & (this->bucket_cnt_.load() - 1));
+    atomic<listNode*>* prev;
+    listNode* cur;
+    if (this->listFind(head, regularKey(hash_code), &key, prev, cur))
+        return static_cast<dataNode*>(cur);
+    return nullptr;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::lockFreeHashMap(HASH hash, ALLOC alloc)
+    : container<couple<const K_TYPE, V_TYPE>, ALLOC>(std::move(alloc)),
+      hash_(std::move(hash)), segments_(nullptr),
+      reclaimer_([this](epochReclaimer::retirable* node) {
+          this->destroyNode(static_cast<listNode*>(node));
+      }) {
+    this->segments_ = this->segment_alloc_.allocate(MAX_SEGMENTS);
+    for (u_integer i = 0; i < MAX_SEGMENTS; ++i) {
+        ::new (&this->segments_[i]) atomic<bucket*>(makeAtomic<bucket*>(nullptr));
+    }
+    listNode* head = this->list_node_alloc_.allocate(1);
+    this->list_node_alloc_.construct(head, dummyKey(0));
+    this->bucketSlot(0).store(head);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::u_integer
+original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::size() const {
+    return this->size_.load();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::u_integer
+original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::bucketCount() const noexcept {
+    return this->bucket_cnt_.load();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::contains(const couple<const K_TYPE, V_TYPE>& e) const {
+    epochReclaimer::guard guard{this->reclaimer_};
+    auto node = this->findNode(e.first());
+    return node && node->data_.second() == e.second();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::add(const K_TYPE& k, const V_TYPE& v) {
+    epochReclaimer::guard guard{this->reclaimer_};
+    const u_integer hash_code = this->hash_(k);
+    u_integer bucket_cnt = this->bucket_cnt_.load();
+    listNode* head = this->getBucket(hash_code & (bucket_cnt - 1));
+
+    dataNode* node = this->data_node_alloc_.allocate(1);
+    this->data_node_alloc_.construct(node, regularKey(hash_code), k, v);
+    if (this->listInsert(head, node, &k)) {
+        this->destroyNode(node);
+        return false;
+    }
+
+    this->size_ += 1;
+    if (this->size_.load() / bucket_cnt > LOAD_FACTOR_MAX && bucket_cnt < MAX_BUCKETS) {
+        this->bucket_cnt_.exchangeCmp(bucket_cnt, bucket_cnt * 2);
+    }
+    return true;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::remove(const K_TYPE& k) {
+    epochReclaimer::guard guard{this->reclaimer_};
+    const u_integer hash_code = this->hash_(k);
+    const u_integer so_key = regularKey(hash_code);
+    listNode* head = this->getBucket(hash_code & (this->bucket_cnt_.load() - 1));
+    atomic<listNode*>* prev;
+    listNode* cur;
+    while (true) {
+        if (!this->listFind(head, so_key, &k, prev, cur))
+            return false;
+
+        listNode* next = cur->next_.load();
+        if (isMarked(next))
+            continue;
+        if (!cur->next_.exchangeCmp(next, marked(next)))
+            continue;
+
+        if (listNode* expected = cur; prev->exchangeCmp(expected, next)) {
+            this->reclaimer_.retire(cur);
+        } else {
+            this->listFind(head, so_key, &k, prev, cur);
+        }
+        this->size_ -= 1;
+        return true;
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+bool original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::containsKey(const K_TYPE& k) const {
+    epochReclaimer::guard guard{this->reclaimer_};
+    return this->findNode(k);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+V_TYPE original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::get(const K_TYPE& k) const {
+    epochReclaimer::guard guard{this->reclaimer_};
+    auto node = this->findNode(k);
+    if (!node)
+        throw noElementError();
+    return node->data_.second();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+template<typename Callback>
+void original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::forEach(Callback&& c) const {
+    epochReclaimer::guard guard{this->reclaimer_};
+    for (listNode* cur = this->bucketSlot(0).load(); cur; ) {
+        listNode* next = cur->next_.load();
+        if (cur->isData() && !isMarked(next)) {
+            auto data = static_cast<dataNode*>(cur);
+            c(data->data_.first(), data->data_.second());
+        }
+        cur = unmarked(next);
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+std::string original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::className() const {
+    return "lockFreeHashMap";
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+std::string original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::toString(const bool enter) const {
+    std::stringstream ss;
+    ss << this->className();
+    ss << "(";
+    bool first = true;
+    this->forEach([&](const K_TYPE& k, const V_TYPE& v) {
+        if (!first){
+            ss << ", ";
+        }
+        ss << "{" << printable::formatString(k) << ": "
+           << printable::formatString(v) << "}";
+        first = false;
+    });
+    ss << ")";
+    if (enter)
+        ss << "\n";
+    return ss.str();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename HASH, typename ALLOC>
+original::lockFreeHashMap<K_TYPE, V_TYPE, HASH, ALLOC>::~lockFreeHashMap() {
+    for (listNode* cur = this->bucketSlot(0).load(); cur; ) {
+        listNode* next = unmarked(cur->next_.load());
+        this->destroyNode(cur);
+        cur = next;
+    }
+    for (u_integer i = 0; i < MAX_SEGMENTS; ++i) {
+        if (bucket* segment = this->segments_[i].load()) {
+            this->bucket_alloc_.deallocate(segment, i == 0 ? 2 : 1u << i);
+        }
+    }
+    this->segment_alloc_.deallocate(this->segments_, MAX_SEGMENTS);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::concurrentJMap<K_TYPE, V_TYPE, Compare, ALLOC>::concurrentJMap(Compare compare, ALLOC alloc)
+    : skipListType(std::move(compare)),
+      container<couple<const K_TYPE, V_TYPE>, ALLOC>(std::move(alloc)) {}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::u_integer
+original::concurrentJMap<K_TYPE, V_TYPE, Compare, ALLOC>::size() const {
+    return this->size_.load();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::concurrentJMap<K_TYPE, V_TYPE, Compare, ALLOC>::contains(const couple<const K_TYPE, V_TYPE>& e) const {
+    epochReclaimer::guard guard{this->reclaimer_};
+    auto node = this->findNode(e.first());
+    return node && node->getValue() == e.second();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::concurrentJMap<K_TYPE, V_TYPE, Compare, ALLOC>::add(const K_TYPE& k, const V_TYPE& v) {
+    return this->insert(k, v);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::concurrentJMap<K_TYPE, V_TYPE, Compare, ALLOC>::remove(const K_TYPE& k) {
+    return this->erase(k);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+bool original::concurrentJMap<K_TYPE, V_TYPE, Compare, ALLOC>::containsKey(const K_TYPE& k) const {
+    epochReclaimer::guard guard{this->reclaimer_};
+    return this->findNode(k);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+V_TYPE original::concurrentJMap<K_TYPE, V_TYPE, Compare, ALLOC>::get(const K_TYPE& k) const {
+    epochReclaimer::guard guard{this->reclaimer_};
+    auto node = this->findNode(k);
+    if (!node)
+        throw noElementError();
+    return node->getValue();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+template<typename Callback>
+void original::concurrentJMap<K_TYPE, V_TYPE, Compare, ALLOC>::forEach(Callback&& c) const {
+    epochReclaimer::guard guard{this->reclaimer_};
+    this->traverse(nullptr, nullptr, [&](auto node) {
+        c(node->getKey(), node->getValue());
+    });
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+template<typename Callback>
+void original::concurrentJMap<K_TYPE, V_TYPE, Compare, ALLOC>::forEachInRange(
+    const K_TYPE& low, const K_TYPE& high, Callback&& c) const {
+    epochReclaimer::guard guard{this->reclaimer_};
+    if (auto from = this->lowerBound(low)) {
+        this->traverse(from, &high, [&](auto node) {
+            c(node->getKey(), node->getValue());
+        });
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+std::string original::concurrentJMap<K_TYPE, V_TYPE, Compare, ALLOC>::className() const {
+    return "concurrentJMap";
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+std::string original::concurrentJMap<K_TYPE, V_TYPE, Compare, ALLOC>::toString(const bool enter) const {
+    std::stringstream ss;
+    ss << this->className();
+    ss << "(";
+    bool first = true;
+    this->forEach([&](const K_TYPE& k, const V_TYPE& v) {
+        if (!first){
+            ss << ", ";
+        }
+        ss << "{" << printable::formatString(k) << ": "
+           << printable::formatString(v) << "}";
+        first = false;
+    });
+    ss << ")";
+    if (enter)
+        ss << "\n";
+    return ss.str();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+original::concurrentJMap<K_TYPE, V_TYPE, Compare, ALLOC>::~concurrentJMap() = default;
+
+#endif //ORIGINAL_CONCURRENT_MAPS_H
@@ -0,0 +1,208 @@
+#ifndef ORIGINAL_CONCURRENT_SETS_H
+#define ORIGINAL_CONCURRENT_SETS_H
+
+#include "allocator.h"
+#include "comparator.h"
+#include "container.h"
+#include "couple.h"
+#include "lockFreeSkipList.h"
+
+
+/**
+ * @file concurrentSets.h
+ * @brief Set containers that are safe for concurrent use from many threads
+ * @details Provides thread-safe counterparts of the containers in sets.h:
+ * 1. concurrentJSet - Lock-free skip list (ordered, lock-free, epoch-based reclamation)
+ *
+ * Like the containers in concurrentMaps.h, these sets never hand out references into
+ * their storage and are traversed through weakly consistent visitors instead of iterators.
+ *
+ * @see sets.h For the single-threaded set containers
+ * @see concurrentMaps.h For concurrentJMap, the map over the same skip list
+ * @see lockFreeSkipList.h For the skip list behind concurrentJSet
+ */
+
+namespace original {
+
+    /**
+     * @class concurrentJSet
+     * @tparam TYPE Element type (must be comparable and copyable)
+     * @tparam Compare Comparison function type (default: increaseComparator<TYPE>)
+     * @tparam ALLOC Allocator type (default: allocator<couple<const TYPE, const bool>>)
+     * @brief Lock-free ordered set based on a skip list
+     * @details The concurrent counterpart of JSet, built on lockFreeSkipList with a
+     * placeholder value, the same way JSet is built on skipList.
+     *
+     * Progress Guarantees:
+     * - add and remove are lock-free
+     * - contains and the traversals never write the set's nodes; they only update the shared
+     *   epoch counters of its reclaimer
+     * - size() is wait-free (a single atomic load)
+     *
+     * Performance Characteristics:
+     * - Insertion/Lookup/Deletion: Expected O(log n)
+     * - Ordered traversal: O(n), range scan O(log n + k) via forEachInRange()
+     *
+     * @note Not copyable or movable; share it by reference or through a pointer.
+     */
+    template <typename TYPE,
+              typename Compare = increaseComparator<TYPE>,
+              typename ALLOC = allocator<couple<const TYPE, const bool>>>
+    class concurrentJSet final : public lockFreeSkipList<TYPE, const bool, ALLOC, Compare>,
+                                 public container<TYPE, ALLOC>,
+                                 public printable {
+        using skipListType = lockFreeSkipList<TYPE, const bool, ALLOC, Compare>;
+
+    public:
+        /**
+         * @brief Constructs an empty concurrentJSet
+         * @param compare Comparison function to use
+         * @param alloc Allocator to use
+         */
+        explicit concurrentJSet(Compare compare = Compare{}, ALLOC alloc = ALLOC{});
+
+        /**
+         * @brief Gets number of elements
+         * @return Current size (wait-free)
+         */
+        [[nodiscard]] u_integer size() const override;
+
+        /**
+         * @brief Checks if element exists
+         * @param e Element to check
+         * @return true if element exists
+         */
+        bool contains(const TYPE& e) const override;
+
+        /**
+         * @brief Adds new element
+         * @param e Element to add
+         * @return true if added, false if element existed
+         */
+        bool add(const TYPE& e);
+
+        /**
+         * @brief Removes element
+         * @param e Element to remove
+         * @return true if removed, false if element didn't exist
+         */
+        bool remove(const TYPE& e);
+
+        /**
+         * @brief Visits every element in order
+         * @tparam Callback Callable invocable with const TYPE&
+         * @param c Visitor
+         * @details The traversal is weakly consistent: elements present for the whole call
+         * are visited exactly once and in order, concurrently added or removed elements may
+         * or may not be visited.
+         */
+        template<typename Callback>
+        void forEach(Callback&& c) const;
+
+        /**
+         * @brief Visits the elements in [low, high) in order
+         * @tparam Callback Callable invocable with const TYPE&
+         * @param low Inclusive lower bound
+         * @param high Exclusive upper bound
+         * @param c Visitor
+         * @details Descends once to low, then walks the bottom level. Weakly consistent like forEach().
+         */
+        template<typename Callback>
+        void forEachInRange(const TYPE& low, const TYPE& high, Callback&& c) const;
+
+        /**
+         * @brief Gets class name
+         * @return "concurrentJSet"
+         */
+        [[nodiscard]] std::string className() const override;
+
+        /**
+         * @brief Converts to string representation
+         * @param enter Add newline if true
+         * @return String representation
+         */
+        [[nodiscard]] std::string toString(bool enter) const override;
+
+        /**
+         * @brief Frees all nodes
+         * @note No other thread may access the set during destruction
+         */
+        ~concurrentJSet() override;
+    };
+}
+
+template<typename TYPE, typename Compare, typename ALLOC>
+original::concurrentJSet<TYPE, Compare, ALLOC>::concurrentJSet(Compare compare, ALLOC alloc)
+    : skipListType(std::move(compare)),
+      container<TYPE, ALLOC>(std::move(alloc)) {}
+
+template<typename TYPE, typename Compare, typename ALLOC>
+original::u_integer original::concurrentJSet<TYPE, Compare, ALLOC>::size() const {
+    return this->size_.load();
+}
+
+template<typename TYPE, typename Compare, typename ALLOC>
+bool original::concurrentJSet<TYPE, Compare, ALLOC>::contains(const TYPE& e) const {
+    epochReclaimer::guard guard{this->reclaimer_};
+    return this->findNode(e);
+}
+
+template<typename TYPE, typename Compare, typename ALLOC>
+bool original::concurrentJSet<TYPE, Compare, ALLOC>::add(const TYPE& e) {
+    return this->insert(e, true);
+}
+
+template<typename TYPE, typename Compare, typename ALLOC>
+bool original::concurrentJSet<TYPE, Compare, ALLOC>::remove(const TYPE& e) {
+    return this->erase(e);
+}
+
+template<typename TYPE, typename Compare, typename ALLOC>
+template<typename Callback>
+void original::concurrentJSet<TYPE, Compare, ALLOC>::forEach(Callback&& c) const {
+    epochReclaimer::guard guard{this->reclaimer_};
+    this->traverse(nullptr, nullptr, [&](auto node) {
+        c(node->getKey());
+    });
+}
+
+template<typename TYPE, typename Compare, typename ALLOC>
+template<typename Callback>
+void original::concurrentJSet<TYPE, Compare, ALLOC>::forEachInRange(
+    const TYPE& low, const TYPE& high, Callback&& c) const {
+    epochReclaimer::guard guard{this->reclaimer_};
+    if (auto from = this->lowerBound(low)) {
+        this->traverse(from, &high, [&](auto node) {
+            c(node->getKey());
+        });
+    }
+}
+
+template<typename TYPE, typename Compare, typename ALLOC>
+std::string original::concurrentJSet<TYPE, Compare, ALLOC>::className() const {
+    return "concurrentJSet";
+}
+
+template<typename TYPE, typename Compare, typename ALLOC>
+std::string original::concurrentJSet<TYPE, Compare, ALLOC>::toString(const bool enter) const {
+    std::stringstream ss;
+    ss << this->className();
+    ss << "(";
+    bool first = true;
+    this->forEach([&](const TYPE& e) {
+        if (!first){
+            ss << ", ";
+        }
+        ss << printable::formatString(e);
+        first = false;
+    });
+    ss << ")";
+    if (enter)
+        ss << "\n";
+    return ss.str();
+}
+
+template<typename TYPE, typename Compare, typename ALLOC>
+original::concurrentJSet<TYPE, Compare, ALLOC>::~concurrentJSet() = default;
+
+#endif //ORIGINAL_CONCURRENT_SETS_H
@@ -0,0 +1,219 @@
+#ifndef ORIGINAL_EPOCH_RECLAIMER_H
+#define ORIGINAL_EPOCH_RECLAIMER_H
+
+#include "atomic.h"
+#include "config.h"
+#include <functional>
+
+
+/**
+ * @file epochReclaimer.h
+ * @brief Epoch-based safe memory reclamation for lock-free data structures
+ * @details Lock-free containers unlink nodes that other threads may still be reading.
+ * Such nodes cannot be freed right away; they are handed to an epochReclaimer, which
+ * frees them only after every operation that could have observed them has finished.
+ *
+ * Protocol:
+ * - Every operation on the protected structure holds an epochReclaimer::guard while it
+ *   dereferences shared nodes
+ * - A node is passed to retire() after it has been unlinked, so no new operation can reach it
+ * - A retired node is freed once the global epoch has advanced twice past its retirement
+ *
+ * The epoch only advances when no guard pinned in the previous epoch is still alive, so
+ * at most three epochs (and three pin counters) are ever relevant.
+ */
+
+namespace original {
+
+    /**
+     * @class epochReclaimer
+     * @brief Epoch-based reclamation domain for nodes of a lock-free structure
+     * @details Uses a global epoch counter plus one active-guard counter for each of the
+     * three live epochs, so threads do not have to register with the domain.
+     * Retired nodes are kept in an intrusive lock-free stack and stamped with the epoch
+     * at retirement; every RECLAIM_THRESHOLD retirements one thread tries to advance the
+     * epoch and frees the nodes that became unreachable.
+     *
+     * Progress:
+     * - Pinning, unpinning and retiring are lock-free
+     * - Reclamation is blocking in the memory sense: a thread stalled inside a guard delays
+     *   the freeing of nodes retired after it pinned, but never blocks other operations
+     *
+     * @note Not copyable or movable; the owning container keeps it as a member.
+     */
+    class epochReclaimer final {
+    public:
+        /**
+         * @class retirable
+         * @brief Intrusive base for nodes that may be retired to an epochReclaimer
+         * @details Carries the retired-list link and the retirement epoch, so retiring
+         * a node needs no allocation.
+         */
+        class retirable {
+            friend class epochReclaimer;
+
+            retirable* retired_next_ = nullptr;   ///< Next node in the retired list
+            ul_integer retired_epoch_ = 0;        ///< Global epoch when the node was retired
+        };
+
+        /**
+         * @class guard
+         * @brief RAII pin on the current epoch
+         * @details While a guard is alive, no node retired after its construction is freed.
+         */
+        class guard final {
+            const epochReclaimer& domain_;  ///< Domain this guard pins
+            u_integer slot_;                ///< Pinned epoch slot (epoch % 3)
+
+        public:
+            /**
+             * @brief Pins the current epoch of domain
+             * @param domain Reclamation domain to pin
+             */
+            explicit guard(const epochReclaimer& domain);
+
+            guard(const guard&) = delete;               ///< Disable copy constructor
+            guard& operator=(const guard&) = delete;    ///< Disable copy assignment
+
+            /**
+             * @brief Releases the pin
+             */
+            ~guard();
+        };
+
+        /**
+         * @brief Number of retirements between two reclamation attempts
+         */
+        static constexpr u_integer RECLAIM_THRESHOLD = 64;
+
+        /**
+         * @brief Constructs an empty reclamation domain
+         * @param deleter Callable that destroys and deallocates a retired node
+         */
+        explicit epochReclaimer(std::function<void(retirable*)> deleter);
+
+        epochReclaimer(const epochReclaimer&) = delete;               ///< Disable copy constructor
+        epochReclaimer& operator=(const epochReclaimer&) = delete;    ///< Disable copy assignment
+
+        /**
+         * @brief Hands an unlinked node over for deferred deletion
+         * @param node Node that is no longer reachable from the structure
+         * @note The caller must hold a guard
+         */
+        void retire(retirable* node);
+
+        /**
+         * @brief Tries to advance the epoch and frees nodes that are no longer observable
+         * @return Number of freed nodes
+         */
+        u_integer reclaim();
+
+        /**
+         * @brief Gets the current global epoch
+         * @return Current epoch
+         */
+        [[nodiscard]] ul_integer epoch() const noexcept;
+
+        /**
+         * @brief Frees every remaining retired node
+         * @note No guard may be alive during destruction
+         */
+        ~epochReclaimer();
+
+    private:
+        atomic<ul_integer> epoch_{makeAtomic<ul_integer>(0)};              ///< Global epoch
+        byte padding_epoch_[CACHE_LINE_SIZE]{};                             ///< Keeps epoch_ off the counters' line
+        mutable atomic<u_integer> active_[3]{makeAtomic<u_integer>(0),
+                                             makeAtomic<u_integer>(0),
+                                             makeAtomic<u_integer>(0)};     ///< Live guards per epoch slot
+        byte padding_active_[CACHE_LINE_SIZE]{};                            ///< Keeps counters off the list's line
+        atomic<retirable*> retired_{makeAtomic<retirable*>(nullptr)};       ///< Retired node stack
+        atomic<u_integer> retired_cnt_{makeAtomic<u_integer>(0)};           ///< Retirements since construction
+        std::function<void(retirable*)> deleter_;                           ///< Frees a retired node
+
+        /**
+         * @brief Pushes a chain of retired nodes onto the retired stack
+         * @param first First node of the chain
+         * @param last Last node of the chain
+         */
+        void pushRetired(retirable* first, retirable* last);
+    };
+}
+
+inline original::epochReclaimer::guard::guard(const epochReclaimer& domain)
+    : domain_(domain), slot_(0) {
+    while (true) {
+        const ul_integer e = this->domain_.epoch_.load();
+        this->slot_ = static_cast<u_integer>(e % 3);
+        this->domain_.active_[this->slot_] += 1;
+        if (this->domain_.epoch_.load() == e)
+            return;
+        this->domain_.active_[this->slot_] -= 1;
+    }
+}
+
+inline original::epochReclaimer::guard::~guard() {
+    this->domain_.active_[this->slot_] -= 1;
+}
+
+inline original::epochReclaimer::epochReclaimer(std::function<void(retirable*)> deleter)
+    : deleter_(std::move(deleter)) {}
+
+inline void original::epochReclaimer::pushRetired(retirable* first, retirable* last) {
+    retirable* head = this->retired_.load();
+    do {
+        last->retired_next_ = head;
+    } while (!this->retired_.exchangeCmp(head, first));
+}
+
+inline void original::epochReclaimer::retire(retirable* node) {
+    node->retired_epoch_ = this->epoch_.load();
+    this->pushRetired(node, node);
+    this->retired_cnt_ += 1;
+    if (this->retired_cnt_.load(memOrder::RELAXED) % RECLAIM_THRESHOLD == 0) {
+        this->reclaim();
+    }
+}
+
+inline original::u_integer original::epochReclaimer::reclaim() {
+    ul_integer e = this->epoch_.load();
+    if (this->active_[(e + 2) % 3].load() == 0 && this->epoch_.exchangeCmp(e, e + 1)) {
+        e += 1;
+    }
+
+    retirable* cur = this->retired_.exchange(nullptr);
+    retirable* keep_first = nullptr;
+    retirable* keep_last = nullptr;
+    u_integer freed = 0;
+    while (cur) {
+        retirable* next = cur->retired_next_;
+        if (cur->retired_epoch_ + 2 <= e) {
+            this->deleter_(cur);
+            freed += 1;
+        } else {
+            cur->retired_next_ = keep_first;
+            keep_first = cur;
+            if (!keep_last)
+                keep_last = cur;
+        }
+        cur = next;
+    }
+    if (keep_first)
+        this->pushRetired(keep_first, keep_last);
+    return freed;
+}
+
+inline original::ul_integer original::epochReclaimer::epoch() const noexcept {
+    return this->epoch_.load();
+}
+
+inline original::epochReclaimer::~epochReclaimer() {
+    retirable* cur = this->retired_.exchange(nullptr);
+    while (cur) {
+        retirable* next = cur->retired_next_;
+        this->deleter_(cur);
+        cur = next;
+    }
+}
+
+#endif //ORIGINAL_EPOCH_RECLAIMER_H
@@ -1,5 +1,6 @@
 #ifndef ORIGINAL_GENERATORS_H
 #define ORIGINAL_GENERATORS_H
+#include "cancellation.h"
 #include "coroutines.h"
 #include "couple.h"
 #include "sets.h"
@@ -331,6 +332,27 @@ namespace original {
     template<typename TYPE>
     coroutine::generator<TYPE> skip(coroutine::generator<TYPE> gen, u_integer n);
 
+    /**
+     * @brief Stops a generator once a cancellation token is cancelled.
+     * @tparam TYPE The element type.
+     * @param gen The source generator.
+     * @param token The token to observe.
+     * @return A generator yielding elements until the token is cancelled.
+     * @details The token is checked before each element is pulled from the source,
+     *          so no further upstream work is done once it is cancelled (or its deadline
+     *          has passed).
+     *
+     * Example:
+     * @code
+     * cancellationSource source{time::duration{50, time::MILLISECOND}};
+     * for (auto val : cancellable(expensiveResults(), source.token())) {
+     *     // Yields results until 50 ms have passed or source.cancel() is called
+     * }
+     * @endcode
+     */
+    template<typename TYPE>
+    coroutine::generator<TYPE> cancellable(coroutine::generator<TYPE> gen, cancellationToken token);
+
     /**
      * @brief Finds the position of the first element satisfying a predicate.
      * @tparam TYPE The element type.
@@ -430,6 +452,9 @@ namespace original {
         template<typename>
         friend auto skip(u_integer n);
 
+        template<typename>
+        friend auto cancellable(cancellationToken token);
+
         template<typename F>
         friend auto zipWith(coroutine::generator<F> gen2);
 
@@ -542,6 +567,16 @@ namespace original {
     template<typename = void>
     auto skip(u_integer n);
 
+    /**
+     * @brief Creates a cancellable pipe operation.
+     * @param token The token to observe.
+     * @return A genPipe that stops the pipeline once the token is cancelled.
+     * @details Factory function for creating cancellable operations that can be
+     *          used with the pipe operator.
+     */
+    template<typename = void>
+    auto cancellable(cancellationToken token);
+
     /**
      * @brief Creates a join pipe operation.
      * @tparam T The target element type.
@@ -845,6 +880,21 @@ original::skip(coroutine::generator<TYPE> gen, const u_integer n)
     }
 }
 
+template <typename TYPE>
+original::coroutine::generator<TYPE>
+original::cancellable(coroutine::generator<TYPE> gen, const cancellationToken token)
+{
+    while (!token.cancelled())
+    {
+        auto elem = gen.next();
+        if (!elem)
+        {
+            co_return;
+        }
+        co_yield *elem;
+    }
+}
+
 template <typename TYPE, typename Callback>
 original::u_integer original::position(coroutine::generator<TYPE> gen, Callback&& c)
 {
@@ -936,6 +986,14 @@ auto original::skip(u_integer n)
     }};
 }
 
+template<typename>
+auto original::cancellable(cancellationToken token)
+{
+    return genPipe{[token = std::move(token)]<typename TYPE>(coroutine::generator<TYPE> gen) mutable {
+        return cancellable(std::move(gen), token);
+    }};
+}
+
 template <typename T, typename U>
 auto original::join(coroutine::generator<U> gen2)
 {
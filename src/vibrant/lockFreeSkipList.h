@@ -0,0 +1,593 @@
+#ifndef ORIGINAL_LOCK_FREE_SKIP_LIST_H
+#define ORIGINAL_LOCK_FREE_SKIP_LIST_H
+
+#include "allocator.h"
+#include "atomic.h"
+#include "comparator.h"
+#include "config.h"
+#include "couple.h"
+#include "epochReclaimer.h"
+#include <bit>
+#include <random>
+
+
+/**
+ * @file lockFreeSkipList.h
+ * @brief Lock-free skip list shared by concurrentJMap and concurrentJSet
+ * @details The concurrent counterpart of skipList.h: an ordered set of key-value nodes that
+ * many threads can search and modify without any lock, following the lock-free skip list of
+ * Fraser and of Herlihy and Shavit:
+ * - Every level is a Harris/Michael list; the lowest bit of a successor pointer marks the
+ *   owning node as logically deleted at that level
+ * - Level 0 is authoritative: a node is in the set exactly while it is linked at level 0
+ *   with an unmarked level-0 successor; upper levels are shortcuts
+ * - Removal marks a node's tower top-down and level 0 last, so a node that is unmarked
+ *   at any level is still present
+ * - Unlinked nodes are retired to an epochReclaimer
+ */
+
+namespace original {
+
+    /**
+     * @class lockFreeSkipList
+     * @tparam K_TYPE Key type (must be comparable)
+     * @tparam V_TYPE Value type (must be copyable)
+     * @tparam ALLOC Allocator type (default: allocator<K_TYPE>)
+     * @tparam Compare Comparison function type (default: increaseComparator<K_TYPE>)
+     * @brief Lock-free skip list storage for the concurrent ordered containers
+     * @details Keys are unique under the equivalence induced by Compare.
+     *
+     * Reclamation: a node may only be freed once it is unlinked at every level. Its tower
+     * can still be growing while it is being removed, so each node has two owners, the
+     * inserting thread (until its tower is complete or abandoned) and the removing thread
+     * (until its cleanup search has unlinked it). The last owner to let go retires the node.
+     *
+     * Progress Guarantees:
+     * - insert and erase are lock-free
+     * - findNode and the traversals never restart, and never write the list itself: their only
+     *   shared writes are the increment and decrement of the reclaimer's epoch counters
+     *   (epochReclaimer::guard), which all readers share on one cache line
+     *
+     * @note Not copyable or movable; the owning container keeps it as a base.
+     */
+    template<typename K_TYPE,
+             typename V_TYPE,
+             typename ALLOC = allocator<K_TYPE>,
+             typename Compare = increaseComparator<K_TYPE>>
+    class lockFreeSkipList {
+    protected:
+        /**
+         * @brief Maximum number of levels of a node
+         */
+        static constexpr u_integer MAX_LEVELS = 32;
+
+        /**
+         * @class skipNode
+         * @brief Node of the lock-free skip list
+         * @details Like skipList::skipListNode, a node and its tower of atomic successor
+         * pointers are one allocation; the tower trails the node object.
+         * Nodes must therefore be created through lockFreeSkipList::createNode().
+         */
+        class skipNode : public epochReclaimer::retirable {
+            const couple<const K_TYPE, V_TYPE> data_;   ///< Stored pair
+            const u_integer levels_;                    ///< Height of the tower
+            atomic<u_integer> owners_;                  ///< Threads that still may link or unlink the node
+
+        public:
+            friend class lockFreeSkipList;
+
+            /**
+             * @brief Constructs a node in storage of towerUnits(levels) units
+             * @param key Key to store
+             * @param value Value to store
+             * @param levels Height of the tower
+             * @details All successors start as nullptr.
+             */
+            skipNode(const K_TYPE& key, const V_TYPE& value, u_integer levels);
+
+            skipNode(const skipNode&) = delete;             ///< Nodes are tied to their storage
+            skipNode& operator=(const skipNode&) = delete;  ///< Nodes are tied to their storage
+
+            /**
+             * @brief Number of nodeUnit blocks holding a node and its tower
+             * @param levels Height of the tower
+             * @return Units to allocate through the node allocator
+             */
+            static constexpr u_integer towerUnits(u_integer levels);
+
+            /**
+             * @brief Gets the successor pointer of a level
+             * @param level Level (0-based, below levels_)
+             * @return Marked successor pointer
+             */
+            atomic<skipNode*>& next(u_integer level);
+
+            /**
+             * @brief Gets key-value pair
+             * @return Const reference to key-value pair
+             */
+            const couple<const K_TYPE, V_TYPE>& getVal() const;
+
+            /**
+             * @brief Gets key
+             * @return Const reference to key
+             */
+            const K_TYPE& getKey() const;
+
+            /**
+             * @brief Gets value
+             * @return Const reference to value
+             */
+            const V_TYPE& getValue() const;
+        };
+
+        /**
+         * @struct nodeUnit
+         * @brief Allocation granule of a node and its tower, one alignment step of skipNode
+         */
+        struct alignas(skipNode) nodeUnit {
+            byte storage[alignof(skipNode)];
+        };
+
+        using link = atomic<skipNode*>;                                             ///< Successor pointer
+        using rebind_alloc_node = ALLOC::template rebind_alloc<nodeUnit>;           ///< Node storage allocator
+        using rebind_alloc_link = ALLOC::template rebind_alloc<link>;               ///< Head tower allocator
+
+        link* head_;                                                    ///< Head tower, one link per level
+        atomic<u_integer> levels_{makeAtomic<u_integer>(1)};            ///< Highest tower in use (search hint)
+        atomic<u_integer> size_{makeAtomic<u_integer>(0)};              ///< Element count
+        Compare compare_;                                               ///< Comparison function
+        mutable rebind_alloc_node node_alloc_{};                        ///< Allocator for nodes
+        mutable rebind_alloc_link link_alloc_{};                        ///< Allocator for the head tower
+        mutable epochReclaimer reclaimer_;                              ///< Reclamation of unlinked nodes
+
+        /**
+         * @brief Checks the deletion mark of a successor pointer
+         */
+        static bool isMarked(skipNode* p) noexcept;
+
+        /**
+         * @brief Sets the deletion mark of a successor pointer
+         */
+        static skipNode* marked(skipNode* p) noexcept;
+
+        /**
+         * @brief Clears the deletion mark of a successor pointer
+         */
+        static skipNode* unmarked(skipNode* p) noexcept;
+
+        /**
+         * @brief Draws a tower height with P(levels > l) = 2^-l
+         * @return Height in [1, MAX_LEVELS]
+         * @details Uses a thread-local xorshift64* generator, so concurrent inserts share no state.
+         */
+        static u_integer getRandomLevels();
+
+        /**
+         * @brief Gets the successor pointer of a level of a predecessor
+         * @param pred Predecessor node, nullptr for the head
+         * @param level Level (0-based)
+         * @return Successor pointer
+         */
+        link& linkOf(skipNode* pred, u_integer level) const;
+
+        /**
+         * @brief Checks whether a key is ordered before a node's key
+         * @param key Key to compare
+         * @param node Node to compare with (not nullptr)
+         * @return true if key < node key
+         */
+        bool before(const K_TYPE& key, skipNode* node) const;
+
+        /**
+         * @brief Checks whether a node's key is ordered before a key
+         * @param node Node to compare (not nullptr)
+         * @param key Key to compare with
+         * @return true if node key < key
+         */
+        bool after(const K_TYPE& key, skipNode* node) const;
+
+        /**
+         * @brief Allocates and constructs a node
+         * @param key Key to store
+         * @param value Value to store
+         * @param levels Height of the tower
+         * @return Node with all successors nullptr
+         */
+        skipNode* createNode(const K_TYPE& key, const V_TYPE& value, u_integer levels) const;
+
+        /**
+         * @brief Destroys and deallocates a node
+         * @param node Node to free
+         */
+        void destroyNode(skipNode* node) const;
+
+        /**
+         * @brief Drops one owner of a node, retiring the node when it was the last one
+         * @param node Node released by the calling thread
+         * @note The caller must hold an epochReclaimer::guard
+         */
+        void release(skipNode* node);
+
+        /**
+         * @brief Locates the position of a key on every level, unlinking marked nodes on the way
+         * @param key Key to search
+         * @param preds Set to the last node ordered before key on each level below top (nullptr: head)
+         * @param succs Set to the first node not ordered before key on each level below top
+         * @param top Number of levels to record (at least 1)
+         * @return true if succs[0] holds key
+         * @note The caller must hold an epochReclaimer::guard
+         */
+        bool find(const K_TYPE& key, skipNode** preds, skipNode** succs, u_integer top);
+
+        /**
+         * @brief Finds the node of a key without modifying the list
+         * @param key Key to look up
+         * @return Present node holding key, or nullptr
+         * @note The caller must hold an epochReclaimer::guard
+         */
+        skipNode* findNode(const K_TYPE& key) const;
+
+        /**
+         * @brief Finds the first present node whose key is not ordered before a key
+         * @param key Lower bound
+         * @return First node with key >= key on level 0, or nullptr
+         * @note The caller must hold an epochReclaimer::guard
+         */
+        skipNode* lowerBound(const K_TYPE& key) const;
+
+        /**
+         * @brief Inserts a key-value pair unless the key is present
+         * @param key Key to insert
+         * @param value Value to associate
+         * @return true if inserted
+         */
+        bool insert(const K_TYPE& key, const V_TYPE& value);
+
+        /**
+         * @brief Removes the node of a key
+         * @param key Key to remove
+         * @return true if this call removed the key
+         */
+        bool erase(const K_TYPE& key);
+
+        /**
+         * @brief Visits present nodes in key order
+         * @tparam Callback Callable invocable with (skipNode*), returning void
+         * @param from First node to consider, nullptr for the smallest key
+         * @param high Exclusive upper bound, nullptr for no bound
+         * @param c Visitor
+         * @details Walks level 0 once. The traversal is weakly consistent: nodes present for
+         * the whole call are visited exactly once and in order, concurrently added or removed
+         * nodes may or may not be visited.
+         * @note The caller must hold an epochReclaimer::guard
+         */
+        template<typename Callback>
+        void traverse(skipNode* from, const K_TYPE* high, Callback&& c) const;
+
+        /**
+         * @brief Constructs an empty list
+         * @param compare Comparison function to use
+         */
+        explicit lockFreeSkipList(Compare compare = Compare{});
+
+        /**
+         * @brief Frees all nodes and the head tower
+         * @note No other thread may access the list during destruction
+         */
+        ~lockFreeSkipList();
+
+    public:
+        lockFreeSkipList(const lockFreeSkipList&) = delete;             ///< Disable copy constructor
+        lockFreeSkipList& operator=(const lockFreeSkipList&) = delete;  ///< Disable copy assignment
+        lockFreeSkipList(lockFreeSkipList&&) = delete;                  ///< Disable move constructor
+        lockFreeSkipList& operator=(lockFreeSkipList&&) = delete;       ///< Disable move assignment
+    };
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipNode::skipNode(
+    const K_TYPE& key, const V_TYPE& value, const u_integer levels)
+    : data_(key, value), levels_(levels), owners_(makeAtomic<u_integer>(2)) {
+    auto tower = reinterpret_cast<link*>(this + 1);
+    for (u_integer i = 0; i < levels; ++i) {
+        ::new (&tower[i]) link(makeAtomic<skipNode*>(nullptr));
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+constexpr original::u_integer
+original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipNode::towerUnits(const u_integer levels) {
+    return (sizeof(skipNode) + levels * sizeof(link) + sizeof(nodeUnit) - 1) / sizeof(nodeUnit);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::link&
+original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipNode::next(const u_integer level) {
+    return reinterpret_cast<link*>(this + 1)[level];
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+const original::couple<const K_TYPE, V_TYPE>&
+original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipNode::getVal() const {
+    return this->data_;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+const K_TYPE& original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipNode::getKey() const {
+    return this->data_.first();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+const V_TYPE& original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipNode::getValue() const {
+    return this->data_.second();
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+bool original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::isMarked(skipNode* p) noexcept {
+    return reinterpret_cast<ul_integer>(p) & 1;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipNode*
+original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::marked(skipNode* p) noexcept {
+    return reinterpret_cast<skipNode*>(reinterpret_cast<ul_integer>(p) | 1);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipNode*
+original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::unmarked(skipNode* p) noexcept {
+    return reinterpret_cast<skipNode*>(reinterpret_cast<ul_integer>(p) & ~static_cast<ul_integer>(1));
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+original::u_integer original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::getRandomLevels() {
+    thread_local ul_integer seed = static_cast<ul_integer>(std::random_device{}()) << 1 | 1;
+    seed ^= seed >> 12;
+    seed ^= seed << 25;
+    seed ^= seed >> 27;
+    const ul_integer word = seed * 0x2545F4914F6CDD1DULL;
+    const auto levels = static_cast<u_integer>(1 + std::countr_zero(word));
+    return levels < MAX_LEVELS ? levels : MAX_LEVELS;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::link&
+original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::linkOf(skipNode* pred, const u_integer level) const {
+    return pred ? pred->next(level) : this->head_[level];
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+bool original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::before(const K_TYPE& key, skipNode* node) const {
+    return this->compare_(key, node->getKey());
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+bool original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::after(const K_TYPE& key, skipNode* node) const {
+    return this->compare_(node->getKey(), key);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipNode*
+original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::createNode(
+    const K_TYPE& key, const V_TYPE& value, const u_integer levels) const {
+    auto units = this->node_alloc_.allocate(skipNode::towerUnits(levels));
+    auto node = reinterpret_cast<skipNode*>(units);
+    try {
+        this->node_alloc_.construct(node, key, value, levels);
+    } catch (...) {
+        this->node_alloc_.deallocate(units, skipNode::towerUnits(levels));
+        throw;
+    }
+    return node;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::destroyNode(skipNode* node) const {
+    const u_integer units = skipNode::towerUnits(node->levels_);
+    this->node_alloc_.destroy(node);
+    this->node_alloc_.deallocate(reinterpret_cast<nodeUnit*>(node), units);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::release(skipNode* node) {
+    u_integer owners = node->owners_.load();
+    while (!node->owners_.exchangeCmp(owners, owners - 1)) {}
+    if (owners == 1) {
+        this->reclaimer_.retire(node);
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+bool original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::find(
+    const K_TYPE& key, skipNode** preds, skipNode** succs, const u_integer top) {
+    const u_integer hint = this->levels_.load();
+    const u_integer start = hint > top ? hint : top;
+    retry:
+    skipNode* pred = nullptr;
+    for (u_integer level = start; level-- > 0; ) {
+        skipNode* cur = unmarked(this->linkOf(pred, level).load());
+        while (cur) {
+            skipNode* next = cur->next(level).load();
+            if (isMarked(next)) {
+                skipNode* expected = cur;
+                if (!this->linkOf(pred, level).exchangeCmp(expected, unmarked(next)))
+                    goto retry;
+                cur = unmarked(next);
+                continue;
+            }
+            if (!this->after(key, cur))
+                break;
+            pred = cur;
+            cur = next;
+        }
+        if (level < top) {
+            preds[level] = pred;
+            succs[level] = cur;
+        }
+    }
+    return succs[0] && !this->before(key, succs[0]);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipNode*
+original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::findNode(const K_TYPE& key) const {
+    skipNode* pred = nullptr;
+    for (u_integer level = this->levels_.load(); level-- > 0; ) {
+        skipNode* cur = unmarked(this->linkOf(pred, level).load());
+        while (cur) {
+            skipNode* next = cur->next(level).load();
+            if (isMarked(next)) {
+                cur = unmarked(next);
+                continue;
+            }
+            if (this->after(key, cur)) {
+                pred = cur;
+                cur = next;
+                continue;
+            }
+            if (!this->before(key, cur))
+                return cur;
+            break;
+        }
+    }
+    return nullptr;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+typename original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::skipNode*
+original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::lowerBound(const K_TYPE& key) const {
+    skipNode* pred = nullptr;
+    skipNode* cur = nullptr;
+    for (u_integer level = this->levels_.load(); level-- > 0; ) {
+        cur = unmarked(this->linkOf(pred, level).load());
+        while (cur) {
+            skipNode* next = cur->next(level).load();
+            if (isMarked(next)) {
+                cur = unmarked(next);
+                continue;
+            }
+            if (!this->after(key, cur))
+                break;
+            pred = cur;
+            cur = next;
+        }
+    }
+    return cur;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+bool original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::insert(const K_TYPE& key, const V_TYPE& value) {
+    skipNode* preds[MAX_LEVELS];
+    skipNode* succs[MAX_LEVELS];
+    const u_integer top = getRandomLevels();
+    skipNode* node = nullptr;
+
+    epochReclaimer::guard guard{this->reclaimer_};
+    while (true) {
+        if (this->find(key, preds, succs, top)) {
+            if (node)
+                this->destroyNode(node);
+            return false;
+        }
+        if (!node)
+            node = this->createNode(key, value, top);
+        for (u_integer level = 0; level < top; ++level) {
+            node->next(level).store(succs[level]);
+        }
+        if (skipNode* expected = succs[0]; this->linkOf(preds[0], 0).exchangeCmp(expected, node))
+            break;
+    }
+    this->size_ += 1;
+
+    u_integer hint = this->levels_.load();
+    while (hint < top && !this->levels_.exchangeCmp(hint, top)) {}
+
+    for (u_integer level = 1; level < top; ++level) {
+        while (true) {
+            if (skipNode* expected = succs[level]; this->linkOf(preds[level], level).exchangeCmp(expected, node))
+                break;
+            this->find(key, preds, succs, top);
+            if (succs[0] != node)
+                goto built;
+            skipNode* cur = node->next(level).load();
+            if (isMarked(cur))
+                goto built;
+            if (cur != succs[level] && !node->next(level).exchangeCmp(cur, succs[level]))
+                goto built;
+        }
+    }
+    built:
+    if (isMarked(node->next(0).load())) {
+        this->find(key, preds, succs, top);
+    }
+    this->release(node);
+    return true;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+bool original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::erase(const K_TYPE& key) {
+    skipNode* preds[MAX_LEVELS];
+    skipNode* succs[MAX_LEVELS];
+
+    epochReclaimer::guard guard{this->reclaimer_};
+    if (!this->find(key, preds, succs, 1))
+        return false;
+
+    skipNode* victim = succs[0];
+    for (u_integer level = victim->levels_; level-- > 1; ) {
+        skipNode* next = victim->next(level).load();
+        while (!isMarked(next) && !victim->next(level).exchangeCmp(next, marked(next))) {}
+    }
+
+    skipNode* next = victim->next(0).load();
+    while (true) {
+        if (isMarked(next))
+            return false;
+        if (victim->next(0).exchangeCmp(next, marked(next)))
+            break;
+    }
+    this->size_ -= 1;
+
+    this->find(key, preds, succs, victim->levels_);
+    this->release(victim);
+    return true;
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+template<typename Callback>
+void original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::traverse(
+    skipNode* from, const K_TYPE* high, Callback&& c) const {
+    for (skipNode* cur = from ? from : unmarked(this->head_[0].load()); cur; ) {
+        if (high && !this->after(*high, cur))
+            return;
+        skipNode* next = cur->next(0).load();
+        if (!isMarked(next))
+            c(cur);
+        cur = unmarked(next);
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::lockFreeSkipList(Compare compare)
+    : head_(nullptr), compare_(std::move(compare)),
+      reclaimer_([this](epochReclaimer::retirable* node) {
+          this->destroyNode(static_cast<skipNode*>(node));
+      }) {
+    this->head_ = this->link_alloc_.allocate(MAX_LEVELS);
+    for (u_integer i = 0; i < MAX_LEVELS; ++i) {
+        ::new (&this->head_[i]) link(makeAtomic<skipNode*>(nullptr));
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+original::lockFreeSkipList<K_TYPE, V_TYPE, ALLOC, Compare>::~lockFreeSkipList() {
+    for (skipNode* cur = unmarked(this->head_[0].load()); cur; ) {
+        skipNode* next = unmarked(cur->next(0).load());
+        this->destroyNode(cur);
+        cur = next;
+    }
+    this->link_alloc_.deallocate(this->head_, MAX_LEVELS);
+}
+
+#endif //ORIGINAL_LOCK_FREE_SKIP_LIST_H
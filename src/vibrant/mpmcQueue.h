@@ -0,0 +1,375 @@
+#ifndef ORIGINAL_MPMC_QUEUE_H
+#define ORIGINAL_MPMC_QUEUE_H
+
+#include "allocator.h"
+#include "atomic.h"
+#include "config.h"
+#include "error.h"
+#include "optional.h"
+#include "thread.h"
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+
+/**
+ * @file mpmcQueue.h
+ * @brief Bounded lock-free queue for many producer and many consumer threads
+ * @details Dmitry Vyukov's bounded MPMC queue: an array of cells, each carrying a sequence
+ * number that tells which lap of the array the cell is ready for.
+ * - A producer claims the cell at the enqueue position with one CAS on that position, fills
+ *   it and then publishes it by advancing the cell's sequence
+ * - A consumer does the same with the dequeue position and hands the cell back to the
+ *   producers of the next lap
+ * - Producers only contend with producers and consumers with consumers; the two positions
+ *   live on separate cache lines
+ *
+ * Compared with queue guarded by pMutex, no thread ever waits for another thread that was
+ * descheduled while holding a lock, except for the short window between claiming a cell and
+ * publishing it.
+ * @see spscRing.h for the single-producer/single-consumer case, which needs no CAS at all
+ */
+
+namespace original {
+
+    /**
+     * @class mpmcQueue
+     * @tparam TYPE Element type (may be move-only, must be nothrow move constructible)
+     * @tparam ALLOC Allocator type, rebound to the cell type (default: allocator<TYPE>)
+     * @brief Fixed-capacity multi-producer/multi-consumer FIFO queue
+     * @details Capacity must be a power of two. The enqueue and dequeue positions are
+     * free-running u_integer counters; cell (pos & mask) is ready for the producer of pos
+     * when its sequence equals pos and for the consumer of pos when it equals pos + 1.
+     * Sequence comparisons are done on the signed difference, so the counters may wrap.
+     *
+     * Progress Guarantees:
+     * - tryPush and tryPop are lock-free as long as no thread stalls between claiming a cell
+     *   and publishing it; such a stall makes the cell's next user report full or empty
+     * - push and pop poll their try* counterpart with thread::backOff until they succeed
+     *
+     * Closing: close is meant to be called once every producer has finished; after that,
+     * pop returns an empty alternative as soon as the queue is drained.
+     *
+     * @note Not copyable or movable, since all threads hold references to it.
+     */
+    template<typename TYPE, typename ALLOC = allocator<TYPE>>
+    class mpmcQueue final {
+        static_assert(std::is_nothrow_move_constructible_v<TYPE>,
+                      "mpmcQueue elements are moved into claimed cells and must not throw on move");
+
+        /**
+         * @struct cell
+         * @brief One slot of the ring: a sequence number and raw storage for an element
+         */
+        struct cell {
+            atomic<u_integer> sequence_{makeAtomic<u_integer>(0)};    ///< Lap stamp, see class details
+            alignas(TYPE) byte storage_[sizeof(TYPE)];                  ///< Element storage
+
+            /**
+             * @brief The element stored in this cell
+             * @return Pointer into storage_
+             */
+            TYPE* element();
+        };
+
+        using rebind_alloc_cell = ALLOC::template rebind_alloc<cell>;      ///< Cell array allocator
+        using difference = std::make_signed_t<u_integer>;                   ///< Signed sequence distance
+
+        rebind_alloc_cell cell_alloc_{};                                    ///< Allocator of the cell array
+        cell* cells_;                                                       ///< Cell array
+        u_integer capacity_;                                                ///< Number of cells, a power of two
+        u_integer mask_;                                                    ///< capacity_ - 1
+        byte padding_shared_[CACHE_LINE_SIZE]{};                            ///< Keeps read-only fields off enqueue_pos_
+        atomic<u_integer> enqueue_pos_{makeAtomic<u_integer>(0)};           ///< Next position to fill
+        byte padding_enqueue_[CACHE_LINE_SIZE]{};                           ///< Keeps producers off the consumer line
+        atomic<u_integer> dequeue_pos_{makeAtomic<u_integer>(0)};           ///< Next position to empty
+        byte padding_dequeue_[CACHE_LINE_SIZE]{};                           ///< Keeps consumers off the close flag
+        atomic<bool> closed_{makeAtomic<bool>(false)};                      ///< Set once all producers are done
+
+        /**
+         * @brief Claims the cell of the next enqueue position
+         * @return The claimed cell, or nullptr if the queue is full
+         */
+        cell* claimEnqueue();
+
+        /**
+         * @brief Claims the cell of the next dequeue position
+         * @param pos Set to the claimed position
+         * @return The claimed cell, or nullptr if the queue is empty
+         */
+        cell* claimDequeue(u_integer& pos);
+
+    public:
+        /**
+         * @brief Constructs an empty queue
+         * @param capacity Number of cells, a non-zero power of two below 2^31
+         * @throw valueError If capacity is zero, not a power of two or too large
+         */
+        explicit mpmcQueue(u_integer capacity);
+
+        mpmcQueue(const mpmcQueue&) = delete;               ///< Disable copy constructor
+        mpmcQueue& operator=(const mpmcQueue&) = delete;    ///< Disable copy assignment
+
+        /**
+         * @brief Constructs an element at the back of the queue, if there is room
+         * @tparam Args Constructor argument types
+         * @param args Arguments forwarded to the TYPE constructor
+         * @return True if the element was pushed, false if the queue was full
+         */
+        template<typename... Args>
+        bool tryEmplace(Args&&... args);
+
+        /**
+         * @brief Copies an element to the back of the queue, if there is room
+         * @param e Element to push
+         * @return True if the element was pushed, false if the queue was full
+         */
+        bool tryPush(const TYPE& e);
+
+        /**
+         * @brief Moves an element to the back of the queue, if there is room
+         * @param e Element to push; left untouched if the queue was full
+         * @return True if the element was pushed, false if the queue was full
+         */
+        bool tryPush(TYPE&& e);
+
+        /**
+         * @brief Takes the front element, if there is one
+         * @return The element, or an empty alternative if the queue was empty
+         */
+        alternative<TYPE> tryPop();
+
+        /**
+         * @brief Copies an element to the back of the queue, waiting for room
+         * @param e Element to push
+         */
+        void push(const TYPE& e);
+
+        /**
+         * @brief Moves an element to the back of the queue, waiting for room
+         * @param e Element to push
+         */
+        void push(TYPE&& e);
+
+        /**
+         * @brief Takes the front element, waiting until there is one or the queue is closed
+         * @return The element, or an empty alternative once the queue is closed and drained
+         */
+        alternative<TYPE> pop();
+
+        /**
+         * @brief Marks the end of the stream, once every producer has pushed its last element
+         */
+        void close();
+
+        /**
+         * @brief Checks whether close has been called
+         * @return True if the queue is closed
+         */
+        [[nodiscard]] bool closed() const;
+
+        /**
+         * @brief Approximate number of elements
+         * @return Claimed enqueue positions minus claimed dequeue positions, at most capacity
+         */
+        [[nodiscard]] u_integer size() const;
+
+        /**
+         * @brief Checks whether the queue looked empty during the call
+         * @return True if size() is 0
+         */
+        [[nodiscard]] bool empty() const;
+
+        /**
+         * @brief Number of cells
+         * @return Capacity given at construction
+         */
+        [[nodiscard]] u_integer capacity() const;
+
+        /**
+         * @brief Destroys the remaining elements and frees the cell array
+         * @note No other thread may use the queue any more.
+         */
+        ~mpmcQueue();
+    };
+}
+
+template<typename TYPE, typename ALLOC>
+TYPE* original::mpmcQueue<TYPE, ALLOC>::cell::element() {
+    return std::launder(reinterpret_cast<TYPE*>(this->storage_));
+}
+
+template<typename TYPE, typename ALLOC>
+typename original::mpmcQueue<TYPE, ALLOC>::cell*
+original::mpmcQueue<TYPE, ALLOC>::claimEnqueue() {
+    u_integer pos = this->enqueue_pos_.load(memOrder::RELAXED);
+    while (true) {
+        cell* c = this->cells_ + (pos & this->mask_);
+        const u_integer sequence = c->sequence_.load(memOrder::ACQUIRE);
+        const auto distance = static_cast<difference>(sequence - pos);
+        if (distance == 0) {
+            // On failure exchangeCmp reloads pos, so the loop retries the newer position
+            if (this->enqueue_pos_.exchangeCmp(pos, pos + 1, memOrder::RELAXED)) {
+                return c;
+            }
+        } else if (distance < 0) {
+            // The cell still holds the element of the previous lap
+            return nullptr;
+        } else {
+            pos = this->enqueue_pos_.load(memOrder::RELAXED);
+        }
+    }
+}
+
+template<typename TYPE, typename ALLOC>
+typename original::mpmcQueue<TYPE, ALLOC>::cell*
+original::mpmcQueue<TYPE, ALLOC>::claimDequeue(u_integer& pos) {
+    pos = this->dequeue_pos_.load(memOrder::RELAXED);
+    while (true) {
+        cell* c = this->cells_ + (pos & this->mask_);
+        const u_integer sequence = c->sequence_.load(memOrder::ACQUIRE);
+        const auto distance = static_cast<difference>(sequence - (pos + 1));
+        if (distance == 0) {
+            if (this->dequeue_pos_.exchangeCmp(pos, pos + 1, memOrder::RELAXED)) {
+                return c;
+            }
+        } else if (distance < 0) {
+            // The producer of this position has not published yet
+            return nullptr;
+        } else {
+            pos = this->dequeue_pos_.load(memOrder::RELAXED);
+        }
+    }
+}
+
+template<typename TYPE, typename ALLOC>
+original::mpmcQueue<TYPE, ALLOC>::mpmcQueue(const u_integer capacity)
+    : cells_(nullptr), capacity_(capacity), mask_(capacity - 1) {
+    if (!std::has_single_bit(capacity) || capacity > static_cast<u_integer>(std::numeric_limits<difference>::max())) {
+        throw valueError("mpmcQueue capacity must be a power of two below 2^31, got " + std::to_string(capacity));
+    }
+    this->cells_ = this->cell_alloc_.allocate(capacity);
+    for (u_integer i = 0; i < capacity; ++i) {
+        this->cell_alloc_.construct(this->cells_ + i);
+        this->cells_[i].sequence_.store(i, memOrder::RELAXED);
+    }
+}
+
+template<typename TYPE, typename ALLOC>
+template<typename... Args>
+bool original::mpmcQueue<TYPE, ALLOC>::tryEmplace(Args&&... args) {
+    if constexpr (noexcept(TYPE(std::declval<Args>()...))) {
+        cell* c = this->claimEnqueue();
+        if (!c) {
+            return false;
+        }
+        const u_integer pos = c->sequence_.load(memOrder::RELAXED);
+        new (c->storage_) TYPE(std::forward<Args>(args)...);
+        c->sequence_.store(pos + 1, memOrder::RELEASE);
+        return true;
+    } else {
+        // A claimed cell cannot be given back, so a constructor that may throw runs first
+        return this->tryEmplace(TYPE(std::forward<Args>(args)...));
+    }
+}
+
+template<typename TYPE, typename ALLOC>
+bool original::mpmcQueue<TYPE, ALLOC>::tryPush(const TYPE& e) {
+    return this->tryEmplace(e);
+}
+
+template<typename TYPE, typename ALLOC>
+bool original::mpmcQueue<TYPE, ALLOC>::tryPush(TYPE&& e) {
+    return this->tryEmplace(std::move(e));
+}
+
+template<typename TYPE, typename ALLOC>
+original::alternative<TYPE> original::mpmcQueue<TYPE, ALLOC>::tryPop() {
+    u_integer pos;
+    cell* c = this->claimDequeue(pos);
+    if (!c) {
+        return alternative<TYPE>{};
+    }
+    TYPE* element = c->element();
+    alternative<TYPE> result{std::move(*element)};
+    element->~TYPE();
+    // Hand the cell to the producer of the next lap
+    c->sequence_.store(pos + this->capacity_, memOrder::RELEASE);
+    return result;
+}
+
+template<typename TYPE, typename ALLOC>
+void original::mpmcQueue<TYPE, ALLOC>::push(const TYPE& e) {
+    u_integer spins = 0;
+    while (!this->tryEmplace(e)) {
+        thread::backOff(spins);
+    }
+}
+
+template<typename TYPE, typename ALLOC>
+void original::mpmcQueue<TYPE, ALLOC>::push(TYPE&& e) {
+    u_integer spins = 0;
+    while (!this->tryEmplace(std::move(e))) {
+        thread::backOff(spins);
+    }
+}
+
+template<typename TYPE, typename ALLOC>
+original::alternative<TYPE> original::mpmcQueue<TYPE, ALLOC>::pop() {
+    u_integer spins = 0;
+    while (true) {
+        if (auto e = this->tryPop()) {
+            return e;
+        }
+        if (this->closed_.load(memOrder::ACQUIRE)) {
+            // Every push finished before close, so one more try settles it
+            return this->tryPop();
+        }
+        thread::backOff(spins);
+    }
+}
+
+template<typename TYPE, typename ALLOC>
+void original::mpmcQueue<TYPE, ALLOC>::close() {
+    this->closed_.store(true, memOrder::RELEASE);
+}
+
+template<typename TYPE, typename ALLOC>
+bool original::mpmcQueue<TYPE, ALLOC>::closed() const {
+    return this->closed_.load(memOrder::ACQUIRE);
+}
+
+template<typename TYPE, typename ALLOC>
+original::u_integer original::mpmcQueue<TYPE, ALLOC>::size() const {
+    const u_integer head = this->dequeue_pos_.load(memOrder::ACQUIRE);
+    const u_integer tail = this->enqueue_pos_.load(memOrder::ACQUIRE);
+    const auto distance = static_cast<difference>(tail - head);
+    // Pops between the two loads can make the difference overshoot or even go negative
+    return distance < 0 ? 0 : std::min(static_cast<u_integer>(distance), this->capacity_);
+}
+
+template<typename TYPE, typename ALLOC>
+bool original::mpmcQueue<TYPE, ALLOC>::empty() const {
+    return this->size() == 0;
+}
+
+template<typename TYPE, typename ALLOC>
+original::u_integer original::mpmcQueue<TYPE, ALLOC>::capacity() const {
+    return this->capacity_;
+}
+
+template<typename TYPE, typename ALLOC>
+original::mpmcQueue<TYPE, ALLOC>::~mpmcQueue() {
+    const u_integer tail = this->enqueue_pos_.load(memOrder::ACQUIRE);
+    for (u_integer pos = this->dequeue_pos_.load(memOrder::RELAXED); pos != tail; ++pos) {
+        this->cells_[pos & this->mask_].element()->~TYPE();
+    }
+    for (u_integer i = 0; i < this->capacity_; ++i) {
+        rebind_alloc_cell::destroy(this->cells_ + i);
+    }
+    this->cell_alloc_.deallocate(this->cells_, this->capacity_);
+}
+
+#endif //ORIGINAL_MPMC_QUEUE_H
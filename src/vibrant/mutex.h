@@ -28,6 +28,7 @@ namespace original {
      *       Derived classes must implement all pure virtual methods.
      */
     class mutexBase {
+        friend class uniqueLock;
     protected:
         /**
          * @brief Locks the mutex, blocking if necessary
@@ -206,15 +207,100 @@ namespace original {
         ~pMutex() override;
     };
 
+    /**
+     * @class pRWMutex
+     * @brief POSIX read-write lock implementation
+     * @extends mutexBase
+     * @details Wrapper around pthread_rwlock_t. The mutexBase interface
+     * (lock/tryLock/unlock) acquires the lock exclusively, while
+     * lockShared/tryLockShared/unlockShared allow any number of concurrent
+     * readers. Intended for read-mostly data where readers should not
+     * serialize on each other.
+     */
+    class pRWMutex final : public mutexBase {
+        pthread_rwlock_t rw_lock_; ///< Internal POSIX read-write lock handle
+    public:
+        /// Native handle type (pthread_rwlock_t)
+        using native_handle = pthread_rwlock_t;
+
+        /**
+         * @brief Constructs and initializes the read-write lock
+         * @throws sysError if initialization fails
+         */
+        explicit pRWMutex();
+
+        /// Deleted move constructor
+        pRWMutex(pRWMutex&&) = delete;
+
+        /// Deleted move assignment operator
+        pRWMutex& operator=(pRWMutex&&) = delete;
+
+        /**
+         * @brief Gets a unique identifier for the lock
+         * @return Unique identifier based on lock internal state
+         */
+        [[nodiscard]] ul_integer id() const override;
+
+        /**
+         * @brief Gets the native lock handle
+         * @return Pointer to the internal pthread_rwlock_t
+         */
+        [[nodiscard]] void* nativeHandle() noexcept override;
+
+        /**
+         * @brief Acquires the lock exclusively, blocking if necessary
+         * @throws sysError if the lock operation fails
+         */
+        void lock() override;
+
+        /**
+         * @brief Attempts to acquire the lock exclusively without blocking
+         * @return true if lock was acquired, false if lock is busy
+         * @throws sysError if the operation fails (other than EBUSY)
+         */
+        bool tryLock() override;
+
+        /**
+         * @brief Releases the lock (exclusive or shared)
+         * @throws sysError if the unlock operation fails
+         */
+        void unlock() override;
+
+        /**
+         * @brief Acquires the lock in shared mode, blocking if a writer holds it
+         * @throws sysError if the lock operation fails
+         */
+        void lockShared();
+
+        /**
+         * @brief Attempts to acquire the lock in shared mode without blocking
+         * @return true if lock was acquired, false if a writer holds it
+         * @throws sysError if the operation fails (other than EBUSY)
+         */
+        bool tryLockShared();
+
+        /**
+         * @brief Releases a shared hold of the lock
+         * @throws sysError if the unlock operation fails
+         */
+        void unlockShared();
+
+        /**
+         * @brief Destroys the read-write lock
+         * @note Calls std::terminate() if destruction fails
+         */
+        ~pRWMutex() override;
+    };
+
     /**
      * @class uniqueLock
      * @brief RAII wrapper for single mutex locking
      * @extends lockGuard
-     * @details Provides scoped lock management for a single pMutex
-     * with various locking policies.
+     * @details Provides scoped lock management for a single mutex
+     * with various locking policies. For pRWMutex the lock is held exclusively.
      */
     class uniqueLock final : public lockGuard {
-        pMutex& p_mutex_;   ///< Reference to managed mutex
+        mutexBase& p_mutex_;   ///< Reference to managed mutex
         bool is_locked;     ///< Current lock state
 
     public:
@@ -224,7 +310,7 @@ namespace original {
          * @param policy Locking policy (default: AUTO_LOCK)
          * @throws sysError if locking fails
          */
-        explicit uniqueLock(pMutex& p_mutex, lockPolicy policy = AUTO_LOCK);
+        explicit uniqueLock(mutexBase& p_mutex, lockPolicy policy = AUTO_LOCK);
 
         /// Deleted move constructor
         uniqueLock(uniqueLock&&) = delete;
@@ -263,6 +349,64 @@ namespace original {
         ~uniqueLock() override;
     };
 
+    /**
+     * @class sharedLock
+     * @brief RAII wrapper for shared (reader) locking of a pRWMutex
+     * @extends lockGuard
+     * @details Provides scoped shared-mode lock management for a pRWMutex.
+     * Multiple sharedLock instances on the same pRWMutex may be held at once,
+     * but none can coexist with a uniqueLock on it.
+     */
+    class sharedLock final : public lockGuard {
+        pRWMutex& p_mutex_;   ///< Reference to managed read-write lock
+        bool is_locked;       ///< Current lock state
+
+    public:
+        /**
+         * @brief Constructs a sharedLock with specified policy
+         * @param p_mutex Read-write lock to manage
+         * @param policy Locking policy (default: AUTO_LOCK)
+         * @throws sysError if locking fails
+         */
+        explicit sharedLock(pRWMutex& p_mutex, lockPolicy policy = AUTO_LOCK);
+
+        /// Deleted move constructor
+        sharedLock(sharedLock&&) = delete;
+
+        /// Deleted move assignment operator
+        sharedLock& operator=(sharedLock&&) = delete;
+
+        /**
+         * @brief Checks if the shared lock is currently held
+         * @return true if locked, false otherwise
+         */
+        [[nodiscard]] bool isLocked() const noexcept override;
+
+        /**
+         * @brief Acquires the associated lock in shared mode
+         * @throws sysError if already locked or locking fails
+         */
+        void lock() override;
+
+        /**
+         * @brief Attempts to acquire the associated lock in shared mode without blocking
+         * @return true if lock was acquired, false otherwise
+         * @throws sysError if already locked or operation fails
+         */
+        bool tryLock() override;
+
+        /**
+         * @brief Releases the shared hold
+         * @throws sysError if unlock fails
+         */
+        void unlock() override;
+
+        /**
+         * @brief Destructor - automatically unlocks if locked
+         */
+        ~sharedLock() override;
+    };
+
     /**
      * @class multiLock
      * @brief RAII wrapper for multiple mutex locking
@@ -402,7 +546,79 @@ inline original::pMutex::~pMutex() {
     }
 }
 
-inline original::uniqueLock::uniqueLock(pMutex& p_mutex, lockPolicy policy)
+inline original::pRWMutex::pRWMutex() : rw_lock_{} {
+    if (const int code = pthread_rwlock_init(&this->rw_lock_, nullptr);
+        code != 0){
+        throw sysError("Failed to initialize rwlock (pthread_rwlock_init returned " + printable::formatString(code) + ")");
+    }
+}
+
+inline original::ul_integer original::pRWMutex::id() const {
+    return reinterpret_cast<ul_integer>(&this->rw_lock_);
+}
+
+inline void* original::pRWMutex::nativeHandle() noexcept
+{
+    return &this->rw_lock_;
+}
+
+inline void original::pRWMutex::lock() {
+    if (const int code = pthread_rwlock_wrlock(&this->rw_lock_);
+        code != 0) {
+        throw sysError("Failed to lock rwlock (pthread_rwlock_wrlock returned " + printable::formatString(code) + ")");
+    }
+}
+
+inline bool original::pRWMutex::tryLock() {
+    if (const int code = pthread_rwlock_trywrlock(&this->rw_lock_);
+            code != 0) {
+        if (code == EBUSY)
+            return false;
+
+        throw sysError("Failed to try-lock rwlock (pthread_rwlock_try-wrlock returned " + printable::formatString(code) + ")");
+    }
+    return true;
+}
+
+inline void original::pRWMutex::unlock() {
+    if (const int code = pthread_rwlock_unlock(&this->rw_lock_);
+        code != 0){
+        throw sysError("Failed to unlock rwlock (pthread_rwlock_unlock returned " + printable::formatString(code) + ")");
+    }
+}
+
+inline void original::pRWMutex::lockShared() {
+    if (const int code = pthread_rwlock_rdlock(&this->rw_lock_);
+        code != 0) {
+        throw sysError("Failed to lock rwlock shared (pthread_rwlock_rdlock returned " + printable::formatString(code) + ")");
+    }
+}
+
+inline bool original::pRWMutex::tryLockShared() {
+    if (const int code = pthread_rwlock_tryrdlock(&this->rw_lock_);
+            code != 0) {
+        if (code == EBUSY)
+            return false;
+
+        throw sysError("Failed to try-lock rwlock shared (pthread_rwlock_try-rdlock returned " + printable::formatString(code) + ")");
+    }
+    return true;
+}
+
+inline void original::pRWMutex::unlockShared() {
+    this->unlock();
+}
+
+inline original::pRWMutex::~pRWMutex() {
+    if (const int code = pthread_rwlock_destroy(&this->rw_lock_);
+        code != 0){
+        std::cerr << "Fatal error: Failed to destroy rwlock (pthread_rwlock_destroy returned "
+                  << code << ")" << std::endl;
+        std::terminate();
+    }
+}
+
+inline original::uniqueLock::uniqueLock(mutexBase& p_mutex, lockPolicy policy)
     : p_mutex_(p_mutex), is_locked(false) {
     switch (policy) {
         case MANUAL_LOCK:
@@ -449,6 +665,53 @@ inline original::uniqueLock::~uniqueLock() {
     this->unlock();
 }
 
+inline original::sharedLock::sharedLock(pRWMutex& p_mutex, lockPolicy policy)
+    : p_mutex_(p_mutex), is_locked(false) {
+    switch (policy) {
+        case MANUAL_LOCK:
+            break;
+        case AUTO_LOCK:
+            this->lock();
+            break;
+        case TRY_LOCK:
+            this->tryLock();
+            break;
+        case ADOPT_LOCK:
+            this->is_locked = true;
+    }
+}
+
+inline bool original::sharedLock::isLocked() const noexcept {
+    return this->is_locked;
+}
+
+inline void original::sharedLock::lock() {
+    if (this->is_locked)
+        throw sysError("Cannot lock sharedLock: already locked");
+
+    this->p_mutex_.lockShared();
+    this->is_locked = true;
+}
+
+inline bool original::sharedLock::tryLock() {
+    if (this->is_locked)
+        throw sysError("Cannot try-lock sharedLock: already locked");
+
+    this->is_locked = this->p_mutex_.tryLockShared();
+    return this->is_locked;
+}
+
+inline void original::sharedLock::unlock() {
+    if (this->is_locked){
+        this->p_mutex_.unlockShared();
+        this->is_locked = false;
+    }
+}
+
+inline original::sharedLock::~sharedLock() {
+    this->unlock();
+}
+
 template<typename... MUTEX>
 template<original::u_integer... IDXES>
 void original::multiLock<MUTEX...>::lockAll(indexSequence<IDXES...>) {
@@ -0,0 +1,296 @@
+#ifndef ORIGINAL_PARALLEL_H
+#define ORIGINAL_PARALLEL_H
+
+#include "atomic.h"
+#include "condition.h"
+#include "mutex.h"
+#include "tasks.h"
+#include <exception>
+#include <utility>
+
+
+/**
+ * @file parallel.h
+ * @brief Fork-join parallelism on a taskDelegator
+ * @details Provides:
+ * - `forkJoin`: a group of child tasks that can be joined
+ * - `parallelFor`: runs a body over an index range, splitting it recursively
+ * - `parallelInvoke`: runs several callables in parallel
+ *
+ * A thread joining a group does not just block: while children are outstanding it runs
+ * queued tasks of the delegator itself (taskDelegator::tryRunOne()). Nested fork-join code
+ * therefore cannot deadlock a fixed-size pool, even one with a single worker, and the
+ * calling thread takes part in the work.
+ *
+ * @see tasks.h for the taskDelegator running the children
+ */
+
+namespace original {
+
+    /**
+     * @class forkJoin
+     * @brief Group of child tasks forked onto a taskDelegator and joined together
+     * @details Children may fork further children into the same group; join() returns
+     * once every child finished. If children throw, the first exception is kept and
+     * rethrown by join(), and children that have not started yet are skipped.
+     *
+     * @note Not copyable or movable. The destructor waits for outstanding children but
+     * drops their exceptions; call join() to see them.
+     */
+    class forkJoin final {
+        taskDelegator& delegator_;                              ///< Pool running the children
+        atomic<u_integer> pending_{makeAtomic<u_integer>(0)};   ///< Children not finished yet
+        atomic<bool> failed_{makeAtomic(false)};                ///< Whether a child threw
+        std::exception_ptr error_;                              ///< First exception thrown
+        u_integer busy_limit_;                                  ///< Outstanding children that keep the pool busy
+        pMutex mutex_;                                          ///< Guards the last decrement of pending_
+        pCondition condition_;                                  ///< Signals pending_ reaching zero
+
+        /**
+         * @brief Runs a child and counts it as finished
+         * @param child The child callable
+         */
+        template<typename Callback>
+        void runChild(Callback& child);
+
+        /**
+         * @brief Waits for every child, helping the delegator meanwhile
+         */
+        void wait();
+
+    public:
+        forkJoin(const forkJoin&) = delete;
+        forkJoin& operator=(const forkJoin&) = delete;
+        forkJoin(forkJoin&&) = delete;
+        forkJoin& operator=(forkJoin&&) = delete;
+
+        /**
+         * @brief Constructs an empty group
+         * @param delegator Pool running the children
+         */
+        explicit forkJoin(taskDelegator& delegator);
+
+        /**
+         * @brief Starts a child task
+         * @tparam Callback Callable taking no arguments
+         * @param child The child; run on the calling thread if the delegator is stopped
+         */
+        template<typename Callback>
+        void fork(Callback&& child);
+
+        /**
+         * @brief Records an exception as if a child had thrown it
+         * @param e The exception; ignored if one was recorded before
+         */
+        void fail(std::exception_ptr e);
+
+        /**
+         * @brief Whether a child threw, so remaining work may be skipped
+         */
+        [[nodiscard]] bool failed() const noexcept;
+
+        /**
+         * @brief Whether forking more children would help
+         * @return True while fewer children are outstanding than the pool can keep busy
+         * @details Used by adaptive splitting: work is divided further only when there
+         * are threads that could take it.
+         */
+        [[nodiscard]] bool wantsWork() const noexcept;
+
+        /**
+         * @brief Runs a body over an index range within this group
+         * @tparam Body Callable taking an `integer` index
+         * @param begin First index
+         * @param end One past the last index
+         * @param grain Smallest number of indexes run as one piece (0 counts as 1)
+         * @param body Called once per index; must outlive join()
+         * @details While the range is longer than `grain` and wantsWork() holds, its upper
+         * half is forked as a child that splits further the same way; otherwise `grain`
+         * indexes are run on the calling thread before checking again. Stops early once
+         * a child failed.
+         */
+        template<typename Body>
+        void forRange(integer begin, integer end, u_integer grain, Body& body);
+
+        /**
+         * @brief Waits for every child, running queued tasks meanwhile
+         * @throw The first exception thrown by a child
+         */
+        void join();
+
+        /**
+         * @brief Destructor
+         * @details Waits for outstanding children
+         */
+        ~forkJoin();
+    };
+
+    /**
+     * @brief Runs a body for every index of a range in parallel
+     * @tparam Body Callable taking an `integer` index
+     * @param delegator Pool running the pieces
+     * @param begin First index
+     * @param end One past the last index
+     * @param grain Smallest number of indexes run as one piece (0 counts as 1)
+     * @param body Called once per index, from any thread
+     * @details The range is halved recursively, Cilk style: a piece forks its upper half
+     * and keeps the lower one. Splitting is adaptive: a piece only forks while the pool
+     * could use more work, and otherwise runs `grain` indexes at a time, checking again
+     * in between, so work is split further as soon as threads run out of it.
+     * @throw The first exception thrown by the body; later pieces are then skipped
+     */
+    template<typename Body>
+    void parallelFor(taskDelegator& delegator, integer begin, integer end, u_integer grain, Body&& body);
+
+    /**
+     * @brief Runs callables in parallel and waits for all of them
+     * @tparam Callbacks Callables taking no arguments
+     * @param delegator Pool running all callables but the last, which runs on the calling thread
+     * @param callbacks The callables
+     * @throw The first exception thrown by a callable
+     */
+    template<typename... Callbacks>
+    void parallelInvoke(taskDelegator& delegator, Callbacks&&... callbacks);
+
+} // namespace original
+
+inline original::forkJoin::forkJoin(taskDelegator& delegator)
+    : delegator_(delegator), busy_limit_(2 * delegator.maxThreads() + 1) {}
+
+template <typename Callback>
+void original::forkJoin::runChild(Callback& child)
+{
+    try {
+        if (!this->failed()) {
+            child();
+        }
+    } catch (...) {
+        this->fail(std::current_exception());
+    }
+    // The joining thread takes the mutex before returning, so the group outlives this
+    uniqueLock lock{this->mutex_};
+    u_integer left = this->pending_.load(memOrder::ACQUIRE);
+    while (!this->pending_.exchangeCmp(left, left - 1)) {}
+    if (left == 1) {
+        this->condition_.notifyAll();
+    }
+}
+
+template <typename Callback>
+void original::forkJoin::fork(Callback&& child)
+{
+    u_integer seen = this->pending_.load(memOrder::ACQUIRE);
+    while (!this->pending_.exchangeCmp(seen, seen + 1)) {}
+    auto task = [this, child = std::forward<Callback>(child)] mutable {
+        this->runChild(child);
+    };
+    try {
+        this->delegator_.post(taskDelegator::NORMAL, task);
+    } catch (const sysError&) {
+        task();
+    }
+}
+
+inline void original::forkJoin::fail(std::exception_ptr e)
+{
+    bool expected = false;
+    if (this->failed_.exchangeCmp(expected, true)) {
+        this->error_ = std::move(e);
+    }
+}
+
+inline bool original::forkJoin::failed() const noexcept
+{
+    return this->failed_.load(memOrder::ACQUIRE);
+}
+
+inline bool original::forkJoin::wantsWork() const noexcept
+{
+    return this->pending_.load(memOrder::RELAXED) < this->busy_limit_;
+}
+
+inline void original::forkJoin::wait()
+{
+    while (this->pending_.load(memOrder::ACQUIRE) > 0) {
+        if (this->delegator_.tryRunOne()) {
+            continue;
+        }
+        // Nothing queued: every outstanding child is running somewhere and finishes on its own
+        uniqueLock lock{this->mutex_};
+        this->condition_.wait(this->mutex_, [this] {
+            return this->pending_.load(memOrder::ACQUIRE) == 0;
+        });
+    }
+    // Wait until the child that counted down last has released the mutex
+    uniqueLock lock{this->mutex_};
+}
+
+inline void original::forkJoin::join()
+{
+    this->wait();
+    if (this->error_) {
+        std::exception_ptr e = std::move(this->error_);
+        this->error_ = nullptr;
+        this->failed_.store(false);
+        std::rethrow_exception(e);
+    }
+}
+
+inline original::forkJoin::~forkJoin()
+{
+    this->wait();
+}
+
+template <typename Body>
+void original::forkJoin::forRange(integer begin, integer end, const u_integer grain, Body& body)
+{
+    const integer piece = grain == 0 ? 1 : static_cast<integer>(grain);
+    while (begin < end && !this->failed()) {
+        if (end - begin > piece && this->wantsWork()) {
+            const integer mid = begin + (end - begin) / 2;
+            this->fork([this, mid, end, grain, &body] {
+                this->forRange(mid, end, grain, body);
+            });
+            end = mid;
+            continue;
+        }
+        const integer stop = end - begin > piece ? begin + piece : end;
+        for (integer i = begin; i < stop; ++i) {
+            body(i);
+        }
+        begin = stop;
+    }
+}
+
+template <typename Body>
+void original::parallelFor(taskDelegator& delegator, const integer begin, const integer end,
+                           const u_integer grain, Body&& body)
+{
+    forkJoin group{delegator};
+    try {
+        group.forRange(begin, end, grain, body);
+    } catch (...) {
+        group.fail(std::current_exception());
+    }
+    group.join();
+}
+
+template <typename... Callbacks>
+void original::parallelInvoke(taskDelegator& delegator, Callbacks&&... callbacks)
+{
+    if constexpr (sizeof...(Callbacks) > 0) {
+        forkJoin group{delegator};
+        auto&& all = std::forward_as_tuple(std::forward<Callbacks>(callbacks)...);
+        [&]<std::size_t... IDX>(std::index_sequence<IDX...>) {
+            (group.fork(std::get<IDX>(all)), ...);
+        }(std::make_index_sequence<sizeof...(Callbacks) - 1>{});
+        try {
+            std::get<sizeof...(Callbacks) - 1>(all)();
+        } catch (...) {
+            group.fail(std::current_exception());
+        }
+        group.join();
+    }
+}
+
+#endif //ORIGINAL_PARALLEL_H
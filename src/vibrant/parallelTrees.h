@@ -0,0 +1,391 @@
+#ifndef ORIGINAL_PARALLEL_TREES_H
+#define ORIGINAL_PARALLEL_TREES_H
+
+#include "maps.h"
+#include "sets.h"
+#include "tasks.h"
+#include <exception>
+
+
+/**
+ * @file parallelTrees.h
+ * @brief Parallel union, intersection and difference of treeMap and treeSet
+ * @details Provides:
+ * - `parallelUnion`, `parallelIntersection`, `parallelDifference` for treeMap and treeSet
+ * - `parallelTrees`: the join/split driver behind them
+ *
+ * The results equal those of treeMap::unionWith() and friends; only the independent
+ * subproblems run on a taskDelegator. Kept apart from RBTree.h so the core containers do
+ * not depend on the threading layer.
+ *
+ * @see RBTree.h for the sequential join/split algebra
+ */
+
+namespace original {
+
+    /**
+     * @class parallelTrees
+     * @brief Spreads the join/split set algebra of an RBTree over a taskDelegator
+     * @details The calling thread splits both trees a few levels deep, which yields about
+     * four independent subproblems per pool thread, and submits each to the pool. It then
+     * joins the results in order. Splitting and joining cost O(log n) per subproblem, so
+     * the work is the same as the sequential version.
+     *
+     * If anything throws, every submitted subproblem is waited for before the exception
+     * leaves, all detached parts are destroyed and the tree is left empty.
+     *
+     * @note Nodes are created and destroyed on the pool threads, so the allocator must
+     * be usable from several threads at once. The default allocator is.
+     */
+    class parallelTrees final {
+        /**
+         * @struct combineStep
+         * @brief One step of a parallel combine in postfix order
+         * @details A leaf takes the result of the next submitted task. An inner step pops two
+         * subtrees and joins them around mid, or without a middle node if mid is nullptr.
+         */
+        template<typename RBNode>
+        struct combineStep {
+            bool leaf;      ///< Whether this step takes the next task result
+            RBNode* mid;    ///< Middle node of an inner step
+        };
+
+        /**
+         * @brief Splits the trees top-down and submits the independent subproblems
+         * @param tree Tree owning the nodes of mine
+         * @param mine Detached subtree of tree, consumed
+         * @param other Subtree of the other tree
+         * @param op Operation to perform
+         * @param depth Remaining levels to split before submitting
+         * @param pool Delegator running the subproblems
+         * @param leaves Receives the futures of the subproblems in order
+         * @param leaf_cnt Number of futures in leaves so far
+         * @param steps Receives the postfix join plan
+         * @throw Whatever splitting, node creation or submission throws. Parts not yet handed
+         * to leaves or steps are destroyed first.
+         */
+        template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+        static void planCombine(RBTree<K_TYPE, V_TYPE, ALLOC, Compare>& tree,
+                                typename RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::subtree mine,
+                                const typename RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode* other,
+                                typename RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::setOperation op,
+                                u_integer depth, taskDelegator& pool,
+                                array<async::future<typename RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::subtree>>& leaves,
+                                u_integer& leaf_cnt,
+                                vector<combineStep<typename RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode>>& steps);
+
+        /**
+         * @brief Parallel RBTree::combineWith()
+         * @param tree Tree to modify
+         * @param other Tree ordered by the same comparison
+         * @param op Operation to perform
+         * @param pool Delegator running the subproblems
+         */
+        template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+        static void combineWith(RBTree<K_TYPE, V_TYPE, ALLOC, Compare>& tree,
+                                const RBTree<K_TYPE, V_TYPE, ALLOC, Compare>& other,
+                                typename RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::setOperation op,
+                                taskDelegator& pool);
+
+    public:
+        /**
+         * @brief Adds every key of other to tree
+         * @param tree Tree to modify; keys present in both keep its nodes
+         * @param other Tree ordered by the same comparison
+         * @param pool Delegator running the subproblems
+         */
+        template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+        static void unite(RBTree<K_TYPE, V_TYPE, ALLOC, Compare>& tree,
+                          const RBTree<K_TYPE, V_TYPE, ALLOC, Compare>& other, taskDelegator& pool);
+
+        /**
+         * @brief Keeps only the keys of tree that are also in other
+         * @param tree Tree to modify
+         * @param other Tree ordered by the same comparison
+         * @param pool Delegator running the subproblems
+         */
+        template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+        static void intersect(RBTree<K_TYPE, V_TYPE, ALLOC, Compare>& tree,
+                              const RBTree<K_TYPE, V_TYPE, ALLOC, Compare>& other, taskDelegator& pool);
+
+        /**
+         * @brief Removes the keys of tree that are in other
+         * @param tree Tree to modify
+         * @param other Tree ordered by the same comparison
+         * @param pool Delegator running the subproblems
+         */
+        template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+        static void subtract(RBTree<K_TYPE, V_TYPE, ALLOC, Compare>& tree,
+                             const RBTree<K_TYPE, V_TYPE, ALLOC, Compare>& other, taskDelegator& pool);
+    };
+
+    /**
+     * @brief Parallel treeMap::unionWith()
+     * @param map treeMap to modify; keys present in both keep its values
+     * @param other treeMap ordered by the same comparison
+     * @param pool Delegator whose threads combine independent subtrees
+     * @details Same result and total work as map.unionWith(other); the calling thread
+     * waits for the pool to finish.
+     * @throw Whatever node creation, comparison or submission throws; map is then empty
+     */
+    template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+    void parallelUnion(treeMap<K_TYPE, V_TYPE, Compare, ALLOC>& map,
+                       const treeMap<K_TYPE, V_TYPE, Compare, ALLOC>& other, taskDelegator& pool);
+
+    /**
+     * @brief Parallel treeMap::intersectWith()
+     * @param map treeMap to modify
+     * @param other treeMap ordered by the same comparison
+     * @param pool Delegator whose threads combine independent subtrees
+     * @throw Whatever comparison or submission throws; map is then empty
+     */
+    template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+    void parallelIntersection(treeMap<K_TYPE, V_TYPE, Compare, ALLOC>& map,
+                              const treeMap<K_TYPE, V_TYPE, Compare, ALLOC>& other, taskDelegator& pool);
+
+    /**
+     * @brief Parallel treeMap::differenceWith()
+     * @param map treeMap to modify
+     * @param other treeMap ordered by the same comparison
+     * @param pool Delegator whose threads combine independent subtrees
+     * @throw Whatever comparison or submission throws; map is then empty
+     */
+    template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+    void parallelDifference(treeMap<K_TYPE, V_TYPE, Compare, ALLOC>& map,
+                            const treeMap<K_TYPE, V_TYPE, Compare, ALLOC>& other, taskDelegator& pool);
+
+    /**
+     * @brief Parallel treeSet::unionWith()
+     * @param set treeSet to modify
+     * @param other treeSet ordered by the same comparison
+     * @param pool Delegator whose threads combine independent subtrees
+     * @throw Whatever node creation, comparison or submission throws; set is then empty
+     */
+    template<typename TYPE, typename Compare, typename ALLOC>
+    void parallelUnion(treeSet<TYPE, Compare, ALLOC>& set,
+                       const treeSet<TYPE, Compare, ALLOC>& other, taskDelegator& pool);
+
+    /**
+     * @brief Parallel treeSet::intersectWith()
+     * @param set treeSet to modify
+     * @param other treeSet ordered by the same comparison
+     * @param pool Delegator whose threads combine independent subtrees
+     * @throw Whatever comparison or submission throws; set is then empty
+     */
+    template<typename TYPE, typename Compare, typename ALLOC>
+    void parallelIntersection(treeSet<TYPE, Compare, ALLOC>& set,
+                              const treeSet<TYPE, Compare, ALLOC>& other, taskDelegator& pool);
+
+    /**
+     * @brief Parallel treeSet::differenceWith()
+     * @param set treeSet to modify
+     * @param other treeSet ordered by the same comparison
+     * @param pool Delegator whose threads combine independent subtrees
+     * @throw Whatever comparison or submission throws; set is then empty
+     */
+    template<typename TYPE, typename Compare, typename ALLOC>
+    void parallelDifference(treeSet<TYPE, Compare, ALLOC>& set,
+                            const treeSet<TYPE, Compare, ALLOC>& other, taskDelegator& pool);
+
+} // namespace original
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::parallelTrees::planCombine(RBTree<K_TYPE, V_TYPE, ALLOC, Compare>& tree,
+                                          typename RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::subtree mine,
+                                          const typename RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode* other,
+                                          const typename RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::setOperation op,
+                                          const u_integer depth, taskDelegator& pool,
+                                          array<async::future<typename RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::subtree>>& leaves,
+                                          u_integer& leaf_cnt,
+                                          vector<combineStep<typename RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::RBNode>>& steps)
+{
+    using tree_type = RBTree<K_TYPE, V_TYPE, ALLOC, Compare>;
+    using subtree = typename tree_type::subtree;
+    using RBNode = typename tree_type::RBNode;
+    using setOperation = typename tree_type::setOperation;
+
+    if (depth == 0 || !mine.root || !other) {
+        try {
+            leaves[leaf_cnt] = pool.submit([&tree, mine, other, op] {
+                return tree.combine(mine, other, op);
+            });
+        } catch (...) {
+            tree.destroyTree(mine.root);
+            throw;
+        }
+        // Counted at once, so the caller waits for and frees it even if recording the step fails
+        leaf_cnt += 1;
+        steps.pushEnd(combineStep<RBNode>{true, nullptr});
+        return;
+    }
+
+    subtree less, greater;
+    RBNode* match;
+    tree.split(mine, other->getKey(), less, match, greater);
+    try {
+        planCombine(tree, less, other->getPLeft(), op, depth - 1, pool, leaves, leaf_cnt, steps);
+    } catch (...) {
+        tree.destroyTree(greater.root);
+        if (match) {
+            tree.destroyNode(match);
+        }
+        throw;
+    }
+    try {
+        planCombine(tree, greater, other->getPRight(), op, depth - 1, pool, leaves, leaf_cnt, steps);
+        if (op == setOperation::UNION && !match) {
+            match = tree.createNode(other->getKey(), other->getValue());
+        } else if (op == setOperation::DIFFERENCE && match) {
+            tree.destroyNode(match);
+            match = nullptr;
+        }
+        steps.pushEnd(combineStep<RBNode>{false, match});
+    } catch (...) {
+        if (match) {
+            tree.destroyNode(match);
+        }
+        throw;
+    }
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::parallelTrees::combineWith(RBTree<K_TYPE, V_TYPE, ALLOC, Compare>& tree,
+                                          const RBTree<K_TYPE, V_TYPE, ALLOC, Compare>& other,
+                                          const typename RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::setOperation op,
+                                          taskDelegator& pool)
+{
+    using tree_type = RBTree<K_TYPE, V_TYPE, ALLOC, Compare>;
+    using subtree = typename tree_type::subtree;
+    using RBNode = typename tree_type::RBNode;
+
+    const u_integer threads = pool.maxThreads();
+    if (&other == &tree || threads < 2 || !tree.root_ || !other.root_) {
+        tree.combineWith(other, op);
+        return;
+    }
+
+    u_integer depth = 2;
+    while (static_cast<u_integer>(1) << (depth - 2) < threads) {
+        depth += 1;
+    }
+    // Allocated up front: once the tree is detached, nothing may fail before every leaf is waited for
+    array<async::future<subtree>> leaves(static_cast<u_integer>(1) << depth);
+    array<subtree> parts(static_cast<u_integer>(1) << depth);
+    vector<combineStep<RBNode>> steps;
+    u_integer leaf_cnt = 0;
+    const subtree mine{tree.root_, tree_type::blackHeight(tree.root_)};
+    tree.root_ = nullptr;
+    tree.size_ = 0;
+
+    std::exception_ptr error;
+    try {
+        planCombine(tree, mine, other.root_, op, depth, pool, leaves, leaf_cnt, steps);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    // Leaves work on tree, so all of them finish before anything is joined, freed or rethrown
+    for (u_integer i = 0; i < leaf_cnt; ++i) {
+        try {
+            parts[i] = leaves[i].result();
+        } catch (...) {
+            parts[i] = subtree{nullptr, 0};
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error) {
+        for (u_integer i = 0; i < leaf_cnt; ++i) {
+            tree.destroyTree(parts[i].root);
+        }
+        for (const auto& step : steps) {
+            if (step.mid) {
+                tree.destroyNode(step.mid);
+            }
+        }
+        std::rethrow_exception(error);
+    }
+
+    // The join stack grows over the consumed results, never past the next unread one
+    u_integer top = 0;
+    u_integer next = 0;
+    for (const auto& step : steps) {
+        if (step.leaf) {
+            parts[top++] = parts[next++];
+        } else {
+            const subtree right = parts[--top];
+            const subtree left = parts[--top];
+            parts[top++] = step.mid ? tree_type::join(left, step.mid, right) : tree_type::join(left, right);
+        }
+    }
+    tree.root_ = parts[0].root;
+    if (tree.root_) {
+        tree.root_->setColor(tree_type::BLACK);
+    }
+    tree.size_ = tree_type::RBNode::countOf(tree.root_);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::parallelTrees::unite(RBTree<K_TYPE, V_TYPE, ALLOC, Compare>& tree,
+                                    const RBTree<K_TYPE, V_TYPE, ALLOC, Compare>& other, taskDelegator& pool)
+{
+    combineWith(tree, other, RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::setOperation::UNION, pool);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::parallelTrees::intersect(RBTree<K_TYPE, V_TYPE, ALLOC, Compare>& tree,
+                                        const RBTree<K_TYPE, V_TYPE, ALLOC, Compare>& other, taskDelegator& pool)
+{
+    combineWith(tree, other, RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::setOperation::INTERSECTION, pool);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename ALLOC, typename Compare>
+void original::parallelTrees::subtract(RBTree<K_TYPE, V_TYPE, ALLOC, Compare>& tree,
+                                       const RBTree<K_TYPE, V_TYPE, ALLOC, Compare>& other, taskDelegator& pool)
+{
+    combineWith(tree, other, RBTree<K_TYPE, V_TYPE, ALLOC, Compare>::setOperation::DIFFERENCE, pool);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+void original::parallelUnion(treeMap<K_TYPE, V_TYPE, Compare, ALLOC>& map,
+                             const treeMap<K_TYPE, V_TYPE, Compare, ALLOC>& other, taskDelegator& pool)
+{
+    parallelTrees::unite<K_TYPE, V_TYPE, ALLOC, Compare>(map, other, pool);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+void original::parallelIntersection(treeMap<K_TYPE, V_TYPE, Compare, ALLOC>& map,
+                                    const treeMap<K_TYPE, V_TYPE, Compare, ALLOC>& other, taskDelegator& pool)
+{
+    parallelTrees::intersect<K_TYPE, V_TYPE, ALLOC, Compare>(map, other, pool);
+}
+
+template<typename K_TYPE, typename V_TYPE, typename Compare, typename ALLOC>
+void original::parallelDifference(treeMap<K_TYPE, V_TYPE, Compare, ALLOC>& map,
+                                  const treeMap<K_TYPE, V_TYPE, Compare, ALLOC>& other, taskDelegator& pool)
+{
+    parallelTrees::subtract<K_TYPE, V_TYPE, ALLOC, Compare>(map, other, pool);
+}
+
+template<typename TYPE, typename Compare, typename ALLOC>
+void original::parallelUnion(treeSet<TYPE, Compare, ALLOC>& set,
+                             const treeSet<TYPE, Compare, ALLOC>& other, taskDelegator& pool)
+{
+    parallelTrees::unite<TYPE, const bool, ALLOC, Compare>(set, other, pool);
+}
+
+template<typename TYPE, typename Compare, typename ALLOC>
+void original::parallelIntersection(treeSet<TYPE, Compare, ALLOC>& set,
+                                    const treeSet<TYPE, Compare, ALLOC>& other, taskDelegator& pool)
+{
+    parallelTrees::intersect<TYPE, const bool, ALLOC, Compare>(set, other, pool);
+}
+
+template<typename TYPE, typename Compare, typename ALLOC>
+void original::parallelDifference(treeSet<TYPE, Compare, ALLOC>& set,
+                                  const treeSet<TYPE, Compare, ALLOC>& other, taskDelegator& pool)
+{
+    parallelTrees::subtract<TYPE, const bool, ALLOC, Compare>(set, other, pool);
+}
+
+#endif //ORIGINAL_PARALLEL_TREES_H
@@ -0,0 +1,369 @@
+#ifndef ORIGINAL_SPSC_RING_H
+#define ORIGINAL_SPSC_RING_H
+
+#include "allocator.h"
+#include "atomic.h"
+#include "config.h"
+#include "coroutines.h"
+#include "error.h"
+#include "optional.h"
+#include "thread.h"
+#include <algorithm>
+#include <bit>
+
+
+/**
+ * @file spscRing.h
+ * @brief Bounded lock-free ring buffer for one producer thread and one consumer thread
+ * @details The hand-off queue for two-stage pipelines, where a mutex-protected queue spends
+ * most of its time on the lock and on the cache line the lock lives on:
+ * - The producer only writes the tail index and the consumer only writes the head index,
+ *   so neither side ever needs a read-modify-write instruction
+ * - Each side keeps a private copy of the other side's index and reloads it only when the
+ *   copy says the ring is full (producer) or empty (consumer)
+ * - The two indices, the two cached copies and the read-only fields live on separate cache
+ *   lines, so steady-state traffic is one line per batch in each direction
+ * - tryPushN and tryPopN move a whole batch and publish it with a single index store
+ */
+
+namespace original {
+
+    /**
+     * @class spscRing
+     * @tparam TYPE Element type (may be move-only)
+     * @tparam ALLOC Allocator type for the slot buffer (default: allocator<TYPE>)
+     * @brief Fixed-capacity single-producer/single-consumer ring buffer
+     * @details Capacity must be a power of two so that a slot is found by masking a free-running
+     * index. Both indices count every element ever pushed or popped and wrap around together,
+     * so tail - head is the number of stored elements even after the counters overflow.
+     *
+     * Slots are raw storage: an element is constructed by the push that fills its slot and
+     * destroyed by the pop that empties it.
+     *
+     * Threading rules:
+     * - Producer side: tryPush, tryEmplace, tryPushN, push, close
+     * - Consumer side: tryPop, tryPopN, pop, elements
+     * - size, empty, capacity and closed may be called from any thread; size is a snapshot
+     *
+     * Progress Guarantees:
+     * - The try* operations are wait-free
+     * - push and pop spin briefly, then yield the time slice until they can proceed
+     *
+     * @note Not copyable or movable, since both threads hold references to it.
+     */
+    template<typename TYPE, typename ALLOC = allocator<TYPE>>
+    class spscRing final {
+        ALLOC allocator_;                                           ///< Allocator of the slot buffer
+        TYPE* slots_;                                               ///< Raw slot storage
+        u_integer capacity_;                                        ///< Number of slots, a power of two
+        u_integer mask_;                                            ///< capacity_ - 1
+        byte padding_shared_[CACHE_LINE_SIZE]{};                    ///< Keeps read-only fields off the producer line
+        atomic<u_integer> tail_{makeAtomic<u_integer>(0)};          ///< Next slot to fill, written by the producer
+        u_integer head_cache_ = 0;                                  ///< Producer's last observed head_
+        byte padding_producer_[CACHE_LINE_SIZE]{};                  ///< Keeps the producer line off the consumer line
+        atomic<u_integer> head_{makeAtomic<u_integer>(0)};          ///< Next slot to empty, written by the consumer
+        u_integer tail_cache_ = 0;                                  ///< Consumer's last observed tail_
+        byte padding_consumer_[CACHE_LINE_SIZE]{};                  ///< Keeps the consumer line off the close flag
+        atomic<bool> closed_{makeAtomic<bool>(false)};              ///< Set once the producer is done
+
+        /**
+         * @brief Number of free slots seen by the producer
+         * @param tail Current tail index
+         * @param wanted Number of slots the caller needs
+         * @return Free slots; head_ is reloaded only if the cached head shows fewer than wanted
+         */
+        u_integer freeSlots(u_integer tail, u_integer wanted);
+
+        /**
+         * @brief Number of filled slots seen by the consumer
+         * @param head Current head index
+         * @param wanted Number of elements the caller needs
+         * @return Filled slots; tail_ is reloaded only if the cached tail shows fewer than wanted
+         */
+        u_integer readySlots(u_integer head, u_integer wanted);
+
+    public:
+        /**
+         * @brief Constructs an empty ring
+         * @param capacity Number of slots, a non-zero power of two
+         * @param alloc Allocator for the slot buffer
+         * @throw valueError If capacity is zero or not a power of two
+         */
+        explicit spscRing(u_integer capacity, ALLOC alloc = ALLOC{});
+
+        spscRing(const spscRing&) = delete;             ///< Disable copy constructor
+        spscRing& operator=(const spscRing&) = delete;  ///< Disable copy assignment
+
+        /**
+         * @brief Constructs an element in the next free slot, if there is one
+         * @tparam Args Constructor argument types
+         * @param args Arguments forwarded to the TYPE constructor
+         * @return True if the element was pushed, false if the ring was full
+         */
+        template<typename... Args>
+        bool tryEmplace(Args&&... args);
+
+        /**
+         * @brief Copies an element into the ring, if there is room
+         * @param e Element to push
+         * @return True if the element was pushed, false if the ring was full
+         */
+        bool tryPush(const TYPE& e);
+
+        /**
+         * @brief Moves an element into the ring, if there is room
+         * @param e Element to push; left untouched if the ring was full
+         * @return True if the element was pushed, false if the ring was full
+         */
+        bool tryPush(TYPE&& e);
+
+        /**
+         * @brief Copies up to n elements into the ring and publishes them together
+         * @param src Elements to push
+         * @param n Number of elements at src
+         * @return Number of elements pushed, the first ones of src
+         */
+        u_integer tryPushN(const TYPE* src, u_integer n);
+
+        /**
+         * @brief Takes the oldest element, if there is one
+         * @return The element, or an empty alternative if the ring was empty
+         */
+        alternative<TYPE> tryPop();
+
+        /**
+         * @brief Moves up to n of the oldest elements to dst and releases their slots together
+         * @param dst Destination of the elements, assigned in order
+         * @param n Capacity of dst
+         * @return Number of elements popped
+         */
+        u_integer tryPopN(TYPE* dst, u_integer n);
+
+        /**
+         * @brief Copies an element into the ring, waiting for a free slot
+         * @param e Element to push
+         */
+        void push(const TYPE& e);
+
+        /**
+         * @brief Moves an element into the ring, waiting for a free slot
+         * @param e Element to push
+         */
+        void push(TYPE&& e);
+
+        /**
+         * @brief Takes the oldest element, waiting until one is pushed or the ring is closed
+         * @return The element, or an empty alternative once the ring is closed and drained
+         */
+        alternative<TYPE> pop();
+
+        /**
+         * @brief Marks the end of the stream
+         * @details Called by the producer after its last push. Elements already in the ring
+         * can still be popped; a blocked pop returns once they are gone.
+         */
+        void close();
+
+        /**
+         * @brief Checks whether close has been called
+         * @return True if the producer has closed the ring
+         */
+        [[nodiscard]] bool closed() const;
+
+        /**
+         * @brief Number of elements in the ring at some moment during the call
+         * @return Stored element count
+         */
+        [[nodiscard]] u_integer size() const;
+
+        /**
+         * @brief Checks whether the ring held no element at some moment during the call
+         * @return True if empty
+         */
+        [[nodiscard]] bool empty() const;
+
+        /**
+         * @brief Number of slots
+         * @return Capacity given at construction
+         */
+        [[nodiscard]] u_integer capacity() const;
+
+        /**
+         * @brief Consumer-side generator over the stream
+         * @return Generator that pops elements until the ring is closed and drained
+         * @note The generator blocks like pop, so a consumer thread can drive a
+         *       coroutine pipeline with a plain range-for over it.
+         */
+        coroutine::generator<TYPE> elements();
+
+        /**
+         * @brief Destroys the remaining elements and frees the slot buffer
+         */
+        ~spscRing();
+    };
+}
+
+template<typename TYPE, typename ALLOC>
+original::u_integer original::spscRing<TYPE, ALLOC>::freeSlots(const u_integer tail, const u_integer wanted) {
+    if (this->capacity_ - (tail - this->head_cache_) < wanted) {
+        this->head_cache_ = this->head_.load(memOrder::ACQUIRE);
+    }
+    return this->capacity_ - (tail - this->head_cache_);
+}
+
+template<typename TYPE, typename ALLOC>
+original::u_integer original::spscRing<TYPE, ALLOC>::readySlots(const u_integer head, const u_integer wanted) {
+    if (this->tail_cache_ - head < wanted) {
+        this->tail_cache_ = this->tail_.load(memOrder::ACQUIRE);
+    }
+    return this->tail_cache_ - head;
+}
+
+template<typename TYPE, typename ALLOC>
+original::spscRing<TYPE, ALLOC>::spscRing(const u_integer capacity, ALLOC alloc)
+    : allocator_(std::move(alloc)), slots_(nullptr), capacity_(capacity), mask_(capacity - 1) {
+    if (!std::has_single_bit(capacity)) {
+        throw valueError("spscRing capacity must be a non-zero power of two, got " + std::to_string(capacity));
+    }
+    this->slots_ = this->allocator_.allocate(capacity);
+}
+
+template<typename TYPE, typename ALLOC>
+template<typename... Args>
+bool original::spscRing<TYPE, ALLOC>::tryEmplace(Args&&... args) {
+    const u_integer tail = this->tail_.load(memOrder::RELAXED);
+    if (this->freeSlots(tail, 1) == 0) {
+        return false;
+    }
+    this->allocator_.construct(this->slots_ + (tail & this->mask_), std::forward<Args>(args)...);
+    this->tail_.store(tail + 1, memOrder::RELEASE);
+    return true;
+}
+
+template<typename TYPE, typename ALLOC>
+bool original::spscRing<TYPE, ALLOC>::tryPush(const TYPE& e) {
+    return this->tryEmplace(e);
+}
+
+template<typename TYPE, typename ALLOC>
+bool original::spscRing<TYPE, ALLOC>::tryPush(TYPE&& e) {
+    return this->tryEmplace(std::move(e));
+}
+
+template<typename TYPE, typename ALLOC>
+original::u_integer original::spscRing<TYPE, ALLOC>::tryPushN(const TYPE* src, const u_integer n) {
+    const u_integer tail = this->tail_.load(memOrder::RELAXED);
+    const u_integer count = std::min(n, this->freeSlots(tail, n));
+    for (u_integer i = 0; i < count; ++i) {
+        this->allocator_.construct(this->slots_ + ((tail + i) & this->mask_), src[i]);
+    }
+    if (count > 0) {
+        this->tail_.store(tail + count, memOrder::RELEASE);
+    }
+    return count;
+}
+
+template<typename TYPE, typename ALLOC>
+original::alternative<TYPE> original::spscRing<TYPE, ALLOC>::tryPop() {
+    const u_integer head = this->head_.load(memOrder::RELAXED);
+    if (this->readySlots(head, 1) == 0) {
+        return alternative<TYPE>{};
+    }
+    TYPE* slot = this->slots_ + (head & this->mask_);
+    alternative<TYPE> result{std::move(*slot)};
+    ALLOC::destroy(slot);
+    this->head_.store(head + 1, memOrder::RELEASE);
+    return result;
+}
+
+template<typename TYPE, typename ALLOC>
+original::u_integer original::spscRing<TYPE, ALLOC>::tryPopN(TYPE* dst, const u_integer n) {
+    const u_integer head = this->head_.load(memOrder::RELAXED);
+    const u_integer count = std::min(n, this->readySlots(head, n));
+    for (u_integer i = 0; i < count; ++i) {
+        TYPE* slot = this->slots_ + ((head + i) & this->mask_);
+        dst[i] = std::move(*slot);
+        ALLOC::destroy(slot);
+    }
+    if (count > 0) {
+        this->head_.store(head + count, memOrder::RELEASE);
+    }
+    return count;
+}
+
+template<typename TYPE, typename ALLOC>
+void original::spscRing<TYPE, ALLOC>::push(const TYPE& e) {
+    u_integer spins = 0;
+    while (!this->tryEmplace(e)) {
+        thread::backOff(spins);
+    }
+}
+
+template<typename TYPE, typename ALLOC>
+void original::spscRing<TYPE, ALLOC>::push(TYPE&& e) {
+    u_integer spins = 0;
+    while (!this->tryEmplace(std::move(e))) {
+        thread::backOff(spins);
+    }
+}
+
+template<typename TYPE, typename ALLOC>
+original::alternative<TYPE> original::spscRing<TYPE, ALLOC>::pop() {
+    u_integer spins = 0;
+    while (true) {
+        if (auto e = this->tryPop()) {
+            return e;
+        }
+        if (this->closed_.load(memOrder::ACQUIRE)) {
+            // Everything pushed before close is visible now, so one more try settles it
+            return this->tryPop();
+        }
+        thread::backOff(spins);
+    }
+}
+
+template<typename TYPE, typename ALLOC>
+void original::spscRing<TYPE, ALLOC>::close() {
+    this->closed_.store(true, memOrder::RELEASE);
+}
+
+template<typename TYPE, typename ALLOC>
+bool original::spscRing<TYPE, ALLOC>::closed() const {
+    return this->closed_.load(memOrder::ACQUIRE);
+}
+
+template<typename TYPE, typename ALLOC>
+original::u_integer original::spscRing<TYPE, ALLOC>::size() const {
+    const u_integer head = this->head_.load(memOrder::ACQUIRE);
+    const u_integer tail = this->tail_.load(memOrder::ACQUIRE);
+    // Pops between the two loads can make the difference overshoot the capacity
+    return std::min(tail - head, this->capacity_);
+}
+
+template<typename TYPE, typename ALLOC>
+bool original::spscRing<TYPE, ALLOC>::empty() const {
+    return this->size() == 0;
+}
+
+template<typename TYPE, typename ALLOC>
+original::u_integer original::spscRing<TYPE, ALLOC>::capacity() const {
+    return this->capacity_;
+}
+
+template<typename TYPE, typename ALLOC>
+original::coroutine::generator<TYPE> original::spscRing<TYPE, ALLOC>::elements() {
+    while (auto e = this->pop()) {
+        co_yield std::move(*e);
+    }
+}
+
+template<typename TYPE, typename ALLOC>
+original::spscRing<TYPE, ALLOC>::~spscRing() {
+    const u_integer tail = this->tail_.load(memOrder::ACQUIRE);
+    for (u_integer i = this->head_.load(memOrder::RELAXED); i != tail; ++i) {
+        ALLOC::destroy(this->slots_ + (i & this->mask_));
+    }
+    this->allocator_.deallocate(this->slots_, this->capacity_);
+}
+
+#endif //ORIGINAL_SPSC_RING_H
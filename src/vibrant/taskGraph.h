@@ -0,0 +1,461 @@
+#ifndef ORIGINAL_TASKGRAPH_H
+#define ORIGINAL_TASKGRAPH_H
+
+#include "atomic.h"
+#include "condition.h"
+#include "mutex.h"
+#include "refCntPtr.h"
+#include "tasks.h"
+#include "vector.h"
+#include "zeit.h"
+#include <exception>
+#include <functional>
+#include <sstream>
+#include <string>
+
+
+/**
+ * @file taskGraph.h
+ * @brief Dependency graph of tasks executed on a taskDelegator
+ * @details A taskGraph is built once from nodes (callables) and edges (orderings), then
+ * run any number of times:
+ * - Every node carries a counter of unfinished predecessors; the worker finishing a node
+ *   counts down its successors and schedules those that reach zero, so no worker ever
+ *   blocks waiting for another task
+ * - One newly ready successor runs on the same worker right away, the others are
+ *   submitted to the delegator
+ * - Runs reuse the node storage and counters; the only allocation per handed-off node is
+ *   the delegator's task object, posted without a future
+ * - The start and end of every node are recorded for the last run
+ * - run() does not just block: while nodes are outstanding it runs queued tasks of the
+ *   delegator itself (taskDelegator::tryRunOne()), so a graph run from inside a task
+ *   cannot deadlock a small or saturated pool
+ *
+ * @see tasks.h for the taskDelegator running the nodes
+ */
+
+namespace original {
+
+    /**
+     * @class taskGraph
+     * @brief Directed acyclic graph of callables run in dependency order
+     * @details Nodes are identified by the index add() returns. precede(a, b) makes b wait
+     * for a. run() starts every node without predecessors, and returns once all nodes finished.
+     *
+     * If a node throws, nodes that have not started yet are skipped (they still count as
+     * finished, so the run completes) and run() rethrows the first exception.
+     *
+     * @note Not copyable or movable. The graph must not be modified while it runs.
+     */
+    class taskGraph final {
+        /**
+         * @struct node
+         * @brief A callable with its successors and the bookkeeping of the current run
+         */
+        struct node {
+            std::function<void()> work;     ///< The callable
+            std::string name;               ///< Name used in timings()
+            vector<u_integer> successors;   ///< Nodes waiting for this one
+            u_integer predecessors = 0;     ///< Number of nodes this one waits for
+            atomic<u_integer> pending{makeAtomic<u_integer>(0)};  ///< Unfinished predecessors in this run
+            bool skipped = false;           ///< Whether this run skipped the node after an error
+            time::point started;            ///< When the node started in the last run
+            time::point finished;           ///< When the node finished in the last run
+
+            node(std::function<void()> work, std::string name);
+        };
+
+        vector<strongPtr<node>> nodes_;     ///< All nodes, by index
+        bool verified_;                     ///< Whether the current edges are known to be acyclic
+
+        taskDelegator* delegator_;          ///< Delegator of the current run
+        atomic<bool> running_{makeAtomic(false)};       ///< Whether a run is in progress
+        atomic<u_integer> remaining_{makeAtomic<u_integer>(0)};  ///< Nodes not finished in this run
+        atomic<bool> failed_{makeAtomic(false)};        ///< Whether a node threw in this run
+        std::exception_ptr error_;          ///< First exception of this run
+        time::point run_started_;           ///< Start of the last run
+        time::point run_finished_;          ///< End of the last run
+        pMutex mutex_;                      ///< Guards done_
+        pCondition condition_;              ///< Signals done_
+        bool done_;                         ///< Whether every node of this run finished
+
+        /**
+         * @brief Checks that an index refers to a node
+         * @throw outOfBoundError if it does not
+         */
+        void check(u_integer index) const;
+
+        /**
+         * @brief Throws if a run is in progress
+         * @throw sysError if the graph is running
+         */
+        void checkIdle() const;
+
+        /**
+         * @brief Verifies the graph has no cycle, if edges changed since the last check
+         * @throw valueError if some nodes are on a cycle
+         */
+        void verify();
+
+        /**
+         * @brief Runs a node and every successor it makes ready that is not handed off
+         * @param index The ready node
+         */
+        void execute(u_integer index);
+
+        /**
+         * @brief Hands a ready node to the delegator, or runs it here if that fails
+         * @param index The ready node
+         */
+        void dispatch(u_integer index);
+
+        /**
+         * @brief Waits for every node of the current run, running queued tasks meanwhile
+         */
+        void wait();
+
+    public:
+        taskGraph(const taskGraph&) = delete;
+        taskGraph& operator=(const taskGraph&) = delete;
+        taskGraph(taskGraph&&) = delete;
+        taskGraph& operator=(taskGraph&&) = delete;
+
+        /**
+         * @brief Constructs an empty graph
+         */
+        taskGraph();
+
+        /**
+         * @brief Adds a node
+         * @param work Callable run when all predecessors of the node finished
+         * @return Index of the new node
+         * @throw sysError if the graph is running
+         */
+        u_integer add(std::function<void()> work);
+
+        /**
+         * @brief Adds a named node
+         * @param name Name shown by timings()
+         * @param work Callable run when all predecessors of the node finished
+         * @return Index of the new node
+         * @throw sysError if the graph is running
+         */
+        u_integer add(std::string name, std::function<void()> work);
+
+        /**
+         * @brief Adds an edge: `after` starts only once `before` finished
+         * @param before Index of the predecessor
+         * @param after Index of the successor
+         * @throw outOfBoundError if an index does not refer to a node
+         * @throw valueError if both indexes are the same node
+         * @throw sysError if the graph is running
+         * @note Cycles through several nodes are reported by the next run()
+         */
+        void precede(u_integer before, u_integer after);
+
+        /**
+         * @brief Runs every node in dependency order and waits for all of them
+         * @param delegator Thread pool running the nodes; may be the pool of the calling task,
+         *        which then runs nodes too
+         * @details The calling thread runs queued tasks of the delegator while nodes are
+         * outstanding, so even a single-worker pool completes a run started from its worker.
+         * @throw valueError if the graph has a cycle (nothing runs then)
+         * @throw sysError if the graph is already running, or the delegator is stopped
+         * @throw Whatever the first failing node threw
+         */
+        void run(taskDelegator& delegator);
+
+        /**
+         * @brief Gets the number of nodes
+         */
+        [[nodiscard]] u_integer size() const noexcept;
+
+        /**
+         * @brief Gets the name of a node
+         * @throw outOfBoundError if the index does not refer to a node
+         */
+        [[nodiscard]] const std::string& name(u_integer index) const;
+
+        /**
+         * @brief Gets how long a node ran in the last run
+         * @return Duration of the node's callable, zero if it was skipped or never ran
+         * @throw outOfBoundError if the index does not refer to a node
+         */
+        [[nodiscard]] time::duration elapsed(u_integer index) const;
+
+        /**
+         * @brief Gets when a node started in the last run, relative to the start of the run
+         * @throw outOfBoundError if the index does not refer to a node
+         */
+        [[nodiscard]] time::duration startOffset(u_integer index) const;
+
+        /**
+         * @brief Gets the wall time of the last run
+         */
+        [[nodiscard]] time::duration lastRun() const;
+
+        /**
+         * @brief Formats the timings of the last run
+         * @return One line per node: index, name, start offset and duration in microseconds
+         */
+        [[nodiscard]] std::string timings() const;
+    };
+
+} // namespace original
+
+inline original::taskGraph::node::node(std::function<void()> work, std::string name)
+    : work(std::move(work)), name(std::move(name)) {}
+
+inline original::taskGraph::taskGraph()
+    : verified_(true), delegator_(nullptr), done_(true) {}
+
+inline void original::taskGraph::check(const u_integer index) const
+{
+    if (index >= this->nodes_.size()) {
+        throw outOfBoundError("taskGraph: Node " + printable::formatString(index) +
+                              " out of bound max " + printable::formatString(this->nodes_.size()));
+    }
+}
+
+inline void original::taskGraph::checkIdle() const
+{
+    if (this->running_.load()) {
+        throw sysError("taskGraph is running");
+    }
+}
+
+inline void original::taskGraph::verify()
+{
+    if (this->verified_) {
+        return;
+    }
+    // Kahn's algorithm: every node must become ready once its predecessors are done
+    const u_integer n = this->nodes_.size();
+    vector<u_integer> indegree;
+    vector<u_integer> ready;
+    for (u_integer i = 0; i < n; ++i) {
+        indegree.pushEnd(this->nodes_[i]->predecessors);
+        if (this->nodes_[i]->predecessors == 0) {
+            ready.pushEnd(i);
+        }
+    }
+    u_integer visited = 0;
+    while (visited < ready.size()) {
+        const auto& successors = this->nodes_[ready[visited]]->successors;
+        for (u_integer i = 0; i < successors.size(); ++i) {
+            if (--indegree[successors[i]] == 0) {
+                ready.pushEnd(successors[i]);
+            }
+        }
+        visited += 1;
+    }
+    if (visited != n) {
+        throw valueError("taskGraph has a cycle through " + printable::formatString(n - visited) + " nodes");
+    }
+    this->verified_ = true;
+}
+
+inline void original::taskGraph::execute(u_integer index)
+{
+    constexpr u_integer none = static_cast<u_integer>(-1);
+    while (index != none) {
+        node& current = *this->nodes_[index];
+        current.skipped = this->failed_.load(memOrder::ACQUIRE);
+        current.started = time::point::now();
+        if (!current.skipped) {
+            try {
+                current.work();
+            } catch (...) {
+                bool expected = false;
+                if (this->failed_.exchangeCmp(expected, true)) {
+                    this->error_ = std::current_exception();
+                }
+            }
+        }
+        current.finished = time::point::now();
+
+        // The first successor made ready continues on this worker, the rest go to the delegator
+        u_integer next = none;
+        for (u_integer i = 0; i < current.successors.size(); ++i) {
+            const u_integer successor = current.successors[i];
+            auto& pending = this->nodes_[successor]->pending;
+            u_integer left = pending.load(memOrder::ACQUIRE);
+            while (!pending.exchangeCmp(left, left - 1)) {}
+            if (left != 1) {
+                continue;
+            }
+            if (next == none) {
+                next = successor;
+            } else {
+                this->dispatch(successor);
+            }
+        }
+
+        u_integer left = this->remaining_.load(memOrder::ACQUIRE);
+        while (!this->remaining_.exchangeCmp(left, left - 1)) {}
+        if (left == 1) {
+            uniqueLock lock{this->mutex_};
+            this->done_ = true;
+            this->condition_.notifyAll();
+        }
+        index = next;
+    }
+}
+
+inline void original::taskGraph::dispatch(const u_integer index)
+{
+    try {
+        this->delegator_->post(taskDelegator::NORMAL, [this, index] { this->execute(index); });
+    } catch (...) {
+        // A stopped delegator cannot take it, but the run has to finish anyway
+        this->execute(index);
+    }
+}
+
+inline void original::taskGraph::wait()
+{
+    while (this->remaining_.load(memOrder::ACQUIRE) > 0) {
+        if (this->delegator_->tryRunOne()) {
+            continue;
+        }
+        // Nothing queued: every outstanding node is running somewhere and finishes or hands off
+        uniqueLock lock{this->mutex_};
+        this->condition_.wait(this->mutex_, [this] { return this->done_; });
+    }
+    // The node that finished last counts down before it takes the mutex to set done_
+    uniqueLock lock{this->mutex_};
+    this->condition_.wait(this->mutex_, [this] { return this->done_; });
+}
+
+inline original::u_integer original::taskGraph::add(std::function<void()> work)
+{
+    return this->add(std::string{}, std::move(work));
+}
+
+inline original::u_integer original::taskGraph::add(std::string name, std::function<void()> work)
+{
+    this->checkIdle();
+    this->nodes_.pushEnd(makeStrongPtr<node>(std::move(work), std::move(name)));
+    return this->nodes_.size() - 1;
+}
+
+inline void original::taskGraph::precede(const u_integer before, const u_integer after)
+{
+    this->checkIdle();
+    this->check(before);
+    this->check(after);
+    if (before == after) {
+        throw valueError("taskGraph: A node cannot precede itself");
+    }
+    this->nodes_[before]->successors.pushEnd(after);
+    this->nodes_[after]->predecessors += 1;
+    this->verified_ = false;
+}
+
+inline void original::taskGraph::run(taskDelegator& delegator)
+{
+    bool idle = false;
+    if (!this->running_.exchangeCmp(idle, true)) {
+        throw sysError("taskGraph is already running");
+    }
+    try {
+        this->verify();
+    } catch (...) {
+        this->running_.store(false);
+        throw;
+    }
+
+    const u_integer n = this->nodes_.size();
+    this->delegator_ = &delegator;
+    this->error_ = nullptr;
+    this->failed_.store(false);
+    this->remaining_.store(n);
+    for (u_integer i = 0; i < n; ++i) {
+        this->nodes_[i]->pending.store(this->nodes_[i]->predecessors);
+        this->nodes_[i]->skipped = true;
+    }
+    this->done_ = n == 0;
+    this->run_started_ = time::point::now();
+
+    u_integer submitted = 0;
+    try {
+        for (u_integer i = 0; i < n; ++i) {
+            if (this->nodes_[i]->predecessors == 0) {
+                delegator.post(taskDelegator::NORMAL, [this, i] { this->execute(i); });
+                submitted += 1;
+            }
+        }
+    } catch (...) {
+        if (submitted == 0) {
+            this->running_.store(false);
+            throw;
+        }
+        // Some roots are already running: mark the run failed and finish the other roots here
+        bool expected = false;
+        if (this->failed_.exchangeCmp(expected, true)) {
+            this->error_ = std::current_exception();
+        }
+        u_integer roots = 0;
+        for (u_integer i = 0; i < n; ++i) {
+            if (this->nodes_[i]->predecessors == 0 && roots++ >= submitted) {
+                this->execute(i);
+            }
+        }
+    }
+
+    this->wait();
+    this->run_finished_ = time::point::now();
+    this->running_.store(false);
+    if (this->error_) {
+        std::rethrow_exception(this->error_);
+    }
+}
+
+inline original::u_integer original::taskGraph::size() const noexcept
+{
+    return this->nodes_.size();
+}
+
+inline const std::string& original::taskGraph::name(const u_integer index) const
+{
+    this->check(index);
+    return this->nodes_[index]->name;
+}
+
+inline original::time::duration original::taskGraph::elapsed(const u_integer index) const
+{
+    this->check(index);
+    const node& n = *this->nodes_[index];
+    return n.skipped ? time::duration::ZERO : n.finished - n.started;
+}
+
+inline original::time::duration original::taskGraph::startOffset(const u_integer index) const
+{
+    this->check(index);
+    const node& n = *this->nodes_[index];
+    return n.skipped ? time::duration::ZERO : n.started - this->run_started_;
+}
+
+inline original::time::duration original::taskGraph::lastRun() const
+{
+    return this->run_finished_ - this->run_started_;
+}
+
+inline std::string original::taskGraph::timings() const
+{
+    std::stringstream ss;
+    for (u_integer i = 0; i < this->nodes_.size(); ++i) {
+        const node& n = *this->nodes_[i];
+        ss << i << " " << (n.name.empty() ? "-" : n.name);
+        if (n.skipped) {
+            ss << " skipped\n";
+        } else {
+            ss << " start +" << (n.started - this->run_started_).value(time::MICROSECOND) << "us"
+               << " took " << (n.finished - n.started).value(time::MICROSECOND) << "us\n";
+        }
+    }
+    ss << "total " << this->lastRun().value(time::MICROSECOND) << "us\n";
+    return ss.str();
+}
+
+#endif //ORIGINAL_TASKGRAPH_H
@@ -17,6 +17,18 @@
  * - Deferred task handling (activate, discard, or keep on shutdown)
  * - Query interfaces for task counts and thread states
  * - Timeout-based immediate task submission
+ * - Cancellable submission: tasks whose cancellationToken is cancelled by the time a
+ *   worker dequeues them are skipped and complete with a cancelledError
+ * - Batch submission under one lock acquisition, and workers that dequeue small batches into
+ *   a local queue that idle workers and helping threads steal from
+ * - Elastic mode: workers are added up to a maximum when tasks wait and no thread is
+ *   idle, and retire down to a minimum after staying idle for a keep-alive duration
+ * - Helping: a thread waiting for tasks it submitted can run queued tasks itself
+ * - Fire-and-forget posting without a future, for callers that track completion themselves
+ * - Optional latency instrumentation: per-priority histograms of queue wait and run time,
+ *   throughput, queue depth high-water mark and per-worker utilization, read as a snapshot
+ * - Worker pinning (COMPACT, SCATTER or an EXPLICIT CPU list), so workers keep their caches
+ *   instead of migrating between cores; workers are named "tasks-<slot>"
  * - Thread-safe execution and synchronization
  *
  * @note taskDelegator is **non-copyable** and **non-movable** to prevent accidental
@@ -28,11 +40,14 @@
 
 #include "async.h"
 #include "atomic.h"
+#include "cancellation.h"
+#include "condition.h"
 #include "queue.h"
 #include "refCntPtr.h"
 #include "array.h"
-#include "prique.h"
 #include "vector.h"
+#include "zeit.h"
+#include <bit>
 
 namespace original {
 
@@ -45,6 +60,12 @@ namespace original {
      * Provides a managed thread pool that can execute tasks with different priority levels.
      * Supports immediate, high, normal, low, and deferred tasks. Deferred tasks can be
      * manually activated or discarded on shutdown.
+     *
+     * The pool either has a fixed number of workers, or is elastic between a minimum
+     * and a maximum: a submission that leaves more waiting tasks than idle or starting
+     * workers starts new ones while fewer than the maximum are alive, and a worker that
+     * waits longer than the keep-alive duration for work exits while more than the
+     * minimum are alive.
      */
     class taskDelegator {
         // ==================== Task Base Interface ====================
@@ -58,6 +79,10 @@ namespace original {
          */
         class taskBase {
         public:
+            time::point enqueued;   ///< When the task was queued, if timed
+            u_integer level = 0;    ///< Priority the task was queued with
+            bool timed = false;     ///< Whether enqueued was recorded
+
             /**
              * @brief Executes the task
              */
@@ -111,6 +136,32 @@ namespace original {
             async::future<TYPE> getFuture();
         };
 
+        // ==================== Posted Task Class ====================
+
+        /**
+         * @class postedTask
+         * @brief Task without a future, for fire-and-forget submission
+         * @tparam Callback Type of the stored callable
+         * @details Exceptions escaping the callable are dropped.
+         */
+        template<typename Callback>
+        class postedTask final : public taskBase {
+            Callback callback_;  ///< The callable
+
+        public:
+            /**
+             * @brief Constructs a posted task
+             * @param c Callable to execute
+             */
+            template<typename C>
+            explicit postedTask(C&& c);
+
+            /**
+             * @brief Executes the callable, dropping its exceptions
+             */
+            void run() override;
+        };
+
     public:
         // ==================== Task Priorities ====================
 
@@ -136,6 +187,19 @@ namespace original {
             RUN_DEFERRED,      ///< Execute all deferred tasks before stopping
         };
 
+        /**
+         * @enum pinPolicy
+         * @brief How worker slots are pinned to CPUs
+         * @details Worker slot i runs on the i-th CPU of the order below, wrapping around when
+         * there are more slots than CPUs.
+         */
+        enum class pinPolicy {
+            UNPINNED,   ///< Workers may run on any CPU
+            COMPACT,    ///< Fill a core's hardware threads, then the next core, then the next package
+            SCATTER,    ///< One worker per package, then per core, before sharing a core
+            EXPLICIT,   ///< The given CPU list, in order
+        };
+
         // Convenience constants
         static constexpr auto IMMEDIATE = priority::IMMEDIATE;
         static constexpr auto HIGH = priority::HIGH;
@@ -147,29 +211,126 @@ namespace original {
         static constexpr auto KEEP_DEFERRED = stopMode::KEEP_DEFERRED;
         static constexpr auto RUN_DEFERRED = stopMode::RUN_DEFERRED;
 
-    private:
-        // Internal type definitions
-        using priorityTask = couple<strongPtr<taskBase>, priority>;  ///< Task with priority
+        static constexpr auto UNPINNED = pinPolicy::UNPINNED;
+        static constexpr auto COMPACT = pinPolicy::COMPACT;
+        static constexpr auto SCATTER = pinPolicy::SCATTER;
+        static constexpr auto EXPLICIT = pinPolicy::EXPLICIT;
+
+        /// Number of priority levels
+        static constexpr u_integer PRIORITIES = static_cast<u_integer>(priority::DEFERRED) + 1;
+
+        // ==================== Instrumentation ====================
 
         /**
-         * @struct taskComparator
-         * @brief Comparator for ordering tasks by priority
+         * @struct histogram
+         * @brief Log2-bucketed histogram of durations
+         * @details Bucket 0 counts durations under 1 ns, bucket b (b > 0) counts durations
+         * in [2^(b-1), 2^b) ns; the last bucket also takes everything longer.
          */
-        template<typename COUPLE>
-        struct taskComparator {
+        struct histogram {
+            static constexpr u_integer BUCKETS = 48;    ///< Number of buckets
+
+            ul_integer counts[BUCKETS]{};   ///< Samples per bucket
+            ul_integer total = 0;           ///< Number of samples
+            time::duration sum{time::duration::ZERO}; ///< Sum of all samples
+            time::duration max{time::duration::ZERO}; ///< Longest sample
+
             /**
-             * @brief Compares two tasks based on priority
-             * @param lhs Left-hand side task
-             * @param rhs Right-hand side task
-             * @return True if lhs has higher priority than rhs
+             * @brief Adds a sample
+             * @param d The duration; negative ones (clock adjustments) count as zero
              */
-            bool operator()(const COUPLE& lhs, const COUPLE& rhs) const;
+            void record(const time::duration& d);
+
+            /**
+             * @brief Mean of the samples, zero if there are none
+             */
+            [[nodiscard]] time::duration mean() const;
+
+            /**
+             * @brief Approximate quantile
+             * @param fraction Quantile in [0, 1], e.g. 0.99
+             * @return Upper bound of the bucket holding the quantile, at most max
+             */
+            [[nodiscard]] time::duration percentile(double fraction) const;
         };
 
-        using priorityTaskQueue = prique<priorityTask, taskComparator, vector>;  ///< Priority queue
+        /**
+         * @struct workerStats
+         * @brief Activity of one live worker since it started or instrumentation was enabled
+         */
+        struct workerStats {
+            u_integer slot = 0;         ///< Index of the worker's slot
+            ul_integer tasks = 0;       ///< Tasks run
+            time::duration busy{time::duration::ZERO};   ///< Time spent running tasks
+            time::duration alive{time::duration::ZERO};       ///< Time observed
+
+            /**
+             * @brief Fraction of the observed time spent running tasks
+             */
+            [[nodiscard]] double utilization() const;
+        };
+
+        /**
+         * @struct statistics
+         * @brief Snapshot of the instrumentation counters
+         * @details Histograms are indexed by priority (IMMEDIATE = 0 ... DEFERRED = 4). Tasks
+         * run by helping threads (tryRunOne()) count in the histograms and in completed, but
+         * not in any worker.
+         */
+        struct statistics {
+            bool enabled = false;               ///< Whether instrumentation is on
+            time::duration elapsed{time::duration::ZERO}; ///< Time since instrumentation was enabled
+            ul_integer completed = 0;           ///< Tasks finished since then
+            u_integer queue_depth = 0;          ///< Immediate and waiting tasks now
+            u_integer queue_high_water = 0;     ///< Largest queue depth since then
+            histogram wait[PRIORITIES];         ///< Time from queueing to dequeuing, per priority
+            histogram run[PRIORITIES];          ///< Time spent running, per priority
+            vector<workerStats> workers;        ///< Live workers
+
+            /**
+             * @brief Queue wait histogram of a priority
+             */
+            [[nodiscard]] const histogram& waitOf(priority priority) const;
+
+            /**
+             * @brief Run time histogram of a priority
+             */
+            [[nodiscard]] const histogram& runOf(priority priority) const;
+
+            /**
+             * @brief Completed tasks per second since instrumentation was enabled
+             */
+            [[nodiscard]] double throughput() const;
+        };
+
+    private:
+        /// Most tasks a worker takes from the waiting queues per lock acquisition
+        static constexpr u_integer MAX_GRAB = 16;
+
+        /**
+         * @struct localQueue
+         * @brief Tasks a worker took in one go and has not started yet
+         * @details The owner pops from the front under its mutex alone; other threads steal
+         * from the front while also holding mutex_, so a task is never hidden behind a busy owner.
+         */
+        struct localQueue {
+            pMutex mutex;                        ///< Guards tasks
+            queue<strongPtr<taskBase>> tasks;    ///< Tasks in the order they are to be run
+        };
 
-        array<thread> threads_;              ///< Worker threads
-        priorityTaskQueue tasks_waiting_;    ///< Waiting tasks
+        array<thread> threads_;              ///< Worker slots, one per possible worker
+        queue<u_integer> free_slots_;        ///< Slots without a live worker (maybe an exited one to join)
+        u_integer min_threads_;              ///< Workers kept alive while idle
+        u_integer max_threads_;              ///< Upper bound on live workers
+        time::duration keep_alive_;          ///< Idle time after which a worker above the minimum exits
+        pinPolicy pin_policy_;               ///< How workers are pinned
+        array<u_integer> worker_cpus_;       ///< CPU of every slot, empty if unpinned
+        u_integer thread_cnt_;               ///< Count of live workers
+        u_integer spawned_cnt_;              ///< Workers started on demand since construction
+        u_integer retired_cnt_;              ///< Workers retired after idling since construction
+        /// Waiting tasks, one FIFO queue per priority from HIGH to DEFERRED
+        array<queue<strongPtr<taskBase>>> tasks_waiting_;
+        u_integer waiting_cnt_;              ///< Total number of waiting tasks
         queue<strongPtr<taskBase>> task_immediate_;  ///< Immediate tasks
         queue<strongPtr<taskBase>> tasks_deferred_;  ///< Deferred tasks
         mutable pCondition condition_;       ///< Synchronization
@@ -177,6 +338,28 @@ namespace original {
         bool stopped_;                       ///< Stop flag
         u_integer active_threads_;           ///< Count of active threads
         u_integer idle_threads_;             ///< Count of idle threads
+        u_integer starting_;                 ///< Workers spawned that have not reached their loop yet
+        array<strongPtr<localQueue>> local_; ///< Per-slot queue of grabbed tasks
+        atomic<u_integer> local_cnt_;        ///< Tasks in all local queues
+
+        /**
+         * @struct slotStats
+         * @brief Instrumentation counters of one worker slot
+         */
+        struct slotStats {
+            time::point since;      ///< Start of observation
+            time::duration busy{time::duration::ZERO}; ///< Time spent running tasks
+            ul_integer tasks = 0;   ///< Tasks run
+            bool live = false;      ///< Whether a worker occupies the slot
+        };
+
+        bool instrumented_;                  ///< Whether tasks are timed
+        time::point stats_since_;            ///< When instrumentation was enabled
+        ul_integer completed_;               ///< Timed tasks finished
+        u_integer queue_high_water_;         ///< Largest immediate plus waiting count
+        histogram wait_[PRIORITIES];         ///< Queue wait per priority
+        histogram run_[PRIORITIES];          ///< Run time per priority
+        array<slotStats> slot_stats_;        ///< Per-slot counters
 
         /**
          * @brief Submits a pre-created task with specified priority
@@ -188,6 +371,114 @@ namespace original {
         template<typename TYPE>
         async::future<TYPE> submit(priority priority, strongPtr<task<TYPE>>& t);
 
+        /**
+         * @brief Queues a task, starting a worker on demand, and wakes a worker for it
+         * @param priority Task priority level
+         * @param t The task, solely owned so the worker running it releases it alone
+         * @throw sysError if delegator is stopped or no idle thread is available
+         *        for IMMEDIATE submission
+         */
+        void push(priority priority, strongPtr<taskBase>&& t);
+
+        /**
+         * @brief Queues a task according to its priority
+         * @param priority Task priority level
+         * @param t The task
+         * @throw sysError for IMMEDIATE submission without an idle thread
+         * @pre mutex_ is held and the delegator is not stopped
+         */
+        void enqueue(priority priority, strongPtr<taskBase>&& t);
+
+        /**
+         * @brief Adds a task to the waiting queue of its priority
+         * @param priority HIGH, NORMAL, LOW or DEFERRED
+         * @param t The task
+         * @pre mutex_ is held
+         */
+        void pushWaiting(priority priority, strongPtr<taskBase>&& t);
+
+        /**
+         * @brief Takes the next task to run
+         * @param slot Slot of the calling worker, or max_threads_ for a helping thread
+         * @return The oldest immediate task, else the oldest waiting task of the highest priority,
+         *         else a task stolen from the front of some local queue; null if there was none
+         * @details A worker taking a waiting task also moves a fair share of the rest (at most
+         * MAX_GRAB tasks in all, highest priority first) into its local queue, and a worker
+         * stealing moves half of what the victim has left. A helping thread takes a single
+         * task. Queue waits are recorded for every task taken from the waiting queues.
+         * @pre mutex_ is held
+         */
+        strongPtr<taskBase> grab(u_integer slot);
+
+        /**
+         * @brief Pops the next task of a worker's local queue
+         * @param slot Slot of the worker
+         * @return The task, or null if other threads stole the rest
+         */
+        strongPtr<taskBase> popLocal(u_integer slot);
+
+        /**
+         * @brief Starts a worker in a free slot
+         * @details Joins the slot's previous worker first if it has retired.
+         * @pre mutex_ is held and thread_cnt_ < max_threads_
+         */
+        void spawn();
+
+        /**
+         * @brief Starts workers on demand
+         * @param wanted Number of workers the caller could use
+         * @details Starts at most `wanted` workers without exceeding max_threads_,
+         * and counts them as spawned.
+         * @pre mutex_ is held
+         */
+        void grow(u_integer wanted);
+
+        /**
+         * @brief Starts workers for waiting tasks that no idle or starting worker will take
+         * @details Workers that were spawned but have not reached their loop yet count as
+         * idle, so a burst of submissions before they run does not start extra workers.
+         * @pre mutex_ is held
+         */
+        void growForBacklog();
+
+        /**
+         * @brief Worker loop
+         * @param slot Index of the worker's slot in threads_
+         * @details Runs batches of tasks until the delegator stops, or until the worker
+         * waits longer than keep_alive_ while more than min_threads_ workers are alive.
+         */
+        void work(u_integer slot);
+
+        /**
+         * @brief Records the queue wait of a freshly dequeued task
+         * @param t The task
+         * @pre mutex_ is held
+         */
+        void recordWait(const taskBase& t);
+
+        /**
+         * @brief Records the run time of a finished task
+         * @param slot Slot of the worker that ran it, or max_threads_ for a helping thread
+         * @param level Priority of the task
+         * @param run Run time of the task
+         * @pre mutex_ is held
+         */
+        void recordRun(u_integer slot, u_integer level, const time::duration& run);
+
+        /**
+         * @brief Raises the queue depth high-water mark if needed
+         * @pre mutex_ is held
+         */
+        void noteDepth();
+
+        /**
+         * @brief Orders CPUs for pinning
+         * @param pin The policy, not UNPINNED
+         * @param cpus The CPUs to use
+         * @return The CPUs in the order slots take them
+         */
+        static vector<u_integer> pinOrder(pinPolicy pin, const vector<u_integer>& cpus);
+
     public:
         taskDelegator(const taskDelegator&) = delete;               ///< Disable copy constructor
         taskDelegator& operator=(const taskDelegator&) = delete;    ///< Disable copy assignment
@@ -200,6 +491,30 @@ namespace original {
          */
         explicit taskDelegator(u_integer thread_cnt = 8);
 
+        /**
+         * @brief Constructs a task delegator with pinned workers
+         * @param thread_cnt Number of threads
+         * @param pin How workers are pinned
+         * @param cpus CPUs to pin to; empty means every CPU the calling thread may use.
+         *        Required for EXPLICIT
+         * @throw valueError if EXPLICIT gets no CPUs or a CPU the calling thread may not use
+         */
+        taskDelegator(u_integer thread_cnt, pinPolicy pin, const vector<u_integer>& cpus = vector<u_integer>{});
+
+        /**
+         * @brief Constructs an elastic task delegator
+         * @param min_threads Workers started at once and kept alive while idle
+         * @param max_threads Upper bound on live workers
+         * @param keep_alive How long a worker above the minimum may wait for work before exiting
+         * @param pin How workers are pinned; a replacement worker takes the CPU of its slot
+         * @param cpus CPUs to pin to; empty means every CPU the calling thread may use.
+         *        Required for EXPLICIT
+         * @throw valueError if min_threads is greater than max_threads, or if EXPLICIT gets no
+         *        CPUs or a CPU the calling thread may not use
+         */
+        taskDelegator(u_integer min_threads, u_integer max_threads, time::duration keep_alive,
+                      pinPolicy pin = pinPolicy::UNPINNED, const vector<u_integer>& cpus = vector<u_integer>{});
+
         /**
          * @brief Submits a task with normal priority
          * @tparam Callback Type of the callable
@@ -244,6 +559,88 @@ namespace original {
         template<typename Callback, typename... Args>
         auto submit(time::duration timeout, Callback&& c, Args&&... args);
 
+        /**
+         * @brief Submits a cancellable task with normal priority
+         * @tparam Callback Type of the callable
+         * @tparam Args Types of the arguments
+         * @param token Token checked when a worker dequeues the task
+         * @param c Callable to execute
+         * @param args Arguments to forward to the callable
+         * @return Future for the task result
+         * @details If the token is cancelled (or its deadline has passed) by the time the
+         * task is dequeued, the callable is not run and the future holds a cancelledError.
+         * A running callable can poll its own copy of the token to stop early.
+         */
+        template<typename Callback, typename... Args>
+        auto submit(cancellationToken token, Callback&& c, Args&&... args);
+
+        /**
+         * @brief Submits a cancellable task with specified priority
+         * @tparam Callback Type of the callable
+         * @tparam Args Types of the arguments
+         * @param priority Task priority level
+         * @param token Token checked when a worker dequeues the task
+         * @param c Callable to execute
+         * @param args Arguments to forward to the callable
+         * @return Future for the task result, holding a cancelledError if the task was
+         *         skipped because of the token
+         *
+         * @throw sysError if delegator is stopped or no idle thread is available
+         *        for IMMEDIATE submission
+         */
+        template<typename Callback, typename... Args>
+        auto submit(priority priority, cancellationToken token, Callback&& c, Args&&... args);
+
+        /**
+         * @brief Submits a range of callables with normal priority
+         * @tparam Range Iterable range of callables taking no arguments
+         * @param callables The callables; moved from if the range is an rvalue
+         * @return One future per callable, in range order
+         * @see submitBatch(priority, Range&&)
+         */
+        template<typename Range>
+        auto submitBatch(Range&& callables);
+
+        /**
+         * @brief Submits a range of callables with specified priority
+         * @tparam Range Iterable range of callables taking no arguments
+         * @param priority Task priority level, shared by every callable
+         * @param callables The callables; moved from if the range is an rvalue
+         * @return One future per callable, in range order
+         * @details All tasks are queued under a single lock acquisition, and at most
+         * min(number of tasks, idle threads) workers are woken for them.
+         *
+         * @throw sysError if delegator is stopped, or if fewer idle threads than callables
+         *        are available for IMMEDIATE submission (nothing is queued then)
+         */
+        template<typename Range>
+        auto submitBatch(priority priority, Range&& callables);
+
+        /**
+         * @brief Submits a callable without a future
+         * @tparam Callback Callable taking no arguments
+         * @param priority Task priority level
+         * @param c Callable to execute; exceptions escaping it are dropped
+         * @details Cheaper than submit(): no promise or future is created. For callers that
+         * signal completion themselves, such as forkJoin and taskGraph.
+         *
+         * @throw sysError if delegator is stopped or no idle thread is available
+         *        for IMMEDIATE submission
+         */
+        template<typename Callback>
+        void post(priority priority, Callback&& c);
+
+        /**
+         * @brief Runs one queued task on the calling thread
+         * @return True if a task was run, false if no immediate, waiting or grabbed task was queued
+         * @details Takes the task the next worker would take (immediate first, then the
+         * highest waiting priority), or else steals one a worker has grabbed but not started.
+         * Meant for threads that wait for tasks they submitted:
+         * helping instead of blocking keeps nested submissions from deadlocking a small pool.
+         * Deferred tasks are not touched.
+         */
+        bool tryRunOne();
+
         /**
          * @brief Returns the number of waiting (non-immediate, non-deferred) tasks
          */
@@ -302,6 +699,69 @@ namespace original {
          */
         u_integer idleThreads() const noexcept;
 
+        /**
+         * @brief Gets the number of live worker threads
+         * @return Count of workers, whether running tasks or waiting for them
+         */
+        u_integer threadCnt() const noexcept;
+
+        /**
+         * @brief Gets the minimum number of workers
+         */
+        u_integer minThreads() const noexcept;
+
+        /**
+         * @brief Gets the maximum number of workers
+         */
+        u_integer maxThreads() const noexcept;
+
+        /**
+         * @brief Gets the idle time after which a worker above the minimum exits
+         */
+        time::duration keepAlive() const noexcept;
+
+        /**
+         * @brief Gets the number of workers started on demand since construction
+         */
+        u_integer spawnedCnt() const noexcept;
+
+        /**
+         * @brief Gets the number of workers retired after idling since construction
+         */
+        u_integer retiredCnt() const noexcept;
+
+        /**
+         * @brief Gets how workers are pinned
+         */
+        pinPolicy pinning() const noexcept;
+
+        /**
+         * @brief Gets the CPU every worker slot is pinned to
+         * @return One CPU per slot, indexed like workerStats::slot; empty if unpinned
+         */
+        const array<u_integer>& workerCpus() const noexcept;
+
+        /**
+         * @brief Turns latency instrumentation on or off
+         * @param enabled Whether to time tasks
+         * @details Turning it on clears all counters. While on, every task costs a few clock
+         * reads, and the counters are updated under the lock workers take once per batch anyway.
+         * Tasks queued before it was turned on do not count in the wait histograms.
+         */
+        void instrument(bool enabled);
+
+        /**
+         * @brief Whether latency instrumentation is on
+         */
+        bool instrumented() const noexcept;
+
+        /**
+         * @brief Takes a snapshot of the instrumentation counters
+         * @details Takes the lock briefly, like the other queries; workers keep running.
+         * Tasks being run at that moment are counted once they finish.
+         */
+        statistics stats() const;
+
         /**
          * @brief Destructor
          * @details Calls stop(RUN_DEFERRED) and joins all threads
@@ -331,61 +791,389 @@ original::async::future<TYPE> original::taskDelegator::task<TYPE>::getFuture()
     return this->p.getFuture();
 }
 
-// ==================== Task Delegator Implementation ====================
+template <typename Callback>
+template <typename C>
+original::taskDelegator::postedTask<Callback>::postedTask(C&& c)
+    : callback_(std::forward<C>(c)) {}
 
-template <typename COUPLE>
-bool original::taskDelegator::taskComparator<COUPLE>::operator()(const COUPLE& lhs, const COUPLE& rhs) const
+template <typename Callback>
+void original::taskDelegator::postedTask<Callback>::run()
 {
-    return static_cast<u_integer>(lhs.second()) < static_cast<u_integer>(rhs.second());
+    try {
+        this->callback_();
+    } catch (...) {
+        // Nobody waits for a posted task, so there is nobody to report to
+    }
 }
 
+// ==================== Task Delegator Implementation ====================
+
 inline original::taskDelegator::taskDelegator(const u_integer thread_cnt)
-    : threads_(thread_cnt),
+    : taskDelegator(thread_cnt, thread_cnt, time::duration::ZERO) {}
+
+inline original::taskDelegator::taskDelegator(const u_integer thread_cnt, const pinPolicy pin,
+                                              const vector<u_integer>& cpus)
+    : taskDelegator(thread_cnt, thread_cnt, time::duration::ZERO, pin, cpus) {}
+
+inline original::taskDelegator::taskDelegator(const u_integer min_threads, const u_integer max_threads,
+                                              const time::duration keep_alive, const pinPolicy pin,
+                                              const vector<u_integer>& cpus)
+    : threads_(max_threads),
+      min_threads_(min_threads),
+      max_threads_(max_threads),
+      keep_alive_(keep_alive),
+      pin_policy_(pin),
+      thread_cnt_(0),
+      spawned_cnt_(0),
+      retired_cnt_(0),
+      tasks_waiting_(static_cast<u_integer>(priority::DEFERRED)),
+      waiting_cnt_(0),
       stopped_(false),
       active_threads_(0),
-      idle_threads_(0) {
-    for (auto& thread_ : this->threads_) {
-        thread_ = thread {
-            [this]{
-                while (true) {
-                    strongPtr<taskBase> task;
-                    {
-                        uniqueLock lock(this->mutex_);
-                        this->idle_threads_ += 1;
-                        this->condition_.wait(this->mutex_, [this] {
-                            return this->stopped_ || !this->tasks_waiting_.empty() || !this->task_immediate_.empty();
-                        });
-
-                        if (this->stopped_ &&
-                            this->tasks_waiting_.empty() &&
-                            this->task_immediate_.empty()) {
-                                this->idle_threads_ -= 1;
-                                return;
-                        }
-
-                        if (!this->task_immediate_.empty()) {
-                            task = std::move(this->task_immediate_.pop());
-                        } else {
-                            task = std::move(this->tasks_waiting_.pop().first());
-                        }
-                        this->idle_threads_ -= 1;
-                    }
+      idle_threads_(0),
+      starting_(0),
+      local_(max_threads),
+      local_cnt_(makeAtomic<u_integer>(0)),
+      instrumented_(false),
+      completed_(0),
+      queue_high_water_(0),
+      slot_stats_(max_threads) {
+    if (min_threads > max_threads) {
+        throw valueError("Minimum thread count exceeds maximum thread count");
+    }
+    if (pin != pinPolicy::UNPINNED) {
+        // Checked before any worker starts: a worker failing to start here could not be stopped
+        const vector<u_integer> available = thread::availableCpus();
+        if (pin == pinPolicy::EXPLICIT && cpus.empty()) {
+            throw valueError("Explicit pinning needs at least one CPU");
+        }
+        for (u_integer i = 0; i < cpus.size(); ++i) {
+            if (!available.contains(cpus[i])) {
+                throw valueError("CPU " + std::to_string(cpus[i]) + " is not available to this thread");
+            }
+        }
+        const vector<u_integer> order = pinOrder(pin, cpus.empty() ? available : cpus);
+        this->worker_cpus_ = array<u_integer>(max_threads);
+        for (u_integer i = 0; i < max_threads; ++i) {
+            this->worker_cpus_[i] = order[i % order.size()];
+        }
+    }
+    for (u_integer i = 0; i < max_threads; ++i) {
+        this->free_slots_.push(i);
+        this->local_[i] = makeStrongPtr<localQueue>();
+    }
+    uniqueLock lock(this->mutex_);
+    for (u_integer i = 0; i < min_threads; ++i) {
+        this->spawn();
+    }
+}
 
-                    {
-                        uniqueLock lock(this->mutex_);
-                        this->active_threads_ += 1;
-                    }
-                    task->run();
-                    {
-                        uniqueLock lock(this->mutex_);
-                        this->active_threads_ -= 1;
+inline void original::taskDelegator::spawn()
+{
+    const u_integer slot = this->free_slots_.head();
+    // A retired worker left the critical section before its slot was freed, so this does not block long
+    if (this->threads_[slot].joinable()) {
+        this->threads_[slot].join();
+    }
+    threadOptions options;
+    options.name("tasks-" + std::to_string(slot));
+    if (this->pin_policy_ != pinPolicy::UNPINNED) {
+        options.pin(this->worker_cpus_[slot]);
+    }
+    this->threads_[slot] = thread{options, [this, slot] { this->work(slot); }};
+    this->free_slots_.pop();
+    this->thread_cnt_ += 1;
+    this->starting_ += 1;
+    this->slot_stats_[slot] = slotStats{time::point::now(), time::duration::ZERO, 0, true};
+}
+
+inline original::vector<original::u_integer>
+original::taskDelegator::pinOrder(const pinPolicy pin, const vector<u_integer>& cpus)
+{
+    if (pin == pinPolicy::EXPLICIT) {
+        return cpus;
+    }
+    // Sort keys carry the CPU number in their low 16 bits
+    auto insertSorted = [](vector<ul_integer>& keys, const ul_integer key) {
+        u_integer at = keys.size();
+        while (at > 0 && keys[at - 1] > key) {
+            --at;
+        }
+        at == keys.size() ? keys.pushEnd(key) : keys.push(at, key);
+    };
+
+    // Compact order: by package, then core, then CPU number, so SMT siblings are adjacent
+    vector<ul_integer> compact;
+    for (u_integer i = 0; i < cpus.size(); ++i) {
+        const ul_integer package = thread::cpuPackage(cpus[i]) & 0xFFFF;
+        const ul_integer core = thread::cpuCore(cpus[i]) & 0xFFFFFFFF;
+        insertSorted(compact, package << 48 | core << 16 | cpus[i]);
+    }
+
+    vector<ul_integer> keys;
+    if (pin == pinPolicy::COMPACT) {
+        keys = compact;
+    } else {
+        // Scatter order: first sibling of every core, cycling through packages, then second siblings...
+        ul_integer package_idx = 0, core_idx = 0, sibling = 0;
+        for (u_integer i = 0; i < compact.size(); ++i) {
+            if (i > 0) {
+                if (compact[i] >> 48 != compact[i - 1] >> 48) {
+                    package_idx += 1;
+                    core_idx = 0;
+                    sibling = 0;
+                } else if (compact[i] >> 16 != compact[i - 1] >> 16) {
+                    core_idx += 1;
+                    sibling = 0;
+                } else {
+                    sibling += 1;
+                }
+            }
+            insertSorted(keys, sibling << 48 | core_idx << 32 | package_idx << 16 | (compact[i] & 0xFFFF));
+        }
+    }
+
+    vector<u_integer> order;
+    for (u_integer i = 0; i < keys.size(); ++i) {
+        order.pushEnd(static_cast<u_integer>(keys[i] & 0xFFFF));
+    }
+    return order;
+}
+
+inline void original::taskDelegator::grow(const u_integer wanted)
+{
+    for (u_integer i = 0; i < wanted && this->thread_cnt_ < this->max_threads_; ++i) {
+        this->spawn();
+        this->spawned_cnt_ += 1;
+    }
+}
+
+inline void original::taskDelegator::growForBacklog()
+{
+    const u_integer ready = this->idle_threads_ + this->starting_;
+    if (this->waiting_cnt_ > ready) {
+        this->grow(this->waiting_cnt_ - ready);
+    }
+}
+
+inline void original::taskDelegator::work(const u_integer slot)
+{
+    const auto ready = [this] {
+        return this->stopped_ || this->waiting_cnt_ > 0 || !this->task_immediate_.empty() ||
+               this->local_cnt_.load() > 0;
+    };
+    strongPtr<taskBase> next;
+    array<u_integer> levels(MAX_GRAB);
+    array<time::duration> runs(MAX_GRAB);
+    u_integer ran = 0;
+    bool started = false;
+    bool timed = false;
+    bool wake = false;
+    while (true) {
+        {
+            uniqueLock lock(this->mutex_);
+            if (!started) {
+                this->starting_ -= 1;
+                started = true;
+            }
+            if (ran > 0) {
+                this->active_threads_ -= 1;
+                if (timed && this->instrumented_) {
+                    for (u_integer i = 0; i < ran; ++i) {
+                        this->recordRun(slot, levels[i], runs[i]);
                     }
                 }
             }
-        };
+            this->idle_threads_ += 1;
+            if (this->thread_cnt_ > this->min_threads_) {
+                if (!this->condition_.waitFor(this->mutex_, this->keep_alive_, ready) &&
+                    this->thread_cnt_ > this->min_threads_) {
+                    this->idle_threads_ -= 1;
+                    this->thread_cnt_ -= 1;
+                    this->retired_cnt_ += 1;
+                    this->slot_stats_[slot].live = false;
+                    this->free_slots_.push(slot);
+                    return;
+                }
+            } else {
+                this->condition_.wait(this->mutex_, ready);
+            }
+            this->idle_threads_ -= 1;
+
+            next = this->grab(slot);
+            if (!next) {
+                if (this->stopped_ && this->local_cnt_.load() == 0) {
+                    return;
+                }
+                // Timed out but has to stay, or lost a steal to another thread
+                ran = 0;
+                continue;
+            }
+            this->active_threads_ += 1;
+            timed = this->instrumented_;
+            // Grabbed tasks left over can go to a sleeping worker, which passes the wake-up on
+            wake = this->local_cnt_.load() > 0 && this->idle_threads_ > 0;
+        }
+        if (wake) {
+            this->condition_.notify();
+        }
+
+        ran = 0;
+        time::point last;
+        if (timed) {
+            last = time::point::now();
+        }
+        while (next) {
+            if (timed) {
+                levels[ran] = next->level;
+            }
+            next->run();
+            next = strongPtr<taskBase>{};
+            if (timed) {
+                const time::point now = time::point::now();
+                runs[ran] = now - last;
+                last = now;
+            }
+            ran += 1;
+            next = this->popLocal(slot);
+        }
+    }
+}
+
+inline void original::taskDelegator::enqueue(const priority priority, strongPtr<taskBase>&& t)
+{
+    t->level = static_cast<u_integer>(priority);
+    t->timed = this->instrumented_;
+    if (t->timed) {
+        t->enqueued = time::point::now();
+    }
+    switch (priority) {
+    case priority::IMMEDIATE:
+        if (this->idle_threads_ == 0) {
+            throw sysError("No idle threads now");
+        }
+        this->task_immediate_.push(std::move(t));
+        this->noteDepth();
+        break;
+    case priority::HIGH:
+    case priority::NORMAL:
+    case priority::LOW:
+        this->pushWaiting(priority, std::move(t));
+        break;
+    case priority::DEFERRED:
+        this->tasks_deferred_.push(std::move(t));
+        break;
+    default:
+        throw sysError("Unknown priority");
+    }
+}
+
+inline void original::taskDelegator::pushWaiting(const priority priority, strongPtr<taskBase>&& t)
+{
+    if (priority == priority::DEFERRED) {
+        // Deferred tasks wait from activation; their time on hold is not queueing
+        t->timed = this->instrumented_;
+        if (t->timed) {
+            t->enqueued = time::point::now();
+        }
+    }
+    this->tasks_waiting_[static_cast<u_integer>(priority) - 1].push(std::move(t));
+    this->waiting_cnt_ += 1;
+    this->noteDepth();
+}
+
+inline void original::taskDelegator::noteDepth()
+{
+    const u_integer depth = this->waiting_cnt_ + this->task_immediate_.size();
+    if (depth > this->queue_high_water_) {
+        this->queue_high_water_ = depth;
     }
 }
 
+inline void original::taskDelegator::recordWait(const taskBase& t)
+{
+    if (t.timed) {
+        this->wait_[t.level].record(time::point::now() - t.enqueued);
+    }
+}
+
+inline void original::taskDelegator::recordRun(const u_integer slot, const u_integer level,
+                                               const time::duration& run)
+{
+    this->run_[level].record(run);
+    this->completed_ += 1;
+    if (slot < this->max_threads_) {
+        this->slot_stats_[slot].busy += run;
+        this->slot_stats_[slot].tasks += 1;
+    }
+}
+
+inline original::strongPtr<original::taskDelegator::taskBase> original::taskDelegator::grab(const u_integer slot)
+{
+    if (!this->task_immediate_.empty()) {
+        strongPtr<taskBase> next = this->task_immediate_.pop();
+        if (this->instrumented_) {
+            this->recordWait(*next);
+        }
+        return next;
+    }
+    if (this->waiting_cnt_ == 0) {
+        // Stolen tasks had their waits recorded when they were grabbed
+        for (u_integer i = 1; i <= this->max_threads_ && this->local_cnt_.load() > 0; ++i) {
+            localQueue& victim = *this->local_[(slot + i) % this->max_threads_];
+            uniqueLock lock(victim.mutex);
+            if (victim.tasks.empty()) {
+                continue;
+            }
+            strongPtr<taskBase> next = victim.tasks.pop();
+            this->local_cnt_ -= 1;
+            if (slot < this->max_threads_) {
+                // A worker takes half of what is left, so thieves do not come back for every task
+                for (u_integer n = victim.tasks.size() / 2; n > 0; --n) {
+                    this->local_[slot]->tasks.push(victim.tasks.pop());
+                }
+            }
+            return next;
+        }
+        return strongPtr<taskBase>{};
+    }
+    // A fair share of the backlog, so one worker does not hoard tasks others could run
+    u_integer share = slot < this->max_threads_ ? this->waiting_cnt_ / this->thread_cnt_ : 1;
+    share = share == 0 ? 1 : share < MAX_GRAB ? share : MAX_GRAB;
+    strongPtr<taskBase> next;
+    u_integer taken = 0;
+    for (u_integer level = 0; level < this->tasks_waiting_.size() && taken < share; ++level) {
+        auto& waiting = this->tasks_waiting_[level];
+        while (!waiting.empty() && taken < share) {
+            strongPtr<taskBase> t = waiting.pop();
+            if (this->instrumented_) {
+                this->recordWait(*t);
+            }
+            if (taken == 0) {
+                next = std::move(t);
+            } else {
+                // Only the owner pushes, and only under mutex_, which thieves hold as well
+                this->local_[slot]->tasks.push(std::move(t));
+            }
+            taken += 1;
+        }
+    }
+    this->waiting_cnt_ -= taken;
+    this->local_cnt_ += taken - 1;
+    return next;
+}
+
+inline original::strongPtr<original::taskDelegator::taskBase> original::taskDelegator::popLocal(const u_integer slot)
+{
+    localQueue& own = *this->local_[slot];
+    uniqueLock lock(own.mutex);
+    if (own.tasks.empty()) {
+        return strongPtr<taskBase>{};
+    }
+    this->local_cnt_ -= 1;
+    return own.tasks.pop();
+}
+
 template <typename Callback, typename ... Args>
 auto original::taskDelegator::submit(Callback&& c, Args&&... args)
 {
@@ -423,16 +1211,62 @@ auto original::taskDelegator::submit(time::duration timeout, Callback&& c, Args&
         if (!success) {
             throw sysError("No idle threads available within timeout");
         }
-        this->task_immediate_.push(std::move(new_task.template dynamicCastTo<taskBase>()));
+        this->enqueue(priority::IMMEDIATE, new_task.template dynamicCastTo<taskBase>());
+        new_task = strongPtr<task<ReturnType>>{};
     }
     this->condition_.notify();
     return f;
 }
 
+template <typename Callback, typename ... Args>
+auto original::taskDelegator::submit(cancellationToken token, Callback&& c, Args&&... args)
+{
+    return this->submit(priority::NORMAL, std::move(token), std::forward<Callback>(c), std::forward<Args>(args)...);
+}
+
+template <typename Callback, typename ... Args>
+auto original::taskDelegator::submit(const priority priority, cancellationToken token, Callback&& c, Args&&... args)
+{
+    return this->submit(priority,
+        [token = std::move(token), c = std::forward<Callback>(c)](auto&&... params) mutable {
+            token.throwIfCancelled();
+            return c(std::forward<decltype(params)>(params)...);
+        },
+        std::forward<Args>(args)...
+    );
+}
+
+inline bool original::taskDelegator::tryRunOne()
+{
+    strongPtr<taskBase> next;
+    bool timed;
+    {
+        uniqueLock lock(this->mutex_);
+        next = this->grab(this->max_threads_);
+        if (!next) {
+            return false;
+        }
+        timed = this->instrumented_;
+    }
+    if (!timed) {
+        next->run();
+        return true;
+    }
+    const u_integer level = next->level;
+    const time::point start = time::point::now();
+    next->run();
+    const time::duration run = time::point::now() - start;
+    uniqueLock lock(this->mutex_);
+    if (this->instrumented_) {
+        this->recordRun(this->max_threads_, level, run);
+    }
+    return true;
+}
+
 inline original::u_integer original::taskDelegator::waitingCnt() const noexcept
 {
     uniqueLock lock(this->mutex_);
-    return this->tasks_waiting_.size();
+    return this->waiting_cnt_;
 }
 
 inline original::u_integer original::taskDelegator::immediateCnt() const noexcept
@@ -446,32 +1280,94 @@ original::async::future<TYPE>
 original::taskDelegator::submit(const priority priority, strongPtr<task<TYPE>>& t)
 {
     auto f = t->getFuture();
+    strongPtr<taskBase> base = t.template dynamicCastTo<taskBase>();
+    t = strongPtr<task<TYPE>>{};
+    this->push(priority, std::move(base));
+    return f;
+}
+
+inline void original::taskDelegator::push(const priority priority, strongPtr<taskBase>&& t)
+{
+    bool wake;
     {
         uniqueLock lock(this->mutex_);
         if (this->stopped_) {
             throw sysError("taskDelegator already stopped");
         }
-        switch (priority) {
-        case priority::IMMEDIATE:
-            if (this->idle_threads_ == 0) {
-                throw sysError("No idle threads now");
-            }
-            this->task_immediate_.push(std::move(t.template dynamicCastTo<taskBase>()));
-            break;
-        case priority::HIGH:
-        case priority::NORMAL:
-        case priority::LOW:
-            this->tasks_waiting_.push(priorityTask{t.template dynamicCastTo<taskBase>(), priority});
-            break;
-        case priority::DEFERRED:
-            this->tasks_deferred_.push(t.template dynamicCastTo<taskBase>());
-            return f;
-        default:
-            throw sysError("Unknown priority");
+        this->enqueue(priority, std::move(t));
+        // The queue owns the task from here, so a worker never shares its release with the submitter
+        t = strongPtr<taskBase>{};
+        if (priority != priority::IMMEDIATE && priority != priority::DEFERRED) {
+            this->growForBacklog();
         }
+        // Busy workers find the task when they come back for more; only sleeping ones need a signal
+        wake = priority != priority::DEFERRED && this->idle_threads_ > 0;
+    }
+    if (wake) {
+        this->condition_.notify();
     }
-    this->condition_.notify();
-    return f;
+}
+
+template <typename Callback>
+void original::taskDelegator::post(const priority priority, Callback&& c)
+{
+    strongPtr<taskBase> t = makeStrongPtr<postedTask<std::decay_t<Callback>>>(std::forward<Callback>(c))
+        .template dynamicCastTo<taskBase>();
+    this->push(priority, std::move(t));
+}
+
+template <typename Range>
+auto original::taskDelegator::submitBatch(Range&& callables)
+{
+    return this->submitBatch(priority::NORMAL, std::forward<Range>(callables));
+}
+
+template <typename Range>
+auto original::taskDelegator::submitBatch(const priority priority, Range&& callables)
+{
+    using Callback = std::remove_cvref_t<decltype(*std::begin(callables))>;
+    using ReturnType = std::invoke_result_t<Callback&>;
+
+    u_integer n = 0;
+    for (auto it = std::begin(callables); it != std::end(callables); ++it) {
+        n += 1;
+    }
+    array<strongPtr<taskBase>> tasks(n);
+    array<async::future<ReturnType>> futures(n);
+    u_integer i = 0;
+    for (auto it = std::begin(callables); it != std::end(callables); ++it, ++i) {
+        strongPtr<task<ReturnType>> new_task;
+        if constexpr (std::is_rvalue_reference_v<Range&&>) {
+            new_task = makeStrongPtr<task<ReturnType>>(std::move(*it));
+        } else {
+            new_task = makeStrongPtr<task<ReturnType>>(*it);
+        }
+        futures[i] = new_task->getFuture();
+        tasks[i] = new_task.template dynamicCastTo<taskBase>();
+    }
+
+    u_integer wake = 0;
+    {
+        uniqueLock lock(this->mutex_);
+        if (this->stopped_) {
+            throw sysError("taskDelegator already stopped");
+        }
+        if (priority == priority::IMMEDIATE && this->idle_threads_ < n) {
+            throw sysError("Not enough idle threads now");
+        }
+        for (i = 0; i < n; ++i) {
+            this->enqueue(priority, std::move(tasks[i]));
+            tasks[i] = strongPtr<taskBase>{};
+        }
+        if (priority != priority::IMMEDIATE && priority != priority::DEFERRED) {
+            this->growForBacklog();
+        }
+        if (priority != priority::DEFERRED) {
+            wake = n < this->idle_threads_ ? n : this->idle_threads_;
+        }
+    }
+    this->condition_.notifySome(wake);
+    return futures;
 }
 
 inline void original::taskDelegator::runDeferred()
@@ -479,7 +1375,8 @@ inline void original::taskDelegator::runDeferred()
     {
         uniqueLock lock(this->mutex_);
         if (!this->tasks_deferred_.empty()) {
-            this->tasks_waiting_.push(priorityTask{this->tasks_deferred_.pop(), priority::DEFERRED});
+            this->pushWaiting(priority::DEFERRED, this->tasks_deferred_.pop());
+            this->growForBacklog();
         } else {
             return;
         }
@@ -495,8 +1392,9 @@ inline void original::taskDelegator::runAllDeferred()
             return;
         }
         while (!this->tasks_deferred_.empty()) {
-            this->tasks_waiting_.push(priorityTask{this->tasks_deferred_.pop(), priority::DEFERRED});
+            this->pushWaiting(priority::DEFERRED, this->tasks_deferred_.pop());
         }
+        this->growForBacklog();
     }
     this->condition_.notifyAll();
 }
@@ -531,7 +1429,7 @@ inline void original::taskDelegator::stop(const stopMode mode)
         switch (mode) {
         case RUN_DEFERRED:
             while (!this->tasks_deferred_.empty()) {
-                this->tasks_waiting_.push(priorityTask{this->tasks_deferred_.pop(), DEFERRED});
+                this->pushWaiting(DEFERRED, this->tasks_deferred_.pop());
             }
             break;
         case DISCARD_DEFERRED:
@@ -559,6 +1457,167 @@ inline original::u_integer original::taskDelegator::idleThreads() const noexcept
     return this->idle_threads_;
 }
 
+inline original::u_integer original::taskDelegator::threadCnt() const noexcept
+{
+    uniqueLock lock(this->mutex_);
+    return this->thread_cnt_;
+}
+
+inline original::u_integer original::taskDelegator::minThreads() const noexcept
+{
+    return this->min_threads_;
+}
+
+inline original::u_integer original::taskDelegator::maxThreads() const noexcept
+{
+    return this->max_threads_;
+}
+
+inline original::time::duration original::taskDelegator::keepAlive() const noexcept
+{
+    return this->keep_alive_;
+}
+
+inline original::u_integer original::taskDelegator::spawnedCnt() const noexcept
+{
+    uniqueLock lock(this->mutex_);
+    return this->spawned_cnt_;
+}
+
+inline original::u_integer original::taskDelegator::retiredCnt() const noexcept
+{
+    uniqueLock lock(this->mutex_);
+    return this->retired_cnt_;
+}
+
+inline original::taskDelegator::pinPolicy original::taskDelegator::pinning() const noexcept
+{
+    return this->pin_policy_;
+}
+
+inline const original::array<original::u_integer>& original::taskDelegator::workerCpus() const noexcept
+{
+    return this->worker_cpus_;
+}
+
+inline void original::taskDelegator::instrument(const bool enabled)
+{
+    uniqueLock lock(this->mutex_);
+    if (enabled && !this->instrumented_) {
+        const time::point now = time::point::now();
+        this->stats_since_ = now;
+        this->completed_ = 0;
+        this->queue_high_water_ = this->waiting_cnt_ + this->task_immediate_.size();
+        for (u_integer i = 0; i < PRIORITIES; ++i) {
+            this->wait_[i] = histogram{};
+            this->run_[i] = histogram{};
+        }
+        for (u_integer i = 0; i < this->slot_stats_.size(); ++i) {
+            this->slot_stats_[i].since = now;
+            this->slot_stats_[i].busy = time::duration::ZERO;
+            this->slot_stats_[i].tasks = 0;
+        }
+    }
+    this->instrumented_ = enabled;
+}
+
+inline bool original::taskDelegator::instrumented() const noexcept
+{
+    uniqueLock lock(this->mutex_);
+    return this->instrumented_;
+}
+
+inline original::taskDelegator::statistics original::taskDelegator::stats() const
+{
+    statistics snapshot;
+    uniqueLock lock(this->mutex_);
+    const time::point now = time::point::now();
+    snapshot.enabled = this->instrumented_;
+    snapshot.elapsed = now - this->stats_since_;
+    snapshot.completed = this->completed_;
+    snapshot.queue_depth = this->waiting_cnt_ + this->task_immediate_.size();
+    snapshot.queue_high_water = this->queue_high_water_;
+    for (u_integer i = 0; i < PRIORITIES; ++i) {
+        snapshot.wait[i] = this->wait_[i];
+        snapshot.run[i] = this->run_[i];
+    }
+    for (u_integer i = 0; i < this->slot_stats_.size(); ++i) {
+        const slotStats& slot = this->slot_stats_[i];
+        if (slot.live) {
+            snapshot.workers.pushEnd(workerStats{i, slot.tasks, slot.busy, now - slot.since});
+        }
+    }
+    return snapshot;
+}
+
+inline void original::taskDelegator::histogram::record(const time::duration& d)
+{
+    const time::time_val_type ns = d.value(time::NANOSECOND);
+    const ul_integer v = ns > 0 ? static_cast<ul_integer>(ns) : 0;
+    const u_integer bucket = static_cast<u_integer>(std::bit_width(v));
+    this->counts[bucket < BUCKETS ? bucket : BUCKETS - 1] += 1;
+    this->total += 1;
+    const time::duration sample{static_cast<time::time_val_type>(v), time::NANOSECOND};
+    this->sum += sample;
+    if (sample > this->max) {
+        this->max = sample;
+    }
+}
+
+inline original::time::duration original::taskDelegator::histogram::mean() const
+{
+    return this->total == 0 ? time::duration::ZERO
+                            : this->sum / static_cast<time::time_val_type>(this->total);
+}
+
+inline original::time::duration original::taskDelegator::histogram::percentile(const double fraction) const
+{
+    if (this->total == 0) {
+        return time::duration::ZERO;
+    }
+    const double clamped = fraction < 0 ? 0 : fraction > 1 ? 1 : fraction;
+    ul_integer rank = static_cast<ul_integer>(clamped * static_cast<double>(this->total));
+    rank = rank == 0 ? 1 : rank;
+    ul_integer seen = 0;
+    for (u_integer b = 0; b < BUCKETS; ++b) {
+        seen += this->counts[b];
+        if (seen >= rank) {
+            if (b == BUCKETS - 1) {
+                break;
+            }
+            const time::duration bound{static_cast<time::time_val_type>(1) << b, time::NANOSECOND};
+            return bound < this->max ? bound : this->max;
+        }
+    }
+    return this->max;
+}
+
+inline double original::taskDelegator::workerStats::utilization() const
+{
+    const auto alive_ns = this->alive.value(time::NANOSECOND);
+    return alive_ns <= 0 ? 0.0
+                         : static_cast<double>(this->busy.value(time::NANOSECOND)) / static_cast<double>(alive_ns);
+}
+
+inline const original::taskDelegator::histogram&
+original::taskDelegator::statistics::waitOf(const priority priority) const
+{
+    return this->wait[static_cast<u_integer>(priority)];
+}
+
+inline const original::taskDelegator::histogram&
+original::taskDelegator::statistics::runOf(const priority priority) const
+{
+    return this->run[static_cast<u_integer>(priority)];
+}
+
+inline double original::taskDelegator::statistics::throughput() const
+{
+    const auto elapsed_ns = this->elapsed.value(time::NANOSECOND);
+    return elapsed_ns <= 0 ? 0.0
+                           : static_cast<double>(this->completed) * 1e9 / static_cast<double>(elapsed_ns);
+}
+
 inline original::taskDelegator::~taskDelegator()
 {
     this->stop(stopMode::RUN_DEFERRED);
@@ -5,7 +5,14 @@
 #include "functional"
 #include "pthread.h"
 #include "ownerPtr.h"
+#include "vector.h"
 #include "zeit.h"
+#include <fstream>
+#include <sched.h>
+#include <string>
+#if !ORIGINAL_PLATFORM_WINDOWS
+#include <unistd.h>
+#endif
 
 
 /**
@@ -16,6 +23,8 @@
  * - High-level RAII thread management (thread)
  * - Exception-safe thread operations
  * - Flexible join/detach policies
+ * - Creation-time scheduling attributes (threadOptions): name, stack size,
+ *   CPU affinity and scheduling policy
  */
 
 namespace original {
@@ -140,6 +149,107 @@ namespace original {
         std::string toString(bool enter) const override;
     };
 
+    /**
+     * @class threadOptions
+     * @brief Scheduling attributes applied when a thread is created
+     * @details Setters return the object so options can be chained; anything left unset
+     * keeps the system default:
+     * @code
+     * original::thread t(original::threadOptions{}.name("io").pin(2), [] {
+     *     // runs on CPU 2 only
+     * });
+     * @endcode
+     *
+     * @note Affinity and names are applied on Linux only and ignored elsewhere. Names
+     *       longer than 15 characters are truncated, the limit of the kernel.
+     */
+    class threadOptions final : public printable {
+    public:
+        /**
+         * @enum schedPolicy
+         * @brief Scheduling policy of a new thread
+         */
+        enum class schedPolicy {
+            INHERIT,     ///< Same policy and priority as the creating thread
+            OTHER,       ///< Default time-sharing policy
+            BATCH,       ///< Time-sharing, for CPU-bound non-interactive work (Linux)
+            IDLE,        ///< Runs only when nothing else wants the CPU (Linux)
+            FIFO,        ///< Real-time first-in first-out; usually needs privileges
+            ROUND_ROBIN, ///< Real-time round robin; usually needs privileges
+        };
+
+        static constexpr auto INHERIT = schedPolicy::INHERIT;          ///< Alias for schedPolicy::INHERIT
+        static constexpr auto OTHER = schedPolicy::OTHER;              ///< Alias for schedPolicy::OTHER
+        static constexpr auto BATCH = schedPolicy::BATCH;              ///< Alias for schedPolicy::BATCH
+        static constexpr auto IDLE = schedPolicy::IDLE;                ///< Alias for schedPolicy::IDLE
+        static constexpr auto FIFO = schedPolicy::FIFO;                ///< Alias for schedPolicy::FIFO
+        static constexpr auto ROUND_ROBIN = schedPolicy::ROUND_ROBIN;  ///< Alias for schedPolicy::ROUND_ROBIN
+
+    private:
+        std::string name_;          ///< Thread name, empty for none
+        u_integer stack_size_;      ///< Stack size in bytes, 0 for the default
+        vector<u_integer> cpus_;    ///< CPUs the thread may run on, empty for all
+        schedPolicy policy_;        ///< Scheduling policy
+        integer priority_;          ///< Static priority for real-time policies
+
+    public:
+        /**
+         * @brief Options keeping every system default
+         */
+        threadOptions();
+
+        /**
+         * @brief Sets the thread name shown by debuggers and tools like top -H
+         * @param name The name
+         */
+        threadOptions& name(std::string name);
+
+        /**
+         * @brief Sets the stack size
+         * @param bytes Stack size in bytes; 0 keeps the default, small sizes are raised to
+         *        the system minimum
+         */
+        threadOptions& stackSize(u_integer bytes);
+
+        /**
+         * @brief Restricts the thread to a set of CPUs
+         * @param cpus CPU numbers; empty allows every CPU
+         */
+        threadOptions& affinity(const vector<u_integer>& cpus);
+
+        /**
+         * @brief Restricts the thread to one CPU
+         * @param cpu CPU number
+         */
+        threadOptions& pin(u_integer cpu);
+
+        /**
+         * @brief Sets the scheduling policy
+         * @param policy The policy
+         * @param priority Static priority, used by FIFO and ROUND_ROBIN only
+         */
+        threadOptions& schedule(schedPolicy policy, integer priority = 0);
+
+        /// @brief Thread name, empty if unset
+        [[nodiscard]] const std::string& name() const noexcept;
+
+        /// @brief Stack size in bytes, 0 if unset
+        [[nodiscard]] u_integer stackSize() const noexcept;
+
+        /// @brief CPUs the thread may run on, empty if unrestricted
+        [[nodiscard]] const vector<u_integer>& affinity() const noexcept;
+
+        /// @brief Scheduling policy
+        [[nodiscard]] schedPolicy policy() const noexcept;
+
+        /// @brief Static priority for real-time policies
+        [[nodiscard]] integer priority() const noexcept;
+
+        std::string className() const override;
+
+        std::string toString(bool enter) const override;
+    };
+
     /**
      * @class pThread
      * @brief POSIX thread implementation
@@ -158,6 +268,32 @@ namespace original {
          * @return true if thread handle is valid
          */
         [[nodiscard]] bool valid() const override;
+
+        /**
+         * @brief Starts the thread
+         * @param options Attributes to create it with, or nullptr for the defaults
+         * @param c Callback function to execute in new thread
+         * @param args Arguments to forward to callback
+         * @throw sysError if an attribute is rejected or thread creation fails
+         */
+        template<typename Callback, typename... ARGS>
+        void start(const threadOptions* options, Callback c, ARGS&&... args);
+
+        /**
+         * @brief Translates options into creation attributes
+         * @param attr Initialized attributes to fill
+         * @param options The options
+         * @throw sysError if an attribute is rejected
+         */
+        static void applyOptions(pthread_attr_t& attr, const threadOptions& options);
+
+        /**
+         * @brief Applies the options that only take effect on a running thread
+         * @param name Thread name, empty to keep the default
+         * @param policy Scheduling policy; only BATCH and IDLE are applied here
+         * @note Called on the new thread itself before its callback; failures are ignored
+         */
+        static void applyToSelf(const std::string& name, threadOptions::schedPolicy policy);
     public:
         /**
          * @brief Construct empty (invalid) thread
@@ -177,6 +313,21 @@ namespace original {
         template<typename Callback, typename... ARGS>
         explicit pThread(Callback c, ARGS&&... args);
 
+        /**
+         * @brief Construct and start POSIX thread with scheduling attributes
+         * @tparam Callback Callback function type
+         * @tparam ARGS Argument types for callback
+         * @param options Name, stack size, affinity and policy of the new thread
+         * @param c Callback function to execute in new thread
+         * @param args Arguments to forward to callback
+         * @throw sysError if an attribute is rejected (e.g. a real-time policy without
+         *        privileges, or no allowed CPU) or thread creation fails
+         * @note The name and the BATCH and IDLE policies are set by the new thread before it
+         *       runs the callback; failing to set them is not an error, the thread keeps the defaults.
+         */
+        template<typename Callback, typename... ARGS>
+        explicit pThread(const threadOptions& options, Callback c, ARGS&&... args);
+
         /**
          * @brief Move constructor
          * @param other Thread to move from
@@ -298,6 +449,46 @@ namespace original {
          */
         static inline void sleep(const time::duration& d);
 
+        /**
+         * @brief Gives the rest of the current time slice to other ready threads
+         * @note Uses sched_yield on GCC/Linux and SwitchToThread on Windows
+         */
+        static inline void yield();
+
+        /**
+         * @brief Number of polls backOff only counts before it starts yielding
+         */
+        static constexpr u_integer SPIN_LIMIT = 64;
+
+        /**
+         * @brief Backs off after a failed poll of a spinning wait loop
+         * @param spins Failed polls so far, kept by the caller across the loop
+         * @note The first SPIN_LIMIT calls return at once, keeping short waits off the
+         *       scheduler; later calls yield the time slice.
+         */
+        static inline void backOff(u_integer& spins);
+
+        /**
+         * @brief CPUs the current thread is allowed to run on
+         * @return CPU numbers in ascending order
+         * @note Outside Linux returns 0 ... n-1 for the n online CPUs
+         */
+        static vector<u_integer> availableCpus();
+
+        /**
+         * @brief Physical package (socket) of a CPU
+         * @param cpu CPU number
+         * @return Package id, 0 if the topology is unknown
+         */
+        static u_integer cpuPackage(u_integer cpu);
+
+        /**
+         * @brief Physical core of a CPU within its package
+         * @param cpu CPU number
+         * @return Core id; SMT siblings share it. The CPU number itself if the topology is unknown
+         */
+        static u_integer cpuCore(u_integer cpu);
+
         /// @brief Alias for joinPolicy::AUTO_JOIN
         static constexpr auto AUTO_JOIN = joinPolicy::AUTO_JOIN;
 
@@ -335,6 +526,29 @@ namespace original {
         template<typename Callback, typename... ARGS>
         explicit thread(Callback c, joinPolicy policy, ARGS&&... args);
 
+        /**
+         * @brief Construct and start thread with scheduling attributes (AUTO_JOIN policy)
+         * @param options Name, stack size, affinity and policy of the new thread
+         * @param c Callable to execute in thread
+         * @param args Arguments forwarded to the callable
+         * @throw sysError if an attribute is rejected or thread creation fails
+         * @see threadOptions
+         */
+        template<typename Callback, typename... ARGS>
+        explicit thread(const threadOptions& options, Callback c, ARGS&&... args);
+
+        /**
+         * @brief Construct and start thread with scheduling attributes and join policy
+         * @param options Name, stack size, affinity and policy of the new thread
+         * @param c Callable to execute in thread
+         * @param policy Join policy (AUTO_JOIN or AUTO_DETACH)
+         * @param args Arguments forwarded to the callable
+         * @throw sysError if an attribute is rejected or thread creation fails
+         * @see threadOptions
+         */
+        template<typename Callback, typename... ARGS>
+        explicit thread(const threadOptions& options, Callback c, joinPolicy policy, ARGS&&... args);
+
         /**
          * @brief Construct a thread from an existing pThread with a join policy
          * @param p_thread The POSIX thread wrapper to take ownership of
@@ -458,26 +672,218 @@ std::string original::threadBase<DERIVED>::toString(bool enter) const {
     return ss.str();
 }
 
+inline original::threadOptions::threadOptions()
+    : stack_size_(0), policy_(schedPolicy::INHERIT), priority_(0) {}
+
+inline original::threadOptions& original::threadOptions::name(std::string name)
+{
+    this->name_ = std::move(name);
+    return *this;
+}
+
+inline original::threadOptions& original::threadOptions::stackSize(const u_integer bytes)
+{
+    this->stack_size_ = bytes;
+    return *this;
+}
+
+inline original::threadOptions& original::threadOptions::affinity(const vector<u_integer>& cpus)
+{
+    this->cpus_ = cpus;
+    return *this;
+}
+
+inline original::threadOptions& original::threadOptions::pin(const u_integer cpu)
+{
+    this->cpus_ = vector<u_integer>{};
+    this->cpus_.pushEnd(cpu);
+    return *this;
+}
+
+inline original::threadOptions& original::threadOptions::schedule(const schedPolicy policy, const integer priority)
+{
+    this->policy_ = policy;
+    this->priority_ = priority;
+    return *this;
+}
+
+inline const std::string& original::threadOptions::name() const noexcept
+{
+    return this->name_;
+}
+
+inline original::u_integer original::threadOptions::stackSize() const noexcept
+{
+    return this->stack_size_;
+}
+
+inline const original::vector<original::u_integer>& original::threadOptions::affinity() const noexcept
+{
+    return this->cpus_;
+}
+
+inline original::threadOptions::schedPolicy original::threadOptions::policy() const noexcept
+{
+    return this->policy_;
+}
+
+inline original::integer original::threadOptions::priority() const noexcept
+{
+    return this->priority_;
+}
+
+inline std::string original::threadOptions::className() const
+{
+    return "threadOptions";
+}
+
+inline std::string original::threadOptions::toString(const bool enter) const
+{
+    std::stringstream ss;
+    ss << "(" << this->className() << " name=\"" << this->name_ << "\" stack=" << this->stack_size_
+       << " cpus=" << this->cpus_.size() << " policy=" << static_cast<int>(this->policy_)
+       << " priority=" << this->priority_ << ")";
+    if (enter)
+        ss << "\n";
+    return ss.str();
+}
+
 inline original::pThread::pThread() : handle(), is_joinable() {}
 
 template<typename Callback, typename... ARGS>
 original::pThread::pThread(Callback c, ARGS&&... args) : handle(), is_joinable(true)
 {
+    this->start(nullptr, std::move(c), std::forward<ARGS>(args)...);
+}
+
+template<typename Callback, typename... ARGS>
+original::pThread::pThread(const threadOptions& options, Callback c, ARGS&&... args) : handle(), is_joinable(true)
+{
+    this->start(&options, std::move(c), std::forward<ARGS>(args)...);
+}
+
+inline void original::pThread::applyOptions(pthread_attr_t& attr, const threadOptions& options)
+{
+    if (options.stackSize() > 0) {
+        const auto minimum = static_cast<size_t>(PTHREAD_STACK_MIN);
+        const size_t bytes = options.stackSize() < minimum ? minimum : options.stackSize();
+        if (const int code = pthread_attr_setstacksize(&attr, bytes); code != 0) {
+            throw sysError("Failed to set thread stack size (pthread_attr_setstacksize returned "
+                           + formatString(code) + ")");
+        }
+    }
+
+    // Creation attributes only take the POSIX policies; BATCH and IDLE are set by applyToSelf()
+    if (options.policy() != threadOptions::INHERIT
+        && options.policy() != threadOptions::BATCH && options.policy() != threadOptions::IDLE) {
+        int policy = SCHED_OTHER;
+        switch (options.policy()) {
+        case threadOptions::FIFO:
+            policy = SCHED_FIFO;
+            break;
+        case threadOptions::ROUND_ROBIN:
+            policy = SCHED_RR;
+            break;
+        default:
+            break;
+        }
+        sched_param param{};
+        if (policy == SCHED_FIFO || policy == SCHED_RR) {
+            param.sched_priority = static_cast<int>(options.priority());
+        }
+        int code = pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        if (code == 0) {
+            code = pthread_attr_setschedpolicy(&attr, policy);
+        }
+        if (code == 0) {
+            code = pthread_attr_setschedparam(&attr, &param);
+        }
+        if (code != 0) {
+            throw sysError("Failed to set thread scheduling policy (pthread_attr_setsched* returned "
+                           + formatString(code) + ")");
+        }
+    }
+
+#if ORIGINAL_PLATFORM_LINUX
+    if (!options.affinity().empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (u_integer i = 0; i < options.affinity().size(); ++i) {
+            const u_integer cpu = options.affinity()[i];
+            if (cpu >= CPU_SETSIZE) {
+                throw sysError("CPU " + formatString(cpu) + " is out of the supported range");
+            }
+            CPU_SET(cpu, &set);
+        }
+        if (const int code = pthread_attr_setaffinity_np(&attr, sizeof(set), &set); code != 0) {
+            throw sysError("Failed to set thread affinity (pthread_attr_setaffinity_np returned "
+                           + formatString(code) + ")");
+        }
+    }
+#endif
+}
+
+inline void original::pThread::applyToSelf(const std::string& name, const threadOptions::schedPolicy policy)
+{
+#if ORIGINAL_PLATFORM_LINUX
+    if (!name.empty()) {
+        // The kernel keeps 15 characters plus the terminator
+        pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+    }
+    if (policy == threadOptions::BATCH || policy == threadOptions::IDLE) {
+        // Unprivileged threads may always switch to these policies
+        constexpr sched_param param{};
+        pthread_setschedparam(pthread_self(), policy == threadOptions::BATCH ? SCHED_BATCH : SCHED_IDLE, &param);
+    }
+#else
+    static_cast<void>(name);
+    static_cast<void>(policy);
+#endif
+}
+
+template<typename Callback, typename... ARGS>
+void original::pThread::start(const threadOptions* options, Callback c, ARGS&&... args)
+{
+    // The thread sets its own name and late policy, so both are in place before the callback runs
     auto bound_lambda =
-    [func = std::forward<Callback>(c), ...lambda_args = std::forward<ARGS>(args)]() mutable {
+    [func = std::forward<Callback>(c), ...lambda_args = std::forward<ARGS>(args),
+     name = options ? options->name() : std::string{},
+     policy = options ? options->policy() : threadOptions::INHERIT]() mutable {
+        if (!name.empty() || policy != threadOptions::INHERIT) {
+            applyToSelf(name, policy);
+        }
         std::invoke(std::move(func), std::move(lambda_args)...);
     };
 
     using bound_callback = decltype(bound_lambda);
     using bound_thread_data = threadData<bound_callback>;
 
+    pthread_attr_t attr;
+    if (options) {
+        if (const int code = pthread_attr_init(&attr); code != 0) {
+            throw sysError("Failed to initialize thread attributes (pthread_attr_init returned "
+                           + formatString(code) + ")");
+        }
+        try {
+            applyOptions(attr, *options);
+        } catch (...) {
+            pthread_attr_destroy(&attr);
+            throw;
+        }
+    }
+
     auto task = new bound_thread_data(std::move(bound_lambda));
 
-    if (const int code = pthread_create(&this->handle, nullptr, &bound_thread_data::run, task); code != 0)
+    const int code = pthread_create(&this->handle, options ? &attr : nullptr, &bound_thread_data::run, task);
+    if (options) {
+        pthread_attr_destroy(&attr);
+    }
+    if (code != 0)
     {
         delete task;
         throw sysError("Failed to create thread (pthread_create returned " + formatString(code) + ")");
     }
+
 }
 
 inline bool original::pThread::valid() const
@@ -608,6 +1014,74 @@ inline void original::thread::sleep(const time::duration& d)
 #endif
 }
 
+inline void original::thread::yield()
+{
+#if ORIGINAL_COMPILER_GCC || ORIGINAL_COMPILER_CLANG
+    sched_yield();
+#else
+    ::SwitchToThread();
+#endif
+}
+
+inline void original::thread::backOff(u_integer& spins)
+{
+    if (spins < SPIN_LIMIT) {
+        ++spins;
+        return;
+    }
+    yield();
+}
+
+inline original::vector<original::u_integer> original::thread::availableCpus()
+{
+    vector<u_integer> cpus;
+#if ORIGINAL_PLATFORM_LINUX
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (u_integer cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.pushEnd(cpu);
+            }
+        }
+        return cpus;
+    }
+#endif
+#if ORIGINAL_PLATFORM_WINDOWS
+    SYSTEM_INFO info;
+    ::GetSystemInfo(&info);
+    const long online = static_cast<long>(info.dwNumberOfProcessors);
+#else
+    const long online = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    for (long cpu = 0; cpu < (online > 0 ? online : 1); ++cpu) {
+        cpus.pushEnd(static_cast<u_integer>(cpu));
+    }
+    return cpus;
+}
+
+inline original::u_integer original::thread::cpuPackage(const u_integer cpu)
+{
+#if ORIGINAL_PLATFORM_LINUX
+    std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/physical_package_id");
+    if (integer id = -1; file >> id && id >= 0) {
+        return static_cast<u_integer>(id);
+    }
+#endif
+    return 0;
+}
+
+inline original::u_integer original::thread::cpuCore(const u_integer cpu)
+{
+#if ORIGINAL_PLATFORM_LINUX
+    std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/core_id");
+    if (integer id = -1; file >> id && id >= 0) {
+        return static_cast<u_integer>(id);
+    }
+#endif
+    return cpu;
+}
+
 inline original::thread::thread()
     : will_join(true) {}
 
@@ -619,6 +1093,14 @@ template <typename Callback, typename ... ARGS>
 original::thread::thread(Callback c, const joinPolicy policy, ARGS&&... args)
     : thread_(std::forward<Callback>(c), std::forward<ARGS>(args)...), will_join(policy == AUTO_JOIN) {}
 
+template <typename Callback, typename ... ARGS>
+original::thread::thread(const threadOptions& options, Callback c, ARGS&&... args)
+    : thread_(options, std::forward<Callback>(c), std::forward<ARGS>(args)...), will_join(true) {}
+
+template <typename Callback, typename ... ARGS>
+original::thread::thread(const threadOptions& options, Callback c, const joinPolicy policy, ARGS&&... args)
+    : thread_(options, std::forward<Callback>(c), std::forward<ARGS>(args)...), will_join(policy == AUTO_JOIN) {}
+
 inline original::thread::thread(pThread p_thread, const joinPolicy policy)
     : thread_(std::move(p_thread)), will_join(policy == AUTO_JOIN) {}
 
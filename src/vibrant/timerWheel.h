@@ -0,0 +1,657 @@
+#ifndef ORIGINAL_TIMERWHEEL_H
+#define ORIGINAL_TIMERWHEEL_H
+
+#include "condition.h"
+#include "config.h"
+#include "mutex.h"
+#include "tasks.h"
+#include "thread.h"
+#include "zeit.h"
+#include <functional>
+
+
+/**
+ * @file timerWheel.h
+ * @brief Hierarchical timing wheel for delayed and periodic callbacks
+ * @details One driver thread serves any number of timers:
+ * - Scheduling and cancelling are O(1): a timer is linked into a slot list picked from
+ *   its expiry tick, and cancelling unlinks it through its handle
+ * - Four levels of 256 slots cover 2^32 ticks (about 49 days at 1 ms); later expiries
+ *   park in the top level and are re-placed as the wheel turns
+ * - The driver sleeps until the next occupied slot of the lowest level (or the next
+ *   rotation of it), so idle ticks cost nothing and busy ones cost a bit test
+ * - Expired callbacks are submitted to a taskDelegator, or run on the driver thread
+ *   when the wheel was built without one
+ *
+ * @see tasks.h for the taskDelegator that runs the callbacks
+ */
+
+namespace original {
+
+    /**
+     * @class timerWheel
+     * @brief Timer service running callbacks after a delay, at a point in time or periodically
+     * @details Expiries are rounded up to whole ticks counted from construction, so a callback
+     * never runs before its deadline and usually runs less than one tick after it (plus the
+     * delegator's queueing delay).
+     *
+     * All wheel state is guarded by one pMutex. Timer entries are recycled through a free
+     * list; a generation counter in each entry lets stale handles detect that their timer
+     * already fired or was cancelled.
+     *
+     * @note Not copyable or movable. Timer handles must not be used after the wheel is destroyed.
+     */
+    class timerWheel final {
+        static constexpr u_integer LEVELS = 4;              ///< Number of wheel levels
+        static constexpr u_integer SLOT_BITS = 8;           ///< Tick bits covered by one level
+        static constexpr u_integer SLOTS = 1 << SLOT_BITS;  ///< Slots per level
+        static constexpr ul_integer MASK = SLOTS - 1;       ///< Slot index mask
+        static constexpr ul_integer NEVER = ~static_cast<ul_integer>(0);  ///< Tick of no wake-up
+
+        /**
+         * @struct link
+         * @brief Node of a circular doubly linked slot list
+         */
+        struct link {
+            link* prev;  ///< Previous node
+            link* next;  ///< Next node
+        };
+
+        /**
+         * @struct entry
+         * @brief A scheduled timer
+         */
+        struct entry : link {
+            std::function<void()> callback;  ///< Callback to run on expiry
+            ul_integer expiry;               ///< Absolute tick to fire at
+            ul_integer period;               ///< Ticks between firings, 0 for one-shot timers
+            u_integer generation;            ///< Bumped each time the entry is released
+            u_integer slot;                  ///< level * SLOTS + index while scheduled
+        };
+
+        taskDelegator* delegator_;           ///< Runs expired callbacks, nullptr to run them inline
+        const time::point start_;            ///< Time of tick 0
+        const integer tick_ns_;              ///< Tick length in nanoseconds
+        link slots_[LEVELS][SLOTS];          ///< Slot list heads
+        ul_integer occupied_[SLOTS / 64];    ///< Non-empty slots of level 0
+        ul_integer current_;                 ///< Last processed tick
+        ul_integer wake_;                    ///< Tick the driver sleeps until
+        u_integer count_;                    ///< Scheduled timers
+        entry* free_;                        ///< Released entries, linked through next
+        entry* due_;                         ///< Expired entries awaiting dispatch
+        bool stopped_;                       ///< Set by stop()
+        mutable pMutex mutex_;               ///< Guards all fields above
+        pCondition condition_;               ///< Wakes the driver early or on stop
+        thread driver_;                      ///< Advances the wheel and dispatches callbacks
+
+        /**
+         * @brief First tick due at or after a point in time
+         * @param p Point in time
+         * @return Tick number, 0 for points before start_
+         */
+        [[nodiscard]] ul_integer tickAt(const time::point& p) const;
+
+        /**
+         * @brief Last tick that is due now
+         * @return Number of whole ticks elapsed since start_
+         */
+        [[nodiscard]] ul_integer ticksElapsed() const;
+
+        /**
+         * @brief Start time of a tick
+         * @param tick Tick number
+         * @return Point in time at which the tick is due
+         */
+        [[nodiscard]] time::point timeOf(ul_integer tick) const;
+
+        /**
+         * @brief Takes an entry from the free list or allocates one
+         * @return Unlinked entry with an empty callback
+         * @pre mutex_ is held
+         */
+        entry* acquire();
+
+        /**
+         * @brief Returns an entry to the free list and invalidates its handles
+         * @param e Unlinked entry
+         * @pre mutex_ is held
+         */
+        void release(entry* e);
+
+        /**
+         * @brief Links an entry into the slot matching its expiry
+         * @param e Unlinked entry with expiry >= current_
+         * @pre mutex_ is held
+         */
+        void place(entry* e);
+
+        /**
+         * @brief Unlinks a scheduled entry from its slot
+         * @param e Scheduled entry
+         * @pre mutex_ is held
+         */
+        void unlink(entry* e);
+
+        /**
+         * @brief Re-places the entries of the current slot of a level, higher levels first
+         * @param level Level to cascade (1 or above)
+         * @pre mutex_ is held
+         */
+        void cascade(u_integer level);
+
+        /**
+         * @brief Processes the next tick, moving expired entries to due_
+         * @pre mutex_ is held
+         */
+        void advance();
+
+        /**
+         * @brief Moves an empty wheel to the present tick
+         * @details Without timers there is nothing to cascade or fire, so the ticks slept
+         * through are skipped instead of advanced one by one.
+         * @pre mutex_ is held
+         */
+        void skipIdle();
+
+        /**
+         * @brief Tick at which the driver has to wake up next
+         * @return Next occupied tick of level 0, or the start of its next rotation
+         * @pre mutex_ is held and count_ > 0
+         */
+        [[nodiscard]] ul_integer nextWake() const;
+
+        /**
+         * @brief Runs or submits the callbacks of a due list, then releases its entries
+         * @param due Detached due list
+         * @param lock Held lock on mutex_, released while the callbacks are dispatched
+         */
+        void dispatch(entry* due, uniqueLock& lock);
+
+        /**
+         * @brief Body of the driver thread
+         */
+        void run();
+
+        /**
+         * @brief Initializes an empty wheel and starts its driver thread
+         * @param delegator Delegator running the callbacks, nullptr to run them inline
+         * @param tick Granularity of the wheel
+         */
+        timerWheel(taskDelegator* delegator, const time::duration& tick);
+
+    public:
+        /**
+         * @class timer
+         * @brief Handle of a scheduled timer
+         * @details Copyable; all copies refer to the same timer. A default constructed handle
+         * refers to no timer.
+         */
+        class timer {
+            friend class timerWheel;
+
+            timerWheel* wheel_;      ///< Owning wheel
+            entry* entry_;           ///< Entry of the timer
+            u_integer generation_;   ///< Generation of entry_ when scheduled
+
+            timer(timerWheel* wheel, entry* e);
+
+        public:
+            /**
+             * @brief Constructs a handle that refers to no timer
+             */
+            timer();
+
+            /**
+             * @brief Cancels the timer in O(1)
+             * @return True if the timer was still scheduled; false if it already fired
+             *         (one-shot) or was cancelled before
+             * @note A firing that was already handed to the delegator still runs.
+             */
+            bool cancel();
+
+            /**
+             * @brief Checks whether the timer is still scheduled
+             * @return True until a one-shot timer fires or any timer is cancelled
+             */
+            [[nodiscard]] bool pending() const;
+        };
+
+    private:
+        /**
+         * @brief Schedules a callback
+         * @param expiry Absolute tick of the first firing
+         * @param period Ticks between firings, 0 for a one-shot timer
+         * @param callback Callback to run
+         * @return Handle of the timer
+         * @throws sysError if the wheel is stopped
+         */
+        timer add(ul_integer expiry, ul_integer period, std::function<void()>&& callback);
+
+    public:
+        /**
+         * @brief Constructs a wheel that runs callbacks on its own driver thread
+         * @param tick Granularity of the wheel (at least one nanosecond)
+         * @note Callbacks must then be short; exceptions they throw are dropped.
+         */
+        explicit timerWheel(const time::duration& tick = time::duration{1, time::MILLISECOND});
+
+        /**
+         * @brief Constructs a wheel that submits expired callbacks to a taskDelegator
+         * @param delegator Delegator running the callbacks, must outlive the wheel
+         * @param tick Granularity of the wheel (at least one nanosecond)
+         * @note Firings that the delegator refuses (because it was stopped) are dropped.
+         */
+        explicit timerWheel(taskDelegator& delegator,
+                            const time::duration& tick = time::duration{1, time::MILLISECOND});
+
+        timerWheel(const timerWheel&) = delete;               ///< Disable copy constructor
+        timerWheel& operator=(const timerWheel&) = delete;    ///< Disable copy assignment
+
+        /**
+         * @brief Runs a callback once after a delay
+         * @param delay Time from now
+         * @param callback Callback to run
+         * @return Handle for cancelling the timer
+         * @throws sysError if the wheel is stopped
+         */
+        timer schedule(const time::duration& delay, std::function<void()> callback);
+
+        /**
+         * @brief Runs a callback once at a point in time
+         * @param deadline Point in time; a past one fires on the next tick
+         * @param callback Callback to run
+         * @return Handle for cancelling the timer
+         * @throws sysError if the wheel is stopped
+         */
+        timer scheduleAt(const time::point& deadline, std::function<void()> callback);
+
+        /**
+         * @brief Runs a callback repeatedly until the timer is cancelled
+         * @param period Time from now to the first firing and between firings (rounded
+         *        up to whole ticks, at least one)
+         * @param callback Callback to run
+         * @return Handle for cancelling the timer
+         * @throws sysError if the wheel is stopped
+         * @note If the driver falls behind, missed firings are skipped rather than bunched up.
+         */
+        timer scheduleEvery(const time::duration& period, std::function<void()> callback);
+
+        /**
+         * @brief Number of scheduled timers
+         * @return Timers that have neither fired (one-shot) nor been cancelled, 0 once stopped
+         */
+        [[nodiscard]] u_integer pending() const;
+
+        /**
+         * @brief Granularity of the wheel
+         * @return Tick length
+         */
+        [[nodiscard]] time::duration tick() const;
+
+        /**
+         * @brief Stops the driver thread, dropping every scheduled timer
+         * @details Idempotent. Callbacks being dispatched when stop() is called still run.
+         */
+        void stop();
+
+        /**
+         * @brief Stops the wheel and frees its timers
+         */
+        ~timerWheel();
+    };
+}
+
+inline original::ul_integer original::timerWheel::tickAt(const time::point& p) const
+{
+    const integer ns = (p - this->start_).value(time::NANOSECOND);
+    if (ns <= 0) {
+        return 0;
+    }
+    return static_cast<ul_integer>((ns + this->tick_ns_ - 1) / this->tick_ns_);
+}
+
+inline original::ul_integer original::timerWheel::ticksElapsed() const
+{
+    const integer ns = (time::point::now() - this->start_).value(time::NANOSECOND);
+    return ns <= 0 ? 0 : static_cast<ul_integer>(ns / this->tick_ns_);
+}
+
+inline original::time::point original::timerWheel::timeOf(const ul_integer tick) const
+{
+    return this->start_ + time::duration{static_cast<integer>(tick) * this->tick_ns_, time::NANOSECOND};
+}
+
+inline original::timerWheel::entry* original::timerWheel::acquire()
+{
+    if (!this->free_) {
+        return new entry{{nullptr, nullptr}, {}, 0, 0, 0, 0};
+    }
+    entry* e = this->free_;
+    this->free_ = static_cast<entry*>(e->next);
+    return e;
+}
+
+inline void original::timerWheel::release(entry* e)
+{
+    e->generation += 1;
+    e->next = this->free_;
+    this->free_ = e;
+}
+
+inline void original::timerWheel::place(entry* e)
+{
+    const ul_integer delta = e->expiry - this->current_;
+    u_integer level = 0;
+    while (level + 1 < LEVELS && delta >> (SLOT_BITS * (level + 1)) != 0) {
+        level += 1;
+    }
+    // Expiries beyond the top level's reach park in its furthest slot
+    const ul_integer reach = static_cast<ul_integer>(1) << (SLOT_BITS * LEVELS);
+    const ul_integer at = delta < reach ? e->expiry : this->current_ + reach - 1;
+    const u_integer index = static_cast<u_integer>(at >> (SLOT_BITS * level) & MASK);
+
+    link& head = this->slots_[level][index];
+    e->prev = head.prev;
+    e->next = &head;
+    head.prev->next = e;
+    head.prev = e;
+    e->slot = level * SLOTS + index;
+    if (level == 0) {
+        this->occupied_[index / 64] |= static_cast<ul_integer>(1) << (index % 64);
+    }
+}
+
+inline void original::timerWheel::unlink(entry* e)
+{
+    e->prev->next = e->next;
+    e->next->prev = e->prev;
+    if (e->slot < SLOTS && this->slots_[0][e->slot].next == &this->slots_[0][e->slot]) {
+        this->occupied_[e->slot / 64] &= ~(static_cast<ul_integer>(1) << (e->slot % 64));
+    }
+}
+
+inline void original::timerWheel::cascade(const u_integer level)
+{
+    const u_integer index = static_cast<u_integer>(this->current_ >> (SLOT_BITS * level) & MASK);
+    if (index == 0 && level + 1 < LEVELS) {
+        this->cascade(level + 1);
+    }
+    link& head = this->slots_[level][index];
+    link* node = head.next;
+    head.prev = head.next = &head;
+    while (node != &head) {
+        link* next = node->next;
+        this->place(static_cast<entry*>(node));
+        node = next;
+    }
+}
+
+inline void original::timerWheel::advance()
+{
+    this->current_ += 1;
+    const u_integer index = static_cast<u_integer>(this->current_ & MASK);
+    if (index == 0) {
+        this->cascade(1);
+    }
+    if ((this->occupied_[index / 64] >> (index % 64) & 1) == 0) {
+        return;
+    }
+    link& head = this->slots_[0][index];
+    link* node = head.next;
+    head.prev = head.next = &head;
+    this->occupied_[index / 64] &= ~(static_cast<ul_integer>(1) << (index % 64));
+    while (node != &head) {
+        link* next = node->next;
+        auto e = static_cast<entry*>(node);
+        entry* fired = e;
+        if (e->period != 0) {
+            // The periodic entry stays scheduled; a copy of its callback is dispatched
+            fired = this->acquire();
+            fired->callback = e->callback;
+            e->expiry += e->period;
+            if (e->expiry <= this->current_) {
+                e->expiry += (this->current_ - e->expiry) / e->period * e->period + e->period;
+            }
+            this->place(e);
+        } else {
+            this->count_ -= 1;
+            e->generation += 1;
+        }
+        fired->next = this->due_;
+        this->due_ = fired;
+        node = next;
+    }
+}
+
+inline void original::timerWheel::skipIdle()
+{
+    if (this->count_ != 0) {
+        return;
+    }
+    const ul_integer now = this->ticksElapsed();
+    if (this->current_ < now) {
+        this->current_ = now;
+    }
+}
+
+inline original::ul_integer original::timerWheel::nextWake() const
+{
+    const u_integer from = static_cast<u_integer>(this->current_ & MASK) + 1;
+    for (u_integer word = from / 64; word < SLOTS / 64; ++word) {
+        ul_integer bits = this->occupied_[word];
+        if (word == from / 64) {
+            bits &= ~static_cast<ul_integer>(0) << (from % 64);
+        }
+        if (bits != 0) {
+            return (this->current_ & ~MASK) + word * 64 + static_cast<u_integer>(__builtin_ctzll(bits));
+        }
+    }
+    return (this->current_ | MASK) + 1;
+}
+
+inline void original::timerWheel::dispatch(entry* due, uniqueLock& lock)
+{
+    // Entries were pushed in front, reverse them back into expiry order
+    entry* ordered = nullptr;
+    while (due) {
+        auto next = static_cast<entry*>(due->next);
+        due->next = ordered;
+        ordered = due;
+        due = next;
+    }
+    lock.unlock();
+    for (entry* e = ordered; e; e = static_cast<entry*>(e->next)) {
+        try {
+            if (this->delegator_) {
+                this->delegator_->submit(std::move(e->callback));
+            } else {
+                e->callback();
+            }
+        } catch (...) {
+            // A stopped delegator or a throwing inline callback only loses this firing
+        }
+        e->callback = nullptr;
+    }
+    lock.lock();
+    while (ordered) {
+        auto next = static_cast<entry*>(ordered->next);
+        ordered->next = this->free_;
+        this->free_ = ordered;
+        ordered = next;
+    }
+}
+
+inline void original::timerWheel::run()
+{
+    uniqueLock lock{this->mutex_};
+    while (!this->stopped_) {
+        this->skipIdle();
+        const ul_integer now = this->ticksElapsed();
+        while (this->current_ < now) {
+            this->advance();
+        }
+        if (this->due_) {
+            entry* due = this->due_;
+            this->due_ = nullptr;
+            this->dispatch(due, lock);
+            continue;
+        }
+        if (this->count_ == 0) {
+            this->wake_ = NEVER;
+            this->condition_.wait(this->mutex_, [this] { return this->stopped_ || this->wake_ != NEVER; });
+            continue;
+        }
+        const ul_integer planned = this->nextWake();
+        this->wake_ = planned;
+        const time::duration remaining = this->timeOf(planned) - time::point::now();
+        if (remaining > time::duration::ZERO) {
+            this->condition_.waitFor(this->mutex_, remaining,
+                                     [this, planned] { return this->stopped_ || this->wake_ < planned; });
+        }
+    }
+}
+
+inline original::timerWheel::timer original::timerWheel::add(ul_integer expiry, const ul_integer period,
+                                      std::function<void()>&& callback)
+{
+    uniqueLock lock{this->mutex_};
+    if (this->stopped_) {
+        throw sysError("timerWheel already stopped");
+    }
+    // The driver of an empty wheel may have slept for long; place relative to now, not to then
+    this->skipIdle();
+    if (expiry <= this->current_) {
+        expiry = this->current_ + 1;
+    }
+    entry* e = this->acquire();
+    e->callback = std::move(callback);
+    e->expiry = expiry;
+    e->period = period;
+    this->place(e);
+    this->count_ += 1;
+    if (expiry < this->wake_) {
+        this->wake_ = expiry;
+        this->condition_.notify();
+    }
+    return timer{this, e};
+}
+
+inline original::timerWheel::timer::timer(timerWheel* wheel, entry* e)
+    : wheel_(wheel), entry_(e), generation_(e->generation) {}
+
+inline original::timerWheel::timer::timer() : wheel_(nullptr), entry_(nullptr), generation_(0) {}
+
+inline bool original::timerWheel::timer::cancel()
+{
+    if (!this->wheel_) {
+        return false;
+    }
+    std::function<void()> dropped;
+    uniqueLock lock{this->wheel_->mutex_};
+    if (this->entry_->generation != this->generation_ || this->wheel_->stopped_) {
+        return false;
+    }
+    this->wheel_->unlink(this->entry_);
+    dropped = std::move(this->entry_->callback);
+    this->entry_->callback = nullptr;
+    this->wheel_->release(this->entry_);
+    this->wheel_->count_ -= 1;
+    return true;
+}
+
+inline bool original::timerWheel::timer::pending() const
+{
+    if (!this->wheel_) {
+        return false;
+    }
+    uniqueLock lock{this->wheel_->mutex_};
+    return this->entry_->generation == this->generation_ && !this->wheel_->stopped_;
+}
+
+inline original::timerWheel::timerWheel(taskDelegator* delegator, const time::duration& tick)
+    : delegator_(delegator), start_(time::point::now()),
+      tick_ns_(tick.value(time::NANOSECOND) > 0 ? tick.value(time::NANOSECOND) : 1),
+      occupied_{}, current_(0), wake_(NEVER), count_(0), free_(nullptr), due_(nullptr), stopped_(false)
+{
+    for (auto& level : this->slots_) {
+        for (auto& head : level) {
+            head.prev = head.next = &head;
+        }
+    }
+    this->driver_ = thread{[this] { this->run(); }};
+}
+
+inline original::timerWheel::timerWheel(const time::duration& tick)
+    : timerWheel(nullptr, tick) {}
+
+inline original::timerWheel::timerWheel(taskDelegator& delegator, const time::duration& tick)
+    : timerWheel(&delegator, tick) {}
+
+inline original::timerWheel::timer
+original::timerWheel::schedule(const time::duration& delay, std::function<void()> callback)
+{
+    return this->scheduleAt(time::point::now() + delay, std::move(callback));
+}
+
+inline original::timerWheel::timer
+original::timerWheel::scheduleAt(const time::point& deadline, std::function<void()> callback)
+{
+    return this->add(this->tickAt(deadline), 0, std::move(callback));
+}
+
+inline original::timerWheel::timer
+original::timerWheel::scheduleEvery(const time::duration& period, std::function<void()> callback)
+{
+    const integer ns = period.value(time::NANOSECOND);
+    const ul_integer ticks = ns <= this->tick_ns_ ? 1 : static_cast<ul_integer>((ns + this->tick_ns_ - 1) / this->tick_ns_);
+    return this->add(this->tickAt(time::point::now()) + ticks, ticks, std::move(callback));
+}
+
+inline original::u_integer original::timerWheel::pending() const
+{
+    uniqueLock lock{this->mutex_};
+    return this->count_;
+}
+
+inline original::time::duration original::timerWheel::tick() const
+{
+    return time::duration{this->tick_ns_, time::NANOSECOND};
+}
+
+inline void original::timerWheel::stop()
+{
+    {
+        uniqueLock lock{this->mutex_};
+        if (this->stopped_) {
+            return;
+        }
+        this->stopped_ = true;
+        this->count_ = 0;
+    }
+    this->condition_.notify();
+    if (this->driver_.joinable()) {
+        this->driver_.join();
+    }
+}
+
+inline original::timerWheel::~timerWheel()
+{
+    this->stop();
+    for (auto& level : this->slots_) {
+        for (auto& head : level) {
+            link* node = head.next;
+            while (node != &head) {
+                link* next = node->next;
+                delete static_cast<entry*>(node);
+                node = next;
+            }
+        }
+    }
+    while (this->free_) {
+        auto next = static_cast<entry*>(this->free_->next);
+        delete this->free_;
+        this->free_ = next;
+    }
+}
+
+#endif //ORIGINAL_TIMERWHEEL_H
@@ -3,14 +3,26 @@
 
 #include "async.h"
 #include "atomic.h"
+#include "cancellation.h"
+#include "channel.h"
+#include "concurrentMaps.h"
+#include "concurrentSets.h"
+#include "epochReclaimer.h"
+#include "lockFreeSkipList.h"
+#include "mpmcQueue.h"
 #include "condition.h"
 #include "coroutines.h"
 #include "generators.h"
 #include "mutex.h"
+#include "parallel.h"
+#include "parallelTrees.h"
 #include "semaphores.h"
+#include "spscRing.h"
 #include "syncPoint.h"
+#include "taskGraph.h"
 #include "tasks.h"
 #include "thread.h"
+#include "timerWheel.h"
 #include "zeit.h"
 
 #endif //VIBRANT_H
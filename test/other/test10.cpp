@@ -0,0 +1,84 @@
+#include <iostream>
+#include <iomanip>
+#include "maps.h"
+#include "vector.h"
+#include "zeit.h"
+
+// Ordered map lookups and range scans: pointer-per-pair red-black treeMap
+// versus the wide-node B+ tree btreeMap at a few fanouts.
+
+namespace {
+    constexpr int KEYS = 1 << 20;
+    constexpr int LOOKUPS = 1 << 20;
+    constexpr int SCANS = 1 << 12;
+    constexpr int SCAN_WIDTH = 1 << 10;
+
+    double elapsedMs(const original::time::point& start) {
+        return (original::time::point::now() - start).value(original::time::MICROSECOND) / 1000.0;
+    }
+
+    template<typename MAP>
+    void run(const char* name, const original::vector<int>& keys, const original::vector<int>& probes) {
+        MAP m;
+        auto start = original::time::point::now();
+        for (const int k : keys) {
+            m.add(k, k);
+        }
+        const double build_ms = elapsedMs(start);
+
+        long long hits = 0;
+        start = original::time::point::now();
+        for (const int k : probes) {
+            hits += m.containsKey(k);
+        }
+        const double lookup_ms = elapsedMs(start);
+
+        long long sum = 0;
+        start = original::time::point::now();
+        if constexpr (requires { m.forEachInRange(0, 0, [](const auto&) {}); }) {
+            for (int i = 0; i < SCANS; ++i) {
+                const int low = probes[i] & ~1;
+                m.forEachInRange(low, low + 2 * SCAN_WIDTH, [&](const auto& pair) { sum += pair.second(); });
+            }
+        } else {
+            for (int i = 0; i < SCANS; ++i) {
+                const int low = probes[i] & ~1;
+                for (int k = low; k < low + 2 * SCAN_WIDTH; k += 2) {
+                    if (m.containsKey(k))
+                        sum += m[k];
+                }
+            }
+        }
+        const double scan_ms = elapsedMs(start);
+
+        std::cout << std::setw(16) << name << std::fixed << std::setprecision(2)
+                  << std::setw(12) << build_ms << std::setw(12) << lookup_ms << std::setw(12) << scan_ms
+                  << std::setw(10) << hits << std::setw(16) << sum << std::endl;
+    }
+}
+
+int main() {
+    original::vector<int> keys;
+    original::vector<int> probes;
+    original::u_integer seed = 2166136261u;
+    for (int i = 0; i < KEYS; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        keys.pushEnd(static_cast<int>((seed >> 8) % (2u * KEYS)) & ~1);
+    }
+    for (int i = 0; i < LOOKUPS; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        probes.pushEnd(static_cast<int>((seed >> 8) % (2u * KEYS)));
+    }
+
+    std::cout << KEYS << " inserts, " << LOOKUPS << " lookups, "
+              << SCANS << " scans of " << SCAN_WIDTH << " keys" << std::endl;
+    std::cout << std::setw(16) << "map" << std::setw(12) << "build ms" << std::setw(12) << "lookup ms"
+              << std::setw(12) << "scan ms" << std::setw(10) << "hits" << std::setw(16) << "checksum" << std::endl;
+    run<original::treeMap<int, int>>("treeMap", keys, probes);
+    run<original::btreeMap<int, int, original::increaseComparator<int>,
+        original::allocator<original::couple<const int, int>>, 16>>("btreeMap<16>", keys, probes);
+    run<original::btreeMap<int, int>>("btreeMap<32>", keys, probes);
+    run<original::btreeMap<int, int, original::increaseComparator<int>,
+        original::allocator<original::couple<const int, int>>, 64>>("btreeMap<64>", keys, probes);
+    return 0;
+}
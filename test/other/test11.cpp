@@ -0,0 +1,57 @@
+#include <iostream>
+#include <iomanip>
+#include "maps.h"
+#include "vector.h"
+#include "zeit.h"
+
+// Rebuilding an ordered index from sorted pairs: add() one pair at a time
+// versus treeMap::fromSorted, and merging a sorted batch into a populated map.
+
+namespace {
+    constexpr int PAIRS = 1 << 20;
+
+    template<typename Build>
+    void measure(const char* name, Build build) {
+        const auto start = original::time::point::now();
+        const original::u_integer size = build();
+        const auto elapsed = original::time::point::now() - start;
+        std::cout << std::setw(24) << name << std::setw(12) << std::fixed << std::setprecision(2)
+                  << elapsed.value(original::time::MICROSECOND) / 1000.0 << std::setw(10) << size << std::endl;
+    }
+}
+
+int main() {
+    original::vector<original::couple<int, int>> sorted;
+    original::vector<original::couple<int, int>> batch;
+    for (int i = 0; i < PAIRS; ++i) {
+        sorted.pushEnd({i * 2, i});
+        batch.pushEnd({i * 2 + 1, -i});
+    }
+
+    std::cout << PAIRS << " sorted pairs" << std::endl;
+    std::cout << std::setw(24) << "build" << std::setw(12) << "ms" << std::setw(10) << "size" << std::endl;
+    // Maps stay alive until the end, so destruction is not measured
+    original::treeMap<int, int> added;
+    measure("add", [&] {
+        for (const auto& e : sorted) {
+            added.add(e.first(), e.second());
+        }
+        return added.size();
+    });
+    original::treeMap<int, int> loaded;
+    measure("fromSorted", [&] {
+        loaded = original::treeMap<int, int>::fromSorted(sorted);
+        return loaded.size();
+    });
+    measure("add batch", [&] {
+        for (const auto& e : batch) {
+            added.add(e.first(), e.second());
+        }
+        return added.size();
+    });
+    measure("bulkLoad batch", [&] {
+        loaded.bulkLoad(batch);
+        return loaded.size();
+    });
+    return 0;
+}
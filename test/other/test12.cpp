@@ -0,0 +1,77 @@
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <new>
+#include "maps.h"
+#include "sets.h"
+#include "vector.h"
+#include "zeit.h"
+
+// Heap footprint and insert throughput of the skip list containers JMap and JSet.
+// Global operator new/delete are replaced to count live bytes and allocations.
+
+namespace {
+    constexpr int ELEMENTS = 1 << 20;
+
+    original::ul_integer live_bytes = 0;
+    original::ul_integer allocations = 0;
+}
+
+void* operator new(const std::size_t size) {
+    auto* block = static_cast<std::size_t*>(std::malloc(size + sizeof(std::max_align_t)));
+    if (!block)
+        throw std::bad_alloc{};
+    *block = size;
+    live_bytes += size;
+    allocations += 1;
+    return reinterpret_cast<char*>(block) + sizeof(std::max_align_t);
+}
+
+void operator delete(void* ptr) noexcept {
+    if (!ptr)
+        return;
+    auto* block = reinterpret_cast<std::size_t*>(static_cast<char*>(ptr) - sizeof(std::max_align_t));
+    live_bytes -= *block;
+    std::free(block);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+namespace {
+    template<typename CONTAINER, typename Add>
+    void run(const char* name, const original::vector<int>& keys, Add add) {
+        const original::ul_integer bytes_before = live_bytes;
+        const original::ul_integer allocations_before = allocations;
+        CONTAINER c;
+        const auto start = original::time::point::now();
+        for (const int k : keys) {
+            add(c, k);
+        }
+        const auto elapsed = original::time::point::now() - start;
+        const double per_element = static_cast<double>(c.size());
+        std::cout << std::setw(10) << name << std::fixed << std::setprecision(2)
+                  << std::setw(14) << static_cast<double>(live_bytes - bytes_before) / per_element
+                  << std::setw(14) << static_cast<double>(allocations - allocations_before) / per_element
+                  << std::setw(14) << per_element / static_cast<double>(elapsed.value(original::time::MICROSECOND))
+                  << std::endl;
+    }
+}
+
+int main() {
+    original::vector<int> keys;
+    original::u_integer seed = 2166136261u;
+    for (int i = 0; i < ELEMENTS; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        keys.pushEnd(static_cast<int>(seed >> 1));
+    }
+
+    std::cout << ELEMENTS << " random inserts" << std::endl;
+    std::cout << std::setw(10) << "container" << std::setw(14) << "bytes/elem"
+              << std::setw(14) << "allocs/elem" << std::setw(14) << "insert Mops/s" << std::endl;
+    run<original::JMap<int, int>>("JMap", keys, [](auto& m, const int k) { m.add(k, k); });
+    run<original::JSet<int>>("JSet", keys, [](auto& s, const int k) { s.add(k); });
+    return 0;
+}
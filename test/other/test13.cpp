@@ -0,0 +1,86 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include "concurrentMaps.h"
+#include "maps.h"
+#include "mutex.h"
+#include "thread.h"
+#include "vector.h"
+#include "zeit.h"
+
+// Ordered map under concurrent mixed load (80% lookups, 10% adds, 10% removes):
+// lock-free concurrentJMap versus a JMap behind one pMutex, over several thread counts.
+
+namespace {
+    constexpr int KEY_RANGE = 1 << 16;
+    constexpr int TOTAL_OPS = 1 << 19;
+
+    struct lockedJMap {
+        original::JMap<int, int> map;
+        original::pMutex mutex;
+
+        bool containsKey(const int k) {
+            original::uniqueLock lock{this->mutex};
+            return this->map.containsKey(k);
+        }
+
+        bool add(const int k, const int v) {
+            original::uniqueLock lock{this->mutex};
+            return this->map.add(k, v);
+        }
+
+        bool remove(const int k) {
+            original::uniqueLock lock{this->mutex};
+            return this->map.remove(k);
+        }
+    };
+
+    template<typename MAP>
+    void run(const char* name, const original::u_integer threads) {
+        MAP m;
+        for (int k = 0; k < KEY_RANGE; k += 2) {
+            m.add(k, k);
+        }
+
+        const int per_thread = TOTAL_OPS / static_cast<int>(threads);
+        auto hits = original::makeAtomic<original::u_integer>(0);
+        const auto start = original::time::point::now();
+        {
+            original::vector<original::thread> workers;
+            for (original::u_integer t = 0; t < threads; ++t) {
+                workers.pushEnd(original::thread{[&m, &hits, per_thread, t] {
+                    original::u_integer seed = 2166136261u ^ (t * 16777619u);
+                    original::u_integer local_hits = 0;
+                    for (int i = 0; i < per_thread; ++i) {
+                        seed = seed * 1664525u + 1013904223u;
+                        const int key = static_cast<int>(seed >> 8) % KEY_RANGE;
+                        const original::u_integer dice = seed % 10;
+                        if (dice == 0) {
+                            m.add(key, key);
+                        } else if (dice == 1) {
+                            m.remove(key);
+                        } else {
+                            local_hits += m.containsKey(key);
+                        }
+                    }
+                    hits += local_hits;
+                }});
+            }
+        }
+        const auto elapsed = original::time::point::now() - start;
+        const double us = static_cast<double>(elapsed.value(original::time::MICROSECOND));
+        std::cout << std::setw(16) << name << std::setw(10) << threads << std::fixed << std::setprecision(2)
+                  << std::setw(14) << TOTAL_OPS / us << std::setw(12) << hits.load() << std::endl;
+    }
+}
+
+int main() {
+    std::cout << TOTAL_OPS << " mixed ops over " << KEY_RANGE << " keys" << std::endl;
+    std::cout << std::setw(16) << "map" << std::setw(10) << "threads"
+              << std::setw(14) << "Mops/s" << std::setw(12) << "hits" << std::endl;
+    for (const original::u_integer threads : {1u, 2u, 4u, 8u}) {
+        run<lockedJMap>("JMap + pMutex", threads);
+        run<original::concurrentJMap<int, int>>("concurrentJMap", threads);
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <iostream>
+#include <iomanip>
+#include "maps.h"
+#include "vector.h"
+#include "zeit.h"
+
+// Percentile queries on a treeMap: select() and rank() through the subtree sizes
+// versus walking an iterator from the minimum key.
+
+namespace {
+    constexpr int KEYS = 1 << 18;
+    constexpr int QUERIES = 1 << 12;
+    constexpr int WALKS = 1 << 3;
+
+    double elapsedMs(const original::time::point& start) {
+        return (original::time::point::now() - start).value(original::time::MICROSECOND) / 1000.0;
+    }
+}
+
+int main() {
+    original::treeMap<int, int> m;
+    original::u_integer seed = 2166136261u;
+    for (int i = 0; i < KEYS; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        const int k = static_cast<int>(seed >> 1);
+        m.add(k, i);
+    }
+    original::vector<original::u_integer> positions;
+    for (int i = 0; i < QUERIES; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        positions.pushEnd(seed % m.size());
+    }
+
+    long long sum = 0;
+    auto start = original::time::point::now();
+    for (const original::u_integer p : positions) {
+        sum += m.select(p).first();
+    }
+    const double select_ms = elapsedMs(start);
+
+    long long walked = 0;
+    start = original::time::point::now();
+    for (int i = 0; i < WALKS; ++i) {
+        const original::u_integer p = positions[i];
+        const auto it = original::ownerPtr(m.begins());
+        for (original::u_integer step = 0; step < p; ++step) {
+            it->next();
+        }
+        walked += it->get().first();
+    }
+    const double walk_ms = elapsedMs(start);
+
+    long long ranks = 0;
+    start = original::time::point::now();
+    for (const original::u_integer p : positions) {
+        ranks += m.rank(m.select(p).first());
+    }
+    const double rank_ms = elapsedMs(start);
+
+    std::cout << KEYS << " keys, " << QUERIES << " percentile queries (" << WALKS << " walked)" << std::endl;
+    std::cout << std::setw(16) << "method" << std::setw(14) << "us/query" << std::setw(16) << "checksum" << std::endl;
+    std::cout << std::fixed << std::setprecision(3)
+              << std::setw(16) << "select" << std::setw(14) << select_ms * 1000 / QUERIES
+              << std::setw(16) << sum << std::endl
+              << std::setw(16) << "iterator walk" << std::setw(14) << walk_ms * 1000 / WALKS
+              << std::setw(16) << walked << std::endl
+              << std::setw(16) << "select + rank" << std::setw(14) << rank_ms * 1000 / QUERIES
+              << std::setw(16) << ranks << std::endl;
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include <iostream>
+#include <iomanip>
+#include "parallelTrees.h"
+#include "zeit.h"
+
+// Set algebra on two large ordered sets: element-wise add/contains loops versus
+// join/split treeSet operations, sequential and across a taskDelegator, and the
+// linear merge of JSet.
+
+namespace {
+    constexpr int ELEMENTS = 1 << 16;
+
+    double elapsedMs(const original::time::point& start) {
+        return (original::time::point::now() - start).value(original::time::MICROSECOND) / 1000.0;
+    }
+
+    constexpr int BLOCK = 1 << 10;
+
+    // Random keys, or alternating runs of BLOCK consecutive keys per set
+    template<typename SET>
+    void fill(SET& a, SET& b, const bool blocks) {
+        original::u_integer seed = 2166136261u;
+        for (int i = 0; i < ELEMENTS; ++i) {
+            if (blocks) {
+                a.add(i + i / BLOCK * BLOCK);
+                b.add(i + i / BLOCK * BLOCK + BLOCK);
+                continue;
+            }
+            seed = seed * 1664525u + 1013904223u;
+            a.add(static_cast<int>((seed >> 8) % (4u * ELEMENTS)));
+            seed = seed * 1664525u + 1013904223u;
+            b.add(static_cast<int>((seed >> 8) % (4u * ELEMENTS)));
+        }
+    }
+
+    template<typename SET, typename Union, typename Intersection>
+    void run(const char* name, const SET& a, const SET& b, Union unite, Intersection intersect) {
+        SET u = a;
+        auto start = original::time::point::now();
+        unite(u, b);
+        const double union_ms = elapsedMs(start);
+
+        SET n = a;
+        start = original::time::point::now();
+        intersect(n, b);
+        const double intersection_ms = elapsedMs(start);
+
+        std::cout << std::setw(22) << name << std::fixed << std::setprecision(2)
+                  << std::setw(12) << union_ms << std::setw(16) << intersection_ms
+                  << std::setw(10) << u.size() << std::setw(10) << n.size() << std::endl;
+    }
+}
+
+void compare(const bool blocks) {
+    original::treeSet<int> ta, tb;
+    fill(ta, tb, blocks);
+    original::JSet<int> ja, jb;
+    fill(ja, jb, blocks);
+    original::taskDelegator pool{4};
+
+    std::cout << "two sets of " << ELEMENTS << (blocks ? " keys in alternating runs" : " random adds") << std::endl;
+    std::cout << std::setw(22) << "method" << std::setw(12) << "union ms" << std::setw(16) << "intersect ms"
+              << std::setw(10) << "union" << std::setw(10) << "common" << std::endl;
+    run("treeSet add/contains", ta, tb,
+        [](auto& s, const auto& other) { for (const int e : other) s.add(e); },
+        [](auto& s, const auto& other) {
+            original::treeSet<int> kept;
+            for (const int e : s) {
+                if (other.contains(e))
+                    kept.add(e);
+            }
+            s = std::move(kept);
+        });
+    run("treeSet join", ta, tb,
+        [](auto& s, const auto& other) { s.unionWith(other); },
+        [](auto& s, const auto& other) { s.intersectWith(other); });
+    run("treeSet join x4", ta, tb,
+        [&pool](auto& s, const auto& other) { original::parallelUnion(s, other, pool); },
+        [&pool](auto& s, const auto& other) { original::parallelIntersection(s, other, pool); });
+    run("JSet add/contains", ja, jb,
+        [](auto& s, const auto& other) { for (const int e : other) s.add(e); },
+        [](auto& s, const auto& other) {
+            original::JSet<int> kept;
+            for (const int e : s) {
+                if (other.contains(e))
+                    kept.add(e);
+            }
+            s = std::move(kept);
+        });
+    run("JSet merge", ja, jb,
+        [](auto& s, const auto& other) { s.unionWith(other); },
+        [](auto& s, const auto& other) { s.intersectWith(other); });
+}
+
+int main() {
+    compare(false);
+    compare(true);
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <iostream>
+#include <iomanip>
+#include "maps.h"
+#include "zeit.h"
+
+// Consistent read views of an ordered map: copying a treeMap versus an O(1) persistentTreeMap
+// snapshot, and the write cost of path copying while snapshots (plain copies) are being taken.
+
+namespace {
+    constexpr int ELEMENTS = 1 << 16;
+    constexpr int VIEWS = 64;
+    constexpr int WRITES = 1 << 16;
+
+    double since(const original::time::point& start) {
+        return static_cast<double>((original::time::point::now() - start).value(original::time::MICROSECOND));
+    }
+
+    void report(const char* name, const double us, const int ops) {
+        std::cout << std::setw(40) << name << std::fixed << std::setprecision(3)
+                  << std::setw(14) << us / ops << std::endl;
+    }
+
+    template<typename MAP>
+    MAP filled() {
+        MAP map;
+        for (int i = 0; i < ELEMENTS; ++i) {
+            map.add(i * 2, i);
+        }
+        return map;
+    }
+
+    template<typename MAP>
+    double writes(const int snapshot_every) {
+        MAP map = filled<MAP>();
+        original::u_integer seed = 2166136261u;
+        MAP view;
+        const auto start = original::time::point::now();
+        for (int i = 0; i < WRITES; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            const int key = static_cast<int>(seed >> 8) % (ELEMENTS * 2);
+            if (seed >> 31) {
+                map.add(key, i);
+            } else {
+                map.remove(key);
+            }
+            if (snapshot_every && i % snapshot_every == 0) {
+                view = map;
+            }
+        }
+        return since(start);
+    }
+}
+
+int main() {
+    const auto tree = filled<original::treeMap<int, int>>();
+    const auto persistent = filled<original::persistentTreeMap<int, int>>();
+
+    std::cout << ELEMENTS << " pairs" << std::endl;
+    std::cout << std::setw(40) << "operation" << std::setw(14) << "us/op" << std::endl;
+
+    original::u_integer sizes = 0;
+    auto start = original::time::point::now();
+    for (int i = 0; i < VIEWS; ++i) {
+        const original::treeMap<int, int> view = tree;
+        sizes += view.size();
+    }
+    report("treeMap copy", since(start), VIEWS);
+
+    start = original::time::point::now();
+    for (int i = 0; i < VIEWS; ++i) {
+        const auto view = persistent.snapshot();
+        sizes += view.size();
+    }
+    report("persistentTreeMap snapshot", since(start), VIEWS);
+
+    using persistentMap = original::persistentTreeMap<int, int>;
+    report("treeMap write", writes<original::treeMap<int, int>>(0), WRITES);
+    report("persistentTreeMap write", writes<persistentMap>(0), WRITES);
+    report("persistentTreeMap write, snapshot/64", writes<persistentMap>(64), WRITES);
+    report("persistentTreeMap write, snapshot/1", writes<persistentMap>(1), WRITES);
+
+    std::cout << "checksum " << sizes << std::endl;
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include <iostream>
+#include <iomanip>
+#include <utility>
+#include "indexedHeap.h"
+#include "prique.h"
+#include "vector.h"
+#include "zeit.h"
+
+// Priority queues: prique (binary heap over blocksList or vector through polymorphic iterators) versus
+// indexedHeap of arity 2/4/8, on plain push/pop and on Dijkstra over a random sparse graph,
+// where prique re-inserts duplicates and indexedHeap calls decreaseKey.
+
+namespace {
+    constexpr int ELEMENTS = 1 << 12;
+    constexpr int VERTICES = 1 << 10;
+    constexpr original::u_integer DEGREE = 8;
+
+    using distance = std::pair<original::u_integer, original::u_integer>;
+
+    struct edge {
+        original::u_integer to;
+        original::u_integer weight;
+    };
+
+    double since(const original::time::point& start) {
+        return static_cast<double>((original::time::point::now() - start).value(original::time::MICROSECOND));
+    }
+
+    void report(const char* name, const char* workload, const double us, const int ops,
+                const original::ul_integer checksum) {
+        std::cout << std::setw(16) << name << std::setw(12) << workload << std::fixed << std::setprecision(3)
+                  << std::setw(12) << us / ops << std::setw(24) << checksum << std::endl;
+    }
+
+    original::u_integer next(original::u_integer& seed) {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    }
+
+    template<typename HEAP>
+    void pushPop(const char* name) {
+        HEAP heap;
+        original::u_integer seed = 12345;
+        original::ul_integer checksum = 0;
+        const auto start = original::time::point::now();
+        for (int i = 0; i < ELEMENTS; ++i) {
+            heap.push(distance{next(seed), i});
+        }
+        while (!heap.empty()) {
+            checksum = checksum * 31 + heap.pop().first;
+        }
+        report(name, "push/pop", since(start), ELEMENTS, checksum);
+    }
+
+    template<template <typename, typename> typename SERIAL>
+    original::ul_integer dijkstraPrique(const original::vector<edge>& graph) {
+        auto dist = original::makeVector<original::u_integer>(VERTICES, static_cast<original::u_integer>(-1));
+        original::prique<distance, original::increaseComparator, SERIAL> heap;
+        dist[0] = 0;
+        heap.push({0, 0});
+        while (!heap.empty()) {
+            const auto [d, v] = heap.pop();
+            if (d != dist[v]) {
+                continue;
+            }
+            for (original::u_integer e = v * DEGREE; e < (v + 1) * DEGREE; ++e) {
+                const auto [to, weight] = graph[e];
+                if (d + weight < dist[to]) {
+                    dist[to] = d + weight;
+                    heap.push({dist[to], to});
+                }
+            }
+        }
+        original::ul_integer sum = 0;
+        for (const auto d : dist) {
+            sum += d;
+        }
+        return sum;
+    }
+
+    template<original::u_integer ARITY>
+    original::ul_integer dijkstraIndexed(const original::vector<edge>& graph) {
+        using heapType = original::indexedHeap<distance, original::increaseComparator, ARITY>;
+        constexpr auto NONE = static_cast<typename heapType::handle>(-1);
+        auto dist = original::makeVector<original::u_integer>(VERTICES, static_cast<original::u_integer>(-1));
+        auto handles = original::makeVector<typename heapType::handle>(VERTICES, NONE);
+        heapType heap;
+        dist[0] = 0;
+        handles[0] = heap.push({0, 0});
+        while (!heap.empty()) {
+            const auto [d, v] = heap.pop();
+            for (original::u_integer e = v * DEGREE; e < (v + 1) * DEGREE; ++e) {
+                const auto [to, weight] = graph[e];
+                if (d + weight < dist[to]) {
+                    dist[to] = d + weight;
+                    if (handles[to] == NONE) {
+                        handles[to] = heap.push({dist[to], to});
+                    } else {
+                        heap.decreaseKey(handles[to], {dist[to], to});
+                    }
+                }
+            }
+        }
+        original::ul_integer sum = 0;
+        for (const auto d : dist) {
+            sum += d;
+        }
+        return sum;
+    }
+
+    template<typename Search>
+    void shortestPaths(const char* name, const original::vector<edge>& graph, Search search) {
+        const auto start = original::time::point::now();
+        const auto checksum = search(graph);
+        report(name, "dijkstra", since(start), VERTICES * DEGREE, checksum);
+    }
+}
+
+int main() {
+    std::cout << ELEMENTS << " push/pop, dijkstra over " << VERTICES << " vertices x " << DEGREE << " edges" << std::endl;
+    std::cout << std::setw(16) << "heap" << std::setw(12) << "workload"
+              << std::setw(12) << "us/op" << std::setw(24) << "checksum" << std::endl;
+
+    pushPop<original::prique<distance>>("prique");
+    pushPop<original::prique<distance, original::increaseComparator, original::vector>>("prique<vector>");
+    pushPop<original::indexedHeap<distance, original::increaseComparator, 2>>("indexedHeap<2>");
+    pushPop<original::indexedHeap<distance, original::increaseComparator, 4>>("indexedHeap<4>");
+    pushPop<original::indexedHeap<distance, original::increaseComparator, 8>>("indexedHeap<8>");
+
+    // Edges of vertex v are graph[v * DEGREE, (v + 1) * DEGREE)
+    original::vector<edge> graph;
+    original::u_integer seed = 777;
+    for (original::u_integer e = 0; e < VERTICES * DEGREE; ++e) {
+        const original::u_integer to = next(seed) % VERTICES;
+        graph.pushEnd({to, next(seed) % 1000 + 1});
+    }
+    shortestPaths("prique", graph, dijkstraPrique<original::blocksList>);
+    shortestPaths("prique<vector>", graph, dijkstraPrique<original::vector>);
+    shortestPaths("indexedHeap<2>", graph, dijkstraIndexed<2>);
+    shortestPaths("indexedHeap<4>", graph, dijkstraIndexed<4>);
+    shortestPaths("indexedHeap<8>", graph, dijkstraIndexed<8>);
+    return 0;
+}
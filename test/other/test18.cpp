@@ -0,0 +1,89 @@
+#include <iostream>
+#include <iomanip>
+#include "pairingHeap.h"
+#include "prique.h"
+#include "vector.h"
+#include "zeit.h"
+
+// Merging per-shard priority queues every tick: prique drains every shard into the global
+// queue, pairingHeap links each shard in O(1), with node storage from objPoolAllocator
+// (default) or the plain allocator.
+
+namespace {
+    constexpr int SHARDS = 8;
+    constexpr int PER_SHARD = 256;
+    constexpr int TICKS = 8;
+    constexpr int POPS_PER_TICK = SHARDS * PER_SHARD / 2;
+
+    double since(const original::time::point& start) {
+        return static_cast<double>((original::time::point::now() - start).value(original::time::MICROSECOND));
+    }
+
+    original::u_integer next(original::u_integer& seed) {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    }
+
+    void report(const char* name, const double merge_us, const double total_us, const original::ul_integer checksum) {
+        std::cout << std::setw(28) << name << std::fixed << std::setprecision(3)
+                  << std::setw(14) << merge_us / (TICKS * SHARDS)
+                  << std::setw(14) << total_us / TICKS << std::setw(24) << checksum << std::endl;
+    }
+
+    template<typename HEAP, typename Merge>
+    void run(const char* name, Merge merge) {
+        HEAP global;
+        original::u_integer seed = 4242;
+        original::ul_integer checksum = 0;
+        double merge_us = 0;
+        const auto start = original::time::point::now();
+        for (int tick = 0; tick < TICKS; ++tick) {
+            original::vector<HEAP*> shards;
+            for (int s = 0; s < SHARDS; ++s) {
+                auto shard = new HEAP;
+                for (int i = 0; i < PER_SHARD; ++i) {
+                    shard->push(next(seed) % 1000000);
+                }
+                shards.pushEnd(shard);
+            }
+
+            const auto merge_start = original::time::point::now();
+            for (auto shard : shards) {
+                merge(global, *shard);
+            }
+            merge_us += since(merge_start);
+
+            for (auto shard : shards) {
+                delete shard;
+            }
+            for (int i = 0; i < POPS_PER_TICK; ++i) {
+                checksum = checksum * 31 + global.pop();
+            }
+        }
+        report(name, merge_us, since(start), checksum);
+    }
+}
+
+int main() {
+    using pooled = original::pairingHeap<original::u_integer>;
+    using plain = original::pairingHeap<original::u_integer, original::increaseComparator, original::allocator>;
+    using queue = original::prique<original::u_integer>;
+
+    std::cout << TICKS << " ticks, " << SHARDS << " shards x " << PER_SHARD << " pushes, "
+              << POPS_PER_TICK << " pops per tick" << std::endl;
+    std::cout << std::setw(28) << "heap" << std::setw(14) << "us/merge"
+              << std::setw(14) << "us/tick" << std::setw(24) << "checksum" << std::endl;
+
+    run<queue>("prique (re-push)", [](queue& global, queue& shard) {
+        while (!shard.empty()) {
+            global.push(shard.pop());
+        }
+    });
+    run<pooled>("pairingHeap<objPool>", [](pooled& global, pooled& shard) {
+        global.merge(shard);
+    });
+    run<plain>("pairingHeap<allocator>", [](plain& global, plain& shard) {
+        global.merge(shard);
+    });
+    return 0;
+}
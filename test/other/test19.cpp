@@ -0,0 +1,120 @@
+#include <iostream>
+#include <iomanip>
+#include "condition.h"
+#include "mutex.h"
+#include "queue.h"
+#include "spscRing.h"
+#include "thread.h"
+#include "zeit.h"
+
+// Hand-off between one producer thread and one consumer thread: a bounded queue guarded by
+// pMutex with two pConditions, versus spscRing moving one element per call (blocking push/pop)
+// and moving batches with tryPushN/tryPopN.
+
+namespace {
+    constexpr int ELEMENTS = 1 << 21;
+    constexpr original::u_integer CAPACITY = 1024;
+    constexpr original::u_integer BATCH = 64;
+
+    double since(const original::time::point& start) {
+        return static_cast<double>((original::time::point::now() - start).value(original::time::MICROSECOND));
+    }
+
+    void report(const char* name, const double us, const original::ul_integer checksum) {
+        std::cout << std::setw(20) << name << std::fixed << std::setprecision(4)
+                  << std::setw(12) << us * 1000 / ELEMENTS
+                  << std::setw(14) << ELEMENTS / us << std::setw(20) << checksum << std::endl;
+    }
+
+    void lockedQueue() {
+        original::queue<int> q;
+        original::pMutex mutex;
+        original::pCondition not_empty;
+        original::pCondition not_full;
+        original::ul_integer checksum = 0;
+        const auto start = original::time::point::now();
+        original::thread producer{[&] {
+            for (int i = 0; i < ELEMENTS; ++i) {
+                original::uniqueLock lock{mutex};
+                not_full.wait(mutex, [&] { return q.size() < CAPACITY; });
+                q.push(i);
+                not_empty.notify();
+            }
+        }};
+        for (int i = 0; i < ELEMENTS; ++i) {
+            original::uniqueLock lock{mutex};
+            not_empty.wait(mutex, [&] { return !q.empty(); });
+            checksum += static_cast<original::ul_integer>(q.pop());
+            not_full.notify();
+        }
+        producer.join();
+        report("queue+pMutex", since(start), checksum);
+    }
+
+    void ringSingle() {
+        original::spscRing<int> ring{CAPACITY};
+        original::ul_integer checksum = 0;
+        const auto start = original::time::point::now();
+        original::thread producer{[&ring] {
+            for (int i = 0; i < ELEMENTS; ++i) {
+                ring.push(i);
+            }
+            ring.close();
+        }};
+        while (const auto e = ring.pop()) {
+            checksum += static_cast<original::ul_integer>(*e);
+        }
+        producer.join();
+        report("spscRing push/pop", since(start), checksum);
+    }
+
+    void ringBatch() {
+        original::spscRing<int> ring{CAPACITY};
+        original::ul_integer checksum = 0;
+        const auto start = original::time::point::now();
+        original::thread producer{[&ring] {
+            int batch[BATCH];
+            int next = 0;
+            while (next < ELEMENTS) {
+                for (original::u_integer i = 0; i < BATCH; ++i) {
+                    batch[i] = next + static_cast<int>(i);
+                }
+                original::u_integer sent = 0;
+                while (sent < BATCH) {
+                    const auto pushed = ring.tryPushN(batch + sent, BATCH - sent);
+                    if (pushed == 0) {
+                        original::thread::yield();
+                    }
+                    sent += pushed;
+                }
+                next += BATCH;
+            }
+            ring.close();
+        }};
+        int batch[BATCH];
+        while (true) {
+            const auto popped = ring.tryPopN(batch, BATCH);
+            for (original::u_integer i = 0; i < popped; ++i) {
+                checksum += static_cast<original::ul_integer>(batch[i]);
+            }
+            if (popped == 0) {
+                if (ring.closed() && ring.empty()) {
+                    break;
+                }
+                original::thread::yield();
+            }
+        }
+        producer.join();
+        report("spscRing batch 64", since(start), checksum);
+    }
+}
+
+int main() {
+    std::cout << ELEMENTS << " ints, capacity " << CAPACITY << std::endl;
+    std::cout << std::setw(20) << "channel" << std::setw(12) << "ns/elem"
+              << std::setw(14) << "Melem/s" << std::setw(20) << "checksum" << std::endl;
+    lockedQueue();
+    ringSingle();
+    ringBatch();
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include "condition.h"
+#include "mpmcQueue.h"
+#include "mutex.h"
+#include "queue.h"
+#include "thread.h"
+#include "zeit.h"
+
+// Fan-in/fan-out under contention: N producer threads hand ELEMENTS ints to N consumer threads,
+// for N from 1 to 64, through a bounded queue guarded by one pMutex and two pConditions and
+// through mpmcQueue.
+
+namespace {
+    constexpr int ELEMENTS = 1 << 20;
+    constexpr original::u_integer CAPACITY = 1024;
+
+    double since(const original::time::point& start) {
+        return static_cast<double>((original::time::point::now() - start).value(original::time::MICROSECOND));
+    }
+
+    void report(const char* name, const int threads, const double us, const original::ul_integer checksum) {
+        std::cout << std::setw(16) << name << std::setw(8) << threads << std::fixed << std::setprecision(2)
+                  << std::setw(12) << us * 1000 / ELEMENTS << std::setw(20) << checksum << std::endl;
+    }
+
+    // Runs produce(first, last) on every producer for its share of the elements and consume() on
+    // every consumer, then sums what the consumers return.
+    template<typename Produce, typename Close, typename Consume>
+    original::ul_integer fan(const int threads, Produce produce, Close close, Consume consume) {
+        std::vector<original::ul_integer> sums(threads, 0);
+        std::vector<original::thread> consumers;
+        for (int c = 0; c < threads; ++c) {
+            consumers.emplace_back([&, c] { sums[c] = consume(); });
+        }
+        {
+            std::vector<original::thread> producers;
+            const int share = ELEMENTS / threads;
+            for (int p = 0; p < threads; ++p) {
+                producers.emplace_back([&, p] { produce(p * share, (p + 1) * share); });
+            }
+        }
+        close();
+        for (auto& t : consumers) {
+            t.join();
+        }
+        original::ul_integer checksum = 0;
+        for (const auto s : sums) {
+            checksum += s;
+        }
+        return checksum;
+    }
+
+    void lockedQueue(const int threads) {
+        original::queue<int> q;
+        original::pMutex mutex;
+        original::pCondition not_empty;
+        original::pCondition not_full;
+        bool closed = false;
+        const auto start = original::time::point::now();
+        const auto checksum = fan(threads,
+            [&](const int first, const int last) {
+                for (int i = first; i < last; ++i) {
+                    original::uniqueLock lock{mutex};
+                    not_full.wait(mutex, [&] { return q.size() < CAPACITY; });
+                    q.push(i);
+                    not_empty.notify();
+                }
+            },
+            [&] {
+                original::uniqueLock lock{mutex};
+                closed = true;
+                not_empty.notifyAll();
+            },
+            [&] {
+                original::ul_integer sum = 0;
+                while (true) {
+                    original::uniqueLock lock{mutex};
+                    not_empty.wait(mutex, [&] { return !q.empty() || closed; });
+                    if (q.empty()) {
+                        return sum;
+                    }
+                    sum += static_cast<original::ul_integer>(q.pop());
+                    not_full.notify();
+                }
+            });
+        report("queue+pMutex", threads, since(start), checksum);
+    }
+
+    void lockFreeQueue(const int threads) {
+        original::mpmcQueue<int> q{CAPACITY};
+        const auto start = original::time::point::now();
+        const auto checksum = fan(threads,
+            [&](const int first, const int last) {
+                for (int i = first; i < last; ++i) {
+                    q.push(i);
+                }
+            },
+            [&] { q.close(); },
+            [&] {
+                original::ul_integer sum = 0;
+                while (const auto e = q.pop()) {
+                    sum += static_cast<original::ul_integer>(*e);
+                }
+                return sum;
+            });
+        report("mpmcQueue", threads, since(start), checksum);
+    }
+}
+
+int main() {
+    std::cout << ELEMENTS << " ints, capacity " << CAPACITY << ", N producers and N consumers" << std::endl;
+    std::cout << std::setw(16) << "queue" << std::setw(8) << "N"
+              << std::setw(12) << "ns/elem" << std::setw(20) << "checksum" << std::endl;
+    for (const int threads : {1, 4, 16, 64}) {
+        lockedQueue(threads);
+        lockFreeQueue(threads);
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "channel.h"
+#include "thread.h"
+#include "zeit.h"
+
+// Log shipping through a channel: PRODUCERS threads send short log lines, one shipper thread
+// receives them one lock round-trip per message (receive) or per batch (receiveBatch), on an
+// unbounded and on a bounded channel.
+
+namespace {
+    constexpr int PRODUCERS = 4;
+    constexpr int PER_PRODUCER = 1 << 16;
+    constexpr int MESSAGES = PRODUCERS * PER_PRODUCER;
+    constexpr original::u_integer BOUND = 4096;
+
+    double since(const original::time::point& start) {
+        return static_cast<double>((original::time::point::now() - start).value(original::time::MICROSECOND));
+    }
+
+    void report(const char* name, const original::u_integer capacity, const double us,
+                const original::ul_integer shipped) {
+        std::cout << std::setw(20) << name << std::setw(10)
+                  << (capacity == original::channel<std::string>::UNBOUNDED ? std::string{"unbounded"} : std::to_string(capacity))
+                  << std::fixed << std::setprecision(1) << std::setw(12) << us * 1000 / MESSAGES
+                  << std::setw(14) << shipped << std::endl;
+    }
+
+    template<typename Ship>
+    void run(const char* name, const original::u_integer capacity, Ship ship) {
+        original::channel<std::string> logs{capacity};
+        const auto start = original::time::point::now();
+        original::ul_integer shipped = 0;
+        original::thread shipper{[&] { shipped = ship(logs); }};
+        {
+            std::vector<original::thread> producers;
+            for (int p = 0; p < PRODUCERS; ++p) {
+                producers.emplace_back([&logs, p] {
+                    for (int i = 0; i < PER_PRODUCER; ++i) {
+                        logs.send("worker " + std::to_string(p) + " request " + std::to_string(i));
+                    }
+                });
+            }
+        }
+        logs.close();
+        shipper.join();
+        report(name, capacity, since(start), shipped);
+    }
+
+    original::ul_integer shipEach(original::channel<std::string>& logs) {
+        original::ul_integer bytes = 0;
+        while (const auto line = logs.receive()) {
+            bytes += line->size();
+        }
+        return bytes;
+    }
+
+    template<original::u_integer BATCH>
+    original::ul_integer shipBatches(original::channel<std::string>& logs) {
+        original::ul_integer bytes = 0;
+        while (true) {
+            const auto lines = logs.receiveBatch(BATCH);
+            if (lines.empty()) {
+                return bytes;
+            }
+            for (const auto& line : lines) {
+                bytes += line.size();
+            }
+        }
+    }
+}
+
+int main() {
+    std::cout << PRODUCERS << " producers x " << PER_PRODUCER << " log lines, one shipper" << std::endl;
+    std::cout << std::setw(20) << "shipper" << std::setw(10) << "capacity"
+              << std::setw(12) << "ns/msg" << std::setw(14) << "bytes" << std::endl;
+    for (const original::u_integer capacity : {original::channel<std::string>::UNBOUNDED, BOUND}) {
+        run("receive", capacity, shipEach);
+        run("receiveBatch(64)", capacity, shipBatches<64>);
+        run("receiveBatch(1024)", capacity, shipBatches<1024>);
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include "async.h"
+#include "thread.h"
+#include "zeit.h"
+
+// Cost of the future/promise shared state: creating a promise and running it in place, reading
+// an already completed future (the uncontended fast path) and handing a result to a consumer
+// that is blocked in result() on another thread.
+
+namespace {
+    constexpr int PROMISES = 1 << 18;
+    constexpr int READS = 1 << 22;
+    constexpr int HANDOFFS = 1 << 12;
+
+    double since(const original::time::point& start) {
+        return static_cast<double>((original::time::point::now() - start).value(original::time::MICROSECOND));
+    }
+
+    void report(const char* name, const double us, const int ops, const original::ul_integer checksum) {
+        std::cout << std::setw(28) << name << std::fixed << std::setprecision(1)
+                  << std::setw(12) << us * 1000 / ops << std::setw(16) << checksum << std::endl;
+    }
+
+    void runInPlace() {
+        original::ul_integer checksum = 0;
+        const auto start = original::time::point::now();
+        for (int i = 0; i < PROMISES; ++i) {
+            auto p = original::async::makePromise([i] { return std::to_string(i); });
+            auto f = p.getFuture();
+            p.run();
+            checksum += f.result().size();
+        }
+        report("promise+run+result", since(start), PROMISES, checksum);
+    }
+
+    void readReady() {
+        auto p = original::async::makePromise([] { return 42; });
+        const auto f = p.getFuture().share();
+        p.run();
+        original::ul_integer checksum = 0;
+        const auto start = original::time::point::now();
+        for (int i = 0; i < READS; ++i) {
+            f.wait();
+            checksum += f.ready() ? 1 : 0;
+        }
+        report("ready sharedFuture wait", since(start), READS, checksum);
+    }
+
+    void handOff() {
+        original::ul_integer checksum = 0;
+        const auto start = original::time::point::now();
+        for (int i = 0; i < HANDOFFS; ++i) {
+            auto p = original::async::makePromise([i] { return i; });
+            auto f = p.getFuture();
+            original::thread producer{[&p] {
+                original::thread::yield();
+                p.run();
+            }};
+            checksum += static_cast<original::ul_integer>(f.result());
+        }
+        report("blocked result() handoff", since(start), HANDOFFS, checksum);
+    }
+}
+
+int main() {
+    std::cout << std::setw(28) << "operation" << std::setw(12) << "ns/op" << std::setw(16) << "checksum" << std::endl;
+    runInPlace();
+    readReady();
+    handOff();
+    return 0;
+}
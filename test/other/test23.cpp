@@ -0,0 +1,68 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include "thread.h"
+#include "timerWheel.h"
+#include "zeit.h"
+
+// Connection-timeout tracking with one timer per connection: TIMERS timeouts spread over
+// SPREAD_MS milliseconds (after a 200 ms grace period) are armed, most connections finish
+// early and cancel theirs, and the rest expire on the wheel's driver thread. Reports the cost
+// of arming and cancelling, and how late the expired timers fired relative to their deadlines.
+
+namespace {
+    constexpr int TIMERS = 1 << 20;
+    constexpr int SPREAD_MS = 400;
+    constexpr int KEEP_EVERY = 8;   // one connection in KEEP_EVERY times out
+
+    double since(const original::time::point& start) {
+        return static_cast<double>((original::time::point::now() - start).value(original::time::MICROSECOND));
+    }
+
+    void report(const char* name, const double us, const int ops) {
+        std::cout << std::setw(24) << name << std::fixed << std::setprecision(1)
+                  << std::setw(12) << us * 1000 / ops << std::setw(12) << ops << std::endl;
+    }
+}
+
+int main() {
+    original::timerWheel wheel;
+    std::vector<original::timerWheel::timer> timers(TIMERS);
+    original::integer worst_late_us = 0;
+    original::ul_integer late_sum_us = 0;
+    int expired = 0;
+
+    std::cout << std::setw(24) << "operation" << std::setw(12) << "ns/op" << std::setw(12) << "ops" << std::endl;
+    const auto armed = original::time::point::now();
+    for (int i = 0; i < TIMERS; ++i) {
+        const auto deadline = armed + original::time::duration{200 + i % SPREAD_MS, original::time::MILLISECOND};
+        // Only the driver thread touches the statistics
+        timers[i] = wheel.scheduleAt(deadline, [deadline, &worst_late_us, &late_sum_us, &expired] {
+            const auto late = (original::time::point::now() - deadline).value(original::time::MICROSECOND);
+            worst_late_us = late > worst_late_us ? late : worst_late_us;
+            late_sum_us += static_cast<original::ul_integer>(late);
+            ++expired;
+        });
+    }
+    report("schedule", since(armed), TIMERS);
+    std::cout << std::setw(24) << "pending" << std::setw(24) << wheel.pending() << std::endl;
+
+    int cancelled = 0;
+    const auto cancelling = original::time::point::now();
+    for (int i = 0; i < TIMERS; ++i) {
+        if (i % KEEP_EVERY != 0) {
+            cancelled += timers[i].cancel() ? 1 : 0;
+        }
+    }
+    report("cancel", since(cancelling), cancelled);
+
+    while (wheel.pending() > 0) {
+        original::thread::sleep(original::time::duration{10, original::time::MILLISECOND});
+    }
+    wheel.stop();
+    std::cout << std::setw(24) << "expired" << std::setw(24) << expired << std::endl;
+    std::cout << std::setw(24) << "mean lateness (us)" << std::setw(24)
+              << (expired > 0 ? late_sum_us / expired : 0) << std::endl;
+    std::cout << std::setw(24) << "worst lateness (us)" << std::setw(24) << worst_late_us << std::endl;
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include <iostream>
+#include <iomanip>
+#include <functional>
+#include <vector>
+#include "tasks.h"
+#include "zeit.h"
+
+// Fan-out of TASKS tiny tasks onto a taskDelegator: one submit() call per task versus
+// submitBatch() in chunks of BATCH callables. Reports the submitting thread's cost per task
+// and the end-to-end cost until every result has been read.
+
+namespace {
+    constexpr int TASKS = 100000;
+    constexpr int BATCH = 1000;
+
+    double since(const original::time::point& start) {
+        return static_cast<double>((original::time::point::now() - start).value(original::time::NANOSECOND));
+    }
+
+    void report(const char* name, const original::u_integer threads, const double submit_ns,
+                const double total_ns, const original::ul_integer checksum) {
+        std::cout << std::setw(16) << name << std::setw(8) << threads << std::fixed << std::setprecision(1)
+                  << std::setw(12) << submit_ns / TASKS << std::setw(12) << total_ns / TASKS
+                  << std::setw(12) << checksum << std::endl;
+    }
+
+    void oneByOne(const original::u_integer threads) {
+        original::taskDelegator delegator{threads};
+        std::vector<original::async::future<int>> futures;
+        futures.reserve(TASKS);
+        const auto start = original::time::point::now();
+        for (int i = 0; i < TASKS; ++i) {
+            futures.push_back(delegator.submit([i] { return i & 7; }));
+        }
+        const double submitted = since(start);
+        original::ul_integer checksum = 0;
+        for (auto& f : futures) {
+            checksum += static_cast<original::ul_integer>(f.result());
+        }
+        report("submit", threads, submitted, since(start), checksum);
+    }
+
+    void batched(const original::u_integer threads) {
+        original::taskDelegator delegator{threads};
+        std::vector<original::array<original::async::future<int>>> batches;
+        std::vector<std::function<int()>> chunk(BATCH);
+        const auto start = original::time::point::now();
+        for (int first = 0; first < TASKS; first += BATCH) {
+            for (int i = 0; i < BATCH; ++i) {
+                chunk[i] = [v = first + i] { return v & 7; };
+            }
+            batches.push_back(delegator.submitBatch(std::move(chunk)));
+        }
+        const double submitted = since(start);
+        original::ul_integer checksum = 0;
+        for (auto& futures : batches) {
+            for (original::u_integer i = 0; i < futures.size(); ++i) {
+                checksum += static_cast<original::ul_integer>(futures[i].result());
+            }
+        }
+        report("submitBatch", threads, submitted, since(start), checksum);
+    }
+}
+
+int main() {
+    std::cout << TASKS << " tiny tasks, batches of " << BATCH << std::endl;
+    std::cout << std::setw(16) << "submission" << std::setw(8) << "threads" << std::setw(12) << "submit ns"
+              << std::setw(12) << "total ns" << std::setw(12) << "checksum" << std::endl;
+    for (const original::u_integer threads : {1u, 4u}) {
+        oneByOne(threads);
+        batched(threads);
+    }
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include <iostream>
+#include <iomanip>
+#include "taskGraph.h"
+#include "tasks.h"
+#include "zeit.h"
+
+// A batch pipeline shaped DAG: LAYERS layers of WIDTH steps, each step depending on two
+// steps of the previous layer. The same built graph is run ROUNDS times; reports the
+// scheduling cost per node (the steps themselves do almost nothing) and the slowest steps
+// of the last run.
+
+namespace {
+    constexpr original::u_integer LAYERS = 40;
+    constexpr original::u_integer WIDTH = 100;
+    constexpr int ROUNDS = 200;
+
+    void bench(const original::u_integer threads) {
+        original::taskDelegator delegator{threads};
+        original::taskGraph graph;
+        original::ul_integer sink = 0;
+        for (original::u_integer l = 0; l < LAYERS; ++l) {
+            for (original::u_integer w = 0; w < WIDTH; ++w) {
+                const original::u_integer i = l * WIDTH + w;
+                graph.add([&sink, i] { __atomic_fetch_add(&sink, i, __ATOMIC_RELAXED); });
+                if (l > 0) {
+                    graph.precede(i - WIDTH, i);
+                    graph.precede((l - 1) * WIDTH + (w + 1) % WIDTH, i);
+                }
+            }
+        }
+        const auto start = original::time::point::now();
+        for (int r = 0; r < ROUNDS; ++r) {
+            graph.run(delegator);
+        }
+        const auto total = (original::time::point::now() - start).value(original::time::NANOSECOND);
+        const original::u_integer nodes = LAYERS * WIDTH;
+        std::cout << std::setw(8) << threads << std::setw(10) << nodes << std::fixed << std::setprecision(1)
+                  << std::setw(14) << static_cast<double>(total) / (ROUNDS * nodes)
+                  << std::setw(14) << graph.lastRun().value(original::time::MICROSECOND)
+                  << std::setw(14) << sink << std::endl;
+    }
+}
+
+int main() {
+    std::cout << std::setw(8) << "threads" << std::setw(10) << "nodes" << std::setw(14) << "ns/node"
+              << std::setw(14) << "last run us" << std::setw(14) << "checksum" << std::endl;
+    for (const original::u_integer threads : {1u, 4u}) {
+        bench(threads);
+    }
+    return 0;
+}
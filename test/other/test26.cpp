@@ -0,0 +1,66 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <vector>
+#include "parallel.h"
+#include "tasks.h"
+#include "zeit.h"
+
+// parallelFor over N elements with a cheap body, against a plain loop, for several grain
+// sizes and pool sizes; then a nested parallelFor (outer x inner) on a one-worker pool,
+// which deadlocks with submit() + result() but completes here because joining threads help.
+
+namespace {
+    constexpr original::integer N = 1 << 22;
+
+    double since(const original::time::point& start) {
+        return static_cast<double>((original::time::point::now() - start).value(original::time::MICROSECOND));
+    }
+
+    void report(const char* name, const original::u_integer threads, const original::u_integer grain,
+                const double us, const double checksum) {
+        std::cout << std::setw(12) << name << std::setw(8) << threads << std::setw(10) << grain
+                  << std::fixed << std::setprecision(2) << std::setw(12) << us * 1000 / N
+                  << std::setprecision(0) << std::setw(16) << checksum << std::endl;
+    }
+}
+
+int main() {
+    std::vector<double> out(N);
+    std::cout << std::setw(12) << "loop" << std::setw(8) << "threads" << std::setw(10) << "grain"
+              << std::setw(12) << "ns/elem" << std::setw(16) << "checksum" << std::endl;
+
+    auto start = original::time::point::now();
+    for (original::integer i = 0; i < N; ++i) {
+        out[i] = std::sqrt(static_cast<double>(i));
+    }
+    double sum = 0;
+    for (const double v : out) sum += v;
+    report("serial", 0, 0, since(start), sum);
+
+    for (const original::u_integer threads : {1u, 4u}) {
+        original::taskDelegator delegator{threads};
+        for (const original::u_integer grain : {256u, 4096u, 65536u}) {
+            start = original::time::point::now();
+            original::parallelFor(delegator, 0, N, grain, [&out](const original::integer i) {
+                out[i] = std::sqrt(static_cast<double>(i));
+            });
+            const double us = since(start);
+            sum = 0;
+            for (const double v : out) sum += v;
+            report("parallelFor", threads, grain, us, sum);
+        }
+    }
+
+    original::taskDelegator single{1};
+    start = original::time::point::now();
+    original::parallelFor(single, 0, 256, 1, [&](const original::integer i) {
+        original::parallelFor(single, 0, N / 256, 1024, [&, i](const original::integer j) {
+            out[i * (N / 256) + j] = std::sqrt(static_cast<double>(j));
+        });
+    });
+    sum = 0;
+    for (const double v : out) sum += v;
+    report("nested", 1, 1024, since(start), sum);
+    return 0;
+}
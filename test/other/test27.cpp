@@ -0,0 +1,59 @@
+#include <iostream>
+#include <iomanip>
+#include "tasks.h"
+#include "zeit.h"
+
+// Cost of taskDelegator latency instrumentation: TASKS tiny tasks posted without futures,
+// with instrumentation off and on. Reports the end-to-end cost per task and, when on, the
+// collected wait and run percentiles.
+
+namespace {
+    constexpr int TASKS = 200000;
+
+    double since(const original::time::point& start) {
+        return static_cast<double>((original::time::point::now() - start).value(original::time::NANOSECOND));
+    }
+
+    double ns(const original::time::duration& d) {
+        return static_cast<double>(d.value(original::time::NANOSECOND));
+    }
+
+    void run(const original::u_integer threads, const bool instrumented) {
+        original::taskDelegator delegator{threads};
+        delegator.instrument(instrumented);
+        original::atomic<original::u_integer> done{original::makeAtomic<original::u_integer>(0)};
+        const auto start = original::time::point::now();
+        for (int i = 0; i < TASKS; ++i) {
+            delegator.post(original::taskDelegator::NORMAL, [&done] { done += 1; });
+        }
+        while (done.load() < TASKS) {
+            if (!delegator.tryRunOne()) {
+                original::thread::sleep(original::time::duration{100, original::time::MICROSECOND});
+            }
+        }
+        const double total = since(start);
+        std::cout << std::setw(8) << threads << std::setw(14) << (instrumented ? "on" : "off")
+                  << std::fixed << std::setprecision(1) << std::setw(12) << total / TASKS;
+        if (instrumented) {
+            const auto stats = delegator.stats();
+            const auto& wait = stats.waitOf(original::taskDelegator::NORMAL);
+            const auto& ran = stats.runOf(original::taskDelegator::NORMAL);
+            std::cout << std::setw(14) << ns(wait.percentile(0.5)) << std::setw(14) << ns(wait.percentile(0.99))
+                      << std::setw(14) << ns(ran.percentile(0.5)) << std::setw(14) << ns(ran.percentile(0.99))
+                      << std::setw(14) << stats.queue_high_water;
+        }
+        std::cout << std::endl;
+    }
+}
+
+int main() {
+    std::cout << TASKS << " tiny posted tasks" << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(14) << "instrumented" << std::setw(12) << "ns/task"
+              << std::setw(14) << "wait p50 ns" << std::setw(14) << "wait p99 ns" << std::setw(14) << "run p50 ns"
+              << std::setw(14) << "run p99 ns" << std::setw(14) << "high water" << std::endl;
+    for (const original::u_integer threads : {1u, 4u}) {
+        run(threads, false);
+        run(threads, true);
+    }
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include "tasks.h"
+#include "zeit.h"
+
+// Cache-resident work on pinned and unpinned taskDelegator workers. Every round each of
+// WORKERS pieces sweeps its own BLOCK-byte buffer, which fits in L2, so a worker that stays on
+// its core finds the buffer still cached. Reports the cost per sweep; the difference only shows
+// with more CPUs than workers and other load on the machine.
+
+namespace {
+    constexpr int ROUNDS = 400;
+    constexpr int BLOCK = 256 * 1024;
+
+    void run(const char* name, const original::u_integer workers, const original::taskDelegator::pinPolicy pin) {
+        original::taskDelegator delegator{workers, pin};
+        std::vector<std::vector<unsigned char>> buffers(workers, std::vector<unsigned char>(BLOCK, 1));
+        original::ul_integer checksum = 0;
+        const auto start = original::time::point::now();
+        for (int round = 0; round < ROUNDS; ++round) {
+            std::vector<original::async::future<original::ul_integer>> sums;
+            for (original::u_integer w = 0; w < workers; ++w) {
+                sums.push_back(delegator.submit([&buffer = buffers[w]] {
+                    original::ul_integer sum = 0;
+                    for (int i = 0; i < BLOCK; i += 64) {
+                        buffer[i] += 1;
+                        sum += buffer[i];
+                    }
+                    return sum;
+                }));
+            }
+            for (auto& s : sums) {
+                checksum += s.result();
+            }
+        }
+        const auto ns = static_cast<double>((original::time::point::now() - start).value(original::time::NANOSECOND));
+        std::cout << std::setw(10) << name << std::setw(9) << workers << std::fixed << std::setprecision(1)
+                  << std::setw(14) << ns / (ROUNDS * workers) << std::setw(14) << checksum << std::endl;
+    }
+}
+
+int main() {
+    const auto cpus = original::thread::availableCpus();
+    const original::u_integer workers = cpus.size() > 1 ? cpus.size() / 2 : 1;
+    std::cout << cpus.size() << " CPUs available, " << ROUNDS << " rounds of "
+              << BLOCK / 1024 << " KiB sweeps" << std::endl;
+    std::cout << std::setw(10) << "pinning" << std::setw(9) << "workers" << std::setw(14) << "ns/sweep"
+              << std::setw(14) << "checksum" << std::endl;
+    run("unpinned", workers, original::taskDelegator::UNPINNED);
+    run("compact", workers, original::taskDelegator::COMPACT);
+    run("scatter", workers, original::taskDelegator::SCATTER);
+    return 0;
+}
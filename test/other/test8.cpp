@@ -0,0 +1,96 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include "concurrentMaps.h"
+#include "maps.h"
+#include "mutex.h"
+#include "thread.h"
+#include "zeit.h"
+
+// Throughput of a shared lookup table under mixed read/write load:
+// one hashMap behind a single pMutex versus a lock-striped concurrentHashMap.
+
+namespace {
+    constexpr int KEY_RANGE = 1 << 14;
+    constexpr int TOTAL_OPS = 1 << 18;
+
+    struct lockedHashMap {
+        original::hashMap<int, int> map;
+        mutable original::pMutex mutex;
+
+        bool containsKey(const int k) const {
+            original::uniqueLock lock{mutex};
+            return map.containsKey(k);
+        }
+
+        void write(const int k, const int v) {
+            original::uniqueLock lock{mutex};
+            if (!map.update(k, v))
+                map.add(k, v);
+        }
+    };
+
+    struct stripedHashMap {
+        original::concurrentHashMap<int, int> map{64};
+
+        bool containsKey(const int k) const {
+            return map.containsKey(k);
+        }
+
+        void write(const int k, const int v) {
+            if (!map.update(k, v))
+                map.add(k, v);
+        }
+    };
+
+    template<typename MAP>
+    double run(MAP& m, const int thread_cnt, const int read_percent) {
+        const int per_thread = TOTAL_OPS / thread_cnt;
+        const auto start = original::time::point::now();
+        {
+            std::vector<original::thread> threads;
+            for (int t = 0; t < thread_cnt; ++t) {
+                threads.emplace_back([&m, t, per_thread, read_percent] {
+                    original::u_integer seed = 2166136261u ^ static_cast<original::u_integer>(t);
+                    int hits = 0;
+                    for (int i = 0; i < per_thread; ++i) {
+                        seed = seed * 1664525u + 1013904223u;
+                        const int key = static_cast<int>(seed >> 8) % KEY_RANGE;
+                        if (static_cast<int>(seed % 100) < read_percent) {
+                            hits += m.containsKey(key);
+                        } else {
+                            m.write(key, i);
+                        }
+                    }
+                    if (hits < 0)
+                        std::cout << hits;
+                });
+            }
+        }
+        const auto elapsed = original::time::point::now() - start;
+        return static_cast<double>(per_thread) * thread_cnt / elapsed.value(original::time::MICROSECOND);
+    }
+}
+
+int main() {
+    std::cout << "Mops/s, " << TOTAL_OPS << " ops over " << KEY_RANGE << " keys" << std::endl;
+    std::cout << std::setw(8) << "mix" << std::setw(9) << "threads"
+              << std::setw(16) << "hashMap+pMutex" << std::setw(20) << "concurrentHashMap" << std::endl;
+    for (const int read_percent : {90, 50}) {
+        for (int thread_cnt = 1; thread_cnt <= 64; thread_cnt *= 2) {
+            lockedHashMap locked;
+            stripedHashMap striped;
+            for (int k = 0; k < KEY_RANGE; k += 2) {
+                locked.write(k, k);
+                striped.write(k, k);
+            }
+            const double locked_mops = run(locked, thread_cnt, read_percent);
+            const double striped_mops = run(striped, thread_cnt, read_percent);
+            std::cout << std::setw(5) << read_percent << "/" << std::setw(2) << 100 - read_percent
+                      << std::setw(9) << thread_cnt
+                      << std::setw(16) << std::fixed << std::setprecision(2) << locked_mops
+                      << std::setw(20) << striped_mops << std::endl;
+        }
+    }
+    return 0;
+}
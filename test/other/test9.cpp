@@ -0,0 +1,58 @@
+#include <iostream>
+#include <iomanip>
+#include "maps.h"
+#include "vector.h"
+#include "zeit.h"
+
+// Warm-up cost of a hashMap: add() one pair at a time versus a reserved map
+// and bulkInsert, sequential and hash partitioned over several threads.
+
+namespace {
+    constexpr int PAIRS = 1 << 20;
+
+    template<typename Build>
+    double measure(const char* name, Build build) {
+        const auto start = original::time::point::now();
+        const original::u_integer size = build();
+        const auto elapsed = original::time::point::now() - start;
+        const double ms = elapsed.value(original::time::MICROSECOND) / 1000.0;
+        std::cout << std::setw(24) << name << std::setw(12) << std::fixed << std::setprecision(2)
+                  << ms << std::setw(10) << size << std::endl;
+        return ms;
+    }
+}
+
+int main() {
+    original::vector<original::couple<int, int>> source;
+    original::u_integer seed = 2166136261u;
+    for (int i = 0; i < PAIRS; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        source.pushEnd({static_cast<int>(seed >> 1), i});
+    }
+
+    std::cout << PAIRS << " pairs" << std::endl;
+    std::cout << std::setw(24) << "build" << std::setw(12) << "ms" << std::setw(10) << "size" << std::endl;
+    measure("add", [&] {
+        original::hashMap<int, int> m;
+        for (const auto& e : source) {
+            m.add(e.first(), e.second());
+        }
+        return m.size();
+    });
+    measure("reserve + add", [&] {
+        original::hashMap<int, int> m(PAIRS);
+        for (const auto& e : source) {
+            m.add(e.first(), e.second());
+        }
+        return m.size();
+    });
+    for (const original::u_integer threads : {1u, 2u, 4u, 8u}) {
+        const std::string name = "bulkInsert x" + std::to_string(threads);
+        measure(name.c_str(), [&] {
+            original::hashMap<int, int> m;
+            m.bulkInsert(source, threads);
+            return m.size();
+        });
+    }
+    return 0;
+}
@@ -3,6 +3,8 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <map>
+#include <random>
 
 using namespace original;
 
@@ -317,4 +319,37 @@ it2->next();
 // Check distance
 integer distance = *it2 - *it1;
 EXPECT_EQ(distance, 3);
-}
\ No newline at end of file
+}
+// Randomized adds and removes, checked against std::map, including a copy of the churned list
+TEST_F(JMapTest, RandomAddRemoveMatchesStdMap) {
+std::mt19937 gen(20240611);
+std::uniform_int_distribution<int> key_dist(0, 4095);
+std::map<int, int> expected;
+for (int i = 0; i < 40000; ++i) {
+const int key = key_dist(gen);
+if (gen() % 3 == 0) {
+EXPECT_EQ(intMap->remove(key), expected.erase(key) == 1);
+} else {
+EXPECT_EQ(intMap->add(key, i), expected.emplace(key, i).second);
+}
+}
+ASSERT_EQ(intMap->size(), expected.size());
+
+JMap<int, int> copy = *intMap;
+for (const auto* m : {intMap, &copy}) {
+auto it = ownerPtr(m->begins());
+for (const auto& [key, value] : expected) {
+ASSERT_TRUE(it->isValid());
+EXPECT_EQ(it->get().first(), key);
+EXPECT_EQ(it->get().second(), value);
+it->next();
+}
+EXPECT_FALSE(it->isValid());
+}
+
+for (const auto& [key, value] : expected) {
+EXPECT_TRUE(copy.remove(key));
+}
+EXPECT_EQ(copy.size(), 0);
+EXPECT_EQ(intMap->size(), expected.size());
+}
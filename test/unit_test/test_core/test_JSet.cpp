@@ -3,6 +3,9 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
 
 using namespace original;
 
@@ -158,3 +161,55 @@ TEST(JSetCustomCompareTest, CustomCompare) {
 
     EXPECT_EQ(result, std::vector<int>({3, 2, 1}));
 }
+
+TEST(JSetAlgebraTest, LinearMergeMatchesStdSetAlgorithms) {
+    std::mt19937 gen(23);
+    for (int round = 0; round < 40; ++round) {
+        const int range = 1 + static_cast<int>(gen() % 3000);
+        JSet<int> a, b;
+        std::set<int> ea, eb;
+        for (int i = 0; i < static_cast<int>(gen() % 2000); ++i) {
+            const int e = static_cast<int>(gen() % range);
+            a.add(e);
+            ea.insert(e);
+        }
+        for (int i = 0; i < static_cast<int>(gen() % 2000); ++i) {
+            const int e = static_cast<int>(gen() % range);
+            b.add(e);
+            eb.insert(e);
+        }
+        std::vector<int> u, n, d;
+        std::set_union(ea.begin(), ea.end(), eb.begin(), eb.end(), std::back_inserter(u));
+        std::set_intersection(ea.begin(), ea.end(), eb.begin(), eb.end(), std::back_inserter(n));
+        std::set_difference(ea.begin(), ea.end(), eb.begin(), eb.end(), std::back_inserter(d));
+
+        JSet<int> su = a, sn = a, sd = a;
+        su.unionWith(b);
+        sn.intersectWith(b);
+        sd.differenceWith(b);
+        for (const auto& [result, expected] : {std::pair{&su, &u}, std::pair{&sn, &n}, std::pair{&sd, &d}}) {
+            ASSERT_EQ(result->size(), expected->size());
+            std::vector<int> actual;
+            for (const int e : *result) {
+                actual.push_back(e);
+            }
+            ASSERT_EQ(actual, *expected);
+            for (const int e : *expected) {
+                ASSERT_TRUE(result->contains(e));
+            }
+            result->add(range);
+            result->remove(range);
+            ASSERT_EQ(result->size(), expected->size());
+        }
+    }
+
+    JSet<int> self;
+    self.add(1);
+    self.unionWith(self);
+    self.intersectWith(self);
+    EXPECT_EQ(self.size(), 1);
+    self.differenceWith(self);
+    EXPECT_EQ(self.size(), 0);
+    self.add(2);
+    EXPECT_TRUE(self.contains(2));
+}
@@ -0,0 +1,440 @@
+#include <gtest/gtest.h>
+#include "maps.h"
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <map>
+#include <random>
+
+using namespace original;
+
+class BTreeMapTest : public testing::Test {
+protected:
+    void SetUp() override {
+        // Common setup for all tests
+        intMap = new btreeMap<int, int>();
+        stringMap = new btreeMap<std::string, int>();
+    }
+
+    void TearDown() override {
+        delete intMap;
+        delete stringMap;
+    }
+
+    btreeMap<int, int>* intMap{};
+    btreeMap<std::string, int>* stringMap{};
+};
+
+// Basic Functionality Tests
+TEST_F(BTreeMapTest, InitialState) {
+    EXPECT_EQ(intMap->size(), 0);
+    EXPECT_TRUE(intMap->className() == "btreeMap");
+}
+
+TEST_F(BTreeMapTest, AddAndContains) {
+    EXPECT_TRUE(intMap->add(42, 100));
+    EXPECT_EQ(intMap->size(), 1);
+    EXPECT_TRUE(intMap->containsKey(42));
+    EXPECT_FALSE(intMap->containsKey(43));
+    EXPECT_EQ(intMap->get(42), 100);
+
+    EXPECT_TRUE(stringMap->add("test", 200));
+    EXPECT_TRUE(stringMap->containsKey("test"));
+    EXPECT_EQ(stringMap->get("test"), 200);
+}
+
+TEST_F(BTreeMapTest, AddDuplicate) {
+    EXPECT_TRUE(intMap->add(10, 1));
+    EXPECT_FALSE(intMap->add(10, 2)); // Adding duplicate key should fail
+    EXPECT_EQ(intMap->size(), 1);
+    EXPECT_EQ(intMap->get(10), 1); // Value should remain unchanged
+}
+
+TEST_F(BTreeMapTest, Remove) {
+    intMap->add(1, 10);
+    intMap->add(2, 20);
+    EXPECT_TRUE(intMap->remove(1));
+    EXPECT_EQ(intMap->size(), 1);
+    EXPECT_FALSE(intMap->containsKey(1));
+    EXPECT_TRUE(intMap->containsKey(2));
+    EXPECT_EQ(intMap->get(2), 20);
+
+    EXPECT_FALSE(intMap->remove(99)); // Remove non-existent key
+}
+
+TEST_F(BTreeMapTest, Update) {
+    intMap->add(1, 10);
+    EXPECT_TRUE(intMap->update(1, 100));
+    EXPECT_EQ(intMap->get(1), 100);
+    EXPECT_FALSE(intMap->update(2, 200)); // Update non-existent key
+}
+
+TEST_F(BTreeMapTest, OperatorAccess) {
+    (*intMap)[1] = 10;
+    (*intMap)[2] = 20;
+
+    // Const access
+    const auto& constMap = *intMap;
+    EXPECT_EQ(constMap[1], 10);
+    EXPECT_EQ(constMap[2], 20);
+
+    // Non-const access creates default if not exists
+    EXPECT_EQ((*intMap)[3], int{});
+    EXPECT_EQ(intMap->size(), 3);
+}
+
+// Iterator Tests - btreeMap should maintain order
+TEST_F(BTreeMapTest, IteratorOrder) {
+    // Insert elements out of order
+    intMap->add(3, 30);
+    intMap->add(1, 10);
+    intMap->add(2, 20);
+    intMap->add(5, 50);
+    intMap->add(4, 40);
+
+    const auto it = intMap->begins();
+    EXPECT_TRUE(it->isValid());
+
+    std::vector<int> keys;
+    std::vector<int> values;
+    while (it->isValid()) {
+        auto pair = it->get();
+        keys.push_back(pair.first());
+        values.push_back(pair.second());
+        it->next();
+    }
+    delete it;
+
+    // Verify elements are in order
+    EXPECT_EQ(keys.size(), 5);
+    EXPECT_EQ(values.size(), 5);
+    for (size_t i = 0; i < keys.size() - 1; ++i) {
+        EXPECT_LT(keys[i], keys[i + 1]) << "Elements not in order at position " << i;
+    }
+}
+
+TEST_F(BTreeMapTest, IteratorReverseOrder) {
+    intMap->add(1, 10);
+    intMap->add(2, 20);
+    intMap->add(3, 30);
+
+    const auto it = intMap->ends();
+    EXPECT_TRUE(it->isValid());
+
+    std::vector<int> keys;
+    std::vector<int> values;
+    while (it->isValid()) {
+        auto pair = it->get();
+        keys.push_back(pair.first());
+        values.push_back(pair.second());
+        it->prev();
+    }
+    delete it;
+
+    // Verify elements are in reverse order
+    EXPECT_EQ(keys.size(), 3);
+    EXPECT_EQ(values.size(), 3);
+    for (size_t i = 0; i < keys.size() - 1; ++i) {
+        EXPECT_GT(keys[i], keys[i + 1]) << "Elements not in reverse order at position " << i;
+    }
+}
+
+TEST_F(BTreeMapTest, IteratorEnd) {
+    intMap->add(1, 10);
+    const auto begin = intMap->begin();
+    const auto end = intMap->end();
+
+    EXPECT_TRUE(begin.isValid());
+    EXPECT_FALSE(end.isValid());
+}
+
+// Boundary Tests
+TEST_F(BTreeMapTest, LargeNumberOfElements) {
+    constexpr int count = 100000;
+    for (int i = 0; i < count; ++i) {
+        EXPECT_TRUE(intMap->add(i, i * 10));
+    }
+    EXPECT_EQ(intMap->size(), count);
+
+    for (int i = 0; i < count; ++i) {
+        EXPECT_TRUE(intMap->containsKey(i));
+        EXPECT_EQ(intMap->get(i), i * 10);
+    }
+
+    for (int i = 0; i < count; ++i) {
+        EXPECT_TRUE(intMap->remove(i));
+        EXPECT_FALSE(intMap->containsKey(i));
+    }
+}
+
+TEST_F(BTreeMapTest, StringKeyElements) {
+    const std::vector<std::string> testStrings = {"apple", "banana", "cherry"};
+
+    for (size_t i = 0; i < testStrings.size(); ++i) {
+        stringMap->add(testStrings[i], static_cast<int>(i));
+    }
+
+    EXPECT_EQ(stringMap->size(), 3);
+    for (size_t i = 0; i < testStrings.size(); ++i) {
+        EXPECT_TRUE(stringMap->containsKey(testStrings[i]));
+        EXPECT_EQ(stringMap->get(testStrings[i]), static_cast<int>(i));
+    }
+}
+
+// Copy and Move Tests
+TEST_F(BTreeMapTest, CopyConstructor) {
+    intMap->add(1, 10);
+    intMap->add(2, 20);
+
+    const btreeMap copy(*intMap);
+    EXPECT_EQ(copy.size(), 2);
+    EXPECT_TRUE(copy.containsKey(1));
+    EXPECT_TRUE(copy.containsKey(2));
+    EXPECT_EQ(copy.get(1), 10);
+    EXPECT_EQ(copy.get(2), 20);
+}
+
+TEST_F(BTreeMapTest, MoveConstructor) {
+    intMap->add(1, 10);
+    intMap->add(2, 20);
+
+    const btreeMap moved(std::move(*intMap));
+    EXPECT_EQ(moved.size(), 2);
+    EXPECT_TRUE(moved.containsKey(1));
+    EXPECT_TRUE(moved.containsKey(2));
+    EXPECT_EQ(moved.get(1), 10);
+    EXPECT_EQ(moved.get(2), 20);
+    EXPECT_EQ(intMap->size(), 0); // NOLINT(bugprone-use-after-move)
+}
+
+TEST_F(BTreeMapTest, CopyAssignment) {
+    intMap->add(1, 10);
+    intMap->add(2, 20);
+
+    const btreeMap<int, int> copy = *intMap;
+    EXPECT_EQ(copy.size(), 2);
+    EXPECT_TRUE(copy.containsKey(1));
+    EXPECT_TRUE(copy.containsKey(2));
+    EXPECT_EQ(copy.get(1), 10);
+    EXPECT_EQ(copy.get(2), 20);
+}
+
+TEST_F(BTreeMapTest, MoveAssignment) {
+    intMap->add(1, 10);
+    intMap->add(2, 20);
+
+    const btreeMap<int, int> moved = std::move(*intMap);
+    EXPECT_EQ(moved.size(), 2);
+    EXPECT_TRUE(moved.containsKey(1));
+    EXPECT_TRUE(moved.containsKey(2));
+    EXPECT_EQ(moved.get(1), 10);
+    EXPECT_EQ(moved.get(2), 20);
+    EXPECT_EQ(intMap->size(), 0); // NOLINT(bugprone-use-after-move)
+}
+
+// Custom Comparator Test
+TEST(BTreeMapCustomCompareTest, CustomCompareFunction) {
+    struct CustomCompare {
+        bool operator()(const int a, const int b) const {
+            return a > b; // Reverse order
+        }
+    };
+
+    btreeMap<int, int, CustomCompare> customMap;
+    customMap.add(1, 10);
+    customMap.add(2, 20);
+    customMap.add(3, 30);
+
+    const auto it = customMap.begins();
+    EXPECT_TRUE(it->isValid());
+    std::vector<int> keys;
+    while (it->isValid()) {
+        keys.push_back(it->get().first());
+        it->next();
+    }
+    delete it;
+
+    // Verify elements are in reverse order
+    EXPECT_EQ(keys.size(), 3);
+    for (size_t i = 0; i < keys.size() - 1; ++i) {
+        EXPECT_GT(keys[i], keys[i + 1]) << "Elements not in reverse order at position " << i;
+    }
+}
+
+// toString Test
+TEST_F(BTreeMapTest, ToString) {
+    intMap->add(1, 10);
+    intMap->add(2, 20);
+    const std::string str = intMap->toString(false);
+
+    // Basic checks - exact format might vary
+    EXPECT_TRUE(str.find("btreeMap") != std::string::npos);
+    EXPECT_TRUE(str.find('1') != std::string::npos);
+    EXPECT_TRUE(str.find("10") != std::string::npos);
+    EXPECT_TRUE(str.find('2') != std::string::npos);
+    EXPECT_TRUE(str.find("20") != std::string::npos);
+}
+
+// Contains with value test
+TEST_F(BTreeMapTest, ContainsKeyValuePair) {
+    intMap->add(1, 10);
+    intMap->add(2, 20);
+
+    EXPECT_TRUE(intMap->contains(couple<const int, int>(1, 10)));
+    EXPECT_FALSE(intMap->contains(couple<const int, int>(1, 20))); // Wrong value
+    EXPECT_FALSE(intMap->contains(couple<const int, int>(3, 30))); // Key doesn't exist
+}
+
+// Test predecessor and successor functionality through iterator
+TEST_F(BTreeMapTest, IteratorPredecessorSuccessor) {
+    intMap->add(1, 10);
+    intMap->add(3, 30);
+    intMap->add(5, 50);
+
+    auto it = ownerPtr(intMap->begins());
+    EXPECT_EQ(it->get().first(), 1);
+
+    it->next();
+    EXPECT_EQ(it->get().first(), 3);
+
+    it->next();
+    EXPECT_EQ(it->get().first(), 5);
+
+    it->prev();
+    EXPECT_EQ(it->get().first(), 3);
+
+    it->prev();
+    EXPECT_EQ(it->get().first(), 1);
+}
+
+// Test tree balancing by inserting elements in reverse order
+TEST_F(BTreeMapTest, ReverseOrderInsertion) {
+    constexpr int count = 1000;
+    for (int i = count; i > 0; --i) {
+        EXPECT_TRUE(intMap->add(i, i * 10));
+    }
+
+    EXPECT_EQ(intMap->size(), count);
+
+    // Verify all elements are present and in order
+    auto it = ownerPtr(intMap->begins());
+    int expected = 1;
+    while (it->isValid()) {
+        EXPECT_EQ(it->get().first(), expected);
+        EXPECT_EQ(it->get().second(), expected * 10);
+        it->next();
+        expected++;
+    }
+}
+// Small fanout forces frequent splits, borrows and merges
+TEST(BTreeMapSmallFanoutTest, RandomOperationsMatchStdMap) {
+    btreeMap<int, int, increaseComparator<int>, allocator<couple<const int, int>>, 4> map;
+    std::map<int, int> expected;
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution key_dist(0, 499);
+
+    for (int i = 0; i < 20000; ++i) {
+        const int key = key_dist(gen);
+        if (gen() % 3 == 0) {
+            EXPECT_EQ(map.remove(key), expected.erase(key) == 1);
+        } else {
+            EXPECT_EQ(map.add(key, i), expected.emplace(key, i).second);
+        }
+        ASSERT_EQ(map.size(), expected.size());
+    }
+
+    auto it = ownerPtr(map.begins());
+    for (const auto& [k, v] : expected) {
+        ASSERT_TRUE(it->isValid());
+        EXPECT_EQ(it->get().first(), k);
+        EXPECT_EQ(it->get().second(), v);
+        it->next();
+    }
+    EXPECT_FALSE(it->isValid());
+
+    auto rit = ownerPtr(map.ends());
+    for (auto e = expected.rbegin(); e != expected.rend(); ++e) {
+        ASSERT_TRUE(rit->isValid());
+        EXPECT_EQ(rit->get().first(), e->first);
+        rit->prev();
+    }
+    EXPECT_FALSE(rit->isValid());
+
+    for (const auto& [k, v] : std::map(expected)) {
+        EXPECT_TRUE(map.remove(k));
+    }
+    EXPECT_EQ(map.size(), 0);
+    EXPECT_FALSE(ownerPtr(map.begins())->isValid());
+}
+
+TEST(BTreeMapSmallFanoutTest, IteratorJumpsAcrossLeaves) {
+    btreeMap<int, int, increaseComparator<int>, allocator<couple<const int, int>>, 4> map;
+    for (int i = 0; i < 100; ++i) {
+        map.add(i, i);
+    }
+    auto it = ownerPtr(map.begins());
+    *it += 37;
+    EXPECT_EQ(it->get().first(), 37);
+    *it += 50;
+    EXPECT_EQ(it->get().first(), 87);
+    *it -= 80;
+    EXPECT_EQ(it->get().first(), 7);
+    *it -= 8;
+    EXPECT_FALSE(it->isValid());
+    EXPECT_THROW(it->get(), outOfBoundError);
+}
+
+TEST(BTreeMapSmallFanoutTest, CopyIsIndependent) {
+    btreeMap<int, std::string, increaseComparator<int>, allocator<couple<const int, std::string>>, 4> map;
+    for (int i = 0; i < 200; ++i) {
+        map.add(i, std::to_string(i));
+    }
+    auto copy = map;
+    for (int i = 0; i < 200; i += 2) {
+        map.remove(i);
+    }
+    EXPECT_EQ(map.size(), 100);
+    EXPECT_EQ(copy.size(), 200);
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_EQ(copy.get(i), std::to_string(i));
+        EXPECT_EQ(map.containsKey(i), i % 2 == 1);
+    }
+
+    int prev = -1;
+    for (const auto& [k, v] : copy) {
+        EXPECT_EQ(k, prev + 1);
+        prev = k;
+    }
+    EXPECT_EQ(prev, 199);
+}
+
+TEST_F(BTreeMapTest, ForEachInRange) {
+    for (int i = 0; i < 1000; i += 3) {
+        intMap->add(i, -i);
+    }
+    std::vector<int> keys;
+    intMap->forEachInRange(100, 130, [&](const couple<const int, int>& pair) {
+        EXPECT_EQ(pair.second(), -pair.first());
+        keys.push_back(pair.first());
+    });
+    EXPECT_EQ(keys, (std::vector{102, 105, 108, 111, 114, 117, 120, 123, 126, 129}));
+
+    int visited = 0;
+    intMap->forEachInRange(500, 500, [&](const couple<const int, int>&) { ++visited; });
+    intMap->forEachInRange(2000, 3000, [&](const couple<const int, int>&) { ++visited; });
+    EXPECT_EQ(visited, 0);
+}
+
+TEST_F(BTreeMapTest, Swap) {
+    btreeMap<int, int> other;
+    for (int i = 0; i < 100; ++i) {
+        intMap->add(i, i);
+    }
+    other.add(-1, -1);
+    std::swap(*intMap, other);
+    EXPECT_EQ(intMap->size(), 1);
+    EXPECT_EQ(intMap->get(-1), -1);
+    EXPECT_EQ(other.size(), 100);
+    EXPECT_EQ(other.get(99), 99);
+    EXPECT_EQ(intMap->toString(false), "btreeMap({-1: -1})");
+}
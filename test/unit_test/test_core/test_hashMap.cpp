@@ -261,3 +261,108 @@ TEST_F(HashMapTest, ContainsKeyValuePair) {
     EXPECT_FALSE(intMap->contains(couple<const int, int>(1, 20))); // Wrong value
     EXPECT_FALSE(intMap->contains(couple<const int, int>(3, 30))); // Key doesn't exist
 }
+
+TEST(HashMapBulkTest, CapacityConstructorAndReserve) {
+    hashMap<int, int> m(1000);
+    EXPECT_TRUE(m.empty());
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(m.add(i, i * i));
+    }
+    m.reserve(10);
+    m.reserve(5000);
+    EXPECT_EQ(m.size(), 1000);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(m.get(i), i * i);
+    }
+}
+
+TEST(HashMapBulkTest, BulkInsertKeepsFirstValue) {
+    hashMap<int, std::string> m;
+    m.add(1, "existing");
+
+    vector<couple<int, std::string>> source;
+    source.pushEnd({1, "ignored"});
+    source.pushEnd({2, "two"});
+    source.pushEnd({3, "three"});
+    source.pushEnd({2, "again"});
+
+    EXPECT_EQ(m.bulkInsert(source), 2);
+    EXPECT_EQ(m.size(), 3);
+    EXPECT_EQ(m.get(1), "existing");
+    EXPECT_EQ(m.get(2), "two");
+    EXPECT_EQ(m.get(3), "three");
+    EXPECT_EQ(m.bulkInsert(vector<couple<int, std::string>>{}), 0);
+}
+
+TEST(HashMapBulkTest, BulkInsertFromGenerator) {
+    hashMap<int, int> source;
+    for (int i = 0; i < 500; ++i) {
+        source.add(i, -i);
+    }
+
+    hashMap<int, int> m;
+    EXPECT_EQ(m.bulkInsert(source.generator()), 500);
+    for (int i = 0; i < 500; ++i) {
+        ASSERT_EQ(m.get(i), -i);
+    }
+}
+
+TEST(HashMapBulkTest, ParallelBulkInsertMatchesSequential) {
+    vector<couple<int, int>> source;
+    for (int i = 0; i < 50000; ++i) {
+        source.pushEnd({i % 40000, i});
+    }
+
+    hashMap<int, int> sequential;
+    hashMap<int, int> parallel;
+    parallel.add(7, -1);
+    sequential.add(7, -1);
+    EXPECT_EQ(sequential.bulkInsert(source), 39999);
+    EXPECT_EQ(parallel.bulkInsert(source, 4), 39999);
+    EXPECT_EQ(parallel.size(), 40000);
+    for (int i = 0; i < 40000; ++i) {
+        ASSERT_EQ(parallel.get(i), sequential.get(i));
+    }
+    EXPECT_EQ(parallel.get(7), -1);
+    EXPECT_EQ(parallel.get(39999), 39999);
+}
+
+TEST(HashMapBulkTest, BulkInsertSourceThrows) {
+    // Yields pairs until `limit`, then throws from the middle of the collection
+    struct throwingSource {
+        int limit;
+        struct iter {
+            int i;
+            int limit;
+            couple<int, int> operator*() const {
+                if (i == limit)
+                    throw valueError("source failed");
+                return {i, i};
+            }
+            iter& operator++() { ++i; return *this; }
+            bool operator!=(const iter& other) const { return i != other.i; }
+        };
+        [[nodiscard]] iter begin() const { return {0, limit}; }
+        [[nodiscard]] iter end() const { return {limit + 10, limit}; }
+    };
+
+    hashMap<int, int> m;
+    m.add(-1, -1);
+    EXPECT_THROW(m.bulkInsert(throwingSource{100}, 3), valueError);
+    // Nodes collected before the failure are freed, the map is untouched
+    EXPECT_EQ(m.size(), 1);
+    EXPECT_EQ(m.get(-1), -1);
+
+    // Uneven bucket partitions still link every pair exactly once
+    vector<couple<int, int>> source;
+    for (int i = 0; i < 10007; ++i) {
+        source.pushEnd({i, i * 2});
+    }
+    for (const u_integer threads : {2u, 3u, 7u}) {
+        hashMap<int, int> parallel;
+        EXPECT_EQ(parallel.bulkInsert(source, threads), 10007);
+        for (int i = 0; i < 10007; ++i) {
+            ASSERT_EQ(parallel.get(i), i * 2);
+        }
+    }
+}
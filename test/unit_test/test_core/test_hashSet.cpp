@@ -2,6 +2,8 @@
 #include "sets.h"
 #include <string>
 #include <vector>
+#include <random>
+#include <unordered_set>
 
 using namespace original;
 
@@ -203,3 +205,106 @@ TEST(HashSetCustomHashTest, CustomHashFunction) {
 
     EXPECT_EQ(customSet.size(), 20); // All should be added despite hash collisions
 }
+
+TEST(HashSetBulkTest, CapacityConstructorAndReserve) {
+    hashSet<int> s(1000);
+    EXPECT_TRUE(s.empty());
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(s.add(i));
+    }
+    s.reserve(4000);
+    EXPECT_EQ(s.size(), 1000);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(s.contains(i));
+    }
+}
+
+TEST(HashSetBulkTest, BulkInsertSkipsDuplicates) {
+    hashSet<std::string> s;
+    s.add("a");
+    EXPECT_EQ(s.bulkInsert(vector<std::string>{"a", "b", "c", "b"}), 2);
+    EXPECT_EQ(s.size(), 3);
+    EXPECT_TRUE(s.contains("b"));
+    EXPECT_TRUE(s.contains("c"));
+}
+
+TEST(HashSetBulkTest, ParallelBulkInsertFromGenerator) {
+    hashSet<int> source;
+    for (int i = 0; i < 30000; ++i) {
+        source.add(i * 3);
+    }
+
+    hashSet<int> s;
+    EXPECT_EQ(s.bulkInsert(source.generator(), 3), 30000);
+    for (int i = 0; i < 90000; ++i) {
+        ASSERT_EQ(s.contains(i), i % 3 == 0);
+    }
+}
+
+TEST(HashSetCustomHashTest, DuplicateAtChainTail) {
+    struct ConstantHash {
+        u_integer operator()(const int) const {
+            return 0;
+        }
+    };
+
+    hashSet<int, ConstantHash> s;
+    EXPECT_TRUE(s.add(1));
+    EXPECT_TRUE(s.add(2));
+    EXPECT_TRUE(s.add(3));
+    EXPECT_FALSE(s.add(3));
+    EXPECT_FALSE(s.add(2));
+    EXPECT_EQ(s.size(), 3);
+}
+
+TEST(HashSetAlgebraTest, MatchesStdUnorderedSet) {
+    std::mt19937 gen(29);
+    for (int round = 0; round < 20; ++round) {
+        const int range = 1 + static_cast<int>(gen() % 5000);
+        hashSet<int> a, b;
+        std::unordered_set<int> ea, eb;
+        for (int i = 0; i < 1 + static_cast<int>(gen() % 3000); ++i) {
+            const int e = static_cast<int>(gen() % range);
+            a.add(e);
+            ea.insert(e);
+        }
+        for (int i = 0; i < static_cast<int>(gen() % 3000); ++i) {
+            const int e = static_cast<int>(gen() % range);
+            b.add(e);
+            eb.insert(e);
+        }
+
+        hashSet<int> su = a, sn = a, sd = a;
+        su.unionWith(b);
+        sn.intersectWith(b);
+        sd.differenceWith(b);
+        u_integer union_cnt = 0, intersection_cnt = 0, difference_cnt = 0;
+        for (int e = 0; e < range; ++e) {
+            const bool in_a = ea.count(e) > 0;
+            const bool in_b = eb.count(e) > 0;
+            ASSERT_EQ(su.contains(e), in_a || in_b);
+            ASSERT_EQ(sn.contains(e), in_a && in_b);
+            ASSERT_EQ(sd.contains(e), in_a && !in_b);
+            union_cnt += in_a || in_b;
+            intersection_cnt += in_a && in_b;
+            difference_cnt += in_a && !in_b;
+        }
+        ASSERT_EQ(su.size(), union_cnt);
+        ASSERT_EQ(sn.size(), intersection_cnt);
+        ASSERT_EQ(sd.size(), difference_cnt);
+        u_integer visited = 0;
+        for (const int e : su) {
+            ASSERT_TRUE(ea.count(e) || eb.count(e));
+            visited += 1;
+        }
+        ASSERT_EQ(visited, union_cnt);
+    }
+
+    hashSet<int> self;
+    self.add(1);
+    self.unionWith(self);
+    self.intersectWith(self);
+    EXPECT_EQ(self.size(), 1);
+    self.differenceWith(self);
+    EXPECT_EQ(self.size(), 0);
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include "indexedHeap.h"
+#include <queue>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace original;
+
+namespace {
+    template<u_integer ARITY>
+    void randomOperationsMatchOrderedSet() {
+        // Each value is a (priority, id) pair so that equal priorities still have a strict order
+        indexedHeap<std::pair<int, int>, increaseComparator, ARITY> heap;
+        std::set<std::pair<int, int>> expected;
+        std::vector<typename decltype(heap)::handle> handles;
+        std::vector<std::pair<int, int>> values;
+        std::mt19937 gen(36 + ARITY);
+
+        for (int i = 0; i < 20000; ++i) {
+            const auto dice = gen() % 10;
+            if (dice < 4 || handles.empty()) {
+                const std::pair value{static_cast<int>(gen() % 1000), i};
+                handles.push_back(heap.push(value));
+                values.push_back(value);
+                expected.insert(value);
+            } else if (dice < 6) {
+                const auto top = heap.pop();
+                ASSERT_EQ(top, *expected.begin());
+                expected.erase(expected.begin());
+                for (std::size_t j = 0; j < values.size(); ++j) {
+                    if (values[j] == top) {
+                        handles.erase(handles.begin() + static_cast<std::ptrdiff_t>(j));
+                        values.erase(values.begin() + static_cast<std::ptrdiff_t>(j));
+                        break;
+                    }
+                }
+            } else {
+                const std::size_t j = gen() % handles.size();
+                ASSERT_TRUE(heap.containsHandle(handles[j]));
+                ASSERT_EQ(heap.get(handles[j]), values[j]);
+                expected.erase(values[j]);
+                std::pair value{static_cast<int>(gen() % 1000), values[j].second};
+                if (dice == 6) {
+                    value.first = std::min(value.first, values[j].first);
+                    heap.decreaseKey(handles[j], value);
+                } else if (dice == 7) {
+                    value.first = std::max(value.first, values[j].first);
+                    heap.increaseKey(handles[j], value);
+                } else if (dice == 8) {
+                    heap.update(handles[j], value);
+                } else {
+                    ASSERT_EQ(heap.erase(handles[j]), values[j]);
+                    ASSERT_FALSE(heap.containsHandle(handles[j]));
+                    handles.erase(handles.begin() + static_cast<std::ptrdiff_t>(j));
+                    values.erase(values.begin() + static_cast<std::ptrdiff_t>(j));
+                    continue;
+                }
+                values[j] = value;
+                expected.insert(value);
+            }
+            ASSERT_EQ(heap.size(), expected.size());
+            if (!expected.empty()) {
+                ASSERT_EQ(heap.top(), *expected.begin());
+            }
+        }
+    }
+}
+
+TEST(IndexedHeapTest, PopsInPriorityOrderLikePrique) {
+    indexedHeap<int> minHeap;
+    indexedHeap<int, decreaseComparator> maxHeap;
+    std::priority_queue<int, std::vector<int>, std::greater<>> expectedMin;
+    std::priority_queue<int> expectedMax;
+    for (const int value : {40, 20, 10, 30, 50, 70, 60, 100, 110, 50, 20, 90, 80, 80, 40}) {
+        minHeap.push(value);
+        maxHeap.push(value);
+        expectedMin.push(value);
+        expectedMax.push(value);
+    }
+    while (!expectedMin.empty()) {
+        EXPECT_EQ(minHeap.top(), expectedMin.top());
+        EXPECT_EQ(minHeap.pop(), expectedMin.top());
+        EXPECT_EQ(maxHeap.pop(), expectedMax.top());
+        expectedMin.pop();
+        expectedMax.pop();
+    }
+    EXPECT_TRUE(minHeap.empty());
+    EXPECT_THROW(minHeap.pop(), noElementError);
+    EXPECT_THROW(minHeap.top(), noElementError);
+}
+
+TEST(IndexedHeapTest, HandlesFollowTheirElements) {
+    indexedHeap<std::string> heap;
+    const auto c = heap.push("c");
+    const auto a = heap.push("a");
+    const auto e = heap.push("e");
+    EXPECT_EQ(heap.topHandle(), a);
+    EXPECT_EQ(heap.get(c), "c");
+
+    heap.decreaseKey(e, "0");
+    EXPECT_EQ(heap.topHandle(), e);
+    EXPECT_EQ(heap.top(), "0");
+    heap.increaseKey(e, "z");
+    EXPECT_EQ(heap.topHandle(), a);
+    EXPECT_THROW(heap.decreaseKey(c, "d"), valueError);
+    EXPECT_THROW(heap.increaseKey(c, "b"), valueError);
+    EXPECT_EQ(heap.get(c), "c");
+
+    EXPECT_EQ(heap.erase(a), "a");
+    EXPECT_FALSE(heap.containsHandle(a));
+    EXPECT_THROW(heap.get(a), noElementError);
+    EXPECT_THROW(heap.erase(a), noElementError);
+    EXPECT_TRUE(heap.contains("z"));
+    EXPECT_FALSE(heap.contains("a"));
+    EXPECT_EQ(heap.pop(), "c");
+    EXPECT_EQ(heap.pop(), "z");
+    EXPECT_FALSE(heap.containsHandle(e));
+}
+
+TEST(IndexedHeapTest, RandomOperationsBinary) {
+    randomOperationsMatchOrderedSet<2>();
+}
+
+TEST(IndexedHeapTest, RandomOperationsQuaternary) {
+    randomOperationsMatchOrderedSet<4>();
+}
+
+TEST(IndexedHeapTest, RandomOperationsOctonary) {
+    randomOperationsMatchOrderedSet<8>();
+}
+
+TEST(IndexedHeapTest, CopyMoveAndSwapKeepHandles) {
+    indexedHeap<int> heap;
+    std::vector<indexedHeap<int>::handle> handles;
+    for (int i = 0; i < 100; ++i) {
+        handles.push_back(heap.push((i * 37) % 100));
+    }
+    heap.erase(handles[10]);
+
+    indexedHeap<int> copy = heap;
+    copy.update(handles[20], -1);
+    EXPECT_EQ(copy.top(), -1);
+    EXPECT_EQ(heap.top(), 0);
+    EXPECT_EQ(heap.get(handles[20]), (20 * 37) % 100);
+    EXPECT_FALSE(copy.containsHandle(handles[10]));
+    EXPECT_EQ(copy.get(handles[30]), (30 * 37) % 100);
+
+    indexedHeap<int> moved = std::move(copy);
+    EXPECT_EQ(moved.size(), 99);
+    EXPECT_TRUE(copy.empty());
+    moved.swap(heap);
+    EXPECT_EQ(heap.top(), -1);
+    EXPECT_EQ(moved.top(), 0);
+
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+    EXPECT_FALSE(moved.containsHandle(handles[0]));
+    EXPECT_EQ(moved.push(5), 0);
+    EXPECT_EQ(moved.toString(false), "indexedHeap(5)");
+}
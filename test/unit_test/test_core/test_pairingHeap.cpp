@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include "pairingHeap.h"
+#include <queue>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace original;
+
+namespace {
+    template<template <typename> typename ALLOC>
+    void randomOperationsMatchOrderedSet() {
+        // (priority, id) pairs keep the order strict when priorities repeat
+        using value = std::pair<int, int>;
+        using heapType = pairingHeap<value, increaseComparator, ALLOC>;
+        heapType heap;
+        std::set<value> expected;
+        std::vector<typename heapType::handle> handles;
+        std::vector<value> values;
+        std::mt19937 gen(37);
+
+        const auto forget = [&](const value& v) {
+            for (std::size_t j = 0; j < values.size(); ++j) {
+                if (values[j] == v) {
+                    handles.erase(handles.begin() + static_cast<std::ptrdiff_t>(j));
+                    values.erase(values.begin() + static_cast<std::ptrdiff_t>(j));
+                    return;
+                }
+            }
+        };
+
+        int id = 0;
+        for (int i = 0; i < 20000; ++i) {
+            const auto dice = gen() % 10;
+            if (dice < 4 || handles.empty()) {
+                const value v{static_cast<int>(gen() % 1000), id++};
+                handles.push_back(heap.push(v));
+                values.push_back(v);
+                expected.insert(v);
+            } else if (dice < 6) {
+                const auto top = heap.pop();
+                ASSERT_EQ(top, *expected.begin());
+                expected.erase(expected.begin());
+                forget(top);
+            } else if (dice < 8) {
+                const std::size_t j = gen() % handles.size();
+                ASSERT_EQ(heap.get(handles[j]), values[j]);
+                const value v{std::min(static_cast<int>(gen() % 1000), values[j].first), values[j].second};
+                heap.decreaseKey(handles[j], v);
+                expected.erase(values[j]);
+                expected.insert(v);
+                values[j] = v;
+            } else if (dice == 8) {
+                const std::size_t j = gen() % handles.size();
+                const value v = values[j];
+                ASSERT_EQ(heap.erase(handles[j]), v);
+                expected.erase(v);
+                forget(v);
+            } else {
+                // Merge in a small shard; its handles keep working in heap
+                heapType shard;
+                for (int k = 0; k < 8; ++k) {
+                    const value v{static_cast<int>(gen() % 1000), id++};
+                    handles.push_back(shard.push(v));
+                    values.push_back(v);
+                    expected.insert(v);
+                }
+                heap.merge(shard);
+                ASSERT_TRUE(shard.empty());
+            }
+            ASSERT_EQ(heap.size(), expected.size());
+            if (!expected.empty()) {
+                ASSERT_EQ(heap.top(), *expected.begin());
+            }
+        }
+        while (!expected.empty()) {
+            ASSERT_EQ(heap.pop(), *expected.begin());
+            expected.erase(expected.begin());
+        }
+        EXPECT_TRUE(heap.empty());
+    }
+}
+
+TEST(PairingHeapTest, PopsInPriorityOrderLikePrique) {
+    pairingHeap<int> minHeap;
+    pairingHeap<int, decreaseComparator> maxHeap;
+    std::priority_queue<int, std::vector<int>, std::greater<>> expectedMin;
+    std::priority_queue<int> expectedMax;
+    for (const int value : {40, 20, 10, 30, 50, 70, 60, 100, 110, 50, 20, 90, 80, 80, 40}) {
+        minHeap.push(value);
+        maxHeap.push(value);
+        expectedMin.push(value);
+        expectedMax.push(value);
+    }
+    EXPECT_TRUE(minHeap.contains(110));
+    EXPECT_FALSE(minHeap.contains(111));
+    while (!expectedMin.empty()) {
+        EXPECT_EQ(minHeap.top(), expectedMin.top());
+        EXPECT_EQ(minHeap.pop(), expectedMin.top());
+        EXPECT_EQ(maxHeap.pop(), expectedMax.top());
+        expectedMin.pop();
+        expectedMax.pop();
+    }
+    EXPECT_THROW(minHeap.pop(), noElementError);
+    EXPECT_THROW(minHeap.top(), noElementError);
+}
+
+TEST(PairingHeapTest, DecreaseKeyEraseAndMerge) {
+    pairingHeap<std::string> left;
+    pairingHeap<std::string> right;
+    const auto m = left.push("m");
+    left.push("k");
+    const auto z = right.push("z");
+    const auto q = right.push("q");
+
+    EXPECT_THROW(left.decreaseKey(m, "n"), valueError);
+    EXPECT_THROW(left.get(pairingHeap<std::string>::handle{}), noElementError);
+
+    left.merge(right);
+    EXPECT_TRUE(right.empty());
+    EXPECT_EQ(left.size(), 4);
+    left.decreaseKey(z, "a");
+    EXPECT_EQ(left.top(), "a");
+    EXPECT_EQ(left.erase(q), "q");
+    EXPECT_EQ(left.erase(z), "a");
+    EXPECT_EQ(left.get(m), "m");
+    EXPECT_EQ(left.pop(), "k");
+    EXPECT_EQ(left.pop(), "m");
+    EXPECT_TRUE(left.empty());
+
+    left.merge(right);
+    EXPECT_TRUE(left.empty());
+    right.push("r");
+    left.merge(right);
+    EXPECT_EQ(left.toString(false), "pairingHeap(\"r\")");
+}
+
+TEST(PairingHeapTest, RandomOperationsWithObjectPool) {
+    randomOperationsMatchOrderedSet<objPoolAllocator>();
+}
+
+TEST(PairingHeapTest, RandomOperationsWithAllocator) {
+    randomOperationsMatchOrderedSet<allocator>();
+}
+
+TEST(PairingHeapTest, CopyMoveSwapAndDeepTrees) {
+    pairingHeap<int> heap;
+    // Pushing in increasing order builds a root with 100000 children for the first pop to pair
+    for (int i = 0; i < 100000; ++i) {
+        heap.push(i);
+    }
+    EXPECT_EQ(heap.pop(), 0);
+
+    pairingHeap<int> copy = heap;
+    EXPECT_EQ(copy.size(), heap.size());
+    EXPECT_EQ(copy.pop(), 1);
+    EXPECT_EQ(heap.top(), 1);
+
+    pairingHeap<int> moved = std::move(copy);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved.top(), 2);
+    moved.swap(heap);
+    EXPECT_EQ(heap.top(), 2);
+    EXPECT_EQ(moved.top(), 1);
+
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+    for (int i = 2; i < 100000; ++i) {
+        ASSERT_EQ(heap.pop(), i);
+    }
+
+    // Pushing in decreasing order builds a path as deep as the heap is large
+    for (int i = 100000; i > 0; --i) {
+        heap.push(i);
+    }
+    EXPECT_TRUE(heap.contains(100000));
+    const pairingHeap<int> deepCopy = heap;
+    EXPECT_EQ(deepCopy.size(), 100000);
+}
@@ -0,0 +1,311 @@
+#include <gtest/gtest.h>
+#include "maps.h"
+#include <map>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace original;
+
+namespace {
+    template<typename K, typename V>
+    std::map<K, V> contentsOf(const persistentTreeMap<K, V>& map) {
+        std::map<K, V> result;
+        K last{};
+        bool first = true;
+        map.forEach([&](const couple<const K, V>& pair) {
+            EXPECT_TRUE(first || last < pair.first());
+            last = pair.first();
+            first = false;
+            result.emplace(pair.first(), pair.second());
+        });
+        return result;
+    }
+
+    int copies_left = -1;
+
+    // Copying throws once copies_left counts down to zero, never while it is negative
+    struct fragile {
+        int value = 0;
+
+        fragile() = default;
+
+        explicit fragile(const int v) : value(v) {}
+
+        fragile(const fragile& other) : value(other.value) {
+            if (copies_left == 0) {
+                throw std::runtime_error("copy failed");
+            }
+            if (copies_left > 0) {
+                copies_left -= 1;
+            }
+        }
+
+        fragile& operator=(const fragile& other) = default;
+
+        bool operator==(const fragile& other) const = default;
+    };
+
+    std::map<int, int> valuesOf(const persistentTreeMap<int, fragile>& map) {
+        std::map<int, int> result;
+        map.forEach([&](const couple<const int, fragile>& pair) {
+            result.emplace(pair.first(), pair.second().value);
+        });
+        return result;
+    }
+}
+
+class PersistentTreeMapTest : public testing::Test {
+protected:
+    persistentTreeMap<int, int> intMap;
+    persistentTreeMap<std::string, int> stringMap;
+};
+
+TEST_F(PersistentTreeMapTest, InitialState) {
+    EXPECT_EQ(intMap.size(), 0);
+    EXPECT_FALSE(intMap.containsKey(1));
+    EXPECT_THROW(intMap.get(1), noElementError);
+}
+
+TEST_F(PersistentTreeMapTest, AddRemoveUpdate) {
+    EXPECT_TRUE(intMap.add(1, 10));
+    EXPECT_TRUE(intMap.add(2, 20));
+    EXPECT_FALSE(intMap.add(1, 100));
+    EXPECT_EQ(intMap.size(), 2);
+    EXPECT_EQ(intMap.get(1), 10);
+    EXPECT_TRUE(intMap.contains({2, 20}));
+    EXPECT_FALSE(intMap.contains({2, 21}));
+
+    EXPECT_TRUE(intMap.update(2, 21));
+    EXPECT_FALSE(intMap.update(3, 30));
+    EXPECT_EQ(intMap.get(2), 21);
+
+    EXPECT_TRUE(intMap.remove(1));
+    EXPECT_FALSE(intMap.remove(1));
+    EXPECT_EQ(intMap.size(), 1);
+    EXPECT_FALSE(intMap.containsKey(1));
+}
+
+TEST_F(PersistentTreeMapTest, OperatorAccess) {
+    stringMap["one"] = 1;
+    stringMap["two"] = 2;
+    stringMap["one"] += 10;
+    EXPECT_EQ(stringMap.size(), 2);
+    EXPECT_EQ(stringMap["one"], 11);
+
+    const auto& constMap = stringMap;
+    EXPECT_EQ(constMap["two"], 2);
+    EXPECT_THROW(constMap["three"], noElementError);
+}
+
+TEST_F(PersistentTreeMapTest, ForEachInRangeAndToString) {
+    for (int i = 0; i < 100; ++i) {
+        intMap.add(i * 2, i);
+    }
+    std::vector<int> keys;
+    intMap.forEachInRange(11, 21, [&](const couple<const int, int>& pair) {
+        keys.push_back(pair.first());
+    });
+    EXPECT_EQ(keys, (std::vector<int>{12, 14, 16, 18, 20}));
+
+    persistentTreeMap<int, int> small;
+    small.add(2, 20);
+    small.add(1, 10);
+    EXPECT_EQ(small.toString(false), "persistentTreeMap({1: 10}, {2: 20})");
+}
+
+TEST_F(PersistentTreeMapTest, SnapshotsKeepTheirContentsUnderRandomWrites) {
+    std::mt19937 gen(35);
+    std::map<int, int> expected;
+    std::vector<persistentTreeMap<int, int>> snapshots;
+    std::vector<std::map<int, int>> expectedSnapshots;
+
+    for (int round = 0; round < 40; ++round) {
+        for (int i = 0; i < 200; ++i) {
+            const int key = static_cast<int>(gen() % 500);
+            switch (gen() % 4) {
+                case 0:
+                    EXPECT_EQ(intMap.remove(key), expected.erase(key) == 1);
+                    break;
+                case 1:
+                    EXPECT_EQ(intMap.update(key, round), expected.contains(key));
+                    if (expected.contains(key)) {
+                        expected[key] = round;
+                    }
+                    break;
+                case 2:
+                    intMap[key] = -round;
+                    expected[key] = -round;
+                    break;
+                default:
+                    EXPECT_EQ(intMap.add(key, key), expected.emplace(key, key).second);
+            }
+        }
+        ASSERT_EQ(intMap.size(), expected.size());
+        snapshots.push_back(intMap.snapshot());
+        expectedSnapshots.push_back(expected);
+    }
+
+    EXPECT_EQ(contentsOf(intMap), expected);
+    for (std::size_t i = 0; i < snapshots.size(); ++i) {
+        EXPECT_EQ(snapshots[i].size(), expectedSnapshots[i].size());
+        EXPECT_EQ(contentsOf(snapshots[i]), expectedSnapshots[i]);
+    }
+}
+
+TEST_F(PersistentTreeMapTest, SnapshotsAreIndependentMaps) {
+    for (int i = 0; i < 64; ++i) {
+        intMap.add(i, i);
+    }
+    auto snap = intMap.snapshot();
+    persistentTreeMap<int, int> copy = intMap;
+
+    snap.remove(0);
+    snap[1] = 100;
+    copy.add(64, 64);
+    intMap.update(2, 200);
+
+    EXPECT_EQ(intMap.size(), 64);
+    EXPECT_EQ(intMap.get(0), 0);
+    EXPECT_EQ(intMap.get(1), 1);
+    EXPECT_EQ(intMap.get(2), 200);
+    EXPECT_FALSE(intMap.containsKey(64));
+
+    EXPECT_EQ(snap.size(), 63);
+    EXPECT_FALSE(snap.containsKey(0));
+    EXPECT_EQ(snap.get(1), 100);
+    EXPECT_EQ(snap.get(2), 2);
+
+    EXPECT_EQ(copy.size(), 65);
+    EXPECT_EQ(copy.get(1), 1);
+    EXPECT_EQ(copy.get(2), 2);
+
+    persistentTreeMap<int, int> moved = std::move(copy);
+    EXPECT_EQ(moved.size(), 65);
+    EXPECT_EQ(copy.size(), 0);
+    std::swap(moved, snap);
+    EXPECT_EQ(moved.size(), 63);
+    EXPECT_EQ(snap.size(), 65);
+}
+
+TEST_F(PersistentTreeMapTest, SnapshotOutlivesSource) {
+    persistentTreeMap<std::string, int> snap;
+    {
+        persistentTreeMap<std::string, int> source;
+        for (int i = 0; i < 100; ++i) {
+            source.add(std::to_string(i), i);
+        }
+        snap = source.snapshot();
+        source.remove("50");
+    }
+    EXPECT_EQ(snap.size(), 100);
+    EXPECT_EQ(snap.get("50"), 50);
+}
+
+TEST_F(PersistentTreeMapTest, FailedCopiesLeaveMapsConsistent) {
+    persistentTreeMap<int, fragile> base;
+    std::map<int, int> expected;
+    for (int i = 0; i < 200; ++i) {
+        base.add(i * 2, fragile{i});
+        expected.emplace(i * 2, i);
+    }
+
+    // Fail every copy in turn, on a fully shared map and on one that owns the path to the key,
+    // where a rotation can fail after nodes were changed in place
+    for (const bool partly_owned : {false, true}) {
+        for (int key = 0; key < 400; key += 7) {
+            bool finished = false;
+            for (int fail_at = 0; !finished; ++fail_at) {
+                persistentTreeMap<int, fragile> map = base.snapshot();
+                std::map<int, int> contents = expected;
+                if (partly_owned) {
+                    const int owned = key - key % 2;
+                    map.update(owned, fragile{-owned});
+                    contents[owned] = -owned;
+                }
+
+                copies_left = fail_at;
+                try {
+                    if (key % 2 == 0) {
+                        map.remove(key);
+                    } else {
+                        map.add(key, fragile{key});
+                    }
+                    finished = true;
+                } catch (const std::runtime_error&) {}
+                copies_left = -1;
+
+                // A failed add changes nothing, a failed remove may already have taken the key out
+                const auto actual = valuesOf(map);
+                if (finished || (key % 2 == 0 && !actual.contains(key))) {
+                    if (key % 2 == 0) {
+                        contents.erase(key);
+                    } else {
+                        contents.emplace(key, key);
+                    }
+                }
+                ASSERT_EQ(actual, contents) << "key " << key << ", copy " << fail_at;
+                ASSERT_EQ(map.size(), contents.size());
+                ASSERT_EQ(valuesOf(base), expected);
+
+                map.add(1001, fragile{1001});
+                map.remove(100);
+                EXPECT_TRUE(map.containsKey(1001));
+                EXPECT_FALSE(map.containsKey(100));
+            }
+        }
+    }
+}
+
+TEST(PersistentTreeMapConcurrencyTest, ReadersSeeConsistentSnapshots) {
+    constexpr int WINDOW = 256;
+    constexpr int VERSIONS = 4000;
+
+    // Version v holds exactly the keys [v - WINDOW, v) with value == key
+    persistentTreeMap<int, int> map;
+    persistentTreeMap<int, int> published;
+    std::mutex publish;
+    std::atomic done{false};
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                persistentTreeMap<int, int> view;
+                {
+                    std::lock_guard lock{publish};
+                    view = published;
+                }
+                std::map<int, int> contents = contentsOf(view);
+                ASSERT_EQ(contents.size(), view.size());
+                if (contents.empty()) {
+                    continue;
+                }
+                int expectedKey = contents.begin()->first;
+                for (const auto& [k, v] : contents) {
+                    ASSERT_EQ(k, expectedKey++);
+                    ASSERT_EQ(v, k);
+                }
+                ASSERT_TRUE(contents.size() == WINDOW || contents.begin()->first == 0);
+            }
+        });
+    }
+
+    for (int v = 1; v <= VERSIONS; ++v) {
+        map.add(v - 1, v - 1);
+        if (v > WINDOW) {
+            map.remove(v - 1 - WINDOW);
+        }
+        auto snap = map.snapshot();
+        std::lock_guard lock{publish};
+        published = snap;
+    }
+    done.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(map.size(), WINDOW);
+}
@@ -3,6 +3,8 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <map>
+#include <random>
 
 using namespace original;
 
@@ -323,4 +325,224 @@ TEST_F(TreeMapTest, ReverseOrderInsertion) {
         it->next();
         expected++;
     }
-}
\ No newline at end of file
+}
+TEST(TreeMapBulkTest, FromSortedBuildsOrderedMap) {
+    vector<couple<int, int>> pairs;
+    for (int i = 0; i < 1000; ++i) {
+        pairs.pushEnd({i * 2, i});
+    }
+    auto map = treeMap<int, int>::fromSorted(pairs);
+    EXPECT_EQ(map.size(), 1000);
+    int expected = 0;
+    for (const auto& [k, v] : map) {
+        EXPECT_EQ(k, expected * 2);
+        EXPECT_EQ(v, expected);
+        ++expected;
+    }
+    EXPECT_EQ(expected, 1000);
+
+    // The balanced tree must stay valid under regular modifications
+    for (int i = 0; i < 2000; i += 3) {
+        map.remove(i);
+        map.add(i + 1, -i);
+    }
+    auto it = ownerPtr(map.begins());
+    int prev = -1;
+    while (it->isValid()) {
+        EXPECT_GT(it->get().first(), prev);
+        prev = it->get().first();
+        it->next();
+    }
+}
+
+TEST(TreeMapBulkTest, FromSortedSkipsRepeatedKeysAndRejectsUnsorted) {
+    const vector<couple<int, std::string>> repeated = {{1, "a"}, {1, "b"}, {2, "c"}, {3, "d"}, {3, "e"}};
+    const auto map = treeMap<int, std::string>::fromSorted(repeated);
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(map.get(1), "a");
+    EXPECT_EQ(map.get(3), "d");
+
+    const vector<couple<int, int>> unsorted = {{1, 1}, {3, 3}, {2, 2}};
+    EXPECT_THROW((treeMap<int, int>::fromSorted(unsorted)), valueError);
+
+    struct Descending {
+        bool operator()(const int a, const int b) const { return a > b; }
+    };
+    const vector<couple<int, int>> descending = {{3, 3}, {2, 2}, {1, 1}};
+    auto reversed = treeMap<int, int, Descending>::fromSorted(descending);
+    EXPECT_EQ(reversed.toString(false), "treeMap({3: 3}, {2: 2}, {1: 1})");
+}
+
+TEST(TreeMapBulkTest, BulkLoadMergesIntoExistingMap) {
+    for (const int batch : {3, 500}) {
+        treeMap<int, int> map;
+        for (int i = 0; i < 600; i += 2) {
+            map.add(i, i);
+        }
+        auto first = ownerPtr(map.begins());
+
+        vector<couple<int, int>> sorted;
+        for (int i = 0; i < batch; ++i) {
+            sorted.pushEnd({i * 3, -1});
+        }
+        u_integer fresh = 0;
+        for (int i = 0; i < batch; ++i) {
+            fresh += i * 3 >= 600 || i * 3 % 2 == 1;
+        }
+        EXPECT_EQ(map.bulkLoad(sorted), fresh);
+        EXPECT_EQ(map.size(), 300 + fresh);
+        EXPECT_EQ(first->get().first(), 0);
+
+        for (int i = 0; i < 600; i += 2) {
+            EXPECT_EQ(map.get(i), i);
+        }
+        for (int i = 0; i < batch; ++i) {
+            EXPECT_TRUE(map.containsKey(i * 3));
+        }
+        int prev = -1;
+        for (const auto& [k, v] : map) {
+            EXPECT_GT(k, prev);
+            prev = k;
+        }
+
+        const vector<couple<int, int>> unsorted = {{10001, 0}, {10000, 0}};
+        const u_integer size = map.size();
+        EXPECT_THROW(map.bulkLoad(unsorted), valueError);
+        EXPECT_EQ(map.size(), size);
+        EXPECT_FALSE(map.containsKey(10000));
+    }
+}
+
+// Exercises every rebalancing case of erase, including red leaves and right-left siblings
+TEST(TreeMapRandomTest, AddRemoveMatchesStdMap) {
+    treeMap<int, int> map;
+    std::map<int, int> expected;
+    std::mt19937 gen(7);
+    for (int i = 0; i < 50000; ++i) {
+        const int key = static_cast<int>(gen() % 500);
+        if (gen() % 2) {
+            ASSERT_EQ(map.remove(key), expected.erase(key) == 1);
+        } else {
+            ASSERT_EQ(map.add(key, i), expected.emplace(key, i).second);
+        }
+        ASSERT_EQ(map.size(), expected.size());
+    }
+    auto it = ownerPtr(map.begins());
+    for (const auto& [k, v] : expected) {
+        ASSERT_TRUE(it->isValid());
+        EXPECT_EQ(it->get().first(), k);
+        EXPECT_EQ(it->get().second(), v);
+        it->next();
+    }
+    EXPECT_FALSE(it->isValid());
+}
+
+TEST(TreeMapOrderStatisticTest, RankSelectMatchStdMapUnderChurn) {
+    treeMap<int, int> map;
+    std::map<int, int> expected;
+    std::mt19937 gen(11);
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 500; ++i) {
+            const int key = static_cast<int>(gen() % 1000);
+            if (gen() % 3 == 0) {
+                map.remove(key);
+                expected.erase(key);
+            } else {
+                map.add(key, key * 3);
+                expected.emplace(key, key * 3);
+            }
+        }
+        ASSERT_EQ(map.size(), expected.size());
+        u_integer index = 0;
+        for (const auto& [k, v] : expected) {
+            ASSERT_EQ(map.rank(k), index);
+            ASSERT_EQ(map.select(index).first(), k);
+            ASSERT_EQ(map.select(index).second(), v);
+            index += 1;
+        }
+        for (int probe = -1; probe <= 1000; probe += 37) {
+            ASSERT_EQ(map.rank(probe),
+                      static_cast<u_integer>(std::distance(expected.begin(), expected.lower_bound(probe))));
+        }
+    }
+    EXPECT_THROW(map.select(map.size()), outOfBoundError);
+
+    const treeMap<int, int> copy = map;
+    for (u_integer i = 0; i < copy.size(); ++i) {
+        ASSERT_EQ(copy.select(i).first(), map.select(i).first());
+    }
+}
+
+TEST(TreeMapOrderStatisticTest, IteratorJumpsAndDistance) {
+    vector<couple<int, int>> sorted;
+    for (int i = 0; i < 1000; ++i) {
+        sorted.pushEnd({i * 2, i});
+    }
+    auto map = treeMap<int, int>::fromSorted(sorted);
+    vector<couple<int, int>> batch;
+    for (int i = 0; i < 500; ++i) {
+        batch.pushEnd({i * 4 + 1, i});
+    }
+    map.bulkLoad(batch);
+    ASSERT_EQ(map.size(), 1500);
+
+    const auto first = ownerPtr(map.begins());
+    const auto last = ownerPtr(map.ends());
+    EXPECT_EQ(*last - *first, 1499);
+    EXPECT_EQ(*first - *last, -1499);
+
+    for (u_integer i = 0; i < map.size(); i += 97) {
+        const auto it = ownerPtr(map.begins());
+        *it += static_cast<integer>(i);
+        ASSERT_TRUE(it->isValid());
+        ASSERT_EQ(it->get().first(), map.select(i).first());
+        ASSERT_EQ(*it - *first, static_cast<integer>(i));
+        *it -= static_cast<integer>(i / 2);
+        ASSERT_EQ(it->get().first(), map.select(i - i / 2).first());
+    }
+
+    const auto past = ownerPtr(map.ends());
+    *past += 1;
+    EXPECT_FALSE(past->isValid());
+    EXPECT_EQ(*past - *first, 1500);
+    const auto before = ownerPtr(map.begins());
+    *before -= 5;
+    EXPECT_FALSE(before->isValid());
+}
+
+TEST(TreeMapAlgebraTest, KeepsOwnValuesForSharedKeys) {
+    treeMap<int, int> mine, theirs;
+    std::map<int, int> expected_union, expected_intersection, expected_difference;
+    for (int k = 0; k < 3000; k += 2) {
+        mine.add(k, k);
+    }
+    for (int k = 0; k < 3000; k += 3) {
+        theirs.add(k, -k);
+    }
+    for (int k = 0; k < 3000; ++k) {
+        if (k % 2 == 0) {
+            expected_union[k] = k;
+            (k % 3 == 0 ? expected_intersection : expected_difference)[k] = k;
+        } else if (k % 3 == 0) {
+            expected_union[k] = -k;
+        }
+    }
+
+    treeMap<int, int> u = mine, n = mine, d = mine;
+    u.unionWith(theirs);
+    n.intersectWith(theirs);
+    d.differenceWith(theirs);
+    for (const auto& [result, expected] : {std::pair{&u, &expected_union},
+                                           std::pair{&n, &expected_intersection},
+                                           std::pair{&d, &expected_difference}}) {
+        ASSERT_EQ(result->size(), expected->size());
+        auto it = ownerPtr(result->begins());
+        for (const auto& [k, v] : *expected) {
+            ASSERT_EQ(it->get().first(), k);
+            ASSERT_EQ(it->get().second(), v);
+            it->next();
+        }
+        EXPECT_FALSE(it->isValid());
+    }
+    EXPECT_EQ(theirs.size(), 1000);
+}
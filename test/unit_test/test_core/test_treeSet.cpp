@@ -3,6 +3,9 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
 
 using namespace original;
 
@@ -269,3 +272,124 @@ TEST_F(TreeSetTest, ReverseOrderInsertion) {
         expected++;
     }
 }
+
+TEST(TreeSetBulkTest, FromSortedAndBulkLoad) {
+    vector<int> sorted;
+    for (int i = 0; i < 1000; ++i) {
+        sorted.pushEnd(i * 2);
+    }
+    auto set = treeSet<int>::fromSorted(sorted);
+    EXPECT_EQ(set.size(), 1000);
+
+    vector<int> batch;
+    for (int i = 0; i < 1000; ++i) {
+        batch.pushEnd(i);
+        batch.pushEnd(i);
+    }
+    EXPECT_EQ(set.bulkLoad(batch), 500);
+    EXPECT_EQ(set.size(), 1500);
+    int expected = 0;
+    for (const auto& e : set) {
+        EXPECT_EQ(e, expected);
+        expected += expected < 1000 ? 1 : 2;
+    }
+
+    const vector<int> unsorted = {5, 4};
+    EXPECT_THROW(treeSet<int>::fromSorted(unsorted), valueError);
+}
+
+TEST(TreeSetOrderStatisticTest, RankSelectAndIteratorDistance) {
+    treeSet<int> set;
+    std::set<int> expected;
+    std::mt19937 gen(5);
+    for (int i = 0; i < 10000; ++i) {
+        const int e = static_cast<int>(gen() % 2000);
+        if (gen() % 3 == 0) {
+            ASSERT_EQ(set.remove(e), expected.erase(e) == 1);
+        } else {
+            ASSERT_EQ(set.add(e), expected.insert(e).second);
+        }
+    }
+    ASSERT_EQ(set.size(), expected.size());
+
+    const auto first = ownerPtr(set.begins());
+    u_integer index = 0;
+    for (const int e : expected) {
+        ASSERT_EQ(set.rank(e), index);
+        ASSERT_EQ(set.select(index), e);
+        const auto it = ownerPtr(set.begins());
+        *it += static_cast<integer>(index);
+        ASSERT_EQ(it->get(), e);
+        ASSERT_EQ(*it - *first, static_cast<integer>(index));
+        index += 1;
+    }
+    EXPECT_EQ(set.rank(2000), set.size());
+    EXPECT_THROW(set.select(set.size()), outOfBoundError);
+}
+
+TEST(TreeSetAlgebraTest, MatchesStdSetAlgorithms) {
+    std::mt19937 gen(17);
+    for (int round = 0; round < 40; ++round) {
+        const int range = 1 + static_cast<int>(gen() % 4000);
+        const int other_cnt = round % 4 == 0 ? static_cast<int>(gen() % 16) : static_cast<int>(gen() % 3000);
+        treeSet<int> a, b;
+        std::set<int> ea, eb;
+        for (int i = 0; i < static_cast<int>(gen() % 3000); ++i) {
+            const int e = static_cast<int>(gen() % range);
+            a.add(e);
+            ea.insert(e);
+        }
+        for (int i = 0; i < other_cnt; ++i) {
+            const int e = static_cast<int>(gen() % range);
+            b.add(e);
+            eb.insert(e);
+        }
+
+        std::vector<int> u, n, d;
+        std::set_union(ea.begin(), ea.end(), eb.begin(), eb.end(), std::back_inserter(u));
+        std::set_intersection(ea.begin(), ea.end(), eb.begin(), eb.end(), std::back_inserter(n));
+        std::set_difference(ea.begin(), ea.end(), eb.begin(), eb.end(), std::back_inserter(d));
+
+        treeSet<int> su = a, sn = a, sd = a;
+        su.unionWith(b);
+        sn.intersectWith(b);
+        sd.differenceWith(b);
+        for (const auto& [result, expected] : {std::pair{&su, &u}, std::pair{&sn, &n}, std::pair{&sd, &d}}) {
+            ASSERT_EQ(result->size(), expected->size());
+            std::vector<int> actual;
+            for (const int e : *result) {
+                actual.push_back(e);
+            }
+            ASSERT_EQ(actual, *expected);
+            for (u_integer i = 0; i < result->size(); i += 13) {
+                ASSERT_EQ(result->select(i), (*expected)[i]);
+            }
+        }
+        su.add(range);
+        su.remove(0);
+        EXPECT_TRUE(su.contains(range));
+        EXPECT_FALSE(su.contains(0));
+    }
+}
+
+TEST(TreeSetAlgebraTest, SelfAndEmptyOperands) {
+    treeSet<int> set;
+    set.add(1);
+    set.add(2);
+    set.add(3);
+    const treeSet<int> empty;
+    set.unionWith(set);
+    EXPECT_EQ(set.size(), 3);
+    set.intersectWith(set);
+    EXPECT_EQ(set.size(), 3);
+    set.unionWith(empty);
+    EXPECT_EQ(set.size(), 3);
+
+    treeSet<int> copy = empty;
+    copy.unionWith(set);
+    EXPECT_EQ(copy.size(), 3);
+    copy.differenceWith(copy);
+    EXPECT_EQ(copy.size(), 0);
+    set.intersectWith(empty);
+    EXPECT_EQ(set.size(), 0);
+}
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <memory>
 #include <numeric>
 #include <unordered_set>
 #include <gtest/gtest.h>
@@ -21,6 +22,19 @@ public:
     }
 };
 
+// 辅助类型：只能被移动 moves 次，之后再移动就抛出异常
+struct brittleValue {
+    int moves;
+
+    explicit brittleValue(const int moves) : moves(moves) {}
+
+    brittleValue(brittleValue&& other) : moves(other.moves - 1) {
+        if (other.moves == 0) {
+            throw runTimeTestError("moved too often");
+        }
+    }
+};
+
 // 辅助函数：运行 promise 在单独线程中
 template<typename Promise>
 void runPromiseInThread(Promise p) {
@@ -2376,4 +2390,141 @@ TEST(AsyncTest, LazyPipeLazyEvaluationVerification) {
     EXPECT_TRUE(first_stage_executed.load());
     EXPECT_TRUE(second_stage_executed.load());
     EXPECT_GE(total_time.value(), 190);  // 总执行时间至少200ms
-}
\ No newline at end of file
+}
+// 结果内联存储在共享状态中：strongPointer() 在所有 future 销毁后依然有效
+TEST(AsyncTest, StrongPointerOutlivesFuturesAndPromise) {
+    strongPtr<const std::string> result_ptr;
+    {
+        auto p = async::makePromise([] { return std::string(64, 'x'); });
+        auto sf = p.getFuture().share();
+        p.run();
+        result_ptr = sf.strongPointer();
+    }
+    ASSERT_NE(result_ptr, nullptr);
+    EXPECT_EQ(*result_ptr, std::string(64, 'x'));
+}
+
+// 回调直接保存在 promise 中，只能移动的回调也可以运行
+TEST(AsyncTest, MoveOnlyCallbackAndBlockedWaiters) {
+    auto payload = std::make_unique<int>(7);
+    auto p = async::makePromise([payload = std::move(payload)] { return *payload * 6; });
+    auto sf = p.getFuture().share();
+
+    std::vector<int> seen(4, 0);
+    std::vector<thread> waiters;
+    for (int i = 0; i < 4; ++i) {
+        waiters.emplace_back([&sf, &seen, i] { seen[i] = sf.result(); });
+    }
+    thread::sleep(milliseconds(20));
+    EXPECT_FALSE(sf.ready());
+    p.run();
+    for (auto& t : waiters) {
+        t.join();
+    }
+    EXPECT_EQ(seen, std::vector<int>(4, 42));
+}
+
+// whenAll：所有 future 完成后按参数顺序得到结果
+TEST(AsyncTest, WhenAllVariadicCollectsResultsInOrder) {
+    auto slow = async::get([] {
+        thread::sleep(milliseconds(40));
+        return 1;
+    });
+    auto text = async::get([] { return std::string("two"); });
+    auto p = async::makePromise([] { return 3.5; });
+    auto ready = p.getFuture();
+    p.run();
+
+    auto all = async::whenAll(std::move(slow), std::move(text), std::move(ready));
+    EXPECT_FALSE(slow.valid());
+    const auto results = all.result();
+    EXPECT_EQ(results.get<0>(), 1);
+    EXPECT_EQ(results.get<1>(), "two");
+    EXPECT_EQ(results.get<2>(), 3.5);
+}
+
+// whenAll：失败时在所有 future 完成后传播第一个（按参数顺序）异常
+TEST(AsyncTest, WhenAllPropagatesFirstExceptionAfterAllComplete) {
+    std::atomic<bool> slow_done{false};
+    auto ok = async::get([] { return 1; });
+    auto late_failure = async::get([&slow_done]() -> int {
+        thread::sleep(milliseconds(40));
+        slow_done = true;
+        throw std::logic_error("late");
+    });
+    auto early_failure = async::get([]() -> int { throw std::runtime_error("early"); });
+
+    auto all = async::whenAll(std::move(ok), std::move(late_failure), std::move(early_failure));
+    EXPECT_THROW(all.result(), std::logic_error);
+    EXPECT_TRUE(slow_done.load());
+
+    auto invalid = async::future<int>{};
+    EXPECT_THROW(async::whenAll(std::move(invalid)), sysError);
+}
+
+// whenAll：收集结果时抛出的异常进入合并的 future，不影响发布结果的一方
+TEST(AsyncTest, WhenAllCapturesFailureWhileCollecting) {
+    // 第一次移动进入共享状态，whenAll 取出结果时的第二次移动抛出异常
+    auto p = async::makePromise([] { return brittleValue{1}; });
+    auto all = async::whenAll(p.getFuture(), async::get([] { return 2; }));
+    EXPECT_NO_THROW(p.run());
+    EXPECT_THROW(all.result(), runTimeTestError);
+
+    auto q = async::makePromise([] { return brittleValue{1}; });
+    std::vector<async::future<brittleValue>> inputs;
+    inputs.push_back(q.getFuture());
+    auto any = async::whenAny(inputs);
+    EXPECT_NO_THROW(q.run());
+    EXPECT_THROW(any.result(), runTimeTestError);
+}
+
+// whenAll 容器形式：扇出 64 个子任务
+TEST(AsyncTest, WhenAllContainerFansOut) {
+    std::vector<async::future<int>> subtasks;
+    for (int i = 0; i < 64; ++i) {
+        subtasks.push_back(async::get([i] {
+            thread::sleep(milliseconds(i % 5));
+            return i * i;
+        }));
+    }
+    const auto squares = async::whenAll(subtasks).result();
+    ASSERT_EQ(squares.size(), 64);
+    for (int i = 0; i < 64; ++i) {
+        EXPECT_EQ(squares[i], i * i);
+    }
+
+    std::atomic<int> finished{0};
+    std::vector<async::future<void>> steps;
+    for (int i = 0; i < 8; ++i) {
+        steps.push_back(async::get([&finished] { ++finished; }));
+    }
+    auto done = async::whenAll(std::move(steps));
+    done.result();
+    EXPECT_EQ(finished.load(), 8);
+
+    EXPECT_EQ(async::whenAll(std::vector<async::future<int>>{}).result().size(), 0);
+}
+
+// whenAny：第一个完成的 future 决定结果
+TEST(AsyncTest, WhenAnyCompletesWithFirstResult) {
+    auto slow = async::get([] {
+        thread::sleep(milliseconds(200));
+        return std::string("slow");
+    });
+    auto fast = async::get([] {
+        thread::sleep(milliseconds(10));
+        return std::string("fast");
+    });
+    const auto start = time::point::now();
+    const auto first = async::whenAny(std::move(slow), std::move(fast)).result();
+    EXPECT_LT((time::point::now() - start).value(), 150);
+    EXPECT_EQ(first.first(), 1);
+    EXPECT_EQ(first.second(), "fast");
+
+    std::vector<async::future<void>> waits;
+    waits.push_back(async::get([] { thread::sleep(milliseconds(100)); }));
+    waits.push_back(async::get([]() { throw std::runtime_error("failed first"); }));
+    EXPECT_THROW(async::whenAny(waits).result(), std::runtime_error);
+
+    EXPECT_THROW(async::whenAny(std::vector<async::future<int>>{}), valueError);
+}
@@ -110,3 +110,28 @@ TEST(AtomicTest, ConcurrentIncrementCAS) {
 
     EXPECT_EQ(counter.load(), 2000);
 }
+
+// ========== wait / notify ==========
+TEST(AtomicTest, WaitReturnsAfterNotify) {
+    auto flag = makeAtomic<u_integer>(0);
+    EXPECT_FALSE(flag.waitFor(0, time::duration{10, time::MILLISECOND}));
+    EXPECT_TRUE(flag.waitFor(1, time::duration{10, time::MILLISECOND}));
+
+    std::thread notifier([&flag] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        flag.store(1);
+        flag.notifyAll();
+    });
+    flag.wait(0);
+    EXPECT_EQ(flag.load(), 1);
+    notifier.join();
+
+    std::thread late([&flag] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        flag.store(2);
+        flag.notifyOne();
+    });
+    EXPECT_TRUE(flag.waitFor(1, time::duration{5, time::SECOND}));
+    EXPECT_EQ(flag.load(), 2);
+    late.join();
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+#include "async.h"
+#include "cancellation.h"
+#include "generators.h"
+#include "tasks.h"
+#include "thread.h"
+
+using namespace original;
+
+TEST(CancellationTest, TokensObserveCancelAndCallbacksRunOnce) {
+    const cancellationToken detached;
+    EXPECT_FALSE(detached.cancelled());
+    EXPECT_FALSE(detached.deadline());
+    EXPECT_NO_THROW(detached.throwIfCancelled());
+
+    cancellationSource source;
+    const auto token = source.token();
+    EXPECT_FALSE(token.cancelled());
+    EXPECT_FALSE(token.deadline());
+
+    std::vector<int> order;
+    const auto first = token.onCancel([&order] { order.push_back(1); });
+    auto dropped = token.onCancel([&order] { order.push_back(2); });
+    const auto third = token.onCancel([&order] { order.push_back(3); });
+    dropped.reset();
+
+    source.cancel();
+    source.cancel();
+    EXPECT_TRUE(source.cancelled());
+    EXPECT_TRUE(token.cancelled());
+    EXPECT_THROW(token.throwIfCancelled(), cancelledError);
+    ASSERT_EQ(order.size(), 2);
+    EXPECT_EQ(order[0], 1);
+    EXPECT_EQ(order[1], 3);
+
+    // Registering on a cancelled token runs the callback at once
+    const auto late = token.onCancel([&order] { order.push_back(4); });
+    ASSERT_EQ(order.size(), 3);
+    EXPECT_EQ(order[2], 4);
+}
+
+TEST(CancellationTest, CallbacksMayUnregisterCallbacks) {
+    cancellationSource source;
+    const auto token = source.token();
+    std::vector<int> order;
+    cancellationRegistration self, later;
+    self = token.onCancel([&order, &self] {
+        self.reset();
+        order.push_back(1);
+    });
+    const auto second = token.onCancel([&order, &later] {
+        later.reset();
+        order.push_back(2);
+    });
+    later = token.onCancel([&order] { order.push_back(3); });
+    source.cancel();
+    ASSERT_EQ(order.size(), 2);
+    EXPECT_EQ(order[0], 1);
+    EXPECT_EQ(order[1], 2);
+
+    // Unregistering from another thread waits for the running callback
+    cancellationSource slow;
+    std::atomic<bool> started{false};
+    std::atomic<bool> finished{false};
+    auto running = slow.token().onCancel([&started, &finished] {
+        started = true;
+        thread::sleep(milliseconds(50));
+        finished = true;
+    });
+    thread canceller{[&slow] { slow.cancel(); }};
+    while (!started) {
+        thread::yield();
+    }
+    running.reset();
+    EXPECT_TRUE(finished.load());
+}
+
+TEST(CancellationTest, DeadlinesAndChildSources) {
+    const auto soon = time::point::now() + time::duration{20, time::MILLISECOND};
+    cancellationSource parent{soon};
+    ASSERT_TRUE(parent.token().deadline());
+    EXPECT_EQ(*parent.token().deadline(), soon);
+
+    // A child never outlives its parent's deadline, but may have an earlier one
+    cancellationSource child{parent.token(), soon + time::duration{1, time::SECOND}};
+    EXPECT_EQ(*child.token().deadline(), soon);
+    cancellationSource sooner{parent.token(), time::point::now()};
+    EXPECT_TRUE(sooner.cancelled());
+    EXPECT_FALSE(parent.cancelled());
+
+    bool fired = false;
+    const auto registration = child.token().onCancel([&fired] { fired = true; });
+    thread::sleep(time::duration{30, time::MILLISECOND});
+    // Deadlines fire when a check notices them
+    EXPECT_FALSE(fired);
+    EXPECT_TRUE(child.token().cancelled());
+    EXPECT_TRUE(fired);
+
+    cancellationSource root;
+    cancellationSource branch{root.token()};
+    cancellationSource leaf{branch.token()};
+    EXPECT_FALSE(leaf.token().deadline());
+    root.cancel();
+    EXPECT_TRUE(branch.cancelled());
+    EXPECT_TRUE(leaf.cancelled());
+
+    cancellationSource timeout{time::duration{0, time::MILLISECOND}};
+    EXPECT_TRUE(timeout.cancelled());
+}
+
+TEST(CancellationTest, FutureWaitForReturnsOnCancelDeadlineOrResult) {
+    auto blocked = async::makePromise([] { return 7; });
+    const auto f = blocked.getFuture().share();
+
+    cancellationSource source;
+    thread canceller{[&source] {
+        thread::sleep(time::duration{20, time::MILLISECOND});
+        source.cancel();
+    }};
+    EXPECT_FALSE(f.waitFor(source.token()));
+    canceller.join();
+
+    const auto start = time::point::now();
+    const cancellationSource expiring{time::duration{20, time::MILLISECOND}};
+    EXPECT_FALSE(f.waitFor(expiring.token()));
+    EXPECT_GE((time::point::now() - start).value(time::MILLISECOND), 15);
+
+    const cancellationSource idle;
+    thread producer{[&blocked] {
+        thread::sleep(time::duration{10, time::MILLISECOND});
+        blocked.run();
+    }};
+    EXPECT_TRUE(f.waitFor(idle.token()));
+    producer.join();
+    EXPECT_EQ(f.result(), 7);
+    EXPECT_TRUE(f.waitFor(source.token()));
+}
+
+TEST(CancellationTest, CancelledWorkIsSkipped) {
+    cancellationSource source;
+    auto gate = async::makePromise([] {});
+    auto open = gate.getFuture().share();
+
+    taskDelegator delegator{1};
+    // Keeps the only worker busy until the gate opens
+    auto busy = delegator.submit([open] { open.wait(); });
+    int runs = 0;
+    auto skipped = delegator.submit(source.token(), [&runs](const int x) { ++runs; return x; }, 1);
+    auto kept = delegator.submit(taskDelegator::HIGH, cancellationToken{}, [&runs](const int x) { ++runs; return x; }, 2);
+    source.cancel();
+    gate.run();
+
+    busy.result();
+    EXPECT_EQ(kept.result(), 2);
+    EXPECT_THROW(skipped.result(), cancelledError);
+    EXPECT_EQ(runs, 1);
+
+    auto never = async::get(source.token(), [] { return 1; });
+    EXPECT_THROW(never.result(), cancelledError);
+    // A callable that polls its own token stops early instead of being skipped
+    cancellationSource live;
+    auto polled = async::get([](const cancellationToken& token) {
+        int steps = 0;
+        while (!token.cancelled()) {
+            ++steps;
+            thread::yield();
+        }
+        return steps;
+    }, live.token());
+    live.cancel();
+    EXPECT_GE(polled.result(), 0);
+}
+
+TEST(CancellationTest, GeneratorPipelineStopsWhenCancelled) {
+    cancellationSource source;
+    int produced = 0;
+    auto naturals = [&produced]() -> coroutine::generator<int> {
+        for (int i = 0;; ++i) {
+            ++produced;
+            co_yield i;
+        }
+    };
+
+    int sum = 0;
+    for (const int v : naturals() | cancellable(source.token()) | transforms([](const int x) { return x * 2; })) {
+        sum += v;
+        if (v == 8) {
+            source.cancel();
+        }
+    }
+    EXPECT_EQ(sum, 0 + 2 + 4 + 6 + 8);
+    EXPECT_EQ(produced, 5);
+
+    auto rest = cancellable(naturals(), source.token());
+    EXPECT_FALSE(rest.next());
+}
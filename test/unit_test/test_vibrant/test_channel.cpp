@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "channel.h"
+#include "thread.h"
+
+using namespace original;
+
+TEST(ChannelTest, UnboundedFifoAndCloseDrainsPendingMessages) {
+    channel<std::string> ch;
+    EXPECT_EQ(ch.capacity(), channel<std::string>::UNBOUNDED);
+    EXPECT_FALSE(ch.tryReceive());
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(ch.send(std::to_string(i)));
+    }
+    EXPECT_EQ(ch.size(), 1000);
+    EXPECT_EQ(*ch.receive(), "0");
+    EXPECT_EQ(*ch.tryReceive(), "1");
+
+    ch.close();
+    EXPECT_TRUE(ch.closed());
+    EXPECT_FALSE(ch.send("late"));
+    EXPECT_FALSE(ch.trySend("late"));
+    EXPECT_EQ(*ch.receiveFor(time::duration{1, time::MILLISECOND}), "2");
+
+    const auto batch = ch.receiveBatch(500);
+    ASSERT_EQ(batch.size(), 500);
+    EXPECT_EQ(batch.get(0), "3");
+    EXPECT_EQ(batch.get(499), "502");
+    EXPECT_EQ(ch.receiveBatch(0).size(), 0);
+    EXPECT_EQ(ch.receiveBatch(1000).size(), 497);
+    EXPECT_FALSE(ch.receive());
+    EXPECT_TRUE(ch.receiveBatch(8).empty());
+    EXPECT_TRUE(ch.empty());
+}
+
+TEST(ChannelTest, ReceiveForTimesOutOnAnOpenEmptyChannel) {
+    channel<int> ch{4};
+    const auto start = time::point::now();
+    EXPECT_FALSE(ch.receiveFor(time::duration{20, time::MILLISECOND}));
+    EXPECT_GE((time::point::now() - start).value(time::MILLISECOND), 15);
+
+    thread sender{[&ch] {
+        thread::sleep(time::duration{10, time::MILLISECOND});
+        ch.send(7);
+    }};
+    const auto e = ch.receiveFor(time::duration{5, time::SECOND});
+    sender.join();
+    ASSERT_TRUE(e);
+    EXPECT_EQ(*e, 7);
+}
+
+TEST(ChannelTest, BoundedSendWaitsForRoomAndCloseReleasesSenders) {
+    channel<int> ch{2};
+    EXPECT_TRUE(ch.trySend(1));
+    EXPECT_TRUE(ch.trySend(2));
+    EXPECT_FALSE(ch.trySend(3));
+
+    thread sender{[&ch] {
+        EXPECT_TRUE(ch.send(3));
+        // The channel is full again; this send only returns because of close()
+        EXPECT_FALSE(ch.send(4));
+    }};
+    EXPECT_EQ(*ch.receive(), 1);
+    while (ch.size() < 2) {
+        thread::yield();
+    }
+    thread::sleep(time::duration{10, time::MILLISECOND});
+    ch.close();
+    sender.join();
+    const auto rest = ch.receiveBatch(8);
+    ASSERT_EQ(rest.size(), 2);
+    EXPECT_EQ(rest.get(0), 2);
+    EXPECT_EQ(rest.get(1), 3);
+}
+
+TEST(ChannelTest, ManyProducersBatchedConsumersAndGenerator) {
+    constexpr int producers = 4;
+    constexpr int per_producer = 20000;
+    channel<int> ch{256};
+
+    std::vector<thread> senders;
+    for (int p = 0; p < producers; ++p) {
+        senders.emplace_back([&ch, p] {
+            for (int i = 0; i < per_producer; ++i) {
+                ch.send(p * per_producer + i);
+            }
+        });
+    }
+
+    std::vector<int> seen(producers * per_producer, 0);
+    std::vector<int> from_batches;
+    thread batch_receiver{[&ch, &from_batches] {
+        while (true) {
+            const auto batch = ch.receiveBatch(32);
+            if (batch.empty()) {
+                return;
+            }
+            for (const int v : batch) {
+                from_batches.push_back(v);
+            }
+        }
+    }};
+    thread closer{[&ch, &senders] {
+        for (auto& t : senders) {
+            t.join();
+        }
+        ch.close();
+    }};
+
+    std::vector<int> last(producers, -1);
+    for (const int v : ch.elements(16)) {
+        // One receiver sees each producer's messages in send order
+        ASSERT_GT(v, last[v / per_producer]);
+        last[v / per_producer] = v;
+        ++seen[v];
+    }
+    closer.join();
+    batch_receiver.join();
+
+    for (const int v : from_batches) {
+        ++seen[v];
+    }
+    for (int v = 0; v < producers * per_producer; ++v) {
+        ASSERT_EQ(seen[v], 1) << "message " << v;
+    }
+}
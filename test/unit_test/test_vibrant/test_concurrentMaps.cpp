@@ -0,0 +1,427 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "concurrentMaps.h"
+#include "thread.h"
+
+using namespace original;
+
+TEST(ConcurrentHashMapTest, BasicOperations) {
+    concurrentHashMap<int, std::string> m;
+    EXPECT_EQ(m.size(), 0);
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.className(), "concurrentHashMap");
+
+    EXPECT_TRUE(m.add(1, "one"));
+    EXPECT_TRUE(m.add(2, "two"));
+    EXPECT_FALSE(m.add(1, "uno"));
+    EXPECT_EQ(m.size(), 2);
+    EXPECT_EQ(m.get(1), "one");
+    EXPECT_TRUE(m.containsKey(2));
+    EXPECT_FALSE(m.containsKey(3));
+    EXPECT_TRUE(m.contains({2, "two"}));
+    EXPECT_FALSE(m.contains({2, "deux"}));
+    EXPECT_THROW(m.get(3), noElementError);
+
+    EXPECT_TRUE(m.update(2, "deux"));
+    EXPECT_FALSE(m.update(3, "trois"));
+    EXPECT_EQ(m.get(2), "deux");
+
+    EXPECT_TRUE(m.remove(1));
+    EXPECT_FALSE(m.remove(1));
+    EXPECT_EQ(m.size(), 1);
+}
+
+TEST(ConcurrentHashMapTest, ShardCountRoundsToPowerOfTwo) {
+    EXPECT_EQ((concurrentHashMap<int, int>{1}.shardCount()), 1);
+    EXPECT_EQ((concurrentHashMap<int, int>{5}.shardCount()), 8);
+    EXPECT_EQ((concurrentHashMap<int, int>{16}.shardCount()), 16);
+}
+
+TEST(ConcurrentHashMapTest, ComputeIfAbsentAndCallbackUpdate) {
+    concurrentHashMap<int, int> m;
+    int calls = 0;
+    EXPECT_EQ(m.computeIfAbsent(7, [&](const int k) { ++calls; return k * 10; }), 70);
+    EXPECT_EQ(m.computeIfAbsent(7, [&](const int k) { ++calls; return k * 100; }), 70);
+    EXPECT_EQ(calls, 1);
+
+    EXPECT_TRUE(m.update(7, [](int& v) { v += 1; }));
+    EXPECT_FALSE(m.update(8, [](int& v) { v += 1; }));
+    EXPECT_EQ(m.get(7), 71);
+}
+
+TEST(ConcurrentHashMapTest, ForEachVisitsAllPairs) {
+    concurrentHashMap<int, int> m{4};
+    for (int i = 0; i < 1000; ++i) {
+        m.add(i, i * 2);
+    }
+    long long key_sum = 0;
+    long long value_sum = 0;
+    m.forEach([&](const int k, const int v) {
+        key_sum += k;
+        value_sum += v;
+    });
+    EXPECT_EQ(key_sum, 999 * 1000 / 2);
+    EXPECT_EQ(value_sum, 999 * 1000);
+}
+
+TEST(ConcurrentHashMapTest, ConcurrentDisjointInserts) {
+    constexpr int thread_count = 8;
+    constexpr int per_thread = 2000;
+    concurrentHashMap<int, int> m;
+
+    std::vector<thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&m, t] {
+            for (int i = 0; i < per_thread; ++i) {
+                m.add(t * per_thread + i, i);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(m.size(), thread_count * per_thread);
+    for (int i = 0; i < thread_count * per_thread; ++i) {
+        ASSERT_EQ(m.get(i), i % per_thread);
+    }
+}
+
+TEST(ConcurrentHashMapTest, ConcurrentCountersAreAtomic) {
+    constexpr int thread_count = 8;
+    constexpr int iterations = 2000;
+    constexpr int keys = 16;
+    concurrentHashMap<int, int> m;
+
+    std::vector<thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&m] {
+            for (int i = 0; i < iterations; ++i) {
+                const int key = i % keys;
+                m.computeIfAbsent(key, [](int) { return 0; });
+                m.update(key, [](int& v) { v += 1; });
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    int total = 0;
+    m.forEach([&](int, const int v) { total += v; });
+    EXPECT_EQ(m.size(), keys);
+    EXPECT_EQ(total, thread_count * iterations);
+}
+
+TEST(ConcurrentHashMapTest, ConcurrentAddRemove) {
+    constexpr int thread_count = 4;
+    constexpr int iterations = 3000;
+    concurrentHashMap<int, int> m;
+
+    std::vector<thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&m, t] {
+            for (int i = 0; i < iterations; ++i) {
+                const int key = t * iterations + i;
+                EXPECT_TRUE(m.add(key, i));
+                EXPECT_TRUE(m.containsKey(key));
+                if (i % 2 == 0) {
+                    EXPECT_TRUE(m.remove(key));
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(m.size(), thread_count * iterations / 2);
+}
+
+TEST(LockFreeHashMapTest, BasicOperations) {
+    lockFreeHashMap<int, std::string> m;
+    EXPECT_EQ(m.size(), 0);
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.className(), "lockFreeHashMap");
+
+    EXPECT_TRUE(m.add(1, "one"));
+    EXPECT_TRUE(m.add(2, "two"));
+    EXPECT_FALSE(m.add(1, "uno"));
+    EXPECT_EQ(m.size(), 2);
+    EXPECT_EQ(m.get(1), "one");
+    EXPECT_TRUE(m.containsKey(2));
+    EXPECT_FALSE(m.containsKey(3));
+    EXPECT_TRUE(m.contains({2, "two"}));
+    EXPECT_FALSE(m.contains({2, "deux"}));
+    EXPECT_THROW(m.get(3), noElementError);
+
+    EXPECT_TRUE(m.remove(1));
+    EXPECT_FALSE(m.remove(1));
+    EXPECT_EQ(m.size(), 1);
+    EXPECT_EQ(m.toString(false), "lockFreeHashMap({2: \"two\"})");
+}
+
+namespace {
+    struct constantHash {
+        u_integer operator()(const int&) const noexcept {
+            return 42;
+        }
+    };
+}
+
+TEST(LockFreeHashMapTest, CollidingKeys) {
+    lockFreeHashMap<int, int, constantHash> m;
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(m.add(i, i + 1));
+    }
+    for (int i = 0; i < 100; i += 2) {
+        EXPECT_TRUE(m.remove(i));
+    }
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(m.containsKey(i), i % 2 == 1);
+    }
+    EXPECT_EQ(m.get(51), 52);
+    EXPECT_EQ(m.size(), 50);
+}
+
+TEST(LockFreeHashMapTest, GrowsBucketsWithoutMovingElements) {
+    lockFreeHashMap<int, int> m;
+    const u_integer initial = m.bucketCount();
+    for (int i = 0; i < 20000; ++i) {
+        m.add(i, -i);
+    }
+    EXPECT_GT(m.bucketCount(), initial);
+    EXPECT_EQ(m.bucketCount() & (m.bucketCount() - 1), 0);
+    EXPECT_LE(m.size() / m.bucketCount(), (lockFreeHashMap<int, int>::LOAD_FACTOR_MAX));
+    for (int i = 0; i < 20000; ++i) {
+        ASSERT_EQ(m.get(i), -i);
+    }
+
+    long long key_sum = 0;
+    int visited = 0;
+    m.forEach([&](const int k, int) {
+        key_sum += k;
+        ++visited;
+    });
+    EXPECT_EQ(visited, 20000);
+    EXPECT_EQ(key_sum, 19999LL * 20000 / 2);
+}
+
+TEST(LockFreeHashMapTest, ConcurrentAddRemoveGet) {
+    constexpr int thread_count = 8;
+    constexpr int iterations = 4000;
+    lockFreeHashMap<int, int> m;
+
+    std::vector<thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&m, t] {
+            for (int i = 0; i < iterations; ++i) {
+                const int key = t * iterations + i;
+                EXPECT_TRUE(m.add(key, i));
+                EXPECT_EQ(m.get(key), i);
+                if (i % 2 == 0) {
+                    EXPECT_TRUE(m.remove(key));
+                    EXPECT_FALSE(m.containsKey(key));
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(m.size(), thread_count * iterations / 2);
+    for (int key = 0; key < thread_count * iterations; ++key) {
+        ASSERT_EQ(m.containsKey(key), key % iterations % 2 == 1);
+    }
+}
+
+TEST(LockFreeHashMapTest, ContendedSameKeys) {
+    constexpr int thread_count = 8;
+    constexpr int iterations = 5000;
+    constexpr int keys = 32;
+    lockFreeHashMap<int, std::string> m;
+
+    std::vector<thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&m, t] {
+            for (int i = 0; i < iterations; ++i) {
+                const int key = (i * 7 + t) % keys;
+                if ((i + t) % 3 == 0) {
+                    m.remove(key);
+                } else if (m.add(key, std::to_string(key))) {
+                    continue;
+                } else {
+                    try {
+                        EXPECT_EQ(m.get(key), std::to_string(key));
+                    } catch (const noElementError&) {}
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    int visited = 0;
+    m.forEach([&](const int k, const std::string& v) {
+        EXPECT_EQ(v, std::to_string(k));
+        ++visited;
+    });
+    EXPECT_EQ(visited, m.size());
+}
+
+TEST(ConcurrentJMapTest, BasicOperations) {
+    concurrentJMap<int, std::string> m;
+    EXPECT_EQ(m.size(), 0);
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.className(), "concurrentJMap");
+
+    EXPECT_TRUE(m.add(2, "two"));
+    EXPECT_TRUE(m.add(1, "one"));
+    EXPECT_FALSE(m.add(1, "uno"));
+    EXPECT_EQ(m.size(), 2);
+    EXPECT_EQ(m.get(1), "one");
+    EXPECT_TRUE(m.containsKey(2));
+    EXPECT_FALSE(m.containsKey(3));
+    EXPECT_TRUE(m.contains({2, "two"}));
+    EXPECT_FALSE(m.contains({2, "deux"}));
+    EXPECT_THROW(m.get(3), noElementError);
+    EXPECT_EQ(m.toString(false), "concurrentJMap({1: \"one\"}, {2: \"two\"})");
+
+    EXPECT_TRUE(m.remove(1));
+    EXPECT_FALSE(m.remove(1));
+    EXPECT_EQ(m.size(), 1);
+    EXPECT_EQ(m.toString(false), "concurrentJMap({2: \"two\"})");
+}
+
+TEST(ConcurrentJMapTest, OrderedTraversalAndRange) {
+    concurrentJMap<int, int, decreaseComparator<int>> m;
+    for (int i = 0; i < 100; ++i) {
+        m.add((i * 37) % 100, i);
+    }
+    std::vector<int> keys;
+    m.forEach([&](const int k, int) { keys.push_back(k); });
+    ASSERT_EQ(keys.size(), 100);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(keys[i], 99 - i);
+    }
+
+    keys.clear();
+    m.forEachInRange(50, 40, [&](const int k, int) { keys.push_back(k); });
+    EXPECT_EQ(keys, (std::vector<int>{50, 49, 48, 47, 46, 45, 44, 43, 42, 41}));
+    keys.clear();
+    m.forEachInRange(200, 150, [&](const int k, int) { keys.push_back(k); });
+    EXPECT_TRUE(keys.empty());
+}
+
+TEST(ConcurrentJMapTest, RandomAddRemoveMatchesStdMap) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> key_dist(0, 2047);
+    concurrentJMap<int, int> m;
+    std::map<int, int> expected;
+    for (int i = 0; i < 30000; ++i) {
+        const int key = key_dist(gen);
+        if (gen() % 3 == 0) {
+            EXPECT_EQ(m.remove(key), expected.erase(key) == 1);
+        } else {
+            EXPECT_EQ(m.add(key, i), expected.emplace(key, i).second);
+        }
+    }
+    ASSERT_EQ(m.size(), expected.size());
+    auto it = expected.begin();
+    m.forEach([&](const int k, const int v) {
+        ASSERT_NE(it, expected.end());
+        EXPECT_EQ(k, it->first);
+        EXPECT_EQ(v, it->second);
+        ++it;
+    });
+    EXPECT_EQ(it, expected.end());
+}
+
+TEST(ConcurrentJMapTest, ConcurrentAddRemoveGet) {
+    constexpr int thread_count = 8;
+    constexpr int iterations = 4000;
+    concurrentJMap<int, int> m;
+
+    std::vector<thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&m, t] {
+            for (int i = 0; i < iterations; ++i) {
+                const int key = i * thread_count + t;
+                EXPECT_TRUE(m.add(key, i));
+                EXPECT_EQ(m.get(key), i);
+                if (i % 2 == 0) {
+                    EXPECT_TRUE(m.remove(key));
+                    EXPECT_FALSE(m.containsKey(key));
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(m.size(), thread_count * iterations / 2);
+    int visited = 0;
+    int last = -1;
+    m.forEach([&](const int k, const int v) {
+        EXPECT_GT(k, last);
+        EXPECT_EQ(k / thread_count % 2, 1);
+        EXPECT_EQ(v, k / thread_count);
+        last = k;
+        ++visited;
+    });
+    EXPECT_EQ(visited, thread_count * iterations / 2);
+}
+
+TEST(ConcurrentJMapTest, ContendedSameKeysWithReaders) {
+    constexpr int writer_count = 6;
+    constexpr int iterations = 5000;
+    constexpr int keys = 64;
+    concurrentJMap<int, std::string> m;
+    auto writers_done = makeAtomic<u_integer>(0);
+
+    std::vector<thread> threads;
+    for (int t = 0; t < writer_count; ++t) {
+        threads.emplace_back([&m, &writers_done, t] {
+            for (int i = 0; i < iterations; ++i) {
+                const int key = (i * 7 + t) % keys;
+                if ((i + t) % 3 == 0) {
+                    m.remove(key);
+                } else if (!m.add(key, std::to_string(key))) {
+                    try {
+                        EXPECT_EQ(m.get(key), std::to_string(key));
+                    } catch (const noElementError&) {}
+                }
+            }
+            writers_done += 1;
+        });
+    }
+    for (int r = 0; r < 2; ++r) {
+        threads.emplace_back([&m, &writers_done] {
+            while (writers_done.load() < writer_count) {
+                int last = -1;
+                m.forEach([&](const int k, const std::string& v) {
+                    EXPECT_GT(k, last);
+                    EXPECT_EQ(v, std::to_string(k));
+                    last = k;
+                });
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    int visited = 0;
+    m.forEach([&](const int k, const std::string& v) {
+        EXPECT_EQ(v, std::to_string(k));
+        EXPECT_TRUE(m.containsKey(k));
+        ++visited;
+    });
+    EXPECT_EQ(visited, m.size());
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+#include <vector>
+#include "concurrentSets.h"
+#include "thread.h"
+
+using namespace original;
+
+TEST(ConcurrentJSetTest, BasicOperations) {
+    concurrentJSet<std::string> s;
+    EXPECT_EQ(s.size(), 0);
+    EXPECT_TRUE(s.empty());
+    EXPECT_EQ(s.className(), "concurrentJSet");
+
+    EXPECT_TRUE(s.add("b"));
+    EXPECT_TRUE(s.add("a"));
+    EXPECT_FALSE(s.add("a"));
+    EXPECT_EQ(s.size(), 2);
+    EXPECT_TRUE(s.contains("a"));
+    EXPECT_FALSE(s.contains("c"));
+    EXPECT_EQ(s.toString(false), "concurrentJSet(\"a\", \"b\")");
+
+    EXPECT_TRUE(s.remove("a"));
+    EXPECT_FALSE(s.remove("a"));
+    EXPECT_EQ(s.size(), 1);
+    EXPECT_EQ(s.toString(false), "concurrentJSet(\"b\")");
+}
+
+TEST(ConcurrentJSetTest, OrderedTraversalAndRange) {
+    concurrentJSet<int> s;
+    for (int i = 0; i < 200; ++i) {
+        s.add((i * 73) % 200);
+    }
+    int expected = 0;
+    s.forEach([&](const int e) { EXPECT_EQ(e, expected++); });
+    EXPECT_EQ(expected, 200);
+
+    std::vector<int> range;
+    s.forEachInRange(10, 15, [&](const int e) { range.push_back(e); });
+    EXPECT_EQ(range, (std::vector<int>{10, 11, 12, 13, 14}));
+    range.clear();
+    s.forEachInRange(195, 1000, [&](const int e) { range.push_back(e); });
+    EXPECT_EQ(range, (std::vector<int>{195, 196, 197, 198, 199}));
+}
+
+TEST(ConcurrentJSetTest, ConcurrentInsertRemove) {
+    constexpr int thread_count = 8;
+    constexpr int per_thread = 3000;
+    concurrentJSet<int> s;
+
+    std::vector<thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&s, t] {
+            for (int i = 0; i < per_thread; ++i) {
+                EXPECT_TRUE(s.add(i * thread_count + t));
+            }
+            for (int i = 0; i < per_thread; i += 3) {
+                EXPECT_TRUE(s.remove(i * thread_count + t));
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    std::set<int> expected;
+    for (int e = 0; e < thread_count * per_thread; ++e) {
+        if (e / thread_count % 3 != 0)
+            expected.insert(e);
+    }
+    EXPECT_EQ(s.size(), expected.size());
+    auto it = expected.begin();
+    s.forEach([&](const int e) {
+        ASSERT_NE(it, expected.end());
+        EXPECT_EQ(e, *it);
+        ++it;
+    });
+    EXPECT_EQ(it, expected.end());
+}
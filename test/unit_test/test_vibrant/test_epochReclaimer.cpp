@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "epochReclaimer.h"
+#include "thread.h"
+
+using namespace original;
+
+namespace {
+    struct trackedNode : epochReclaimer::retirable {
+        int payload = 0;
+    };
+}
+
+TEST(EpochReclaimerTest, FreesAfterTwoEpochs) {
+    auto freed = makeAtomic<u_integer>(0);
+    epochReclaimer domain{[&freed](epochReclaimer::retirable* node) {
+        freed += 1;
+        delete static_cast<trackedNode*>(node);
+    }};
+
+    {
+        epochReclaimer::guard guard{domain};
+        domain.retire(new trackedNode);
+    }
+    EXPECT_EQ(freed.load(), 0);
+    domain.reclaim();
+    EXPECT_EQ(freed.load(), 0);
+    domain.reclaim();
+    EXPECT_EQ(freed.load(), 1);
+    EXPECT_EQ(domain.epoch(), 2);
+}
+
+TEST(EpochReclaimerTest, LiveGuardBlocksReclamation) {
+    auto freed = makeAtomic<u_integer>(0);
+    epochReclaimer domain{[&freed](epochReclaimer::retirable* node) {
+        freed += 1;
+        delete static_cast<trackedNode*>(node);
+    }};
+
+    {
+        epochReclaimer::guard reader{domain};
+        {
+            epochReclaimer::guard writer{domain};
+            domain.retire(new trackedNode);
+        }
+        for (int i = 0; i < 5; ++i) {
+            domain.reclaim();
+        }
+        EXPECT_EQ(freed.load(), 0);
+        EXPECT_LE(domain.epoch(), 1);
+    }
+    domain.reclaim();
+    domain.reclaim();
+    EXPECT_EQ(freed.load(), 1);
+}
+
+TEST(EpochReclaimerTest, DestructorFreesRemainingNodes) {
+    auto freed = makeAtomic<u_integer>(0);
+    {
+        epochReclaimer domain{[&freed](epochReclaimer::retirable* node) {
+            freed += 1;
+            delete static_cast<trackedNode*>(node);
+        }};
+        epochReclaimer::guard guard{domain};
+        for (int i = 0; i < 10; ++i) {
+            domain.retire(new trackedNode);
+        }
+        EXPECT_EQ(freed.load(), 0);
+    }
+    EXPECT_EQ(freed.load(), 10);
+}
+
+TEST(EpochReclaimerTest, ConcurrentRetire) {
+    constexpr int thread_count = 8;
+    constexpr int per_thread = 1000;
+    auto freed = makeAtomic<u_integer>(0);
+    {
+        epochReclaimer domain{[&freed](epochReclaimer::retirable* node) {
+            freed += 1;
+            delete static_cast<trackedNode*>(node);
+        }};
+        std::vector<thread> threads;
+        for (int t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&domain, &freed] {
+                for (int i = 0; i < per_thread; ++i) {
+                    epochReclaimer::guard guard{domain};
+                    domain.retire(new trackedNode);
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        EXPECT_GT(freed.load(), 0);
+    }
+    EXPECT_EQ(freed.load(), thread_count * per_thread);
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "mpmcQueue.h"
+#include "thread.h"
+
+using namespace original;
+
+TEST(MpmcQueueTest, RejectsCapacityThatIsNotAPowerOfTwo) {
+    EXPECT_THROW(mpmcQueue<int>{0}, valueError);
+    EXPECT_THROW(mpmcQueue<int>{6}, valueError);
+    EXPECT_THROW(mpmcQueue<int>{1u << 31}, valueError);
+    EXPECT_EQ(mpmcQueue<int>{1}.capacity(), 1);
+    EXPECT_EQ(mpmcQueue<int>{32}.capacity(), 32);
+}
+
+TEST(MpmcQueueTest, FifoAcrossManyLaps) {
+    mpmcQueue<std::string> q{4};
+    EXPECT_TRUE(q.empty());
+    EXPECT_FALSE(q.tryPop());
+
+    int pushed = 0;
+    int popped = 0;
+    // Keep two to four elements queued so every cell is reused many times
+    for (int round = 0; round < 100; ++round) {
+        while (q.tryPush(std::to_string(pushed))) {
+            ++pushed;
+        }
+        EXPECT_EQ(q.size(), 4);
+        for (int i = 0; i < 2 + round % 3; ++i) {
+            const auto e = q.tryPop();
+            ASSERT_TRUE(e);
+            EXPECT_EQ(*e, std::to_string(popped++));
+        }
+    }
+    while (const auto e = q.tryPop()) {
+        EXPECT_EQ(*e, std::to_string(popped++));
+    }
+    EXPECT_EQ(pushed, popped);
+    EXPECT_TRUE(q.empty());
+
+    const std::string copied = "copied";
+    EXPECT_TRUE(q.tryPush(copied));
+    EXPECT_TRUE(q.tryEmplace("emplaced, not this", std::string::size_type{8}));
+    EXPECT_EQ(*q.tryPop(), "copied");
+    EXPECT_EQ(*q.tryPop(), "emplaced");
+
+    // Arguments select a constructor, not an initializer list
+    mpmcQueue<std::vector<int>> vectors{2};
+    EXPECT_TRUE(vectors.tryEmplace(3, 0));
+    EXPECT_EQ(*vectors.tryPop(), std::vector<int>(3, 0));
+}
+
+TEST(MpmcQueueTest, MoveOnlyElementsAreDestroyedWithTheQueue) {
+    const auto counter = std::make_shared<int>(0);
+    {
+        mpmcQueue<std::unique_ptr<std::shared_ptr<int>>> q{8};
+        for (int i = 0; i < 5; ++i) {
+            q.push(std::make_unique<std::shared_ptr<int>>(counter));
+        }
+        auto rejected = std::make_unique<std::shared_ptr<int>>(counter);
+        for (int i = 5; i < 8; ++i) {
+            ASSERT_TRUE(q.tryPush(std::make_unique<std::shared_ptr<int>>(counter)));
+        }
+        EXPECT_FALSE(q.tryPush(std::move(rejected)));
+        ASSERT_TRUE(rejected);
+        EXPECT_EQ(counter.use_count(), 10);
+        EXPECT_EQ(**q.pop(), counter);
+        EXPECT_EQ(counter.use_count(), 9);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(MpmcQueueTest, ManyProducersAndConsumersDeliverEachElementOnce) {
+    constexpr int producers = 6;
+    constexpr int consumers = 5;
+    constexpr int per_producer = 30000;
+    mpmcQueue<int> q{64};
+
+    std::vector<thread> producer_threads;
+    for (int p = 0; p < producers; ++p) {
+        producer_threads.emplace_back([&q, p] {
+            for (int i = 0; i < per_producer; ++i) {
+                q.push(p * per_producer + i);
+            }
+        });
+    }
+
+    std::vector<std::vector<int>> received(consumers);
+    std::vector<thread> consumer_threads;
+    for (int c = 0; c < consumers; ++c) {
+        consumer_threads.emplace_back([&q, &received, c] {
+            while (const auto e = q.pop()) {
+                received[c].push_back(*e);
+            }
+        });
+    }
+
+    for (auto& t : producer_threads) {
+        t.join();
+    }
+    q.close();
+    for (auto& t : consumer_threads) {
+        t.join();
+    }
+
+    std::vector<int> seen(producers * per_producer, 0);
+    for (const auto& values : received) {
+        // FIFO: one consumer sees the elements of each producer in push order
+        std::vector<int> last(producers, -1);
+        for (const int v : values) {
+            ASSERT_GT(v, last[v / per_producer]);
+            last[v / per_producer] = v;
+            ++seen[v];
+        }
+    }
+    for (int v = 0; v < producers * per_producer; ++v) {
+        ASSERT_EQ(seen[v], 1) << "element " << v;
+    }
+    EXPECT_TRUE(q.empty());
+}
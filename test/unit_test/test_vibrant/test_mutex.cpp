@@ -359,4 +359,50 @@ TEST(MultiLockTest, TryLockFailsWhenAnyMutexUnavailable) {
     EXPECT_FALSE(lock.isLocked());
 
     m1.unlock();
-}
\ No newline at end of file
+}
+TEST(RWMutexTest, SharedLocksCoexist) {
+    pRWMutex rw;
+    const sharedLock r1(rw);
+    const sharedLock r2(rw, sharedLock::TRY_LOCK);
+    EXPECT_TRUE(r1.isLocked());
+    EXPECT_TRUE(r2.isLocked());
+    EXPECT_FALSE(rw.tryLock());
+}
+
+TEST(RWMutexTest, ExclusiveLockBlocksReaders) {
+    pRWMutex rw;
+    {
+        const uniqueLock w(rw);
+        EXPECT_TRUE(w.isLocked());
+        EXPECT_FALSE(rw.tryLockShared());
+    }
+    EXPECT_TRUE(rw.tryLockShared());
+    rw.unlockShared();
+}
+
+TEST(RWMutexTest, WritersExcludeEachOther) {
+    constexpr int thread_count = 8;
+    constexpr int iterations = 5000;
+    int counter = 0;
+    pRWMutex rw;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < thread_count; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < iterations; ++j) {
+                if (j % 4 == 0) {
+                    uniqueLock lock(rw);
+                    ++counter;
+                } else {
+                    sharedLock lock(rw);
+                    EXPECT_GE(counter, 0);
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(counter, thread_count * iterations / 4);
+}
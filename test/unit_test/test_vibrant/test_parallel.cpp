@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "atomic.h"
+#include "parallel.h"
+#include "tasks.h"
+
+using namespace original;
+
+namespace {
+    void add(atomic<integer>& sum, const integer value) {
+        integer seen = sum.load();
+        while (!sum.exchangeCmp(seen, seen + value)) {}
+    }
+
+    integer fib(taskDelegator& delegator, const integer n) {
+        if (n < 12) {
+            return n < 2 ? n : fib(delegator, n - 1) + fib(delegator, n - 2);
+        }
+        integer left = 0;
+        integer right = 0;
+        parallelInvoke(delegator,
+            [&] { left = fib(delegator, n - 1); },
+            [&] { right = fib(delegator, n - 2); });
+        return left + right;
+    }
+}
+
+TEST(ParallelTest, ParallelForVisitsEveryIndexOnce) {
+    taskDelegator delegator{4};
+    for (const u_integer grain : {0u, 1u, 7u, 1000u, 100000u}) {
+        std::vector<int> visits(10000, 0);
+        parallelFor(delegator, 0, 10000, grain, [&visits](const integer i) { visits[i] += 1; });
+        for (const int v : visits) {
+            ASSERT_EQ(v, 1);
+        }
+    }
+
+    auto sum = makeAtomic<integer>(0);
+    parallelFor(delegator, -50, 50, 3, [&sum](const integer i) { add(sum, i); });
+    EXPECT_EQ(sum.load(), -50);
+    parallelFor(delegator, 5, 5, 1, [&sum](integer) { add(sum, 1000); });
+    parallelFor(delegator, 5, 2, 1, [&sum](integer) { add(sum, 1000); });
+    EXPECT_EQ(sum.load(), -50);
+}
+
+TEST(ParallelTest, NestedParallelismOnOneWorkerDoesNotDeadlock) {
+    // Every outer index runs on the single worker or the caller, and each of them
+    // joins an inner loop whose pieces are queued behind it
+    taskDelegator delegator{1};
+    auto sum = makeAtomic<integer>(0);
+    parallelFor(delegator, 0, 16, 1, [&](const integer i) {
+        parallelFor(delegator, 0, 100, 4, [&](const integer j) { add(sum, i * 100 + j); });
+    });
+    EXPECT_EQ(sum.load(), 1600 * 1599 / 2);
+
+    EXPECT_EQ(fib(delegator, 20), 6765);
+
+    // Tasks submitted the old way and waited on from inside a parallel body also complete
+    parallelFor(delegator, 0, 4, 1, [&](const integer i) {
+        auto f = delegator.submit([i] { return i; });
+        while (!f.ready()) {
+            delegator.tryRunOne();
+        }
+        add(sum, f.result());
+    });
+    EXPECT_EQ(sum.load(), 1600 * 1599 / 2 + 6);
+}
+
+TEST(ParallelTest, InvokeAndExceptions) {
+    taskDelegator delegator{2};
+    int a = 0, b = 0, c = 0;
+    parallelInvoke(delegator, [&a] { a = 1; }, [&b] { b = 2; }, [&c] { c = 3; });
+    EXPECT_EQ(a + b + c, 6);
+    parallelInvoke(delegator, [&a] { a = 10; });
+    EXPECT_EQ(a, 10);
+    parallelInvoke(delegator);
+
+    EXPECT_THROW(parallelInvoke(delegator, [] {}, [] { throw valueError("first"); }), valueError);
+    EXPECT_THROW(parallelInvoke(delegator, [] { throw valueError("forked"); }, [] {}), valueError);
+
+    auto ran = makeAtomic<integer>(0);
+    EXPECT_THROW(parallelFor(delegator, 0, 100000, 10, [&ran](const integer i) {
+        add(ran, 1);
+        if (i == 500) {
+            throw outOfBoundError();
+        }
+    }), outOfBoundError);
+    // Pieces not started when the error was seen are skipped
+    EXPECT_LT(ran.load(), 100000);
+
+    forkJoin group{delegator};
+    auto total = makeAtomic<integer>(0);
+    for (int i = 1; i <= 10; ++i) {
+        group.fork([&total, i] { add(total, i); });
+    }
+    group.join();
+    EXPECT_EQ(total.load(), 55);
+    group.fork([] { throw valueError(); });
+    EXPECT_THROW(group.join(), valueError);
+    EXPECT_NO_THROW(group.join());
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+#include "parallelTrees.h"
+
+using namespace original;
+
+namespace {
+    thread_local bool copies_fail = false;
+
+    // Copying throws only on a thread that armed copies_fail
+    struct fragile {
+        int value = 0;
+
+        fragile() = default;
+
+        explicit fragile(const int v) : value(v) {}
+
+        fragile(const fragile& other) : value(other.value) {
+            if (copies_fail) {
+                throw std::runtime_error("copy failed");
+            }
+        }
+
+        fragile& operator=(const fragile& other) = default;
+
+        bool operator==(const fragile& other) const = default;
+    };
+}
+
+TEST(ParallelTreesTest, TreeSetMatchesStdSetAlgorithms) {
+    taskDelegator pool{4};
+    std::mt19937 gen(17);
+    for (int round = 0; round < 40; ++round) {
+        const int range = 1 + static_cast<int>(gen() % 4000);
+        const int other_cnt = round % 4 == 0 ? static_cast<int>(gen() % 16) : static_cast<int>(gen() % 3000);
+        treeSet<int> a, b;
+        std::set<int> ea, eb;
+        for (int i = 0; i < static_cast<int>(gen() % 3000); ++i) {
+            const int e = static_cast<int>(gen() % range);
+            a.add(e);
+            ea.insert(e);
+        }
+        for (int i = 0; i < other_cnt; ++i) {
+            const int e = static_cast<int>(gen() % range);
+            b.add(e);
+            eb.insert(e);
+        }
+
+        std::vector<int> u, n, d;
+        std::set_union(ea.begin(), ea.end(), eb.begin(), eb.end(), std::back_inserter(u));
+        std::set_intersection(ea.begin(), ea.end(), eb.begin(), eb.end(), std::back_inserter(n));
+        std::set_difference(ea.begin(), ea.end(), eb.begin(), eb.end(), std::back_inserter(d));
+
+        treeSet<int> su = a, sn = a, sd = a;
+        parallelUnion(su, b, pool);
+        parallelIntersection(sn, b, pool);
+        parallelDifference(sd, b, pool);
+        for (const auto& [result, expected] : {std::pair{&su, &u}, std::pair{&sn, &n}, std::pair{&sd, &d}}) {
+            ASSERT_EQ(result->size(), expected->size());
+            std::vector<int> actual;
+            for (const int e : *result) {
+                actual.push_back(e);
+            }
+            ASSERT_EQ(actual, *expected);
+            for (u_integer i = 0; i < result->size(); i += 13) {
+                ASSERT_EQ(result->select(i), (*expected)[i]);
+            }
+        }
+        su.add(range);
+        su.remove(0);
+        EXPECT_TRUE(su.contains(range));
+        EXPECT_FALSE(su.contains(0));
+        EXPECT_EQ(b.size(), eb.size());
+    }
+}
+
+TEST(ParallelTreesTest, TreeMapKeepsOwnValuesForSharedKeys) {
+    taskDelegator pool{4};
+    treeMap<int, int> mine, theirs;
+    for (int k = 0; k < 3000; k += 2) {
+        mine.add(k, k);
+    }
+    for (int k = 0; k < 3000; k += 3) {
+        theirs.add(k, -k);
+    }
+
+    treeMap<int, int> u = mine, n = mine, d = mine;
+    treeMap<int, int> su = mine, sn = mine, sd = mine;
+    parallelUnion(u, theirs, pool);
+    parallelIntersection(n, theirs, pool);
+    parallelDifference(d, theirs, pool);
+    su.unionWith(theirs);
+    sn.intersectWith(theirs);
+    sd.differenceWith(theirs);
+    for (const auto& [result, expected] : {std::pair{&u, &su}, std::pair{&n, &sn}, std::pair{&d, &sd}}) {
+        ASSERT_EQ(result->size(), expected->size());
+        auto it = ownerPtr(result->begins());
+        auto ex = ownerPtr(expected->begins());
+        while (ex->isValid()) {
+            ASSERT_TRUE(it->isValid());
+            ASSERT_EQ(it->get().first(), ex->get().first());
+            ASSERT_EQ(it->get().second(), ex->get().second());
+            it->next();
+            ex->next();
+        }
+        EXPECT_FALSE(it->isValid());
+    }
+    EXPECT_EQ(u.size(), 2000);
+    EXPECT_EQ(n.size(), 500);
+    EXPECT_EQ(d.size(), 1000);
+    EXPECT_EQ(theirs.size(), 1000);
+}
+
+TEST(ParallelTreesTest, SmallPoolFallsBackToSequential) {
+    taskDelegator pool{1};
+    treeSet<int> a, b;
+    for (int i = 0; i < 100; ++i) {
+        a.add(i);
+        b.add(i + 50);
+    }
+    parallelUnion(a, b, pool);
+    EXPECT_EQ(a.size(), 150);
+    parallelIntersection(a, a, pool);
+    EXPECT_EQ(a.size(), 150);
+    parallelDifference(a, b, pool);
+    EXPECT_EQ(a.size(), 50);
+}
+
+TEST(ParallelTreesTest, FailureLeavesTreeEmpty) {
+    taskDelegator pool{4};
+    treeMap<int, fragile> mine, theirs;
+    for (int k = 0; k < 3000; k += 2) {
+        mine.add(k, fragile{k});
+    }
+    for (int k = 0; k < 3000; k += 3) {
+        theirs.add(k, fragile{-k});
+    }
+
+    // Only the calling thread fails, so subtrees already on the pool finish normally
+    // and have to be freed while the exception unwinds
+    copies_fail = true;
+    EXPECT_THROW(parallelUnion(mine, theirs, pool), std::runtime_error);
+    copies_fail = false;
+    EXPECT_EQ(mine.size(), 0);
+    EXPECT_FALSE(mine.containsKey(0));
+    EXPECT_EQ(theirs.size(), 1000);
+
+    parallelUnion(mine, theirs, pool);
+    EXPECT_EQ(mine.size(), 1000);
+    EXPECT_EQ(mine.get(2997).value, -2997);
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "generators.h"
+#include "spscRing.h"
+#include "thread.h"
+
+using namespace original;
+
+TEST(SpscRingTest, RejectsCapacityThatIsNotAPowerOfTwo) {
+    EXPECT_THROW(spscRing<int>{0}, valueError);
+    EXPECT_THROW(spscRing<int>{3}, valueError);
+    EXPECT_THROW(spscRing<int>{100}, valueError);
+    EXPECT_NO_THROW(spscRing<int>{1});
+    EXPECT_EQ(spscRing<int>{64}.capacity(), 64);
+}
+
+TEST(SpscRingTest, FifoUntilFullThenEmpty) {
+    spscRing<std::string> ring{4};
+    EXPECT_TRUE(ring.empty());
+    EXPECT_FALSE(ring.tryPop());
+
+    EXPECT_TRUE(ring.tryPush("a"));
+    const std::string b = "b";
+    EXPECT_TRUE(ring.tryPush(b));
+    EXPECT_TRUE(ring.tryEmplace("cccc", std::string::size_type{3}));
+    EXPECT_TRUE(ring.tryPush("d"));
+    EXPECT_FALSE(ring.tryPush("e"));
+    EXPECT_EQ(ring.size(), 4);
+
+    EXPECT_EQ(*ring.tryPop(), "a");
+    EXPECT_TRUE(ring.tryPush("e"));
+    for (const std::string expected : {"b", "ccc", "d", "e"}) {
+        const auto e = ring.tryPop();
+        ASSERT_TRUE(e);
+        EXPECT_EQ(*e, expected);
+    }
+    EXPECT_TRUE(ring.empty());
+    EXPECT_FALSE(ring.tryPop());
+}
+
+TEST(SpscRingTest, BatchesWrapAroundAndStopAtCapacity) {
+    spscRing<int> ring{8};
+    int src[16];
+    int dst[16];
+    for (int i = 0; i < 16; ++i) {
+        src[i] = i;
+    }
+
+    EXPECT_EQ(ring.tryPushN(src, 5), 5);
+    EXPECT_EQ(ring.tryPopN(dst, 3), 3);
+    EXPECT_EQ(dst[2], 2);
+    // Tail is at 5 and head at 3, so six more fit and the batch wraps past the end
+    EXPECT_EQ(ring.tryPushN(src + 5, 11), 6);
+    EXPECT_EQ(ring.size(), 8);
+    EXPECT_EQ(ring.tryPushN(src, 1), 0);
+    EXPECT_EQ(ring.tryPopN(dst, 16), 8);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(dst[i], i + 3);
+    }
+    EXPECT_EQ(ring.tryPopN(dst, 16), 0);
+}
+
+TEST(SpscRingTest, MoveOnlyElementsAreDestroyedWithTheRing) {
+    const auto counter = std::make_shared<int>(0);
+    {
+        spscRing<std::unique_ptr<std::shared_ptr<int>>> ring{4};
+        for (int i = 0; i < 3; ++i) {
+            ASSERT_TRUE(ring.tryPush(std::make_unique<std::shared_ptr<int>>(counter)));
+        }
+        EXPECT_EQ(counter.use_count(), 4);
+        auto e = ring.tryPop();
+        ASSERT_TRUE(e);
+        EXPECT_EQ(**e, counter);
+        e.reset();
+        EXPECT_EQ(counter.use_count(), 3);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(SpscRingTest, ProducerAndConsumerThreadsKeepOrder) {
+    constexpr int count = 200000;
+    spscRing<int> ring{64};
+    thread producer{[&ring] {
+        int batch[7];
+        int next = 0;
+        while (next < count) {
+            if (next % 3 == 0) {
+                ring.push(next++);
+                continue;
+            }
+            int n = 0;
+            while (n < 7 && next + n < count) {
+                batch[n] = next + n;
+                ++n;
+            }
+            const u_integer pushed = ring.tryPushN(batch, n);
+            next += static_cast<int>(pushed);
+            if (pushed == 0) {
+                thread::yield();
+            }
+        }
+        ring.close();
+    }};
+
+    int expected = 0;
+    int batch[5];
+    while (true) {
+        const u_integer popped = ring.tryPopN(batch, 5);
+        for (u_integer i = 0; i < popped; ++i) {
+            ASSERT_EQ(batch[i], expected++);
+        }
+        if (popped == 0) {
+            const auto e = ring.pop();
+            if (!e) {
+                break;
+            }
+            ASSERT_EQ(*e, expected++);
+        }
+    }
+    producer.join();
+    EXPECT_EQ(expected, count);
+    EXPECT_TRUE(ring.closed());
+}
+
+TEST(SpscRingTest, GeneratorDrainsAClosedStream) {
+    constexpr int count = 10000;
+    spscRing<int> ring{16};
+    thread producer{[&ring] {
+        for (int i = 1; i <= count; ++i) {
+            ring.push(i);
+        }
+        ring.close();
+    }};
+
+    long long sum = 0;
+    int seen = 0;
+    for (const auto& [index, value] : enumerate(ring.elements())) {
+        ASSERT_EQ(value, static_cast<int>(index) + 1);
+        sum += value;
+        ++seen;
+    }
+    producer.join();
+    EXPECT_EQ(seen, count);
+    EXPECT_EQ(sum, static_cast<long long>(count) * (count + 1) / 2);
+}
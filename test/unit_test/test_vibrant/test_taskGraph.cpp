@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "atomic.h"
+#include "taskGraph.h"
+#include "tasks.h"
+
+using namespace original;
+
+TEST(TaskGraphTest, RunsInDependencyOrderWithoutBlockingWorkers) {
+    // A diamond whose middle is wider than the pool: with blocking result() calls
+    // inside tasks a single worker would deadlock here
+    taskDelegator delegator{1};
+    taskGraph graph;
+    pMutex mutex;
+    std::vector<u_integer> order;
+    auto record = [&mutex, &order](const u_integer i) {
+        return [&mutex, &order, i] {
+            uniqueLock lock{mutex};
+            order.push_back(i);
+        };
+    };
+
+    const u_integer source = graph.add("source", record(0));
+    std::vector<u_integer> middle;
+    for (u_integer i = 1; i <= 4; ++i) {
+        middle.push_back(graph.add("middle", record(i)));
+        graph.precede(source, middle.back());
+    }
+    const u_integer sink = graph.add("sink", record(5));
+    for (const u_integer m : middle) {
+        graph.precede(m, sink);
+    }
+    EXPECT_EQ(graph.size(), 6);
+    EXPECT_EQ(graph.name(sink), "sink");
+
+    for (int round = 0; round < 3; ++round) {
+        order.clear();
+        graph.run(delegator);
+        ASSERT_EQ(order.size(), 6);
+        EXPECT_EQ(order.front(), 0);
+        EXPECT_EQ(order.back(), 5);
+    }
+    EXPECT_GE(graph.startOffset(sink), graph.startOffset(source));
+    EXPECT_GE(graph.lastRun(), graph.elapsed(source));
+    EXPECT_NE(graph.timings().find("sink"), std::string::npos);
+
+    taskGraph empty;
+    EXPECT_NO_THROW(empty.run(delegator));
+}
+
+TEST(TaskGraphTest, RunFromInsideATaskOfASingleWorkerPool) {
+    // The only worker runs the graph, so it has to run the nodes itself while it waits
+    taskDelegator delegator{1};
+    taskGraph graph;
+    auto ran = makeAtomic<u_integer>(0);
+    auto count = [&ran] {
+        u_integer seen = ran.load();
+        while (!ran.exchangeCmp(seen, seen + 1)) {}
+    };
+    const u_integer source = graph.add(count);
+    const u_integer sink = graph.add(count);
+    for (int i = 0; i < 8; ++i) {
+        const u_integer middle = graph.add(count);
+        graph.precede(source, middle);
+        graph.precede(middle, sink);
+    }
+
+    auto outer = delegator.submit([&graph, &delegator, &ran] {
+        for (int round = 0; round < 3; ++round) {
+            graph.run(delegator);
+        }
+        return ran.load();
+    });
+    EXPECT_EQ(outer.result(), 30);
+}
+
+TEST(TaskGraphTest, LayeredGraphCountsEveryPredecessor) {
+    taskDelegator delegator{4};
+    taskGraph graph;
+    constexpr u_integer layers = 20;
+    constexpr u_integer width = 50;
+    std::vector<int> values(layers * width, 0);
+    for (u_integer l = 0; l < layers; ++l) {
+        for (u_integer w = 0; w < width; ++w) {
+            const u_integer i = l * width + w;
+            graph.add([&values, i, l] {
+                // Each node reads the two nodes it depends on in the previous layer
+                values[i] = l == 0 ? 1 : values[i - width] + values[(i - width + 1) % width + (l - 1) * width];
+            });
+            if (l > 0) {
+                graph.precede(i - width, i);
+                graph.precede((i - width + 1) % width + (l - 1) * width, i);
+            }
+        }
+    }
+    for (int round = 0; round < 5; ++round) {
+        std::fill(values.begin(), values.end(), 0);
+        graph.run(delegator);
+        for (u_integer w = 0; w < width; ++w) {
+            EXPECT_EQ(values[(layers - 1) * width + w], 1 << (layers - 1));
+        }
+    }
+}
+
+TEST(TaskGraphTest, ErrorsCyclesAndBounds) {
+    taskDelegator delegator{2};
+    taskGraph graph;
+    auto ran = makeAtomic<u_integer>(0);
+    auto count = [&ran] {
+        u_integer seen = ran.load();
+        while (!ran.exchangeCmp(seen, seen + 1)) {}
+    };
+    const u_integer a = graph.add(count);
+    const u_integer b = graph.add("fails", [] { throw valueError("boom"); });
+    const u_integer c = graph.add(count);
+    graph.precede(a, b);
+    graph.precede(b, c);
+
+    EXPECT_THROW(graph.precede(a, a), valueError);
+    EXPECT_THROW(graph.precede(a, 3), outOfBoundError);
+    EXPECT_THROW(static_cast<void>(graph.name(7)), outOfBoundError);
+
+    // The node after the failing one is skipped, and the run can be repeated
+    for (int round = 1; round <= 2; ++round) {
+        EXPECT_THROW(graph.run(delegator), valueError);
+        EXPECT_EQ(ran.load(), round);
+        EXPECT_EQ(graph.elapsed(c), time::duration::ZERO);
+        EXPECT_NE(graph.timings().find("skipped"), std::string::npos);
+    }
+
+    graph.precede(c, a);
+    EXPECT_THROW(graph.run(delegator), valueError);
+    EXPECT_EQ(ran.load(), 2);
+
+    taskGraph lone;
+    lone.add(count);
+    delegator.stop();
+    EXPECT_THROW(lone.run(delegator), sysError);
+}
@@ -1,4 +1,7 @@
 #include <gtest/gtest.h>
+#include <atomic>
+#include <functional>
+#include <vector>
 #include "tasks.h"
 #include "thread.h"
 
@@ -763,3 +766,361 @@ TEST(TaskDelegatorTest, StressTestMixedTasks) {
     EXPECT_EQ(deferred_sum.load(), expected_deferred_sum);
     EXPECT_EQ(immediate_sum.load(), immediate_task_submitted ? expected_immediate_sum : 0);
 }
+
+// 测试批量提交：结果按提交顺序返回
+TEST(TaskDelegatorTest, SubmitBatchReturnsFuturesInOrder) {
+    taskDelegator delegator(4);
+
+    std::vector<std::function<int()>> callables;
+    for (int i = 0; i < 1000; ++i) {
+        callables.emplace_back([i] { return i * 2; });
+    }
+    auto futures = delegator.submitBatch(callables);
+    ASSERT_EQ(futures.size(), 1000);
+    for (u_integer i = 0; i < futures.size(); ++i) {
+        EXPECT_EQ(futures[i].result(), static_cast<int>(i) * 2);
+    }
+    // 左值范围不会被移动
+    EXPECT_EQ(callables[10](), 20);
+
+    std::vector<std::function<void()>> none;
+    EXPECT_EQ(delegator.submitBatch(none).size(), 0);
+    EXPECT_EQ(delegator.waitingCnt(), 0);
+}
+
+// 测试批量提交的优先级、延迟任务与异常
+TEST(TaskDelegatorTest, SubmitBatchPrioritiesAndErrors) {
+    taskDelegator delegator(2);
+
+    auto counter = makeAtomic<int>(0);
+    auto increment = [&counter] {
+        int seen = counter.load();
+        while (!counter.exchangeCmp(seen, seen + 1)) {}
+    };
+    std::vector<std::function<void()>> deferred(5, increment);
+    auto deferred_futures = delegator.submitBatch(taskDelegator::DEFERRED, std::move(deferred));
+    EXPECT_EQ(delegator.deferredCnt(), 5);
+    EXPECT_EQ(counter.load(), 0);
+    delegator.runAllDeferred();
+    for (u_integer i = 0; i < deferred_futures.size(); ++i) {
+        deferred_futures[i].result();
+    }
+    EXPECT_EQ(counter.load(), 5);
+
+    while (delegator.idleThreads() < 2) {
+        thread::yield();
+    }
+    std::vector<std::function<void()>> too_many(3, increment);
+    EXPECT_THROW(delegator.submitBatch(taskDelegator::IMMEDIATE, too_many), sysError);
+    EXPECT_EQ(delegator.immediateCnt(), 0);
+
+    std::vector<std::function<int()>> failing{[] { return 1; }, []() -> int { throw valueError(); }};
+    auto results = delegator.submitBatch(taskDelegator::HIGH, failing);
+    EXPECT_EQ(results[0].result(), 1);
+    EXPECT_THROW(results[1].result(), valueError);
+
+    delegator.stop();
+    EXPECT_THROW(delegator.submitBatch(failing), sysError);
+}
+
+// 测试任务等待同一批次中排在其后的任务时不会死锁：等待者帮忙执行，能取到已被抓取的后者
+TEST(TaskDelegatorTest, TaskWaitingOnLaterTaskOfSameBatch) {
+    taskDelegator delegator(4);
+    constexpr int pairs = 32;
+    std::atomic<bool> done[pairs]{};
+    std::vector<std::function<bool()>> callables;
+    for (int i = 0; i < pairs; ++i) {
+        callables.emplace_back([&delegator, &done, i] {
+            const auto deadline = time::point::now() + milliseconds(500);
+            while (!done[i].load()) {
+                if (time::point::now() > deadline) {
+                    return false;
+                }
+                if (!delegator.tryRunOne()) {
+                    thread::yield();
+                }
+            }
+            return true;
+        });
+        callables.emplace_back([&done, i] {
+            done[i] = true;
+            return true;
+        });
+    }
+    auto futures = delegator.submitBatch(callables);
+    for (u_integer i = 0; i < futures.size(); ++i) {
+        EXPECT_TRUE(futures[i].result()) << "task " << i;
+    }
+}
+
+// 测试空闲线程从阻塞线程的本地队列中窃取任务
+TEST(TaskDelegatorTest, IdleWorkerStealsFromBlockedWorker) {
+    taskDelegator delegator(2);
+    std::atomic<bool> released{false};
+    std::vector<std::function<bool()>> callables;
+    // 第一个任务只等待，不帮忙；放行它的任务紧随其后，与它同批
+    callables.emplace_back([&released] {
+        const auto deadline = time::point::now() + milliseconds(500);
+        while (!released.load()) {
+            if (time::point::now() > deadline) {
+                return false;
+            }
+            thread::yield();
+        }
+        return true;
+    });
+    callables.emplace_back([&released] {
+        released = true;
+        return true;
+    });
+    for (int i = 0; i < 6; ++i) {
+        callables.emplace_back([] { return true; });
+    }
+    auto futures = delegator.submitBatch(callables);
+    for (u_integer i = 0; i < futures.size(); ++i) {
+        EXPECT_TRUE(futures[i].result()) << "task " << i;
+    }
+}
+
+// 测试大量小任务全部执行
+TEST(TaskDelegatorTest, ManySmallTasksAllRun) {
+    taskDelegator delegator(4);
+    auto sum = makeAtomic<int>(0);
+    std::vector<async::future<void>> futures;
+    for (int i = 1; i <= 20000; ++i) {
+        futures.push_back(delegator.submit(i % 2 == 0 ? taskDelegator::HIGH : taskDelegator::LOW, [&sum, i] {
+            int seen = sum.load();
+            while (!sum.exchangeCmp(seen, seen + i)) {}
+        }));
+    }
+    for (auto& f : futures) {
+        f.result();
+    }
+    EXPECT_EQ(sum.load(), 20000 * 20001 / 2);
+    EXPECT_EQ(delegator.waitingCnt(), 0);
+}
+
+// 测试弹性线程池：突发任务时扩容，空闲超时后缩回最小线程数
+TEST(TaskDelegatorTest, ElasticGrowsUnderBurstAndRetires) {
+    taskDelegator delegator(1, 4, time::duration{20, time::MILLISECOND});
+    EXPECT_EQ(delegator.minThreads(), 1);
+    EXPECT_EQ(delegator.maxThreads(), 4);
+    EXPECT_EQ(delegator.keepAlive(), time::duration(20, time::MILLISECOND));
+    EXPECT_EQ(delegator.threadCnt(), 1);
+    EXPECT_EQ(delegator.spawnedCnt(), 0);
+
+    auto gate = async::makePromise([] {});
+    auto open = gate.getFuture().share();
+    std::vector<async::future<int>> futures;
+    for (int i = 0; i < 8; ++i) {
+        futures.push_back(delegator.submit([open, i] { open.wait(); return i; }));
+    }
+    // 每个任务提交时都没有空闲线程，直到达到最大线程数
+    EXPECT_EQ(delegator.threadCnt(), 4);
+    EXPECT_EQ(delegator.spawnedCnt(), 3);
+    gate.run();
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(futures[i].result(), i);
+    }
+
+    while (delegator.threadCnt() > 1) {
+        thread::sleep(time::duration{5, time::MILLISECOND});
+    }
+    EXPECT_EQ(delegator.retiredCnt(), 3);
+
+    // 退出线程的槽位可以再次使用
+    std::vector<std::function<int()>> burst(6, [open] { open.wait(); return 1; });
+    auto results = delegator.submitBatch(burst);
+    EXPECT_EQ(delegator.threadCnt(), 4);
+    EXPECT_EQ(delegator.spawnedCnt(), 6);
+    int total = 0;
+    for (u_integer i = 0; i < results.size(); ++i) {
+        total += results[i].result();
+    }
+    EXPECT_EQ(total, 6);
+}
+
+// 测试弹性线程池：已启动但尚未运行的线程也算作空闲，不会为此多启动线程
+TEST(TaskDelegatorTest, ElasticCountsStartingWorkers) {
+    taskDelegator delegator(4, 8, time::duration{1, time::SECOND});
+    // 构造函数返回时最小线程可能还没有开始运行，此时提交的任务不超过它们的数量
+    std::vector<async::future<int>> futures;
+    for (int i = 0; i < 3; ++i) {
+        futures.push_back(delegator.submit([] { return 1; }));
+    }
+    std::vector<std::function<int()>> last(1, [] { return 1; });
+    auto rest = delegator.submitBatch(last);
+    EXPECT_EQ(delegator.spawnedCnt(), 0);
+    int total = rest[0].result();
+    for (auto& f : futures) {
+        total += f.result();
+    }
+    EXPECT_EQ(total, 4);
+    EXPECT_EQ(delegator.spawnedCnt(), 0);
+    EXPECT_EQ(delegator.threadCnt(), 4);
+}
+
+// 测试弹性线程池参数与固定线程池的计数
+TEST(TaskDelegatorTest, ElasticPolicyAndFixedCounters) {
+    EXPECT_THROW(taskDelegator(3, 2, time::duration{1, time::SECOND}), valueError);
+
+    taskDelegator fixed(2);
+    EXPECT_EQ(fixed.minThreads(), 2);
+    EXPECT_EQ(fixed.maxThreads(), 2);
+    EXPECT_EQ(fixed.threadCnt(), 2);
+    for (int i = 0; i < 10; ++i) {
+        fixed.submit([] { thread::sleep(time::duration{1, time::MILLISECOND}); });
+    }
+    thread::sleep(time::duration{30, time::MILLISECOND});
+    EXPECT_EQ(fixed.threadCnt(), 2);
+    EXPECT_EQ(fixed.spawnedCnt(), 0);
+    EXPECT_EQ(fixed.retiredCnt(), 0);
+
+    // 最小线程数为 0 时，延迟任务被激活后才启动线程
+    taskDelegator lazy(0, 2, time::duration{10, time::MILLISECOND});
+    EXPECT_EQ(lazy.threadCnt(), 0);
+    auto deferred = lazy.submit(taskDelegator::DEFERRED, [] { return 5; });
+    EXPECT_EQ(lazy.threadCnt(), 0);
+    lazy.runDeferred();
+    EXPECT_EQ(deferred.result(), 5);
+    while (lazy.threadCnt() > 0) {
+        thread::sleep(time::duration{5, time::MILLISECOND});
+    }
+    EXPECT_EQ(lazy.retiredCnt(), lazy.spawnedCnt());
+}
+
+// 测试直方图的分桶与分位数
+TEST(TaskDelegatorTest, LatencyHistogram) {
+    taskDelegator::histogram h;
+    EXPECT_EQ(h.mean(), time::duration::ZERO);
+    EXPECT_EQ(h.percentile(0.5), time::duration::ZERO);
+    for (int i = 0; i < 99; ++i) {
+        h.record(time::duration{100, time::NANOSECOND});
+    }
+    h.record(time::duration{1, time::MILLISECOND});
+    h.record(time::duration{-5, time::NANOSECOND});
+    EXPECT_EQ(h.total, 101);
+    EXPECT_EQ(h.counts[0], 1);
+    EXPECT_EQ(h.counts[std::bit_width(100u)], 99);
+    EXPECT_EQ(h.max, time::duration(1, time::MILLISECOND));
+    // 分位数取所在桶的上界：100ns 落在 [64ns, 128ns)
+    EXPECT_EQ(h.percentile(0.5), time::duration(128, time::NANOSECOND));
+    EXPECT_EQ(h.percentile(1.0), time::duration(1, time::MILLISECOND));
+    EXPECT_GT(h.mean(), time::duration(100, time::NANOSECOND));
+}
+
+// 测试任务延迟统计与快照
+TEST(TaskDelegatorTest, InstrumentationSnapshot) {
+    taskDelegator delegator(2);
+    EXPECT_FALSE(delegator.instrumented());
+    delegator.submit([] {}).result();
+    EXPECT_EQ(delegator.stats().completed, 0);
+
+    delegator.instrument(true);
+    EXPECT_TRUE(delegator.instrumented());
+    std::vector<async::future<void>> futures;
+    for (int i = 0; i < 10; ++i) {
+        futures.push_back(delegator.submit(taskDelegator::HIGH, [] {
+            thread::sleep(time::duration{2, time::MILLISECOND});
+        }));
+    }
+    for (int i = 0; i < 5; ++i) {
+        futures.push_back(delegator.submit(taskDelegator::LOW, [] {}));
+    }
+    auto deferred = delegator.submit(taskDelegator::DEFERRED, [] {});
+    for (auto& f : futures) {
+        f.result();
+    }
+    delegator.runAllDeferred();
+    deferred.result();
+
+    // 统计在工作线程取下一个任务时归并，等待其完成
+    while (delegator.stats().completed < 16) {
+        thread::sleep(time::duration{1, time::MILLISECOND});
+    }
+    const auto stats = delegator.stats();
+    EXPECT_TRUE(stats.enabled);
+    EXPECT_EQ(stats.completed, 16);
+    EXPECT_EQ(stats.waitOf(taskDelegator::HIGH).total, 10);
+    EXPECT_EQ(stats.runOf(taskDelegator::HIGH).total, 10);
+    EXPECT_EQ(stats.waitOf(taskDelegator::LOW).total, 5);
+    EXPECT_EQ(stats.runOf(taskDelegator::DEFERRED).total, 1);
+    EXPECT_EQ(stats.runOf(taskDelegator::NORMAL).total, 0);
+    EXPECT_GE(stats.runOf(taskDelegator::HIGH).mean(), time::duration(2, time::MILLISECOND));
+    EXPECT_GE(stats.queue_high_water, 1);
+    EXPECT_EQ(stats.queue_depth, 0);
+    EXPECT_GT(stats.throughput(), 0.0);
+    ASSERT_EQ(stats.workers.size(), 2);
+    ul_integer tasks = 0;
+    for (u_integer i = 0; i < stats.workers.size(); ++i) {
+        tasks += stats.workers[i].tasks;
+        EXPECT_GE(stats.workers[i].utilization(), 0.0);
+        EXPECT_LE(stats.workers[i].utilization(), 1.0);
+    }
+    EXPECT_EQ(tasks, 16);
+
+    // 关闭后不再计数，再次开启时清零
+    delegator.instrument(false);
+    delegator.submit([] {}).result();
+    EXPECT_EQ(delegator.stats().completed, 16);
+    delegator.instrument(true);
+    EXPECT_EQ(delegator.stats().completed, 0);
+    EXPECT_EQ(delegator.stats().runOf(taskDelegator::HIGH).total, 0);
+
+    // 带超时的立即提交同样计入等待时间与队列深度
+    while (delegator.idleThreads() == 0) {
+        thread::yield();
+    }
+    delegator.submit(time::duration{1, time::SECOND}, [] {}).result();
+    while (delegator.stats().completed < 1) {
+        thread::sleep(time::duration{1, time::MILLISECOND});
+    }
+    EXPECT_EQ(delegator.stats().waitOf(taskDelegator::IMMEDIATE).total, 1);
+    EXPECT_EQ(delegator.stats().runOf(taskDelegator::IMMEDIATE).total, 1);
+    EXPECT_GE(delegator.stats().queue_high_water, 1);
+}
+
+// 测试工作线程绑定 CPU 与命名
+TEST(TaskDelegatorTest, PinnedWorkers) {
+    const auto cpus = thread::availableCpus();
+    ASSERT_FALSE(cpus.empty());
+
+    for (const auto pin : {taskDelegator::COMPACT, taskDelegator::SCATTER}) {
+        taskDelegator delegator(3, pin);
+        EXPECT_EQ(delegator.pinning(), pin);
+        ASSERT_EQ(delegator.workerCpus().size(), 3);
+        for (u_integer i = 0; i < 3; ++i) {
+            EXPECT_TRUE(cpus.contains(delegator.workerCpus()[i]));
+        }
+        // 每个 CPU 先各分到一个工作线程
+        if (cpus.size() >= 3) {
+            EXPECT_NE(delegator.workerCpus()[0], delegator.workerCpus()[1]);
+            EXPECT_NE(delegator.workerCpus()[1], delegator.workerCpus()[2]);
+        }
+        auto f = delegator.submit([] {
+            char buf[16] = {};
+            pthread_getname_np(pthread_self(), buf, sizeof(buf));
+            return std::make_pair(std::string(buf), sched_getcpu());
+        });
+        const auto [name, cpu] = f.result();
+        EXPECT_EQ(name.rfind("tasks-", 0), 0);
+        const u_integer slot = std::stoul(name.substr(6));
+        EXPECT_EQ(static_cast<u_integer>(cpu), delegator.workerCpus()[slot]);
+    }
+
+    // 显式列表按顺序循环使用
+    const u_integer last = cpus[cpus.size() - 1];
+    taskDelegator explicit_pin(0, 3, time::duration{10, time::MILLISECOND}, taskDelegator::EXPLICIT, {last, cpus[0]});
+    EXPECT_EQ(explicit_pin.workerCpus()[0], last);
+    EXPECT_EQ(explicit_pin.workerCpus()[1], cpus[0]);
+    EXPECT_EQ(explicit_pin.workerCpus()[2], last);
+    EXPECT_EQ(explicit_pin.submit([] { return sched_getcpu(); }).result(), static_cast<int>(last));
+
+    taskDelegator unpinned(1);
+    EXPECT_EQ(unpinned.pinning(), taskDelegator::UNPINNED);
+    EXPECT_TRUE(unpinned.workerCpus().empty());
+
+    EXPECT_THROW(taskDelegator(2, taskDelegator::EXPLICIT), valueError);
+    EXPECT_THROW(taskDelegator(2, taskDelegator::EXPLICIT, {100000}), valueError);
+    EXPECT_THROW(taskDelegator(2, taskDelegator::COMPACT, {100000}), valueError);
+}
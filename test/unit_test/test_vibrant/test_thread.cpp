@@ -484,4 +484,61 @@ TEST_F(ThreadTest, PThreadPrintableInterface) {
     ASSERT_TRUE(str2.find("pThread") != std::string::npos);
 
     pt1.join();
-}
\ No newline at end of file
+}
+// Test creation-time name, affinity and stack size
+TEST_F(ThreadTest, ThreadOptionsApplied) {
+    const auto cpus = thread::availableCpus();
+    ASSERT_FALSE(cpus.empty());
+    const u_integer cpu = cpus[cpus.size() - 1];
+
+    std::string name;
+    int ran_on = -1;
+    size_t stack = 0;
+    thread t(threadOptions{}.name("options-test-long-name").pin(cpu).stackSize(1024 * 1024), [&] {
+        char buf[16] = {};
+        pthread_getname_np(pthread_self(), buf, sizeof(buf));
+        name = buf;
+        ran_on = sched_getcpu();
+        pthread_attr_t attr;
+        pthread_getattr_np(pthread_self(), &attr);
+        pthread_attr_getstacksize(&attr, &stack);
+        pthread_attr_destroy(&attr);
+    });
+    t.join();
+    // Names are truncated to the 15 characters the kernel keeps
+    EXPECT_EQ(name, "options-test-lo");
+    EXPECT_EQ(ran_on, static_cast<int>(cpu));
+    EXPECT_GE(stack, 1024u * 1024u);
+
+    // Join policy and arguments still work with options
+    int value = 0;
+    {
+        thread d(threadOptions{}.schedule(threadOptions::BATCH), [&value] {
+            simpleFunction(value);
+            EXPECT_EQ(sched_getscheduler(0), SCHED_BATCH);
+        }, thread::AUTO_JOIN);
+    }
+    EXPECT_EQ(value, 42);
+}
+
+// Test rejected options and option accessors
+TEST_F(ThreadTest, ThreadOptionsRejected) {
+    EXPECT_THROW(thread(threadOptions{}.pin(100000), [] {}), sysError);
+
+    // Real-time priorities need privileges; without them creation fails cleanly
+    std::atomic<bool> ran = false;
+    try {
+        thread rt(threadOptions{}.schedule(threadOptions::FIFO, 1), [&ran] { ran = true; });
+        rt.join();
+        EXPECT_TRUE(ran);
+    } catch (const sysError&) {
+        EXPECT_FALSE(ran);
+    }
+
+    const threadOptions defaults;
+    EXPECT_TRUE(defaults.name().empty());
+    EXPECT_EQ(defaults.stackSize(), 0);
+    EXPECT_TRUE(defaults.affinity().empty());
+    EXPECT_EQ(defaults.policy(), threadOptions::INHERIT);
+    EXPECT_NE(defaults.toString(false).find("threadOptions"), std::string::npos);
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "atomic.h"
+#include "tasks.h"
+#include "thread.h"
+#include "timerWheel.h"
+
+using namespace original;
+
+TEST(TimerWheelTest, OneShotTimersFireInDeadlineOrderAndNotEarly) {
+    timerWheel wheel;
+    EXPECT_EQ(wheel.tick(), time::duration(1, time::MILLISECOND));
+
+    pMutex mutex;
+    std::vector<int> order;
+    std::vector<time::point> fired_at(3, time::point{});
+    const auto start = time::point::now();
+    for (const int i : {2, 0, 1}) {
+        wheel.schedule(time::duration{10 + 10 * i, time::MILLISECOND}, [&, i] {
+            uniqueLock lock{mutex};
+            order.push_back(i);
+            fired_at[i] = time::point::now();
+        });
+    }
+    EXPECT_EQ(wheel.pending(), 3);
+
+    while (wheel.pending() > 0) {
+        thread::sleep(time::duration{1, time::MILLISECOND});
+    }
+    thread::sleep(time::duration{5, time::MILLISECOND});
+    uniqueLock lock{mutex};
+    ASSERT_EQ(order.size(), 3);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(order[i], i);
+        EXPECT_GE((fired_at[i] - start).value(time::MILLISECOND), 10 + 10 * i);
+    }
+}
+
+TEST(TimerWheelTest, CancelAndHandles) {
+    timerWheel wheel;
+    auto fired = makeAtomic<u_integer>(0);
+    auto far = wheel.schedule(time::duration{1, time::HOUR}, [&fired] { fired.exchange(fired.load() + 1); });
+    auto soon = wheel.schedule(time::duration{5, time::MILLISECOND}, [&fired] { fired.exchange(fired.load() + 1); });
+    const auto copy = far;
+    EXPECT_TRUE(far.pending());
+    EXPECT_TRUE(copy.pending());
+    EXPECT_EQ(wheel.pending(), 2);
+
+    EXPECT_TRUE(far.cancel());
+    EXPECT_FALSE(copy.pending());
+    EXPECT_FALSE(far.cancel());
+    EXPECT_EQ(wheel.pending(), 1);
+
+    while (soon.pending()) {
+        thread::sleep(time::duration{1, time::MILLISECOND});
+    }
+    // A fired one-shot timer cannot be cancelled, even after its entry is reused
+    EXPECT_FALSE(soon.cancel());
+    auto reused = wheel.schedule(time::duration{1, time::HOUR}, [] {});
+    EXPECT_FALSE(soon.pending());
+    EXPECT_TRUE(reused.pending());
+
+    timerWheel::timer none;
+    EXPECT_FALSE(none.pending());
+    EXPECT_FALSE(none.cancel());
+
+    thread::sleep(time::duration{5, time::MILLISECOND});
+    EXPECT_EQ(fired.load(), 1);
+    EXPECT_EQ(wheel.pending(), 1);
+    wheel.stop();
+    EXPECT_FALSE(reused.pending());
+    EXPECT_EQ(wheel.pending(), 0);
+    EXPECT_THROW(wheel.schedule(time::duration{1, time::MILLISECOND}, [] {}), sysError);
+}
+
+TEST(TimerWheelTest, IdleWheelSkipsTheTicksItSlept) {
+    // At one nanosecond per tick, sleeping 200 ms leaves 200 million ticks behind
+    timerWheel wheel{time::duration{1, time::NANOSECOND}};
+    thread::sleep(time::duration{200, time::MILLISECOND});
+
+    auto fired = makeAtomic(false);
+    const auto start = time::point::now();
+    wheel.schedule(time::duration::ZERO, [&fired] { fired.store(true); });
+    while (!fired.load()) {
+        thread::sleep(time::duration{1, time::MILLISECOND});
+    }
+    EXPECT_LT(time::point::now() - start, time::duration(50, time::MILLISECOND));
+}
+
+TEST(TimerWheelTest, PeriodicTimerOnDelegatorUntilCancelled) {
+    taskDelegator delegator{2};
+    timerWheel wheel{delegator};
+    auto runs = makeAtomic<u_integer>(0);
+    auto every = wheel.scheduleEvery(time::duration{5, time::MILLISECOND}, [&runs] {
+        u_integer seen = runs.load();
+        while (!runs.exchangeCmp(seen, seen + 1)) {}
+    });
+    auto at = makeAtomic(false);
+    wheel.scheduleAt(time::point::now() - time::duration{1, time::SECOND}, [&at] { at.store(true); });
+
+    while (runs.load() < 3) {
+        thread::sleep(time::duration{1, time::MILLISECOND});
+    }
+    EXPECT_TRUE(every.pending());
+    EXPECT_TRUE(every.cancel());
+    EXPECT_FALSE(every.pending());
+    const u_integer after = runs.load();
+    thread::sleep(time::duration{30, time::MILLISECOND});
+    // At most one firing handed to the delegator before the cancel still runs
+    EXPECT_LE(runs.load(), after + 1);
+    EXPECT_TRUE(at.load());
+    EXPECT_EQ(wheel.pending(), 0);
+}
+
+TEST(TimerWheelTest, ManyTimersAcrossLevels) {
+    timerWheel wheel{time::duration{100, time::MICROSECOND}};
+    constexpr int count = 20000;
+    auto fired = makeAtomic<u_integer>(0);
+    std::vector<timerWheel::timer> timers;
+    for (int i = 0; i < count; ++i) {
+        // Spread over 0..80 ms, i.e. past the first level (256 ticks of 100 us)
+        timers.push_back(wheel.schedule(time::duration{(i % 800) * 100, time::MICROSECOND}, [&fired] {
+            u_integer seen = fired.load();
+            while (!fired.exchangeCmp(seen, seen + 1)) {}
+        }));
+    }
+    // Timers far beyond the wheel's reach park in the top level
+    auto parked = wheel.schedule(time::duration{10000, time::DAY}, [] {});
+    u_integer cancelled = 0;
+    for (int i = 0; i < count; i += 3) {
+        cancelled += timers[i].cancel() ? 1 : 0;
+    }
+    while (wheel.pending() > 1) {
+        thread::sleep(time::duration{1, time::MILLISECOND});
+    }
+    EXPECT_EQ(fired.load() + cancelled, count);
+    EXPECT_TRUE(parked.pending());
+}